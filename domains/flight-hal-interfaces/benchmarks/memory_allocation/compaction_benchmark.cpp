@@ -0,0 +1,93 @@
+/**
+ * @file compaction_benchmark.cpp
+ * @brief CompactingAllocator allocation and compaction benchmarks
+ * 
+ * Measures handle allocation on a 16MB heap and how much a fragmented heap
+ * compacts within frame-sized time budgets.
+ */
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../../include/flight/hal/allocators/compacting_allocator.hpp"
+
+using namespace flight::hal;
+using namespace flight::hal::allocators;
+
+namespace {
+
+constexpr size_t HEAP_SIZE = 16 * 1024 * 1024;
+
+/**
+ * @brief Fill the heap with small blocks and free every other one
+ */
+std::vector<CompactingAllocator::Handle> fragment(CompactingAllocator& heap, std::mt19937& rng) {
+    std::vector<CompactingAllocator::Handle> handles;
+    std::uniform_int_distribution<size_t> size_dist(64, 4096);
+    for (;;) {
+        auto result = heap.allocate_handle(size_dist(rng));
+        if (!result) {
+            break;
+        }
+        handles.push_back(result.value());
+    }
+    std::vector<CompactingAllocator::Handle> live;
+    for (size_t i = 0; i < handles.size(); ++i) {
+        if (i % 2) {
+            live.push_back(handles[i]);
+        } else {
+            heap.free_handle(handles[i]);
+        }
+    }
+    return live;
+}
+
+} // anonymous namespace
+
+static void BM_CompactingAllocator_AllocateFree(benchmark::State& state) {
+    CompactingAllocator heap(HEAP_SIZE);
+    const size_t size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        auto result = heap.allocate_handle(size);
+        benchmark::DoNotOptimize(heap.resolve(result.value()));
+        heap.free_handle(result.value());
+    }
+}
+BENCHMARK(BM_CompactingAllocator_AllocateFree)->Arg(64)->Arg(4096);
+
+// Bytes moved per step of the given budget (microseconds) on a half-empty heap
+static void BM_CompactingAllocator_CompactStep(benchmark::State& state) {
+    const std::chrono::microseconds budget{state.range(0)};
+    size_t moved = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        CompactingAllocator heap(HEAP_SIZE);
+        std::mt19937 rng(42);
+        auto live = fragment(heap, rng);
+        state.ResumeTiming();
+
+        auto progress = heap.compact_step(budget);
+        moved += progress.value().bytes_moved;
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(moved));
+    state.counters["moved_per_step"] = benchmark::Counter(static_cast<double>(moved),
+                                                          benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_CompactingAllocator_CompactStep)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+// Full defragmentation of a half-empty 16MB heap
+static void BM_CompactingAllocator_Defragment(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        CompactingAllocator heap(HEAP_SIZE);
+        std::mt19937 rng(42);
+        auto live = fragment(heap, rng);
+        state.ResumeTiming();
+
+        heap.defragment();
+        benchmark::DoNotOptimize(heap.get_largest_free_block());
+    }
+}
+BENCHMARK(BM_CompactingAllocator_Defragment)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,252 @@
+/**
+ * @file compacting_allocator.hpp
+ * @brief Compacting Allocator Implementation
+ *
+ * Handle-based relocatable heap that slides live blocks together to undo
+ * fragmentation. Built for long-running sessions on 16-32MB targets, where
+ * a general-purpose heap eventually fails large allocations even though
+ * enough memory is free in total.
+ */
+
+#pragma once
+
+#include "../interfaces/memory.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace flight::hal::allocators {
+
+/**
+ * @brief Relocatable allocator with incremental compaction
+ *
+ * Blocks are addressed through stable handles; the address behind a handle
+ * may change whenever the heap is compacted. compact_step() moves blocks
+ * toward the start of the buffer until its time budget runs out, so a game
+ * can spend idle frame time on compaction instead of stalling. Owners that
+ * cache addresses are told about every move through the relocation callback.
+ *
+ * Pinned handles are never moved. Plain allocate() hands out permanently
+ * pinned blocks so the allocator can stand in for any IMemoryAllocator;
+ * compaction works around them.
+ *
+ * Every operation takes an internal mutex. Addresses from resolve() stay
+ * valid until the next compaction step, or for as long as the handle is
+ * pinned.
+ */
+class CompactingAllocator : public IMemoryAllocator {
+public:
+    /// Allocation granularity and per-block header size
+    static constexpr size_t GRANULE = 16;
+
+    /**
+     * @brief Stable reference to a relocatable block
+     */
+    struct Handle {
+        static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+        uint32_t index = INVALID_INDEX; ///< Slot in the handle table
+        uint32_t generation = 0;        ///< Detects handles to freed blocks
+
+        explicit operator bool() const { return index != INVALID_INDEX; }
+        bool operator==(const Handle& other) const {
+            return index == other.index && generation == other.generation;
+        }
+        bool operator!=(const Handle& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Called for every block moved by compaction
+     */
+    using RelocationCallback = std::function<void(Handle handle, void* old_address, void* new_address)>;
+
+    /**
+     * @brief Result of one compaction step
+     */
+    struct CompactionProgress {
+        size_t bytes_moved;      ///< Bytes copied during this step
+        size_t blocks_moved;     ///< Blocks relocated during this step
+        size_t fragmented_bytes; ///< Free bytes still trapped below the top of the heap
+        bool complete;           ///< Nothing left to move (pinned blocks aside)
+    };
+
+    /**
+     * @brief Constructor
+     * @param buffer Pre-allocated buffer to manage
+     * @param buffer_size Size of the buffer in bytes
+     * @param name Human-readable name for this allocator
+     */
+    CompactingAllocator(void* buffer, size_t buffer_size, std::string_view name = "Compacting");
+
+    /**
+     * @brief Constructor with self-managed buffer
+     * @param capacity Heap size in bytes
+     * @param name Human-readable name for this allocator
+     */
+    explicit CompactingAllocator(size_t capacity, std::string_view name = "Compacting");
+
+    /**
+     * @brief Destructor
+     */
+    ~CompactingAllocator() override;
+
+    CompactingAllocator(const CompactingAllocator&) = delete;
+    CompactingAllocator& operator=(const CompactingAllocator&) = delete;
+
+    // IMemoryAllocator implementation
+    HALResult<void*> allocate(size_t size, size_t alignment = alignof(std::max_align_t)) override;
+    HALResult<void> deallocate(void* ptr) override;
+    HALResult<void*> reallocate(void* ptr, size_t new_size) override;
+    AllocatorStats get_stats() const override;
+    AllocatorType get_type() const override;
+    std::string_view get_name() const override;
+    bool supports_size(size_t size) const override;
+    bool supports_alignment(size_t alignment) const override;
+    bool owns_pointer(void* ptr) const override;
+    HALResult<void> reset() override;
+
+    /**
+     * @brief Compact the whole heap
+     * @param callback Optional progress callback, invoked after every step
+     * @return HALResult indicating success or failure
+     */
+    HALResult<void> defragment(DefragmentationCallback callback = nullptr) override;
+
+    // Compacting allocator specific methods
+
+    /**
+     * @brief Allocate a relocatable block
+     * @param size Number of bytes to allocate
+     * @return HALResult containing the block's handle on success
+     */
+    HALResult<Handle> allocate_handle(size_t size);
+
+    /**
+     * @brief Free a relocatable block
+     * @param handle Handle from allocate_handle()
+     * @return HALResult indicating success or failure
+     */
+    HALResult<void> free_handle(Handle handle);
+
+    /**
+     * @brief Current address of a block
+     * @param handle Block handle
+     * @return Address, or nullptr for stale or invalid handles
+     */
+    void* resolve(Handle handle) const;
+
+    /**
+     * @brief Size requested for a block
+     * @param handle Block handle
+     * @return Size in bytes, or 0 for stale or invalid handles
+     */
+    size_t get_size(Handle handle) const;
+
+    /**
+     * @brief Prevent compaction from moving a block
+     * @param handle Block handle
+     * @return HALResult containing the block's address on success
+     */
+    HALResult<void*> pin(Handle handle);
+
+    /**
+     * @brief Release a pin taken with pin()
+     * @param handle Block handle
+     * @return HALResult indicating success or failure
+     */
+    HALResult<void> unpin(Handle handle);
+
+    /**
+     * @brief Set the callback invoked for every relocated block
+     *
+     * The callback runs with the allocator locked and must not call back
+     * into it.
+     * @param callback Callback, or nullptr to disable notifications
+     */
+    void set_relocation_callback(RelocationCallback callback);
+
+    /**
+     * @brief Compact failed allocations synchronously (default on)
+     * @param enabled Whether an allocation that fails for lack of
+     *        contiguous space compacts the heap and retries
+     */
+    void set_compact_on_failure(bool enabled);
+
+    /**
+     * @brief Move blocks until the heap is compact or the budget runs out
+     * @param budget Time budget; at least one block is moved per call
+     * @return HALResult containing the step's progress
+     */
+    HALResult<CompactionProgress> compact_step(std::chrono::microseconds budget);
+
+    /**
+     * @brief Get the largest allocation that would currently succeed
+     * @return Size in bytes of the largest contiguous free range, less the header
+     */
+    size_t get_largest_free_block() const;
+
+    /**
+     * @brief Get heap capacity
+     * @return Managed bytes, including block headers
+     */
+    size_t get_capacity() const { return capacity_; }
+
+private:
+    struct BlockHeader {
+        size_t size;    ///< Block size including this header
+        uint32_t slot;  ///< Handle table index
+        uint32_t check; ///< ~slot, detects foreign or corrupted pointers
+    };
+    static_assert(sizeof(BlockHeader) <= GRANULE, "Block header must fit in one granule");
+
+    struct Slot {
+        size_t offset;       ///< Block offset in the heap
+        size_t size;         ///< Requested size
+        uint32_t generation; ///< Incremented when the slot is freed
+        uint32_t pins;       ///< Pin count; PINNED_FOREVER for raw allocations
+        bool in_use;
+    };
+
+    static constexpr uint32_t PINNED_FOREVER = 0xFFFFFFFF;
+
+    uint8_t* base_;
+    size_t capacity_;
+    void* buffer_;
+    bool owns_buffer_;
+    std::string name_;
+
+    std::map<size_t, size_t> free_ranges_; ///< Offset -> size of holes below top_
+    size_t top_;                           ///< Everything from here to capacity_ is free
+    size_t scan_;                          ///< Compaction resumes from the first hole here
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_slots_;
+    RelocationCallback relocation_callback_;
+    bool compact_on_failure_;
+
+    size_t used_bytes_;
+    size_t allocation_count_;
+    size_t peak_used_bytes_;
+    size_t total_allocations_;
+
+    mutable std::mutex mutex_;
+
+    void initialize_heap(void* buffer, size_t buffer_size);
+    HALResult<Handle> allocate_locked(size_t size, uint32_t pins);
+    bool reserve_block(size_t block_size, size_t& offset);
+    void release_block(size_t offset, size_t block_size);
+    void release_slot(uint32_t index);
+    CompactionProgress compact_locked(std::chrono::steady_clock::time_point deadline, bool unbounded);
+    size_t free_bytes_below_top() const;
+    size_t largest_free_range() const;
+    const Slot* find_slot(Handle handle) const;
+    uint32_t slot_for_pointer(void* ptr) const;
+    BlockHeader* header_at(size_t offset) const {
+        return reinterpret_cast<BlockHeader*>(base_ + offset);
+    }
+};
+
+} // namespace flight::hal::allocators
@@ -12,6 +12,8 @@
 #include "../interfaces/memory.hpp"
 #include <atomic>
 #include <mutex>
+#include <string>
+#include <vector>
 
 namespace flight::hal::allocators {
 
@@ -21,6 +23,11 @@ namespace flight::hal::allocators {
  * Allocates memory sequentially from a pre-allocated buffer.
  * Provides extremely fast O(1) allocation but no individual deallocation.
  * Must be reset in bulk. Perfect for frame-based allocations.
+ *
+ * allocate() is lock-free: each call reserves its bytes with a single
+ * fetch_add on the position, so concurrent callers never wait on each
+ * other. reset(), set_position() and restore_checkpoint() must not race
+ * with allocation.
  */
 class LinearAllocator : public IMemoryAllocator {
 public:
@@ -67,7 +74,7 @@ public:
     
     /**
      * @brief Set position marker (for checkpoint/restore functionality)
-     * @param position Position to set
+     * @param position Position to set, rounded up to the allocator's base alignment
      * @return HALResult indicating success or failure
      */
     virtual HALResult<void> set_position(size_t position);
@@ -100,39 +107,32 @@ public:
 private:
     void* buffer_;                  ///< Memory buffer
     size_t buffer_size_;           ///< Total buffer size
-    std::atomic<size_t> position_; ///< Current allocation position
     bool owns_buffer_;             ///< Whether we own the buffer
     std::string name_;             ///< Allocator name
     
-    // Statistics (protected by mutex for thread safety)
-    mutable std::mutex stats_mutex_;
-    size_t allocation_count_;
-    size_t peak_usage_;
-    size_t total_allocations_;
+    // Hot counters, shared by all allocating threads
+    alignas(64) std::atomic<size_t> position_; ///< Current allocation position (may pass buffer_size_ on failure)
+    std::atomic<size_t> allocation_count_;      ///< Allocations since the last reset
+    
+    // Folded in at reset/rewind time, off the allocation path
+    std::atomic<size_t> peak_usage_;        ///< Highest position before a rewind
+    std::atomic<size_t> total_allocations_; ///< Allocations before the last reset
     
     // Helper methods
     bool is_aligned(size_t value, size_t alignment) const;
     size_t align_up(size_t value, size_t alignment) const;
-    void update_stats(size_t allocated_size);
+    void update_stats(size_t position);
 };
 
 /**
  * @brief Thread-safe linear allocator
  * 
- * Version of LinearAllocator with full thread safety.
- * Slightly slower but safe for multi-threaded use.
+ * LinearAllocator::allocate is itself lock-free and thread-safe; this name
+ * is kept for existing callers.
  */
 class ThreadSafeLinearAllocator : public LinearAllocator {
 public:
     using LinearAllocator::LinearAllocator;
-    
-    // Thread-safe overrides
-    HALResult<void*> allocate(size_t size, size_t alignment = alignof(std::max_align_t)) override;
-    HALResult<void> reset() override;
-    HALResult<void> set_position(size_t position) override;
-    
-private:
-    mutable std::mutex allocation_mutex_;
 };
 
 /**
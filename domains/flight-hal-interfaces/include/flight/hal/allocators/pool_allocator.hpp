@@ -11,7 +11,9 @@
 
 #include "../interfaces/memory.hpp"
 #include <atomic>
-#include <mutex>
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace flight::hal::allocators {
@@ -22,6 +24,13 @@ namespace flight::hal::allocators {
  * Manages a pool of fixed-size blocks with O(1) allocation and deallocation.
  * Zero fragmentation as all blocks are the same size. Perfect for objects
  * that are frequently allocated and deallocated.
+ *
+ * allocate() and deallocate() are lock-free and safe to call concurrently:
+ * free blocks form a stack of block indices whose head packs the top index
+ * with a version tag, updated by compare-exchange (the tag defeats ABA).
+ * deallocate() claims a block by compare-exchanging its link from
+ * ALLOCATED, so of two racing frees of one block exactly one succeeds.
+ * Statistics are relaxed atomics. reset() must not race with allocation.
  */
 class PoolAllocator : public IMemoryAllocator {
 public:
@@ -111,6 +120,9 @@ public:
     bool owns_buffer() const { return owns_buffer_; }
 
 private:
+    static constexpr uint32_t NO_BLOCK = 0xFFFFFFFFu;   ///< Empty free list
+    static constexpr uint32_t ALLOCATED = 0xFFFFFFFEu;  ///< Link of a block in use
+    
     void* buffer_;              ///< Memory buffer
     size_t buffer_size_;        ///< Total buffer size
     size_t block_size_;         ///< Size of each block
@@ -119,51 +131,40 @@ private:
     bool owns_buffer_;          ///< Whether we own the buffer
     std::string name_;          ///< Allocator name
     
-    // Free list management
-    void* free_head_;           ///< Head of free list
-    std::atomic<size_t> free_count_; ///< Number of free blocks
+    uint8_t* blocks_;           ///< First block (aligned)
+    size_t stride_;             ///< Distance between blocks
+    
+    /// Per-block link: next free index while free, ALLOCATED while in use.
+    /// Kept beside the blocks so a racing pop never reads user data.
+    std::unique_ptr<std::atomic<uint32_t>[]> links_;
     
-    // Statistics (protected by mutex for thread safety)
-    mutable std::mutex stats_mutex_;
-    size_t total_allocations_;
-    size_t peak_usage_;
+    // Free list management (hot, shared by all threads)
+    alignas(64) std::atomic<uint64_t> free_head_; ///< Version tag << 32 | top index
+    /// Blocks in use: raised after a block is popped and lowered before it
+    /// is pushed, so it never counts a block twice and never underflows
+    std::atomic<size_t> used_count_;
+    std::atomic<size_t> peak_usage_;              ///< Peak blocks in use
+    std::atomic<size_t> total_allocations_;       ///< Allocations since construction
     
     // Helper methods
     void initialize_free_list();
     bool is_valid_block_pointer(void* ptr) const;
     size_t get_block_index(void* ptr) const;
     void* get_block_at_index(size_t index) const;
-    void update_stats();
+    uint32_t pop_free_block();
+    void push_free_block(uint32_t index);
+    void update_stats(size_t used);
 };
 
 /**
  * @brief Thread-safe pool allocator
  * 
- * Version of PoolAllocator with full thread safety.
- * Uses lock-free operations where possible for maximum performance.
+ * PoolAllocator itself is lock-free and thread-safe; this name is kept for
+ * existing callers such as PoolManager.
  */
 class ThreadSafePoolAllocator : public PoolAllocator {
 public:
     using PoolAllocator::PoolAllocator;
-    
-    // Thread-safe overrides
-    HALResult<void*> allocate(size_t size, size_t alignment = alignof(std::max_align_t)) override;
-    HALResult<void> deallocate(void* ptr) override;
-    HALResult<void> reset() override;
-    
-    // Thread-safe pool-specific methods
-    size_t get_free_blocks() const;
-    size_t get_used_blocks() const;
-    bool is_full() const;
-    bool is_empty() const;
-    
-private:
-    mutable std::mutex allocation_mutex_;
-    std::atomic<void*> atomic_free_head_{nullptr};
-    
-    // Lock-free operations
-    void* pop_free_block();
-    void push_free_block(void* block);
 };
 
 /**
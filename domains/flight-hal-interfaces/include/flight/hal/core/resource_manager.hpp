@@ -22,6 +22,7 @@
 #include <mutex>
 #include <shared_mutex>
 #include <condition_variable>
+#include <vector>
 
 // Hash specialization for ResourceType, size_t pair
 namespace std {
@@ -108,6 +109,14 @@ using PressureCallback = std::function<void(coordination::ResourceType, Resource
  */
 using ReclamationCallback = std::function<size_t(coordination::ResourceType, size_t requested_bytes)>;
 
+/**
+ * @brief Priority of callbacks installed with set_reclamation_callback()
+ *
+ * Lower priorities run first, so cheap reclamation (dropping caches) should
+ * register below this and expensive reclamation (evicting live assets) above.
+ */
+constexpr uint32_t DEFAULT_RECLAMATION_PRIORITY = 100;
+
 /**
  * @brief RAII-based resource reference with automatic cleanup
  */
@@ -312,11 +321,33 @@ public:
     
     /**
      * @brief Set reclamation callback
+     *
+     * Replaces every callback registered for the type with one callback at
+     * DEFAULT_RECLAMATION_PRIORITY.
      */
     void set_reclamation_callback(coordination::ResourceType type, ReclamationCallback callback);
     
+    /**
+     * @brief Add a reclamation callback alongside existing ones
+     * @param type Resource type the callback reclaims
+     * @param priority Lower priorities run first
+     * @param callback Returns the number of bytes it released
+     * @return Callback ID for remove_reclamation_callback(), 0 if callback is empty
+     */
+    uint32_t add_reclamation_callback(coordination::ResourceType type, uint32_t priority,
+                                      ReclamationCallback callback);
+    
+    /**
+     * @brief Remove a callback added with add_reclamation_callback()
+     */
+    HALResult<void> remove_reclamation_callback(uint32_t callback_id);
+    
     /**
      * @brief Trigger emergency reclamation
+     *
+     * Runs the type's callbacks in priority order until requested_bytes
+     * have been reclaimed or every callback has run.
+     * @return Total bytes reclaimed
      */
     HALResult<size_t> emergency_reclamation(coordination::ResourceType type, size_t requested_bytes);
     
@@ -326,10 +357,17 @@ public:
     void update_pressure_levels();
 
 private:
+    struct ReclamationEntry {
+        uint32_t id;
+        uint32_t priority;
+        ReclamationCallback callback;
+    };
+    
     mutable std::shared_mutex budgets_mutex_;
     std::unordered_map<coordination::ResourceType, ResourceBudget> budgets_;
     std::unordered_map<coordination::ResourceType, ResourceStats> stats_;
-    std::unordered_map<coordination::ResourceType, ReclamationCallback> reclamation_callbacks_;
+    std::unordered_map<coordination::ResourceType, std::vector<ReclamationEntry>> reclamation_callbacks_; ///< Sorted by priority
+    uint32_t next_reclamation_id_ = 1;
     PressureCallback pressure_callback_;
     
     void notify_pressure_change(coordination::ResourceType type, ResourcePressure old_pressure, ResourcePressure new_pressure);
@@ -471,6 +509,16 @@ public:
      * @brief Register reclamation callback
      */
     void register_reclamation_callback(coordination::ResourceType type, ReclamationCallback callback);
+    
+    /**
+     * @brief Drive memory reclamation from a platform pressure monitor
+     *
+     * Runs the memory reclamation callbacks whenever the monitor reports
+     * Medium pressure or worse, reclaiming a larger share of tracked usage
+     * as pressure rises and everything reclaimable at Critical.
+     * @return Callback ID registered with the monitor
+     */
+    HALResult<uint32_t> attach_pressure_monitor(IMemoryPressureMonitor& monitor);
 
 private:
     ResourceManager() = default;
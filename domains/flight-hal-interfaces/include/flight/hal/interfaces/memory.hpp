@@ -71,7 +71,8 @@ enum class AllocatorType : uint8_t {
     Pool,           ///< Pool allocator (fixed-size, zero fragmentation)
     Buddy,          ///< Buddy allocator (power-of-2, low fragmentation)
     FreeList,       ///< Free list allocator (general purpose)
-    System          ///< System default allocator
+    System,         ///< System default allocator
+    Compacting      ///< Handle-based allocator that relocates blocks to defragment
 };
 
 /**
@@ -125,6 +126,8 @@ struct AllocatorStats {
     size_t used_bytes;           ///< Currently allocated bytes
     size_t free_bytes;           ///< Available bytes
     size_t allocation_count;     ///< Number of active allocations
+    size_t peak_used_bytes;      ///< Highest used_bytes seen (0 if not tracked)
+    size_t total_allocations;    ///< Allocations since construction (0 if not tracked)
     size_t allocation_overhead;  ///< Per-allocation overhead in bytes
     double fragmentation_ratio;  ///< Fragmentation ratio (0.0-1.0)
     bool supports_defrag;        ///< Whether defragmentation is supported
@@ -0,0 +1,193 @@
+/**
+ * @file linux_memory_pressure_monitor.hpp
+ * @brief Linux Memory Pressure Monitor
+ *
+ * Event-driven memory pressure detection built on pressure stall
+ * information (PSI) triggers and cgroup v2 memory events. Lets containerized
+ * processes shed memory while the kernel is still reclaiming, instead of
+ * finding out from the OOM killer.
+ */
+
+#pragma once
+
+#include "../interfaces/memory.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace flight::hal::platform {
+
+/**
+ * @brief Linux memory pressure monitor configuration
+ */
+struct LinuxMemoryPressureConfig {
+    /**
+     * @brief PSI trigger raising the pressure level
+     *
+     * Fires when tasks stalled on memory for stall_time within any window.
+     * "some" counts time at least one task stalled; "full" counts time all
+     * non-idle tasks stalled at once, i.e. the workload made no progress.
+     */
+    struct Trigger {
+        MemoryPressureLevel level;
+        bool full;
+        std::chrono::microseconds stall_time;
+        std::chrono::microseconds window;
+    };
+
+    /// Unprivileged processes may only use windows that are multiples of 2s
+    std::vector<Trigger> triggers = {
+        {MemoryPressureLevel::Low, false, std::chrono::milliseconds{100}, std::chrono::seconds{2}},
+        {MemoryPressureLevel::Medium, false, std::chrono::milliseconds{300}, std::chrono::seconds{2}},
+        {MemoryPressureLevel::High, true, std::chrono::milliseconds{200}, std::chrono::seconds{2}},
+        {MemoryPressureLevel::Critical, true, std::chrono::milliseconds{600}, std::chrono::seconds{2}},
+    };
+
+    /// cgroup v2 directory; empty detects the process's own cgroup
+    std::string cgroup_path;
+
+    /// Use system-wide /proc/pressure/memory even inside a cgroup
+    bool system_wide = false;
+
+    /// How long a level stays raised after its last event
+    std::chrono::milliseconds settle_time{2000};
+};
+
+/**
+ * @brief IMemoryPressureMonitor backed by PSI and cgroup v2
+ *
+ * A monitor thread sleeps in poll() on one PSI trigger per configured level
+ * and on the cgroup's memory.events file, so there is no periodic sampling:
+ * the kernel wakes the thread when stall time crosses a threshold or when
+ * the cgroup hits memory.high (Medium), memory.max (High) or the OOM killer
+ * runs (Critical). The current level is the highest one signalled within
+ * the last settle_time, so it decays as the events stop.
+ *
+ * On every level change, callbacks registered at or below the new level run
+ * on the monitor thread, in ascending order of their registered level. When
+ * Critical is reached the emergency reserve is released first, giving the
+ * callbacks headroom to work in.
+ *
+ * Without PSI or cgroup v2, start() fails and check_pressure() still reports
+ * usage from /proc/meminfo.
+ */
+class LinuxMemoryPressureMonitor : public IMemoryPressureMonitor {
+public:
+    /**
+     * @brief Constructor
+     * @param config Trigger thresholds and cgroup selection
+     */
+    explicit LinuxMemoryPressureMonitor(LinuxMemoryPressureConfig config = {});
+
+    /**
+     * @brief Destructor, stops the monitor thread
+     */
+    ~LinuxMemoryPressureMonitor() override;
+
+    LinuxMemoryPressureMonitor(const LinuxMemoryPressureMonitor&) = delete;
+    LinuxMemoryPressureMonitor& operator=(const LinuxMemoryPressureMonitor&) = delete;
+
+    /**
+     * @brief Arm the PSI triggers and start the monitor thread
+     * @return HALResult indicating success or failure
+     */
+    HALResult<void> start();
+
+    /**
+     * @brief Stop the monitor thread and close the triggers
+     */
+    void stop();
+
+    /**
+     * @brief Check if the monitor thread is running
+     */
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Get the PSI file the triggers are armed on
+     * @return Path, or an empty string when the kernel lacks PSI
+     */
+    const std::string& get_pressure_path() const { return pressure_path_; }
+
+    // IMemoryPressureMonitor implementation
+    HALResult<uint32_t> register_callback(MemoryPressureLevel level,
+                                          MemoryPressureCallback callback) override;
+    HALResult<void> unregister_callback(uint32_t callback_id) override;
+    MemoryPressureInfo get_pressure_info() const override;
+
+    /**
+     * @brief Re-read PSI averages and cgroup events synchronously
+     *
+     * Derives a level from the avg10 stall percentages using the trigger
+     * thresholds. If the level changes, callbacks run on the monitor thread
+     * when it is running; otherwise they run on the calling thread before
+     * this returns.
+     */
+    HALResult<void> check_pressure() override;
+
+    /**
+     * @brief Set emergency memory reserve
+     *
+     * The reserve is committed memory that is released when pressure turns
+     * Critical and re-acquired once pressure is gone.
+     */
+    HALResult<void> set_emergency_reserve(size_t bytes) override;
+    size_t get_emergency_reserve() const override;
+
+private:
+    struct CallbackEntry {
+        uint32_t id;
+        MemoryPressureLevel level;
+        MemoryPressureCallback callback;
+    };
+
+    /// memory.events counters that map onto pressure levels
+    struct CgroupEvents {
+        uint64_t high = 0;
+        uint64_t max = 0;
+        uint64_t oom = 0;
+        uint64_t oom_kill = 0;
+    };
+
+    LinuxMemoryPressureConfig config_;
+    std::string cgroup_path_;
+    std::string pressure_path_;
+
+    std::vector<int> trigger_fds_; ///< Parallel to config_.triggers
+    int events_fd_;
+    int wake_fd_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+
+    mutable std::mutex state_mutex_;
+    MemoryPressureLevel level_;
+    std::chrono::steady_clock::time_point fired_[5]; ///< Last event per level
+    double pressure_ratio_;
+    uint64_t last_pressure_time_;
+    CgroupEvents events_;
+
+    std::mutex callbacks_mutex_;
+    std::vector<CallbackEntry> callbacks_; ///< Sorted by level
+    uint32_t next_callback_id_;
+
+    mutable std::mutex reserve_mutex_;
+    size_t reserve_size_;
+    std::unique_ptr<uint8_t[]> reserve_;
+
+    void monitor_loop();
+    void close_fds();
+    MemoryPressureLevel read_cgroup_events();
+    double read_stall_average(bool full) const;
+    size_t read_available_bytes() const;
+    void raise_level(MemoryPressureLevel level);
+    int settle_level();
+    void notify(MemoryPressureLevel level);
+    void acquire_reserve_locked();
+};
+
+} // namespace flight::hal::platform
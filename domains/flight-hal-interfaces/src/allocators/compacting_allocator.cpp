@@ -0,0 +1,494 @@
+/**
+ * @file compacting_allocator.cpp
+ * @brief Compacting Allocator Implementation
+ *
+ * First-fit heap over an address-ordered hole map, with sliding compaction
+ * that moves each block down into the hole in front of it.
+ */
+
+#include "../../include/flight/hal/allocators/compacting_allocator.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace flight::hal::allocators {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+bool is_power_of_two(size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+// Compaction under defragment() releases the lock between slices this long
+constexpr std::chrono::microseconds DEFRAGMENT_SLICE{1000};
+
+} // anonymous namespace
+
+// =====================================================================
+// CompactingAllocator Implementation
+// =====================================================================
+
+CompactingAllocator::CompactingAllocator(void* buffer, size_t buffer_size, std::string_view name)
+    : base_(nullptr), capacity_(0), buffer_(buffer), owns_buffer_(false), name_(name),
+      top_(0), scan_(0), compact_on_failure_(true), used_bytes_(0), allocation_count_(0), peak_used_bytes_(0), total_allocations_(0) {
+    initialize_heap(buffer, buffer ? buffer_size : 0);
+}
+
+CompactingAllocator::CompactingAllocator(size_t capacity, std::string_view name)
+    : base_(nullptr), capacity_(0), buffer_(nullptr), owns_buffer_(false), name_(name),
+      top_(0), scan_(0), compact_on_failure_(true), used_bytes_(0), allocation_count_(0), peak_used_bytes_(0), total_allocations_(0) {
+    capacity = capacity & ~(GRANULE - 1);
+    if (capacity > 0) {
+        buffer_ = ::operator new(capacity, std::align_val_t(GRANULE), std::nothrow);
+        owns_buffer_ = buffer_ != nullptr;
+    }
+    initialize_heap(buffer_, owns_buffer_ ? capacity : 0);
+}
+
+CompactingAllocator::~CompactingAllocator() {
+    if (owns_buffer_) {
+        ::operator delete(buffer_, std::align_val_t(GRANULE));
+    }
+}
+
+HALResult<void*> CompactingAllocator::allocate(size_t size, size_t alignment) {
+    if (!supports_alignment(alignment)) {
+        return HALResult<void*>::error(errors::invalid_parameter(2, "Alignment exceeds allocator granule"));
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Raw pointers cannot be fixed up, so these blocks never move
+    auto result = allocate_locked(size, PINNED_FOREVER);
+    if (!result) {
+        return HALResult<void*>::error(result.error());
+    }
+    return HALResult<void*>::success(base_ + slots_[result.value().index].offset + GRANULE);
+}
+
+HALResult<void> CompactingAllocator::deallocate(void* ptr) {
+    if (!ptr) {
+        return HALResult<void>::success();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint32_t index = slot_for_pointer(ptr);
+    if (index == Handle::INVALID_INDEX) {
+        return HALResult<void>::error(errors::invalid_parameter(3, "Pointer not owned by compacting allocator"));
+    }
+    release_slot(index);
+    return HALResult<void>::success();
+}
+
+HALResult<void*> CompactingAllocator::reallocate(void* ptr, size_t new_size) {
+    if (!ptr) {
+        return allocate(new_size);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint32_t index = slot_for_pointer(ptr);
+    if (index == Handle::INVALID_INDEX) {
+        return HALResult<void*>::error(errors::invalid_parameter(3, "Pointer not owned by compacting allocator"));
+    }
+
+    Slot& slot = slots_[index];
+    if (header_at(slot.offset)->size - GRANULE >= new_size) {
+        slot.size = new_size;
+        return HALResult<void*>::success(ptr);
+    }
+
+    // Keep the old block in place while a retry compacts around it
+    const uint32_t pins = slot.pins;
+    slot.pins = PINNED_FOREVER;
+    auto result = allocate_locked(new_size, PINNED_FOREVER);
+    slots_[index].pins = pins;
+    if (!result) {
+        return HALResult<void*>::error(result.error());
+    }
+    void* moved = base_ + slots_[result.value().index].offset + GRANULE;
+    std::memcpy(moved, ptr, std::min(slots_[index].size, new_size));
+    release_slot(index);
+    return HALResult<void*>::success(moved);
+}
+
+AllocatorStats CompactingAllocator::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t free_bytes = capacity_ - used_bytes_;
+    const size_t largest = largest_free_range();
+
+    AllocatorStats stats{};
+    stats.type = AllocatorType::Compacting;
+    stats.name = name_;
+    stats.total_capacity = capacity_;
+    stats.used_bytes = used_bytes_;
+    stats.free_bytes = free_bytes;
+    stats.allocation_count = allocation_count_;
+    stats.peak_used_bytes = peak_used_bytes_;
+    stats.total_allocations = total_allocations_;
+    stats.allocation_overhead = GRANULE;
+    stats.fragmentation_ratio = free_bytes > 0 ? 1.0 - static_cast<double>(largest) / free_bytes : 0.0;
+    stats.supports_defrag = true;
+    return stats;
+}
+
+AllocatorType CompactingAllocator::get_type() const {
+    return AllocatorType::Compacting;
+}
+
+std::string_view CompactingAllocator::get_name() const {
+    return name_;
+}
+
+bool CompactingAllocator::supports_size(size_t size) const {
+    return size <= capacity_ && capacity_ - size >= GRANULE;
+}
+
+bool CompactingAllocator::supports_alignment(size_t alignment) const {
+    return is_power_of_two(alignment) && alignment <= GRANULE;
+}
+
+bool CompactingAllocator::owns_pointer(void* ptr) const {
+    const uint8_t* p = static_cast<const uint8_t*>(ptr);
+    return base_ && p >= base_ && p < base_ + capacity_;
+}
+
+HALResult<void> CompactingAllocator::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_slots_.clear();
+    for (size_t i = slots_.size(); i-- > 0;) {
+        if (slots_[i].in_use) {
+            slots_[i].in_use = false;
+            ++slots_[i].generation;
+        }
+        free_slots_.push_back(static_cast<uint32_t>(i));
+    }
+    free_ranges_.clear();
+    top_ = 0;
+    scan_ = 0;
+    used_bytes_ = 0;
+    allocation_count_ = 0;
+    return HALResult<void>::success();
+}
+
+HALResult<void> CompactingAllocator::defragment(DefragmentationCallback callback) {
+    size_t total = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Everything above the first hole moves once
+        if (!free_ranges_.empty()) {
+            total = top_ - free_ranges_.begin()->first - free_bytes_below_top();
+        }
+        scan_ = 0;
+    }
+
+    size_t moved = 0;
+    for (;;) {
+        CompactionProgress progress;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            progress = compact_locked(Clock::now() + DEFRAGMENT_SLICE, false);
+        }
+        moved += progress.bytes_moved;
+        if (callback) {
+            const double fraction = progress.complete || total == 0
+                                        ? 1.0
+                                        : std::min(1.0, static_cast<double>(moved) / total);
+            callback(moved, total, fraction);
+        }
+        if (progress.complete) {
+            return HALResult<void>::success();
+        }
+    }
+}
+
+HALResult<CompactingAllocator::Handle> CompactingAllocator::allocate_handle(size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return allocate_locked(size, 0);
+}
+
+HALResult<void> CompactingAllocator::free_handle(Handle handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!find_slot(handle)) {
+        return HALResult<void>::error(errors::invalid_parameter(4, "Stale or invalid handle"));
+    }
+    release_slot(handle.index);
+    return HALResult<void>::success();
+}
+
+void* CompactingAllocator::resolve(Handle handle) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Slot* slot = find_slot(handle);
+    return slot ? base_ + slot->offset + GRANULE : nullptr;
+}
+
+size_t CompactingAllocator::get_size(Handle handle) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Slot* slot = find_slot(handle);
+    return slot ? slot->size : 0;
+}
+
+HALResult<void*> CompactingAllocator::pin(Handle handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!find_slot(handle)) {
+        return HALResult<void*>::error(errors::invalid_parameter(4, "Stale or invalid handle"));
+    }
+    Slot& slot = slots_[handle.index];
+    if (slot.pins == PINNED_FOREVER - 1) {
+        return HALResult<void*>::error(errors::invalid_state(2, "Pin count overflow"));
+    }
+    if (slot.pins != PINNED_FOREVER) {
+        ++slot.pins;
+    }
+    return HALResult<void*>::success(base_ + slot.offset + GRANULE);
+}
+
+HALResult<void> CompactingAllocator::unpin(Handle handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!find_slot(handle)) {
+        return HALResult<void>::error(errors::invalid_parameter(4, "Stale or invalid handle"));
+    }
+    Slot& slot = slots_[handle.index];
+    if (slot.pins == 0 || slot.pins == PINNED_FOREVER) {
+        return HALResult<void>::error(errors::invalid_state(1, "Handle is not pinned"));
+    }
+    if (--slot.pins == 0) {
+        // Holes in front of this block can be closed again
+        scan_ = 0;
+    }
+    return HALResult<void>::success();
+}
+
+void CompactingAllocator::set_relocation_callback(RelocationCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    relocation_callback_ = std::move(callback);
+}
+
+void CompactingAllocator::set_compact_on_failure(bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    compact_on_failure_ = enabled;
+}
+
+HALResult<CompactingAllocator::CompactionProgress> CompactingAllocator::compact_step(std::chrono::microseconds budget) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return HALResult<CompactionProgress>::success(compact_locked(Clock::now() + budget, false));
+}
+
+size_t CompactingAllocator::get_largest_free_block() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t largest = largest_free_range();
+    return largest > GRANULE ? largest - GRANULE : 0;
+}
+
+void CompactingAllocator::initialize_heap(void* buffer, size_t buffer_size) {
+    if (!buffer) {
+        return;
+    }
+    const uintptr_t address = reinterpret_cast<uintptr_t>(buffer);
+    const uintptr_t aligned = (address + GRANULE - 1) & ~(uintptr_t(GRANULE) - 1);
+    const size_t padding = aligned - address;
+    if (padding < buffer_size) {
+        base_ = reinterpret_cast<uint8_t*>(aligned);
+        capacity_ = (buffer_size - padding) & ~(GRANULE - 1);
+    }
+}
+
+HALResult<CompactingAllocator::Handle> CompactingAllocator::allocate_locked(size_t size, uint32_t pins) {
+    if (!supports_size(size)) {
+        return HALResult<Handle>::error(errors::out_of_memory(1, "Allocation exceeds heap capacity"));
+    }
+    const size_t block_size = (std::max<size_t>(size, 1) + GRANULE + GRANULE - 1) & ~(GRANULE - 1);
+
+    size_t offset = 0;
+    if (!reserve_block(block_size, offset)) {
+        // Enough memory in total but no hole big enough: compact and retry
+        if (!compact_on_failure_ || capacity_ - used_bytes_ < block_size) {
+            return HALResult<Handle>::error(errors::out_of_memory(2, "Compacting allocator exhausted"));
+        }
+        scan_ = 0;
+        compact_locked(Clock::time_point{}, true);
+        if (!reserve_block(block_size, offset)) {
+            return HALResult<Handle>::error(errors::out_of_memory(3, "Heap too fragmented by pinned blocks"));
+        }
+    }
+
+    uint32_t index;
+    if (!free_slots_.empty()) {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+    } else if (slots_.size() < Handle::INVALID_INDEX) {
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.push_back(Slot{0, 0, 0, 0, false});
+    } else {
+        release_block(offset, block_size);
+        return HALResult<Handle>::error(errors::out_of_memory(4, "Handle table exhausted"));
+    }
+
+    BlockHeader* header = header_at(offset);
+    header->size = block_size;
+    header->slot = index;
+    header->check = ~index;
+
+    Slot& slot = slots_[index];
+    slot.offset = offset;
+    slot.size = size;
+    slot.pins = pins;
+    slot.in_use = true;
+
+    used_bytes_ += block_size;
+    ++allocation_count_;
+    peak_used_bytes_ = std::max(peak_used_bytes_, used_bytes_);
+    ++total_allocations_;
+    return HALResult<Handle>::success(Handle{index, slot.generation});
+}
+
+bool CompactingAllocator::reserve_block(size_t block_size, size_t& offset) {
+    for (auto it = free_ranges_.begin(); it != free_ranges_.end(); ++it) {
+        if (it->second >= block_size) {
+            offset = it->first;
+            const size_t rest = it->second - block_size;
+            free_ranges_.erase(it);
+            if (rest > 0) {
+                free_ranges_.emplace(offset + block_size, rest);
+            }
+            return true;
+        }
+    }
+    if (capacity_ - top_ >= block_size) {
+        offset = top_;
+        top_ += block_size;
+        return true;
+    }
+    return false;
+}
+
+void CompactingAllocator::release_block(size_t offset, size_t block_size) {
+    size_t start = offset;
+    size_t size = block_size;
+
+    // Coalesce with the hole in front
+    auto next = free_ranges_.lower_bound(offset);
+    if (next != free_ranges_.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == start) {
+            start = previous->first;
+            size += previous->second;
+            free_ranges_.erase(previous);
+        }
+    }
+
+    if (start + size == top_) {
+        top_ = start;
+    } else {
+        // Coalesce with the hole behind
+        if (next != free_ranges_.end() && next->first == start + size) {
+            size += next->second;
+            free_ranges_.erase(next);
+        }
+        free_ranges_.emplace(start, size);
+    }
+    scan_ = std::min(scan_, start);
+}
+
+void CompactingAllocator::release_slot(uint32_t index) {
+    Slot& slot = slots_[index];
+    const size_t block_size = header_at(slot.offset)->size;
+    header_at(slot.offset)->check = 0;
+    release_block(slot.offset, block_size);
+    slot.in_use = false;
+    ++slot.generation;
+    free_slots_.push_back(index);
+    used_bytes_ -= block_size;
+    --allocation_count_;
+}
+
+CompactingAllocator::CompactionProgress CompactingAllocator::compact_locked(Clock::time_point deadline, bool unbounded) {
+    CompactionProgress progress{0, 0, 0, false};
+    for (;;) {
+        auto hole = free_ranges_.lower_bound(scan_);
+        if (hole == free_ranges_.end()) {
+            progress.complete = true;
+            scan_ = 0;
+            break;
+        }
+        if (!unbounded && progress.blocks_moved > 0 && Clock::now() >= deadline) {
+            break;
+        }
+
+        // Holes never touch each other or top_, so a live block follows
+        const size_t hole_offset = hole->first;
+        size_t hole_size = hole->second;
+        const size_t block_offset = hole_offset + hole_size;
+        const BlockHeader* header = header_at(block_offset);
+        const size_t block_size = header->size;
+        const uint32_t index = header->slot;
+        Slot& slot = slots_[index];
+        if (slot.pins != 0) {
+            scan_ = block_offset + block_size;
+            continue;
+        }
+
+        // Slide the block down; the hole moves up behind it
+        std::memmove(base_ + hole_offset, base_ + block_offset, block_size);
+        slot.offset = hole_offset;
+        free_ranges_.erase(hole);
+
+        const size_t new_hole = hole_offset + block_size;
+        if (new_hole + hole_size == top_) {
+            top_ = new_hole;
+        } else {
+            auto following = free_ranges_.find(new_hole + hole_size);
+            if (following != free_ranges_.end()) {
+                hole_size += following->second;
+                free_ranges_.erase(following);
+            }
+            free_ranges_.emplace(new_hole, hole_size);
+        }
+
+        progress.bytes_moved += block_size;
+        ++progress.blocks_moved;
+        if (relocation_callback_) {
+            relocation_callback_(Handle{index, slot.generation}, base_ + block_offset + GRANULE,
+                                 base_ + hole_offset + GRANULE);
+        }
+    }
+    progress.fragmented_bytes = free_bytes_below_top();
+    return progress;
+}
+
+size_t CompactingAllocator::free_bytes_below_top() const {
+    return top_ - used_bytes_;
+}
+
+size_t CompactingAllocator::largest_free_range() const {
+    size_t largest = capacity_ - top_;
+    for (const auto& range : free_ranges_) {
+        largest = std::max(largest, range.second);
+    }
+    return largest;
+}
+
+const CompactingAllocator::Slot* CompactingAllocator::find_slot(Handle handle) const {
+    if (handle.index >= slots_.size()) {
+        return nullptr;
+    }
+    const Slot& slot = slots_[handle.index];
+    return slot.in_use && slot.generation == handle.generation ? &slot : nullptr;
+}
+
+uint32_t CompactingAllocator::slot_for_pointer(void* ptr) const {
+    if (!owns_pointer(ptr)) {
+        return Handle::INVALID_INDEX;
+    }
+    const size_t position = static_cast<size_t>(static_cast<uint8_t*>(ptr) - base_);
+    if (position < GRANULE || position % GRANULE != 0 || position - GRANULE >= top_) {
+        return Handle::INVALID_INDEX;
+    }
+    const size_t offset = position - GRANULE;
+    const BlockHeader* header = header_at(offset);
+    const uint32_t index = header->slot;
+    if (header->check != ~index || index >= slots_.size() || !slots_[index].in_use ||
+        slots_[index].offset != offset) {
+        return Handle::INVALID_INDEX;
+    }
+    return index;
+}
+
+} // namespace flight::hal::allocators
@@ -0,0 +1,242 @@
+/**
+ * @file linear_allocator.cpp
+ * @brief Linear/Arena Allocator Implementation
+ *
+ * Lock-free bump allocation with checkpoint/restore and frame stacks.
+ */
+
+#include "../../include/flight/hal/allocators/linear_allocator.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace flight::hal::allocators {
+
+namespace {
+
+// Positions advance in multiples of this so default-aligned requests need no padding
+constexpr size_t BASE_ALIGNMENT = alignof(std::max_align_t);
+
+bool is_power_of_two(size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+} // anonymous namespace
+
+// =====================================================================
+// LinearAllocator Implementation
+// =====================================================================
+
+LinearAllocator::LinearAllocator(void* buffer, size_t size, std::string_view name)
+    : buffer_(buffer), buffer_size_(buffer ? size : 0), owns_buffer_(false), name_(name),
+      position_(0), allocation_count_(0), peak_usage_(0), total_allocations_(0) {}
+
+LinearAllocator::LinearAllocator(size_t size, std::string_view name)
+    : buffer_(nullptr), buffer_size_(0), owns_buffer_(false), name_(name),
+      position_(0), allocation_count_(0), peak_usage_(0), total_allocations_(0) {
+    if (size > 0) {
+        buffer_ = ::operator new(size, std::nothrow);
+        if (buffer_) {
+            buffer_size_ = size;
+            owns_buffer_ = true;
+        }
+    }
+}
+
+LinearAllocator::~LinearAllocator() {
+    if (owns_buffer_) {
+        ::operator delete(buffer_);
+    }
+}
+
+HALResult<void*> LinearAllocator::allocate(size_t size, size_t alignment) {
+    if (!is_power_of_two(alignment)) {
+        return HALResult<void*>::error(errors::invalid_parameter(1, "Alignment must be a power of two"));
+    }
+    if (size > buffer_size_ || alignment > buffer_size_) {
+        return HALResult<void*>::error(errors::out_of_memory(1, "Linear allocator exhausted"));
+    }
+
+    // Reserve the worst-case padding up front so the aligned start can be
+    // found inside our own range, without a compare-exchange loop
+    const uintptr_t base = reinterpret_cast<uintptr_t>(buffer_);
+    const bool base_aligned = base % BASE_ALIGNMENT == 0;
+    const size_t padding = (alignment <= BASE_ALIGNMENT && base_aligned) ? 0 : alignment - 1;
+    const size_t reserved = align_up(std::max<size_t>(size, 1) + padding, BASE_ALIGNMENT);
+
+    const size_t start = position_.fetch_add(reserved, std::memory_order_relaxed);
+    if (start > buffer_size_ || reserved > buffer_size_ - start) {
+        // Give the range back if nobody reserved after us
+        size_t expected = start + reserved;
+        position_.compare_exchange_strong(expected, start, std::memory_order_relaxed);
+        return HALResult<void*>::error(errors::out_of_memory(1, "Linear allocator exhausted"));
+    }
+
+    allocation_count_.fetch_add(1, std::memory_order_relaxed);
+    const uintptr_t aligned = (base + start + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    return HALResult<void*>::success(reinterpret_cast<void*>(aligned));
+}
+
+HALResult<void> LinearAllocator::deallocate(void* ptr) {
+    // Individual blocks are reclaimed in bulk by reset() or a checkpoint
+    if (ptr && !owns_pointer(ptr)) {
+        return HALResult<void>::error(errors::invalid_parameter(3, "Pointer not owned by linear allocator"));
+    }
+    return HALResult<void>::success();
+}
+
+HALResult<void*> LinearAllocator::reallocate(void* ptr, size_t new_size) {
+    if (!ptr) {
+        return allocate(new_size);
+    }
+    if (!owns_pointer(ptr)) {
+        return HALResult<void*>::error(errors::invalid_parameter(3, "Pointer not owned by linear allocator"));
+    }
+
+    // The old size is unknown; it cannot extend past what was handed out
+    const size_t old_end = get_position();
+    const size_t offset = static_cast<size_t>(static_cast<uint8_t*>(ptr) - static_cast<uint8_t*>(buffer_));
+    auto result = allocate(new_size);
+    if (!result) {
+        return result;
+    }
+    std::memmove(result.value(), ptr, std::min(new_size, old_end > offset ? old_end - offset : 0));
+    return result;
+}
+
+AllocatorStats LinearAllocator::get_stats() const {
+    const size_t used = get_position();
+
+    AllocatorStats stats{};
+    stats.type = AllocatorType::Linear;
+    stats.name = name_;
+    stats.total_capacity = buffer_size_;
+    stats.used_bytes = used;
+    stats.free_bytes = buffer_size_ - used;
+    stats.allocation_count = allocation_count_.load(std::memory_order_relaxed);
+    stats.peak_used_bytes = std::max(peak_usage_.load(std::memory_order_relaxed), used);
+    stats.total_allocations = total_allocations_.load(std::memory_order_relaxed) + stats.allocation_count;
+    stats.allocation_overhead = 0;
+    stats.fragmentation_ratio = 0.0;
+    stats.supports_defrag = false;
+    return stats;
+}
+
+AllocatorType LinearAllocator::get_type() const {
+    return AllocatorType::Linear;
+}
+
+std::string_view LinearAllocator::get_name() const {
+    return name_;
+}
+
+bool LinearAllocator::supports_size(size_t size) const {
+    return size <= buffer_size_;
+}
+
+bool LinearAllocator::supports_alignment(size_t alignment) const {
+    return is_power_of_two(alignment) && alignment <= buffer_size_;
+}
+
+bool LinearAllocator::owns_pointer(void* ptr) const {
+    const uint8_t* p = static_cast<const uint8_t*>(ptr);
+    const uint8_t* base = static_cast<const uint8_t*>(buffer_);
+    return base && p >= base && p < base + buffer_size_;
+}
+
+HALResult<void> LinearAllocator::reset() {
+    update_stats(position_.load(std::memory_order_relaxed));
+    total_allocations_.fetch_add(allocation_count_.exchange(0, std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+    position_.store(0, std::memory_order_relaxed);
+    return HALResult<void>::success();
+}
+
+HALResult<void> LinearAllocator::defragment(DefragmentationCallback callback) {
+    // Allocations are contiguous; nothing to compact
+    if (callback) {
+        callback(0, 0, 1.0);
+    }
+    return HALResult<void>::success();
+}
+
+size_t LinearAllocator::get_position() const {
+    // A failed reservation can leave the position past the end until reset
+    return std::min(position_.load(std::memory_order_relaxed), buffer_size_);
+}
+
+HALResult<void> LinearAllocator::set_position(size_t position) {
+    if (position > buffer_size_) {
+        return HALResult<void>::error(errors::parameter_out_of_range(1, "Position beyond buffer"));
+    }
+    update_stats(position_.load(std::memory_order_relaxed));
+    // allocate() relies on every reservation starting base-aligned
+    position_.store(align_up(position, BASE_ALIGNMENT), std::memory_order_relaxed);
+    return HALResult<void>::success();
+}
+
+size_t LinearAllocator::create_checkpoint() const {
+    return get_position();
+}
+
+HALResult<void> LinearAllocator::restore_checkpoint(size_t checkpoint) {
+    return set_position(checkpoint);
+}
+
+size_t LinearAllocator::get_remaining_space() const {
+    return buffer_size_ - get_position();
+}
+
+bool LinearAllocator::is_aligned(size_t value, size_t alignment) const {
+    return (value & (alignment - 1)) == 0;
+}
+
+size_t LinearAllocator::align_up(size_t value, size_t alignment) const {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+void LinearAllocator::update_stats(size_t position) {
+    // Positions only grow between rewinds, so the peak is folded in here
+    // rather than on every allocation
+    position = std::min(position, buffer_size_);
+    size_t peak = peak_usage_.load(std::memory_order_relaxed);
+    while (position > peak && !peak_usage_.compare_exchange_weak(peak, position, std::memory_order_relaxed)) {
+    }
+}
+
+// =====================================================================
+// StackLinearAllocator Implementation
+// =====================================================================
+
+size_t StackLinearAllocator::push_frame() {
+    std::lock_guard<std::mutex> lock(frame_mutex_);
+    frame_stack_.push_back(get_position());
+    return frame_stack_.size() - 1;
+}
+
+HALResult<void> StackLinearAllocator::pop_frame() {
+    std::lock_guard<std::mutex> lock(frame_mutex_);
+    if (frame_stack_.empty()) {
+        return HALResult<void>::error(errors::invalid_state(1, "No frame to pop"));
+    }
+    const size_t position = frame_stack_.back();
+    frame_stack_.pop_back();
+    return set_position(position);
+}
+
+HALResult<void> StackLinearAllocator::pop_to_frame(size_t frame_id) {
+    std::lock_guard<std::mutex> lock(frame_mutex_);
+    if (frame_id >= frame_stack_.size()) {
+        return HALResult<void>::error(errors::invalid_parameter(2, "Unknown frame"));
+    }
+    const size_t position = frame_stack_[frame_id];
+    frame_stack_.resize(frame_id);
+    return set_position(position);
+}
+
+size_t StackLinearAllocator::get_frame_depth() const {
+    std::lock_guard<std::mutex> lock(frame_mutex_);
+    return frame_stack_.size();
+}
+
+} // namespace flight::hal::allocators
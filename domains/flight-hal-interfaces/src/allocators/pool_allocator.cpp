@@ -0,0 +1,420 @@
+/**
+ * @file pool_allocator.cpp
+ * @brief Pool Allocator Implementation
+ *
+ * Lock-free fixed-size block pools and the multi-size pool built on them.
+ */
+
+#include "../../include/flight/hal/allocators/pool_allocator.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace flight::hal::allocators {
+
+namespace {
+
+bool is_power_of_two(size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+size_t normalize_alignment(size_t alignment) {
+    return is_power_of_two(alignment) ? alignment : alignof(std::max_align_t);
+}
+
+size_t block_stride(size_t block_size, size_t alignment) {
+    const size_t size = std::max<size_t>(block_size, 1);
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+// The free list packs a 32-bit block index, so pools stop short of the sentinels
+constexpr size_t MAX_BLOCKS = 0xFFFFFFF0u;
+
+uint64_t next_head(uint64_t head, uint32_t index) {
+    return (((head >> 32) + 1) << 32) | index;
+}
+
+} // anonymous namespace
+
+// =====================================================================
+// PoolAllocator Implementation
+// =====================================================================
+
+PoolAllocator::PoolAllocator(void* buffer, size_t buffer_size, size_t block_size,
+                             size_t alignment, std::string_view name)
+    : buffer_(buffer), buffer_size_(buffer_size), block_size_(block_size), block_count_(0),
+      alignment_(normalize_alignment(alignment)), owns_buffer_(false), name_(name),
+      blocks_(nullptr), stride_(block_stride(block_size, alignment_)),
+      free_head_(NO_BLOCK), used_count_(0), peak_usage_(0), total_allocations_(0) {
+    if (buffer_) {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(buffer_);
+        const uintptr_t first = (base + alignment_ - 1) & ~(uintptr_t(alignment_) - 1);
+        const size_t padding = first - base;
+        if (padding < buffer_size_) {
+            blocks_ = reinterpret_cast<uint8_t*>(first);
+            block_count_ = std::min((buffer_size_ - padding) / stride_, MAX_BLOCKS);
+        }
+    }
+    initialize_free_list();
+}
+
+PoolAllocator::PoolAllocator(size_t block_count, size_t block_size,
+                             size_t alignment, std::string_view name)
+    : buffer_(nullptr), buffer_size_(0), block_size_(block_size), block_count_(0),
+      alignment_(normalize_alignment(alignment)), owns_buffer_(false), name_(name),
+      blocks_(nullptr), stride_(block_stride(block_size, alignment_)),
+      free_head_(NO_BLOCK), used_count_(0), peak_usage_(0), total_allocations_(0) {
+    block_count = std::min(block_count, MAX_BLOCKS);
+    if (block_count > 0 && stride_ <= SIZE_MAX / block_count) {
+        buffer_ = ::operator new(block_count * stride_, std::align_val_t(alignment_), std::nothrow);
+        if (buffer_) {
+            buffer_size_ = block_count * stride_;
+            blocks_ = static_cast<uint8_t*>(buffer_);
+            block_count_ = block_count;
+            owns_buffer_ = true;
+        }
+    }
+    initialize_free_list();
+}
+
+PoolAllocator::~PoolAllocator() {
+    if (owns_buffer_) {
+        ::operator delete(buffer_, std::align_val_t(alignment_));
+    }
+}
+
+HALResult<void*> PoolAllocator::allocate(size_t size, size_t alignment) {
+    if (size > block_size_) {
+        return HALResult<void*>::error(errors::invalid_parameter(1, "Size exceeds pool block size"));
+    }
+    if (!supports_alignment(alignment)) {
+        return HALResult<void*>::error(errors::invalid_parameter(2, "Alignment exceeds pool alignment"));
+    }
+
+    const uint32_t index = pop_free_block();
+    if (index == NO_BLOCK) {
+        return HALResult<void*>::error(errors::out_of_memory(1, "Pool exhausted"));
+    }
+
+    update_stats(used_count_.fetch_add(1, std::memory_order_relaxed) + 1);
+    return HALResult<void*>::success(get_block_at_index(index));
+}
+
+HALResult<void> PoolAllocator::deallocate(void* ptr) {
+    if (!ptr) {
+        return HALResult<void>::success();
+    }
+    if (!is_valid_block_pointer(ptr)) {
+        return HALResult<void>::error(errors::invalid_parameter(3, "Pointer not owned by pool"));
+    }
+
+    // Claim the block before pushing it: a racing second free of the same
+    // block finds the link already changed and fails
+    const uint32_t index = static_cast<uint32_t>(get_block_index(ptr));
+    uint32_t expected = ALLOCATED;
+    if (!links_[index].compare_exchange_strong(expected, NO_BLOCK, std::memory_order_relaxed)) {
+        return HALResult<void>::error(errors::invalid_state(1, "Double free of pool block"));
+    }
+
+    used_count_.fetch_sub(1, std::memory_order_relaxed);
+    push_free_block(index);
+    return HALResult<void>::success();
+}
+
+HALResult<void*> PoolAllocator::reallocate(void* ptr, size_t new_size) {
+    if (!ptr) {
+        return allocate(new_size);
+    }
+    if (!is_valid_block_pointer(ptr)) {
+        return HALResult<void*>::error(errors::invalid_parameter(3, "Pointer not owned by pool"));
+    }
+    if (new_size > block_size_) {
+        return HALResult<void*>::error(errors::invalid_parameter(1, "Size exceeds pool block size"));
+    }
+    // Every block already holds block_size_ bytes
+    return HALResult<void*>::success(ptr);
+}
+
+AllocatorStats PoolAllocator::get_stats() const {
+    const size_t used_blocks = get_used_blocks();
+    const size_t free_blocks = block_count_ - used_blocks;
+
+    AllocatorStats stats{};
+    stats.type = AllocatorType::Pool;
+    stats.name = name_;
+    stats.total_capacity = block_count_ * block_size_;
+    stats.used_bytes = used_blocks * block_size_;
+    stats.free_bytes = free_blocks * block_size_;
+    stats.allocation_count = used_blocks;
+    stats.peak_used_bytes = peak_usage_.load(std::memory_order_relaxed) * block_size_;
+    stats.total_allocations = total_allocations_.load(std::memory_order_relaxed);
+    stats.allocation_overhead = stride_ - block_size_;
+    stats.fragmentation_ratio = 0.0; // Fixed-size blocks never fragment
+    stats.supports_defrag = false;
+    return stats;
+}
+
+AllocatorType PoolAllocator::get_type() const {
+    return AllocatorType::Pool;
+}
+
+std::string_view PoolAllocator::get_name() const {
+    return name_;
+}
+
+bool PoolAllocator::supports_size(size_t size) const {
+    return size <= block_size_;
+}
+
+bool PoolAllocator::supports_alignment(size_t alignment) const {
+    return is_power_of_two(alignment) && alignment <= alignment_;
+}
+
+bool PoolAllocator::owns_pointer(void* ptr) const {
+    const uint8_t* p = static_cast<const uint8_t*>(ptr);
+    return blocks_ && p >= blocks_ && p < blocks_ + block_count_ * stride_;
+}
+
+HALResult<void> PoolAllocator::reset() {
+    initialize_free_list();
+    return HALResult<void>::success();
+}
+
+HALResult<void> PoolAllocator::defragment(DefragmentationCallback callback) {
+    // Fixed-size blocks never fragment; nothing to move
+    if (callback) {
+        callback(0, 0, 1.0);
+    }
+    return HALResult<void>::success();
+}
+
+size_t PoolAllocator::get_free_blocks() const {
+    return block_count_ - get_used_blocks();
+}
+
+size_t PoolAllocator::get_used_blocks() const {
+    return used_count_.load(std::memory_order_relaxed);
+}
+
+bool PoolAllocator::is_full() const {
+    return get_used_blocks() == block_count_;
+}
+
+bool PoolAllocator::is_empty() const {
+    return get_used_blocks() == 0;
+}
+
+void PoolAllocator::initialize_free_list() {
+    if (!links_ && block_count_ > 0) {
+        links_.reset(new std::atomic<uint32_t>[block_count_]);
+    }
+    for (size_t i = 0; i < block_count_; ++i) {
+        const uint32_t next = i + 1 < block_count_ ? static_cast<uint32_t>(i + 1) : NO_BLOCK;
+        links_[i].store(next, std::memory_order_relaxed);
+    }
+    used_count_.store(0, std::memory_order_relaxed);
+    free_head_.store(block_count_ > 0 ? 0 : NO_BLOCK, std::memory_order_release);
+}
+
+bool PoolAllocator::is_valid_block_pointer(void* ptr) const {
+    return owns_pointer(ptr) && (static_cast<uint8_t*>(ptr) - blocks_) % stride_ == 0;
+}
+
+size_t PoolAllocator::get_block_index(void* ptr) const {
+    return static_cast<size_t>(static_cast<uint8_t*>(ptr) - blocks_) / stride_;
+}
+
+void* PoolAllocator::get_block_at_index(size_t index) const {
+    return blocks_ + index * stride_;
+}
+
+uint32_t PoolAllocator::pop_free_block() {
+    uint64_t head = free_head_.load(std::memory_order_acquire);
+    for (;;) {
+        const uint32_t index = static_cast<uint32_t>(head);
+        if (index == NO_BLOCK) {
+            return NO_BLOCK;
+        }
+        // If the block was taken meanwhile this link is stale, but then the
+        // version tag has moved on and the exchange fails
+        const uint32_t next = links_[index].load(std::memory_order_relaxed);
+        if (free_head_.compare_exchange_weak(head, next_head(head, next),
+                                             std::memory_order_acquire, std::memory_order_acquire)) {
+            links_[index].store(ALLOCATED, std::memory_order_relaxed);
+            return index;
+        }
+    }
+}
+
+void PoolAllocator::push_free_block(uint32_t index) {
+    uint64_t head = free_head_.load(std::memory_order_relaxed);
+    for (;;) {
+        links_[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        if (free_head_.compare_exchange_weak(head, next_head(head, index),
+                                             std::memory_order_release, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+void PoolAllocator::update_stats(size_t used) {
+    total_allocations_.fetch_add(1, std::memory_order_relaxed);
+    size_t peak = peak_usage_.load(std::memory_order_relaxed);
+    while (used > peak && !peak_usage_.compare_exchange_weak(peak, used, std::memory_order_relaxed)) {
+    }
+}
+
+// =====================================================================
+// MultiSizePoolAllocator Implementation
+// =====================================================================
+
+MultiSizePoolAllocator::MultiSizePoolAllocator(const std::vector<PoolConfig>& configs,
+                                               std::string_view name)
+    : configs_(configs), name_(name) {
+    std::sort(configs_.begin(), configs_.end(),
+              [](const PoolConfig& a, const PoolConfig& b) { return a.block_size < b.block_size; });
+    initialize_pools();
+}
+
+MultiSizePoolAllocator::~MultiSizePoolAllocator() = default;
+
+HALResult<void*> MultiSizePoolAllocator::allocate(size_t size, size_t alignment) {
+    const size_t first = find_best_fit_pool(size, alignment);
+    if (first == pools_.size()) {
+        return HALResult<void*>::error(errors::invalid_parameter(1, "No pool fits size and alignment"));
+    }
+    // Spill into the next larger pool when the best fit is exhausted
+    for (size_t i = first; i < pools_.size(); ++i) {
+        if (!pools_[i]->supports_alignment(alignment)) {
+            continue;
+        }
+        auto result = pools_[i]->allocate(size, alignment);
+        if (result) {
+            return result;
+        }
+    }
+    return HALResult<void*>::error(errors::out_of_memory(1, "All fitting pools exhausted"));
+}
+
+HALResult<void> MultiSizePoolAllocator::deallocate(void* ptr) {
+    if (!ptr) {
+        return HALResult<void>::success();
+    }
+    for (auto& pool : pools_) {
+        if (pool->owns_pointer(ptr)) {
+            return pool->deallocate(ptr);
+        }
+    }
+    return HALResult<void>::error(errors::invalid_parameter(3, "Pointer not owned by pool"));
+}
+
+HALResult<void*> MultiSizePoolAllocator::reallocate(void* ptr, size_t new_size) {
+    if (!ptr) {
+        return allocate(new_size);
+    }
+    PoolAllocator* owner = nullptr;
+    for (auto& pool : pools_) {
+        if (pool->owns_pointer(ptr)) {
+            owner = pool.get();
+            break;
+        }
+    }
+    if (!owner) {
+        return HALResult<void*>::error(errors::invalid_parameter(3, "Pointer not owned by pool"));
+    }
+    if (owner->supports_size(new_size)) {
+        return HALResult<void*>::success(ptr);
+    }
+
+    auto result = allocate(new_size);
+    if (!result) {
+        return result;
+    }
+    std::memcpy(result.value(), ptr, std::min(owner->get_block_size(), new_size));
+    owner->deallocate(ptr);
+    return result;
+}
+
+AllocatorStats MultiSizePoolAllocator::get_stats() const {
+    AllocatorStats stats{};
+    stats.type = AllocatorType::Pool;
+    stats.name = name_;
+    for (const auto& pool : pools_) {
+        const AllocatorStats pool_stats = pool->get_stats();
+        stats.total_capacity += pool_stats.total_capacity;
+        stats.used_bytes += pool_stats.used_bytes;
+        stats.free_bytes += pool_stats.free_bytes;
+        stats.allocation_count += pool_stats.allocation_count;
+        stats.peak_used_bytes += pool_stats.peak_used_bytes; // Pools peak independently: an upper bound
+        stats.total_allocations += pool_stats.total_allocations;
+        stats.allocation_overhead = std::max(stats.allocation_overhead, pool_stats.allocation_overhead);
+    }
+    stats.fragmentation_ratio = 0.0;
+    stats.supports_defrag = false;
+    return stats;
+}
+
+AllocatorType MultiSizePoolAllocator::get_type() const {
+    return AllocatorType::Pool;
+}
+
+std::string_view MultiSizePoolAllocator::get_name() const {
+    return name_;
+}
+
+bool MultiSizePoolAllocator::supports_size(size_t size) const {
+    return !pools_.empty() && pools_.back()->supports_size(size);
+}
+
+bool MultiSizePoolAllocator::supports_alignment(size_t alignment) const {
+    return std::any_of(pools_.begin(), pools_.end(),
+                       [alignment](const auto& pool) { return pool->supports_alignment(alignment); });
+}
+
+bool MultiSizePoolAllocator::owns_pointer(void* ptr) const {
+    return std::any_of(pools_.begin(), pools_.end(),
+                       [ptr](const auto& pool) { return pool->owns_pointer(ptr); });
+}
+
+HALResult<void> MultiSizePoolAllocator::reset() {
+    for (auto& pool : pools_) {
+        pool->reset();
+    }
+    return HALResult<void>::success();
+}
+
+HALResult<void> MultiSizePoolAllocator::defragment(DefragmentationCallback callback) {
+    if (callback) {
+        callback(0, 0, 1.0);
+    }
+    return HALResult<void>::success();
+}
+
+PoolAllocator* MultiSizePoolAllocator::get_pool_for_size(size_t size) const {
+    const size_t index = find_best_fit_pool(size, 1);
+    return index < pools_.size() ? pools_[index].get() : nullptr;
+}
+
+std::vector<MultiSizePoolAllocator::PoolConfig> MultiSizePoolAllocator::get_pool_configs() const {
+    return configs_;
+}
+
+size_t MultiSizePoolAllocator::find_best_fit_pool(size_t size, size_t alignment) const {
+    for (size_t i = 0; i < pools_.size(); ++i) {
+        if (pools_[i]->supports_size(size) && pools_[i]->supports_alignment(alignment)) {
+            return i;
+        }
+    }
+    return pools_.size();
+}
+
+void MultiSizePoolAllocator::initialize_pools() {
+    pools_.clear();
+    pools_.reserve(configs_.size());
+    for (const auto& config : configs_) {
+        pools_.push_back(std::make_unique<ThreadSafePoolAllocator>(
+            config.block_count, config.block_size, config.alignment, name_));
+    }
+}
+
+} // namespace flight::hal::allocators
@@ -32,6 +32,7 @@ const char* to_string(AllocatorType type) {
         case AllocatorType::Buddy:    return "Buddy";
         case AllocatorType::FreeList: return "FreeList";
         case AllocatorType::System:   return "System";
+        case AllocatorType::Compacting: return "Compacting";
         default:                      return "Unknown";
     }
 }
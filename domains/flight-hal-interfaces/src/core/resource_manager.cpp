@@ -10,6 +10,7 @@
 #include <thread>
 #include <cstring>
 #include <cstdlib>
+#include <limits>
 
 namespace flight::hal::core {
 
@@ -203,22 +204,66 @@ void ResourceBudgetManager::set_pressure_callback(PressureCallback callback) {
 
 void ResourceBudgetManager::set_reclamation_callback(coordination::ResourceType type, ReclamationCallback callback) {
     std::unique_lock<std::shared_mutex> lock(budgets_mutex_);
-    reclamation_callbacks_[type] = std::move(callback);
+    auto& entries = reclamation_callbacks_[type];
+    entries.clear();
+    if (callback) {
+        entries.push_back({next_reclamation_id_++, DEFAULT_RECLAMATION_PRIORITY, std::move(callback)});
+    }
+}
+
+uint32_t ResourceBudgetManager::add_reclamation_callback(coordination::ResourceType type, uint32_t priority,
+                                                         ReclamationCallback callback) {
+    if (!callback) {
+        return 0;
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(budgets_mutex_);
+    auto& entries = reclamation_callbacks_[type];
+    
+    // Insert after callbacks of equal priority so registration order breaks ties
+    auto position = std::upper_bound(entries.begin(), entries.end(), priority,
+                                     [](uint32_t p, const ReclamationEntry& entry) {
+                                         return p < entry.priority;
+                                     });
+    uint32_t id = next_reclamation_id_++;
+    entries.insert(position, ReclamationEntry{id, priority, std::move(callback)});
+    return id;
+}
+
+HALResult<void> ResourceBudgetManager::remove_reclamation_callback(uint32_t callback_id) {
+    std::unique_lock<std::shared_mutex> lock(budgets_mutex_);
+    for (auto& [type, entries] : reclamation_callbacks_) {
+        auto it = std::find_if(entries.begin(), entries.end(),
+                               [callback_id](const ReclamationEntry& entry) { return entry.id == callback_id; });
+        if (it != entries.end()) {
+            entries.erase(it);
+            return HALResult<void>::success();
+        }
+    }
+    
+    return HALResult<void>::error(
+        errors::invalid_parameter(13, "Reclamation callback not found"));
 }
 
 HALResult<size_t> ResourceBudgetManager::emergency_reclamation(coordination::ResourceType type, size_t requested_bytes) {
     std::shared_lock<std::shared_mutex> read_lock(budgets_mutex_);
     
     auto callback_it = reclamation_callbacks_.find(type);
-    if (callback_it == reclamation_callbacks_.end()) {
+    if (callback_it == reclamation_callbacks_.end() || callback_it->second.empty()) {
         return HALResult<size_t>::success(0); // No reclamation callback available
     }
     
-    auto callback = callback_it->second; // Copy callback
+    auto entries = callback_it->second; // Copy callbacks
     read_lock.unlock();
     
-    // Execute reclamation callback
-    size_t reclaimed_bytes = callback(type, requested_bytes);
+    // Execute reclamation callbacks, cheapest first, until enough is freed
+    size_t reclaimed_bytes = 0;
+    for (const auto& entry : entries) {
+        reclaimed_bytes += entry.callback(type, requested_bytes - reclaimed_bytes);
+        if (reclaimed_bytes >= requested_bytes) {
+            break;
+        }
+    }
     
     // Update stats
     std::unique_lock<std::shared_mutex> write_lock(budgets_mutex_);
@@ -558,6 +603,27 @@ void ResourceManager::register_reclamation_callback(coordination::ResourceType t
     budget_manager_.set_reclamation_callback(type, std::move(callback));
 }
 
+HALResult<uint32_t> ResourceManager::attach_pressure_monitor(IMemoryPressureMonitor& monitor) {
+    return monitor.register_callback(MemoryPressureLevel::Medium,
+                                     [this](MemoryPressureLevel level, const MemoryPressureInfo& info) {
+        size_t requested_bytes = std::numeric_limits<size_t>::max();
+        if (level < MemoryPressureLevel::Critical) {
+            auto stats = budget_manager_.get_stats(coordination::ResourceType::Memory);
+            size_t usage = stats ? stats.value().current_usage : 0;
+            requested_bytes = level == MemoryPressureLevel::High ? usage / 4 : usage / 10;
+        }
+        
+        // Always try to restore the emergency reserve headroom
+        if (info.available_bytes < info.emergency_reserve) {
+            requested_bytes = std::max(requested_bytes, info.emergency_reserve - info.available_bytes);
+        }
+        
+        if (requested_bytes > 0) {
+            budget_manager_.emergency_reclamation(coordination::ResourceType::Memory, requested_bytes);
+        }
+    });
+}
+
 // Template specializations would go here for specific resource types
 template<>
 HALResult<void*> ResourceManager::allocate_resource<void>(const coordination::ResourceMetadata& metadata) {
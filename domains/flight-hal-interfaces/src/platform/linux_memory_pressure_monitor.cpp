@@ -0,0 +1,490 @@
+/**
+ * @file linux_memory_pressure_monitor.cpp
+ * @brief Linux Memory Pressure Monitor Implementation
+ */
+
+#include "../../include/flight/hal/platform/linux_memory_pressure_monitor.hpp"
+#include "../../include/flight/hal/core/hal_logging.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <new>
+#include <poll.h>
+#include <sstream>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace flight::hal::platform {
+
+namespace {
+
+constexpr const char* SYSTEM_PRESSURE_PATH = "/proc/pressure/memory";
+/// Unified hierarchy mount points: pure cgroup v2, then hybrid setups
+constexpr const char* CGROUP_ROOTS[] = {"/sys/fs/cgroup", "/sys/fs/cgroup/unified"};
+
+std::string read_file(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return {};
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+bool file_exists(const std::string& path) {
+    return access(path.c_str(), R_OK) == 0;
+}
+
+/**
+ * @brief Find the unified hierarchy entry ("0::/path") of this process
+ */
+std::string detect_cgroup_path() {
+    std::istringstream lines(read_file("/proc/self/cgroup"));
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.compare(0, 3, "0::") != 0) {
+            continue;
+        }
+        for (const char* root : CGROUP_ROOTS) {
+            std::string path = std::string(root) + line.substr(3);
+            if (file_exists(path + "/memory.events")) {
+                return path;
+            }
+        }
+    }
+    return {};
+}
+
+/**
+ * @brief Value following "key " on its own line of a flat keyed file
+ */
+bool find_counter(const std::string& contents, const char* key, uint64_t& value) {
+    const size_t key_length = std::strlen(key);
+    size_t position = 0;
+    while (position < contents.size()) {
+        if (contents.compare(position, key_length, key) == 0 && position + key_length < contents.size() &&
+            contents[position + key_length] == ' ') {
+            value = std::strtoull(contents.c_str() + position + key_length + 1, nullptr, 10);
+            return true;
+        }
+        position = contents.find('\n', position);
+        if (position == std::string::npos) {
+            break;
+        }
+        ++position;
+    }
+    return false;
+}
+
+uint64_t now_ms() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // anonymous namespace
+
+LinuxMemoryPressureMonitor::LinuxMemoryPressureMonitor(LinuxMemoryPressureConfig config)
+    : config_(std::move(config)), events_fd_(-1), wake_fd_(-1), running_(false),
+      level_(MemoryPressureLevel::None), pressure_ratio_(0.0), last_pressure_time_(0),
+      next_callback_id_(1), reserve_size_(0) {
+    cgroup_path_ = config_.cgroup_path.empty() ? detect_cgroup_path() : config_.cgroup_path;
+
+    // Prefer the cgroup's own PSI file so pressure elsewhere on the host is ignored
+    if (!config_.system_wide && !cgroup_path_.empty() && file_exists(cgroup_path_ + "/memory.pressure")) {
+        pressure_path_ = cgroup_path_ + "/memory.pressure";
+    } else if (file_exists(SYSTEM_PRESSURE_PATH)) {
+        pressure_path_ = SYSTEM_PRESSURE_PATH;
+    }
+}
+
+LinuxMemoryPressureMonitor::~LinuxMemoryPressureMonitor() {
+    stop();
+}
+
+HALResult<void> LinuxMemoryPressureMonitor::start() {
+    if (running_.load(std::memory_order_acquire)) {
+        return HALResult<void>::success();
+    }
+
+    // One file descriptor per trigger; the kernel keeps one trigger per open file
+    bool any_trigger = false;
+    trigger_fds_.assign(config_.triggers.size(), -1);
+    for (size_t i = 0; i < config_.triggers.size() && !pressure_path_.empty(); ++i) {
+        const auto& trigger = config_.triggers[i];
+        int fd = open(pressure_path_.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) {
+            break;
+        }
+
+        char spec[64];
+        int length = std::snprintf(spec, sizeof(spec), "%s %lld %lld", trigger.full ? "full" : "some",
+                                   static_cast<long long>(trigger.stall_time.count()),
+                                   static_cast<long long>(trigger.window.count()));
+        if (write(fd, spec, static_cast<size_t>(length) + 1) < 0) {
+            HAL_LOG_MESSAGE(LogLevel::Warning, "Rejected PSI memory trigger");
+            close(fd);
+            continue;
+        }
+        trigger_fds_[i] = fd;
+        any_trigger = true;
+    }
+
+    if (!cgroup_path_.empty()) {
+        events_fd_ = open((cgroup_path_ + "/memory.events").c_str(), O_RDONLY | O_CLOEXEC);
+        if (events_fd_ >= 0) {
+            read_cgroup_events(); // Baseline counters; only increases count as pressure
+        }
+    }
+
+    if (!any_trigger && events_fd_ < 0) {
+        close_fds();
+        return HALResult<void>::error(errors::feature_not_supported(1, "Neither PSI nor cgroup v2 memory events available"));
+    }
+
+    wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wake_fd_ < 0) {
+        close_fds();
+        return HALResult<void>::error(errors::resource_exhausted(2, "Failed to create monitor wake-up eventfd"));
+    }
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&LinuxMemoryPressureMonitor::monitor_loop, this);
+    return HALResult<void>::success();
+}
+
+void LinuxMemoryPressureMonitor::stop() {
+    if (running_.exchange(false, std::memory_order_acq_rel)) {
+        uint64_t one = 1;
+        (void)write(wake_fd_, &one, sizeof(one));
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    close_fds();
+}
+
+void LinuxMemoryPressureMonitor::close_fds() {
+    for (int& fd : trigger_fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    trigger_fds_.clear();
+    if (events_fd_ >= 0) {
+        close(events_fd_);
+        events_fd_ = -1;
+    }
+    if (wake_fd_ >= 0) {
+        close(wake_fd_);
+        wake_fd_ = -1;
+    }
+}
+
+void LinuxMemoryPressureMonitor::monitor_loop() {
+    // Slot 0 is the wake-up eventfd, then the triggers, then memory.events
+    std::vector<pollfd> fds;
+    fds.push_back({wake_fd_, POLLIN, 0});
+    for (int fd : trigger_fds_) {
+        fds.push_back({fd, POLLPRI, 0});
+    }
+    const size_t events_slot = fds.size();
+    fds.push_back({events_fd_, POLLPRI, 0});
+
+    int timeout = settle_level();
+    while (running_.load(std::memory_order_acquire)) {
+        int ready = poll(fds.data(), fds.size(), timeout);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            HAL_LOG_MESSAGE(LogLevel::Error, "Memory pressure monitor poll failed");
+            break;
+        }
+        if (fds[0].revents != 0) {
+            // Woken by stop(), or by check_pressure() changing the deadline
+            uint64_t count;
+            (void)read(wake_fd_, &count, sizeof(count));
+            timeout = settle_level();
+            continue;
+        }
+
+        MemoryPressureLevel signalled = MemoryPressureLevel::None;
+        for (size_t i = 0; i < trigger_fds_.size(); ++i) {
+            pollfd& entry = fds[i + 1];
+            if (entry.revents & POLLERR) {
+                entry.fd = -1; // Monitored cgroup went away; poll() skips negative fds
+            } else if (entry.revents & POLLPRI) {
+                signalled = std::max(signalled, config_.triggers[i].level);
+            }
+        }
+        // kernfs reports a modified file as POLLPRI | POLLERR
+        if (fds[events_slot].revents & (POLLPRI | POLLERR)) {
+            signalled = std::max(signalled, read_cgroup_events());
+        }
+
+        if (signalled != MemoryPressureLevel::None) {
+            raise_level(signalled);
+        }
+        timeout = settle_level();
+    }
+}
+
+MemoryPressureLevel LinuxMemoryPressureMonitor::read_cgroup_events() {
+    std::string contents;
+    if (events_fd_ >= 0) {
+        char buffer[512];
+        ssize_t length = pread(events_fd_, buffer, sizeof(buffer) - 1, 0);
+        if (length > 0) {
+            contents.assign(buffer, static_cast<size_t>(length));
+        }
+    } else if (!cgroup_path_.empty()) {
+        contents = read_file(cgroup_path_ + "/memory.events");
+    }
+    if (contents.empty()) {
+        return MemoryPressureLevel::None;
+    }
+
+    CgroupEvents current;
+    find_counter(contents, "high", current.high);
+    find_counter(contents, "max", current.max);
+    find_counter(contents, "oom", current.oom);
+    find_counter(contents, "oom_kill", current.oom_kill);
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    MemoryPressureLevel level = MemoryPressureLevel::None;
+    if (current.oom > events_.oom || current.oom_kill > events_.oom_kill) {
+        level = MemoryPressureLevel::Critical;
+    } else if (current.max > events_.max) {
+        level = MemoryPressureLevel::High; // Direct reclaim at the hard limit
+    } else if (current.high > events_.high) {
+        level = MemoryPressureLevel::Medium; // Throttled above memory.high
+    }
+    events_ = current;
+    return level;
+}
+
+double LinuxMemoryPressureMonitor::read_stall_average(bool full) const {
+    if (pressure_path_.empty()) {
+        return -1.0;
+    }
+    // Lines look like "some avg10=1.23 avg60=0.50 avg300=0.10 total=12345"
+    std::istringstream lines(read_file(pressure_path_));
+    std::string line;
+    const char* prefix = full ? "full avg10=" : "some avg10=";
+    while (std::getline(lines, line)) {
+        if (line.compare(0, 11, prefix) == 0) {
+            return std::strtod(line.c_str() + 11, nullptr);
+        }
+    }
+    return -1.0;
+}
+
+size_t LinuxMemoryPressureMonitor::read_available_bytes() const {
+    uint64_t available = 0;
+    bool system_known = false;
+    std::string meminfo = read_file("/proc/meminfo");
+    size_t position = meminfo.find("MemAvailable:");
+    if (position != std::string::npos) {
+        available = std::strtoull(meminfo.c_str() + position + 13, nullptr, 10) * 1024;
+        system_known = true;
+    }
+
+    // A cgroup limit below what the host has free is the tighter bound
+    if (!cgroup_path_.empty()) {
+        std::string limit = read_file(cgroup_path_ + "/memory.max");
+        std::string usage = read_file(cgroup_path_ + "/memory.current");
+        if (!limit.empty() && limit.compare(0, 3, "max") != 0 && !usage.empty()) {
+            uint64_t max_bytes = std::strtoull(limit.c_str(), nullptr, 10);
+            uint64_t current_bytes = std::strtoull(usage.c_str(), nullptr, 10);
+            uint64_t room = max_bytes > current_bytes ? max_bytes - current_bytes : 0;
+            available = system_known ? std::min(available, room) : room;
+        }
+    }
+    return static_cast<size_t>(available);
+}
+
+void LinuxMemoryPressureMonitor::raise_level(MemoryPressureLevel level) {
+    double some = read_stall_average(false);
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    fired_[static_cast<size_t>(level)] = std::chrono::steady_clock::now();
+    last_pressure_time_ = now_ms();
+    if (some >= 0.0) {
+        pressure_ratio_ = std::min(some / 100.0, 1.0);
+    }
+}
+
+int LinuxMemoryPressureMonitor::settle_level() {
+    const auto now = std::chrono::steady_clock::now();
+    MemoryPressureLevel level = MemoryPressureLevel::None;
+    int timeout = -1;
+    bool changed = false;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        for (size_t i = static_cast<size_t>(MemoryPressureLevel::Critical); i > 0; --i) {
+            const auto expiry = fired_[i] + config_.settle_time;
+            if (fired_[i].time_since_epoch().count() != 0 && expiry > now) {
+                level = static_cast<MemoryPressureLevel>(i);
+                // Wake up when this level lapses, rounding up to whole milliseconds
+                timeout = static_cast<int>(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(expiry - now).count()) + 1;
+                break;
+            }
+        }
+        if (level == MemoryPressureLevel::None) {
+            pressure_ratio_ = 0.0;
+        }
+        changed = level != level_;
+        level_ = level;
+    }
+
+    if (changed) {
+        notify(level);
+    }
+    return timeout;
+}
+
+void LinuxMemoryPressureMonitor::notify(MemoryPressureLevel level) {
+    {
+        std::lock_guard<std::mutex> lock(reserve_mutex_);
+        if (level == MemoryPressureLevel::Critical) {
+            reserve_.reset(); // Hand the reserve back before anyone else reacts
+        } else if (level == MemoryPressureLevel::None && !reserve_) {
+            acquire_reserve_locked();
+        }
+    }
+
+    std::vector<CallbackEntry> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(callbacks_mutex_);
+        for (const auto& entry : callbacks_) {
+            if (entry.level > level) {
+                break;
+            }
+            callbacks.push_back(entry);
+        }
+    }
+
+    const MemoryPressureInfo info = get_pressure_info();
+    for (const auto& entry : callbacks) {
+        entry.callback(level, info);
+    }
+}
+
+HALResult<uint32_t> LinuxMemoryPressureMonitor::register_callback(MemoryPressureLevel level,
+                                                                  MemoryPressureCallback callback) {
+    if (!callback) {
+        return HALResult<uint32_t>::error(errors::invalid_parameter(3, "Null pressure callback"));
+    }
+
+    std::lock_guard<std::mutex> lock(callbacks_mutex_);
+    auto position = std::upper_bound(callbacks_.begin(), callbacks_.end(), level,
+                                     [](MemoryPressureLevel l, const CallbackEntry& entry) {
+                                         return l < entry.level;
+                                     });
+    uint32_t id = next_callback_id_++;
+    callbacks_.insert(position, CallbackEntry{id, level, std::move(callback)});
+    return HALResult<uint32_t>::success(id);
+}
+
+HALResult<void> LinuxMemoryPressureMonitor::unregister_callback(uint32_t callback_id) {
+    std::lock_guard<std::mutex> lock(callbacks_mutex_);
+    auto it = std::find_if(callbacks_.begin(), callbacks_.end(),
+                           [callback_id](const CallbackEntry& entry) { return entry.id == callback_id; });
+    if (it == callbacks_.end()) {
+        return HALResult<void>::error(errors::invalid_parameter(4, "Unknown pressure callback ID"));
+    }
+    callbacks_.erase(it);
+    return HALResult<void>::success();
+}
+
+MemoryPressureInfo LinuxMemoryPressureMonitor::get_pressure_info() const {
+    MemoryPressureInfo info{};
+    info.available_bytes = read_available_bytes();
+    info.emergency_reserve = get_emergency_reserve();
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    info.level = level_;
+    info.pressure_ratio = pressure_ratio_;
+    info.gc_recommended = level_ >= MemoryPressureLevel::Medium;
+    info.last_pressure_time = last_pressure_time_;
+    return info;
+}
+
+HALResult<void> LinuxMemoryPressureMonitor::check_pressure() {
+    // Without PSI or cgroup v2 there is nothing to read; available bytes still come from /proc/meminfo
+    const double some = read_stall_average(false);
+    const double full = read_stall_average(true);
+    if (some >= 0.0 || !cgroup_path_.empty()) {
+        // A trigger's threshold as an avg10 percentage is stall_time / window
+        MemoryPressureLevel level = MemoryPressureLevel::None;
+        for (const auto& trigger : config_.triggers) {
+            const double average = trigger.full ? full : some;
+            const double threshold = 100.0 * static_cast<double>(trigger.stall_time.count()) /
+                                     static_cast<double>(trigger.window.count());
+            if (average >= 0.0 && average >= threshold) {
+                level = std::max(level, trigger.level);
+            }
+        }
+        // Counters advanced by check_pressure() are not signalled again by the monitor thread
+        level = std::max(level, read_cgroup_events());
+
+        if (level != MemoryPressureLevel::None) {
+            raise_level(level);
+        }
+    }
+
+    // While the monitor thread runs, it alone settles the level and runs the
+    // callbacks; wake it to pick up the new level and decay deadline
+    if (running_.load(std::memory_order_acquire)) {
+        uint64_t one = 1;
+        (void)write(wake_fd_, &one, sizeof(one));
+    } else {
+        settle_level();
+    }
+    return HALResult<void>::success();
+}
+
+HALResult<void> LinuxMemoryPressureMonitor::set_emergency_reserve(size_t bytes) {
+    std::lock_guard<std::mutex> lock(reserve_mutex_);
+    reserve_size_ = bytes;
+    reserve_.reset();
+
+    bool critical;
+    {
+        std::lock_guard<std::mutex> state_lock(state_mutex_);
+        critical = level_ == MemoryPressureLevel::Critical;
+    }
+    if (critical || bytes == 0) {
+        return HALResult<void>::success(); // Acquired once pressure is gone
+    }
+
+    acquire_reserve_locked();
+    if (!reserve_) {
+        reserve_size_ = 0;
+        return HALResult<void>::error(errors::out_of_memory(5, "Failed to commit emergency reserve"));
+    }
+    return HALResult<void>::success();
+}
+
+size_t LinuxMemoryPressureMonitor::get_emergency_reserve() const {
+    std::lock_guard<std::mutex> lock(reserve_mutex_);
+    return reserve_size_;
+}
+
+void LinuxMemoryPressureMonitor::acquire_reserve_locked() {
+    if (reserve_size_ == 0) {
+        return;
+    }
+    reserve_.reset(new (std::nothrow) uint8_t[reserve_size_]);
+    if (reserve_) {
+        // Touch every page so the reserve is committed, not just address space
+        std::memset(reserve_.get(), 0, reserve_size_);
+    }
+}
+
+} // namespace flight::hal::platform
@@ -0,0 +1,247 @@
+/**
+ * @file fragmentation_stress_test.cpp
+ * @brief Memory Fragmentation Stress Test
+ *
+ * Reproduces the fragmentation of long-running game sessions on a 16MB heap
+ * and validates that the compacting allocator keeps large allocations
+ * succeeding while blocks move underneath their handles.
+ */
+
+#include "../framework/stress_test_base.hpp"
+#include "../../../include/flight/hal/allocators/compacting_allocator.hpp"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstring>
+
+namespace flight::hal::test::stress {
+
+using allocators::CompactingAllocator;
+
+/**
+ * @brief Fragmentation stress test for the compacting allocator
+ *
+ * Each iteration:
+ * 1. Allocates a mix of small and large relocatable blocks
+ * 2. Frees random blocks, keeping the heap 60-85% full
+ * 3. Spends a bounded time slice on incremental compaction
+ * 4. Verifies block contents survived every relocation
+ *
+ * An allocation that fails while enough memory is free in total is a
+ * fragmentation failure and fails the test.
+ */
+class FragmentationStressTest : public StressTestBase {
+public:
+    explicit FragmentationStressTest() : StressTestBase("MemoryFragmentation") {
+        auto config = config_presets::standard_stress("MemoryFragmentation");
+        config.max_memory_mb = 32; // Test memory budget; the heap gets half
+        config.fail_on_resource_exhaustion = false;
+        configure(config);
+    }
+
+protected:
+    bool setup_test() override {
+        heap_ = std::make_unique<CompactingAllocator>(get_config().max_memory_mb * 1024 * 1024 / 2,
+                                                      "FragmentationHeap");
+        if (heap_->get_capacity() == 0) {
+            record_error("Failed to reserve compacting heap");
+            return false;
+        }
+        heap_->set_relocation_callback([this](CompactingAllocator::Handle, void*, void*) {
+            ++relocations_;
+        });
+
+        blocks_.clear();
+        fragmentation_failures_ = 0;
+        relocations_ = 0;
+        return true;
+    }
+
+    bool teardown_test() override {
+        for (const auto& block : blocks_) {
+            heap_->free_handle(block.handle);
+        }
+        blocks_.clear();
+
+        printf("Relocated blocks: %zu\n", relocations_);
+        printf("Fragmentation failures: %zu\n", fragmentation_failures_);
+        heap_.reset();
+        return true;
+    }
+
+    bool execute_stress_iteration(double intensity) override {
+        bool iteration_success = true;
+        const size_t capacity = heap_->get_capacity();
+        const size_t allocation_count = 1 + static_cast<size_t>(20 * intensity);
+
+        for (size_t i = 0; i < allocation_count; ++i) {
+            const size_t size = generate_allocation_size(capacity);
+            if (heap_->get_stats().used_bytes + size > capacity * 85 / 100) {
+                free_random_blocks(capacity * 60 / 100);
+            }
+
+            const size_t free_before = heap_->get_stats().free_bytes;
+            auto result = heap_->allocate_handle(size);
+            if (!result) {
+                record_operation(false);
+                // Enough memory in total means the heap failed to compact
+                if (free_before >= size + 2 * CompactingAllocator::GRANULE) {
+                    ++fragmentation_failures_;
+                    record_error("Allocation of " + std::to_string(size) + " bytes failed with " +
+                                 std::to_string(free_before) + " bytes free");
+                    iteration_success = false;
+                }
+                continue;
+            }
+
+            Block block{result.value(), size, static_cast<uint8_t>(rng_())};
+            write_test_pattern(block);
+            blocks_.push_back(block);
+            get_metrics_collector()->record_allocation(size);
+            record_operation(true);
+        }
+
+        if (!blocks_.empty() && std::uniform_int_distribution<int>(0, 2)(rng_) == 0) {
+            free_block(std::uniform_int_distribution<size_t>(0, blocks_.size() - 1)(rng_));
+        }
+
+        // Incremental compaction within a frame-sized slice
+        const auto start_time = std::chrono::steady_clock::now();
+        auto step = heap_->compact_step(std::chrono::microseconds{500});
+        const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start_time);
+        get_metrics_collector()->record_performance_measurement(duration);
+        if (!step) {
+            record_error("Compaction step failed: " + std::string(step.error().message()));
+            iteration_success = false;
+        }
+
+        if (!verify_blocks()) {
+            record_error("Block contents corrupted by relocation");
+            iteration_success = false;
+        }
+        return iteration_success;
+    }
+
+    bool validate_recovery() override {
+        // Drop everything, compact, and expect one block of half the heap
+        for (const auto& block : blocks_) {
+            heap_->free_handle(block.handle);
+            get_metrics_collector()->record_deallocation(block.size);
+        }
+        blocks_.clear();
+
+        if (!heap_->defragment()) {
+            record_error("Defragmentation failed during recovery");
+            return false;
+        }
+        auto result = heap_->allocate_handle(heap_->get_capacity() / 2);
+        if (!result) {
+            record_error("Memory recovery validation failed: " + std::string(result.error().message()));
+            return false;
+        }
+        heap_->free_handle(result.value());
+        return true;
+    }
+
+private:
+    struct Block {
+        CompactingAllocator::Handle handle;
+        size_t size;
+        uint8_t pattern;
+    };
+
+    /**
+     * @brief Mostly small blocks with occasional large buffers
+     */
+    size_t generate_allocation_size(size_t capacity) {
+        if (std::uniform_int_distribution<int>(0, 31)(rng_) == 0) {
+            return std::uniform_int_distribution<size_t>(64 * 1024, capacity / 16)(rng_);
+        }
+        return std::uniform_int_distribution<size_t>(64, 8 * 1024)(rng_);
+    }
+
+    void write_test_pattern(const Block& block) {
+        std::memset(heap_->resolve(block.handle), block.pattern, block.size);
+    }
+
+    /**
+     * @brief Check the first and last bytes of every live block
+     */
+    bool verify_blocks() const {
+        for (const auto& block : blocks_) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(heap_->resolve(block.handle));
+            if (!bytes || bytes[0] != block.pattern || bytes[block.size - 1] != block.pattern) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void free_block(size_t index) {
+        heap_->free_handle(blocks_[index].handle);
+        get_metrics_collector()->record_deallocation(blocks_[index].size);
+        blocks_[index] = blocks_.back();
+        blocks_.pop_back();
+    }
+
+    /**
+     * @brief Free random blocks until usage drops below target bytes
+     */
+    void free_random_blocks(size_t target) {
+        while (!blocks_.empty() && heap_->get_stats().used_bytes > target) {
+            free_block(std::uniform_int_distribution<size_t>(0, blocks_.size() - 1)(rng_));
+        }
+    }
+
+    std::unique_ptr<CompactingAllocator> heap_;
+    std::vector<Block> blocks_;
+    size_t fragmentation_failures_ = 0;
+    size_t relocations_ = 0;
+    std::mt19937 rng_{std::random_device{}()};
+};
+
+} // namespace flight::hal::test::stress
+
+// Test execution function
+int main() {
+    using namespace flight::hal::test::stress;
+
+    std::vector<StressTestConfig> test_configs = {
+        config_presets::light_stress("MemoryFragmentation_Light"),
+        config_presets::standard_stress("MemoryFragmentation_Standard")
+    };
+
+    int failed_tests = 0;
+
+    for (auto config : test_configs) {
+        config.max_memory_mb = 32;
+
+        FragmentationStressTest test;
+        test.configure(config);
+
+        auto result = test.execute();
+
+        // Print results
+        printf("Test: %s\n", result.test_name.c_str());
+        printf("Success: %s\n", result.success ? "true" : "false");
+        printf("Total Operations: %zu\n", result.total_operations);
+        printf("Failed Operations: %zu\n", result.failed_operations);
+        printf("Recovery: %s\n", result.successful_recovery ? "successful" : "failed");
+
+        if (!result.errors.empty()) {
+            printf("Errors:\n");
+            for (const auto& error : result.errors) {
+                printf("  - %s\n", error.c_str());
+            }
+        }
+
+        printf("\n");
+
+        if (!result.success) {
+            failed_tests++;
+        }
+    }
+
+    return failed_tests;
+}
@@ -0,0 +1,327 @@
+/**
+ * @file compacting_allocator_test.cpp
+ * @brief Unit tests for the relocatable compacting allocator
+ */
+
+#include "../../../include/flight/hal/allocators/compacting_allocator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace flight::hal;
+using namespace flight::hal::allocators;
+
+namespace {
+
+using Handle = CompactingAllocator::Handle;
+
+constexpr size_t BLOCK_SIZE = 100; // 128 bytes with header and rounding
+constexpr size_t BLOCK_COUNT = 8;
+constexpr size_t CAPACITY = 1024;  // Exactly BLOCK_COUNT blocks
+
+void fill(void* ptr, size_t size, uint8_t seed) {
+    auto* bytes = static_cast<uint8_t*>(ptr);
+    for (size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<uint8_t>(seed + i);
+    }
+}
+
+bool holds(const void* ptr, size_t size, uint8_t seed) {
+    const auto* bytes = static_cast<const uint8_t*>(ptr);
+    for (size_t i = 0; i < size; ++i) {
+        if (bytes[i] != static_cast<uint8_t>(seed + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Fills the heap with BLOCK_COUNT handles, then frees every other one so
+// each surviving block sits behind a hole
+std::vector<Handle> fragment(CompactingAllocator& heap) {
+    std::vector<Handle> handles;
+    for (size_t i = 0; i < BLOCK_COUNT; ++i) {
+        auto handle = heap.allocate_handle(BLOCK_SIZE);
+        EXPECT_TRUE(handle.is_ok());
+        fill(heap.resolve(handle.value()), BLOCK_SIZE, static_cast<uint8_t>(i * 16));
+        handles.push_back(handle.value());
+    }
+    std::vector<Handle> survivors;
+    for (size_t i = 0; i < BLOCK_COUNT; ++i) {
+        if (i % 2 == 0) {
+            EXPECT_TRUE(heap.free_handle(handles[i]).is_ok());
+        } else {
+            survivors.push_back(handles[i]);
+        }
+    }
+    return survivors;
+}
+
+// Seed each surviving block was filled with
+uint8_t seed_of(size_t survivor) {
+    return static_cast<uint8_t>((2 * survivor + 1) * 16);
+}
+
+} // anonymous namespace
+
+// =====================================================================
+// Compaction
+// =====================================================================
+
+TEST(CompactingAllocatorTest, DefragmentPreservesDataAndHandles) {
+    CompactingAllocator heap(CAPACITY);
+    const std::vector<Handle> survivors = fragment(heap);
+    EXPECT_GT(heap.get_stats().fragmentation_ratio, 0.0);
+    EXPECT_LT(heap.get_largest_free_block(), 2 * BLOCK_SIZE);
+
+    std::vector<void*> before;
+    for (Handle handle : survivors) {
+        before.push_back(heap.resolve(handle));
+    }
+
+    size_t reported = 0;
+    double last_fraction = 0.0;
+    ASSERT_TRUE(heap.defragment([&](size_t, size_t, double fraction) {
+        ++reported;
+        last_fraction = fraction;
+    }).is_ok());
+    EXPECT_GT(reported, 0u);
+    EXPECT_DOUBLE_EQ(last_fraction, 1.0);
+
+    for (size_t i = 0; i < survivors.size(); ++i) {
+        void* address = heap.resolve(survivors[i]);
+        ASSERT_NE(address, nullptr);
+        EXPECT_NE(address, before[i]);
+        EXPECT_EQ(heap.get_size(survivors[i]), BLOCK_SIZE);
+        EXPECT_TRUE(holds(address, BLOCK_SIZE, seed_of(i)));
+    }
+    EXPECT_DOUBLE_EQ(heap.get_stats().fragmentation_ratio, 0.0);
+    EXPECT_GE(heap.get_largest_free_block(), 3 * BLOCK_SIZE);
+}
+
+TEST(CompactingAllocatorTest, CompactStepMovesAtLeastOneBlockPerCall) {
+    CompactingAllocator heap(CAPACITY);
+    const std::vector<Handle> survivors = fragment(heap);
+
+    size_t steps = 0;
+    size_t blocks = 0;
+    for (;;) {
+        auto progress = heap.compact_step(std::chrono::microseconds(0));
+        ASSERT_TRUE(progress.is_ok());
+        ++steps;
+        blocks += progress.value().blocks_moved;
+        if (progress.value().complete) {
+            EXPECT_EQ(progress.value().fragmented_bytes, 0u);
+            break;
+        }
+        // A zero budget still makes progress, one block at a time
+        EXPECT_EQ(progress.value().blocks_moved, 1u);
+        ASSERT_LT(steps, 2 * BLOCK_COUNT);
+
+        // Data stays reachable between steps
+        for (size_t i = 0; i < survivors.size(); ++i) {
+            EXPECT_TRUE(holds(heap.resolve(survivors[i]), BLOCK_SIZE, seed_of(i)));
+        }
+    }
+    EXPECT_EQ(blocks, survivors.size());
+    for (size_t i = 0; i < survivors.size(); ++i) {
+        EXPECT_TRUE(holds(heap.resolve(survivors[i]), BLOCK_SIZE, seed_of(i)));
+    }
+
+    // A compact heap has nothing left to move
+    auto again = heap.compact_step(std::chrono::microseconds(1000));
+    ASSERT_TRUE(again.is_ok());
+    EXPECT_EQ(again.value().blocks_moved, 0u);
+    EXPECT_TRUE(again.value().complete);
+}
+
+TEST(CompactingAllocatorTest, RelocationCallbackReportsEveryMove) {
+    CompactingAllocator heap(CAPACITY);
+    const std::vector<Handle> survivors = fragment(heap);
+
+    struct Move {
+        Handle handle;
+        void* from;
+        void* to;
+    };
+    std::vector<Move> moves;
+    heap.set_relocation_callback([&](Handle handle, void* from, void* to) {
+        moves.push_back({handle, from, to});
+    });
+    std::vector<void*> before;
+    for (Handle handle : survivors) {
+        before.push_back(heap.resolve(handle));
+    }
+    ASSERT_TRUE(heap.defragment().is_ok());
+
+    ASSERT_EQ(moves.size(), survivors.size());
+    for (size_t i = 0; i < survivors.size(); ++i) {
+        EXPECT_EQ(moves[i].handle, survivors[i]);
+        EXPECT_EQ(moves[i].from, before[i]);
+        EXPECT_EQ(moves[i].to, heap.resolve(survivors[i]));
+    }
+}
+
+TEST(CompactingAllocatorTest, PinnedBlocksAreNotMoved) {
+    CompactingAllocator heap(CAPACITY);
+    const std::vector<Handle> survivors = fragment(heap);
+
+    auto pinned = heap.pin(survivors[1]);
+    ASSERT_TRUE(pinned.is_ok());
+    EXPECT_EQ(pinned.value(), heap.resolve(survivors[1]));
+    ASSERT_TRUE(heap.defragment().is_ok());
+
+    EXPECT_EQ(heap.resolve(survivors[1]), pinned.value());
+    for (size_t i = 0; i < survivors.size(); ++i) {
+        EXPECT_TRUE(holds(heap.resolve(survivors[i]), BLOCK_SIZE, seed_of(i)));
+    }
+    // Only the hole behind the pinned block is left
+    EXPECT_GT(heap.get_stats().fragmentation_ratio, 0.0);
+
+    // Once unpinned, the block slides down like any other
+    ASSERT_TRUE(heap.unpin(survivors[1]).is_ok());
+    EXPECT_FALSE(heap.unpin(survivors[1]).is_ok());
+    ASSERT_TRUE(heap.defragment().is_ok());
+    EXPECT_NE(heap.resolve(survivors[1]), pinned.value());
+    EXPECT_TRUE(holds(heap.resolve(survivors[1]), BLOCK_SIZE, seed_of(1)));
+    EXPECT_DOUBLE_EQ(heap.get_stats().fragmentation_ratio, 0.0);
+}
+
+TEST(CompactingAllocatorTest, RawAllocationsAreNeverMoved) {
+    CompactingAllocator heap(CAPACITY);
+    auto front = heap.allocate_handle(BLOCK_SIZE);
+    ASSERT_TRUE(front.is_ok());
+    auto raw = heap.allocate(BLOCK_SIZE);
+    ASSERT_TRUE(raw.is_ok());
+    fill(raw.value(), BLOCK_SIZE, 7);
+    ASSERT_TRUE(heap.free_handle(front.value()).is_ok());
+
+    ASSERT_TRUE(heap.defragment().is_ok());
+    EXPECT_TRUE(holds(raw.value(), BLOCK_SIZE, 7));
+    EXPECT_TRUE(heap.deallocate(raw.value()).is_ok());
+}
+
+TEST(CompactingAllocatorTest, FailedAllocationsCompactAndRetry) {
+    CompactingAllocator heap(CAPACITY);
+    const std::vector<Handle> survivors = fragment(heap);
+    constexpr size_t LARGE = 3 * BLOCK_SIZE;
+
+    heap.set_compact_on_failure(false);
+    EXPECT_FALSE(heap.allocate_handle(LARGE).is_ok());
+
+    heap.set_compact_on_failure(true);
+    auto large = heap.allocate_handle(LARGE);
+    ASSERT_TRUE(large.is_ok());
+    fill(heap.resolve(large.value()), LARGE, 3);
+    for (size_t i = 0; i < survivors.size(); ++i) {
+        EXPECT_TRUE(holds(heap.resolve(survivors[i]), BLOCK_SIZE, seed_of(i)));
+    }
+    EXPECT_TRUE(holds(heap.resolve(large.value()), LARGE, 3));
+
+    // More than the free total never fits
+    EXPECT_FALSE(heap.allocate_handle(CAPACITY).is_ok());
+}
+
+// =====================================================================
+// Reallocation
+// =====================================================================
+
+TEST(CompactingAllocatorTest, ReallocateShrinksInPlaceAndGrowsByCopying) {
+    CompactingAllocator heap(CAPACITY);
+    auto block = heap.allocate(BLOCK_SIZE);
+    ASSERT_TRUE(block.is_ok());
+    fill(block.value(), BLOCK_SIZE, 9);
+    // Keeps the block from growing into the space behind it
+    auto neighbour = heap.allocate(16);
+    ASSERT_TRUE(neighbour.is_ok());
+
+    auto shrunk = heap.reallocate(block.value(), 32);
+    ASSERT_TRUE(shrunk.is_ok());
+    EXPECT_EQ(shrunk.value(), block.value());
+    EXPECT_TRUE(holds(shrunk.value(), 32, 9));
+
+    // Growing within the block's rounded size stays in place too
+    auto regrown = heap.reallocate(shrunk.value(), BLOCK_SIZE + 4);
+    ASSERT_TRUE(regrown.is_ok());
+    EXPECT_EQ(regrown.value(), block.value());
+
+    auto grown = heap.reallocate(regrown.value(), 4 * BLOCK_SIZE);
+    ASSERT_TRUE(grown.is_ok());
+    EXPECT_NE(grown.value(), block.value());
+    EXPECT_TRUE(holds(grown.value(), 32, 9));
+    EXPECT_FALSE(heap.deallocate(block.value()).is_ok());
+    EXPECT_TRUE(heap.deallocate(grown.value()).is_ok());
+
+    auto fresh = heap.reallocate(nullptr, 64);
+    ASSERT_TRUE(fresh.is_ok());
+    EXPECT_TRUE(heap.owns_pointer(fresh.value()));
+}
+
+TEST(CompactingAllocatorTest, FailedReallocateKeepsTheOriginalBlock) {
+    CompactingAllocator heap(CAPACITY);
+    auto block = heap.allocate(BLOCK_SIZE);
+    ASSERT_TRUE(block.is_ok());
+    fill(block.value(), BLOCK_SIZE, 5);
+
+    EXPECT_FALSE(heap.reallocate(block.value(), CAPACITY).is_ok());
+    EXPECT_TRUE(holds(block.value(), BLOCK_SIZE, 5));
+    EXPECT_TRUE(heap.deallocate(block.value()).is_ok());
+}
+
+// =====================================================================
+// Stale handles and pointers
+// =====================================================================
+
+TEST(CompactingAllocatorTest, FreedHandlesAreRejected) {
+    CompactingAllocator heap(CAPACITY);
+    auto handle = heap.allocate_handle(BLOCK_SIZE);
+    ASSERT_TRUE(handle.is_ok());
+    const Handle stale = handle.value();
+    ASSERT_TRUE(heap.free_handle(stale).is_ok());
+
+    EXPECT_EQ(heap.resolve(stale), nullptr);
+    EXPECT_EQ(heap.get_size(stale), 0u);
+    EXPECT_FALSE(heap.pin(stale).is_ok());
+    EXPECT_FALSE(heap.unpin(stale).is_ok());
+    EXPECT_FALSE(heap.free_handle(stale).is_ok());
+
+    // The slot is reused under a new generation
+    auto fresh = heap.allocate_handle(BLOCK_SIZE);
+    ASSERT_TRUE(fresh.is_ok());
+    EXPECT_EQ(fresh.value().index, stale.index);
+    EXPECT_NE(fresh.value(), stale);
+    EXPECT_EQ(heap.resolve(stale), nullptr);
+    EXPECT_NE(heap.resolve(fresh.value()), nullptr);
+
+    EXPECT_EQ(heap.resolve(Handle{}), nullptr);
+    EXPECT_FALSE(heap.free_handle(Handle{}).is_ok());
+}
+
+TEST(CompactingAllocatorTest, ResetInvalidatesEveryHandle) {
+    CompactingAllocator heap(CAPACITY);
+    auto handle = heap.allocate_handle(BLOCK_SIZE);
+    ASSERT_TRUE(handle.is_ok());
+    ASSERT_TRUE(heap.reset().is_ok());
+
+    EXPECT_EQ(heap.resolve(handle.value()), nullptr);
+    EXPECT_EQ(heap.get_stats().used_bytes, 0u);
+    EXPECT_TRUE(heap.allocate_handle(CAPACITY - CompactingAllocator::GRANULE).is_ok());
+}
+
+TEST(CompactingAllocatorTest, ForeignAndInteriorPointersAreRejected) {
+    CompactingAllocator heap(CAPACITY);
+    auto block = heap.allocate(BLOCK_SIZE);
+    ASSERT_TRUE(block.is_ok());
+
+    int local = 0;
+    EXPECT_FALSE(heap.deallocate(&local).is_ok());
+    EXPECT_FALSE(heap.deallocate(static_cast<uint8_t*>(block.value()) + CompactingAllocator::GRANULE).is_ok());
+    EXPECT_FALSE(heap.reallocate(&local, 16).is_ok());
+
+    EXPECT_TRUE(heap.deallocate(block.value()).is_ok());
+    EXPECT_FALSE(heap.deallocate(block.value()).is_ok());
+}
@@ -0,0 +1,202 @@
+/**
+ * @file pool_allocator_test.cpp
+ * @brief Unit tests for the lock-free pool and linear allocators
+ */
+
+#include "../../../include/flight/hal/allocators/pool_allocator.hpp"
+#include "../../../include/flight/hal/allocators/linear_allocator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace flight::hal;
+using namespace flight::hal::allocators;
+
+namespace {
+
+constexpr size_t BLOCK_SIZE = 64;
+constexpr size_t BLOCK_COUNT = 256;
+
+} // anonymous namespace
+
+// =====================================================================
+// PoolAllocator
+// =====================================================================
+
+TEST(PoolAllocatorTest, AllocatesEveryBlockOnce) {
+    PoolAllocator pool(BLOCK_COUNT, BLOCK_SIZE);
+    std::set<void*> blocks;
+    for (size_t i = 0; i < BLOCK_COUNT; ++i) {
+        auto result = pool.allocate(BLOCK_SIZE);
+        ASSERT_TRUE(result.is_ok());
+        EXPECT_TRUE(blocks.insert(result.value()).second);
+    }
+    EXPECT_TRUE(pool.is_full());
+    EXPECT_FALSE(pool.allocate(BLOCK_SIZE).is_ok());
+
+    for (void* block : blocks) {
+        EXPECT_TRUE(pool.deallocate(block).is_ok());
+    }
+    EXPECT_TRUE(pool.is_empty());
+}
+
+TEST(PoolAllocatorTest, RejectsOversizedAndForeignPointers) {
+    PoolAllocator pool(BLOCK_COUNT, BLOCK_SIZE);
+    EXPECT_FALSE(pool.allocate(BLOCK_SIZE + 1).is_ok());
+
+    auto block = pool.allocate(BLOCK_SIZE);
+    ASSERT_TRUE(block.is_ok());
+    int local = 0;
+    EXPECT_FALSE(pool.deallocate(&local).is_ok());
+    EXPECT_FALSE(pool.deallocate(static_cast<uint8_t*>(block.value()) + 1).is_ok());
+    EXPECT_EQ(pool.get_used_blocks(), 1u);
+}
+
+TEST(PoolAllocatorTest, DoubleFreeFails) {
+    PoolAllocator pool(BLOCK_COUNT, BLOCK_SIZE);
+    auto block = pool.allocate(BLOCK_SIZE);
+    ASSERT_TRUE(block.is_ok());
+
+    EXPECT_TRUE(pool.deallocate(block.value()).is_ok());
+    EXPECT_FALSE(pool.deallocate(block.value()).is_ok());
+    EXPECT_EQ(pool.get_used_blocks(), 0u);
+
+    // The block was pushed once, so it is handed out once
+    std::set<void*> blocks;
+    for (size_t i = 0; i < BLOCK_COUNT; ++i) {
+        auto result = pool.allocate(BLOCK_SIZE);
+        ASSERT_TRUE(result.is_ok());
+        EXPECT_TRUE(blocks.insert(result.value()).second);
+    }
+    EXPECT_FALSE(pool.allocate(BLOCK_SIZE).is_ok());
+}
+
+TEST(PoolAllocatorTest, RacingDoubleFreeSucceedsOnce) {
+    PoolAllocator pool(BLOCK_COUNT, BLOCK_SIZE);
+    for (int round = 0; round < 500; ++round) {
+        auto block = pool.allocate(BLOCK_SIZE);
+        ASSERT_TRUE(block.is_ok());
+
+        std::atomic<int> ready{0};
+        std::atomic<int> freed{0};
+        auto free_block = [&] {
+            ready.fetch_add(1);
+            while (ready.load() < 2) {
+            }
+            if (pool.deallocate(block.value()).is_ok()) {
+                freed.fetch_add(1);
+            }
+        };
+        std::thread a(free_block);
+        std::thread b(free_block);
+        a.join();
+        b.join();
+
+        ASSERT_EQ(freed.load(), 1);
+        ASSERT_TRUE(pool.is_empty());
+    }
+}
+
+TEST(PoolAllocatorTest, ConcurrentAllocateAndFree) {
+    constexpr int THREADS = 4;
+    constexpr int ROUNDS = 20000;
+    PoolAllocator pool(BLOCK_COUNT, BLOCK_SIZE);
+    std::atomic<bool> overlap{false};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            std::vector<void*> held;
+            for (int i = 0; i < ROUNDS; ++i) {
+                auto result = pool.allocate(BLOCK_SIZE);
+                if (result.is_ok()) {
+                    // A block handed to two threads at once would be overwritten
+                    auto* bytes = static_cast<uint8_t*>(result.value());
+                    std::fill(bytes, bytes + BLOCK_SIZE, static_cast<uint8_t>(t));
+                    held.push_back(bytes);
+                }
+                if (held.size() > BLOCK_COUNT / THREADS || (!held.empty() && i % 3 == 0)) {
+                    auto* bytes = static_cast<uint8_t*>(held.back());
+                    if (std::any_of(bytes, bytes + BLOCK_SIZE, [t](uint8_t b) { return b != t; })) {
+                        overlap.store(true);
+                    }
+                    held.pop_back();
+                    pool.deallocate(bytes);
+                }
+            }
+            for (void* block : held) {
+                pool.deallocate(block);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_FALSE(overlap.load());
+    EXPECT_TRUE(pool.is_empty());
+    const AllocatorStats stats = pool.get_stats();
+    EXPECT_EQ(stats.used_bytes, 0u);
+    EXPECT_LE(stats.peak_used_bytes, BLOCK_COUNT * BLOCK_SIZE);
+    EXPECT_GT(stats.total_allocations, 0u);
+}
+
+TEST(PoolAllocatorTest, ReportsPeakAndTotalAllocations) {
+    PoolAllocator pool(BLOCK_COUNT, BLOCK_SIZE);
+    std::vector<void*> blocks;
+    for (int i = 0; i < 10; ++i) {
+        blocks.push_back(pool.allocate(BLOCK_SIZE).value());
+    }
+    for (void* block : blocks) {
+        pool.deallocate(block);
+    }
+    pool.deallocate(pool.allocate(BLOCK_SIZE).value());
+
+    const AllocatorStats stats = pool.get_stats();
+    EXPECT_EQ(stats.used_bytes, 0u);
+    EXPECT_EQ(stats.peak_used_bytes, 10 * BLOCK_SIZE);
+    EXPECT_EQ(stats.total_allocations, 11u);
+}
+
+// =====================================================================
+// LinearAllocator
+// =====================================================================
+
+TEST(LinearAllocatorTest, ReportsPeakAndTotalAcrossResets) {
+    LinearAllocator linear(4096);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(linear.allocate(256, 16).is_ok());
+    }
+    linear.reset();
+    ASSERT_TRUE(linear.allocate(128, 16).is_ok());
+
+    const AllocatorStats stats = linear.get_stats();
+    EXPECT_EQ(stats.used_bytes, 128u);
+    EXPECT_EQ(stats.peak_used_bytes, 1024u);
+    EXPECT_EQ(stats.total_allocations, 5u);
+}
+
+TEST(LinearAllocatorTest, UnalignedPositionsDoNotOverlapBlocks) {
+    LinearAllocator linear(4096);
+    ASSERT_TRUE(linear.set_position(1).is_ok());
+    EXPECT_EQ(linear.get_position() % alignof(std::max_align_t), 0u);
+
+    auto first = linear.allocate(48, 16);
+    ASSERT_TRUE(first.is_ok());
+    auto second = linear.allocate(1, 1);
+    ASSERT_TRUE(second.is_ok());
+    EXPECT_GE(static_cast<uint8_t*>(second.value()), static_cast<uint8_t*>(first.value()) + 48);
+
+    // Checkpoints go through the same rounding
+    const size_t checkpoint = linear.create_checkpoint();
+    ASSERT_TRUE(linear.restore_checkpoint(checkpoint - 1).is_ok());
+    auto third = linear.allocate(32, 16);
+    ASSERT_TRUE(third.is_ok());
+    EXPECT_GE(static_cast<uint8_t*>(third.value()), static_cast<uint8_t*>(second.value()) + 1);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file linux_memory_pressure_monitor_test.cpp
+ * @brief Unit tests for the PSI / cgroup v2 memory pressure monitor
+ *
+ * A scratch directory stands in for the cgroup, so memory.events can be
+ * advanced by hand and the tests do not depend on real memory pressure.
+ */
+
+#include "../../../include/flight/hal/platform/linux_memory_pressure_monitor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace flight::hal;
+using namespace flight::hal::platform;
+
+namespace {
+
+class FakeCgroup {
+public:
+    FakeCgroup() {
+        char path[] = "/tmp/flight-hal-cgroup-XXXXXX";
+        path_ = mkdtemp(path) ? path : "";
+        write_events(0);
+    }
+
+    ~FakeCgroup() {
+        std::remove((path_ + "/memory.events").c_str());
+        rmdir(path_.c_str());
+    }
+
+    void write_events(uint64_t high) {
+        std::ofstream file(path_ + "/memory.events", std::ios::trunc);
+        file << "low 0\nhigh " << high << "\nmax 0\noom 0\noom_kill 0\n";
+    }
+
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+};
+
+LinuxMemoryPressureConfig fake_config(const FakeCgroup& cgroup) {
+    LinuxMemoryPressureConfig config;
+    config.triggers.clear(); // Only memory.events, which the tests control
+    config.cgroup_path = cgroup.path();
+    config.settle_time = std::chrono::milliseconds(100);
+    return config;
+}
+
+} // anonymous namespace
+
+TEST(LinuxMemoryPressureMonitorTest, CheckPressureNotifiesOnCallerWhenStopped) {
+    FakeCgroup cgroup;
+    ASSERT_FALSE(cgroup.path().empty());
+    LinuxMemoryPressureMonitor monitor(fake_config(cgroup));
+
+    std::thread::id callback_thread;
+    MemoryPressureLevel seen = MemoryPressureLevel::None;
+    ASSERT_TRUE(monitor.register_callback(MemoryPressureLevel::Low,
+                                          [&](MemoryPressureLevel level, const MemoryPressureInfo&) {
+                                              callback_thread = std::this_thread::get_id();
+                                              seen = level;
+                                          }).is_ok());
+
+    cgroup.write_events(1);
+    ASSERT_TRUE(monitor.check_pressure().is_ok());
+    EXPECT_EQ(seen, MemoryPressureLevel::Medium);
+    EXPECT_EQ(callback_thread, std::this_thread::get_id());
+    EXPECT_EQ(monitor.get_pressure_info().level, MemoryPressureLevel::Medium);
+}
+
+TEST(LinuxMemoryPressureMonitorTest, CheckPressureNotifiesOnMonitorThreadWhenRunning) {
+    FakeCgroup cgroup;
+    ASSERT_FALSE(cgroup.path().empty());
+    LinuxMemoryPressureMonitor monitor(fake_config(cgroup));
+
+    std::atomic<bool> raised{false};
+    std::atomic<bool> on_caller{false};
+    const std::thread::id caller = std::this_thread::get_id();
+    ASSERT_TRUE(monitor.register_callback(MemoryPressureLevel::Low,
+                                          [&](MemoryPressureLevel level, const MemoryPressureInfo&) {
+                                              if (std::this_thread::get_id() == caller) {
+                                                  on_caller.store(true);
+                                              }
+                                              if (level == MemoryPressureLevel::Medium) {
+                                                  raised.store(true);
+                                              }
+                                          }).is_ok());
+    ASSERT_TRUE(monitor.start().is_ok());
+
+    cgroup.write_events(1);
+    ASSERT_TRUE(monitor.check_pressure().is_ok());
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!raised.load() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    monitor.stop();
+
+    EXPECT_TRUE(raised.load());
+    EXPECT_FALSE(on_caller.load());
+}
+
+TEST(LinuxMemoryPressureMonitorTest, UnknownCallbackIdFails) {
+    FakeCgroup cgroup;
+    LinuxMemoryPressureMonitor monitor(fake_config(cgroup));
+    EXPECT_FALSE(monitor.unregister_callback(12345).is_ok());
+}
@@ -0,0 +1,286 @@
+#pragma once
+/**
+ * Flight-Core Shared Types - Allocation-free WIT views
+ *
+ * Runtime support for the bindings flight-wit-cpp17 generates from the
+ * WIT files: non-owning views for strings, lists, options, tuples and
+ * variants, an arena that backs returned values, and the canonical ABI
+ * layout of every type as constexpr traits.
+ *
+ * Every view is trivially copyable and never touches the heap. Parameters
+ * borrow the caller's memory; a function returning strings or lists takes
+ * an Arena and places them there, so a whole result is released by
+ * resetting the arena instead of freeing it field by field.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace flight::shared_types::wit {
+
+// The payload of a case without one, and of `_` in result<_, E>
+using Unit = std::monostate;
+
+/**
+ * Canonical ABI layout
+ *
+ * Size and alignment of a type in linear memory (wasm32). Records,
+ * tuples and variants describe themselves through a nested `layout`;
+ * enums and flags use their discriminant type.
+ */
+template <std::size_t Size, std::size_t Align>
+struct FixedLayout {
+    static constexpr std::size_t size = Size;
+    static constexpr std::size_t align = Align;
+};
+
+constexpr std::size_t align_to(std::size_t value, std::size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+template <typename T, bool = std::is_enum_v<T>>
+struct LayoutOf : T::layout {};
+
+template <typename T>
+struct Layout : LayoutOf<T> {};
+
+template <typename T>
+struct LayoutOf<T, true> : Layout<std::underlying_type_t<T>> {};
+
+template <> struct Layout<Unit> : FixedLayout<0, 1> {};
+template <> struct Layout<bool> : FixedLayout<1, 1> {};
+template <> struct Layout<std::uint8_t> : FixedLayout<1, 1> {};
+template <> struct Layout<std::int8_t> : FixedLayout<1, 1> {};
+template <> struct Layout<std::uint16_t> : FixedLayout<2, 2> {};
+template <> struct Layout<std::int16_t> : FixedLayout<2, 2> {};
+template <> struct Layout<std::uint32_t> : FixedLayout<4, 4> {};
+template <> struct Layout<std::int32_t> : FixedLayout<4, 4> {};
+template <> struct Layout<std::uint64_t> : FixedLayout<8, 8> {};
+template <> struct Layout<std::int64_t> : FixedLayout<8, 8> {};
+template <> struct Layout<float> : FixedLayout<4, 4> {};
+template <> struct Layout<double> : FixedLayout<8, 8> {};
+template <> struct Layout<char32_t> : FixedLayout<4, 4> {};
+template <> struct Layout<std::string_view> : FixedLayout<8, 4> {};
+
+// Fields laid out in order, each at its own alignment
+template <typename... Fields>
+struct RecordLayout {
+    static constexpr std::size_t align = std::max({std::size_t(1), Layout<Fields>::align...});
+
+    static constexpr std::size_t end() noexcept {
+        std::size_t offset = 0;
+        ((offset = align_to(offset, Layout<Fields>::align) + Layout<Fields>::size), ...);
+        return offset;
+    }
+
+    static constexpr std::size_t size = align_to(end(), align);
+};
+
+// A discriminant sized by the case count, then the largest payload
+template <typename... Cases>
+struct VariantLayout {
+    static constexpr std::size_t discriminant = sizeof...(Cases) <= 0x100 ? 1 : sizeof...(Cases) <= 0x10000 ? 2 : 4;
+    static constexpr std::size_t payload_align = std::max({std::size_t(1), Layout<Cases>::align...});
+    static constexpr std::size_t payload_size = std::max({std::size_t(0), Layout<Cases>::size...});
+    static constexpr std::size_t align = std::max(discriminant, payload_align);
+    static constexpr std::size_t size = align_to(align_to(discriminant, payload_align) + payload_size, align);
+};
+
+template <typename T>
+struct Layout<std::optional<T>> : VariantLayout<Unit, T> {};
+
+/**
+ * list<T>: a view of elements owned by the caller or an arena
+ */
+template <typename T>
+class List {
+public:
+    using value_type = T;
+    using layout = FixedLayout<8, 4>;
+
+    constexpr List() noexcept = default;
+    constexpr List(const T* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+    template <std::size_t N>
+    constexpr List(const T (&elements)[N]) noexcept : data_(elements), size_(N) {}
+
+    constexpr const T* data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr const T* begin() const noexcept { return data_; }
+    constexpr const T* end() const noexcept { return data_ + size_; }
+    constexpr const T& operator[](std::size_t index) const noexcept { return data_[index]; }
+
+private:
+    const T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/**
+ * tuple<...>: an aggregate, unlike std::tuple trivially copyable
+ */
+template <typename... Ts>
+struct Tuple;
+
+template <typename A>
+struct Tuple<A> {
+    A first;
+    using layout = RecordLayout<A>;
+};
+
+template <typename A, typename B>
+struct Tuple<A, B> {
+    A first;
+    B second;
+    using layout = RecordLayout<A, B>;
+};
+
+template <typename A, typename B, typename C>
+struct Tuple<A, B, C> {
+    A first;
+    B second;
+    C third;
+    using layout = RecordLayout<A, B, C>;
+};
+
+template <typename A, typename B, typename C, typename D>
+struct Tuple<A, B, C, D> {
+    A first;
+    B second;
+    C third;
+    D fourth;
+    using layout = RecordLayout<A, B, C, D>;
+};
+
+/**
+ * variant: one payload per case, selected by the case enum
+ *
+ * Cases are addressed by index, so several cases may share a payload
+ * type; accessors return pointers instead of throwing.
+ */
+template <typename Case, typename... Payloads>
+struct Variant {
+    using layout = VariantLayout<Payloads...>;
+
+    std::variant<Payloads...> value;
+
+    template <Case C, typename... Args>
+    static constexpr Variant make(Args&&... args) {
+        return Variant{std::variant<Payloads...>(std::in_place_index<static_cast<std::size_t>(C)>,
+                                                 std::forward<Args>(args)...)};
+    }
+
+    constexpr Case tag() const noexcept { return static_cast<Case>(value.index()); }
+
+    template <Case C>
+    constexpr const auto* get() const noexcept {
+        return std::get_if<static_cast<std::size_t>(C)>(&value);
+    }
+};
+
+enum class ResultCase : std::uint8_t {
+    Ok,
+    Err
+};
+
+// result<T, E>; a missing payload is Unit
+template <typename T = Unit, typename E = Unit>
+using Result = Variant<ResultCase, T, E>;
+
+// Also holds for variants shaped like a result, ok case first, such as flight-result
+template <typename Case, typename T, typename E>
+[[nodiscard]] constexpr bool is_ok(const Variant<Case, T, E>& result) noexcept {
+    return result.value.index() == 0;
+}
+
+/**
+ * Bump allocator over caller-provided storage
+ *
+ * Backs the strings and lists of returned values. Allocation never falls
+ * back to the heap: once the storage is used up it returns nullptr, or
+ * an empty view, and overflowed() stays set until reset().
+ */
+class Arena {
+public:
+    constexpr Arena(void* storage, std::size_t capacity) noexcept
+        : storage_(static_cast<unsigned char*>(storage)), capacity_(capacity) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment) noexcept {
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(storage_);
+        const std::size_t offset = align_to(base + used_, alignment) - base;
+        if (offset > capacity_ || size > capacity_ - offset) {
+            overflowed_ = true;
+            return nullptr;
+        }
+        used_ = offset + size;
+        return storage_ + offset;
+    }
+
+    // Uninitialized room for count elements of a view type
+    template <typename T>
+    T* allocate(std::size_t count) noexcept {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                      "Arena elements are never destroyed");
+        if (count > capacity_ / sizeof(T)) {
+            overflowed_ = true;
+            return nullptr;
+        }
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    std::string_view copy(std::string_view text) noexcept {
+        char* bytes = allocate<char>(text.size());
+        if (bytes == nullptr) {
+            return {};
+        }
+        std::memcpy(bytes, text.data(), text.size());
+        return {bytes, text.size()};
+    }
+
+    template <typename T>
+    List<T> copy(List<T> elements) noexcept {
+        T* copied = allocate<T>(elements.size());
+        if (copied == nullptr) {
+            return {};
+        }
+        std::memcpy(static_cast<void*>(copied), elements.data(), elements.size() * sizeof(T));
+        return {copied, elements.size()};
+    }
+
+    void reset() noexcept {
+        used_ = 0;
+        overflowed_ = false;
+    }
+
+    std::size_t used() const noexcept { return used_; }
+    std::size_t capacity() const noexcept { return capacity_; }
+    bool overflowed() const noexcept { return overflowed_; }
+
+private:
+    unsigned char* storage_;
+    std::size_t capacity_;
+    std::size_t used_ = 0;
+    bool overflowed_ = false;
+};
+
+// An arena with its storage inline, e.g. on the stack of a call
+template <std::size_t Capacity>
+class InlineArena : public Arena {
+public:
+    InlineArena() noexcept : Arena(storage_, Capacity) {}
+
+private:
+    alignas(std::max_align_t) unsigned char storage_[Capacity];
+};
+
+} // namespace flight::shared_types::wit
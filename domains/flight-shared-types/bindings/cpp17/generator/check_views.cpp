@@ -0,0 +1,12 @@
+/**
+ * Flight-Core Shared Types - generated view checks
+ *
+ * Includes every generated header once so their layout and triviality
+ * static_asserts are evaluated as part of the build.
+ */
+
+#include "flight/views/component.hpp"
+#include "flight/views/error.hpp"
+#include "flight/views/memory.hpp"
+#include "flight/views/platform.hpp"
+#include "flight/views/session.hpp"
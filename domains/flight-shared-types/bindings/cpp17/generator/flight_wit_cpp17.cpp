@@ -0,0 +1,1274 @@
+/**
+ * flight-wit-cpp17 - WIT to allocation-free C++17 bindings
+ *
+ * Usage: flight-wit-cpp17 --out-dir <dir> <file.wit>...
+ *
+ * Writes <dir>/flight/views/<package>.hpp for every package in the input
+ * files. Types become views over flight_wit_views.hpp: string parameters
+ * are std::string_view, lists wit::List spans, and functions whose
+ * results hold strings or lists take a wit::Arena to place them in.
+ * Each record and variant carries its canonical ABI layout as a
+ * constexpr trait, checked by static_asserts against the sizes the
+ * generator computes itself, so a drifting WIT file or view type fails
+ * to compile instead of misreading memory.
+ *
+ * Packages referenced by `use` must be among the inputs. The generator
+ * runs at build time; it is a host tool and may use exceptions.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Error : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+// =========================================================================
+// Lexer
+// =========================================================================
+
+struct Token {
+    enum class Kind { Identifier, Version, Punct, End };
+
+    Kind kind = Kind::End;
+    std::string text;
+    std::vector<std::string> docs; // `///` lines directly before the token
+    int line = 0;
+};
+
+std::vector<Token> tokenize(const std::string& source, const std::string& file) {
+    std::vector<Token> tokens;
+    std::vector<std::string> docs;
+    int line = 1;
+    size_t i = 0;
+    const auto is_identifier = [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_';
+    };
+
+    while (i < source.size()) {
+        const char c = source[i];
+        if (c == '\n') {
+            ++line;
+            ++i;
+        } else if (std::isspace(static_cast<unsigned char>(c))) {
+            ++i;
+        } else if (source.compare(i, 2, "//") == 0) {
+            const size_t end = std::min(source.find('\n', i), source.size());
+            if (source.compare(i, 3, "///") == 0) {
+                std::string text = source.substr(i + 3, end - i - 3);
+                if (!text.empty() && text[0] == ' ') {
+                    text.erase(0, 1);
+                }
+                while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+                    text.pop_back();
+                }
+                docs.push_back(text);
+            }
+            i = end;
+        } else if (source.compare(i, 2, "/*") == 0) {
+            const size_t end = source.find("*/", i + 2);
+            if (end == std::string::npos) {
+                throw Error(file + ":" + std::to_string(line) + ": unterminated comment");
+            }
+            line += static_cast<int>(std::count(source.begin() + i, source.begin() + end, '\n'));
+            i = end + 2;
+        } else {
+            Token token;
+            token.line = line;
+            token.docs = std::move(docs);
+            docs.clear();
+            if (std::isdigit(static_cast<unsigned char>(c))) {
+                // Package versions: 1.0.0, 0.2.0-rc
+                const size_t start = i;
+                while (i < source.size() && (is_identifier(source[i]) || source[i] == '.' || source[i] == '+')) {
+                    ++i;
+                }
+                token.kind = Token::Kind::Version;
+                token.text = source.substr(start, i - start);
+            } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '%' || c == '_') {
+                // `%` escapes identifiers that are keywords
+                const size_t start = c == '%' ? ++i : i;
+                while (i < source.size() && is_identifier(source[i])) {
+                    ++i;
+                }
+                token.kind = Token::Kind::Identifier;
+                token.text = source.substr(start, i - start);
+            } else if (source.compare(i, 2, "->") == 0) {
+                token.kind = Token::Kind::Punct;
+                token.text = "->";
+                i += 2;
+            } else if (std::string("{}()<>,:;.=/*@").find(c) != std::string::npos) {
+                token.kind = Token::Kind::Punct;
+                token.text = std::string(1, c);
+                ++i;
+            } else {
+                throw Error(file + ":" + std::to_string(line) + ": unexpected character '" + std::string(1, c) + "'");
+            }
+            tokens.push_back(std::move(token));
+        }
+    }
+    Token end;
+    end.line = line;
+    tokens.push_back(end);
+    return tokens;
+}
+
+// =========================================================================
+// Model
+// =========================================================================
+
+struct Type {
+    enum class Kind { Primitive, String, List, Option, Result, Tuple, Named };
+
+    Kind kind = Kind::Primitive;
+    std::string name; // Primitive and Named
+    std::vector<Type> args;
+    bool has_ok = false; // Result: args hold the ok payload, then the error
+    bool has_err = false;
+};
+
+struct Field {
+    std::string name;
+    bool has_type = false; // Variant cases without a payload have none
+    Type type;
+    std::vector<std::string> docs;
+};
+
+struct TypeDef {
+    enum class Kind { Record, Variant, Enum, Flags, Alias };
+
+    Kind kind = Kind::Record;
+    std::string name;
+    std::vector<std::string> params;
+    std::vector<Field> fields; // Record fields, variant, enum and flags cases
+    Type alias;
+    std::vector<std::string> docs;
+    int line = 0;
+};
+
+struct Function {
+    std::string name;
+    std::vector<std::string> params;
+    std::vector<Field> args;
+    bool has_result = false;
+    Type result;
+    std::vector<std::string> docs;
+};
+
+struct Use {
+    std::string package; // "namespace:name", or empty for this package
+    std::string interface;
+    std::vector<std::pair<std::string, std::string>> names; // (name, local name)
+    int line = 0;
+};
+
+struct Package;
+
+struct Interface {
+    const Package* package = nullptr;
+    std::string name;
+    std::vector<std::string> docs;
+    std::vector<Use> uses;
+    std::vector<TypeDef> types;
+    std::vector<Function> functions;
+};
+
+struct Package {
+    std::string id; // "namespace:name"
+    std::string name;
+    std::string file;
+    std::vector<std::unique_ptr<Interface>> interfaces;
+};
+
+// =========================================================================
+// Parser
+// =========================================================================
+
+class Parser {
+public:
+    Parser(std::vector<Token> tokens, std::string file) : tokens_(std::move(tokens)), file_(std::move(file)) {}
+
+    std::unique_ptr<Package> parse() {
+        auto package = std::make_unique<Package>();
+        package->file = file_;
+        expect_keyword("package");
+        const std::string ns = identifier();
+        expect(":");
+        package->name = identifier();
+        package->id = ns + ":" + package->name;
+        skip_version();
+        expect(";");
+
+        while (peek().kind != Token::Kind::End) {
+            if (accept_keyword("interface")) {
+                auto interface = std::make_unique<Interface>();
+                interface->package = package.get();
+                interface->docs = previous().docs;
+                interface->name = identifier();
+                expect("{");
+                while (!accept("}")) {
+                    parse_item(*interface);
+                }
+                package->interfaces.push_back(std::move(interface));
+            } else if (accept_keyword("world")) {
+                // Worlds only select interfaces; every interface is emitted
+                identifier();
+                skip_block();
+            } else if (accept_keyword("use")) {
+                while (!accept(";")) {
+                    next();
+                }
+            } else {
+                fail("expected interface or world");
+            }
+        }
+        return package;
+    }
+
+private:
+    void parse_item(Interface& interface) {
+        const Token& start = peek();
+        if (accept_keyword("use")) {
+            interface.uses.push_back(parse_use(start.line));
+        } else if (accept_keyword("record")) {
+            TypeDef def = begin_type(TypeDef::Kind::Record, start);
+            expect("{");
+            while (!accept("}")) {
+                Field field;
+                field.docs = peek().docs;
+                field.name = identifier();
+                expect(":");
+                field.has_type = true;
+                field.type = parse_type();
+                def.fields.push_back(std::move(field));
+                if (!accept(",")) {
+                    expect("}");
+                    break;
+                }
+            }
+            interface.types.push_back(std::move(def));
+        } else if (accept_keyword("variant")) {
+            TypeDef def = begin_type(TypeDef::Kind::Variant, start);
+            expect("{");
+            while (!accept("}")) {
+                Field field;
+                field.docs = peek().docs;
+                field.name = identifier();
+                if (accept("(")) {
+                    field.has_type = true;
+                    field.type = parse_type();
+                    expect(")");
+                }
+                def.fields.push_back(std::move(field));
+                if (!accept(",")) {
+                    expect("}");
+                    break;
+                }
+            }
+            interface.types.push_back(std::move(def));
+        } else if (accept_keyword("enum") || accept_keyword("flags")) {
+            const bool flags = previous().text == "flags";
+            TypeDef def = begin_type(flags ? TypeDef::Kind::Flags : TypeDef::Kind::Enum, start);
+            expect("{");
+            while (!accept("}")) {
+                Field field;
+                field.docs = peek().docs;
+                field.name = identifier();
+                def.fields.push_back(std::move(field));
+                if (!accept(",")) {
+                    expect("}");
+                    break;
+                }
+            }
+            if (def.fields.empty()) {
+                fail("'" + def.name + "' has no cases");
+            }
+            interface.types.push_back(std::move(def));
+        } else if (accept_keyword("type")) {
+            TypeDef def = begin_type(TypeDef::Kind::Alias, start);
+            expect("=");
+            def.alias = parse_type();
+            expect(";");
+            interface.types.push_back(std::move(def));
+        } else if (accept_keyword("resource")) {
+            fail("resources are not supported");
+        } else {
+            Function function;
+            function.docs = start.docs;
+            function.name = identifier();
+            expect(":");
+            expect_keyword("func");
+            function.params = type_params();
+            expect("(");
+            while (!accept(")")) {
+                Field arg;
+                arg.name = identifier();
+                expect(":");
+                arg.has_type = true;
+                arg.type = parse_type();
+                function.args.push_back(std::move(arg));
+                if (!accept(",")) {
+                    expect(")");
+                    break;
+                }
+            }
+            if (accept("->")) {
+                if (peek().text == "(") {
+                    fail("named results are not supported");
+                }
+                function.has_result = true;
+                function.result = parse_type();
+            }
+            expect(";");
+            interface.functions.push_back(std::move(function));
+        }
+    }
+
+    Use parse_use(int line) {
+        Use use;
+        use.line = line;
+        use.interface = identifier();
+        if (accept(":")) {
+            use.package = use.interface + ":" + identifier();
+            expect("/");
+            use.interface = identifier();
+            skip_version();
+        }
+        expect(".");
+        expect("{");
+        while (!accept("}")) {
+            const std::string name = identifier();
+            std::string local = name;
+            if (accept_keyword("as")) {
+                local = identifier();
+            }
+            use.names.emplace_back(name, local);
+            if (!accept(",")) {
+                expect("}");
+                break;
+            }
+        }
+        expect(";");
+        return use;
+    }
+
+    TypeDef begin_type(TypeDef::Kind kind, const Token& start) {
+        TypeDef def;
+        def.kind = kind;
+        def.docs = start.docs;
+        def.line = start.line;
+        def.name = identifier();
+        def.params = type_params();
+        return def;
+    }
+
+    std::vector<std::string> type_params() {
+        std::vector<std::string> params;
+        if (accept("<")) {
+            do {
+                params.push_back(identifier());
+            } while (accept(","));
+            expect(">");
+        }
+        return params;
+    }
+
+    Type parse_type() {
+        static const std::set<std::string> primitives = {"bool", "u8",  "u16", "u32", "u64", "s8",
+                                                         "s16",  "s32", "s64", "f32", "f64", "float32",
+                                                         "float64", "char"};
+        Type type;
+        type.name = identifier();
+        if (primitives.count(type.name) != 0) {
+            type.kind = Type::Kind::Primitive;
+        } else if (type.name == "string") {
+            type.kind = Type::Kind::String;
+        } else if (type.name == "list" || type.name == "option") {
+            type.kind = type.name == "list" ? Type::Kind::List : Type::Kind::Option;
+            expect("<");
+            type.args.push_back(parse_type());
+            expect(">");
+        } else if (type.name == "tuple") {
+            type.kind = Type::Kind::Tuple;
+            expect("<");
+            do {
+                type.args.push_back(parse_type());
+            } while (accept(","));
+            expect(">");
+            if (type.args.size() > 4) {
+                fail("tuples of more than four elements are not supported");
+            }
+        } else if (type.name == "result") {
+            type.kind = Type::Kind::Result;
+            if (accept("<")) {
+                if (peek().text == "_") {
+                    next();
+                } else {
+                    type.has_ok = true;
+                    type.args.push_back(parse_type());
+                }
+                if (accept(",")) {
+                    type.has_err = true;
+                    type.args.push_back(parse_type());
+                }
+                expect(">");
+            }
+        } else if (type.name == "own" || type.name == "borrow" || type.name == "future" || type.name == "stream") {
+            fail("'" + type.name + "' types are not supported");
+        } else {
+            type.kind = Type::Kind::Named;
+            if (accept("<")) {
+                do {
+                    type.args.push_back(parse_type());
+                } while (accept(","));
+                expect(">");
+            }
+        }
+        return type;
+    }
+
+    void skip_version() {
+        if (accept("@")) {
+            if (peek().kind != Token::Kind::Version) {
+                fail("expected a version");
+            }
+            next();
+        }
+    }
+
+    void skip_block() {
+        expect("{");
+        int depth = 1;
+        while (depth > 0) {
+            if (peek().kind == Token::Kind::End) {
+                fail("unterminated block");
+            }
+            const std::string& text = next().text;
+            depth += text == "{" ? 1 : text == "}" ? -1 : 0;
+        }
+    }
+
+    const Token& peek() const { return tokens_[position_]; }
+    const Token& previous() const { return tokens_[position_ - 1]; }
+
+    const Token& next() {
+        const Token& token = tokens_[position_];
+        if (token.kind != Token::Kind::End) {
+            ++position_;
+        }
+        return token;
+    }
+
+    bool accept(const char* punct) {
+        if (peek().kind == Token::Kind::Punct && peek().text == punct) {
+            next();
+            return true;
+        }
+        return false;
+    }
+
+    bool accept_keyword(const char* keyword) {
+        if (peek().kind == Token::Kind::Identifier && peek().text == keyword) {
+            next();
+            return true;
+        }
+        return false;
+    }
+
+    void expect(const char* punct) {
+        if (!accept(punct)) {
+            fail(std::string("expected '") + punct + "'");
+        }
+    }
+
+    void expect_keyword(const char* keyword) {
+        if (!accept_keyword(keyword)) {
+            fail(std::string("expected '") + keyword + "'");
+        }
+    }
+
+    std::string identifier() {
+        if (peek().kind != Token::Kind::Identifier) {
+            fail("expected an identifier");
+        }
+        return next().text;
+    }
+
+    [[noreturn]] void fail(const std::string& message) const {
+        const Token& token = peek();
+        const std::string found = token.kind == Token::Kind::End ? "end of file" : "'" + token.text + "'";
+        throw Error(file_ + ":" + std::to_string(token.line) + ": " + message + ", found " + found);
+    }
+
+    std::vector<Token> tokens_;
+    std::string file_;
+    size_t position_ = 0;
+};
+
+// =========================================================================
+// Names
+// =========================================================================
+
+const std::set<std::string>& reserved_names() {
+    // C++ keywords, and names the generated code looks up unqualified
+    static const std::set<std::string> names = {
+        "alignas", "alignof", "and", "asm", "auto", "bool", "break", "case", "catch", "char", "class", "const",
+        "constexpr", "continue", "decltype", "default", "delete", "do", "double", "else", "enum", "explicit",
+        "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int", "long", "mutable",
+        "namespace", "new", "noexcept", "not", "nullptr", "operator", "or", "private", "protected", "public",
+        "register", "return", "short", "signed", "sizeof", "static", "struct", "switch", "template", "this",
+        "throw", "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void",
+        "volatile", "while", "xor", "std", "wit", "flight", "arena"};
+    return names;
+}
+
+std::string snake_name(const std::string& name) {
+    std::string result = name;
+    std::replace(result.begin(), result.end(), '-', '_');
+    return reserved_names().count(result) != 0 ? result + "_" : result;
+}
+
+std::string pascal_name(const std::string& name) {
+    std::string result;
+    bool upper = true;
+    for (const char c : name) {
+        if (c == '-' || c == '_') {
+            upper = true;
+        } else {
+            result += upper ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : c;
+            upper = false;
+        }
+    }
+    return result;
+}
+
+const char* primitive_type(const std::string& name) {
+    static const std::map<std::string, const char*> types = {
+        {"bool", "bool"},          {"u8", "std::uint8_t"},  {"u16", "std::uint16_t"}, {"u32", "std::uint32_t"},
+        {"u64", "std::uint64_t"},  {"s8", "std::int8_t"},   {"s16", "std::int16_t"},  {"s32", "std::int32_t"},
+        {"s64", "std::int64_t"},   {"f32", "float"},        {"f64", "double"},        {"float32", "float"},
+        {"float64", "double"},     {"char", "char32_t"}};
+    return types.at(name);
+}
+
+// Discriminant of an enum or variant with count cases
+const char* discriminant_type(size_t count) {
+    return count <= 0x100 ? "std::uint8_t" : count <= 0x10000 ? "std::uint16_t" : "std::uint32_t";
+}
+
+// Storage of flags with count members
+const char* flags_type(size_t count) {
+    return count <= 8 ? "std::uint8_t" : count <= 16 ? "std::uint16_t" : "std::uint32_t";
+}
+
+// =========================================================================
+// Resolution
+// =========================================================================
+
+struct Resolved {
+    const Interface* interface;
+    const TypeDef* def;
+};
+
+class Resolver {
+public:
+    void add(std::unique_ptr<Package> package) {
+        if (packages_.count(package->id) != 0) {
+            throw Error(package->file + ": package " + package->id + " is also defined in " +
+                        packages_[package->id]->file);
+        }
+        const std::string id = package->id;
+        packages_[id] = std::move(package);
+    }
+
+    const std::map<std::string, std::unique_ptr<Package>>& packages() const { return packages_; }
+
+    const Interface& used_interface(const Interface& from, const Use& use) const {
+        const Package* package = from.package;
+        if (!use.package.empty()) {
+            const auto found = packages_.find(use.package);
+            if (found == packages_.end()) {
+                throw Error(from.package->file + ":" + std::to_string(use.line) + ": package " + use.package +
+                            " is not among the inputs");
+            }
+            package = found->second.get();
+        }
+        for (const auto& interface : package->interfaces) {
+            if (interface->name == use.interface) {
+                return *interface;
+            }
+        }
+        throw Error(from.package->file + ":" + std::to_string(use.line) + ": no interface " + use.interface +
+                    " in " + package->id);
+    }
+
+    // The definition a name refers to in an interface, following `use`
+    Resolved resolve(const Interface& interface, const std::string& name) const {
+        const Interface* current = &interface;
+        std::string wanted = name;
+        for (int depth = 0; depth < 16; ++depth) {
+            const TypeDef* def = find_local(*current, wanted);
+            if (def != nullptr) {
+                return Resolved{current, def};
+            }
+            const Use* use = find_use(*current, wanted);
+            if (use == nullptr) {
+                throw Error(current->package->file + ": unknown type '" + wanted + "' in interface " +
+                            current->name);
+            }
+            current = &used_interface(*current, *use);
+        }
+        throw Error(interface.package->file + ": `use` of '" + name + "' does not terminate");
+    }
+
+    // The `use` naming a type locally; renames name to the used one
+    static const Use* find_use(const Interface& interface, std::string& name) {
+        for (const Use& use : interface.uses) {
+            for (const auto& [used, local] : use.names) {
+                if (local == name) {
+                    name = used;
+                    return &use;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    static const TypeDef* find_local(const Interface& interface, const std::string& name) {
+        for (const TypeDef& def : interface.types) {
+            if (def.name == name) {
+                return &def;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    std::map<std::string, std::unique_ptr<Package>> packages_;
+};
+
+// =========================================================================
+// Canonical ABI layout
+// =========================================================================
+
+struct Layout {
+    uint64_t size;
+    uint64_t align;
+};
+
+uint64_t align_to(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// A type together with the interface its names are looked up in and the
+// arguments bound to the generic parameters in scope
+struct Scope;
+
+struct Binding {
+    const Type* type;
+    const Interface* interface;
+    const Scope* scope;
+};
+
+struct Scope {
+    std::map<std::string, Binding> params;
+};
+
+class LayoutCalculator {
+public:
+    explicit LayoutCalculator(const Resolver& resolver) : resolver_(resolver) {}
+
+    Layout of(const Type& type, const Interface& interface, const Scope* scope) const {
+        switch (type.kind) {
+        case Type::Kind::Primitive: {
+            const std::string& name = type.name;
+            if (name == "bool" || name == "u8" || name == "s8") {
+                return {1, 1};
+            }
+            if (name == "u16" || name == "s16") {
+                return {2, 2};
+            }
+            if (name == "u64" || name == "s64" || name == "f64" || name == "float64") {
+                return {8, 8};
+            }
+            return {4, 4};
+        }
+        case Type::Kind::String:
+        case Type::Kind::List:
+            return {8, 4};
+        case Type::Kind::Option:
+            return variant({Layout{0, 1}, of(type.args[0], interface, scope)});
+        case Type::Kind::Result: {
+            std::vector<Layout> cases;
+            size_t arg = 0;
+            cases.push_back(type.has_ok ? of(type.args[arg++], interface, scope) : Layout{0, 1});
+            cases.push_back(type.has_err ? of(type.args[arg], interface, scope) : Layout{0, 1});
+            return variant(cases);
+        }
+        case Type::Kind::Tuple: {
+            std::vector<Layout> fields;
+            for (const Type& arg : type.args) {
+                fields.push_back(of(arg, interface, scope));
+            }
+            return record(fields);
+        }
+        case Type::Kind::Named:
+            break;
+        }
+
+        if (scope != nullptr) {
+            const auto bound = scope->params.find(type.name);
+            if (bound != scope->params.end()) {
+                return of(*bound->second.type, *bound->second.interface, bound->second.scope);
+            }
+        }
+        const Resolved resolved = resolver_.resolve(interface, type.name);
+        const TypeDef& def = *resolved.def;
+        if (def.params.size() != type.args.size()) {
+            throw Error(interface.package->file + ": '" + type.name + "' takes " +
+                        std::to_string(def.params.size()) + " type arguments");
+        }
+        Scope inner;
+        for (size_t i = 0; i < def.params.size(); ++i) {
+            inner.params[def.params[i]] = Binding{&type.args[i], &interface, scope};
+        }
+        return of(def, *resolved.interface, &inner);
+    }
+
+    Layout of(const TypeDef& def, const Interface& interface, const Scope* scope) const {
+        std::vector<Layout> members;
+        switch (def.kind) {
+        case TypeDef::Kind::Record:
+            for (const Field& field : def.fields) {
+                members.push_back(of(field.type, interface, scope));
+            }
+            return record(members);
+        case TypeDef::Kind::Variant:
+            for (const Field& field : def.fields) {
+                members.push_back(field.has_type ? of(field.type, interface, scope) : Layout{0, 1});
+            }
+            return variant(members);
+        case TypeDef::Kind::Enum:
+            return variant(std::vector<Layout>(def.fields.size(), Layout{0, 1}));
+        case TypeDef::Kind::Flags: {
+            const uint64_t size = def.fields.size() <= 8 ? 1 : def.fields.size() <= 16 ? 2 : 4;
+            return {size, size};
+        }
+        case TypeDef::Kind::Alias:
+            return of(def.alias, interface, scope);
+        }
+        return {0, 1};
+    }
+
+private:
+    static Layout record(const std::vector<Layout>& fields) {
+        uint64_t size = 0;
+        uint64_t align = 1;
+        for (const Layout& field : fields) {
+            size = align_to(size, field.align) + field.size;
+            align = std::max(align, field.align);
+        }
+        return {align_to(size, align), align};
+    }
+
+    static Layout variant(const std::vector<Layout>& cases) {
+        const uint64_t discriminant = cases.size() <= 0x100 ? 1 : cases.size() <= 0x10000 ? 2 : 4;
+        uint64_t payload_size = 0;
+        uint64_t payload_align = 1;
+        for (const Layout& payload : cases) {
+            payload_size = std::max(payload_size, payload.size);
+            payload_align = std::max(payload_align, payload.align);
+        }
+        const uint64_t align = std::max(discriminant, payload_align);
+        return {align_to(align_to(discriminant, payload_align) + payload_size, align), align};
+    }
+
+    const Resolver& resolver_;
+};
+
+// =========================================================================
+// Emitter
+// =========================================================================
+
+const char* const VIEWS_NAMESPACE = "flight::shared_types::views";
+
+class Emitter {
+public:
+    explicit Emitter(const Resolver& resolver) : resolver_(resolver), layouts_(resolver) {}
+
+    std::string emit(const Package& package) {
+        out_.str("");
+        out_ << "// Generated by flight-wit-cpp17 from " << base_name(package.file) << ". DO NOT EDIT!\n"
+             << "#pragma once\n\n"
+             << "#include \"flight_wit_views.hpp\"\n";
+        for (const std::string& dependency : package_dependencies(package)) {
+            out_ << "#include \"flight/views/" << dependency << ".hpp\"\n";
+        }
+        out_ << "\n"
+             << "#include <cstdint>\n"
+             << "#include <optional>\n"
+             << "#include <string_view>\n"
+             << "#include <type_traits>\n\n"
+             << "namespace " << VIEWS_NAMESPACE << "::" << snake_name(package.name) << " {\n";
+
+        for (const Interface* interface : interface_order(package)) {
+            emit_interface(*interface);
+        }
+        out_ << "\n} // namespace " << VIEWS_NAMESPACE << "::" << snake_name(package.name) << "\n";
+        return out_.str();
+    }
+
+    // Names of the other packages a package uses, in a stable order
+    std::vector<std::string> package_dependencies(const Package& package) const {
+        std::set<std::string> names;
+        for (const auto& interface : package.interfaces) {
+            for (const Use& use : interface->uses) {
+                if (!use.package.empty() && use.package != package.id) {
+                    names.insert(resolver_.used_interface(*interface, use).package->name);
+                }
+            }
+        }
+        return {names.begin(), names.end()};
+    }
+
+private:
+    // Interfaces after those they use, keeping file order otherwise
+    std::vector<const Interface*> interface_order(const Package& package) const {
+        std::vector<const Interface*> order;
+        std::set<const Interface*> done;
+        std::set<const Interface*> visiting;
+        std::function<void(const Interface&)> visit = [&](const Interface& interface) {
+            if (done.count(&interface) != 0) {
+                return;
+            }
+            if (!visiting.insert(&interface).second) {
+                throw Error(package.file + ": interfaces use each other: " + interface.name);
+            }
+            for (const Use& use : interface.uses) {
+                if (use.package.empty()) {
+                    visit(resolver_.used_interface(interface, use));
+                }
+            }
+            done.insert(&interface);
+            order.push_back(&interface);
+        };
+        for (const auto& interface : package.interfaces) {
+            visit(*interface);
+        }
+        return order;
+    }
+
+    // Definitions after the local ones they contain
+    std::vector<const TypeDef*> type_order(const Interface& interface) const {
+        std::vector<const TypeDef*> order;
+        std::set<const TypeDef*> done;
+        std::set<const TypeDef*> visiting;
+        std::function<void(const TypeDef&)> visit;
+        std::function<void(const Type&, const TypeDef&)> visit_type = [&](const Type& type, const TypeDef& owner) {
+            if (type.kind == Type::Kind::Named &&
+                std::find(owner.params.begin(), owner.params.end(), type.name) == owner.params.end()) {
+                const TypeDef* local = Resolver::find_local(interface, type.name);
+                if (local != nullptr) {
+                    visit(*local);
+                } else {
+                    resolver_.resolve(interface, type.name);
+                }
+            }
+            for (const Type& arg : type.args) {
+                visit_type(arg, owner);
+            }
+        };
+        visit = [&](const TypeDef& def) {
+            if (done.count(&def) != 0) {
+                return;
+            }
+            if (!visiting.insert(&def).second) {
+                throw Error(interface.package->file + ":" + std::to_string(def.line) + ": '" + def.name +
+                            "' contains itself");
+            }
+            for (const Field& field : def.fields) {
+                if (field.has_type) {
+                    visit_type(field.type, def);
+                }
+            }
+            if (def.kind == TypeDef::Kind::Alias) {
+                visit_type(def.alias, def);
+            }
+            done.insert(&def);
+            order.push_back(&def);
+        };
+        for (const TypeDef& def : interface.types) {
+            visit(def);
+        }
+        return order;
+    }
+
+    void emit_interface(const Interface& interface) {
+        out_ << "\n";
+        docs(interface.docs, "");
+        out_ << "namespace " << snake_name(interface.name) << " {\n";
+
+        bool first_use = true;
+        for (const Use& use : interface.uses) {
+            const Interface& target = resolver_.used_interface(interface, use);
+            for (const auto& [name, local] : use.names) {
+                const Resolved origin = resolver_.resolve(target, name);
+                const std::string qualified = std::string("::") + VIEWS_NAMESPACE + "::" +
+                                              snake_name(origin.interface->package->name) + "::" +
+                                              snake_name(origin.interface->name) + "::" + pascal_name(origin.def->name);
+                out_ << (first_use ? "\n" : "");
+                first_use = false;
+                if (local == name) {
+                    out_ << "using " << qualified << ";\n";
+                } else if (!origin.def->params.empty()) {
+                    out_ << template_header(origin.def->params) << "using " << pascal_name(local) << " = "
+                         << qualified << "<" << join(origin.def->params) << ">;\n";
+                } else {
+                    out_ << "using " << pascal_name(local) << " = " << qualified << ";\n";
+                }
+            }
+        }
+
+        for (const TypeDef* def : type_order(interface)) {
+            out_ << "\n";
+            emit_type(*def, interface);
+        }
+        for (const Function& function : interface.functions) {
+            out_ << "\n";
+            emit_function(function, interface);
+        }
+        out_ << "\n} // namespace " << snake_name(interface.name) << "\n";
+    }
+
+    void emit_type(const TypeDef& def, const Interface& interface) {
+        const std::string name = pascal_name(def.name);
+        switch (def.kind) {
+        case TypeDef::Kind::Record: {
+            docs(def.docs, "");
+            out_ << template_header(def.params) << "struct " << name << " {\n";
+            std::vector<std::string> members;
+            for (const Field& field : def.fields) {
+                const std::string type = cpp_type(field.type, interface, def.params);
+                docs(field.docs, "    ");
+                out_ << "    " << type << " " << snake_name(field.name) << ";\n";
+                members.push_back(type);
+            }
+            if (!def.fields.empty()) {
+                out_ << "\n";
+            }
+            out_ << wrapped("    using layout = wit::RecordLayout<", members, ">;", "        ") << "};\n";
+            break;
+        }
+        case TypeDef::Kind::Variant: {
+            const std::string cases = name + "Case";
+            out_ << "enum class " << cases << " : " << discriminant_type(def.fields.size()) << " {\n";
+            std::vector<std::string> payloads;
+            for (size_t i = 0; i < def.fields.size(); ++i) {
+                const Field& field = def.fields[i];
+                docs(field.docs, "    ");
+                out_ << "    " << pascal_name(field.name) << (i + 1 < def.fields.size() ? ",\n" : "\n");
+                payloads.push_back(field.has_type ? cpp_type(field.type, interface, def.params) : "wit::Unit");
+            }
+            out_ << "};\n\n";
+            docs(def.docs, "");
+            payloads.insert(payloads.begin(), cases);
+            out_ << template_header(def.params)
+                 << wrapped("using " + name + " = wit::Variant<", payloads, ">;", "    ");
+            break;
+        }
+        case TypeDef::Kind::Enum:
+            docs(def.docs, "");
+            out_ << "enum class " << name << " : " << discriminant_type(def.fields.size()) << " {\n";
+            for (size_t i = 0; i < def.fields.size(); ++i) {
+                docs(def.fields[i].docs, "    ");
+                out_ << "    " << pascal_name(def.fields[i].name) << (i + 1 < def.fields.size() ? ",\n" : "\n");
+            }
+            out_ << "};\n";
+            break;
+        case TypeDef::Kind::Flags: {
+            if (def.fields.size() > 32) {
+                throw Error(interface.package->file + ":" + std::to_string(def.line) +
+                            ": flags of more than 32 members are not supported");
+            }
+            const char* storage = flags_type(def.fields.size());
+            docs(def.docs, "");
+            out_ << "enum class " << name << " : " << storage << " {\n";
+            for (size_t i = 0; i < def.fields.size(); ++i) {
+                docs(def.fields[i].docs, "    ");
+                out_ << "    " << pascal_name(def.fields[i].name) << " = 1u << " << i
+                     << (i + 1 < def.fields.size() ? ",\n" : "\n");
+            }
+            out_ << "};\n\n"
+                 << "constexpr " << name << " operator|(" << name << " a, " << name << " b) noexcept {\n"
+                 << "    return static_cast<" << name << ">(static_cast<" << storage << ">(a) | static_cast<"
+                 << storage << ">(b));\n"
+                 << "}\n\n"
+                 << "constexpr " << name << " operator&(" << name << " a, " << name << " b) noexcept {\n"
+                 << "    return static_cast<" << name << ">(static_cast<" << storage << ">(a) & static_cast<"
+                 << storage << ">(b));\n"
+                 << "}\n";
+            break;
+        }
+        case TypeDef::Kind::Alias:
+            docs(def.docs, "");
+            out_ << "using " << name << " = " << cpp_type(def.alias, interface, {}) << ";\n";
+            break;
+        }
+
+        // Generic definitions are checked where they are used
+        const bool compound = def.kind == TypeDef::Kind::Record || def.kind == TypeDef::Kind::Variant;
+        if (compound && def.params.empty()) {
+            const Layout layout = layouts_.of(def, interface, nullptr);
+            out_ << "static_assert(wit::Layout<" << name << ">::size == " << layout.size << " && wit::Layout<"
+                 << name << ">::align == " << layout.align << ",\n"
+                 << "              \"" << def.name << ": canonical ABI layout changed\");\n"
+                 << "static_assert(std::is_trivially_copyable_v<" << name << ">,\n"
+                 << "              \"" << def.name << ": views must not own memory\");\n";
+        }
+    }
+
+    void emit_function(const Function& function, const Interface& interface) {
+        std::vector<std::string> args;
+        for (const Field& arg : function.args) {
+            args.push_back(parameter_type(arg.type, interface, function.params) + " " + snake_name(arg.name));
+        }
+        if (function.has_result && needs_arena(function.result, interface, function.params)) {
+            args.push_back("wit::Arena& arena");
+        }
+        const std::string result =
+            function.has_result ? cpp_type(function.result, interface, function.params) : "void";
+
+        docs(function.docs, "");
+        out_ << template_header(function.params)
+             << wrapped(result + " " + snake_name(function.name) + "(", args, ");", "    ");
+    }
+
+    std::string cpp_type(const Type& type, const Interface& interface, const std::vector<std::string>& params) const {
+        switch (type.kind) {
+        case Type::Kind::Primitive:
+            return primitive_type(type.name);
+        case Type::Kind::String:
+            return "std::string_view";
+        case Type::Kind::List:
+            return "wit::List<" + cpp_type(type.args[0], interface, params) + ">";
+        case Type::Kind::Option:
+            return "std::optional<" + cpp_type(type.args[0], interface, params) + ">";
+        case Type::Kind::Result: {
+            if (!type.has_ok && !type.has_err) {
+                return "wit::Result<>";
+            }
+            size_t arg = 0;
+            const std::string ok = type.has_ok ? cpp_type(type.args[arg++], interface, params) : "wit::Unit";
+            return "wit::Result<" + ok +
+                   (type.has_err ? ", " + cpp_type(type.args[arg], interface, params) : std::string()) + ">";
+        }
+        case Type::Kind::Tuple: {
+            std::vector<std::string> elements;
+            for (const Type& arg : type.args) {
+                elements.push_back(cpp_type(arg, interface, params));
+            }
+            return "wit::Tuple<" + join(elements) + ">";
+        }
+        case Type::Kind::Named:
+            break;
+        }
+
+        if (std::find(params.begin(), params.end(), type.name) != params.end()) {
+            return type.name;
+        }
+        const TypeDef& def = *resolver_.resolve(interface, type.name).def;
+        if (def.params.size() != type.args.size()) {
+            throw Error(interface.package->file + ": '" + type.name + "' takes " +
+                        std::to_string(def.params.size()) + " type arguments");
+        }
+        if (type.args.empty()) {
+            return pascal_name(type.name);
+        }
+        std::vector<std::string> args;
+        for (const Type& arg : type.args) {
+            args.push_back(cpp_type(arg, interface, params));
+        }
+        return pascal_name(type.name) + "<" + join(args) + ">";
+    }
+
+    std::string parameter_type(const Type& type, const Interface& interface,
+                               const std::vector<std::string>& params) const {
+        const std::string spelled = cpp_type(type, interface, params);
+        return by_value(type, interface, params) ? spelled : "const " + spelled + "&";
+    }
+
+    // Scalars, enums and views are passed by value; everything else by reference
+    bool by_value(const Type& type, const Interface& interface, const std::vector<std::string>& params) const {
+        switch (type.kind) {
+        case Type::Kind::Primitive:
+        case Type::Kind::String:
+        case Type::Kind::List:
+            return true;
+        case Type::Kind::Named: {
+            if (std::find(params.begin(), params.end(), type.name) != params.end()) {
+                return false;
+            }
+            const Resolved resolved = resolver_.resolve(interface, type.name);
+            const TypeDef& def = *resolved.def;
+            return def.kind == TypeDef::Kind::Enum || def.kind == TypeDef::Kind::Flags ||
+                   (def.kind == TypeDef::Kind::Alias && by_value(def.alias, *resolved.interface, {}));
+        }
+        default:
+            return false;
+        }
+    }
+
+    // Whether a value of the type holds strings or lists the callee must place somewhere
+    bool needs_arena(const Type& type, const Interface& interface, const std::vector<std::string>& params) const {
+        switch (type.kind) {
+        case Type::Kind::Primitive:
+            return false;
+        case Type::Kind::String:
+        case Type::Kind::List:
+            return true;
+        case Type::Kind::Named:
+            if (std::find(params.begin(), params.end(), type.name) != params.end()) {
+                return true;
+            }
+            if (needs_arena(resolver_.resolve(interface, type.name))) {
+                return true;
+            }
+            break;
+        default:
+            break;
+        }
+        for (const Type& arg : type.args) {
+            if (needs_arena(arg, interface, params)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool needs_arena(const Resolved& resolved) const {
+        const TypeDef& def = *resolved.def;
+        for (const Field& field : def.fields) {
+            if (field.has_type && needs_arena(field.type, *resolved.interface, def.params)) {
+                return true;
+            }
+        }
+        return def.kind == TypeDef::Kind::Alias && needs_arena(def.alias, *resolved.interface, {});
+    }
+
+    void docs(const std::vector<std::string>& lines, const char* indent) {
+        for (const std::string& line : lines) {
+            out_ << indent << "//" << (line.empty() ? "" : " ") << line << "\n";
+        }
+    }
+
+    static std::string template_header(const std::vector<std::string>& params) {
+        if (params.empty()) {
+            return "";
+        }
+        std::string header = "template <";
+        for (size_t i = 0; i < params.size(); ++i) {
+            header += (i == 0 ? "typename " : ", typename ") + params[i];
+        }
+        return header + ">\n";
+    }
+
+    // head, parts and tail on one line, or one part per line if that is too long
+    static std::string wrapped(const std::string& head, const std::vector<std::string>& parts,
+                               const std::string& tail, const std::string& indent) {
+        const std::string line = head + join(parts) + tail;
+        if (line.size() <= 100 || parts.empty()) {
+            return line + "\n";
+        }
+        std::string result = head + "\n";
+        for (size_t i = 0; i < parts.size(); ++i) {
+            result += indent + parts[i] + (i + 1 < parts.size() ? ",\n" : tail + "\n");
+        }
+        return result;
+    }
+
+    static std::string join(const std::vector<std::string>& parts) {
+        std::string joined;
+        for (size_t i = 0; i < parts.size(); ++i) {
+            joined += (i == 0 ? "" : ", ") + parts[i];
+        }
+        return joined;
+    }
+
+    static std::string base_name(const std::string& path) {
+        const size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+
+    const Resolver& resolver_;
+    LayoutCalculator layouts_;
+    std::ostringstream out_;
+};
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw Error(path + ": cannot open");
+    }
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+void write_file(const std::string& path, const std::string& contents) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out || !(out << contents)) {
+        throw Error(path + ": cannot write");
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string out_dir;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--out-dir" && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "flight-wit-cpp17: unknown option " << arg << "\n";
+            return 2;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (out_dir.empty() || inputs.empty()) {
+        std::cerr << "usage: flight-wit-cpp17 --out-dir <dir> <file.wit>...\n";
+        return 2;
+    }
+
+    try {
+        Resolver resolver;
+        for (const std::string& input : inputs) {
+            resolver.add(Parser(tokenize(read_file(input), input), input).parse());
+        }
+        Emitter emitter(resolver);
+        std::filesystem::create_directories(out_dir + "/flight/views");
+        for (const auto& [id, package] : resolver.packages()) {
+            write_file(out_dir + "/flight/views/" + package->name + ".hpp", emitter.emit(*package));
+        }
+    } catch (const Error& error) {
+        std::cerr << "flight-wit-cpp17: " << error.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
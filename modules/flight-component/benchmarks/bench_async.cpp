@@ -0,0 +1,219 @@
+// Flight Core Component - async executor benchmarks
+//
+// A producer streams 64 KiB in 256-byte writes to a consumer reading
+// 128 bytes at a time, through a 1 KiB stream: writers keep running into
+// backpressure and readers into empty streams. The executor runs both as
+// callback tasks on one thread; the baseline gives each side an OS thread
+// blocking on a bounded queue, the way a component waiting on I/O is run
+// without async support.
+
+#include <benchmark/benchmark.h>
+#include <flight/component/async.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace flight;
+using namespace flight::component;
+
+namespace
+{
+    constexpr uint32_t TOTAL = 64 * 1024;
+    constexpr uint32_t WRITE_SIZE = 256;
+    constexpr uint32_t READ_SIZE = 128;
+    constexpr uint32_t CAPACITY = 1024;
+
+    // Baseline: a bounded queue both threads block on
+    struct BlockingQueue
+    {
+        std::mutex mutex;
+        std::condition_variable readable;
+        std::condition_variable writable;
+        RingBuffer ring = RingBuffer(1, CAPACITY);
+        bool closed = false;
+
+        void write(const uint8_t *bytes, uint32_t count)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (count != 0)
+            {
+                writable.wait(lock, [&] { return !ring.full(); });
+                const uint32_t n = ring.push(bytes, count);
+                bytes += n;
+                count -= n;
+                readable.notify_one();
+            }
+        }
+
+        uint32_t read(uint8_t *bytes, uint32_t count)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            readable.wait(lock, [&] { return !ring.empty() || closed; });
+            const uint32_t n = ring.pop(bytes, count);
+            writable.notify_one();
+            return n;
+        }
+
+        void close()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            readable.notify_one();
+        }
+    };
+
+    struct Producer
+    {
+        AsyncInstance *instance;
+        uint32_t writable;
+        uint32_t set;
+        uint32_t sent;
+    };
+
+    struct Consumer
+    {
+        AsyncInstance *instance;
+        uint32_t readable;
+        uint32_t set;
+        uint32_t received;
+    };
+
+    wasm::Result<uint32_t> produce(void *context, const Event &event)
+    {
+        Producer &producer = *static_cast<Producer *>(context);
+        if (event.code == EventCode::StreamWrite)
+        {
+            producer.sent += event.payload >> 4;
+        }
+        while (producer.sent < TOTAL)
+        {
+            auto written = producer.instance->write(producer.writable, 0, WRITE_SIZE);
+            if (!written)
+            {
+                return written;
+            }
+            if (written.value() == BLOCKED)
+            {
+                return wait_on(producer.set);
+            }
+            producer.sent += written.value() >> 4;
+        }
+        auto dropped = producer.instance->drop(producer.writable);
+        if (!dropped)
+        {
+            return wasm::make_error<uint32_t>(dropped.error());
+        }
+        return static_cast<uint32_t>(CallbackCode::Exit);
+    }
+
+    wasm::Result<uint32_t> consume(void *context, const Event &event)
+    {
+        Consumer &consumer = *static_cast<Consumer *>(context);
+        uint32_t result = event.payload;
+        bool completed = event.code == EventCode::StreamRead;
+        for (;;)
+        {
+            if (!completed)
+            {
+                auto read = consumer.instance->read(consumer.readable, 4096, READ_SIZE);
+                if (!read)
+                {
+                    return read;
+                }
+                if (read.value() == BLOCKED)
+                {
+                    return wait_on(consumer.set);
+                }
+                result = read.value();
+            }
+            completed = false;
+            consumer.received += result >> 4;
+            if ((result & 0xF) == static_cast<uint32_t>(CopyStatus::Dropped))
+            {
+                return static_cast<uint32_t>(CallbackCode::Exit);
+            }
+        }
+    }
+} // namespace
+
+static void BM_StreamThreads(benchmark::State &state)
+{
+    std::vector<uint8_t> source(WRITE_SIZE, 0x5A);
+    for (auto _ : state)
+    {
+        BlockingQueue queue;
+        std::thread producer([&] {
+            for (uint32_t sent = 0; sent < TOTAL; sent += WRITE_SIZE)
+            {
+                queue.write(source.data(), WRITE_SIZE);
+            }
+            queue.close();
+        });
+        uint8_t buffer[READ_SIZE];
+        uint32_t received = 0;
+        while (uint32_t n = queue.read(buffer, READ_SIZE))
+        {
+            received += n;
+        }
+        producer.join();
+        benchmark::DoNotOptimize(received);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * TOTAL);
+}
+BENCHMARK(BM_StreamThreads)->UseRealTime();
+
+static void BM_StreamExecutor(benchmark::State &state)
+{
+    std::vector<uint8_t> producer_bytes(8192, 0x5A);
+    std::vector<uint8_t> consumer_bytes(8192);
+    GuestMemory producer_memory;
+    producer_memory.base = producer_bytes.data();
+    producer_memory.size = producer_bytes.size();
+    GuestMemory consumer_memory;
+    consumer_memory.base = consumer_bytes.data();
+    consumer_memory.size = consumer_bytes.size();
+    const MarshalPlan element(InterfaceType{TypeKind::U8, "", {}});
+
+    Executor executor;
+    AsyncInstance writer(executor, producer_memory);
+    AsyncInstance reader(executor, consumer_memory);
+    for (auto _ : state)
+    {
+        auto ends = writer.stream_new(element, CAPACITY).value();
+        Producer producer{&writer, ends.second, writer.waitable_set_new().value(), 0};
+        Consumer consumer{&reader, writer.transfer(ends.first, reader).value(), reader.waitable_set_new().value(),
+                          0};
+        writer.join(producer.writable, producer.set);
+        reader.join(consumer.readable, consumer.set);
+        writer.spawn(&produce, &producer);
+        reader.spawn(&consume, &consumer);
+        benchmark::DoNotOptimize(executor.run().value());
+
+        reader.drop(consumer.readable);
+        writer.drop(producer.set);
+        reader.drop(consumer.set);
+        if (consumer.received != TOTAL)
+        {
+            state.SkipWithError("Stream lost data");
+            break;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * TOTAL);
+}
+BENCHMARK(BM_StreamExecutor)->UseRealTime();
+
+static void BM_RingBuffer(benchmark::State &state)
+{
+    RingBuffer ring(1, CAPACITY);
+    std::vector<uint8_t> source(WRITE_SIZE, 0x5A);
+    std::vector<uint8_t> sink(WRITE_SIZE);
+    for (auto _ : state)
+    {
+        ring.push(source.data(), WRITE_SIZE);
+        benchmark::DoNotOptimize(ring.pop(sink.data(), WRITE_SIZE));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * WRITE_SIZE);
+}
+BENCHMARK(BM_RingBuffer);
@@ -0,0 +1,259 @@
+// Flight Core Component - canonical ABI benchmarks
+//
+// Moves a request record (scalars, a string and a list of records) between
+// two component memories. The baseline walks the InterfaceType tree on every
+// call, the way a naive adapter would; the engine executes a compiled
+// MarshalPlan; the typed path lifts and lowers through CanonicalType.
+// The blob benchmarks pass a list<u8> between components that share one
+// memory, copied and then borrowed.
+
+#include <benchmark/benchmark.h>
+#include <flight/component/canonical_types.hpp>
+
+#include <cstring>
+#include <vector>
+
+using namespace flight::component;
+
+namespace
+{
+    constexpr size_t ENTRY_COUNT = 64;
+
+    struct Arena
+    {
+        std::vector<uint8_t> bytes = std::vector<uint8_t>(1 << 22);
+        uint32_t top = 16;
+    };
+
+    uint32_t arena_realloc(void *context, uint32_t, uint32_t, uint32_t alignment, uint32_t size)
+    {
+        Arena &arena = *static_cast<Arena *>(context);
+        const uint32_t ptr = (arena.top + alignment - 1) & ~(alignment - 1);
+        if (ptr + size > arena.bytes.size())
+        {
+            return 0;
+        }
+        arena.top = ptr + size;
+        return ptr;
+    }
+
+    GuestMemory make_memory(Arena &arena)
+    {
+        GuestMemory memory;
+        memory.base = arena.bytes.data();
+        memory.size = arena.bytes.size();
+        memory.realloc = &arena_realloc;
+        memory.realloc_context = &arena;
+        return memory;
+    }
+
+    struct Entry
+    {
+        uint32_t key;
+        float weight;
+        bool enabled;
+        static constexpr auto canonical_fields = std::make_tuple(&Entry::key, &Entry::weight, &Entry::enabled);
+    };
+
+    struct Request
+    {
+        uint64_t id;
+        uint32_t flags;
+        std::string path;
+        std::vector<Entry> entries;
+        static constexpr auto canonical_fields =
+            std::make_tuple(&Request::id, &Request::flags, &Request::path, &Request::entries);
+    };
+
+    Request make_request()
+    {
+        Request request{42, 7, "/assets/textures/terrain_albedo.ktx2", {}};
+        for (uint32_t i = 0; i < ENTRY_COUNT; ++i)
+        {
+            request.entries.push_back({i, i * 0.5f, (i & 1) != 0});
+        }
+        return request;
+    }
+
+    uint32_t load_u32(const uint8_t *bytes)
+    {
+        uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    // Baseline: recursive walk of the type tree for every value
+    bool interpret(const InterfaceType &type, const GuestMemory &src, uint32_t s, GuestMemory &dst, uint32_t d)
+    {
+        switch (type.kind)
+        {
+        case TypeKind::Record:
+        {
+            uint32_t offset = 0;
+            for (const InterfaceType &field : type.params)
+            {
+                const TypeLayout layout = layout_of(field);
+                offset = (offset + layout.alignment - 1) & ~(layout.alignment - 1);
+                if (!interpret(field, src, s + offset, dst, d + offset))
+                {
+                    return false;
+                }
+                offset += layout.size;
+            }
+            return true;
+        }
+        case TypeKind::String:
+        case TypeKind::List:
+        {
+            const TypeLayout element = type.kind == TypeKind::String ? TypeLayout{1, 1} : layout_of(type.params[0]);
+            const uint32_t ptr = load_u32(src.base + s);
+            const uint32_t length = load_u32(src.base + s + 4);
+            auto allocation = dst.allocate(length * element.size, element.alignment);
+            if (!allocation)
+            {
+                return false;
+            }
+            for (uint32_t i = 0; i < length; ++i)
+            {
+                if (type.kind == TypeKind::String)
+                {
+                    dst.base[allocation.value() + i] = src.base[ptr + i];
+                }
+                else if (!interpret(type.params[0], src, ptr + i * element.size, dst,
+                                    allocation.value() + i * element.size))
+                {
+                    return false;
+                }
+            }
+            std::memcpy(dst.base + d, &allocation.value(), 4);
+            std::memcpy(dst.base + d + 4, &length, 4);
+            return true;
+        }
+        case TypeKind::Bool:
+            dst.base[d] = src.base[s] != 0;
+            return true;
+        default:
+            std::memcpy(dst.base + d, src.base + s, layout_of(type).size);
+            return true;
+        }
+    }
+} // namespace
+
+static void BM_TransferInterpreted(benchmark::State &state)
+{
+    Arena src_arena, dst_arena;
+    GuestMemory src = make_memory(src_arena);
+    GuestMemory dst = make_memory(dst_arena);
+    const InterfaceType type = CanonicalType<Request>::type();
+    const uint32_t offset = lower_new(src, make_request()).value();
+    const TypeLayout layout = layout_of(type);
+
+    for (auto _ : state)
+    {
+        dst_arena.top = 16;
+        const uint32_t target = dst.allocate(layout.size, layout.alignment).value();
+        benchmark::DoNotOptimize(interpret(type, src, offset, dst, target));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_TransferInterpreted);
+
+static void BM_TransferPlan(benchmark::State &state)
+{
+    Arena src_arena, dst_arena;
+    GuestMemory src = make_memory(src_arena);
+    GuestMemory dst = make_memory(dst_arena);
+    CanonicalABI abi;
+    auto plan = abi.plan(CanonicalType<Request>::type());
+    const uint32_t offset = lower_new(src, make_request()).value();
+
+    for (auto _ : state)
+    {
+        dst_arena.top = 16;
+        benchmark::DoNotOptimize(CanonicalABI::transfer_new(*plan, src, offset, dst));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_TransferPlan);
+
+static void BM_LiftTyped(benchmark::State &state)
+{
+    Arena arena;
+    GuestMemory memory = make_memory(arena);
+    const uint32_t offset = lower_new(memory, make_request()).value();
+
+    for (auto _ : state)
+    {
+        auto request = lift<Request>(memory, offset);
+        benchmark::DoNotOptimize(request);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_LiftTyped);
+
+static void BM_LowerTyped(benchmark::State &state)
+{
+    Arena arena;
+    GuestMemory memory = make_memory(arena);
+    const Request request = make_request();
+
+    for (auto _ : state)
+    {
+        arena.top = 16;
+        benchmark::DoNotOptimize(lower_new(memory, request));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_LowerTyped);
+
+static void BM_PlanCacheHit(benchmark::State &state)
+{
+    CanonicalABI abi;
+    const InterfaceType type = CanonicalType<Request>::type();
+    abi.plan(type);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(abi.plan(type));
+    }
+}
+BENCHMARK(BM_PlanCacheHit);
+
+static void BM_TransferBlobCopy(benchmark::State &state)
+{
+    Arena arena;
+    GuestMemory memory = make_memory(arena);
+    CanonicalABI abi;
+    auto plan = abi.plan(CanonicalType<std::vector<uint8_t>>::type());
+    const uint32_t offset = lower_new(memory, std::vector<uint8_t>(state.range(0), 0x5A)).value();
+    const uint32_t top = arena.top;
+
+    for (auto _ : state)
+    {
+        arena.top = top;
+        benchmark::DoNotOptimize(CanonicalABI::transfer_new(*plan, memory, offset, memory));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+BENCHMARK(BM_TransferBlobCopy)->Range(1 << 10, 1 << 20);
+
+static void BM_TransferBlobBorrowed(benchmark::State &state)
+{
+    Arena arena;
+    GuestMemory memory = make_memory(arena);
+    CanonicalABI abi;
+    auto plan = abi.plan(CanonicalType<std::vector<uint8_t>>::type());
+    const uint32_t offset = lower_new(memory, std::vector<uint8_t>(state.range(0), 0x5A)).value();
+    const uint32_t top = arena.top;
+    BorrowScope borrows;
+    TransferOptions options;
+    options.borrows = &borrows;
+
+    for (auto _ : state)
+    {
+        arena.top = top;
+        benchmark::DoNotOptimize(CanonicalABI::transfer_new(*plan, memory, offset, memory, options));
+        borrows.release(memory);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+BENCHMARK(BM_TransferBlobBorrowed)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,259 @@
+// Flight Core Component - linker benchmarks
+//
+// A 20-component application graph: every component exports an API that
+// the next one imports, and all of them import a host logging function.
+// Linking resolves the graph once; instantiating a linked graph only binds
+// its instances. Calls go through the link-time thunks, next to a baseline
+// that looks the import up by name and checks its signature on every call.
+
+#include <benchmark/benchmark.h>
+#include <flight/component/canonical_types.hpp>
+#include <flight/component/linker.hpp>
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace flight::component;
+
+namespace
+{
+    constexpr uint32_t COMPONENT_COUNT = 20;
+
+    struct Arena
+    {
+        std::vector<uint8_t> bytes = std::vector<uint8_t>(1 << 16);
+        uint32_t top = 16;
+    };
+
+    uint32_t arena_realloc(void *context, uint32_t, uint32_t, uint32_t alignment, uint32_t size)
+    {
+        Arena &arena = *static_cast<Arena *>(context);
+        const uint32_t ptr = (arena.top + alignment - 1) & ~(alignment - 1);
+        if (ptr + size > arena.bytes.size())
+        {
+            return 0;
+        }
+        arena.top = ptr + size;
+        return ptr;
+    }
+
+    struct Instance
+    {
+        Arena arena;
+        GuestMemory memory;
+        ResourceTable resources;
+
+        Instance()
+        {
+            memory.base = arena.bytes.data();
+            memory.size = arena.bytes.size();
+            memory.realloc = &arena_realloc;
+            memory.realloc_context = &arena;
+        }
+    };
+
+    const InterfaceType U32{TypeKind::U32, "", {}};
+    const InterfaceType STRING{TypeKind::String, "", {}};
+    const FunctionType ADD{{U32, U32}, {U32}};
+    const FunctionType LOOKUP{{STRING}, {U32}};
+    const FunctionType LOG{{STRING}, {}};
+
+    flight::wasm::Result<void> add(void *, uint64_t *slots)
+    {
+        slots[0] = static_cast<uint32_t>(slots[0]) + static_cast<uint32_t>(slots[1]);
+        return flight::wasm::Result<void>();
+    }
+
+    // lookup(key: string) -> u32, parameters passed indirectly
+    flight::wasm::Result<void> lookup(void *instance, uint64_t *slots)
+    {
+        const GuestMemory &memory = static_cast<Instance *>(instance)->memory;
+        uint32_t length;
+        std::memcpy(&length, memory.base + slots[0] + 4, sizeof(length));
+        slots[0] = length;
+        return flight::wasm::Result<void>();
+    }
+
+    flight::wasm::Result<void> log(void *, GuestMemory &, uint64_t *)
+    {
+        return flight::wasm::Result<void>();
+    }
+
+    std::string api(uint32_t component, const char *function)
+    {
+        return "app:graph/c" + std::to_string(component) + "#" + function;
+    }
+
+    std::vector<std::shared_ptr<const ComponentDefinition>> make_components()
+    {
+        std::vector<std::shared_ptr<const ComponentDefinition>> components;
+        for (uint32_t i = 0; i < COMPONENT_COUNT; ++i)
+        {
+            auto component = std::make_shared<ComponentDefinition>();
+            component->name = "c" + std::to_string(i);
+            component->imports.push_back({"wasi:logging/logging#log", LOG});
+            if (i > 0)
+            {
+                component->imports.push_back({api(i - 1, "add"), ADD});
+                component->imports.push_back({api(i - 1, "lookup"), LOOKUP});
+            }
+            component->exports.push_back({api(i, "add"), ADD, &add});
+            component->exports.push_back({api(i, "lookup"), LOOKUP, &lookup});
+            components.push_back(std::move(component));
+        }
+        return components;
+    }
+
+    std::shared_ptr<const LinkedGraph> link(AdapterCache &adapters,
+                                            const std::vector<std::shared_ptr<const ComponentDefinition>> &components)
+    {
+        Linker linker(adapters);
+        linker.define_host("wasi:logging/logging#log", LOG, &log);
+        for (const auto &component : components)
+        {
+            linker.add(component);
+        }
+        return linker.link().value();
+    }
+
+    struct Application
+    {
+        std::vector<Instance> instances = std::vector<Instance>(COMPONENT_COUNT);
+        std::vector<InstanceBinding> bindings;
+
+        Application()
+        {
+            for (Instance &instance : instances)
+            {
+                bindings.push_back({&instance, &instance.memory, &instance.resources});
+            }
+        }
+    };
+
+    // Baseline: exports by name, signature checked at each call
+    struct NameResolver
+    {
+        struct Target
+        {
+            const ComponentExport *function;
+            Instance *instance;
+        };
+        std::unordered_map<std::string, Target> exports;
+
+        flight::wasm::Result<void> call(const ComponentImport &import, uint64_t *slots) const
+        {
+            auto it = exports.find(import.name);
+            if (it == exports.end())
+            {
+                return flight::wasm::Result<void>(flight::wasm::ErrorCode::ImportResolutionFailed);
+            }
+            const FunctionType &type = it->second.function->type;
+            for (size_t i = 0; i < type.params.size(); ++i)
+            {
+                if (!same_type(type.params[i], import.type.params[i]))
+                {
+                    return flight::wasm::Result<void>(flight::wasm::ErrorCode::TypeMismatch);
+                }
+            }
+            return it->second.function->function(it->second.instance, slots);
+        }
+    };
+} // namespace
+
+static void BM_LinkGraph(benchmark::State &state)
+{
+    CanonicalABI abi;
+    AdapterCache adapters(abi);
+    const auto components = make_components();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(link(adapters, components));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_LinkGraph);
+
+static void BM_InstantiateGraph(benchmark::State &state)
+{
+    CanonicalABI abi;
+    AdapterCache adapters(abi);
+    const auto graph = link(adapters, make_components());
+    Application application;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(graph->instantiate(application.bindings));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_InstantiateGraph);
+
+static void BM_CallByName(benchmark::State &state)
+{
+    const auto components = make_components();
+    Application application;
+    NameResolver resolver;
+    for (uint32_t i = 0; i < COMPONENT_COUNT; ++i)
+    {
+        for (const ComponentExport &function : components[i]->exports)
+        {
+            resolver.exports[function.name] = {&function, &application.instances[i]};
+        }
+    }
+    const ComponentImport &import = components[COMPONENT_COUNT - 1]->imports[1];
+    uint64_t slots[2];
+    for (auto _ : state)
+    {
+        slots[0] = 2;
+        slots[1] = 40;
+        benchmark::DoNotOptimize(resolver.call(import, slots));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_CallByName);
+
+static void BM_CallDirect(benchmark::State &state)
+{
+    CanonicalABI abi;
+    AdapterCache adapters(abi);
+    Application application;
+    const auto graph = link(adapters, make_components());
+    const LinkedInstance instance = graph->instantiate(application.bindings).value();
+    const uint32_t caller = COMPONENT_COUNT - 1;
+    const uint32_t import = graph->import_index(caller, api(caller - 1, "add")).value();
+    uint64_t slots[2];
+    for (auto _ : state)
+    {
+        slots[0] = 2;
+        slots[1] = 40;
+        benchmark::DoNotOptimize(instance.call_import(caller, import, slots));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_CallDirect);
+
+// A string argument crossing from one instance's memory into another's
+static void BM_CallAdapted(benchmark::State &state)
+{
+    CanonicalABI abi;
+    AdapterCache adapters(abi);
+    Application application;
+    const auto graph = link(adapters, make_components());
+    const LinkedInstance instance = graph->instantiate(application.bindings).value();
+    const uint32_t caller = COMPONENT_COUNT - 1;
+    const uint32_t import = graph->import_index(caller, api(caller - 1, "lookup")).value();
+    GuestMemory &memory = application.instances[caller].memory;
+    const uint32_t params = lower_new(memory, std::make_tuple(std::string("textures/terrain_albedo"))).value();
+    Arena &callee_arena = application.instances[caller - 1].arena;
+    const uint32_t top = callee_arena.top;
+    uint64_t slots[1];
+    for (auto _ : state)
+    {
+        callee_arena.top = top;
+        slots[0] = params;
+        benchmark::DoNotOptimize(instance.call_import(caller, import, slots));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_CallAdapted);
@@ -0,0 +1,126 @@
+// Flight Core Component - memory layout benchmarks
+//
+// Planning a segment map for the team brief's PSP game (physics, renderer,
+// audio and logic in 16 MiB), and the run-time side of the relocation
+// table: classifying host-visible addresses into segments and checking
+// guest pointers before translating them. The address baseline scans a
+// list of segment records, the way a first-cut host would.
+
+#include <benchmark/benchmark.h>
+#include <flight/component/memory_layout.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace flight;
+using namespace flight::component;
+
+namespace
+{
+    constexpr uint32_t ADDRESSES = 4096;
+
+    LayoutPlanner psp_game()
+    {
+        PlatformProfile profile = PlatformProfile::psp();
+        profile.capacity = 16ull << 20;
+        LayoutPlanner planner(profile);
+        planner.add("physics", wasm::Limits(64, 64));
+        planner.add("renderer", wasm::Limits(128, 128));
+        planner.add("audio", wasm::Limits(32, 32));
+        planner.add("logic", wasm::Limits(16));
+        return planner;
+    }
+
+    MemoryLayout many_segments(uint32_t count)
+    {
+        LayoutPlanner planner(PlatformProfile::vita());
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            planner.add("component-" + std::to_string(i), wasm::Limits(1, 1 + i % 4));
+        }
+        return planner.plan().value();
+    }
+
+    std::vector<uint64_t> addresses(const MemoryLayout &layout)
+    {
+        std::vector<uint64_t> result;
+        const uint64_t end = layout.maximum_pages() * MemoryLayout::PAGE_SIZE;
+        uint64_t address = 12345;
+        for (uint32_t i = 0; i < ADDRESSES; ++i)
+        {
+            address = (address * 6364136223846793005ull + 1442695040888963407ull) % end;
+            result.push_back(address);
+        }
+        return result;
+    }
+
+    // Baseline: segment records searched front to back
+    uint32_t scan_segment_of(const std::vector<MemorySegment> &segments, uint64_t address)
+    {
+        for (uint32_t i = 0; i < segments.size(); ++i)
+        {
+            const uint64_t base = segments[i].base;
+            if (address >= base && address < base + segments[i].reserved_pages * MemoryLayout::PAGE_SIZE)
+            {
+                return i;
+            }
+        }
+        return MemoryLayout::NONE;
+    }
+} // namespace
+
+static void BM_PlanPspGame(benchmark::State &state)
+{
+    const LayoutPlanner planner = psp_game();
+    for (auto _ : state)
+    {
+        auto layout = planner.plan();
+        benchmark::DoNotOptimize(layout);
+    }
+    const MemoryLayout layout = planner.plan().value();
+    state.counters["pages"] = layout.maximum_pages();
+    state.counters["overhead_bytes"] = static_cast<double>(layout.overhead_bytes());
+}
+BENCHMARK(BM_PlanPspGame);
+
+static void BM_SegmentOfScan(benchmark::State &state)
+{
+    const MemoryLayout layout = many_segments(static_cast<uint32_t>(state.range(0)));
+    const std::vector<uint64_t> probes = addresses(layout);
+    uint32_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(scan_segment_of(layout.segments(), probes[i++ % ADDRESSES]));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_SegmentOfScan)->Range(4, 256);
+
+static void BM_SegmentOf(benchmark::State &state)
+{
+    const MemoryLayout layout = many_segments(static_cast<uint32_t>(state.range(0)));
+    const std::vector<uint64_t> probes = addresses(layout);
+    uint32_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(layout.segment_of(probes[i++ % ADDRESSES]));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_SegmentOf)->Range(4, 256);
+
+static void BM_CheckedTranslate(benchmark::State &state)
+{
+    const MemoryLayout layout = many_segments(64);
+    uint32_t i = 0;
+    uint64_t address = 0;
+    for (auto _ : state)
+    {
+        const uint32_t segment = i % 64;
+        const uint32_t offset = (i * 2654435761u) % 0x20000;
+        benchmark::DoNotOptimize(layout.translate(segment, offset, 16, address));
+        ++i;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_CheckedTranslate);
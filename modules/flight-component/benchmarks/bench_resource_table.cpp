@@ -0,0 +1,214 @@
+// Flight Core Component - resource table benchmarks
+//
+// Handle churn, lookups and borrowed calls against a ResourceTable, next to
+// a baseline that keeps handles in a hash map with a monotonically growing
+// counter, the way a first-cut runtime would. Teardown compares per-handle
+// destructor calls with the table's batched destroy_all().
+
+#include <benchmark/benchmark.h>
+#include <flight/component/resource_table.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+using namespace flight::component;
+
+namespace
+{
+    constexpr uint32_t LIVE_HANDLES = 1024;
+
+    void count_destroyed(void *context, const uint32_t *, size_t count)
+    {
+        *static_cast<size_t *>(context) += count;
+    }
+
+    // Baseline: hashed handles, borrows tracked per handle
+    struct HashedTable
+    {
+        struct Entry
+        {
+            const ResourceType *type;
+            uint32_t rep;
+            uint32_t lends;
+        };
+
+        std::unordered_map<uint32_t, Entry> entries;
+        uint32_t next = 1;
+
+        uint32_t create(const ResourceType &type, uint32_t rep)
+        {
+            entries.emplace(next, Entry{&type, rep, 0});
+            return next++;
+        }
+
+        bool rep(uint32_t handle, const ResourceType &type, uint32_t &out) const
+        {
+            auto it = entries.find(handle);
+            if (it == entries.end() || it->second.type != &type)
+            {
+                return false;
+            }
+            out = it->second.rep;
+            return true;
+        }
+
+        bool drop(uint32_t handle, const ResourceType &type)
+        {
+            auto it = entries.find(handle);
+            if (it == entries.end() || it->second.type != &type || it->second.lends != 0)
+            {
+                return false;
+            }
+            const uint32_t rep = it->second.rep;
+            entries.erase(it);
+            if (type.destroy)
+            {
+                type.destroy(type.context, &rep, 1);
+            }
+            return true;
+        }
+    };
+} // namespace
+
+static void BM_HandleChurnHashed(benchmark::State &state)
+{
+    size_t destroyed = 0;
+    const ResourceType type{&count_destroyed, &destroyed};
+    HashedTable table;
+    std::vector<uint32_t> handles;
+    for (uint32_t i = 0; i < LIVE_HANDLES; ++i)
+    {
+        handles.push_back(table.create(type, i));
+    }
+    uint32_t i = 0;
+    for (auto _ : state)
+    {
+        uint32_t &handle = handles[i++ % LIVE_HANDLES];
+        table.drop(handle, type);
+        handle = table.create(type, i);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_HandleChurnHashed);
+
+static void BM_HandleChurn(benchmark::State &state)
+{
+    size_t destroyed = 0;
+    const ResourceType type{&count_destroyed, &destroyed};
+    ResourceTable table(LIVE_HANDLES);
+    std::vector<uint32_t> handles;
+    for (uint32_t i = 0; i < LIVE_HANDLES; ++i)
+    {
+        handles.push_back(table.create(type, i).value());
+    }
+    uint32_t i = 0;
+    for (auto _ : state)
+    {
+        uint32_t &handle = handles[i++ % LIVE_HANDLES];
+        table.drop(handle, type);
+        handle = table.create(type, i).value();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_HandleChurn);
+
+static void BM_HandleLookupHashed(benchmark::State &state)
+{
+    const ResourceType type;
+    HashedTable table;
+    std::vector<uint32_t> handles;
+    for (uint32_t i = 0; i < LIVE_HANDLES; ++i)
+    {
+        handles.push_back(table.create(type, i));
+    }
+    uint32_t i = 0;
+    uint32_t rep = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(table.rep(handles[i++ % LIVE_HANDLES], type, rep));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_HandleLookupHashed);
+
+static void BM_HandleLookup(benchmark::State &state)
+{
+    const ResourceType type;
+    ResourceTable table(LIVE_HANDLES);
+    std::vector<uint32_t> handles;
+    for (uint32_t i = 0; i < LIVE_HANDLES; ++i)
+    {
+        handles.push_back(table.create(type, i).value());
+    }
+    uint32_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(table.rep(handles[i++ % LIVE_HANDLES], type));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_HandleLookup);
+
+// One call passing a borrowed handle: lend, borrow, callee drops, return
+static void BM_BorrowedCall(benchmark::State &state)
+{
+    const ResourceType type;
+    ResourceTable caller(LIVE_HANDLES);
+    ResourceTable callee;
+    const uint32_t handle = caller.create(type, 7).value();
+    for (auto _ : state)
+    {
+        CallScope scope;
+        const uint32_t rep = caller.lend(handle, type, scope).value();
+        const uint32_t borrowed = callee.borrow(type, rep, scope).value();
+        benchmark::DoNotOptimize(callee.rep(borrowed, type));
+        callee.drop(borrowed, type);
+        benchmark::DoNotOptimize(scope.finish());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_BorrowedCall);
+
+static void BM_TeardownHashed(benchmark::State &state)
+{
+    size_t destroyed = 0;
+    const ResourceType types[] = {{&count_destroyed, &destroyed}, {&count_destroyed, &destroyed}};
+    const uint32_t count = static_cast<uint32_t>(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        HashedTable table;
+        std::vector<uint32_t> handles;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            handles.push_back(table.create(types[i & 1], i));
+        }
+        state.ResumeTiming();
+        for (uint32_t i = 0; i < handles.size(); ++i)
+        {
+            table.drop(handles[i], types[i & 1]);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_TeardownHashed)->Range(1 << 8, 1 << 14);
+
+static void BM_Teardown(benchmark::State &state)
+{
+    size_t destroyed = 0;
+    const ResourceType types[] = {{&count_destroyed, &destroyed}, {&count_destroyed, &destroyed}};
+    const uint32_t count = static_cast<uint32_t>(state.range(0));
+    ResourceTable table(count);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            table.create(types[i & 1], i);
+        }
+        state.ResumeTiming();
+        table.destroy_all();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_Teardown)->Range(1 << 8, 1 << 14);
@@ -0,0 +1,285 @@
+// Flight Core Component - string transcoding benchmarks
+//
+// Throughput of the canonical ABI string transcoders on 64 KiB JSON
+// payloads: pure ASCII, Latin-1 accented text and CJK with emoji. Each
+// transcode counts the source bytes, so results read as GB/s of input.
+// The baseline decodes one code point at a time, the way a straightforward
+// adapter would.
+
+#include <benchmark/benchmark.h>
+#include <flight/component/canonical_types.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace flight::component;
+
+namespace
+{
+    constexpr size_t PAYLOAD_SIZE = 64 * 1024;
+
+    enum Payload
+    {
+        Ascii,
+        Latin1Text,
+        Cjk
+    };
+
+    std::string make_payload(Payload payload)
+    {
+        const char *record = nullptr;
+        switch (payload)
+        {
+        case Ascii:
+            record = "{\"id\":1024,\"name\":\"terrain_albedo\",\"path\":\"/assets/textures/terrain.ktx2\",\"tags\":[\"a\",\"b\"]},";
+            break;
+        case Latin1Text:
+            record = "{\"id\":1024,\"ville\":\"Montr\xc3\xa9" "al\",\"caf\xc3\xa9\":\"cr\xc3\xa8me br\xc3\xbbl\xc3\xa9" "e\",\"gr\xc3\xb6\xc3\x9f" "e\":\"\xc3\xa4\xc3\xb6\xc3\xbc\"},";
+            break;
+        case Cjk:
+            record = "{\"id\":1024,\"\xe5\x90\x8d\xe5\x89\x8d\":\"\xe5\x9c\xb0\xe5\xbd\xa2\xe3\x83\x86\xe3\x82\xaf\xe3\x82\xb9\xe3\x83\x81\xe3\x83\xa3\","
+                     "\"\xe7\x8a\xb6\xe6\x85\x8b\":\"\xe8\xaa\xad\xe3\x81\xbf\xe8\xbe\xbc\xe3\x81\xbf\xe4\xb8\xad \xf0\x9f\x8e\xae\"},";
+            break;
+        }
+        std::string text;
+        while (text.size() < PAYLOAD_SIZE)
+        {
+            text += record;
+        }
+        // Cut at a record boundary so the payload stays valid UTF-8
+        text.resize(text.rfind(',', PAYLOAD_SIZE) + 1);
+        return text;
+    }
+
+    const uint8_t *bytes_of(const std::string &text)
+    {
+        return reinterpret_cast<const uint8_t *>(text.data());
+    }
+
+    std::vector<char16_t> to_utf16(const std::string &text)
+    {
+        std::vector<char16_t> units(transcoding::utf16_length_from_utf8(bytes_of(text), text.size()));
+        transcoding::convert_utf8_to_utf16(bytes_of(text), text.size(), units.data());
+        return units;
+    }
+
+    // Baseline: decode and re-encode one code point at a time, growing the output
+    bool scalar_utf8_to_utf16(const std::string &text, std::vector<char16_t> &out)
+    {
+        out.clear();
+        const uint8_t *s = bytes_of(text);
+        const size_t length = text.size();
+        size_t i = 0;
+        while (i < length)
+        {
+            uint32_t c = s[i];
+            size_t size = 1;
+            if (c >= 0xF0)
+            {
+                c &= 0x07;
+                size = 4;
+            }
+            else if (c >= 0xE0)
+            {
+                c &= 0x0F;
+                size = 3;
+            }
+            else if (c >= 0xC0)
+            {
+                c &= 0x1F;
+                size = 2;
+            }
+            else if (c >= 0x80)
+            {
+                return false;
+            }
+            if (i + size > length)
+            {
+                return false;
+            }
+            for (size_t k = 1; k < size; ++k)
+            {
+                if ((s[i + k] & 0xC0) != 0x80)
+                {
+                    return false;
+                }
+                c = (c << 6) | (s[i + k] & 0x3F);
+            }
+            if (c >= 0x10000)
+            {
+                c -= 0x10000;
+                out.push_back(static_cast<char16_t>(0xD800 | (c >> 10)));
+                out.push_back(static_cast<char16_t>(0xDC00 | (c & 0x3FF)));
+            }
+            else
+            {
+                out.push_back(static_cast<char16_t>(c));
+            }
+            i += size;
+        }
+        return true;
+    }
+
+    struct Arena
+    {
+        std::vector<uint8_t> bytes = std::vector<uint8_t>(4 * PAYLOAD_SIZE);
+        uint32_t top = 16;
+    };
+
+    uint32_t arena_realloc(void *context, uint32_t, uint32_t, uint32_t alignment, uint32_t size)
+    {
+        Arena &arena = *static_cast<Arena *>(context);
+        const uint32_t ptr = (arena.top + alignment - 1) & ~(alignment - 1);
+        if (ptr + size > arena.bytes.size())
+        {
+            return 0;
+        }
+        arena.top = ptr + size;
+        return ptr;
+    }
+
+    GuestMemory make_memory(Arena &arena, StringEncoding encoding)
+    {
+        GuestMemory memory;
+        memory.base = arena.bytes.data();
+        memory.size = arena.bytes.size();
+        memory.realloc = &arena_realloc;
+        memory.realloc_context = &arena;
+        memory.string_encoding = encoding;
+        return memory;
+    }
+
+    void label(benchmark::State &state)
+    {
+        static const char *const NAMES[] = {"ascii", "latin1", "cjk"};
+        state.SetLabel(std::string(NAMES[state.range(0)]) + "/" + transcoding::implementation());
+    }
+} // namespace
+
+static void BM_Utf8ToUtf16Scalar(benchmark::State &state)
+{
+    const std::string text = make_payload(static_cast<Payload>(state.range(0)));
+    std::vector<char16_t> out;
+    out.reserve(text.size());
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(scalar_utf8_to_utf16(text, out));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    label(state);
+}
+BENCHMARK(BM_Utf8ToUtf16Scalar)->DenseRange(Ascii, Cjk);
+
+static void BM_ValidateUtf8(benchmark::State &state)
+{
+    const std::string text = make_payload(static_cast<Payload>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(transcoding::validate_utf8(bytes_of(text), text.size()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    label(state);
+}
+BENCHMARK(BM_ValidateUtf8)->DenseRange(Ascii, Cjk);
+
+static void BM_Utf8ToUtf16(benchmark::State &state)
+{
+    const std::string text = make_payload(static_cast<Payload>(state.range(0)));
+    std::vector<char16_t> out(text.size());
+    for (auto _ : state)
+    {
+        const size_t units = transcoding::utf16_length_from_utf8(bytes_of(text), text.size());
+        benchmark::DoNotOptimize(transcoding::convert_utf8_to_utf16(bytes_of(text), text.size(), out.data()));
+        benchmark::DoNotOptimize(units);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    label(state);
+}
+BENCHMARK(BM_Utf8ToUtf16)->DenseRange(Ascii, Cjk);
+
+static void BM_Utf16ToUtf8(benchmark::State &state)
+{
+    const std::vector<char16_t> units = to_utf16(make_payload(static_cast<Payload>(state.range(0))));
+    std::vector<uint8_t> out(units.size() * 3);
+    for (auto _ : state)
+    {
+        const size_t bytes = transcoding::utf8_length_from_utf16(units.data(), units.size());
+        benchmark::DoNotOptimize(transcoding::convert_utf16_to_utf8(units.data(), units.size(), out.data()));
+        benchmark::DoNotOptimize(bytes);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * units.size() * 2));
+    label(state);
+}
+BENCHMARK(BM_Utf16ToUtf8)->DenseRange(Ascii, Cjk);
+
+static void BM_Utf8ToLatin1(benchmark::State &state)
+{
+    const std::string text = make_payload(static_cast<Payload>(state.range(0)));
+    std::vector<uint8_t> out(text.size());
+    for (auto _ : state)
+    {
+        const size_t length = transcoding::latin1_length_from_utf8(bytes_of(text), text.size());
+        benchmark::DoNotOptimize(transcoding::convert_utf8_to_latin1(bytes_of(text), text.size(), out.data()));
+        benchmark::DoNotOptimize(length);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    label(state);
+}
+BENCHMARK(BM_Utf8ToLatin1)->DenseRange(Ascii, Latin1Text);
+
+static void BM_Latin1ToUtf8(benchmark::State &state)
+{
+    const std::string text = make_payload(static_cast<Payload>(state.range(0)));
+    std::vector<uint8_t> latin1(text.size());
+    latin1.resize(transcoding::convert_utf8_to_latin1(bytes_of(text), text.size(), latin1.data()));
+    std::vector<uint8_t> out(latin1.size() * 2);
+    for (auto _ : state)
+    {
+        const size_t bytes = transcoding::utf8_length_from_latin1(latin1.data(), latin1.size());
+        benchmark::DoNotOptimize(transcoding::convert_latin1_to_utf8(latin1.data(), latin1.size(), out.data()));
+        benchmark::DoNotOptimize(bytes);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * latin1.size()));
+    label(state);
+}
+BENCHMARK(BM_Latin1ToUtf8)->DenseRange(Ascii, Latin1Text);
+
+static void BM_Latin1ToUtf16(benchmark::State &state)
+{
+    const std::string text = make_payload(Ascii);
+    std::vector<char16_t> out(text.size());
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(transcoding::convert_latin1_to_utf16(bytes_of(text), text.size(), out.data()));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    state.SetLabel(transcoding::implementation());
+}
+BENCHMARK(BM_Latin1ToUtf16);
+
+// A string crossing from a UTF-8 component into a UTF-16 one
+static void BM_TransferString(benchmark::State &state)
+{
+    Arena src_arena, dst_arena;
+    GuestMemory src = make_memory(src_arena, StringEncoding::Utf8);
+    GuestMemory dst = make_memory(dst_arena, StringEncoding::Utf16);
+    CanonicalABI abi;
+    auto plan = abi.plan(CanonicalType<std::string>::type());
+    const std::string text = make_payload(static_cast<Payload>(state.range(0)));
+    const uint32_t offset = lower_new(src, text).value();
+
+    for (auto _ : state)
+    {
+        dst_arena.top = 16;
+        benchmark::DoNotOptimize(CanonicalABI::transfer_new(*plan, src, offset, dst));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    label(state);
+}
+BENCHMARK(BM_TransferString)->DenseRange(Ascii, Cjk);
@@ -0,0 +1,147 @@
+// Flight Core Component - type interner benchmarks
+//
+// A world of 64 functions that all pass and return one deeply nested
+// record (three fields per level, six levels), the shape of large WIT
+// worlds built from shared records. Every import and export holds its own
+// copy of the type, as decoded from separate components. The baseline
+// checks each import against its export by walking both type trees; the
+// interner walks each type once and then compares IDs.
+
+#include <benchmark/benchmark.h>
+#include <flight/component/linker.hpp>
+#include <flight/component/type_interner.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace flight::component;
+
+namespace
+{
+    constexpr uint32_t FUNCTION_COUNT = 64;
+    constexpr uint32_t DEPTH = 6;
+    constexpr uint32_t WIDTH = 3;
+
+    // A record of WIDTH fields, each a record one level shallower; the
+    // innermost fields are a status enum with case_count cases
+    InterfaceType nested_record(uint32_t depth, uint32_t case_count)
+    {
+        if (depth == 0)
+        {
+            InterfaceType status{TypeKind::Enum, "status", {}};
+            for (uint32_t i = 0; i < case_count; ++i)
+            {
+                status.params.push_back(InterfaceType{TypeKind::U32, "case-" + std::to_string(i), {}});
+            }
+            return status;
+        }
+        InterfaceType record{TypeKind::Record, "level-" + std::to_string(depth), {}};
+        for (uint32_t i = 0; i < WIDTH; ++i)
+        {
+            InterfaceType field = nested_record(depth - 1, case_count);
+            field.name = "field-" + std::to_string(i);
+            record.params.push_back(std::move(field));
+        }
+        return record;
+    }
+
+    std::vector<FunctionType> world(uint32_t case_count)
+    {
+        const InterfaceType u32{TypeKind::U32, "", {}};
+        std::vector<FunctionType> functions;
+        for (uint32_t i = 0; i < FUNCTION_COUNT; ++i)
+        {
+            functions.push_back(FunctionType{{nested_record(DEPTH, case_count), u32},
+                                             {nested_record(DEPTH, case_count)}});
+        }
+        return functions;
+    }
+} // namespace
+
+static void BM_SignatureDeepWalk(benchmark::State &state)
+{
+    const std::vector<FunctionType> imports = world(3);
+    const std::vector<FunctionType> exports = world(3);
+    for (auto _ : state)
+    {
+        bool linked = true;
+        for (uint32_t i = 0; i < FUNCTION_COUNT; ++i)
+        {
+            linked &= same_signature(imports[i], exports[i]);
+        }
+        benchmark::DoNotOptimize(linked);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * FUNCTION_COUNT);
+}
+BENCHMARK(BM_SignatureDeepWalk);
+
+static void BM_SignatureInterned(benchmark::State &state)
+{
+    const std::vector<FunctionType> imports = world(3);
+    const std::vector<FunctionType> exports = world(3);
+    TypeInterner types;
+    std::vector<Signature> import_signatures;
+    std::vector<Signature> export_signatures;
+    for (uint32_t i = 0; i < FUNCTION_COUNT; ++i)
+    {
+        import_signatures.push_back(types.intern(imports[i]));
+        export_signatures.push_back(types.intern(exports[i]));
+    }
+    for (auto _ : state)
+    {
+        bool linked = true;
+        for (uint32_t i = 0; i < FUNCTION_COUNT; ++i)
+        {
+            linked &= import_signatures[i] == export_signatures[i];
+        }
+        benchmark::DoNotOptimize(linked);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * FUNCTION_COUNT);
+}
+BENCHMARK(BM_SignatureInterned);
+
+// Imports built against an older status enum: every check is a subtype
+// check, decided once and then answered from the memo
+static void BM_SignatureSubtype(benchmark::State &state)
+{
+    const std::vector<FunctionType> imports = world(3);
+    const std::vector<FunctionType> exports = world(4);
+    TypeInterner types;
+    std::vector<Signature> import_signatures;
+    std::vector<Signature> export_signatures;
+    for (uint32_t i = 0; i < FUNCTION_COUNT; ++i)
+    {
+        import_signatures.push_back(types.intern(imports[i]));
+        export_signatures.push_back(types.intern(exports[i]));
+    }
+    for (auto _ : state)
+    {
+        bool linked = true;
+        for (uint32_t i = 0; i < FUNCTION_COUNT; ++i)
+        {
+            linked &= types.satisfies(import_signatures[i], export_signatures[i]);
+        }
+        benchmark::DoNotOptimize(linked);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * FUNCTION_COUNT);
+}
+BENCHMARK(BM_SignatureSubtype);
+
+// Interning a whole world from scratch, as Linker::link() does once per graph
+static void BM_InternWorld(benchmark::State &state)
+{
+    const std::vector<FunctionType> imports = world(3);
+    const std::vector<FunctionType> exports = world(3);
+    for (auto _ : state)
+    {
+        TypeInterner types;
+        bool linked = true;
+        for (uint32_t i = 0; i < FUNCTION_COUNT; ++i)
+        {
+            linked &= types.satisfies(types.intern(imports[i]), types.intern(exports[i]));
+        }
+        benchmark::DoNotOptimize(linked);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * FUNCTION_COUNT);
+}
+BENCHMARK(BM_InternWorld);
@@ -0,0 +1,321 @@
+#ifndef FLIGHT_COMPONENT_ASYNC_HPP
+#define FLIGHT_COMPONENT_ASYNC_HPP
+
+#include <flight/component/canonical_abi.hpp>
+#include <flight/wasm/utilities/error.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace flight
+{
+    namespace component
+    {
+
+        // Outcome of a stream or future copy, reported as copy_result()
+        enum class CopyStatus : uint32_t
+        {
+            Completed = 0,
+            Dropped = 1,  // The other end was dropped
+            Cancelled = 2 // cancel() ended a blocked copy
+        };
+
+        // Returned instead of a copy result when the copy is left pending;
+        // an event reports its result once it completes
+        constexpr uint32_t BLOCKED = 0xFFFFFFFF;
+
+        constexpr uint32_t copy_result(uint32_t count, CopyStatus status)
+        {
+            return count << 4 | static_cast<uint32_t>(status);
+        }
+
+        enum class EventCode : uint32_t
+        {
+            None = 0, // A task's first call, or its resumption after a yield
+            StreamRead = 2,
+            StreamWrite = 3,
+            FutureRead = 4,
+            FutureWrite = 5
+        };
+
+        // A completed copy: the handle of the end that issued it and its copy_result()
+        struct Event
+        {
+            EventCode code = EventCode::None;
+            uint32_t handle = 0;
+            uint32_t payload = 0;
+        };
+
+        // What a task callback returns: Exit, Yield, or wait_on() a waitable set
+        enum class CallbackCode : uint32_t
+        {
+            Exit = 0,
+            Yield = 1,
+            Wait = 2
+        };
+
+        constexpr uint32_t wait_on(uint32_t set)
+        {
+            return set << 4 | static_cast<uint32_t>(CallbackCode::Wait);
+        }
+
+        // One step of a task in the callback ABI: handles one event and
+        // returns a CallbackCode; a failure traps the task
+        using TaskCallback = wasm::Result<uint32_t> (*)(void *context, const Event &event);
+
+        // Fixed-capacity FIFO of equally sized elements in host memory
+        //
+        // The capacity is rounded up to a power of two so positions wrap
+        // with a mask; a push or pop is at most two memcpys.
+        class RingBuffer
+        {
+        public:
+            RingBuffer() = default;
+            RingBuffer(uint32_t element_size, uint32_t capacity);
+
+            // Copies up to count elements in or out; returns how many were copied
+            uint32_t push(const uint8_t *elements, uint32_t count);
+            uint32_t pop(uint8_t *elements, uint32_t count);
+            void clear() { head_ = tail_; }
+
+            uint32_t size() const { return tail_ - head_; }
+            uint32_t capacity() const { return mask_ + 1; }
+            uint32_t available() const { return capacity() - size(); }
+            bool empty() const { return head_ == tail_; }
+            bool full() const { return size() == capacity(); }
+
+        private:
+            std::vector<uint8_t> bytes_;
+            uint32_t element_size_ = 0;
+            uint32_t mask_ = 0;
+            uint32_t head_ = 0; // Positions count elements and wrap at 2^32
+            uint32_t tail_ = 0;
+        };
+
+        class AsyncInstance;
+
+        // Runs the tasks of async component instances
+        //
+        // Tasks follow the callback ABI: each call of the callback handles
+        // one event and returns instead of blocking, so a task waiting on
+        // I/O holds no thread and no stack. A task that waits on a waitable
+        // set is parked on it; when a copy of a stream or future joined to
+        // the set completes, its event moves the task to the ready queue,
+        // and run() resumes ready tasks in FIFO order.
+        //
+        // Streams and futures are ring buffers in host memory, owned by the
+        // executor and shared by their two ends. A write copies as many
+        // elements as the ring has room for and blocks on the rest, so a
+        // stream's capacity bounds how far a writer can run ahead of its
+        // reader. A blocked read completes as soon as any element arrives; a
+        // blocked write once all of its elements are buffered. Zero-length
+        // copies wait until the stream is readable or writable.
+        //
+        // Not thread-safe: one executor and its instances belong to one thread.
+        class Executor
+        {
+        public:
+            Executor() = default;
+            Executor(const Executor &) = delete;
+            Executor &operator=(const Executor &) = delete;
+
+            // Resumes ready tasks until none is left; returns the number of
+            // callback calls. A failing callback ends its task and run().
+            wasm::Result<size_t> run();
+
+            // Resumes the first ready task; false if none was ready
+            wasm::Result<bool> run_one();
+
+            size_t ready() const { return ready_.size(); }
+            size_t tasks() const { return live_tasks_; }
+            size_t channels() const { return live_channels_; }
+
+        private:
+            friend class AsyncInstance;
+
+            static constexpr uint32_t NONE = 0xFFFFFFFF;
+
+            // One end of a channel and the copy it has pending
+            struct End
+            {
+                AsyncInstance *owner;
+                uint32_t handle;
+                uint32_t set; // Joined waitable set, or NONE
+                bool open;
+                bool pending;
+                bool has_event; // Completed while not joined to a set
+                uint32_t ptr;   // Pending copy: next element in the owner's memory,
+                uint32_t count; // elements left,
+                uint32_t done;  // and elements already copied
+                Event event;
+            };
+
+            struct Channel
+            {
+                RingBuffer ring;
+                uint32_t element_size;
+                uint32_t alignment;
+                bool future;
+                bool written;  // Futures: the value was written
+                bool consumed; // Futures: the value was read
+                End reader;
+                End writer;
+            };
+
+            struct WaitableSet
+            {
+                std::deque<Event> events;
+                uint32_t waiter; // Parked task, or NONE
+            };
+
+            struct Task
+            {
+                AsyncInstance *instance; // nullptr when free
+                TaskCallback callback;
+                void *context;
+            };
+
+            struct Ready
+            {
+                uint32_t task;
+                Event event;
+            };
+
+            uint32_t open_channel(AsyncInstance &owner, uint32_t element_size, uint32_t alignment,
+                                  uint32_t capacity, bool future);
+            void close_end(uint32_t channel, bool reader);
+            uint32_t open_set();
+            void close_set(uint32_t set);
+            void join(End &end, uint32_t set);
+
+            // Moves data between a channel's ring and its ends' pending
+            // copies, completing those that finish
+            void pump(uint32_t channel);
+            uint32_t start(uint32_t channel, End &end);
+            void complete(Channel &channel, End &end, bool reader, CopyStatus status);
+            void deliver(uint32_t set, const Event &event);
+
+            // Withdraws the event of an end's finished copy that no task
+            // has received yet; false if there is none
+            bool take_event(End &end, Event &event);
+
+            void spawn(AsyncInstance &instance, TaskCallback callback, void *context);
+            void end_task(uint32_t task);
+            void forget(const AsyncInstance &instance);
+
+            std::vector<Channel> channels_;
+            std::vector<uint32_t> free_channels_;
+            size_t live_channels_ = 0;
+            std::vector<WaitableSet> sets_;
+            std::vector<uint32_t> free_sets_;
+            std::vector<Task> tasks_;
+            std::vector<uint32_t> free_tasks_;
+            size_t live_tasks_ = 0;
+            std::deque<Ready> ready_;
+
+            // The copy start() issues completes without an event
+            const End *starting_ = nullptr;
+            uint32_t started_result_ = 0;
+        };
+
+        // Async state of one component instance: the canon built-ins for
+        // streams, futures and waitable sets, over its own handle table
+        //
+        // Handles are a slot index and a generation, like ResourceTable's,
+        // but fit in 28 bits so that a waitable set packs into wait_on().
+        // Pointers passed to read() and write() are offsets into the
+        // instance's memory and must be aligned to the element type.
+        class AsyncInstance
+        {
+        public:
+            static constexpr uint32_t INDEX_BITS = 18;
+            static constexpr uint32_t GENERATION_BITS = 10;
+            static constexpr uint32_t MAX_SLOTS = 1u << INDEX_BITS;
+
+            AsyncInstance(Executor &executor, GuestMemory &memory);
+            ~AsyncInstance();
+
+            AsyncInstance(const AsyncInstance &) = delete;
+            AsyncInstance &operator=(const AsyncInstance &) = delete;
+
+            // stream.new: (readable, writable) ends of a stream buffering up
+            // to capacity elements; elements must be plain data
+            wasm::Result<std::pair<uint32_t, uint32_t>> stream_new(const MarshalPlan &element, uint32_t capacity);
+
+            // future.new: a stream of exactly one value
+            wasm::Result<std::pair<uint32_t, uint32_t>> future_new(const MarshalPlan &value);
+
+            // stream.read / future.read and stream.write / future.write:
+            // copy_result() of a copy finished at once, or BLOCKED. Future
+            // copies have a count of 1 and happen once per end.
+            wasm::Result<uint32_t> read(uint32_t handle, uint32_t ptr, uint32_t count);
+            wasm::Result<uint32_t> write(uint32_t handle, uint32_t ptr, uint32_t count);
+
+            // cancel-read / cancel-write: ends a blocked copy and returns its
+            // result, Cancelled unless it had already copied elements. A copy
+            // that finished but whose event no task has received yet returns
+            // its own result, and the event is withdrawn.
+            wasm::Result<uint32_t> cancel(uint32_t handle);
+
+            // drop-readable / drop-writable and waitable-set.drop; ends must
+            // have no blocked copy and sets no waiting task
+            wasm::Result<void> drop(uint32_t handle);
+
+            // waitable-set.new, waitable.join (set 0 leaves the current set)
+            // and waitable-set.poll
+            wasm::Result<uint32_t> waitable_set_new();
+            wasm::Result<void> join(uint32_t waitable, uint32_t set);
+            wasm::Result<bool> poll(uint32_t set, Event &event);
+
+            // Starts a task of this instance; its callback first receives EventCode::None
+            void spawn(TaskCallback callback, void *context);
+
+            // Moves a readable end into another instance, as passing a stream
+            // or future in a call does; returns its handle there
+            wasm::Result<uint32_t> transfer(uint32_t handle, AsyncInstance &destination);
+
+            GuestMemory &memory() const { return memory_; }
+            size_t size() const { return live_; }
+
+        private:
+            friend class Executor;
+
+            enum class Kind : uint8_t
+            {
+                Free,
+                Readable,
+                Writable,
+                WaitableSet
+            };
+
+            struct Slot
+            {
+                Kind kind;
+                uint16_t generation;
+                uint32_t index; // Channel or waitable set; next free slot when free
+            };
+
+            static constexpr uint32_t NO_SLOT = 0;
+
+            wasm::Result<uint32_t> insert(Kind kind, uint32_t index);
+            const Slot *find(uint32_t handle) const;
+            void release(uint32_t handle);
+            wasm::Result<uint32_t> channel_of(uint32_t handle, bool &reader) const;
+            wasm::Result<std::pair<uint32_t, uint32_t>> open(const MarshalPlan &element, uint32_t capacity,
+                                                             bool future);
+            wasm::Result<uint32_t> copy(uint32_t handle, uint32_t ptr, uint32_t count, bool reader);
+
+            Executor &executor_;
+            GuestMemory &memory_;
+            std::vector<Slot> slots_;
+            uint32_t free_head_ = NO_SLOT;
+            size_t live_ = 0;
+        };
+
+    } // namespace component
+} // namespace flight
+
+#endif // FLIGHT_COMPONENT_ASYNC_HPP
@@ -0,0 +1,245 @@
+#ifndef FLIGHT_COMPONENT_CANONICAL_ABI_HPP
+#define FLIGHT_COMPONENT_CANONICAL_ABI_HPP
+
+#include <flight/component/component.hpp>
+#include <flight/component/string_transcoding.hpp>
+#include <flight/component/type_interner.hpp>
+#include <flight/memory/arena.hpp>
+#include <flight/memory/stl_allocator.hpp>
+#include <flight/wasm/types/values.hpp>
+#include <flight/wasm/utilities/error.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Debug checks on borrowed buffers: encoding validation of borrowed
+// strings and detection of buffers written while lent to a callee
+#ifndef FLIGHT_COMPONENT_BORROW_CHECKS
+#ifdef NDEBUG
+#define FLIGHT_COMPONENT_BORROW_CHECKS 0
+#else
+#define FLIGHT_COMPONENT_BORROW_CHECKS 1
+#endif
+#endif
+
+namespace flight
+{
+    namespace component
+    {
+
+        // Core wasm values a component function may take or return directly;
+        // larger signatures spill to linear memory
+        constexpr size_t MAX_FLAT_PARAMS = 16;
+        constexpr size_t MAX_FLAT_RESULTS = 1;
+
+        // Size and alignment of a value in linear memory
+        struct TypeLayout
+        {
+            uint32_t size;
+            uint32_t alignment;
+        };
+
+        // Canonical ABI memory layout of a type
+        TypeLayout layout_of(const InterfaceType &type);
+
+        // Core wasm values a type flattens to when passed directly
+        std::vector<wasm::ValueType> flatten(const InterfaceType &type);
+
+        // Discriminant width in bytes for a variant or enum with case_count cases
+        constexpr uint32_t discriminant_size(size_t case_count)
+        {
+            return case_count <= 0x100 ? 1 : case_count <= 0x10000 ? 2 : 4;
+        }
+
+        // A component instance's linear memory, as the canonical ABI sees it
+        struct GuestMemory
+        {
+            // The instance's cabi_realloc export; returns 0 on failure
+            using ReallocFunction = uint32_t (*)(void *context, uint32_t original_ptr, uint32_t original_size,
+                                                 uint32_t alignment, uint32_t new_size);
+
+            uint8_t *base = nullptr;
+            size_t size = 0;
+            ReallocFunction realloc = nullptr;
+            void *realloc_context = nullptr;
+            StringEncoding string_encoding = StringEncoding::Utf8;
+
+            bool contains(uint64_t offset, uint64_t length) const
+            {
+                return offset <= size && length <= size - offset;
+            }
+
+            // Allocates through cabi_realloc and checks the result
+            wasm::Result<uint32_t> allocate(uint32_t length, uint32_t alignment);
+        };
+
+        // Validates the string stored as (ptr, length) in the memory's
+        // encoding and transcodes it to host UTF-8
+        wasm::Result<std::string> lift_string(const GuestMemory &memory, uint32_t ptr, uint32_t length);
+
+        // Stores host UTF-8 in the memory's encoding; returns (ptr, length)
+        // as the guest sees them, including any UTF16_TAG
+        wasm::Result<std::pair<uint32_t, uint32_t>> lower_string(GuestMemory &memory, const char *data, size_t size);
+
+        // Step applied after a value's bytes have been block-copied
+        enum class FixupOp : uint8_t
+        {
+            Bool,         // Normalize the byte to 0 or 1
+            Char,         // Trap on surrogates and code points above U+10FFFF
+            Discriminant, // Trap on an enum case index >= count
+            String,       // Transcode the string into the destination and rewrite (ptr, len)
+            List,         // Copy the elements, run routine target on each, rewrite (ptr, len)
+            Variant,      // Check the case, then run the case's routine at payload_offset
+            Handle        // Pass a resource, stream or future handle through the TransferOptions translator
+        };
+
+        struct Fixup
+        {
+            FixupOp op;
+            uint8_t width;           // Discriminant width (Discriminant, Variant)
+            TypeKind kind;           // Own, Borrow, Stream or Future (Handle)
+            uint32_t offset;         // Offset of the field within the value
+            uint32_t count;          // Case count (Discriminant, Variant)
+            uint32_t payload_offset; // Payload offset within the value (Variant)
+            uint32_t target;         // Element routine (List) or first case entry (Variant)
+        };
+
+        // Fixups of one value type; fields of nested records and tuples are
+        // folded into the enclosing routine
+        struct MarshalRoutine
+        {
+            TypeLayout layout;
+            uint32_t first_fixup;
+            uint32_t fixup_count;
+        };
+
+        // A type compiled for transfer between linear memories
+        //
+        // Moving a value is one memcpy of its layout followed by the fixups,
+        // which are only needed for the parts whose bytes cannot be copied
+        // verbatim: out-of-line strings and lists, bools and characters that
+        // must be validated, variant payloads and resource handles. Routine 0
+        // is the value itself; lists and variant cases get routines of their
+        // own. A plan without fixups is a single memcpy. Compilation
+        // temporaries live in an arena that is rewound after each routine.
+        class MarshalPlan
+        {
+        public:
+            static constexpr uint32_t NO_FIXUPS = 0xFFFFFFFF; // Case routine of a trivially copied payload
+
+            explicit MarshalPlan(const InterfaceType &type);
+
+            const TypeLayout &layout() const { return routines_[0].layout; }
+            bool trivially_copyable() const { return routines_[0].fixup_count == 0; }
+
+            const std::vector<MarshalRoutine> &routines() const { return routines_; }
+            const std::vector<Fixup> &fixups() const { return fixups_; }
+            const std::vector<uint32_t> &case_routines() const { return case_routines_; }
+
+        private:
+            uint32_t compile_routine(const InterfaceType &type, memory::Arena &arena);
+            void compile(const InterfaceType &type, uint32_t offset, memory::ArenaVector<Fixup> &fixups,
+                         memory::Arena &arena);
+
+            std::vector<MarshalRoutine> routines_;
+            std::vector<Fixup> fixups_;
+            std::vector<uint32_t> case_routines_;
+        };
+
+        // Moves or borrows a resource handle into the destination instance
+        using HandleTranslator = wasm::Result<uint32_t> (*)(void *context, TypeKind kind, uint32_t handle);
+
+        // Buffers lent to a callee for the duration of one call
+        //
+        // When both sides of a call share one linear memory, as flattened
+        // components do, a transfer given a BorrowScope passes strings and
+        // lists of plain data as (ptr, len) views of the caller's buffers
+        // instead of copying them, so their cost no longer depends on their
+        // size. Strings are only borrowed when both sides use the same
+        // string encoding. The caller must keep the buffers alive and
+        // unchanged, and the callee must neither keep nor modify them,
+        // until the call returns and release() is called.
+        //
+        // With FLIGHT_COMPONENT_BORROW_CHECKS, borrowed strings are still
+        // validated and release() fails if a lent buffer was written.
+        class BorrowScope
+        {
+        public:
+            BorrowScope() = default;
+            BorrowScope(const BorrowScope &) = delete;
+            BorrowScope &operator=(const BorrowScope &) = delete;
+
+            void lend(const GuestMemory &memory, uint32_t ptr, uint32_t length);
+
+            // Ends the call: checks the lent buffers, then forgets them
+            wasm::Result<void> release(const GuestMemory &memory);
+
+            // Buffers lent since the last release
+            size_t size() const { return lent_; }
+
+        private:
+            struct Loan
+            {
+                uint32_t ptr;
+                uint32_t length;
+                uint64_t checksum;
+            };
+
+            std::vector<Loan> loans_; // Only recorded with borrow checks
+            size_t lent_ = 0;
+        };
+
+        struct TransferOptions
+        {
+            HandleTranslator translate_handle = nullptr; // nullptr copies handles unchanged
+            void *handle_context = nullptr;
+            BorrowScope *borrows = nullptr; // Lend buffers within a shared memory instead of copying
+        };
+
+        // Canonical ABI engine
+        //
+        // Compiles each InterfaceType once into a MarshalPlan and caches it,
+        // then moves values between component memories by executing plans
+        // instead of walking the type tree on every call. Host code with
+        // statically known types should use lift()/lower() from
+        // canonical_types.hpp instead, which need no plan at all.
+        //
+        // A failed transfer is a trap: memory already allocated in the
+        // destination is not released.
+        class CanonicalABI
+        {
+        public:
+            // Compiled plan for a type; cached, and safe to call from any thread
+            std::shared_ptr<const MarshalPlan> plan(const InterfaceType &type);
+
+            // Copy a value stored at src_offset into dst_offset, whose
+            // layout().size bytes must already belong to the value
+            static wasm::Result<void> transfer(const MarshalPlan &plan,
+                                               const GuestMemory &src, uint32_t src_offset,
+                                               GuestMemory &dst, uint32_t dst_offset,
+                                               const TransferOptions &options = {});
+
+            // Allocate room in dst, copy the value there and return its offset
+            static wasm::Result<uint32_t> transfer_new(const MarshalPlan &plan,
+                                                       const GuestMemory &src, uint32_t src_offset,
+                                                       GuestMemory &dst,
+                                                       const TransferOptions &options = {});
+
+            size_t cached_plans() const;
+
+        private:
+            mutable std::mutex mutex_;
+            TypeInterner types_{TypeIdentity::Layout};
+            std::vector<std::shared_ptr<const MarshalPlan>> plans_; // Indexed by TypeId
+            size_t cached_ = 0;
+        };
+
+    } // namespace component
+} // namespace flight
+
+#endif // FLIGHT_COMPONENT_CANONICAL_ABI_HPP
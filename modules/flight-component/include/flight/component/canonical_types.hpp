@@ -0,0 +1,835 @@
+#ifndef FLIGHT_COMPONENT_CANONICAL_TYPES_HPP
+#define FLIGHT_COMPONENT_CANONICAL_TYPES_HPP
+
+#include <flight/component/canonical_abi.hpp>
+#include <flight/wasm/utilities/endian.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace flight
+{
+    namespace component
+    {
+
+        // Compile-time canonical ABI mapping of a C++ type
+        //
+        // Each specialization provides the layout as constants, the matching
+        // InterfaceType, and load/store functions that the compiler inlines
+        // into straight-line code for the whole value. load and store assume
+        // the value's own bytes are in bounds; out-of-line strings and lists
+        // are checked as they are followed. Supported: bool, fixed-width
+        // integers, float, double, char32_t (char), std::string,
+        // std::string_view and ByteView (borrowed views), std::vector,
+        // std::optional, std::pair, std::tuple, std::variant, ResourceHandle
+        // (own) and records that list their members in a static
+        // canonical_fields tuple:
+        //
+        //     struct Point
+        //     {
+        //         int32_t x, y;
+        //         static constexpr auto canonical_fields = std::make_tuple(&Point::x, &Point::y);
+        //     };
+        //
+        // std::string holds UTF-8 on the host side and is transcoded to and
+        // from the memory's string_encoding.
+        //
+        // trivial is true when the canonical bytes equal the host object
+        // representation, so arrays of the type are lifted with one memcpy.
+        template <typename T, typename = void>
+        struct CanonicalType;
+
+        namespace detail
+        {
+            constexpr uint32_t align_up(uint32_t offset, uint32_t alignment)
+            {
+                return (offset + alignment - 1) & ~(alignment - 1);
+            }
+
+            template <typename T>
+            T load_scalar(const uint8_t *bytes)
+            {
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+                    Bits bits;
+                    std::memcpy(&bits, bytes, sizeof(bits));
+                    bits = wasm::endian::wasm_to_host(bits);
+                    T value;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    return value;
+                }
+                else
+                {
+                    T value;
+                    std::memcpy(&value, bytes, sizeof(value));
+                    return sizeof(T) == 1 ? value : wasm::endian::wasm_to_host(value);
+                }
+            }
+
+            template <typename T>
+            void store_scalar(uint8_t *bytes, T value)
+            {
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+                    Bits bits;
+                    std::memcpy(&bits, &value, sizeof(bits));
+                    bits = wasm::endian::host_to_wasm(bits);
+                    std::memcpy(bytes, &bits, sizeof(bits));
+                }
+                else
+                {
+                    if constexpr (sizeof(T) > 1)
+                    {
+                        value = wasm::endian::host_to_wasm(value);
+                    }
+                    std::memcpy(bytes, &value, sizeof(value));
+                }
+            }
+
+            template <typename T>
+            constexpr bool is_scalar_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+                                         !std::is_same_v<T, char32_t> && !std::is_same_v<T, char> &&
+                                         !std::is_same_v<T, long double>;
+
+            template <typename T>
+            constexpr TypeKind scalar_kind()
+            {
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    return sizeof(T) == 4 ? TypeKind::Float32 : TypeKind::Float64;
+                }
+                else if constexpr (std::is_signed_v<T>)
+                {
+                    return sizeof(T) == 1 ? TypeKind::S8 : sizeof(T) == 2 ? TypeKind::S16
+                                                       : sizeof(T) == 4   ? TypeKind::S32
+                                                                          : TypeKind::S64;
+                }
+                else
+                {
+                    return sizeof(T) == 1 ? TypeKind::U8 : sizeof(T) == 2 ? TypeKind::U16
+                                                       : sizeof(T) == 4   ? TypeKind::U32
+                                                                          : TypeKind::U64;
+                }
+            }
+
+            // Reads a (ptr, len) pair and checks the buffer it describes
+            inline wasm::Result<std::pair<uint32_t, uint32_t>> load_buffer(const GuestMemory &memory, uint32_t offset,
+                                                                         uint32_t element_size, uint32_t element_alignment)
+            {
+                const uint32_t ptr = load_scalar<uint32_t>(memory.base + offset);
+                const uint32_t length = load_scalar<uint32_t>(memory.base + offset + 4);
+                if (ptr % element_alignment != 0)
+                {
+                    return wasm::make_error<std::pair<uint32_t, uint32_t>>(wasm::ErrorCode::InvalidAlignment,
+                                                                          "Misaligned list pointer");
+                }
+                if (!memory.contains(ptr, uint64_t(length) * element_size))
+                {
+                    return wasm::make_error<std::pair<uint32_t, uint32_t>>(wasm::ErrorCode::OutOfBounds,
+                                                                          "List out of bounds");
+                }
+                return std::make_pair(ptr, length);
+            }
+
+            template <typename T, typename = void>
+            struct has_canonical_fields : std::false_type
+            {
+            };
+
+            template <typename T>
+            struct has_canonical_fields<T, std::void_t<decltype(T::canonical_fields)>> : std::true_type
+            {
+            };
+
+            template <typename MemberPointer>
+            struct member_type;
+
+            template <typename Class, typename Member>
+            struct member_type<Member Class::*>
+            {
+                using type = Member;
+            };
+        } // namespace detail
+
+        // Lift a value stored at offset in guest memory
+        template <typename T>
+        wasm::Result<T> lift(const GuestMemory &memory, uint32_t offset)
+        {
+            using Canonical = CanonicalType<T>;
+            if (offset % Canonical::alignment != 0)
+            {
+                return wasm::make_error<T>(wasm::ErrorCode::InvalidAlignment, "Misaligned value");
+            }
+            if (!memory.contains(offset, Canonical::size))
+            {
+                return wasm::make_error<T>(wasm::ErrorCode::OutOfBounds, "Value out of bounds");
+            }
+            return Canonical::load(memory, offset);
+        }
+
+        // Lower a value into guest memory at offset
+        template <typename T>
+        wasm::Result<void> lower(GuestMemory &memory, uint32_t offset, const T &value)
+        {
+            using Canonical = CanonicalType<T>;
+            if (offset % Canonical::alignment != 0)
+            {
+                return wasm::Result<void>(wasm::ErrorCode::InvalidAlignment, "Misaligned value");
+            }
+            if (!memory.contains(offset, Canonical::size))
+            {
+                return wasm::Result<void>(wasm::ErrorCode::OutOfBounds, "Value out of bounds");
+            }
+            return Canonical::store(memory, offset, value);
+        }
+
+        // Lower a value into a fresh allocation and return its offset
+        template <typename T>
+        wasm::Result<uint32_t> lower_new(GuestMemory &memory, const T &value)
+        {
+            using Canonical = CanonicalType<T>;
+            auto allocation = memory.allocate(Canonical::size, Canonical::alignment);
+            if (!allocation)
+            {
+                return allocation;
+            }
+            auto result = Canonical::store(memory, allocation.value(), value);
+            if (!result)
+            {
+                return wasm::make_error<uint32_t>(result.error());
+            }
+            return allocation;
+        }
+
+        // Integers and floating point
+        template <typename T>
+        struct CanonicalType<T, std::enable_if_t<detail::is_scalar_v<T>>>
+        {
+            static constexpr uint32_t size = sizeof(T);
+            static constexpr uint32_t alignment = sizeof(T);
+            static constexpr bool trivial = !wasm::platform::CurrentPlatform::is_big_endian;
+
+            static InterfaceType type() { return {detail::scalar_kind<T>(), "", {}}; }
+
+            static wasm::Result<T> load(const GuestMemory &memory, uint32_t offset)
+            {
+                return detail::load_scalar<T>(memory.base + offset);
+            }
+
+            static wasm::Result<void> store(GuestMemory &memory, uint32_t offset, T value)
+            {
+                detail::store_scalar(memory.base + offset, value);
+                return wasm::Result<void>();
+            }
+        };
+
+        template <>
+        struct CanonicalType<bool>
+        {
+            static constexpr uint32_t size = 1;
+            static constexpr uint32_t alignment = 1;
+            static constexpr bool trivial = false; // Any non-zero byte lifts to true
+
+            static InterfaceType type() { return {TypeKind::Bool, "", {}}; }
+
+            static wasm::Result<bool> load(const GuestMemory &memory, uint32_t offset)
+            {
+                return memory.base[offset] != 0;
+            }
+
+            static wasm::Result<void> store(GuestMemory &memory, uint32_t offset, bool value)
+            {
+                memory.base[offset] = value ? 1 : 0;
+                return wasm::Result<void>();
+            }
+        };
+
+        template <>
+        struct CanonicalType<char32_t>
+        {
+            static constexpr uint32_t size = 4;
+            static constexpr uint32_t alignment = 4;
+            static constexpr bool trivial = false; // Surrogates and values past U+10FFFF trap
+
+            static InterfaceType type() { return {TypeKind::Char, "", {}}; }
+
+            static wasm::Result<char32_t> load(const GuestMemory &memory, uint32_t offset)
+            {
+                const uint32_t c = detail::load_scalar<uint32_t>(memory.base + offset);
+                if (c >= 0x110000 || (c >= 0xD800 && c < 0xE000))
+                {
+                    return wasm::make_error<char32_t>(wasm::ErrorCode::TypeMismatch, "Invalid char value");
+                }
+                return static_cast<char32_t>(c);
+            }
+
+            static wasm::Result<void> store(GuestMemory &memory, uint32_t offset, char32_t value)
+            {
+                detail::store_scalar(memory.base + offset, static_cast<uint32_t>(value));
+                return wasm::Result<void>();
+            }
+        };
+
+        template <>
+        struct CanonicalType<std::string>
+        {
+            static constexpr uint32_t size = 8;
+            static constexpr uint32_t alignment = 4;
+            static constexpr bool trivial = false;
+
+            static InterfaceType type() { return {TypeKind::String, "", {}}; }
+
+            static wasm::Result<std::string> load(const GuestMemory &memory, uint32_t offset)
+            {
+                return lift_string(memory, detail::load_scalar<uint32_t>(memory.base + offset),
+                                   detail::load_scalar<uint32_t>(memory.base + offset + 4));
+            }
+
+            static wasm::Result<void> store(GuestMemory &memory, uint32_t offset, const std::string &value)
+            {
+                auto stored = lower_string(memory, value.data(), value.size());
+                if (!stored)
+                {
+                    return wasm::Result<void>(stored.error());
+                }
+                detail::store_scalar(memory.base + offset, stored.value().first);
+                detail::store_scalar(memory.base + offset + 4, stored.value().second);
+                return wasm::Result<void>();
+            }
+        };
+
+        // Borrowed view of a UTF-8 string in guest memory, valid while the
+        // guest buffer is (for a host import: until the call returns).
+        // Loading is O(1); the encoding is only validated with
+        // FLIGHT_COMPONENT_BORROW_CHECKS. Storing copies.
+        template <>
+        struct CanonicalType<std::string_view>
+        {
+            static constexpr uint32_t size = 8;
+            static constexpr uint32_t alignment = 4;
+            static constexpr bool trivial = false;
+
+            static InterfaceType type() { return {TypeKind::String, "", {}}; }
+
+            static wasm::Result<std::string_view> load(const GuestMemory &memory, uint32_t offset)
+            {
+                if (memory.string_encoding != StringEncoding::Utf8)
+                {
+                    return wasm::make_error<std::string_view>(wasm::ErrorCode::TypeMismatch,
+                                                              "Borrowed strings need UTF-8 memory");
+                }
+                auto buffer = detail::load_buffer(memory, offset, 1, 1);
+                if (!buffer)
+                {
+                    return wasm::make_error<std::string_view>(buffer.error());
+                }
+                const auto [ptr, length] = buffer.value();
+#if FLIGHT_COMPONENT_BORROW_CHECKS
+                if (!transcoding::validate_utf8(memory.base + ptr, length))
+                {
+                    return wasm::make_error<std::string_view>(wasm::ErrorCode::InvalidUTF8Sequence,
+                                                              "Invalid UTF-8 string");
+                }
+#endif
+                return std::string_view(reinterpret_cast<const char *>(memory.base + ptr), length);
+            }
+
+            static wasm::Result<void> store(GuestMemory &memory, uint32_t offset, std::string_view value)
+            {
+                auto stored = lower_string(memory, value.data(), value.size());
+                if (!stored)
+                {
+                    return wasm::Result<void>(stored.error());
+                }
+                detail::store_scalar(memory.base + offset, stored.value().first);
+                detail::store_scalar(memory.base + offset + 4, stored.value().second);
+                return wasm::Result<void>();
+            }
+        };
+
+        // Borrowed view of a list<u8> in guest memory, for blobs such as
+        // asset data or network buffers that should not be copied
+        struct ByteView
+        {
+            const uint8_t *data = nullptr;
+            size_t size = 0;
+        };
+
+        template <>
+        struct CanonicalType<ByteView>
+        {
+            static constexpr uint32_t size = 8;
+            static constexpr uint32_t alignment = 4;
+            static constexpr bool trivial = false;
+
+            static InterfaceType type() { return {TypeKind::List, "", {{TypeKind::U8, "", {}}}}; }
+
+            static wasm::Result<ByteView> load(const GuestMemory &memory, uint32_t offset)
+            {
+                auto buffer = detail::load_buffer(memory, offset, 1, 1);
+                if (!buffer)
+                {
+                    return wasm::make_error<ByteView>(buffer.error());
+                }
+                return ByteView{memory.base + buffer.value().first, buffer.value().second};
+            }
+
+            static wasm::Result<void> store(GuestMemory &memory, uint32_t offset, ByteView value)
+            {
+                if (value.size > UINT32_MAX)
+                {
+                    return wasm::Result<void>(wasm::ErrorCode::OutOfMemory, "List too large");
+                }
+                auto allocation = memory.allocate(static_cast<uint32_t>(value.size), 1);
+                if (!allocation)
+                {
+                    return wasm::Result<void>(allocation.error());
+                }
+                if (value.size != 0)
+                {
+                    std::memcpy(memory.base + allocation.value(), value.data, value.size);
+                }
+                detail::store_scalar(memory.base + offset, allocation.value());
+                detail::store_scalar(memory.base + offset + 4, static_cast<uint32_t>(value.size));
+                return wasm::Result<void>();
+            }
+        };
+
+        template <typename T>
+        struct CanonicalType<std::vector<T>>
+        {
+            using Element = CanonicalType<T>;
+
+            static constexpr uint32_t size = 8;
+            static constexpr uint32_t alignment = 4;
+            static constexpr bool trivial = false;
+
+            static InterfaceType type() { return {TypeKind::List, "", {Element::type()}}; }
+
+            static wasm::Result<std::vector<T>> load(const GuestMemory &memory, uint32_t offset)
+            {
+                auto buffer = detail::load_buffer(memory, offset, Element::size, Element::alignment);
+                if (!buffer)
+                {
+                    return wasm::make_error<std::vector<T>>(buffer.error());
+                }
+                const auto [ptr, length] = buffer.value();
+                std::vector<T> values;
+                if constexpr (Element::trivial && std::is_trivially_copyable_v<T> && sizeof(T) == Element::size)
+                {
+                    values.resize(length);
+                    if (length != 0)
+                    {
+                        std::memcpy(values.data(), memory.base + ptr, size_t(length) * Element::size);
+                    }
+                }
+                else
+                {
+                    values.reserve(length);
+                    for (uint32_t i = 0; i < length; ++i)
+                    {
+                        auto value = Element::load(memory, ptr + i * Element::size);
+                        if (!value)
+                        {
+                            return wasm::make_error<std::vector<T>>(value.error());
+                        }
+                        values.push_back(std::move(value).value());
+                    }
+                }
+                return values;
+            }
+
+            static wasm::Result<void> store(GuestMemory &memory, uint32_t offset, const std::vector<T> &values)
+            {
+                const uint64_t bytes = uint64_t(values.size()) * Element::size;
+                if (bytes > UINT32_MAX)
+                {
+                    return wasm::Result<void>(wasm::ErrorCode::OutOfMemory, "List too large");
+                }
+                auto allocation = memory.allocate(static_cast<uint32_t>(bytes), Element::alignment);
+                if (!allocation)
+                {
+                    return wasm::Result<void>(allocation.error());
+                }
+                const uint32_t ptr = allocation.value();
+                if constexpr (Element::trivial && std::is_trivially_copyable_v<T> && sizeof(T) == Element::size)
+                {
+                    if (bytes != 0)
+                    {
+                        std::memcpy(memory.base + ptr, values.data(), static_cast<size_t>(bytes));
+                    }
+                }
+                else
+                {
+                    for (size_t i = 0; i < values.size(); ++i)
+                    {
+                        // Nested allocations may grow memory, so offsets are used, never pointers
+                        auto result = Element::store(memory, ptr + static_cast<uint32_t>(i) * Element::size, values[i]);
+                        if (!result)
+                        {
+                            return result;
+                        }
+                    }
+                }
+                detail::store_scalar(memory.base + offset, ptr);
+                detail::store_scalar(memory.base + offset + 4, static_cast<uint32_t>(values.size()));
+                return wasm::Result<void>();
+            }
+        };
+
+        template <typename T>
+        struct CanonicalType<ResourceHandle<T>>
+        {
+            static constexpr uint32_t size = 4;
+            static constexpr uint32_t alignment = 4;
+            static constexpr bool trivial = false; // Handles are translated between instances
+
+            static InterfaceType type() { return {TypeKind::Own, "", {}}; }
+
+            static wasm::Result<ResourceHandle<T>> load(const GuestMemory &memory, uint32_t offset)
+            {
+                return ResourceHandle<T>(detail::load_scalar<uint32_t>(memory.base + offset));
+            }
+
+            static wasm::Result<void> store(GuestMemory &memory, uint32_t offset, const ResourceHandle<T> &handle)
+            {
+                detail::store_scalar(memory.base + offset, handle.index());
+                return wasm::Result<void>();
+            }
+        };
+
+        template <typename T>
+        struct CanonicalType<std::optional<T>>
+        {
+            using Payload = CanonicalType<T>;
+
+            static constexpr uint32_t alignment = Payload::alignment;
+            static constexpr uint32_t payload_offset = detail::align_up(1, Payload::alignment);
+            static constexpr uint32_t size = detail::align_up(payload_offset + Payload::size, alignment);
+            static constexpr bool trivial = false;
+
+            static InterfaceType type() { return {TypeKind::Option, "", {Payload::type()}}; }
+
+            static wasm::Result<std::optional<T>> load(const GuestMemory &memory, uint32_t offset)
+            {
+                const uint8_t discriminant = memory.base[offset];
+                if (discriminant == 0)
+                {
+                    return std::optional<T>();
+                }
+                if (discriminant != 1)
+                {
+                    return wasm::make_error<std::optional<T>>(wasm::ErrorCode::TypeMismatch, "Invalid case index");
+                }
+                auto value = Payload::load(memory, offset + payload_offset);
+                if (!value)
+                {
+                    return wasm::make_error<std::optional<T>>(value.error());
+                }
+                return std::optional<T>(std::move(value).value());
+            }
+
+            static wasm::Result<void> store(GuestMemory &memory, uint32_t offset, const std::optional<T> &value)
+            {
+                memory.base[offset] = value ? 1 : 0;
+                return value ? Payload::store(memory, offset + payload_offset, *value) : wasm::Result<void>();
+            }
+        };
+
+        // Records, tuples and pairs share the field-by-field implementation
+        namespace detail
+        {
+            template <typename... Fields>
+            struct FieldLayout
+            {
+                static constexpr uint32_t count = sizeof...(Fields);
+
+                static constexpr std::array<uint32_t, sizeof...(Fields) + 1> offsets()
+                {
+                    std::array<uint32_t, sizeof...(Fields) + 1> result{};
+                    const uint32_t sizes[] = {CanonicalType<Fields>::size..., 0};
+                    const uint32_t alignments[] = {CanonicalType<Fields>::alignment..., 1};
+                    uint32_t offset = 0;
+                    uint32_t max_alignment = 1;
+                    for (size_t i = 0; i < sizeof...(Fields); ++i)
+                    {
+                        offset = align_up(offset, alignments[i]);
+                        result[i] = offset;
+                        offset += sizes[i];
+                        max_alignment = alignments[i] > max_alignment ? alignments[i] : max_alignment;
+                    }
+                    result[sizeof...(Fields)] = align_up(offset, max_alignment); // Total size
+                    return result;
+                }
+
+                static constexpr uint32_t alignment()
+                {
+                    uint32_t result = 1;
+                    const uint32_t alignments[] = {CanonicalType<Fields>::alignment..., 1};
+                    for (uint32_t a : alignments)
+                    {
+                        result = a > result ? a : result;
+                    }
+                    return result;
+                }
+
+                static constexpr bool trivial = (CanonicalType<Fields>::trivial && ...);
+
+                static std::vector<InterfaceType> types() { return {CanonicalType<Fields>::type()...}; }
+            };
+
+            template <typename Layout, typename Tuple, size_t... I>
+            wasm::Result<void> load_fields(const GuestMemory &memory, uint32_t offset, Tuple &fields,
+                                           std::index_sequence<I...>)
+            {
+                constexpr auto offsets = Layout::offsets();
+                wasm::Result<void> result;
+                // Stops at the first field that fails
+                (void)((
+                           [&] {
+                               using Field = std::remove_reference_t<decltype(std::get<I>(fields))>;
+                               auto value = CanonicalType<Field>::load(memory, offset + offsets[I]);
+                               if (!value)
+                               {
+                                   result = wasm::Result<void>(value.error());
+                                   return false;
+                               }
+                               std::get<I>(fields) = std::move(value).value();
+                               return true;
+                           }()) &&
+                       ...);
+                return result;
+            }
+
+            template <typename Layout, typename Tuple, size_t... I>
+            wasm::Result<void> store_fields(GuestMemory &memory, uint32_t offset, const Tuple &fields,
+                                            std::index_sequence<I...>)
+            {
+                constexpr auto offsets = Layout::offsets();
+                wasm::Result<void> result;
+                (void)((
+                           [&] {
+                               using Field = std::decay_t<decltype(std::get<I>(fields))>;
+                               result = CanonicalType<Field>::store(memory, offset + offsets[I], std::get<I>(fields));
+                               return result.success();
+                           }()) &&
+                       ...);
+                return result;
+            }
+        } // namespace detail
+
+        template <typename... Ts>
+        struct CanonicalType<std::tuple<Ts...>>
+        {
+            using Layout = detail::FieldLayout<Ts...>;
+
+            static constexpr uint32_t size = Layout::offsets()[sizeof...(Ts)];
+            static constexpr uint32_t alignment = Layout::alignment();
+            static constexpr bool trivial = false;
+
+            static InterfaceType type() { return {TypeKind::Tuple, "", Layout::types()}; }
+
+            static wasm::Result<std::tuple<Ts...>> load(const GuestMemory &memory, uint32_t offset)
+            {
+                std::tuple<Ts...> value;
+                auto result = detail::load_fields<Layout>(memory, offset, value, std::index_sequence_for<Ts...>{});
+                if (!result)
+                {
+                    return wasm::make_error<std::tuple<Ts...>>(result.error());
+                }
+                return value;
+            }
+
+            static wasm::Result<void> store(GuestMemory &memory, uint32_t offset, const std::tuple<Ts...> &value)
+            {
+                return detail::store_fields<Layout>(memory, offset, value, std::index_sequence_for<Ts...>{});
+            }
+        };
+
+        template <typename A, typename B>
+        struct CanonicalType<std::pair<A, B>>
+        {
+            using Layout = detail::FieldLayout<A, B>;
+
+            static constexpr uint32_t size = Layout::offsets()[2];
+            static constexpr uint32_t alignment = Layout::alignment();
+            static constexpr bool trivial = false;
+
+            static InterfaceType type() { return {TypeKind::Tuple, "", Layout::types()}; }
+
+            static wasm::Result<std::pair<A, B>> load(const GuestMemory &memory, uint32_t offset)
+            {
+                std::pair<A, B> value;
+                auto result = detail::load_fields<Layout>(memory, offset, value, std::index_sequence<0, 1>{});
+                if (!result)
+                {
+                    return wasm::make_error<std::pair<A, B>>(result.error());
+                }
+                return value;
+            }
+
+            static wasm::Result<void> store(GuestMemory &memory, uint32_t offset, const std::pair<A, B> &value)
+            {
+                return detail::store_fields<Layout>(memory, offset, value, std::index_sequence<0, 1>{});
+            }
+        };
+
+        // Records declared through canonical_fields
+        template <typename T>
+        struct CanonicalType<T, std::enable_if_t<detail::has_canonical_fields<T>::value>>
+        {
+        private:
+            template <typename Fields>
+            struct LayoutOf;
+
+            template <typename... Members>
+            struct LayoutOf<std::tuple<Members...>>
+            {
+                using type = detail::FieldLayout<typename detail::member_type<Members>::type...>;
+            };
+
+            using Fields = std::decay_t<decltype(T::canonical_fields)>;
+            static constexpr size_t field_count = std::tuple_size_v<Fields>;
+
+            template <size_t... I>
+            static auto tie(T &value, std::index_sequence<I...>)
+            {
+                return std::tie(value.*std::get<I>(T::canonical_fields)...);
+            }
+
+            template <size_t... I>
+            static auto tie(const T &value, std::index_sequence<I...>)
+            {
+                return std::tie(value.*std::get<I>(T::canonical_fields)...);
+            }
+
+        public:
+            using Layout = typename LayoutOf<Fields>::type;
+
+            static constexpr uint32_t size = Layout::offsets()[field_count];
+            static constexpr uint32_t alignment = Layout::alignment();
+            // Field-by-field layout matching the host struct is not guaranteed
+            static constexpr bool trivial = false;
+
+            static InterfaceType type() { return {TypeKind::Record, "", Layout::types()}; }
+
+            static wasm::Result<T> load(const GuestMemory &memory, uint32_t offset)
+            {
+                T value{};
+                auto fields = tie(value, std::make_index_sequence<field_count>{});
+                auto result = detail::load_fields<Layout>(memory, offset, fields, std::make_index_sequence<field_count>{});
+                if (!result)
+                {
+                    return wasm::make_error<T>(result.error());
+                }
+                return value;
+            }
+
+            static wasm::Result<void> store(GuestMemory &memory, uint32_t offset, const T &value)
+            {
+                const auto fields = tie(value, std::make_index_sequence<field_count>{});
+                return detail::store_fields<Layout>(memory, offset, fields, std::make_index_sequence<field_count>{});
+            }
+        };
+
+        template <typename... Ts>
+        struct CanonicalType<std::variant<Ts...>>
+        {
+            static constexpr uint32_t discriminant_bytes = discriminant_size(sizeof...(Ts));
+            static constexpr uint32_t payload_alignment = std::max({CanonicalType<Ts>::alignment...});
+            static constexpr uint32_t alignment = std::max(discriminant_bytes, payload_alignment);
+            static constexpr uint32_t payload_offset = detail::align_up(discriminant_bytes, payload_alignment);
+            static constexpr uint32_t size =
+                detail::align_up(payload_offset + std::max({CanonicalType<Ts>::size...}), alignment);
+            static constexpr bool trivial = false;
+
+            static InterfaceType type() { return {TypeKind::Variant, "", {CanonicalType<Ts>::type()...}}; }
+
+            static wasm::Result<std::variant<Ts...>> load(const GuestMemory &memory, uint32_t offset)
+            {
+                uint32_t index;
+                if constexpr (discriminant_bytes == 1)
+                {
+                    index = memory.base[offset];
+                }
+                else
+                {
+                    index = detail::load_scalar<uint16_t>(memory.base + offset);
+                }
+                return load_case(memory, offset + payload_offset, index, std::index_sequence_for<Ts...>{});
+            }
+
+            static wasm::Result<void> store(GuestMemory &memory, uint32_t offset, const std::variant<Ts...> &value)
+            {
+                if constexpr (discriminant_bytes == 1)
+                {
+                    memory.base[offset] = static_cast<uint8_t>(value.index());
+                }
+                else
+                {
+                    detail::store_scalar(memory.base + offset, static_cast<uint16_t>(value.index()));
+                }
+                return std::visit(
+                    [&](const auto &payload) {
+                        using Case = std::decay_t<decltype(payload)>;
+                        return CanonicalType<Case>::store(memory, offset + payload_offset, payload);
+                    },
+                    value);
+            }
+
+        private:
+            template <size_t... I>
+            static wasm::Result<std::variant<Ts...>> load_case(const GuestMemory &memory, uint32_t offset,
+                                                               uint32_t index, std::index_sequence<I...>)
+            {
+                using Loader = wasm::Result<std::variant<Ts...>> (*)(const GuestMemory &, uint32_t);
+                static constexpr Loader loaders[] = {&load_alternative<I>...};
+                if (index >= sizeof...(Ts))
+                {
+                    return wasm::make_error<std::variant<Ts...>>(wasm::ErrorCode::TypeMismatch, "Invalid case index");
+                }
+                return loaders[index](memory, offset);
+            }
+
+            template <size_t I>
+            static wasm::Result<std::variant<Ts...>> load_alternative(const GuestMemory &memory, uint32_t offset)
+            {
+                using Case = std::variant_alternative_t<I, std::variant<Ts...>>;
+                auto payload = CanonicalType<Case>::load(memory, offset);
+                if (!payload)
+                {
+                    return wasm::make_error<std::variant<Ts...>>(payload.error());
+                }
+                return std::variant<Ts...>(std::in_place_index<I>, std::move(payload).value());
+            }
+        };
+
+        // std::monostate is the payload-less case of a variant
+        template <>
+        struct CanonicalType<std::monostate>
+        {
+            static constexpr uint32_t size = 0;
+            static constexpr uint32_t alignment = 1;
+            static constexpr bool trivial = true;
+
+            static InterfaceType type() { return {TypeKind::Tuple, "", {}}; }
+
+            static wasm::Result<std::monostate> load(const GuestMemory &, uint32_t) { return std::monostate{}; }
+            static wasm::Result<void> store(GuestMemory &, uint32_t, std::monostate) { return wasm::Result<void>(); }
+        };
+
+    } // namespace component
+} // namespace flight
+
+#endif // FLIGHT_COMPONENT_CANONICAL_TYPES_HPP
@@ -42,10 +42,12 @@ namespace flight
             Option,
             Result,
             Own,
-            Borrow
+            Borrow,
+            Stream, // Readable end of a stream, an AsyncInstance handle
+            Future  // Readable end of a future, an AsyncInstance handle
         };
 
-        // Resource handle
+        // Resource handle; index is a ResourceTable handle (slot and generation)
         template <typename T>
         class ResourceHandle
         {
@@ -58,6 +60,13 @@ namespace flight
         };
 
         // Interface type definition
+        //
+        // params holds the nested types: the element of a list, option,
+        // stream or future, the fields of a record or tuple, the ok and
+        // error types of a result, and one entry per variant case, enum
+        // case or flag, named after it. Cases without a payload (and a
+        // result without an ok or error type, or a stream or future
+        // without an element) use an empty tuple.
         struct InterfaceType
         {
             TypeKind kind;
@@ -65,6 +74,13 @@ namespace flight
             std::vector<InterfaceType> params;
         };
 
+        // Parameters and results of a component function
+        struct FunctionType
+        {
+            std::vector<InterfaceType> params;
+            std::vector<InterfaceType> results;
+        };
+
         // This module provides:
         // - Component Model types and operations
         // - Canonical ABI implementation
@@ -0,0 +1,210 @@
+#ifndef FLIGHT_COMPONENT_COMPONENT_BINARY_HPP
+#define FLIGHT_COMPONENT_COMPONENT_BINARY_HPP
+
+#include <flight/component/component.hpp>
+#include <flight/component/string_transcoding.hpp>
+#include <flight/wasm/utilities/error.hpp>
+#include <flight/wasm/utilities/span.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace flight
+{
+    namespace component
+    {
+
+        // Component binary preamble after the magic: version 0x0d, layer 1
+        constexpr uint32_t COMPONENT_VERSION = 0x0001000D;
+
+        // Core sorts, with their binary encodings
+        enum class CoreSort : uint8_t
+        {
+            Func = 0x00,
+            Table = 0x01,
+            Memory = 0x02,
+            Global = 0x03,
+            Type = 0x10,
+            Module = 0x11,
+            Instance = 0x12
+        };
+
+        // Component-level sorts, with their binary encodings
+        enum class Sort : uint8_t
+        {
+            Core = 0x00,
+            Func = 0x01,
+            Value = 0x02,
+            Type = 0x03,
+            Component = 0x04,
+            Instance = 0x05
+        };
+
+        struct CoreSortIndex
+        {
+            CoreSort sort;
+            uint32_t index;
+        };
+
+        struct SortIndex
+        {
+            Sort sort;
+            CoreSort core_sort; // Sort::Core only
+            uint32_t index;
+        };
+
+        // Options of a canon lift or lower
+        struct CanonOptions
+        {
+            static constexpr uint32_t NONE = 0xFFFFFFFF;
+
+            StringEncoding encoding = StringEncoding::Utf8;
+            uint32_t memory = NONE;      // Core memory index
+            uint32_t realloc = NONE;     // Core function index
+            uint32_t post_return = NONE; // Core function index
+        };
+
+        // One core instance of a component
+        struct CoreInstanceDefinition
+        {
+            enum class Kind : uint8_t
+            {
+                Instantiate, // module instantiated with named argument instances
+                Exports      // a bundle of existing core items
+            };
+
+            Kind kind;
+            uint32_t module = 0;
+            std::vector<std::pair<std::string, uint32_t>> args;         // Import module name, core instance
+            std::vector<std::pair<std::string, CoreSortIndex>> exports; // Exports only
+        };
+
+        // An entry of the core func, table, memory or global index space
+        struct CoreItemDefinition
+        {
+            enum class Kind : uint8_t
+            {
+                Alias,   // export name of core instance
+                Lower,   // canon lower of component function
+                Resource // resource.new/drop/rep builtin; not supported by the flattener
+            };
+
+            Kind kind;
+            uint32_t instance = 0;
+            std::string name;
+            uint32_t function = 0;
+            CanonOptions options;
+        };
+
+        // An entry of the component function index space
+        struct FunctionDefinition
+        {
+            enum class Kind : uint8_t
+            {
+                Import, // imports[import]
+                Alias,  // export name of component instance
+                Lift    // canon lift of core function
+            };
+
+            Kind kind;
+            uint32_t import = 0;
+            uint32_t instance = 0;
+            std::string name;
+            uint32_t core_function = 0;
+            CanonOptions options;
+            uint32_t type = 0; // Import, Lift: function type
+        };
+
+        // An entry of the component instance index space
+        struct InstanceDefinition
+        {
+            enum class Kind : uint8_t
+            {
+                Import,     // imports[import]
+                Exports,    // a bundle of existing items
+                Instantiate // of a nested component; not supported by the flattener
+            };
+
+            Kind kind;
+            uint32_t import = 0;
+            uint32_t type = 0; // Import: instance type
+            std::vector<std::pair<std::string, SortIndex>> exports; // Exports only
+        };
+
+        // An entry of the component type index space
+        //
+        // Only what flattening needs is kept: value types, function types
+        // and the functions an instance type exports.
+        struct TypeDefinition
+        {
+            enum class Kind : uint8_t
+            {
+                Value,
+                Function,
+                Instance,
+                Resource,
+                Other // Component types and other declarations
+            };
+
+            Kind kind;
+            InterfaceType value;
+            FunctionType function;
+            std::vector<std::pair<std::string, FunctionType>> functions; // Instance: exported functions
+        };
+
+        struct ImportDefinition
+        {
+            std::string name;
+            SortIndex item; // Index of the imported item in its sort's space
+        };
+
+        struct ExportDefinition
+        {
+            std::string name;
+            SortIndex item;
+        };
+
+        // Outline of a component binary
+        //
+        // Decodes the sections that describe how a component is wired
+        // together: its core modules (kept as byte ranges), core instances,
+        // aliases, canon definitions, types, imports and exports, with every
+        // index space in definition order. Nested components and component
+        // start functions are rejected.
+        class ComponentBinary
+        {
+        public:
+            static wasm::Result<ComponentBinary> parse(std::vector<uint8_t> bytes);
+            static bool is_component(wasm::span<const uint8_t> bytes);
+
+            size_t core_module_count() const { return core_modules_.size(); }
+            wasm::span<const uint8_t> core_module(uint32_t index) const
+            {
+                return wasm::span<const uint8_t>(bytes_.data() + core_modules_[index].first, core_modules_[index].second);
+            }
+
+            std::vector<CoreInstanceDefinition> core_instances;
+            std::vector<CoreItemDefinition> core_functions;
+            std::vector<CoreItemDefinition> core_tables;
+            std::vector<CoreItemDefinition> core_memories;
+            std::vector<CoreItemDefinition> core_globals;
+            std::vector<FunctionDefinition> functions;
+            std::vector<InstanceDefinition> instances;
+            std::vector<TypeDefinition> types;
+            std::vector<ImportDefinition> imports;
+            std::vector<ExportDefinition> exports;
+
+        private:
+            friend class ComponentReader;
+
+            std::vector<uint8_t> bytes_;
+            std::vector<std::pair<size_t, size_t>> core_modules_; // Offset and size within bytes_
+        };
+
+    } // namespace component
+} // namespace flight
+
+#endif // FLIGHT_COMPONENT_COMPONENT_BINARY_HPP
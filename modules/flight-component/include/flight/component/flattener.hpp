@@ -0,0 +1,85 @@
+#ifndef FLIGHT_COMPONENT_FLATTENER_HPP
+#define FLIGHT_COMPONENT_FLATTENER_HPP
+
+#include <flight/component/component_binary.hpp>
+#include <flight/component/memory_layout.hpp>
+#include <flight/wasm/types/modules.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace flight
+{
+    namespace component
+    {
+
+        struct FlattenOptions
+        {
+            PlatformProfile platform; // Capacity, alignment and guard gaps of the segments
+
+            // Trap on loads, stores and bulk memory operations outside the
+            // component's own segment. Without them a component can read
+            // and write every other component's memory.
+            bool bounds_checks = true;
+        };
+
+        struct FlattenResult
+        {
+            wasm::Module module;
+            MemoryLayout layout;          // Segment map, in instantiation order
+            uint32_t direct_imports = 0;  // Cross-component imports fused into direct calls
+            uint32_t adapted_imports = 0; // Imports left to a canonical ABI adapter
+            uint32_t host_imports = 0;    // Imports no component provides
+        };
+
+        // Fuses a graph of components into one core module
+        //
+        // Components are instantiated in dependency order: an import is
+        // provided by the component exporting that name (a function, or
+        // "interface#function" of an exported instance), and every other
+        // import is left to the host. Function, table, global, data and
+        // element index spaces are concatenated; each core memory becomes a
+        // segment of the single flattened memory, placed by a LayoutPlanner
+        // for the target platform, with loads, stores, bulk memory
+        // operations, data segments and memory.size/grow rebased onto it.
+        // The segments share one memory, so isolation between components
+        // rests on the bounds checks emitted before every rebased access
+        // (FlattenOptions::bounds_checks): each compares the address with
+        // the segment's current size, a global, and traps past it.
+        //
+        // Lowered imports whose signatures are made of 32/64-bit integers
+        // and floats in records and tuples, flatten to the same core type on
+        // both sides and need no post-return become direct calls. The rest
+        // are imported from module "flight:adapter" as
+        // "<caller>/<import name>", for the host to marshal through the
+        // canonical ABI against the exported lifted function, the callee's
+        // "flight:realloc/<component>" export and the
+        // "flight:segment/<component>/<n>" base addresses.
+        //
+        // Nested components, component start functions, resource builtins,
+        // multiple memories per instance and SIMD are rejected.
+        class Flattener
+        {
+        public:
+            explicit Flattener(FlattenOptions options = FlattenOptions()) : options_(options) {}
+
+            void add(std::string name, ComponentBinary component);
+
+            wasm::Result<FlattenResult> flatten() const;
+
+        private:
+            struct Input
+            {
+                std::string name;
+                ComponentBinary binary;
+            };
+
+            FlattenOptions options_;
+            std::vector<Input> components_;
+        };
+
+    } // namespace component
+} // namespace flight
+
+#endif // FLIGHT_COMPONENT_FLATTENER_HPP
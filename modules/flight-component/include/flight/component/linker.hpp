@@ -0,0 +1,238 @@
+#ifndef FLIGHT_COMPONENT_LINKER_HPP
+#define FLIGHT_COMPONENT_LINKER_HPP
+
+#include <flight/component/canonical_abi.hpp>
+#include <flight/component/resource_table.hpp>
+#include <flight/component/type_interner.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace flight
+{
+    namespace component
+    {
+
+        // Structural type equality: the names of record fields, variant
+        // cases, enum cases and flags matter, type names do not. Walks both
+        // trees; links intern types with TypeInterner instead, which also
+        // accepts enums and flags extended with new cases
+        bool same_type(const InterfaceType &a, const InterfaceType &b);
+        bool same_signature(const FunctionType &a, const FunctionType &b);
+
+        // Calling convention of linked functions
+        //
+        // Arguments and results travel in one array of 64-bit slots, each
+        // holding one flattened core value; results overwrite the arguments
+        // from slot 0. A parameter list whose values cannot be copied
+        // verbatim (strings, lists, handles, ...) is passed indirectly: slot
+        // 0 holds the offset of the parameter tuple in the caller's memory.
+        // Results of that kind are returned the same way, as the offset of
+        // the result tuple in the callee's memory.
+        using CoreFunction = wasm::Result<void> (*)(void *instance, uint64_t *slots);
+
+        // A host implementation of an import; memory is the caller's
+        using HostFunction = wasm::Result<void> (*)(void *context, GuestMemory &memory, uint64_t *slots);
+
+        struct ComponentImport
+        {
+            std::string name; // "namespace:package/interface#function"
+            FunctionType type;
+        };
+
+        struct ComponentExport
+        {
+            std::string name;
+            FunctionType type;
+            CoreFunction function;
+        };
+
+        // Link-time description of a component
+        struct ComponentDefinition
+        {
+            std::string name;
+            std::vector<ComponentImport> imports;
+            std::vector<ComponentExport> exports;
+        };
+
+        // Marshalling between two instances for one function signature
+        //
+        // Signatures that compile to the same plans share one adapter, and
+        // with it the plans, across imports, graphs and instances.
+        struct Adapter
+        {
+            std::shared_ptr<const MarshalPlan> params;  // Parameter tuple
+            std::shared_ptr<const MarshalPlan> results; // Result tuple
+            bool indirect_params;
+            bool indirect_results;
+
+            // Verbatim slots: calls need no adapter at all
+            bool direct() const { return !indirect_params && !indirect_results; }
+        };
+
+        class AdapterCache
+        {
+        public:
+            explicit AdapterCache(CanonicalABI &abi) : abi_(abi) {}
+
+            // Adapter for a signature; cached, and safe to call from any thread
+            std::shared_ptr<const Adapter> adapter(const FunctionType &type);
+
+            size_t size() const;
+
+        private:
+            CanonicalABI &abi_;
+            mutable std::mutex mutex_;
+            std::map<std::pair<const MarshalPlan *, const MarshalPlan *>, std::shared_ptr<const Adapter>> adapters_;
+        };
+
+        // What an instance of one component is made of at run time
+        struct InstanceBinding
+        {
+            void *instance = nullptr;            // Passed to the component's CoreFunctions
+            GuestMemory *memory = nullptr;       // Shared by every instance of a flattened graph
+            ResourceTable *resources = nullptr;  // nullptr passes handles through unchanged
+            AsyncInstance *async = nullptr;      // nullptr passes stream and future handles through unchanged
+        };
+
+        struct ResolvedImport;
+
+        // Entry point chosen for an import at link time
+        using CallThunk = wasm::Result<void> (*)(const ResolvedImport &import, const InstanceBinding *instances,
+                                                 uint32_t caller, uint64_t *slots);
+
+        enum class ImportTarget : uint8_t
+        {
+            Core,   // Another instance's export, called directly
+            Host,   // A host function, through a trampoline
+            Adapter // Another instance's export, through an adapter
+        };
+
+        // An import bound to its target; independent of any instantiation
+        struct ResolvedImport
+        {
+            CallThunk thunk;
+            ImportTarget target;
+            uint32_t callee;            // Exporting instance (Core, Adapter)
+            CoreFunction function;      // Core, Adapter
+            HostFunction host;          // Host
+            void *host_context;         // Host
+            const Adapter *adapter;     // Adapter
+        };
+
+        class LinkedInstance;
+
+        // The resolved import graph of a set of components
+        //
+        // Every import is bound to a thunk once, when the graph is linked, so
+        // calls neither look up names nor compare types. The graph holds no
+        // per-instance state; instantiating it only copies the bindings of
+        // its instances.
+        class LinkedGraph : public std::enable_shared_from_this<LinkedGraph>
+        {
+        public:
+            size_t component_count() const { return components_.size(); }
+            const ComponentDefinition &component(uint32_t index) const { return *components_[index]; }
+
+            const ResolvedImport &import(uint32_t component, uint32_t index) const
+            {
+                return imports_[import_offsets_[component] + index];
+            }
+
+            // Index lookups for binding guest code to the graph; not for calls
+            wasm::Result<uint32_t> component_index(const std::string &name) const;
+            wasm::Result<uint32_t> import_index(uint32_t component, const std::string &name) const;
+            wasm::Result<uint32_t> export_index(uint32_t component, const std::string &name) const;
+
+            // One binding per component, in link order
+            wasm::Result<LinkedInstance> instantiate(const std::vector<InstanceBinding> &bindings) const;
+
+        private:
+            friend class Linker;
+
+            std::vector<std::shared_ptr<const ComponentDefinition>> components_;
+            std::vector<std::shared_ptr<const Adapter>> adapters_; // Keeps the thunks' adapters alive
+            std::vector<ResolvedImport> imports_;
+            std::vector<uint32_t> import_offsets_;
+        };
+
+        // One instantiation of a LinkedGraph
+        class LinkedInstance
+        {
+        public:
+            LinkedInstance(std::shared_ptr<const LinkedGraph> graph, std::vector<InstanceBinding> bindings)
+                : graph_(std::move(graph)), bindings_(std::move(bindings))
+            {
+            }
+
+            const LinkedGraph &graph() const { return *graph_; }
+            const InstanceBinding &binding(uint32_t component) const { return bindings_[component]; }
+
+            // Calls import index of component through its thunk
+            wasm::Result<void> call_import(uint32_t component, uint32_t index, uint64_t *slots) const
+            {
+                const ResolvedImport &import = graph_->import(component, index);
+                return import.thunk(import, bindings_.data(), component, slots);
+            }
+
+            // Calls an export of component from the host
+            wasm::Result<void> call_export(uint32_t component, uint32_t index, uint64_t *slots) const
+            {
+                return graph_->component(component).exports[index].function(bindings_[component].instance, slots);
+            }
+
+        private:
+            std::shared_ptr<const LinkedGraph> graph_;
+            std::vector<InstanceBinding> bindings_;
+        };
+
+        // Builds LinkedGraphs
+        //
+        // Components are added in instantiation order. An import resolves
+        // to the most recently added earlier component exporting its name,
+        // otherwise to a host function of that name, and fails to link if
+        // neither exists or the types differ. Imports whose arguments and
+        // results are copied verbatim call the export directly; all others
+        // go through a shared adapter.
+        class Linker
+        {
+        public:
+            explicit Linker(AdapterCache &adapters) : adapters_(adapters) {}
+
+            wasm::Result<void> define_host(const std::string &name, const FunctionType &type,
+                                           HostFunction function, void *context = nullptr);
+
+            // Returns the component's index in the linked graph
+            uint32_t add(std::shared_ptr<const ComponentDefinition> component);
+
+            wasm::Result<std::shared_ptr<const LinkedGraph>> link() const;
+
+        private:
+            struct HostDefinition
+            {
+                FunctionType type;
+                Signature signature;
+                HostFunction function;
+                void *context;
+            };
+
+            AdapterCache &adapters_;
+            std::map<std::string, HostDefinition> hosts_;
+            std::vector<std::shared_ptr<const ComponentDefinition>> components_;
+
+            // Types are interned as they are added, so link() type-checks
+            // each import by comparing IDs; mutable for the subtype memo
+            mutable TypeInterner types_;
+            std::vector<Signature> signatures_;      // Each component's imports, then its exports
+            std::vector<uint32_t> signature_offsets_; // First signature of each component
+        };
+
+    } // namespace component
+} // namespace flight
+
+#endif // FLIGHT_COMPONENT_LINKER_HPP
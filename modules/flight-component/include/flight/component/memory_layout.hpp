@@ -0,0 +1,155 @@
+#ifndef FLIGHT_COMPONENT_MEMORY_LAYOUT_HPP
+#define FLIGHT_COMPONENT_MEMORY_LAYOUT_HPP
+
+#include <flight/wasm/types/modules.hpp>
+#include <flight/wasm/utilities/error.hpp>
+#include <flight/wasm/utilities/platform.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace flight
+{
+    namespace component
+    {
+
+        // Memory constraints of the platform a flattened memory targets
+        struct PlatformProfile
+        {
+            const char *name = "desktop";
+            uint64_t capacity = 65536ull * 65536; // Bytes the flattened memory may span
+            uint32_t alignment = 65536;           // Segment base alignment, a power of two
+            uint32_t guard_bytes = 65536;         // Gap left between segments
+            uint32_t default_reserve_pages = 16;  // Reserve of memories without a maximum
+
+            static PlatformProfile dreamcast();
+            static PlatformProfile psp();
+            static PlatformProfile vita();
+            static PlatformProfile desktop();
+
+            static PlatformProfile of(wasm::platform::Platform platform);
+            static PlatformProfile current() { return of(wasm::platform::current_platform()); }
+
+            // Looks a profile up by name: dreamcast, psp, vita or desktop
+            static bool named(const std::string &name, PlatformProfile &profile);
+        };
+
+        // Where a component instance's memory lives in the flattened memory
+        struct MemorySegment
+        {
+            std::string component;
+            uint32_t base;           // First byte of the segment
+            uint32_t initial_pages;  // Declared minimum
+            uint32_t reserved_pages; // Declared maximum, or the default reserve
+        };
+
+        // A planned segment map and its relocation table
+        //
+        // Segments never overlap: each reserve is followed by the profile's
+        // guard gap, and bases are aligned to the profile's alignment only,
+        // not to 64 KiB pages, so small components cost their reserve plus
+        // a few KiB instead of whole pages. The flattened memory is rounded
+        // up to pages once, at its end.
+        //
+        // The relocation table keeps bases, current sizes and reserve ends
+        // in flat arrays for hosts checking and translating guest pointers
+        // at run time; set_pages() mirrors a segment's memory.grow.
+        class MemoryLayout
+        {
+        public:
+            static constexpr uint32_t NONE = 0xFFFFFFFF;
+            static constexpr uint64_t PAGE_SIZE = 65536;
+
+            const std::vector<MemorySegment> &segments() const { return segments_; }
+            size_t size() const { return segments_.size(); }
+            const PlatformProfile &profile() const { return profile_; }
+
+            // Whether [offset, offset + length) lies within the segment's current size
+            bool contains(uint32_t segment, uint32_t offset, uint32_t length) const noexcept
+            {
+                const uint64_t size = sizes_[segment];
+                return offset <= size && length <= size - offset;
+            }
+
+            // Address of a segment offset in the flattened memory, unchecked
+            uint64_t translate(uint32_t segment, uint32_t offset) const noexcept
+            {
+                return static_cast<uint64_t>(bases_[segment]) + offset;
+            }
+
+            // Checked translation of a guest pointer and length
+            bool translate(uint32_t segment, uint32_t offset, uint32_t length, uint64_t &address) const noexcept
+            {
+                if (!contains(segment, offset, length))
+                {
+                    return false;
+                }
+                address = translate(segment, offset);
+                return true;
+            }
+
+            // The segment whose reserve holds address, NONE in guard gaps and padding
+            uint32_t segment_of(uint64_t address) const noexcept;
+
+            // Records a segment's new size after memory.grow; fails beyond its reserve
+            bool set_pages(uint32_t segment, uint32_t pages) noexcept;
+            uint32_t pages(uint32_t segment) const noexcept
+            {
+                return static_cast<uint32_t>(sizes_[segment] / PAGE_SIZE);
+            }
+
+            // Pages of the flattened memory: its minimum covers every
+            // segment's initial size, its maximum every reserve
+            uint32_t initial_pages() const { return initial_pages_; }
+            uint32_t maximum_pages() const { return maximum_pages_; }
+
+            // Bytes of the maximum memory outside any reserve: guard gaps,
+            // alignment padding and page rounding at the end
+            uint64_t overhead_bytes() const;
+
+        private:
+            friend class LayoutPlanner;
+
+            PlatformProfile profile_;
+            std::vector<MemorySegment> segments_;
+            std::vector<uint32_t> bases_;
+            std::vector<uint64_t> sizes_; // Current size, in bytes
+            std::vector<uint64_t> ends_;  // End of the reserve
+            uint32_t initial_pages_ = 0;
+            uint32_t maximum_pages_ = 0;
+        };
+
+        // Places component memories in one flattened memory
+        //
+        // Segments are placed in the order they are added, each at the
+        // first aligned address past the previous reserve and its guard
+        // gap. A memory with a maximum reserves it; one without reserves
+        // the larger of its minimum and the profile's default reserve.
+        class LayoutPlanner
+        {
+        public:
+            explicit LayoutPlanner(PlatformProfile profile = PlatformProfile()) : profile_(profile) {}
+
+            // Adds a memory and returns its segment index
+            uint32_t add(std::string component, const wasm::Limits &limits);
+
+            // Fails if the profile is malformed, a memory's limits are
+            // invalid or the reserves do not fit the profile's capacity
+            wasm::Result<MemoryLayout> plan() const;
+
+        private:
+            struct Request
+            {
+                std::string component;
+                wasm::Limits limits;
+            };
+
+            PlatformProfile profile_;
+            std::vector<Request> requests_;
+        };
+
+    } // namespace component
+} // namespace flight
+
+#endif // FLIGHT_COMPONENT_MEMORY_LAYOUT_HPP
@@ -0,0 +1,185 @@
+#ifndef FLIGHT_COMPONENT_RESOURCE_TABLE_HPP
+#define FLIGHT_COMPONENT_RESOURCE_TABLE_HPP
+
+#include <flight/component/component.hpp>
+#include <flight/wasm/utilities/error.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace flight
+{
+    namespace component
+    {
+
+        class ResourceTable;
+        class AsyncInstance;
+
+        // A resource type, defined by one component instance
+        //
+        // destroy receives the representations of dropped own handles;
+        // single drops pass one, instance teardown passes every remaining
+        // resource of the type in one call.
+        struct ResourceType
+        {
+            using Destructor = void (*)(void *context, const uint32_t *reps, size_t count);
+
+            Destructor destroy = nullptr; // nullptr for resources without a destructor
+            void *context = nullptr;
+        };
+
+        // Borrows made for one cross-instance call
+        //
+        // Lending an own handle to a callee pins it until the call returns,
+        // and every borrow handle the callee receives must be dropped before
+        // then. A CallScope lives on the caller's stack for the duration of
+        // the call; finish() traps on leaked borrows and unpins the lenders.
+        class CallScope
+        {
+        public:
+            CallScope() = default;
+            CallScope(const CallScope &) = delete;
+            CallScope &operator=(const CallScope &) = delete;
+            ~CallScope() { finish(); }
+
+            // Ends the call; fails if the callee still holds borrow handles,
+            // which traps the callee: its table may then only be torn down
+            wasm::Result<void> finish();
+
+            uint32_t live_borrows() const { return borrows_; }
+
+        private:
+            friend class ResourceTable;
+
+            struct Lender
+            {
+                ResourceTable *table;
+                uint32_t slot;
+                uint16_t generation; // Slot generation when lent
+            };
+
+            void add_lender(ResourceTable *table, uint32_t slot, uint16_t generation);
+            static void unpin(const Lender &lender);
+
+            // Calls rarely lend more than a few handles; no allocation until then
+            std::array<Lender, 4> lenders_{};
+            uint32_t lender_count_ = 0;
+            std::vector<Lender> more_lenders_;
+            uint32_t borrows_ = 0;
+        };
+
+        // Per-instance table of resource handles
+        //
+        // Handles index a dense slot vector: the low INDEX_BITS select the
+        // slot and the high bits carry the slot's generation, which is bumped
+        // whenever the slot is freed, so a stale handle fails its lookup
+        // instead of reaching a newer resource. A slot whose generation has
+        // run out is retired rather than reused, so no handle value is ever
+        // handed out twice; the table reports itself full only after about
+        // 2^32 handles. Freed slots are kept on an intrusive free list;
+        // creating, looking up and dropping a handle are O(1) with no
+        // hashing. Slot 0 is never used, so 0 is never a valid handle.
+        //
+        // Own handles are dropped through the type's destructor. Borrow
+        // handles belong to the CallScope that created them and only
+        // decrement its count when dropped. An own handle cannot be dropped
+        // or moved while it is lent to a call.
+        class ResourceTable
+        {
+        public:
+            static constexpr uint32_t INDEX_BITS = 22;
+            static constexpr uint32_t GENERATION_BITS = 32 - INDEX_BITS;
+            static constexpr uint32_t MAX_SLOTS = 1u << INDEX_BITS;
+
+            static constexpr uint32_t slot_of(uint32_t handle) { return handle & (MAX_SLOTS - 1); }
+            static constexpr uint32_t generation_of(uint32_t handle) { return handle >> INDEX_BITS; }
+
+            explicit ResourceTable(size_t reserve = 0);
+            ~ResourceTable();
+
+            ResourceTable(const ResourceTable &) = delete;
+            ResourceTable &operator=(const ResourceTable &) = delete;
+
+            // resource.new: a new own handle for rep
+            wasm::Result<uint32_t> create(const ResourceType &type, uint32_t rep);
+
+            // resource.rep
+            wasm::Result<uint32_t> rep(uint32_t handle, const ResourceType &type) const;
+
+            // resource.drop: runs the destructor for own handles
+            wasm::Result<void> drop(uint32_t handle, const ResourceType &type);
+
+            // Removes an own handle without destroying the resource, to move
+            // it into another instance
+            wasm::Result<uint32_t> take(uint32_t handle, const ResourceType &type);
+
+            // Pins an own or borrow handle for the duration of scope and
+            // returns its representation
+            wasm::Result<uint32_t> lend(uint32_t handle, const ResourceType &type, CallScope &scope);
+
+            // A borrow handle for rep, valid until it is dropped and at most
+            // until scope finishes
+            wasm::Result<uint32_t> borrow(const ResourceType &type, uint32_t rep, CallScope &scope);
+
+            // Type of a live handle, nullptr for stale or invalid ones
+            const ResourceType *type_of(uint32_t handle) const;
+
+            // Instance teardown: drops every handle, running each type's
+            // destructor once over all of its remaining resources. Borrow
+            // handles are discarded without touching their call scopes.
+            // Slots and their generations are kept, so old handles stay
+            // stale and call scopes that still pin a handle finish safely;
+            // the table itself must outlive those scopes.
+            void destroy_all();
+
+            size_t size() const { return live_; }
+            size_t capacity() const { return slots_.size(); }
+
+        private:
+            friend class CallScope;
+
+            static constexpr uint32_t NO_SLOT = 0;
+
+            struct Slot
+            {
+                const ResourceType *type; // nullptr when free
+                CallScope *scope;         // Borrow handles: the call they belong to
+                uint32_t rep;             // Next free slot when free
+                uint32_t lends;           // Calls the handle is lent to
+                uint16_t generation;
+                TypeKind kind;
+            };
+
+            const Slot *find(uint32_t handle) const;
+            Slot *find(uint32_t handle);
+            wasm::Result<uint32_t> insert(const ResourceType &type, uint32_t rep, TypeKind kind, CallScope *scope);
+            void release(uint32_t slot);
+
+            std::vector<Slot> slots_;
+            uint32_t free_head_ = NO_SLOT;
+            size_t live_ = 0;
+        };
+
+        // Context of resource_translator(): handles move from source to
+        // destination, and borrows are scoped to the call. Tables left
+        // nullptr pass their handles through unchanged.
+        struct HandleTransfer
+        {
+            ResourceTable *source;
+            ResourceTable *destination;
+            CallScope *scope;
+            AsyncInstance *async_source = nullptr; // Streams and futures
+            AsyncInstance *async_destination = nullptr;
+        };
+
+        // HandleTranslator for CanonicalABI transfers between instances:
+        // own handles are moved, borrow handles are lent for the call, and
+        // the readable ends of streams and futures are moved
+        wasm::Result<uint32_t> resource_translator(void *context, TypeKind kind, uint32_t handle);
+
+    } // namespace component
+} // namespace flight
+
+#endif // FLIGHT_COMPONENT_RESOURCE_TABLE_HPP
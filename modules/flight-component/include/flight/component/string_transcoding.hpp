@@ -0,0 +1,73 @@
+#ifndef FLIGHT_COMPONENT_STRING_TRANSCODING_HPP
+#define FLIGHT_COMPONENT_STRING_TRANSCODING_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace flight
+{
+    namespace component
+    {
+
+        // Canonical ABI string-encoding option of a component instance
+        enum class StringEncoding : uint8_t
+        {
+            Utf8,       // len counts bytes
+            Utf16,      // len counts little-endian code units; ptr is 2-aligned
+            Latin1Utf16 // Latin-1 bytes, or UTF-16 when len carries UTF16_TAG
+        };
+
+        // Tag bit in a latin1+utf16 string length marking UTF-16 contents
+        constexpr uint32_t UTF16_TAG = 1u << 31;
+
+        // Longest string the canonical ABI can describe, in code units
+        constexpr uint32_t MAX_STRING_LENGTH = UTF16_TAG - 1;
+
+        // Returned by the length functions for input that does not validate
+        constexpr size_t INVALID_LENGTH = ~size_t(0);
+
+        // Validating transcoders between the canonical string encodings
+        //
+        // Transcoding is two passes over the input. A *_length_from_* call
+        // validates the input and predicts the output length in the same
+        // pass, so the destination is allocated exactly once; the matching
+        // convert_* call then writes it without checking again and returns
+        // the number of code units written. convert_* must only be given
+        // input that its length function accepted.
+        //
+        // UTF-16 buffers are in wasm (little-endian) byte order. Runs of
+        // ASCII are converted a vector at a time; with SSSE3, AVX2 or
+        // AArch64 NEON, UTF-8 validation and length prediction are
+        // vectorized for all input (the lookup algorithm of Keiser and
+        // Lemire). The instruction set is chosen at compile time.
+        namespace transcoding
+        {
+            // Name of the instruction set the transcoders were compiled for
+            const char *implementation();
+
+            bool is_ascii(const uint8_t *src, size_t length);
+            bool validate_utf8(const uint8_t *src, size_t length);
+            bool validate_utf16(const char16_t *src, size_t length);
+
+            // UTF-8 source
+            size_t utf16_length_from_utf8(const uint8_t *src, size_t length);
+            size_t latin1_length_from_utf8(const uint8_t *src, size_t length); // Invalid above U+00FF too
+            size_t convert_utf8_to_utf16(const uint8_t *src, size_t length, char16_t *dst);
+            size_t convert_utf8_to_latin1(const uint8_t *src, size_t length, uint8_t *dst);
+
+            // UTF-16 source
+            size_t utf8_length_from_utf16(const char16_t *src, size_t length);
+            bool utf16_fits_latin1(const char16_t *src, size_t length);
+            size_t convert_utf16_to_utf8(const char16_t *src, size_t length, uint8_t *dst);
+            size_t convert_utf16_to_latin1(const char16_t *src, size_t length, uint8_t *dst);
+
+            // Latin-1 source; every byte string is valid Latin-1
+            size_t utf8_length_from_latin1(const uint8_t *src, size_t length);
+            size_t convert_latin1_to_utf8(const uint8_t *src, size_t length, uint8_t *dst);
+            size_t convert_latin1_to_utf16(const uint8_t *src, size_t length, char16_t *dst);
+        } // namespace transcoding
+
+    } // namespace component
+} // namespace flight
+
+#endif // FLIGHT_COMPONENT_STRING_TRANSCODING_HPP
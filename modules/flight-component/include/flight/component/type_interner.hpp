@@ -0,0 +1,107 @@
+#ifndef FLIGHT_COMPONENT_TYPE_INTERNER_HPP
+#define FLIGHT_COMPONENT_TYPE_INTERNER_HPP
+
+#include <flight/component/component.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace flight
+{
+    namespace component
+    {
+
+        // Canonical ID of an interned type: two types are equal exactly
+        // when their IDs are, within one TypeInterner
+        using TypeId = uint32_t;
+
+        // Which differences between types an interner distinguishes
+        enum class TypeIdentity : uint8_t
+        {
+            Linking, // As same_type(): names of fields, cases and flags matter, type names do not
+            Layout   // Only what affects layout and marshalling: no names, enum and flags by count
+        };
+
+        // Parameter and result tuples of an interned function type
+        struct Signature
+        {
+            TypeId params;
+            TypeId results;
+
+            bool operator==(const Signature &other) const
+            {
+                return params == other.params && results == other.results;
+            }
+            bool operator!=(const Signature &other) const { return !(*this == other); }
+        };
+
+        // Hash-consing table of interface types
+        //
+        // Every type is stored once, as its kind and the IDs of its nested
+        // types, so interning a type costs one walk of its tree and no
+        // allocation once it has been seen; comparing interned types is
+        // an integer compare. Subtyping is decided on IDs and memoized, so
+        // deeply nested records shared by many signatures are checked once.
+        //
+        // Not thread-safe.
+        class TypeInterner
+        {
+        public:
+            explicit TypeInterner(TypeIdentity identity = TypeIdentity::Linking);
+
+            TypeId intern(const InterfaceType &type);
+            Signature intern(const FunctionType &type);
+
+            // Whether a value of type a can be used where b is expected
+            // without conversion: equal types, and enums and flags
+            // extended with cases at the end while keeping their width,
+            // anywhere inside otherwise equal types
+            bool subtype(TypeId a, TypeId b);
+
+            // Whether target can be called through an import of type import:
+            // the import's parameters are subtypes of the target's and the
+            // target's results are subtypes of the import's
+            bool satisfies(const Signature &import, const Signature &target);
+
+            TypeKind kind(TypeId type) const { return static_cast<TypeKind>(words_[nodes_[type].offset]); }
+            size_t size() const { return nodes_.size(); }
+
+        private:
+            // A node's words: kind, nested type count, then per nested type
+            // its label (Linking identity, named kinds only) and ID
+            struct Node
+            {
+                uint32_t offset;
+                uint32_t length;
+                uint64_t hash;
+            };
+
+            TypeId intern_children(TypeKind kind, const std::vector<InterfaceType> &params);
+            TypeId intern_node(size_t start);
+            bool check_subtype(TypeId a, TypeId b);
+            uint32_t label(const std::string &name);
+            bool labelled(TypeKind kind) const;
+            void grow();
+            void grow_labels();
+
+            static constexpr TypeId NONE = UINT32_MAX;
+
+            TypeIdentity identity_;
+            TypeId leaves_[static_cast<size_t>(TypeKind::Future) + 1]; // Types without nested types, by kind
+            std::vector<uint32_t> words_;
+            std::vector<Node> nodes_;
+            std::vector<uint32_t> table_; // Open addressing; TypeId + 1, 0 when empty
+            std::vector<uint32_t> scratch_;
+            std::vector<std::string> labels_;
+            std::vector<uint64_t> label_hashes_;
+            std::vector<uint32_t> label_table_; // Open addressing; label + 1, 0 when empty
+            std::unordered_map<uint64_t, bool> subtypes_;
+        };
+
+    } // namespace component
+} // namespace flight
+
+#endif // FLIGHT_COMPONENT_TYPE_INTERNER_HPP
@@ -0,0 +1,731 @@
+#include <flight/component/async.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace flight
+{
+    namespace component
+    {
+
+        namespace
+        {
+            constexpr uint16_t GENERATION_MASK = (1u << AsyncInstance::GENERATION_BITS) - 1;
+            constexpr uint64_t MAX_RING_BYTES = 1ull << 30;
+
+            template <typename T>
+            wasm::Result<T> invalid_handle()
+            {
+                return wasm::make_error<T>(wasm::ErrorCode::InvalidTableIndex, "Invalid or stale async handle");
+            }
+        } // namespace
+
+        // =====================================================================
+        // RingBuffer
+        // =====================================================================
+
+        RingBuffer::RingBuffer(uint32_t element_size, uint32_t capacity) : element_size_(element_size)
+        {
+            uint32_t rounded = 1;
+            while (rounded < capacity)
+            {
+                rounded <<= 1;
+            }
+            mask_ = rounded - 1;
+            bytes_.resize(static_cast<size_t>(element_size) * rounded);
+        }
+
+        uint32_t RingBuffer::push(const uint8_t *elements, uint32_t count)
+        {
+            const uint32_t n = std::min(count, available());
+            if (n != 0 && element_size_ != 0)
+            {
+                const uint32_t start = tail_ & mask_;
+                const uint32_t first = std::min(n, capacity() - start);
+                std::memcpy(bytes_.data() + static_cast<size_t>(start) * element_size_, elements,
+                            static_cast<size_t>(first) * element_size_);
+                std::memcpy(bytes_.data(), elements + static_cast<size_t>(first) * element_size_,
+                            static_cast<size_t>(n - first) * element_size_);
+            }
+            tail_ += n;
+            return n;
+        }
+
+        uint32_t RingBuffer::pop(uint8_t *elements, uint32_t count)
+        {
+            const uint32_t n = std::min(count, size());
+            if (n != 0 && element_size_ != 0)
+            {
+                const uint32_t start = head_ & mask_;
+                const uint32_t first = std::min(n, capacity() - start);
+                std::memcpy(elements, bytes_.data() + static_cast<size_t>(start) * element_size_,
+                            static_cast<size_t>(first) * element_size_);
+                std::memcpy(elements + static_cast<size_t>(first) * element_size_, bytes_.data(),
+                            static_cast<size_t>(n - first) * element_size_);
+            }
+            head_ += n;
+            return n;
+        }
+
+        // =====================================================================
+        // Executor
+        // =====================================================================
+
+        wasm::Result<size_t> Executor::run()
+        {
+            size_t calls = 0;
+            for (;;)
+            {
+                auto resumed = run_one();
+                if (!resumed)
+                {
+                    return wasm::make_error<size_t>(resumed.error());
+                }
+                if (!resumed.value())
+                {
+                    return calls;
+                }
+                ++calls;
+            }
+        }
+
+        wasm::Result<bool> Executor::run_one()
+        {
+            if (ready_.empty())
+            {
+                return false;
+            }
+            const Ready next = ready_.front();
+            ready_.pop_front();
+            const Task task = tasks_[next.task];
+
+            auto code = task.callback(task.context, next.event);
+            if (!tasks_[next.task].instance)
+            {
+                return true; // The callback tore its instance down
+            }
+            if (!code)
+            {
+                end_task(next.task);
+                return wasm::make_error<bool>(code.error());
+            }
+
+            switch (static_cast<CallbackCode>(code.value() & 0xF))
+            {
+            case CallbackCode::Exit:
+                end_task(next.task);
+                return true;
+            case CallbackCode::Yield:
+                ready_.push_back(Ready{next.task, Event()});
+                return true;
+            case CallbackCode::Wait:
+            {
+                const AsyncInstance::Slot *slot = task.instance->find(code.value() >> 4);
+                if (!slot || slot->kind != AsyncInstance::Kind::WaitableSet)
+                {
+                    end_task(next.task);
+                    return wasm::make_error<bool>(wasm::ErrorCode::InvalidTableIndex,
+                                                  "Task waits on an invalid waitable set");
+                }
+                WaitableSet &set = sets_[slot->index];
+                if (set.waiter != NONE)
+                {
+                    end_task(next.task);
+                    return wasm::make_error<bool>(wasm::ErrorCode::InstructionSequenceError,
+                                                  "Waitable set already has a waiting task");
+                }
+                if (set.events.empty())
+                {
+                    set.waiter = next.task;
+                }
+                else
+                {
+                    ready_.push_back(Ready{next.task, set.events.front()});
+                    set.events.pop_front();
+                }
+                return true;
+            }
+            }
+            end_task(next.task);
+            return wasm::make_error<bool>(wasm::ErrorCode::InvalidImmediate, "Invalid task callback code");
+        }
+
+        uint32_t Executor::open_channel(AsyncInstance &owner, uint32_t element_size, uint32_t alignment,
+                                        uint32_t capacity, bool future)
+        {
+            uint32_t index;
+            if (free_channels_.empty())
+            {
+                index = static_cast<uint32_t>(channels_.size());
+                channels_.emplace_back();
+            }
+            else
+            {
+                index = free_channels_.back();
+                free_channels_.pop_back();
+            }
+            const End end{&owner, 0, NONE, true, false, false, 0, 0, 0, Event()};
+            channels_[index] = Channel{RingBuffer(element_size, capacity), element_size, alignment, future,
+                                       false, false, end, end};
+            ++live_channels_;
+            return index;
+        }
+
+        void Executor::close_end(uint32_t channel, bool reader)
+        {
+            Channel &state = channels_[channel];
+            End &end = reader ? state.reader : state.writer;
+            end.owner = nullptr;
+            end.set = NONE;
+            end.open = false;
+            end.pending = false;
+            end.has_event = false;
+            if (reader)
+            {
+                state.ring.clear();
+            }
+            if (!state.reader.open && !state.writer.open)
+            {
+                state.ring = RingBuffer();
+                free_channels_.push_back(channel);
+                --live_channels_;
+                return;
+            }
+            pump(channel);
+        }
+
+        uint32_t Executor::open_set()
+        {
+            if (free_sets_.empty())
+            {
+                sets_.push_back(WaitableSet{{}, NONE});
+                return static_cast<uint32_t>(sets_.size() - 1);
+            }
+            const uint32_t index = free_sets_.back();
+            free_sets_.pop_back();
+            sets_[index].waiter = NONE;
+            return index;
+        }
+
+        void Executor::close_set(uint32_t set)
+        {
+            for (Channel &channel : channels_)
+            {
+                for (End *end : {&channel.reader, &channel.writer})
+                {
+                    if (end->set == set)
+                    {
+                        end->set = NONE;
+                    }
+                }
+            }
+            sets_[set].events.clear();
+            sets_[set].waiter = NONE;
+            free_sets_.push_back(set);
+        }
+
+        void Executor::join(End &end, uint32_t set)
+        {
+            end.set = set;
+            if (set != NONE && end.has_event)
+            {
+                end.has_event = false;
+                deliver(set, end.event);
+            }
+        }
+
+        void Executor::pump(uint32_t channel)
+        {
+            Channel &state = channels_[channel];
+            End &reader = state.reader;
+            End &writer = state.writer;
+            bool progress = true;
+            while (progress)
+            {
+                progress = false;
+                if (reader.pending)
+                {
+                    if (!state.ring.empty())
+                    {
+                        reader.done = state.ring.pop(reader.owner->memory_.base + reader.ptr, reader.count);
+                        complete(state, reader, true, CopyStatus::Completed);
+                        progress = true;
+                    }
+                    else if (!writer.open)
+                    {
+                        complete(state, reader, true, CopyStatus::Dropped);
+                    }
+                }
+                if (writer.pending)
+                {
+                    if (!reader.open)
+                    {
+                        complete(state, writer, false, CopyStatus::Dropped);
+                    }
+                    else if (!state.ring.full())
+                    {
+                        const uint32_t n = state.ring.push(writer.owner->memory_.base + writer.ptr, writer.count);
+                        writer.ptr += n * state.element_size;
+                        writer.count -= n;
+                        writer.done += n;
+                        if (writer.count == 0)
+                        {
+                            complete(state, writer, false, CopyStatus::Completed);
+                        }
+                        progress = n != 0;
+                    }
+                }
+            }
+        }
+
+        uint32_t Executor::start(uint32_t channel, End &end)
+        {
+            starting_ = &end;
+            pump(channel);
+            starting_ = nullptr;
+            return end.pending ? BLOCKED : started_result_;
+        }
+
+        void Executor::complete(Channel &channel, End &end, bool reader, CopyStatus status)
+        {
+            end.pending = false;
+            if (channel.future && status == CopyStatus::Completed)
+            {
+                (reader ? channel.consumed : channel.written) = true;
+            }
+            const uint32_t result = copy_result(end.done, status);
+            if (&end == starting_)
+            {
+                started_result_ = result;
+                return;
+            }
+
+            Event event;
+            event.code = channel.future ? (reader ? EventCode::FutureRead : EventCode::FutureWrite)
+                                        : (reader ? EventCode::StreamRead : EventCode::StreamWrite);
+            event.handle = end.handle;
+            event.payload = result;
+            if (end.set == NONE)
+            {
+                end.has_event = true;
+                end.event = event;
+                return;
+            }
+            deliver(end.set, event);
+        }
+
+        void Executor::deliver(uint32_t set, const Event &event)
+        {
+            WaitableSet &target = sets_[set];
+            if (target.waiter == NONE)
+            {
+                target.events.push_back(event);
+                return;
+            }
+            ready_.push_back(Ready{target.waiter, event});
+            target.waiter = NONE;
+        }
+
+        bool Executor::take_event(End &end, Event &event)
+        {
+            if (end.has_event)
+            {
+                end.has_event = false;
+                event = end.event;
+                return true;
+            }
+            if (end.set == NONE)
+            {
+                return false;
+            }
+            // The latest event of the end is its last copy's
+            std::deque<Event> &events = sets_[end.set].events;
+            for (auto it = events.rbegin(); it != events.rend(); ++it)
+            {
+                if (it->handle == end.handle)
+                {
+                    event = *it;
+                    events.erase(std::next(it).base());
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void Executor::spawn(AsyncInstance &instance, TaskCallback callback, void *context)
+        {
+            uint32_t index;
+            if (free_tasks_.empty())
+            {
+                index = static_cast<uint32_t>(tasks_.size());
+                tasks_.emplace_back();
+            }
+            else
+            {
+                index = free_tasks_.back();
+                free_tasks_.pop_back();
+            }
+            tasks_[index] = Task{&instance, callback, context};
+            ++live_tasks_;
+            ready_.push_back(Ready{index, Event()});
+        }
+
+        void Executor::end_task(uint32_t task)
+        {
+            tasks_[task].instance = nullptr;
+            free_tasks_.push_back(task);
+            --live_tasks_;
+        }
+
+        void Executor::forget(const AsyncInstance &instance)
+        {
+            std::vector<bool> ended(tasks_.size(), false);
+            for (uint32_t task = 0; task < tasks_.size(); ++task)
+            {
+                if (tasks_[task].instance == &instance)
+                {
+                    end_task(task);
+                    ended[task] = true;
+                }
+            }
+            ready_.erase(std::remove_if(ready_.begin(), ready_.end(),
+                                        [&](const Ready &ready) { return ended[ready.task]; }),
+                         ready_.end());
+        }
+
+        // =====================================================================
+        // AsyncInstance
+        // =====================================================================
+
+        AsyncInstance::AsyncInstance(Executor &executor, GuestMemory &memory) : executor_(executor), memory_(memory)
+        {
+            slots_.push_back(Slot{Kind::Free, 0, NO_SLOT}); // Slot 0 is never a handle
+        }
+
+        AsyncInstance::~AsyncInstance()
+        {
+            for (const Slot &slot : slots_)
+            {
+                if (slot.kind == Kind::WaitableSet)
+                {
+                    executor_.close_set(slot.index);
+                }
+            }
+            for (const Slot &slot : slots_)
+            {
+                if (slot.kind == Kind::Readable || slot.kind == Kind::Writable)
+                {
+                    executor_.close_end(slot.index, slot.kind == Kind::Readable);
+                }
+            }
+            executor_.forget(*this);
+        }
+
+        wasm::Result<uint32_t> AsyncInstance::insert(Kind kind, uint32_t index)
+        {
+            uint32_t slot = free_head_;
+            if (slot != NO_SLOT)
+            {
+                free_head_ = slots_[slot].index;
+            }
+            else
+            {
+                if (slots_.size() >= MAX_SLOTS)
+                {
+                    return wasm::make_error<uint32_t>(wasm::ErrorCode::OutOfMemory, "Async handle table is full");
+                }
+                slot = static_cast<uint32_t>(slots_.size());
+                slots_.push_back(Slot{Kind::Free, 0, NO_SLOT});
+            }
+            slots_[slot].kind = kind;
+            slots_[slot].index = index;
+            ++live_;
+            return slot | static_cast<uint32_t>(slots_[slot].generation) << INDEX_BITS;
+        }
+
+        const AsyncInstance::Slot *AsyncInstance::find(uint32_t handle) const
+        {
+            const uint32_t slot = handle & (MAX_SLOTS - 1);
+            if (slot == NO_SLOT || slot >= slots_.size())
+            {
+                return nullptr;
+            }
+            const Slot &entry = slots_[slot];
+            if (entry.kind == Kind::Free || entry.generation != handle >> INDEX_BITS)
+            {
+                return nullptr;
+            }
+            return &entry;
+        }
+
+        void AsyncInstance::release(uint32_t handle)
+        {
+            const uint32_t slot = handle & (MAX_SLOTS - 1);
+            Slot &entry = slots_[slot];
+            entry.kind = Kind::Free;
+            entry.generation = static_cast<uint16_t>((entry.generation + 1) & GENERATION_MASK);
+            entry.index = free_head_;
+            free_head_ = slot;
+            --live_;
+        }
+
+        wasm::Result<uint32_t> AsyncInstance::channel_of(uint32_t handle, bool &reader) const
+        {
+            const Slot *slot = find(handle);
+            if (!slot || (slot->kind != Kind::Readable && slot->kind != Kind::Writable))
+            {
+                return invalid_handle<uint32_t>();
+            }
+            reader = slot->kind == Kind::Readable;
+            return slot->index;
+        }
+
+        wasm::Result<std::pair<uint32_t, uint32_t>> AsyncInstance::open(const MarshalPlan &element, uint32_t capacity,
+                                                                        bool future)
+        {
+            using Ends = std::pair<uint32_t, uint32_t>;
+            if (!element.trivially_copyable())
+            {
+                return wasm::make_error<Ends>(wasm::ErrorCode::TypeMismatch,
+                                              "Stream and future elements must be plain data");
+            }
+            const TypeLayout &layout = element.layout();
+            if (capacity == 0 || capacity > (1u << 31) ||
+                static_cast<uint64_t>(layout.size) * capacity > MAX_RING_BYTES)
+            {
+                return wasm::make_error<Ends>(wasm::ErrorCode::InvalidMemorySize, "Invalid stream capacity");
+            }
+
+            const uint32_t channel = executor_.open_channel(*this, layout.size, layout.alignment, capacity, future);
+            auto readable = insert(Kind::Readable, channel);
+            auto writable = readable ? insert(Kind::Writable, channel) : readable;
+            if (!writable)
+            {
+                if (readable)
+                {
+                    release(readable.value());
+                }
+                executor_.close_end(channel, true);
+                executor_.close_end(channel, false);
+                return wasm::make_error<Ends>(writable.error());
+            }
+            Executor::Channel &state = executor_.channels_[channel];
+            state.reader.handle = readable.value();
+            state.writer.handle = writable.value();
+            return Ends(readable.value(), writable.value());
+        }
+
+        wasm::Result<std::pair<uint32_t, uint32_t>> AsyncInstance::stream_new(const MarshalPlan &element,
+                                                                              uint32_t capacity)
+        {
+            return open(element, capacity, false);
+        }
+
+        wasm::Result<std::pair<uint32_t, uint32_t>> AsyncInstance::future_new(const MarshalPlan &value)
+        {
+            return open(value, 1, true);
+        }
+
+        wasm::Result<uint32_t> AsyncInstance::copy(uint32_t handle, uint32_t ptr, uint32_t count, bool reader)
+        {
+            bool readable;
+            auto channel = channel_of(handle, readable);
+            if (!channel)
+            {
+                return channel;
+            }
+            if (readable != reader)
+            {
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::TypeMismatch, "Copy from the wrong end of a stream");
+            }
+            Executor::Channel &state = executor_.channels_[channel.value()];
+            Executor::End &end = reader ? state.reader : state.writer;
+            if (end.pending)
+            {
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::InstructionSequenceError,
+                                                  "Stream end already has a blocked copy");
+            }
+            if (state.future && (count != 1 || (reader ? state.consumed : state.written)))
+            {
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::InstructionSequenceError,
+                                                  "Futures copy one value once");
+            }
+            if (!memory_.contains(ptr, static_cast<uint64_t>(count) * state.element_size))
+            {
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::OutOfBounds, "Stream buffer out of bounds");
+            }
+            if (ptr & (state.alignment - 1))
+            {
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::InvalidAlignment, "Misaligned stream buffer");
+            }
+
+            end.pending = true;
+            end.has_event = false;
+            end.ptr = ptr;
+            end.count = count;
+            end.done = 0;
+            return executor_.start(channel.value(), end);
+        }
+
+        wasm::Result<uint32_t> AsyncInstance::read(uint32_t handle, uint32_t ptr, uint32_t count)
+        {
+            return copy(handle, ptr, count, true);
+        }
+
+        wasm::Result<uint32_t> AsyncInstance::write(uint32_t handle, uint32_t ptr, uint32_t count)
+        {
+            return copy(handle, ptr, count, false);
+        }
+
+        wasm::Result<uint32_t> AsyncInstance::cancel(uint32_t handle)
+        {
+            bool reader;
+            auto channel = channel_of(handle, reader);
+            if (!channel)
+            {
+                return channel;
+            }
+            Executor::Channel &state = executor_.channels_[channel.value()];
+            Executor::End &end = reader ? state.reader : state.writer;
+            if (!end.pending)
+            {
+                Event event;
+                if (executor_.take_event(end, event))
+                {
+                    return event.payload;
+                }
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::InstructionSequenceError,
+                                                  "No blocked copy to cancel");
+            }
+            end.pending = false;
+            return copy_result(end.done, CopyStatus::Cancelled);
+        }
+
+        wasm::Result<void> AsyncInstance::drop(uint32_t handle)
+        {
+            const Slot *slot = find(handle);
+            if (!slot)
+            {
+                return invalid_handle<void>();
+            }
+            const Kind kind = slot->kind;
+            const uint32_t index = slot->index;
+            if (kind == Kind::WaitableSet)
+            {
+                if (executor_.sets_[index].waiter != Executor::NONE)
+                {
+                    return wasm::make_error<void>(wasm::ErrorCode::InstructionSequenceError,
+                                                  "Waitable set has a waiting task");
+                }
+                release(handle);
+                executor_.close_set(index);
+                return wasm::Result<void>();
+            }
+
+            const Executor::Channel &state = executor_.channels_[index];
+            if ((kind == Kind::Readable ? state.reader : state.writer).pending)
+            {
+                return wasm::make_error<void>(wasm::ErrorCode::InstructionSequenceError,
+                                              "Stream end has a blocked copy");
+            }
+            release(handle);
+            executor_.close_end(index, kind == Kind::Readable);
+            return wasm::Result<void>();
+        }
+
+        wasm::Result<uint32_t> AsyncInstance::waitable_set_new()
+        {
+            const uint32_t set = executor_.open_set();
+            auto handle = insert(Kind::WaitableSet, set);
+            if (!handle)
+            {
+                executor_.close_set(set);
+            }
+            return handle;
+        }
+
+        wasm::Result<void> AsyncInstance::join(uint32_t waitable, uint32_t set)
+        {
+            bool reader;
+            auto channel = channel_of(waitable, reader);
+            if (!channel)
+            {
+                return wasm::Result<void>(channel.error());
+            }
+            uint32_t index = Executor::NONE;
+            if (set != 0)
+            {
+                const Slot *slot = find(set);
+                if (!slot || slot->kind != Kind::WaitableSet)
+                {
+                    return invalid_handle<void>();
+                }
+                index = slot->index;
+            }
+            Executor::Channel &state = executor_.channels_[channel.value()];
+            executor_.join(reader ? state.reader : state.writer, index);
+            return wasm::Result<void>();
+        }
+
+        wasm::Result<bool> AsyncInstance::poll(uint32_t set, Event &event)
+        {
+            const Slot *slot = find(set);
+            if (!slot || slot->kind != Kind::WaitableSet)
+            {
+                return invalid_handle<bool>();
+            }
+            std::deque<Event> &events = executor_.sets_[slot->index].events;
+            if (events.empty())
+            {
+                return false;
+            }
+            event = events.front();
+            events.pop_front();
+            return true;
+        }
+
+        void AsyncInstance::spawn(TaskCallback callback, void *context)
+        {
+            executor_.spawn(*this, callback, context);
+        }
+
+        wasm::Result<uint32_t> AsyncInstance::transfer(uint32_t handle, AsyncInstance &destination)
+        {
+            const Slot *slot = find(handle);
+            if (!slot)
+            {
+                return invalid_handle<uint32_t>();
+            }
+            if (slot->kind != Kind::Readable)
+            {
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::TypeMismatch,
+                                                  "Only readable ends can be transferred");
+            }
+            if (&destination.executor_ != &executor_)
+            {
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::InvalidTableIndex,
+                                                  "Stream ends cannot leave their executor");
+            }
+            const uint32_t channel = slot->index;
+            Executor::End &end = executor_.channels_[channel].reader;
+            if (end.pending)
+            {
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::InstructionSequenceError,
+                                                  "Stream end has a blocked copy");
+            }
+            auto moved = destination.insert(Kind::Readable, channel);
+            if (!moved)
+            {
+                return moved;
+            }
+            release(handle);
+            end.owner = &destination;
+            end.handle = moved.value();
+            end.set = Executor::NONE;
+            end.has_event = false;
+            return moved;
+        }
+
+    } // namespace component
+} // namespace flight
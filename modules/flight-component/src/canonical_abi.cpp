@@ -0,0 +1,916 @@
+#include <flight/component/canonical_abi.hpp>
+#include <flight/wasm/utilities/endian.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace flight
+{
+    namespace component
+    {
+
+        namespace
+        {
+            const InterfaceType EMPTY_TUPLE{TypeKind::Tuple, "", {}};
+
+            // Plan compilation temporaries of typical types fit one block
+            constexpr size_t PLAN_ARENA_BLOCK_SIZE = 4096;
+
+            constexpr uint32_t align_to(uint32_t offset, uint32_t alignment)
+            {
+                return (offset + alignment - 1) & ~(alignment - 1);
+            }
+
+            uint32_t load_u32(const uint8_t *bytes)
+            {
+                uint32_t value;
+                std::memcpy(&value, bytes, sizeof(value));
+                return wasm::endian::wasm_to_host(value);
+            }
+
+            void store_u32(uint8_t *bytes, uint32_t value)
+            {
+                value = wasm::endian::host_to_wasm(value);
+                std::memcpy(bytes, &value, sizeof(value));
+            }
+
+            uint32_t load_discriminant(const uint8_t *bytes, uint32_t width)
+            {
+                if (width == 1)
+                {
+                    return bytes[0];
+                }
+                if (width == 2)
+                {
+                    uint16_t value;
+                    std::memcpy(&value, bytes, sizeof(value));
+                    return wasm::endian::wasm_to_host(value);
+                }
+                return load_u32(bytes);
+            }
+
+            // Variant-like types as a list of case payloads
+            template <typename Cases>
+            void cases_of(const InterfaceType &type, Cases &cases)
+            {
+                cases.clear();
+                switch (type.kind)
+                {
+                case TypeKind::Option:
+                    cases.push_back(&EMPTY_TUPLE);
+                    cases.push_back(type.params.empty() ? &EMPTY_TUPLE : &type.params[0]);
+                    break;
+                case TypeKind::Result:
+                    cases.push_back(type.params.size() > 0 ? &type.params[0] : &EMPTY_TUPLE);
+                    cases.push_back(type.params.size() > 1 ? &type.params[1] : &EMPTY_TUPLE);
+                    break;
+                default:
+                    for (const InterfaceType &param : type.params)
+                    {
+                        cases.push_back(&param);
+                    }
+                    break;
+                }
+            }
+
+            struct VariantLayout
+            {
+                TypeLayout layout;
+                uint32_t discriminant_size;
+                uint32_t payload_offset;
+            };
+
+            template <typename Cases>
+            VariantLayout variant_layout(const Cases &cases)
+            {
+                VariantLayout result;
+                result.discriminant_size = discriminant_size(cases.size());
+                uint32_t payload_size = 0;
+                uint32_t payload_alignment = 1;
+                for (const InterfaceType *payload : cases)
+                {
+                    TypeLayout layout = layout_of(*payload);
+                    payload_size = std::max(payload_size, layout.size);
+                    payload_alignment = std::max(payload_alignment, layout.alignment);
+                }
+                const uint32_t alignment = std::max(result.discriminant_size, payload_alignment);
+                result.payload_offset = align_to(result.discriminant_size, payload_alignment);
+                result.layout = {align_to(result.payload_offset + payload_size, alignment), alignment};
+                return result;
+            }
+
+            wasm::ValueType join(wasm::ValueType a, wasm::ValueType b)
+            {
+                if (a == b)
+                {
+                    return a;
+                }
+                if ((a == wasm::ValueType::I32 && b == wasm::ValueType::F32) ||
+                    (a == wasm::ValueType::F32 && b == wasm::ValueType::I32))
+                {
+                    return wasm::ValueType::I32;
+                }
+                return wasm::ValueType::I64;
+            }
+
+            void flatten_into(const InterfaceType &type, std::vector<wasm::ValueType> &flat)
+            {
+                switch (type.kind)
+                {
+                case TypeKind::S64:
+                case TypeKind::U64:
+                    flat.push_back(wasm::ValueType::I64);
+                    break;
+                case TypeKind::Float32:
+                    flat.push_back(wasm::ValueType::F32);
+                    break;
+                case TypeKind::Float64:
+                    flat.push_back(wasm::ValueType::F64);
+                    break;
+                case TypeKind::String:
+                case TypeKind::List:
+                    flat.push_back(wasm::ValueType::I32);
+                    flat.push_back(wasm::ValueType::I32);
+                    break;
+                case TypeKind::Record:
+                case TypeKind::Tuple:
+                    for (const InterfaceType &field : type.params)
+                    {
+                        flatten_into(field, flat);
+                    }
+                    break;
+                case TypeKind::Flags:
+                    flat.insert(flat.end(), (type.params.size() + 31) / 32, wasm::ValueType::I32);
+                    break;
+                case TypeKind::Variant:
+                case TypeKind::Option:
+                case TypeKind::Result:
+                {
+                    std::vector<const InterfaceType *> cases;
+                    cases_of(type, cases);
+                    std::vector<wasm::ValueType> payload;
+                    for (const InterfaceType *c : cases)
+                    {
+                        std::vector<wasm::ValueType> case_flat;
+                        flatten_into(*c, case_flat);
+                        for (size_t i = 0; i < case_flat.size(); ++i)
+                        {
+                            if (i < payload.size())
+                            {
+                                payload[i] = join(payload[i], case_flat[i]);
+                            }
+                            else
+                            {
+                                payload.push_back(case_flat[i]);
+                            }
+                        }
+                    }
+                    flat.push_back(wasm::ValueType::I32);
+                    flat.insert(flat.end(), payload.begin(), payload.end());
+                    break;
+                }
+                default:
+                    flat.push_back(wasm::ValueType::I32);
+                    break;
+                }
+            }
+
+            enum class StringContent
+            {
+                Utf8,
+                Utf16,
+                Latin1
+            };
+
+            // A string as stored by one side of a call. Guest strings are
+            // addressed by offset so the bytes can be re-read after an
+            // allocation in the same memory.
+            struct StringSource
+            {
+                StringContent content;
+                const GuestMemory *memory; // nullptr for host strings
+                const uint8_t *host;
+                uint32_t ptr;
+                size_t units;
+
+                const uint8_t *bytes() const { return memory ? memory->base + ptr : host; }
+                const char16_t *utf16() const { return reinterpret_cast<const char16_t *>(bytes()); }
+            };
+
+            using StoredString = std::pair<uint32_t, uint32_t>;
+
+            wasm::Result<StringSource> guest_string(const GuestMemory &memory, uint32_t ptr, uint32_t length)
+            {
+                StringSource source{StringContent::Utf8, &memory, nullptr, ptr, length};
+                uint32_t alignment = 1;
+                switch (memory.string_encoding)
+                {
+                case StringEncoding::Utf8:
+                    break;
+                case StringEncoding::Utf16:
+                    source.content = StringContent::Utf16;
+                    alignment = 2;
+                    break;
+                case StringEncoding::Latin1Utf16:
+                    source.content = (length & UTF16_TAG) != 0 ? StringContent::Utf16 : StringContent::Latin1;
+                    source.units = length & ~UTF16_TAG;
+                    alignment = 2;
+                    break;
+                }
+                const uint64_t bytes = uint64_t(source.units) * (source.content == StringContent::Utf16 ? 2 : 1);
+                if (ptr % alignment != 0)
+                {
+                    return wasm::make_error<StringSource>(wasm::ErrorCode::InvalidAlignment, "Misaligned string pointer");
+                }
+                if (!memory.contains(ptr, bytes))
+                {
+                    return wasm::make_error<StringSource>(wasm::ErrorCode::OutOfBounds, "String out of bounds");
+                }
+                return source;
+            }
+
+            wasm::Result<StoredString> invalid_string(StringContent content)
+            {
+                return wasm::make_error<StoredString>(wasm::ErrorCode::InvalidUTF8Sequence,
+                                                      content == StringContent::Utf16 ? "Invalid UTF-16 string"
+                                                                                      : "Invalid UTF-8 string");
+            }
+
+            // Allocates units code units of unit_size bytes and lets write fill them
+            template <typename Write>
+            wasm::Result<StoredString> emit_string(GuestMemory &dst, size_t units, uint32_t unit_size,
+                                                   uint32_t alignment, uint32_t tag, Write write)
+            {
+                if (units > MAX_STRING_LENGTH)
+                {
+                    return wasm::make_error<StoredString>(wasm::ErrorCode::OutOfBounds, "String too long");
+                }
+                auto allocation = dst.allocate(static_cast<uint32_t>(units * unit_size), alignment);
+                if (!allocation)
+                {
+                    return wasm::make_error<StoredString>(allocation.error());
+                }
+                write(dst.base + allocation.value());
+                return StoredString{allocation.value(), static_cast<uint32_t>(units) | tag};
+            }
+
+            // Validates the source and writes it in the destination's
+            // encoding. Output lengths are predicted up front, so every
+            // string is allocated exactly once; latin1+utf16 destinations
+            // get Latin-1 whenever the text fits.
+            wasm::Result<StoredString> store_string(GuestMemory &dst, const StringSource &source)
+            {
+                using namespace transcoding;
+                const StringEncoding encoding = dst.string_encoding;
+                const bool latin1_utf16 = encoding == StringEncoding::Latin1Utf16;
+                const uint32_t tag = latin1_utf16 ? UTF16_TAG : 0;
+                const size_t units = source.units;
+
+                switch (source.content)
+                {
+                case StringContent::Utf8:
+                    if (latin1_utf16)
+                    {
+                        const size_t latin1 = latin1_length_from_utf8(source.bytes(), units);
+                        if (latin1 != INVALID_LENGTH)
+                        {
+                            return emit_string(dst, latin1, 1, 2, 0, [&](uint8_t *out)
+                                               { convert_utf8_to_latin1(source.bytes(), units, out); });
+                        }
+                    }
+                    if (encoding == StringEncoding::Utf8)
+                    {
+                        if (!validate_utf8(source.bytes(), units))
+                        {
+                            return invalid_string(source.content);
+                        }
+                        return emit_string(dst, units, 1, 1, 0, [&](uint8_t *out)
+                                           { std::memcpy(out, source.bytes(), units); });
+                    }
+                    else
+                    {
+                        const size_t utf16 = utf16_length_from_utf8(source.bytes(), units);
+                        if (utf16 == INVALID_LENGTH)
+                        {
+                            return invalid_string(source.content);
+                        }
+                        return emit_string(dst, utf16, 2, 2, tag, [&](uint8_t *out)
+                                           { convert_utf8_to_utf16(source.bytes(), units, reinterpret_cast<char16_t *>(out)); });
+                    }
+                case StringContent::Utf16:
+                    if (encoding == StringEncoding::Utf8)
+                    {
+                        const size_t utf8 = utf8_length_from_utf16(source.utf16(), units);
+                        if (utf8 == INVALID_LENGTH)
+                        {
+                            return invalid_string(source.content);
+                        }
+                        return emit_string(dst, utf8, 1, 1, 0, [&](uint8_t *out)
+                                           { convert_utf16_to_utf8(source.utf16(), units, out); });
+                    }
+                    if (!validate_utf16(source.utf16(), units))
+                    {
+                        return invalid_string(source.content);
+                    }
+                    if (latin1_utf16 && utf16_fits_latin1(source.utf16(), units))
+                    {
+                        return emit_string(dst, units, 1, 2, 0, [&](uint8_t *out)
+                                           { convert_utf16_to_latin1(source.utf16(), units, out); });
+                    }
+                    return emit_string(dst, units, 2, 2, tag, [&](uint8_t *out)
+                                       { std::memcpy(out, source.bytes(), units * 2); });
+                case StringContent::Latin1:
+                    if (encoding == StringEncoding::Utf8)
+                    {
+                        return emit_string(dst, utf8_length_from_latin1(source.bytes(), units), 1, 1, 0,
+                                           [&](uint8_t *out)
+                                           { convert_latin1_to_utf8(source.bytes(), units, out); });
+                    }
+                    if (latin1_utf16)
+                    {
+                        return emit_string(dst, units, 1, 2, 0, [&](uint8_t *out)
+                                           { std::memcpy(out, source.bytes(), units); });
+                    }
+                    return emit_string(dst, units, 2, 2, 0, [&](uint8_t *out)
+                                       { convert_latin1_to_utf16(source.bytes(), units, reinterpret_cast<char16_t *>(out)); });
+                }
+                return invalid_string(source.content);
+            }
+
+            // Executes a plan between two memories. Memory bases are re-read
+            // after every allocation because cabi_realloc may grow memory.
+            class Transfer
+            {
+            public:
+                Transfer(const MarshalPlan &plan, const GuestMemory &src, GuestMemory &dst,
+                         const TransferOptions &options)
+                    : plan_(plan), src_(src), dst_(dst), options_(options),
+                      borrowing_(options.borrows != nullptr && src.base == dst.base)
+                {
+                }
+
+                wasm::Result<void> run(uint32_t routine_index, uint32_t src_offset, uint32_t dst_offset)
+                {
+                    const MarshalRoutine &routine = plan_.routines()[routine_index];
+                    const Fixup *fixups = plan_.fixups().data() + routine.first_fixup;
+                    for (uint32_t i = 0; i < routine.fixup_count; ++i)
+                    {
+                        const Fixup &fixup = fixups[i];
+                        const uint32_t s = src_offset + fixup.offset;
+                        const uint32_t d = dst_offset + fixup.offset;
+                        wasm::Result<void> result;
+                        switch (fixup.op)
+                        {
+                        case FixupOp::Bool:
+                            dst_.base[d] = src_.base[s] != 0 ? 1 : 0;
+                            break;
+                        case FixupOp::Char:
+                        {
+                            const uint32_t c = load_u32(src_.base + s);
+                            if (c >= 0x110000 || (c >= 0xD800 && c < 0xE000))
+                            {
+                                return wasm::Result<void>(wasm::ErrorCode::TypeMismatch, "Invalid char value");
+                            }
+                            break;
+                        }
+                        case FixupOp::Discriminant:
+                            if (load_discriminant(src_.base + s, fixup.width) >= fixup.count)
+                            {
+                                return wasm::Result<void>(wasm::ErrorCode::TypeMismatch, "Invalid case index");
+                            }
+                            break;
+                        case FixupOp::String:
+                            result = borrowing_ && src_.string_encoding == dst_.string_encoding
+                                         ? borrow_string(s)
+                                         : copy_string(s, d);
+                            break;
+                        case FixupOp::List:
+                        {
+                            const MarshalRoutine &element = plan_.routines()[fixup.target];
+                            result = borrowing_ && element.fixup_count == 0
+                                         ? borrow_buffer(s, element.layout.size, element.layout.alignment)
+                                         : copy_buffer(s, d, element.layout.size, element.layout.alignment,
+                                                       fixup.target);
+                            break;
+                        }
+                        case FixupOp::Variant:
+                        {
+                            const uint32_t index = load_discriminant(src_.base + s, fixup.width);
+                            if (index >= fixup.count)
+                            {
+                                return wasm::Result<void>(wasm::ErrorCode::TypeMismatch, "Invalid case index");
+                            }
+                            const uint32_t case_routine = plan_.case_routines()[fixup.target + index];
+                            if (case_routine != MarshalPlan::NO_FIXUPS)
+                            {
+                                result = run(case_routine, src_offset + fixup.payload_offset,
+                                             dst_offset + fixup.payload_offset);
+                            }
+                            break;
+                        }
+                        case FixupOp::Handle:
+                            if (options_.translate_handle)
+                            {
+                                auto handle = options_.translate_handle(options_.handle_context, fixup.kind,
+                                                                        load_u32(src_.base + s));
+                                if (!handle)
+                                {
+                                    return wasm::Result<void>(handle.error());
+                                }
+                                store_u32(dst_.base + d, handle.value());
+                            }
+                            break;
+                        }
+                        if (!result)
+                        {
+                            return result;
+                        }
+                    }
+                    return wasm::Result<void>();
+                }
+
+            private:
+                // Transcodes the string at s into the destination and
+                // rewrites the pair at d
+                wasm::Result<void> copy_string(uint32_t s, uint32_t d)
+                {
+                    auto source = guest_string(src_, load_u32(src_.base + s), load_u32(src_.base + s + 4));
+                    if (!source)
+                    {
+                        return wasm::Result<void>(source.error());
+                    }
+                    auto stored = store_string(dst_, source.value());
+                    if (!stored)
+                    {
+                        return wasm::Result<void>(stored.error());
+                    }
+                    store_u32(dst_.base + d, stored.value().first);
+                    store_u32(dst_.base + d + 4, stored.value().second);
+                    return wasm::Result<void>();
+                }
+
+                // The (ptr, len) pair was copied with the value; lending the
+                // string only needs its bounds checked
+                wasm::Result<void> borrow_string(uint32_t s)
+                {
+                    const uint32_t length = load_u32(src_.base + s + 4);
+                    auto source = guest_string(src_, load_u32(src_.base + s), length);
+                    if (!source)
+                    {
+                        return wasm::Result<void>(source.error());
+                    }
+                    const StringSource &string = source.value();
+                    const uint32_t bytes =
+                        static_cast<uint32_t>(string.units * (string.content == StringContent::Utf16 ? 2 : 1));
+#if FLIGHT_COMPONENT_BORROW_CHECKS
+                    const bool valid = string.content == StringContent::Utf8
+                                           ? transcoding::validate_utf8(string.bytes(), string.units)
+                                       : string.content == StringContent::Utf16
+                                           ? transcoding::validate_utf16(string.utf16(), string.units)
+                                           : true;
+                    if (!valid)
+                    {
+                        return wasm::Result<void>(wasm::ErrorCode::InvalidUTF8Sequence, "Invalid borrowed string");
+                    }
+#endif
+                    options_.borrows->lend(src_, string.ptr, bytes);
+                    return wasm::Result<void>();
+                }
+
+                wasm::Result<void> borrow_buffer(uint32_t s, uint32_t element_size, uint32_t element_alignment)
+                {
+                    const uint32_t ptr = load_u32(src_.base + s);
+                    const uint64_t bytes = uint64_t(load_u32(src_.base + s + 4)) * element_size;
+                    if (ptr % element_alignment != 0)
+                    {
+                        return wasm::Result<void>(wasm::ErrorCode::InvalidAlignment, "Misaligned list pointer");
+                    }
+                    if (bytes > UINT32_MAX || !src_.contains(ptr, bytes))
+                    {
+                        return wasm::Result<void>(wasm::ErrorCode::OutOfBounds, "List out of bounds");
+                    }
+                    options_.borrows->lend(src_, ptr, static_cast<uint32_t>(bytes));
+                    return wasm::Result<void>();
+                }
+
+                // Copies the (ptr, len) buffer at s into a new allocation and
+                // rewrites the pair at d
+                wasm::Result<void> copy_buffer(uint32_t s, uint32_t d, uint32_t element_size,
+                                               uint32_t element_alignment, uint32_t element_routine)
+                {
+                    const uint32_t ptr = load_u32(src_.base + s);
+                    const uint32_t length = load_u32(src_.base + s + 4);
+                    const uint64_t bytes = uint64_t(length) * element_size;
+                    if (ptr % element_alignment != 0)
+                    {
+                        return wasm::Result<void>(wasm::ErrorCode::InvalidAlignment, "Misaligned list pointer");
+                    }
+                    if (bytes > UINT32_MAX || !src_.contains(ptr, bytes))
+                    {
+                        return wasm::Result<void>(wasm::ErrorCode::OutOfBounds, "List out of bounds");
+                    }
+
+                    auto allocation = dst_.allocate(static_cast<uint32_t>(bytes), element_alignment);
+                    if (!allocation)
+                    {
+                        return wasm::Result<void>(allocation.error());
+                    }
+                    const uint32_t new_ptr = allocation.value();
+                    std::memcpy(dst_.base + new_ptr, src_.base + ptr, static_cast<size_t>(bytes));
+
+                    if (element_routine != MarshalPlan::NO_FIXUPS &&
+                        plan_.routines()[element_routine].fixup_count != 0)
+                    {
+                        for (uint32_t i = 0; i < length; ++i)
+                        {
+                            auto result = run(element_routine, ptr + i * element_size, new_ptr + i * element_size);
+                            if (!result)
+                            {
+                                return result;
+                            }
+                        }
+                    }
+
+                    store_u32(dst_.base + d, new_ptr);
+                    store_u32(dst_.base + d + 4, length);
+                    return wasm::Result<void>();
+                }
+
+                const MarshalPlan &plan_;
+                const GuestMemory &src_;
+                GuestMemory &dst_;
+                const TransferOptions &options_;
+                const bool borrowing_;
+            };
+
+#if FLIGHT_COMPONENT_BORROW_CHECKS
+            // FNV-1a; only used to notice writes to lent buffers
+            uint64_t checksum(const uint8_t *bytes, size_t length)
+            {
+                uint64_t hash = 0xCBF29CE484222325ull;
+                for (size_t i = 0; i < length; ++i)
+                {
+                    hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+                }
+                return hash;
+            }
+#endif
+        } // namespace
+
+        TypeLayout layout_of(const InterfaceType &type)
+        {
+            switch (type.kind)
+            {
+            case TypeKind::Bool:
+            case TypeKind::S8:
+            case TypeKind::U8:
+                return {1, 1};
+            case TypeKind::S16:
+            case TypeKind::U16:
+                return {2, 2};
+            case TypeKind::S64:
+            case TypeKind::U64:
+            case TypeKind::Float64:
+                return {8, 8};
+            case TypeKind::String:
+            case TypeKind::List:
+                return {8, 4};
+            case TypeKind::Record:
+            case TypeKind::Tuple:
+            {
+                uint32_t size = 0;
+                uint32_t alignment = 1;
+                for (const InterfaceType &field : type.params)
+                {
+                    TypeLayout layout = layout_of(field);
+                    size = align_to(size, layout.alignment) + layout.size;
+                    alignment = std::max(alignment, layout.alignment);
+                }
+                return {align_to(size, alignment), alignment};
+            }
+            case TypeKind::Flags:
+            {
+                const size_t count = type.params.size();
+                if (count == 0)
+                {
+                    return {0, 1};
+                }
+                if (count <= 16)
+                {
+                    const uint32_t size = count <= 8 ? 1 : 2;
+                    return {size, size};
+                }
+                return {static_cast<uint32_t>(4 * ((count + 31) / 32)), 4};
+            }
+            case TypeKind::Enum:
+            {
+                const uint32_t size = discriminant_size(type.params.size());
+                return {size, size};
+            }
+            case TypeKind::Variant:
+            case TypeKind::Option:
+            case TypeKind::Result:
+            {
+                std::vector<const InterfaceType *> cases;
+                cases_of(type, cases);
+                return variant_layout(cases).layout;
+            }
+            default: // 32-bit scalars, char and resource handles
+                return {4, 4};
+            }
+        }
+
+        std::vector<wasm::ValueType> flatten(const InterfaceType &type)
+        {
+            std::vector<wasm::ValueType> flat;
+            flatten_into(type, flat);
+            return flat;
+        }
+
+        wasm::Result<uint32_t> GuestMemory::allocate(uint32_t length, uint32_t alignment)
+        {
+            if (length == 0)
+            {
+                return alignment; // Dangling but aligned, like an empty slice
+            }
+            if (!realloc)
+            {
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::OutOfMemory, "Memory has no realloc");
+            }
+            const uint32_t ptr = realloc(realloc_context, 0, 0, alignment, length);
+            if (ptr == 0)
+            {
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::OutOfMemory, "cabi_realloc failed");
+            }
+            if (ptr % alignment != 0)
+            {
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::InvalidAlignment, "Misaligned allocation");
+            }
+            if (!contains(ptr, length))
+            {
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::OutOfBounds, "Allocation out of bounds");
+            }
+            return ptr;
+        }
+
+        void BorrowScope::lend(const GuestMemory &memory, uint32_t ptr, uint32_t length)
+        {
+#if FLIGHT_COMPONENT_BORROW_CHECKS
+            loans_.push_back({ptr, length, checksum(memory.base + ptr, length)});
+#else
+            (void)memory;
+            (void)ptr;
+            (void)length;
+#endif
+            ++lent_;
+        }
+
+        wasm::Result<void> BorrowScope::release(const GuestMemory &memory)
+        {
+            wasm::Result<void> result;
+#if FLIGHT_COMPONENT_BORROW_CHECKS
+            for (const Loan &loan : loans_)
+            {
+                if (!memory.contains(loan.ptr, loan.length) ||
+                    checksum(memory.base + loan.ptr, loan.length) != loan.checksum)
+                {
+                    result = wasm::Result<void>(wasm::ErrorCode::MemoryAccessViolation, "Borrowed buffer modified during call");
+                    break;
+                }
+            }
+            loans_.clear();
+#else
+            (void)memory;
+#endif
+            lent_ = 0;
+            return result;
+        }
+
+        wasm::Result<std::string> lift_string(const GuestMemory &memory, uint32_t ptr, uint32_t length)
+        {
+            using namespace transcoding;
+            auto source = guest_string(memory, ptr, length);
+            if (!source)
+            {
+                return wasm::make_error<std::string>(source.error());
+            }
+            const StringSource &string = source.value();
+            switch (string.content)
+            {
+            case StringContent::Utf8:
+                if (!validate_utf8(string.bytes(), string.units))
+                {
+                    return wasm::make_error<std::string>(wasm::ErrorCode::InvalidUTF8Sequence, "Invalid UTF-8 string");
+                }
+                return std::string(reinterpret_cast<const char *>(string.bytes()), string.units);
+            case StringContent::Utf16:
+            {
+                const size_t utf8 = utf8_length_from_utf16(string.utf16(), string.units);
+                if (utf8 == INVALID_LENGTH)
+                {
+                    return wasm::make_error<std::string>(wasm::ErrorCode::InvalidUTF8Sequence, "Invalid UTF-16 string");
+                }
+                std::string value(utf8, '\0');
+                convert_utf16_to_utf8(string.utf16(), string.units, reinterpret_cast<uint8_t *>(&value[0]));
+                return value;
+            }
+            case StringContent::Latin1:
+                break;
+            }
+            std::string value(utf8_length_from_latin1(string.bytes(), string.units), '\0');
+            convert_latin1_to_utf8(string.bytes(), string.units, reinterpret_cast<uint8_t *>(&value[0]));
+            return value;
+        }
+
+        wasm::Result<std::pair<uint32_t, uint32_t>> lower_string(GuestMemory &memory, const char *data, size_t size)
+        {
+            const StringSource source{StringContent::Utf8, nullptr, reinterpret_cast<const uint8_t *>(data), 0, size};
+            return store_string(memory, source);
+        }
+
+        MarshalPlan::MarshalPlan(const InterfaceType &type)
+        {
+            memory::Arena arena(PLAN_ARENA_BLOCK_SIZE);
+            compile_routine(type, arena);
+        }
+
+        uint32_t MarshalPlan::compile_routine(const InterfaceType &type, memory::Arena &arena)
+        {
+            const uint32_t index = static_cast<uint32_t>(routines_.size());
+            routines_.push_back({layout_of(type), 0, 0});
+
+            // Nested routines append to fixups_ while this one is compiled;
+            // their temporaries are allocated and rewound above ours
+            memory::Arena::Scope scope(arena);
+            memory::ArenaVector<Fixup> fixups{memory::StlAllocator<Fixup>(arena)};
+            compile(type, 0, fixups, arena);
+            routines_[index].first_fixup = static_cast<uint32_t>(fixups_.size());
+            routines_[index].fixup_count = static_cast<uint32_t>(fixups.size());
+            fixups_.insert(fixups_.end(), fixups.begin(), fixups.end());
+            return index;
+        }
+
+        void MarshalPlan::compile(const InterfaceType &type, uint32_t offset, memory::ArenaVector<Fixup> &fixups,
+                                  memory::Arena &arena)
+        {
+            Fixup fixup{};
+            fixup.offset = offset;
+            switch (type.kind)
+            {
+            case TypeKind::Bool:
+                fixup.op = FixupOp::Bool;
+                fixups.push_back(fixup);
+                break;
+            case TypeKind::Char:
+                fixup.op = FixupOp::Char;
+                fixups.push_back(fixup);
+                break;
+            case TypeKind::Own:
+            case TypeKind::Borrow:
+            case TypeKind::Stream:
+            case TypeKind::Future:
+                fixup.op = FixupOp::Handle;
+                fixup.kind = type.kind;
+                fixups.push_back(fixup);
+                break;
+            case TypeKind::String:
+                fixup.op = FixupOp::String;
+                fixups.push_back(fixup);
+                break;
+            case TypeKind::List:
+                fixup.op = FixupOp::List;
+                fixup.target = compile_routine(type.params.empty() ? EMPTY_TUPLE : type.params[0], arena);
+                fixups.push_back(fixup);
+                break;
+            case TypeKind::Record:
+            case TypeKind::Tuple:
+            {
+                uint32_t field_offset = 0;
+                for (const InterfaceType &field : type.params)
+                {
+                    TypeLayout layout = layout_of(field);
+                    field_offset = align_to(field_offset, layout.alignment);
+                    compile(field, offset + field_offset, fixups, arena);
+                    field_offset += layout.size;
+                }
+                break;
+            }
+            case TypeKind::Enum:
+                fixup.op = FixupOp::Discriminant;
+                fixup.width = static_cast<uint8_t>(discriminant_size(type.params.size()));
+                fixup.count = static_cast<uint32_t>(type.params.size());
+                fixups.push_back(fixup);
+                break;
+            case TypeKind::Variant:
+            case TypeKind::Option:
+            case TypeKind::Result:
+            {
+                memory::ArenaVector<const InterfaceType *> cases{memory::StlAllocator<const InterfaceType *>(arena)};
+                cases_of(type, cases);
+                const VariantLayout layout = variant_layout(cases);
+
+                memory::ArenaVector<uint32_t> case_routines{memory::StlAllocator<uint32_t>(arena)};
+                bool any_fixups = false;
+                for (const InterfaceType *payload : cases)
+                {
+                    const uint32_t routine = compile_routine(*payload, arena);
+                    if (routines_[routine].fixup_count == 0)
+                    {
+                        routines_.pop_back(); // Payload is plain bytes; the variant's memcpy covers it
+                        case_routines.push_back(NO_FIXUPS);
+                    }
+                    else
+                    {
+                        case_routines.push_back(routine);
+                        any_fixups = true;
+                    }
+                }
+
+                fixup.width = static_cast<uint8_t>(layout.discriminant_size);
+                fixup.count = static_cast<uint32_t>(cases.size());
+                if (any_fixups)
+                {
+                    fixup.op = FixupOp::Variant;
+                    fixup.payload_offset = offset + layout.payload_offset;
+                    fixup.target = static_cast<uint32_t>(case_routines_.size());
+                    case_routines_.insert(case_routines_.end(), case_routines.begin(), case_routines.end());
+                }
+                else
+                {
+                    fixup.op = FixupOp::Discriminant;
+                }
+                fixups.push_back(fixup);
+                break;
+            }
+            default: // Integers, floats and flags are copied verbatim
+                break;
+            }
+        }
+
+        std::shared_ptr<const MarshalPlan> CanonicalABI::plan(const InterfaceType &type)
+        {
+            // Names do not affect layout or marshalling, so types differing
+            // only in names intern to one ID and share a plan
+            std::lock_guard<std::mutex> lock(mutex_);
+            const TypeId id = types_.intern(type);
+            if (id >= plans_.size())
+            {
+                plans_.resize(types_.size());
+            }
+            if (!plans_[id])
+            {
+                plans_[id] = std::make_shared<const MarshalPlan>(type);
+                ++cached_;
+            }
+            return plans_[id];
+        }
+
+        size_t CanonicalABI::cached_plans() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return cached_;
+        }
+
+        wasm::Result<void> CanonicalABI::transfer(const MarshalPlan &plan,
+                                                  const GuestMemory &src, uint32_t src_offset,
+                                                  GuestMemory &dst, uint32_t dst_offset,
+                                                  const TransferOptions &options)
+        {
+            const TypeLayout &layout = plan.layout();
+            if (src_offset % layout.alignment != 0 || dst_offset % layout.alignment != 0)
+            {
+                return wasm::Result<void>(wasm::ErrorCode::InvalidAlignment, "Misaligned value");
+            }
+            if (!src.contains(src_offset, layout.size) || !dst.contains(dst_offset, layout.size))
+            {
+                return wasm::Result<void>(wasm::ErrorCode::OutOfBounds, "Value out of bounds");
+            }
+
+            // Both sides may live in one memory once components are flattened
+            std::memmove(dst.base + dst_offset, src.base + src_offset, layout.size);
+            if (plan.trivially_copyable())
+            {
+                return wasm::Result<void>();
+            }
+            return Transfer(plan, src, dst, options).run(0, src_offset, dst_offset);
+        }
+
+        wasm::Result<uint32_t> CanonicalABI::transfer_new(const MarshalPlan &plan,
+                                                          const GuestMemory &src, uint32_t src_offset,
+                                                          GuestMemory &dst, const TransferOptions &options)
+        {
+            auto allocation = dst.allocate(plan.layout().size, plan.layout().alignment);
+            if (!allocation)
+            {
+                return allocation;
+            }
+            auto result = transfer(plan, src, src_offset, dst, allocation.value(), options);
+            if (!result)
+            {
+                return wasm::make_error<uint32_t>(result.error());
+            }
+            return allocation;
+        }
+
+    } // namespace component
+} // namespace flight
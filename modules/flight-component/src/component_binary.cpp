@@ -0,0 +1,1140 @@
+#include <flight/component/component_binary.hpp>
+#include <flight/wasm/binary/parser.hpp>
+
+namespace flight
+{
+    namespace component
+    {
+
+        namespace
+        {
+            enum SectionId : uint8_t
+            {
+                CUSTOM = 0,
+                CORE_MODULE = 1,
+                CORE_INSTANCE = 2,
+                CORE_TYPE = 3,
+                COMPONENT = 4,
+                INSTANCE = 5,
+                ALIAS = 6,
+                TYPE = 7,
+                CANON = 8,
+                START = 9,
+                IMPORT = 10,
+                EXPORT = 11
+            };
+
+            // A type index space and the spaces of the types enclosing it
+            struct TypeScope
+            {
+                std::vector<TypeDefinition> *types;
+                const TypeScope *outer;
+            };
+
+            // An externdesc: what an import or export declares
+            struct ExternDesc
+            {
+                Sort sort;
+                uint32_t index;        // Type of a func, instance or component; eq bound of a type
+                bool resource = false; // Type bound: sub resource
+            };
+
+            bool primitive(uint8_t code, InterfaceType &type)
+            {
+                static const TypeKind kinds[] = {
+                    TypeKind::String,  // 0x73
+                    TypeKind::Char,    // 0x74
+                    TypeKind::Float64, // 0x75
+                    TypeKind::Float32, // 0x76
+                    TypeKind::U64,     // 0x77
+                    TypeKind::S64,     // 0x78
+                    TypeKind::U32,     // 0x79
+                    TypeKind::S32,     // 0x7a
+                    TypeKind::U16,     // 0x7b
+                    TypeKind::S16,     // 0x7c
+                    TypeKind::U8,      // 0x7d
+                    TypeKind::S8,      // 0x7e
+                    TypeKind::Bool     // 0x7f
+                };
+                if (code < 0x73 || code > 0x7f)
+                {
+                    return false;
+                }
+                type = InterfaceType{kinds[code - 0x73], "", {}};
+                return true;
+            }
+
+            InterfaceType empty_tuple()
+            {
+                return InterfaceType{TypeKind::Tuple, "", {}};
+            }
+        } // namespace
+
+        // Section decoder; collects the first error and stops
+        class ComponentReader
+        {
+        public:
+            explicit ComponentReader(ComponentBinary &binary)
+                : binary_(binary), reader_(wasm::span<const uint8_t>(binary.bytes_.data(), binary.bytes_.size()))
+            {
+            }
+
+            const wasm::Error &error() const { return error_; }
+
+            bool read()
+            {
+                if (!ComponentBinary::is_component(reader_.data()))
+                {
+                    return fail(wasm::ErrorCode::InvalidVersion, "Not a component binary");
+                }
+                reader_.seek(8);
+
+                TypeScope scope{&binary_.types, nullptr};
+                while (reader_.has_data())
+                {
+                    uint8_t id;
+                    uint32_t size;
+                    if (!byte(id) || !u32(size))
+                    {
+                        return false;
+                    }
+                    if (size > reader_.remaining())
+                    {
+                        return fail(wasm::ErrorCode::UnexpectedEndOfFile, "Section extends past the end of the component");
+                    }
+                    const size_t end = reader_.position() + size;
+                    if (!section(id, size, scope))
+                    {
+                        return false;
+                    }
+                    if (reader_.position() != end)
+                    {
+                        return fail(wasm::ErrorCode::MissingSectionSize, "Section size does not match its contents");
+                    }
+                }
+                return true;
+            }
+
+        private:
+            bool fail(wasm::ErrorCode code, const char *message)
+            {
+                if (error_.code() == wasm::ErrorCode::Success)
+                {
+                    error_ = wasm::Error(code, message);
+                }
+                return false;
+            }
+
+            bool unsupported(const char *message)
+            {
+                return fail(wasm::ErrorCode::UnsupportedInstruction, message);
+            }
+
+            // -----------------------------------------------------------------
+            // Primitives
+            // -----------------------------------------------------------------
+
+            bool byte(uint8_t &value)
+            {
+                auto read = reader_.read_byte();
+                if (!read)
+                {
+                    return fail(read.error().code(), "Truncated component");
+                }
+                value = read.value();
+                return true;
+            }
+
+            bool expect(uint8_t value)
+            {
+                uint8_t read;
+                if (!byte(read))
+                {
+                    return false;
+                }
+                return read == value || fail(wasm::ErrorCode::InvalidImmediate, "Unexpected byte in component");
+            }
+
+            bool u32(uint32_t &value)
+            {
+                auto read = reader_.read_leb128_u32();
+                if (!read)
+                {
+                    return fail(read.error().code(), "Invalid LEB128 in component");
+                }
+                value = read.value();
+                return true;
+            }
+
+            bool name(std::string &value)
+            {
+                auto read = reader_.read_name();
+                if (!read)
+                {
+                    return fail(read.error().code(), "Invalid name in component");
+                }
+                value.assign(read.value().data(), read.value().size());
+                return true;
+            }
+
+            // importname' and exportname': a discriminant, the name and,
+            // for 0x01, a version suffix that flattening ignores
+            bool extern_name(std::string &value)
+            {
+                uint8_t kind;
+                if (!byte(kind) || !name(value))
+                {
+                    return false;
+                }
+                if (kind == 0x01)
+                {
+                    std::string version;
+                    return name(version);
+                }
+                return kind == 0x00 || fail(wasm::ErrorCode::InvalidImmediate, "Unknown import or export name kind");
+            }
+
+            bool sort(Sort &value, CoreSort &core)
+            {
+                uint8_t code;
+                if (!byte(code))
+                {
+                    return false;
+                }
+                if (code > static_cast<uint8_t>(Sort::Instance))
+                {
+                    return fail(wasm::ErrorCode::InvalidImmediate, "Unknown sort");
+                }
+                value = static_cast<Sort>(code);
+                core = CoreSort::Func;
+                return value != Sort::Core || core_sort(core);
+            }
+
+            bool core_sort(CoreSort &value)
+            {
+                uint8_t code;
+                if (!byte(code))
+                {
+                    return false;
+                }
+                if (code > static_cast<uint8_t>(CoreSort::Global) &&
+                    (code < static_cast<uint8_t>(CoreSort::Type) || code > static_cast<uint8_t>(CoreSort::Instance)))
+                {
+                    return fail(wasm::ErrorCode::InvalidImmediate, "Unknown core sort");
+                }
+                value = static_cast<CoreSort>(code);
+                return true;
+            }
+
+            bool sort_index(SortIndex &value)
+            {
+                return sort(value.sort, value.core_sort) && u32(value.index);
+            }
+
+            // -----------------------------------------------------------------
+            // Sections
+            // -----------------------------------------------------------------
+
+            bool section(uint8_t id, uint32_t size, TypeScope &scope)
+            {
+                uint32_t count = 0;
+                switch (id)
+                {
+                case CUSTOM:
+                case CORE_TYPE:
+                    // Core types only describe imports flattening resolves itself
+                    reader_.skip_bytes(size);
+                    return true;
+                case CORE_MODULE:
+                    binary_.core_modules_.emplace_back(reader_.position(), size);
+                    reader_.skip_bytes(size);
+                    return true;
+                case COMPONENT:
+                    return unsupported("Nested components are not supported");
+                case START:
+                    return unsupported("Component start functions are not supported");
+                default:
+                    break;
+                }
+                if (id > EXPORT)
+                {
+                    return fail(wasm::ErrorCode::InvalidSectionId, "Unknown component section");
+                }
+
+                if (!u32(count))
+                {
+                    return false;
+                }
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    bool read = false;
+                    switch (id)
+                    {
+                    case CORE_INSTANCE:
+                        read = core_instance();
+                        break;
+                    case INSTANCE:
+                        read = instance();
+                        break;
+                    case ALIAS:
+                        read = alias();
+                        break;
+                    case TYPE:
+                    {
+                        TypeDefinition type;
+                        read = type_definition(scope, type);
+                        binary_.types.push_back(std::move(type));
+                        break;
+                    }
+                    case CANON:
+                        read = canon();
+                        break;
+                    case IMPORT:
+                        read = import(scope);
+                        break;
+                    case EXPORT:
+                        read = export_definition();
+                        break;
+                    }
+                    if (!read)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            bool core_instance()
+            {
+                uint8_t kind;
+                uint32_t count;
+                if (!byte(kind) || !(kind <= 0x01 || fail(wasm::ErrorCode::InvalidImmediate, "Unknown core instance kind")))
+                {
+                    return false;
+                }
+                CoreInstanceDefinition definition;
+                if (kind == 0x00)
+                {
+                    definition.kind = CoreInstanceDefinition::Kind::Instantiate;
+                    if (!u32(definition.module) || !u32(count))
+                    {
+                        return false;
+                    }
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        std::string module;
+                        uint32_t instance;
+                        if (!name(module) || !expect(static_cast<uint8_t>(CoreSort::Instance)) || !u32(instance))
+                        {
+                            return false;
+                        }
+                        definition.args.emplace_back(std::move(module), instance);
+                    }
+                }
+                else
+                {
+                    definition.kind = CoreInstanceDefinition::Kind::Exports;
+                    if (!u32(count))
+                    {
+                        return false;
+                    }
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        std::string field;
+                        CoreSortIndex item;
+                        if (!name(field) || !core_sort(item.sort) || !u32(item.index))
+                        {
+                            return false;
+                        }
+                        definition.exports.emplace_back(std::move(field), item);
+                    }
+                }
+                binary_.core_instances.push_back(std::move(definition));
+                return true;
+            }
+
+            bool instance()
+            {
+                uint8_t kind;
+                uint32_t count;
+                if (!byte(kind))
+                {
+                    return false;
+                }
+                if (kind == 0x00)
+                {
+                    return unsupported("Instantiating nested components is not supported");
+                }
+                if (kind != 0x01)
+                {
+                    return fail(wasm::ErrorCode::InvalidImmediate, "Unknown instance kind");
+                }
+                InstanceDefinition definition;
+                definition.kind = InstanceDefinition::Kind::Exports;
+                if (!u32(count))
+                {
+                    return false;
+                }
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    std::string field;
+                    SortIndex item;
+                    if (!extern_name(field) || !sort_index(item))
+                    {
+                        return false;
+                    }
+                    definition.exports.emplace_back(std::move(field), item);
+                }
+                binary_.instances.push_back(std::move(definition));
+                return true;
+            }
+
+            bool alias()
+            {
+                Sort item;
+                CoreSort core;
+                uint8_t target;
+                uint32_t instance;
+                std::string field;
+                if (!sort(item, core) || !byte(target))
+                {
+                    return false;
+                }
+                if (target == 0x02)
+                {
+                    return unsupported("Outer aliases of a top-level component have no target");
+                }
+                if (target > 0x01)
+                {
+                    return fail(wasm::ErrorCode::InvalidImmediate, "Unknown alias target");
+                }
+                if (!u32(instance) || !name(field))
+                {
+                    return false;
+                }
+
+                if (target == 0x01)
+                {
+                    // Core export of a core instance
+                    if (item != Sort::Core || core > CoreSort::Global)
+                    {
+                        return unsupported("Only core functions, tables, memories and globals can be aliased");
+                    }
+                    CoreItemDefinition definition;
+                    definition.kind = CoreItemDefinition::Kind::Alias;
+                    definition.instance = instance;
+                    definition.name = std::move(field);
+                    core_space(core).push_back(std::move(definition));
+                    return true;
+                }
+
+                // Export of a component instance
+                switch (item)
+                {
+                case Sort::Func:
+                {
+                    FunctionDefinition definition;
+                    definition.kind = FunctionDefinition::Kind::Alias;
+                    definition.instance = instance;
+                    definition.name = std::move(field);
+                    binary_.functions.push_back(std::move(definition));
+                    return true;
+                }
+                case Sort::Type:
+                {
+                    // Resource types of imported interfaces, as used by own and borrow
+                    TypeDefinition definition;
+                    definition.kind = TypeDefinition::Kind::Other;
+                    binary_.types.push_back(std::move(definition));
+                    return true;
+                }
+                default:
+                    return unsupported("Only functions and types can be aliased from instances");
+                }
+            }
+
+            bool canon()
+            {
+                uint8_t kind;
+                if (!byte(kind))
+                {
+                    return false;
+                }
+                switch (kind)
+                {
+                case 0x00:
+                {
+                    FunctionDefinition definition;
+                    definition.kind = FunctionDefinition::Kind::Lift;
+                    if (!expect(0x00) || !u32(definition.core_function) || !canon_options(definition.options) ||
+                        !u32(definition.type))
+                    {
+                        return false;
+                    }
+                    binary_.functions.push_back(std::move(definition));
+                    return true;
+                }
+                case 0x01:
+                {
+                    CoreItemDefinition definition;
+                    definition.kind = CoreItemDefinition::Kind::Lower;
+                    if (!expect(0x00) || !u32(definition.function) || !canon_options(definition.options))
+                    {
+                        return false;
+                    }
+                    binary_.core_functions.push_back(std::move(definition));
+                    return true;
+                }
+                case 0x02: // resource.new
+                case 0x03: // resource.drop
+                case 0x04: // resource.rep
+                case 0x07: // resource.drop async
+                {
+                    CoreItemDefinition definition;
+                    definition.kind = CoreItemDefinition::Kind::Resource;
+                    if (!u32(definition.function))
+                    {
+                        return false;
+                    }
+                    binary_.core_functions.push_back(std::move(definition));
+                    return true;
+                }
+                default:
+                    return unsupported("Unsupported canon definition");
+                }
+            }
+
+            bool canon_options(CanonOptions &options)
+            {
+                uint32_t count;
+                if (!u32(count))
+                {
+                    return false;
+                }
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    uint8_t option;
+                    if (!byte(option))
+                    {
+                        return false;
+                    }
+                    bool read = true;
+                    switch (option)
+                    {
+                    case 0x00:
+                        options.encoding = StringEncoding::Utf8;
+                        break;
+                    case 0x01:
+                        options.encoding = StringEncoding::Utf16;
+                        break;
+                    case 0x02:
+                        options.encoding = StringEncoding::Latin1Utf16;
+                        break;
+                    case 0x03:
+                        read = u32(options.memory);
+                        break;
+                    case 0x04:
+                        read = u32(options.realloc);
+                        break;
+                    case 0x05:
+                        read = u32(options.post_return);
+                        break;
+                    default:
+                        return unsupported("Unsupported canon option");
+                    }
+                    if (!read)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            bool import(const TypeScope &scope)
+            {
+                ImportDefinition definition;
+                ExternDesc desc;
+                if (!extern_name(definition.name) || !extern_desc(desc))
+                {
+                    return false;
+                }
+                const uint32_t import = static_cast<uint32_t>(binary_.imports.size());
+                definition.item = SortIndex{desc.sort, CoreSort::Func, 0};
+                switch (desc.sort)
+                {
+                case Sort::Func:
+                {
+                    FunctionDefinition function;
+                    function.kind = FunctionDefinition::Kind::Import;
+                    function.import = import;
+                    function.type = desc.index;
+                    definition.item.index = static_cast<uint32_t>(binary_.functions.size());
+                    binary_.functions.push_back(std::move(function));
+                    break;
+                }
+                case Sort::Instance:
+                {
+                    InstanceDefinition instance;
+                    instance.kind = InstanceDefinition::Kind::Import;
+                    instance.import = import;
+                    instance.type = desc.index;
+                    definition.item.index = static_cast<uint32_t>(binary_.instances.size());
+                    binary_.instances.push_back(std::move(instance));
+                    break;
+                }
+                case Sort::Type:
+                {
+                    TypeDefinition type;
+                    if (!bound_type(scope, desc, type))
+                    {
+                        return false;
+                    }
+                    definition.item.index = static_cast<uint32_t>(binary_.types.size());
+                    binary_.types.push_back(std::move(type));
+                    break;
+                }
+                default:
+                    return unsupported("Only functions, instances and types can be imported");
+                }
+                binary_.imports.push_back(std::move(definition));
+                return true;
+            }
+
+            // Exports also define a new index in their sort's space
+            bool export_definition()
+            {
+                ExportDefinition definition;
+                uint8_t has_desc;
+                if (!extern_name(definition.name) || !sort_index(definition.item) || !byte(has_desc))
+                {
+                    return false;
+                }
+                if (has_desc == 0x01)
+                {
+                    ExternDesc desc;
+                    if (!extern_desc(desc))
+                    {
+                        return false;
+                    }
+                }
+                else if (has_desc != 0x00)
+                {
+                    return fail(wasm::ErrorCode::InvalidImmediate, "Invalid export type ascription");
+                }
+
+                const uint32_t index = definition.item.index;
+                switch (definition.item.sort)
+                {
+                case Sort::Func:
+                    if (index >= binary_.functions.size())
+                    {
+                        return fail(wasm::ErrorCode::InvalidFunctionIndex, "Export of an undefined function");
+                    }
+                    binary_.functions.push_back(binary_.functions[index]);
+                    break;
+                case Sort::Instance:
+                    if (index >= binary_.instances.size())
+                    {
+                        return fail(wasm::ErrorCode::InvalidModule, "Export of an undefined instance");
+                    }
+                    binary_.instances.push_back(binary_.instances[index]);
+                    break;
+                case Sort::Type:
+                    if (index >= binary_.types.size())
+                    {
+                        return fail(wasm::ErrorCode::InvalidTypeIndex, "Export of an undefined type");
+                    }
+                    binary_.types.push_back(binary_.types[index]);
+                    break;
+                default:
+                    break;
+                }
+                binary_.exports.push_back(std::move(definition));
+                return true;
+            }
+
+            std::vector<CoreItemDefinition> &core_space(CoreSort sort)
+            {
+                switch (sort)
+                {
+                case CoreSort::Table:
+                    return binary_.core_tables;
+                case CoreSort::Memory:
+                    return binary_.core_memories;
+                case CoreSort::Global:
+                    return binary_.core_globals;
+                default:
+                    return binary_.core_functions;
+                }
+            }
+
+            // -----------------------------------------------------------------
+            // Types
+            // -----------------------------------------------------------------
+
+            bool extern_desc(ExternDesc &desc)
+            {
+                uint8_t kind;
+                if (!byte(kind))
+                {
+                    return false;
+                }
+                switch (kind)
+                {
+                case 0x00:
+                    desc.sort = Sort::Core;
+                    return expect(static_cast<uint8_t>(CoreSort::Module)) && u32(desc.index);
+                case 0x01:
+                    desc.sort = Sort::Func;
+                    return u32(desc.index);
+                case 0x02:
+                {
+                    uint8_t bound;
+                    desc.sort = Sort::Value;
+                    return byte(bound) && u32(desc.index);
+                }
+                case 0x03:
+                {
+                    uint8_t bound;
+                    desc.sort = Sort::Type;
+                    if (!byte(bound))
+                    {
+                        return false;
+                    }
+                    if (bound == 0x01)
+                    {
+                        desc.resource = true;
+                        return expect(0x00);
+                    }
+                    return (bound == 0x00 || fail(wasm::ErrorCode::InvalidImmediate, "Unknown type bound")) &&
+                           u32(desc.index);
+                }
+                case 0x04:
+                    desc.sort = Sort::Component;
+                    return u32(desc.index);
+                case 0x05:
+                    desc.sort = Sort::Instance;
+                    return u32(desc.index);
+                default:
+                    return fail(wasm::ErrorCode::InvalidImmediate, "Unknown extern description");
+                }
+            }
+
+            // The type a type-bounded import or export declaration introduces
+            bool bound_type(const TypeScope &scope, const ExternDesc &desc, TypeDefinition &type)
+            {
+                if (desc.resource)
+                {
+                    type.kind = TypeDefinition::Kind::Resource;
+                    return true;
+                }
+                if (desc.index >= scope.types->size())
+                {
+                    return fail(wasm::ErrorCode::InvalidTypeIndex, "Type bound refers to an undefined type");
+                }
+                type = (*scope.types)[desc.index];
+                return true;
+            }
+
+            bool type_definition(const TypeScope &scope, TypeDefinition &type)
+            {
+                uint8_t tag;
+                if (!byte(tag))
+                {
+                    return false;
+                }
+                switch (tag)
+                {
+                case 0x40:
+                    type.kind = TypeDefinition::Kind::Function;
+                    return function_type(scope, type.function);
+                case 0x41:
+                    type.kind = TypeDefinition::Kind::Other;
+                    return declarations(scope, true, type);
+                case 0x42:
+                    type.kind = TypeDefinition::Kind::Instance;
+                    return declarations(scope, false, type);
+                case 0x3f:
+                {
+                    // Representation (i32) and optional destructor
+                    uint8_t has_destructor;
+                    uint32_t destructor;
+                    type.kind = TypeDefinition::Kind::Resource;
+                    if (!expect(0x7f) || !byte(has_destructor))
+                    {
+                        return false;
+                    }
+                    return has_destructor == 0x00 || u32(destructor);
+                }
+                default:
+                    type.kind = TypeDefinition::Kind::Value;
+                    return value_definition(scope, tag, type.value);
+                }
+            }
+
+            bool function_type(const TypeScope &scope, FunctionType &function)
+            {
+                uint32_t count;
+                if (!u32(count))
+                {
+                    return false;
+                }
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    InterfaceType param;
+                    std::string label;
+                    if (!name(label) || !value_type(scope, param))
+                    {
+                        return false;
+                    }
+                    param.name = std::move(label);
+                    function.params.push_back(std::move(param));
+                }
+
+                uint8_t results;
+                if (!byte(results))
+                {
+                    return false;
+                }
+                if (results == 0x00)
+                {
+                    InterfaceType result;
+                    if (!value_type(scope, result))
+                    {
+                        return false;
+                    }
+                    function.results.push_back(std::move(result));
+                    return true;
+                }
+                if (results != 0x01 || !u32(count))
+                {
+                    return fail(wasm::ErrorCode::InvalidImmediate, "Invalid function result list");
+                }
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    InterfaceType result;
+                    std::string label;
+                    if (!name(label) || !value_type(scope, result))
+                    {
+                        return false;
+                    }
+                    result.name = std::move(label);
+                    function.results.push_back(std::move(result));
+                }
+                return true;
+            }
+
+            // Declarations of a component or instance type, in a scope of their own
+            bool declarations(const TypeScope &outer, bool component, TypeDefinition &type)
+            {
+                std::vector<TypeDefinition> types;
+                TypeScope scope{&types, &outer};
+                uint32_t count;
+                if (!u32(count))
+                {
+                    return false;
+                }
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    uint8_t kind;
+                    if (!byte(kind))
+                    {
+                        return false;
+                    }
+                    switch (kind)
+                    {
+                    case 0x01:
+                    {
+                        TypeDefinition nested;
+                        if (!type_definition(scope, nested))
+                        {
+                            return false;
+                        }
+                        types.push_back(std::move(nested));
+                        break;
+                    }
+                    case 0x02:
+                        if (!outer_alias(scope))
+                        {
+                            return false;
+                        }
+                        break;
+                    case 0x03:
+                    case 0x04:
+                    {
+                        std::string field;
+                        ExternDesc desc;
+                        if (kind == 0x03 && !component)
+                        {
+                            return fail(wasm::ErrorCode::InvalidImmediate, "Instance types cannot import");
+                        }
+                        if (!extern_name(field) || !extern_desc(desc))
+                        {
+                            return false;
+                        }
+                        if (desc.sort == Sort::Type)
+                        {
+                            TypeDefinition bound;
+                            if (!bound_type(scope, desc, bound))
+                            {
+                                return false;
+                            }
+                            types.push_back(std::move(bound));
+                        }
+                        else if (kind == 0x04 && desc.sort == Sort::Func && !component)
+                        {
+                            if (desc.index >= types.size() || types[desc.index].kind != TypeDefinition::Kind::Function)
+                            {
+                                return fail(wasm::ErrorCode::InvalidTypeIndex, "Function export without a function type");
+                            }
+                            type.functions.emplace_back(std::move(field), types[desc.index].function);
+                        }
+                        break;
+                    }
+                    default:
+                        return unsupported("Unsupported type declaration");
+                    }
+                }
+                return true;
+            }
+
+            // alias outer ct idx: copies a type of an enclosing scope
+            bool outer_alias(const TypeScope &scope)
+            {
+                Sort item;
+                CoreSort core;
+                uint32_t depth;
+                uint32_t index;
+                if (!sort(item, core) || !expect(0x02) || !u32(depth) || !u32(index))
+                {
+                    return false;
+                }
+                if (item != Sort::Type)
+                {
+                    return unsupported("Only types can be aliased in type declarations");
+                }
+                const TypeScope *target = &scope;
+                for (uint32_t i = 0; i < depth && target; ++i)
+                {
+                    target = target->outer;
+                }
+                if (!target || index >= target->types->size())
+                {
+                    return fail(wasm::ErrorCode::InvalidTypeIndex, "Outer alias of an undefined type");
+                }
+                scope.types->push_back((*target->types)[index]);
+                return true;
+            }
+
+            // valtype: a primitive, or the index of a defined value type
+            bool value_type(const TypeScope &scope, InterfaceType &type)
+            {
+                auto read = reader_.read_leb128_i64();
+                if (!read)
+                {
+                    return fail(read.error().code(), "Invalid value type");
+                }
+                const int64_t code = read.value();
+                if (code < 0)
+                {
+                    return primitive(static_cast<uint8_t>(code & 0x7f), type) ||
+                           unsupported("Unsupported primitive value type");
+                }
+                if (static_cast<uint64_t>(code) >= scope.types->size() ||
+                    (*scope.types)[code].kind != TypeDefinition::Kind::Value)
+                {
+                    return fail(wasm::ErrorCode::InvalidTypeIndex, "Value type refers to a non-value type");
+                }
+                type = (*scope.types)[code].value;
+                return true;
+            }
+
+            bool optional_value_type(const TypeScope &scope, InterfaceType &type)
+            {
+                uint8_t present;
+                if (!byte(present))
+                {
+                    return false;
+                }
+                if (present == 0x00)
+                {
+                    type = empty_tuple();
+                    return true;
+                }
+                return value_type(scope, type);
+            }
+
+            bool labels(std::vector<InterfaceType> &params)
+            {
+                uint32_t count;
+                if (!u32(count))
+                {
+                    return false;
+                }
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    InterfaceType label = empty_tuple();
+                    if (!name(label.name))
+                    {
+                        return false;
+                    }
+                    params.push_back(std::move(label));
+                }
+                return true;
+            }
+
+            bool value_definition(const TypeScope &scope, uint8_t tag, InterfaceType &type)
+            {
+                if (primitive(tag, type))
+                {
+                    return true;
+                }
+                uint32_t count = 0;
+                type.params.clear();
+                switch (tag)
+                {
+                case 0x72: // record
+                case 0x71: // variant
+                    type.kind = tag == 0x72 ? TypeKind::Record : TypeKind::Variant;
+                    if (!u32(count))
+                    {
+                        return false;
+                    }
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        InterfaceType field;
+                        std::string label;
+                        if (!name(label) ||
+                            !(tag == 0x72 ? value_type(scope, field) : optional_value_type(scope, field)))
+                        {
+                            return false;
+                        }
+                        if (tag == 0x71)
+                        {
+                            // Refinement: 0x00, or 0x01 and a case index in older encoders
+                            uint8_t refines;
+                            uint32_t refined;
+                            if (!byte(refines) || (refines == 0x01 && !u32(refined)))
+                            {
+                                return false;
+                            }
+                        }
+                        field.name = std::move(label);
+                        type.params.push_back(std::move(field));
+                    }
+                    return true;
+                case 0x70: // list
+                case 0x6b: // option
+                {
+                    type.kind = tag == 0x70 ? TypeKind::List : TypeKind::Option;
+                    InterfaceType element;
+                    if (!value_type(scope, element))
+                    {
+                        return false;
+                    }
+                    type.params.push_back(std::move(element));
+                    return true;
+                }
+                case 0x6f: // tuple
+                    type.kind = TypeKind::Tuple;
+                    if (!u32(count))
+                    {
+                        return false;
+                    }
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        InterfaceType field;
+                        if (!value_type(scope, field))
+                        {
+                            return false;
+                        }
+                        type.params.push_back(std::move(field));
+                    }
+                    return true;
+                case 0x6e: // flags
+                    type.kind = TypeKind::Flags;
+                    return labels(type.params);
+                case 0x6d: // enum
+                    type.kind = TypeKind::Enum;
+                    return labels(type.params);
+                case 0x6a: // result
+                {
+                    type.kind = TypeKind::Result;
+                    InterfaceType ok;
+                    InterfaceType error;
+                    if (!optional_value_type(scope, ok) || !optional_value_type(scope, error))
+                    {
+                        return false;
+                    }
+                    type.params.push_back(std::move(ok));
+                    type.params.push_back(std::move(error));
+                    return true;
+                }
+                case 0x66: // stream
+                case 0x65: // future
+                {
+                    type.kind = tag == 0x66 ? TypeKind::Stream : TypeKind::Future;
+                    InterfaceType element;
+                    if (!optional_value_type(scope, element))
+                    {
+                        return false;
+                    }
+                    type.params.push_back(std::move(element));
+                    return true;
+                }
+                case 0x69: // own
+                case 0x68: // borrow
+                {
+                    type.kind = tag == 0x69 ? TypeKind::Own : TypeKind::Borrow;
+                    uint32_t resource;
+                    if (!u32(resource))
+                    {
+                        return false;
+                    }
+                    if (resource >= scope.types->size() ||
+                        (*scope.types)[resource].kind == TypeDefinition::Kind::Value ||
+                        (*scope.types)[resource].kind == TypeDefinition::Kind::Function)
+                    {
+                        return fail(wasm::ErrorCode::InvalidTypeIndex, "Handle of a non-resource type");
+                    }
+                    return true;
+                }
+                default:
+                    return unsupported("Unsupported value type definition");
+                }
+            }
+
+            ComponentBinary &binary_;
+            wasm::BinaryReader reader_;
+            wasm::Error error_;
+        };
+
+        // =====================================================================
+        // ComponentBinary
+        // =====================================================================
+
+        bool ComponentBinary::is_component(wasm::span<const uint8_t> bytes)
+        {
+            if (bytes.size() < 8 || bytes[0] != 0x00 || bytes[1] != 0x61 || bytes[2] != 0x73 || bytes[3] != 0x6d)
+            {
+                return false;
+            }
+            const uint32_t version = static_cast<uint32_t>(bytes[4]) | static_cast<uint32_t>(bytes[5]) << 8 |
+                                     static_cast<uint32_t>(bytes[6]) << 16 | static_cast<uint32_t>(bytes[7]) << 24;
+            return version == COMPONENT_VERSION;
+        }
+
+        wasm::Result<ComponentBinary> ComponentBinary::parse(std::vector<uint8_t> bytes)
+        {
+            ComponentBinary binary;
+            binary.bytes_ = std::move(bytes);
+            ComponentReader reader(binary);
+            if (!reader.read())
+            {
+                return wasm::make_error<ComponentBinary>(reader.error());
+            }
+            return binary;
+        }
+
+    } // namespace component
+} // namespace flight
@@ -0,0 +1,1678 @@
+#include <flight/component/flattener.hpp>
+#include <flight/component/canonical_abi.hpp>
+#include <flight/component/type_interner.hpp>
+#include <flight/wasm/binary/encoder.hpp>
+#include <flight/wasm/binary/parser.hpp>
+#include <flight/wasm/text/opcodes.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <set>
+
+namespace flight
+{
+    namespace component
+    {
+
+        namespace
+        {
+            constexpr uint32_t NONE = 0xFFFFFFFF;
+            constexpr uint64_t PAGE_SIZE = 65536;
+
+            // Core index spaces, numbered like wasm::Import::Kind and CoreSort
+            constexpr size_t FUNC = 0;
+            constexpr size_t TABLE = 1;
+            constexpr size_t MEMORY = 2;
+            constexpr size_t GLOBAL = 3;
+            constexpr size_t SPACES = 4;
+
+            // A resolved core item: a function import of the flattened
+            // module, or an item defined by one core instance
+            struct Ref
+            {
+                bool imported;
+                uint32_t unit;
+                uint32_t index; // Import index, or defined index within the unit
+            };
+
+            // One instantiated core module
+            struct Unit
+            {
+                uint32_t component;
+                wasm::Module module;
+                std::vector<Ref> imports[SPACES];
+                uint32_t segment = NONE;
+                uint32_t function_base = 0;
+                uint32_t table_base = 0;
+                uint32_t global_base = 0;
+                uint32_t data_base = 0;
+                uint32_t element_base = 0;
+            };
+
+            struct Segment
+            {
+                MemorySegment layout;
+                uint32_t pages_global = 0;  // Current size, in pages
+                uint32_t grow_function = 0; // memory.grow of the segment
+                uint32_t base_global = 0;   // Exported base address
+            };
+
+            struct FunctionImport
+            {
+                std::string module;
+                std::string field;
+                wasm::FunctionType type;
+            };
+
+            // A component function followed to its definition
+            struct Callee
+            {
+                uint32_t component = NONE; // NONE: left to the host
+                const FunctionDefinition *lift = nullptr;
+                std::string path;
+                FunctionType type;
+            };
+
+            // Index maps of one unit into the flattened module
+            struct Remap
+            {
+                std::vector<uint32_t> functions;
+                std::vector<uint32_t> tables;
+                std::vector<uint32_t> globals;
+                std::vector<uint32_t> types;
+                uint32_t data_base = 0;
+                uint32_t element_base = 0;
+                const Segment *segment = nullptr;
+                uint32_t scratch = NONE; // First of the SCRATCH_LOCALS
+                bool bounds_checks = true;
+            };
+
+            // Locals appended to a function that rebases or checks memory
+            // accesses: a bulk operation's length, its source or value (or
+            // an i32 store's value), an address, then stored values by type
+            constexpr uint32_t SCRATCH_LENGTH = 0;
+            constexpr uint32_t SCRATCH_SOURCE = 1;
+            constexpr uint32_t SCRATCH_ADDRESS = 2;
+            constexpr uint32_t SCRATCH_I64 = 3;
+            constexpr uint32_t SCRATCH_F32 = 4;
+            constexpr uint32_t SCRATCH_F64 = 5;
+            constexpr wasm::ValueType SCRATCH_LOCALS[] = {wasm::ValueType::I32, wasm::ValueType::I32,
+                                                          wasm::ValueType::I32, wasm::ValueType::I64,
+                                                          wasm::ValueType::F32, wasm::ValueType::F64};
+
+            // A load or store: bytes accessed, and the scratch local that
+            // holds a store's value while its address is checked
+            struct MemoryAccess
+            {
+                uint32_t width;
+                uint32_t value; // NONE for loads
+            };
+
+            // Loads are 0x28-0x35 and stores 0x36-0x3E
+            bool memory_access(uint8_t opcode, MemoryAccess &access)
+            {
+                static const uint8_t WIDTHS[] = {4, 8, 4, 8, 1, 1, 2, 2, 1, 1, 2, 2, 4, 4,
+                                                 4, 8, 4, 8, 1, 2, 1, 2, 4};
+                if (opcode < 0x28 || opcode > 0x3E)
+                {
+                    return false;
+                }
+                access.width = WIDTHS[opcode - 0x28];
+                switch (opcode)
+                {
+                case 0x36: // i32.store
+                case 0x3A:
+                case 0x3B:
+                    access.value = SCRATCH_SOURCE;
+                    break;
+                case 0x37: // i64.store
+                case 0x3C:
+                case 0x3D:
+                case 0x3E:
+                    access.value = SCRATCH_I64;
+                    break;
+                case 0x38: // f32.store
+                    access.value = SCRATCH_F32;
+                    break;
+                case 0x39: // f64.store
+                    access.value = SCRATCH_F64;
+                    break;
+                default:
+                    access.value = NONE;
+                    break;
+                }
+                return true;
+            }
+
+            bool flat_scalars(const InterfaceType &type, size_t &count)
+            {
+                switch (type.kind)
+                {
+                case TypeKind::S32:
+                case TypeKind::U32:
+                case TypeKind::S64:
+                case TypeKind::U64:
+                case TypeKind::Float32:
+                case TypeKind::Float64:
+                    ++count;
+                    return true;
+                case TypeKind::Record:
+                case TypeKind::Tuple:
+                    for (const InterfaceType &field : type.params)
+                    {
+                        if (!flat_scalars(field, count))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                default:
+                    // Narrow integers, bool and char are validated when lifted
+                    return false;
+                }
+            }
+
+            // Lowering then lifting this signature copies its core values unchanged
+            bool fusable(const FunctionType &type)
+            {
+                size_t params = 0;
+                size_t results = 0;
+                for (const InterfaceType &param : type.params)
+                {
+                    if (!flat_scalars(param, params))
+                    {
+                        return false;
+                    }
+                }
+                for (const InterfaceType &result : type.results)
+                {
+                    if (!flat_scalars(result, results))
+                    {
+                        return false;
+                    }
+                }
+                return params <= MAX_FLAT_PARAMS && results <= MAX_FLAT_RESULTS;
+            }
+
+            bool same_core_type(const wasm::FunctionType &a, const wasm::FunctionType &b)
+            {
+                return a.params == b.params && a.results == b.results;
+            }
+
+            uint32_t defined_count(const wasm::Module &module, size_t space)
+            {
+                switch (space)
+                {
+                case FUNC:
+                    return static_cast<uint32_t>(module.functions.size());
+                case TABLE:
+                    return static_cast<uint32_t>(module.tables.size());
+                case MEMORY:
+                    return static_cast<uint32_t>(module.memories.size());
+                default:
+                    return static_cast<uint32_t>(module.globals.size());
+                }
+            }
+
+            // =================================================================
+            // Code rewriting
+            // =================================================================
+
+            // Rewrites one function body or constant expression for its
+            // unit's place in the flattened module
+            class CodeRewriter
+            {
+            public:
+                CodeRewriter(const Remap &remap, wasm::span<const uint8_t> code) : remap_(remap), in_(code) {}
+
+                bool run(wasm::BinaryWriter &out)
+                {
+                    while (in_.has_data())
+                    {
+                        if (!instruction(out))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                bool used_scratch() const { return used_scratch_; }
+                const wasm::Error &error() const { return error_; }
+
+            private:
+                bool fail(wasm::ErrorCode code, const char *message)
+                {
+                    error_ = wasm::Error(code, message);
+                    return false;
+                }
+
+                bool byte(uint8_t &value)
+                {
+                    auto read = in_.read_byte();
+                    if (!read)
+                    {
+                        return fail(read.error().code(), "Truncated function body");
+                    }
+                    value = read.value();
+                    return true;
+                }
+
+                bool u32(uint32_t &value)
+                {
+                    auto read = in_.read_leb128_u32();
+                    if (!read)
+                    {
+                        return fail(read.error().code(), "Invalid immediate in function body");
+                    }
+                    value = read.value();
+                    return true;
+                }
+
+                bool copy_u32(wasm::BinaryWriter &out)
+                {
+                    uint32_t value;
+                    if (!u32(value))
+                    {
+                        return false;
+                    }
+                    out.write_leb128_u32(value);
+                    return true;
+                }
+
+                bool index(const std::vector<uint32_t> &map, wasm::BinaryWriter &out)
+                {
+                    uint32_t value;
+                    if (!u32(value))
+                    {
+                        return false;
+                    }
+                    if (value >= map.size())
+                    {
+                        return fail(wasm::ErrorCode::InvalidModule, "Index out of range in function body");
+                    }
+                    out.write_leb128_u32(map[value]);
+                    return true;
+                }
+
+                bool offset(uint32_t base, wasm::BinaryWriter &out)
+                {
+                    uint32_t value;
+                    if (!u32(value))
+                    {
+                        return false;
+                    }
+                    out.write_leb128_u32(value + base);
+                    return true;
+                }
+
+                // The reserved memory index of memory instructions
+                bool memory_zero()
+                {
+                    uint8_t memory;
+                    if (!byte(memory))
+                    {
+                        return false;
+                    }
+                    if (memory != 0x00)
+                    {
+                        return fail(wasm::ErrorCode::UnsupportedInstruction, "Multiple memories are not supported");
+                    }
+                    if (!remap_.segment)
+                    {
+                        return fail(wasm::ErrorCode::InvalidMemoryIndex, "Memory instruction without a memory");
+                    }
+                    return true;
+                }
+
+                uint32_t base() const
+                {
+                    return remap_.segment->layout.base;
+                }
+
+                void i32_add_base(wasm::BinaryWriter &out) const
+                {
+                    out.write_byte(0x41); // i32.const
+                    out.write_leb128_i32(static_cast<int32_t>(base()));
+                    out.write_byte(0x6A); // i32.add
+                }
+
+                void local(wasm::BinaryWriter &out, uint8_t opcode, uint32_t index) const
+                {
+                    out.write_byte(opcode);
+                    out.write_leb128_u32(remap_.scratch + index);
+                }
+
+                // Traps unless address + extra (+ length) lies within the
+                // segment's current size; address and length are scratch
+                // locals. Computed in i64: a full segment is 4 GiB.
+                void bounds_check(wasm::BinaryWriter &out, uint32_t address, uint64_t extra,
+                                  uint32_t length = NONE) const
+                {
+                    local(out, 0x20, address);
+                    out.write_byte(0xAD); // i64.extend_i32_u
+                    if (length != NONE)
+                    {
+                        local(out, 0x20, length);
+                        out.write_byte(0xAD);
+                        out.write_byte(0x7C); // i64.add
+                    }
+                    if (extra != 0)
+                    {
+                        out.write_byte(0x42); // i64.const
+                        out.write_leb128_i64(static_cast<int64_t>(extra));
+                        out.write_byte(0x7C);
+                    }
+                    out.write_byte(0x23); // pages << 16
+                    out.write_leb128_u32(remap_.segment->pages_global);
+                    out.write_byte(0xAD);
+                    out.write_byte(0x42);
+                    out.write_leb128_i64(16);
+                    out.write_byte(0x86); // i64.shl
+                    out.write_byte(0x56); // i64.gt_u
+                    out.write_byte(0x04); // if: unreachable
+                    out.write_byte(0x40);
+                    out.write_byte(0x00);
+                    out.write_byte(0x0B);
+                }
+
+                // Checks and adds the segment base to the destination
+                // address of memory.fill/init (operands: address, value or
+                // source, length) or to both addresses of memory.copy
+                void rebase(wasm::BinaryWriter &out, bool both)
+                {
+                    const bool checked = remap_.bounds_checks;
+                    if (base() == 0 && !checked)
+                    {
+                        return;
+                    }
+                    used_scratch_ = true;
+                    local(out, 0x21, SCRATCH_LENGTH);
+                    local(out, 0x21, SCRATCH_SOURCE);
+                    if (checked)
+                    {
+                        if (both)
+                        {
+                            bounds_check(out, SCRATCH_SOURCE, 0, SCRATCH_LENGTH);
+                        }
+                        local(out, 0x22, SCRATCH_ADDRESS);
+                        bounds_check(out, SCRATCH_ADDRESS, 0, SCRATCH_LENGTH);
+                    }
+                    if (base() != 0)
+                    {
+                        i32_add_base(out);
+                    }
+                    local(out, 0x20, SCRATCH_SOURCE);
+                    if (both && base() != 0)
+                    {
+                        i32_add_base(out);
+                    }
+                    local(out, 0x20, SCRATCH_LENGTH);
+                }
+
+                // A load or store: checks the address against the segment
+                // size, then rebases the static offset onto the segment
+                bool load_store(uint8_t opcode, wasm::BinaryWriter &out)
+                {
+                    uint32_t alignment;
+                    uint32_t offset;
+                    if (!u32(alignment) || !u32(offset))
+                    {
+                        return false;
+                    }
+                    if (alignment & 0x40)
+                    {
+                        return fail(wasm::ErrorCode::UnsupportedInstruction, "Multiple memories are not supported");
+                    }
+                    if (!remap_.segment)
+                    {
+                        return fail(wasm::ErrorCode::InvalidMemoryIndex, "Memory instruction without a memory");
+                    }
+                    MemoryAccess access;
+                    if (!memory_access(opcode, access))
+                    {
+                        return fail(wasm::ErrorCode::UnsupportedInstruction, "Unknown memory access");
+                    }
+                    const uint64_t rebased = static_cast<uint64_t>(offset) + base();
+                    if (rebased > 0xFFFFFFFFull)
+                    {
+                        return fail(wasm::ErrorCode::MemoryLimitExceeded, "Rebased memory offset exceeds 4 GiB");
+                    }
+                    if (remap_.bounds_checks)
+                    {
+                        used_scratch_ = true;
+                        if (access.value != NONE)
+                        {
+                            local(out, 0x21, access.value);
+                        }
+                        local(out, 0x22, SCRATCH_ADDRESS);
+                        bounds_check(out, SCRATCH_ADDRESS, static_cast<uint64_t>(offset) + access.width);
+                        if (access.value != NONE)
+                        {
+                            local(out, 0x20, access.value);
+                        }
+                    }
+                    out.write_byte(opcode);
+                    out.write_leb128_u32(alignment);
+                    out.write_leb128_u32(static_cast<uint32_t>(rebased));
+                    return true;
+                }
+
+                bool instruction(wasm::BinaryWriter &out)
+                {
+                    uint8_t opcode;
+                    if (!byte(opcode))
+                    {
+                        return false;
+                    }
+                    if (opcode == 0xFC)
+                    {
+                        return prefixed(out);
+                    }
+                    if (opcode == 0x1C)
+                    {
+                        // select with explicit result types
+                        uint32_t count;
+                        out.write_byte(opcode);
+                        if (!u32(count))
+                        {
+                            return false;
+                        }
+                        out.write_leb128_u32(count);
+                        for (uint32_t i = 0; i < count; ++i)
+                        {
+                            uint8_t type;
+                            if (!byte(type))
+                            {
+                                return false;
+                            }
+                            out.write_byte(type);
+                        }
+                        return true;
+                    }
+
+                    const wasm::text::OpcodeInfo *info = wasm::text::find_opcode(0, opcode);
+                    if (!info)
+                    {
+                        return fail(wasm::ErrorCode::UnsupportedInstruction,
+                                    opcode == 0xFD ? "SIMD instructions are not supported" : "Unknown instruction");
+                    }
+
+                    using wasm::text::ImmediateKind;
+                    if (info->immediate == ImmediateKind::Memory)
+                    {
+                        // memory.size reads the segment's size; memory.grow grows it
+                        if (!memory_zero())
+                        {
+                            return false;
+                        }
+                        out.write_byte(opcode == 0x3F ? 0x23 : 0x10);
+                        out.write_leb128_u32(opcode == 0x3F ? remap_.segment->pages_global
+                                                            : remap_.segment->grow_function);
+                        return true;
+                    }
+                    if (info->immediate == ImmediateKind::MemArg)
+                    {
+                        return load_store(opcode, out);
+                    }
+
+                    out.write_byte(opcode);
+                    switch (info->immediate)
+                    {
+                    case ImmediateKind::None:
+                    case ImmediateKind::Select: // 0x1B has no immediate in the binary format
+                        return true;
+                    case ImmediateKind::BlockType:
+                    {
+                        auto type = in_.read_leb128_i64();
+                        if (!type)
+                        {
+                            return fail(type.error().code(), "Invalid block type");
+                        }
+                        if (type.value() < 0)
+                        {
+                            out.write_leb128_i64(type.value());
+                            return true;
+                        }
+                        if (static_cast<uint64_t>(type.value()) >= remap_.types.size())
+                        {
+                            return fail(wasm::ErrorCode::InvalidTypeIndex, "Block type out of range");
+                        }
+                        out.write_leb128_i64(remap_.types[type.value()]);
+                        return true;
+                    }
+                    case ImmediateKind::Label:
+                    case ImmediateKind::Local:
+                        return copy_u32(out);
+                    case ImmediateKind::LabelTable:
+                    {
+                        uint32_t count;
+                        if (!u32(count))
+                        {
+                            return false;
+                        }
+                        out.write_leb128_u32(count);
+                        for (uint32_t i = 0; i <= count; ++i)
+                        {
+                            if (!copy_u32(out))
+                            {
+                                return false;
+                            }
+                        }
+                        return true;
+                    }
+                    case ImmediateKind::Function:
+                        return index(remap_.functions, out);
+                    case ImmediateKind::CallIndirect:
+                        return index(remap_.types, out) && index(remap_.tables, out);
+                    case ImmediateKind::Global:
+                        return index(remap_.globals, out);
+                    case ImmediateKind::Table:
+                        return index(remap_.tables, out);
+                    case ImmediateKind::I32:
+                    {
+                        auto value = in_.read_leb128_i32();
+                        if (!value)
+                        {
+                            return fail(value.error().code(), "Invalid i32 constant");
+                        }
+                        out.write_leb128_i32(value.value());
+                        return true;
+                    }
+                    case ImmediateKind::I64:
+                    {
+                        auto value = in_.read_leb128_i64();
+                        if (!value)
+                        {
+                            return fail(value.error().code(), "Invalid i64 constant");
+                        }
+                        out.write_leb128_i64(value.value());
+                        return true;
+                    }
+                    case ImmediateKind::F32:
+                    case ImmediateKind::F64:
+                    {
+                        auto value = in_.read_view(info->immediate == ImmediateKind::F32 ? 4 : 8);
+                        if (!value)
+                        {
+                            return fail(value.error().code(), "Truncated float constant");
+                        }
+                        out.write_bytes(value.value());
+                        return true;
+                    }
+                    case ImmediateKind::RefNull:
+                    {
+                        uint8_t type;
+                        if (!byte(type))
+                        {
+                            return false;
+                        }
+                        out.write_byte(type);
+                        return true;
+                    }
+                    default:
+                        return fail(wasm::ErrorCode::UnsupportedInstruction, "Unsupported instruction immediate");
+                    }
+                }
+
+                bool prefixed(wasm::BinaryWriter &out)
+                {
+                    uint32_t code;
+                    if (!u32(code))
+                    {
+                        return false;
+                    }
+                    const wasm::text::OpcodeInfo *info = wasm::text::find_opcode(0xFC, code);
+                    if (!info)
+                    {
+                        return fail(wasm::ErrorCode::UnsupportedInstruction, "Unknown prefixed instruction");
+                    }
+
+                    using wasm::text::ImmediateKind;
+                    uint32_t data = 0;
+                    switch (info->immediate)
+                    {
+                    case ImmediateKind::MemoryInit:
+                        if (!u32(data) || !memory_zero())
+                        {
+                            return false;
+                        }
+                        rebase(out, false);
+                        break;
+                    case ImmediateKind::MemoryCopy:
+                        if (!memory_zero() || !memory_zero())
+                        {
+                            return false;
+                        }
+                        rebase(out, true);
+                        break;
+                    case ImmediateKind::Memory: // memory.fill
+                        if (!memory_zero())
+                        {
+                            return false;
+                        }
+                        rebase(out, false);
+                        break;
+                    default:
+                        break;
+                    }
+
+                    out.write_byte(0xFC);
+                    out.write_leb128_u32(code);
+                    switch (info->immediate)
+                    {
+                    case ImmediateKind::None:
+                        return true;
+                    case ImmediateKind::MemoryInit:
+                        out.write_leb128_u32(data + remap_.data_base);
+                        out.write_byte(0x00);
+                        return true;
+                    case ImmediateKind::MemoryCopy:
+                        out.write_byte(0x00);
+                        out.write_byte(0x00);
+                        return true;
+                    case ImmediateKind::Memory:
+                        out.write_byte(0x00);
+                        return true;
+                    case ImmediateKind::Data:
+                        return offset(remap_.data_base, out);
+                    case ImmediateKind::TableInit:
+                        return offset(remap_.element_base, out) && index(remap_.tables, out);
+                    case ImmediateKind::Elem:
+                        return offset(remap_.element_base, out);
+                    case ImmediateKind::TableCopy:
+                        return index(remap_.tables, out) && index(remap_.tables, out);
+                    case ImmediateKind::Table:
+                        return index(remap_.tables, out);
+                    default:
+                        return fail(wasm::ErrorCode::UnsupportedInstruction, "Unsupported instruction immediate");
+                    }
+                }
+
+                const Remap &remap_;
+                wasm::BinaryReader in_;
+                bool used_scratch_ = false;
+                wasm::Error error_;
+            };
+
+            // =================================================================
+            // Flattening
+            // =================================================================
+
+            class Flattening
+            {
+            public:
+                Flattening(const FlattenOptions &options, std::vector<std::string> names,
+                           std::vector<const ComponentBinary *> binaries)
+                    : names_(std::move(names)), binaries_(std::move(binaries)), unit_of_(binaries_.size()),
+                      planner_(options.platform), bounds_checks_(options.bounds_checks)
+                {
+                }
+
+                wasm::Result<FlattenResult> run()
+                {
+                    if (!providers() || !sort())
+                    {
+                        return wasm::make_error<FlattenResult>(error_);
+                    }
+                    for (uint32_t component : order_)
+                    {
+                        if (!instantiate(component) || !export_component(component))
+                        {
+                            return wasm::make_error<FlattenResult>(error_);
+                        }
+                    }
+                    FlattenResult result;
+                    auto layout = planner_.plan();
+                    if (!layout)
+                    {
+                        return wasm::make_error<FlattenResult>(layout.error());
+                    }
+                    result.layout = std::move(layout).value();
+                    for (size_t i = 0; i < segments_.size(); ++i)
+                    {
+                        segments_[i].layout = result.layout.segments()[i];
+                    }
+                    if (!assemble(result))
+                    {
+                        return wasm::make_error<FlattenResult>(error_);
+                    }
+                    return result;
+                }
+
+            private:
+                bool fail(wasm::ErrorCode code, const char *message)
+                {
+                    if (error_.code() == wasm::ErrorCode::Success)
+                    {
+                        error_ = wasm::Error(code, message);
+                    }
+                    return false;
+                }
+
+                // -------------------------------------------------------------
+                // Component graph
+                // -------------------------------------------------------------
+
+                bool provide(const std::string &path, uint32_t component, uint32_t function)
+                {
+                    if (!provider_.emplace(path, std::make_pair(component, function)).second)
+                    {
+                        return fail(wasm::ErrorCode::ImportResolutionFailed, "Two components export the same name");
+                    }
+                    return true;
+                }
+
+                // Export paths of every component: "name" for a function,
+                // "name#function" for the functions of an exported instance
+                bool providers()
+                {
+                    for (uint32_t c = 0; c < binaries_.size(); ++c)
+                    {
+                        const ComponentBinary &binary = *binaries_[c];
+                        for (const ExportDefinition &definition : binary.exports)
+                        {
+                            if (definition.item.sort == Sort::Func)
+                            {
+                                if (!provide(definition.name, c, definition.item.index))
+                                {
+                                    return false;
+                                }
+                            }
+                            else if (definition.item.sort == Sort::Instance &&
+                                     definition.item.index < binary.instances.size())
+                            {
+                                // Re-exported imports stay bound to their own provider
+                                const InstanceDefinition &instance = binary.instances[definition.item.index];
+                                if (instance.kind != InstanceDefinition::Kind::Exports)
+                                {
+                                    continue;
+                                }
+                                for (const auto &item : instance.exports)
+                                {
+                                    if (item.second.sort == Sort::Func &&
+                                        !provide(definition.name + "#" + item.first, c, item.second.index))
+                                    {
+                                        return false;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                    return true;
+                }
+
+                std::vector<std::string> import_paths(const ComponentBinary &binary) const
+                {
+                    std::vector<std::string> paths;
+                    for (const InstanceDefinition &instance : binary.instances)
+                    {
+                        if (instance.kind == InstanceDefinition::Kind::Import && instance.type < binary.types.size())
+                        {
+                            for (const auto &function : binary.types[instance.type].functions)
+                            {
+                                paths.push_back(binary.imports[instance.import].name + "#" + function.first);
+                            }
+                        }
+                    }
+                    for (const FunctionDefinition &function : binary.functions)
+                    {
+                        if (function.kind == FunctionDefinition::Kind::Import)
+                        {
+                            paths.push_back(binary.imports[function.import].name);
+                        }
+                    }
+                    return paths;
+                }
+
+                // Providers before their importers, otherwise in input order
+                bool sort()
+                {
+                    const size_t count = binaries_.size();
+                    std::vector<std::set<uint32_t>> dependents(count);
+                    std::vector<uint32_t> pending(count, 0);
+                    for (uint32_t c = 0; c < count; ++c)
+                    {
+                        std::set<uint32_t> providers;
+                        for (const std::string &path : import_paths(*binaries_[c]))
+                        {
+                            auto provider = provider_.find(path);
+                            if (provider != provider_.end())
+                            {
+                                providers.insert(provider->second.first);
+                            }
+                        }
+                        for (uint32_t provider : providers)
+                        {
+                            dependents[provider].insert(c);
+                            ++pending[c];
+                        }
+                    }
+
+                    std::vector<bool> placed(count, false);
+                    while (order_.size() < count)
+                    {
+                        uint32_t next = 0;
+                        while (next < count && (placed[next] || pending[next] != 0))
+                        {
+                            ++next;
+                        }
+                        if (next == count)
+                        {
+                            return fail(wasm::ErrorCode::CircularDependency, "Components import each other");
+                        }
+                        placed[next] = true;
+                        order_.push_back(next);
+                        for (uint32_t dependent : dependents[next])
+                        {
+                            --pending[dependent];
+                        }
+                    }
+                    return true;
+                }
+
+                // -------------------------------------------------------------
+                // Resolution
+                // -------------------------------------------------------------
+
+                uint32_t function_import(const std::string &module, const std::string &field,
+                                         const wasm::FunctionType &type)
+                {
+                    auto key = std::make_pair(module, field);
+                    auto it = import_index_.find(key);
+                    if (it != import_index_.end())
+                    {
+                        return it->second;
+                    }
+                    const uint32_t index = static_cast<uint32_t>(imports_.size());
+                    imports_.push_back(FunctionImport{module, field, type});
+                    import_index_.emplace(std::move(key), index);
+                    return index;
+                }
+
+                void add_export(const std::string &name, const Ref &function)
+                {
+                    if (exported_.insert(name).second)
+                    {
+                        exports_.emplace_back(name, function);
+                    }
+                }
+
+                const wasm::FunctionType &core_type(const Ref &function) const
+                {
+                    if (function.imported)
+                    {
+                        return imports_[function.index].type;
+                    }
+                    const wasm::Module &module = units_[function.unit].module;
+                    return module.types[module.functions[function.index].type_index];
+                }
+
+                // Item index of a unit's own index space
+                bool unit_item(uint32_t unit, size_t space, uint32_t index, Ref &ref)
+                {
+                    const std::vector<Ref> &imports = units_[unit].imports[space];
+                    if (index < imports.size())
+                    {
+                        ref = imports[index];
+                        return true;
+                    }
+                    index -= static_cast<uint32_t>(imports.size());
+                    if (index >= defined_count(units_[unit].module, space))
+                    {
+                        return fail(wasm::ErrorCode::InvalidModule, "Core export index out of range");
+                    }
+                    ref = Ref{false, unit, index};
+                    return true;
+                }
+
+                bool instance_export(uint32_t component, uint32_t instance, size_t space, const std::string &name,
+                                     const wasm::FunctionType *expected, Ref &ref)
+                {
+                    const ComponentBinary &binary = *binaries_[component];
+                    if (instance >= binary.core_instances.size())
+                    {
+                        return fail(wasm::ErrorCode::InvalidModule, "Undefined core instance");
+                    }
+                    const CoreInstanceDefinition &definition = binary.core_instances[instance];
+                    if (definition.kind == CoreInstanceDefinition::Kind::Instantiate)
+                    {
+                        const uint32_t unit = unit_of_[component][instance];
+                        const wasm::Export *exported = units_[unit].module.find_export(name);
+                        if (!exported || static_cast<size_t>(exported->kind) != space)
+                        {
+                            return fail(wasm::ErrorCode::ExportNotFound, "Core instance has no such export");
+                        }
+                        return unit_item(unit, space, exported->index, ref);
+                    }
+                    for (const auto &item : definition.exports)
+                    {
+                        if (item.first == name)
+                        {
+                            if (static_cast<size_t>(item.second.sort) != space)
+                            {
+                                return fail(wasm::ErrorCode::TypeMismatch, "Core export has a different kind");
+                            }
+                            return core_item(component, space, item.second.index, expected, ref);
+                        }
+                    }
+                    return fail(wasm::ErrorCode::ExportNotFound, "Core instance has no such export");
+                }
+
+                // Entry of a component's core func, table, memory or global space
+                bool core_item(uint32_t component, size_t space, uint32_t index, const wasm::FunctionType *expected,
+                               Ref &ref)
+                {
+                    const ComponentBinary &binary = *binaries_[component];
+                    const std::vector<CoreItemDefinition> *items[] = {&binary.core_functions, &binary.core_tables,
+                                                                      &binary.core_memories, &binary.core_globals};
+                    if (index >= items[space]->size())
+                    {
+                        return fail(wasm::ErrorCode::InvalidModule, "Undefined core item");
+                    }
+                    const CoreItemDefinition &definition = (*items[space])[index];
+                    switch (definition.kind)
+                    {
+                    case CoreItemDefinition::Kind::Alias:
+                        return instance_export(component, definition.instance, space, definition.name, expected, ref);
+                    case CoreItemDefinition::Kind::Lower:
+                        return lower(component, definition, expected, ref);
+                    default:
+                        return fail(wasm::ErrorCode::UnsupportedInstruction, "Resource builtins are not supported");
+                    }
+                }
+
+                // Follows a component function to its lift, or to the host
+                bool component_function(uint32_t component, uint32_t index, Callee &callee)
+                {
+                    const ComponentBinary &binary = *binaries_[component];
+                    if (index >= binary.functions.size())
+                    {
+                        return fail(wasm::ErrorCode::InvalidFunctionIndex, "Undefined component function");
+                    }
+                    const FunctionDefinition &function = binary.functions[index];
+                    switch (function.kind)
+                    {
+                    case FunctionDefinition::Kind::Lift:
+                        if (function.type >= binary.types.size() ||
+                            binary.types[function.type].kind != TypeDefinition::Kind::Function)
+                        {
+                            return fail(wasm::ErrorCode::InvalidTypeIndex, "Lift without a function type");
+                        }
+                        callee.component = component;
+                        callee.lift = &function;
+                        callee.path = names_[component] + "/lift" + std::to_string(index);
+                        callee.type = binary.types[function.type].function;
+                        return true;
+                    case FunctionDefinition::Kind::Import:
+                        if (function.type >= binary.types.size() ||
+                            binary.types[function.type].kind != TypeDefinition::Kind::Function)
+                        {
+                            return fail(wasm::ErrorCode::InvalidTypeIndex, "Function import without a function type");
+                        }
+                        return provided(binary.imports[function.import].name, binary.types[function.type].function,
+                                        callee);
+                    default:
+                        break;
+                    }
+
+                    if (function.instance >= binary.instances.size())
+                    {
+                        return fail(wasm::ErrorCode::InvalidModule, "Alias of an undefined instance");
+                    }
+                    const InstanceDefinition &instance = binary.instances[function.instance];
+                    if (instance.kind == InstanceDefinition::Kind::Import)
+                    {
+                        if (instance.type < binary.types.size())
+                        {
+                            for (const auto &exported : binary.types[instance.type].functions)
+                            {
+                                if (exported.first == function.name)
+                                {
+                                    return provided(binary.imports[instance.import].name + "#" + function.name,
+                                                    exported.second, callee);
+                                }
+                            }
+                        }
+                        return fail(wasm::ErrorCode::ExportNotFound, "Imported instance type has no such function");
+                    }
+                    for (const auto &item : instance.exports)
+                    {
+                        if (item.first == function.name && item.second.sort == Sort::Func)
+                        {
+                            return component_function(component, item.second.index, callee);
+                        }
+                    }
+                    return fail(wasm::ErrorCode::ExportNotFound, "Instance has no such function");
+                }
+
+                bool provided(const std::string &path, const FunctionType &type, Callee &callee)
+                {
+                    auto provider = provider_.find(path);
+                    if (provider == provider_.end())
+                    {
+                        callee = Callee{NONE, nullptr, path, type};
+                        return true;
+                    }
+                    if (!component_function(provider->second.first, provider->second.second, callee))
+                    {
+                        return false;
+                    }
+                    if (!signatures_.satisfies(signatures_.intern(type), signatures_.intern(callee.type)))
+                    {
+                        return fail(wasm::ErrorCode::TypeMismatch, "Import and export signatures differ");
+                    }
+                    callee.path = path;
+                    return true;
+                }
+
+                bool lower(uint32_t component, const CoreItemDefinition &definition,
+                           const wasm::FunctionType *expected, Ref &ref)
+                {
+                    if (!expected)
+                    {
+                        return fail(wasm::ErrorCode::ImportResolutionFailed,
+                                    "Lowered function is not used as a function import");
+                    }
+                    Callee callee;
+                    if (!component_function(component, definition.function, callee))
+                    {
+                        return false;
+                    }
+
+                    if (callee.component == NONE)
+                    {
+                        const size_t hash = callee.path.find('#');
+                        const std::string module = hash == std::string::npos ? "$root" : callee.path.substr(0, hash);
+                        const std::string field =
+                            hash == std::string::npos ? callee.path : callee.path.substr(hash + 1);
+                        ref = Ref{true, 0, function_import(module, field, *expected)};
+                        return true;
+                    }
+
+                    Ref target;
+                    if (!core_item(callee.component, FUNC, callee.lift->core_function, nullptr, target))
+                    {
+                        return false;
+                    }
+                    if (fusable(callee.type) && callee.lift->options.post_return == CanonOptions::NONE &&
+                        same_core_type(core_type(target), *expected))
+                    {
+                        ++direct_imports_;
+                        ref = target;
+                        return true;
+                    }
+                    ++adapted_imports_;
+                    add_export(callee.path, target);
+                    ref = Ref{true, 0, function_import("flight:adapter", names_[component] + "/" + callee.path,
+                                                       *expected)};
+                    return true;
+                }
+
+                // -------------------------------------------------------------
+                // Instantiation
+                // -------------------------------------------------------------
+
+                bool instantiate(uint32_t component)
+                {
+                    const ComponentBinary &binary = *binaries_[component];
+                    unit_of_[component].assign(binary.core_instances.size(), NONE);
+
+                    for (uint32_t instance = 0; instance < binary.core_instances.size(); ++instance)
+                    {
+                        const CoreInstanceDefinition &definition = binary.core_instances[instance];
+                        if (definition.kind != CoreInstanceDefinition::Kind::Instantiate)
+                        {
+                            continue;
+                        }
+                        if (definition.module >= binary.core_module_count())
+                        {
+                            return fail(wasm::ErrorCode::InvalidModule, "Instantiation of an undefined core module");
+                        }
+                        wasm::BinaryParser::ParseOptions parse;
+                        parse.zero_copy = true;
+                        auto parsed = wasm::BinaryParser::parse(binary.core_module(definition.module), parse);
+                        if (!parsed)
+                        {
+                            error_ = parsed.error();
+                            return false;
+                        }
+
+                        const uint32_t unit = static_cast<uint32_t>(units_.size());
+                        units_.push_back(Unit());
+                        units_[unit].component = component;
+                        units_[unit].module = std::move(parsed).value();
+                        unit_of_[component][instance] = unit;
+
+                        const wasm::Module &module = units_[unit].module;
+                        for (const wasm::Import &import : module.imports)
+                        {
+                            auto argument = std::find_if(definition.args.begin(), definition.args.end(),
+                                                         [&](const std::pair<std::string, uint32_t> &arg) {
+                                                             return arg.first == import.module_name;
+                                                         });
+                            if (argument == definition.args.end())
+                            {
+                                return fail(wasm::ErrorCode::ImportResolutionFailed,
+                                            "Core import has no instantiation argument");
+                            }
+                            const size_t space = static_cast<size_t>(import.kind);
+                            const wasm::FunctionType *expected =
+                                space == FUNC ? &module.types[import.descriptor.function_type_index] : nullptr;
+                            Ref ref;
+                            if (!instance_export(component, argument->second, space, std::string(import.field_name),
+                                                 expected, ref))
+                            {
+                                return false;
+                            }
+                            if (space == FUNC && !same_core_type(core_type(ref), *expected))
+                            {
+                                return fail(wasm::ErrorCode::TypeMismatch, "Core function import has a different type");
+                            }
+                            units_[unit].imports[space].push_back(ref);
+                        }
+
+                        const std::vector<Ref> &memories = units_[unit].imports[MEMORY];
+                        if (memories.size() + module.memories.size() > 1)
+                        {
+                            return fail(wasm::ErrorCode::UnsupportedInstruction, "Multiple memories are not supported");
+                        }
+                        if (!module.memories.empty())
+                        {
+                            // Placed by the layout planner once every memory is known
+                            units_[unit].segment = planner_.add(names_[component], module.memories[0].limits);
+                            segments_.push_back(Segment());
+                        }
+                        else if (!memories.empty())
+                        {
+                            units_[unit].segment = units_[memories[0].unit].segment;
+                        }
+                    }
+                    return true;
+                }
+
+                bool export_lift(uint32_t component, uint32_t index, const std::string &name)
+                {
+                    Callee callee;
+                    if (!component_function(component, index, callee))
+                    {
+                        return false;
+                    }
+                    if (callee.component == NONE)
+                    {
+                        return true; // A re-exported host import
+                    }
+                    Ref target;
+                    if (!core_item(callee.component, FUNC, callee.lift->core_function, nullptr, target))
+                    {
+                        return false;
+                    }
+                    add_export(name, target);
+                    return true;
+                }
+
+                bool export_component(uint32_t component)
+                {
+                    const ComponentBinary &binary = *binaries_[component];
+                    for (const ExportDefinition &definition : binary.exports)
+                    {
+                        if (definition.item.sort == Sort::Func)
+                        {
+                            if (!export_lift(component, definition.item.index, definition.name))
+                            {
+                                return false;
+                            }
+                        }
+                        else if (definition.item.sort == Sort::Instance &&
+                                 definition.item.index < binary.instances.size() &&
+                                 binary.instances[definition.item.index].kind == InstanceDefinition::Kind::Exports)
+                        {
+                            for (const auto &item : binary.instances[definition.item.index].exports)
+                            {
+                                if (item.second.sort == Sort::Func &&
+                                    !export_lift(component, item.second.index, definition.name + "#" + item.first))
+                                {
+                                    return false;
+                                }
+                            }
+                        }
+                    }
+
+                    // The allocator adapters use to pass data into this component
+                    for (const FunctionDefinition &function : binary.functions)
+                    {
+                        if (function.kind == FunctionDefinition::Kind::Lift &&
+                            function.options.realloc != CanonOptions::NONE)
+                        {
+                            Ref realloc;
+                            if (!core_item(component, FUNC, function.options.realloc, nullptr, realloc))
+                            {
+                                return false;
+                            }
+                            add_export("flight:realloc/" + names_[component], realloc);
+                            break;
+                        }
+                    }
+                    return true;
+                }
+
+                // -------------------------------------------------------------
+                // Assembly
+                // -------------------------------------------------------------
+
+                uint32_t type_index(wasm::Module &module, const wasm::FunctionType &type)
+                {
+                    auto key = std::make_pair(type.params, type.results);
+                    auto it = types_.find(key);
+                    if (it != types_.end())
+                    {
+                        return it->second;
+                    }
+                    const uint32_t index = static_cast<uint32_t>(module.types.size());
+                    module.types.push_back(type);
+                    types_.emplace(std::move(key), index);
+                    return index;
+                }
+
+                uint32_t function_index(const Ref &ref) const
+                {
+                    return ref.imported ? ref.index : units_[ref.unit].function_base + ref.index;
+                }
+
+                Remap remap(wasm::Module &merged, const Unit &unit)
+                {
+                    Remap remap;
+                    for (const Ref &ref : unit.imports[FUNC])
+                    {
+                        remap.functions.push_back(function_index(ref));
+                    }
+                    for (uint32_t i = 0; i < unit.module.functions.size(); ++i)
+                    {
+                        remap.functions.push_back(unit.function_base + i);
+                    }
+                    for (const Ref &ref : unit.imports[TABLE])
+                    {
+                        remap.tables.push_back(units_[ref.unit].table_base + ref.index);
+                    }
+                    for (uint32_t i = 0; i < unit.module.tables.size(); ++i)
+                    {
+                        remap.tables.push_back(unit.table_base + i);
+                    }
+                    for (const Ref &ref : unit.imports[GLOBAL])
+                    {
+                        remap.globals.push_back(units_[ref.unit].global_base + ref.index);
+                    }
+                    for (uint32_t i = 0; i < unit.module.globals.size(); ++i)
+                    {
+                        remap.globals.push_back(unit.global_base + i);
+                    }
+                    for (const wasm::FunctionType &type : unit.module.types)
+                    {
+                        remap.types.push_back(type_index(merged, type));
+                    }
+                    remap.data_base = unit.data_base;
+                    remap.element_base = unit.element_base;
+                    remap.segment = unit.segment == NONE ? nullptr : &segments_[unit.segment];
+                    remap.bounds_checks = bounds_checks_;
+                    return remap;
+                }
+
+                bool rewrite(const Remap &remap, wasm::span<const uint8_t> code, std::vector<uint8_t> &out,
+                             bool *used_scratch = nullptr)
+                {
+                    CodeRewriter rewriter(remap, code);
+                    wasm::BinaryWriter writer;
+                    if (!rewriter.run(writer))
+                    {
+                        error_ = rewriter.error();
+                        return false;
+                    }
+                    if (used_scratch)
+                    {
+                        *used_scratch = rewriter.used_scratch();
+                    }
+                    out = writer.take();
+                    return true;
+                }
+
+                // Active data offsets must be i32 constants, rebased onto the
+                // segment; data past the segment's initial size would land in
+                // the next segment instead of failing instantiation
+                bool data_offset(const Remap &remap, const std::vector<uint8_t> &offset, size_t size,
+                                 std::vector<uint8_t> &out)
+                {
+                    wasm::BinaryReader reader(offset);
+                    auto opcode = reader.read_byte();
+                    auto value = reader.read_leb128_i32();
+                    auto end = reader.read_byte();
+                    if (!opcode || opcode.value() != 0x41 || !value || !end || end.value() != 0x0B)
+                    {
+                        return fail(wasm::ErrorCode::UnsupportedInstruction,
+                                    "Data segment offsets must be i32 constants");
+                    }
+                    const MemorySegment &layout = remap.segment->layout;
+                    const uint64_t start = static_cast<uint32_t>(value.value());
+                    if (start + size > layout.initial_pages * PAGE_SIZE)
+                    {
+                        return fail(wasm::ErrorCode::InvalidModule, "Data segment exceeds its memory");
+                    }
+                    const uint64_t rebased = start + layout.base;
+                    if (rebased > 0xFFFFFFFFull)
+                    {
+                        return fail(wasm::ErrorCode::MemoryLimitExceeded, "Rebased data offset exceeds 4 GiB");
+                    }
+                    wasm::BinaryWriter writer;
+                    writer.write_byte(0x41);
+                    writer.write_leb128_i32(static_cast<int32_t>(static_cast<uint32_t>(rebased)));
+                    writer.write_byte(0x0B);
+                    out = writer.take();
+                    return true;
+                }
+
+                // memory.grow of a segment: grows within its reserve, growing
+                // the flattened memory when the segment reaches its end. The
+                // end of a segment of n pages is page ceil(base / 64 KiB) + n.
+                wasm::Function grow_function(const Segment &segment) const
+                {
+                    const MemorySegment &layout = segment.layout;
+                    wasm::BinaryWriter body;
+                    auto op = [&](uint8_t opcode, uint32_t immediate) {
+                        body.write_byte(opcode);
+                        body.write_leb128_u32(immediate);
+                    };
+                    auto i32_const = [&](uint32_t value) {
+                        body.write_byte(0x41);
+                        body.write_leb128_i32(static_cast<int32_t>(value));
+                    };
+
+                    op(0x23, segment.pages_global); // old = pages
+                    op(0x21, 1);
+                    op(0x20, 0); // if (delta > reserved - old) return -1
+                    i32_const(layout.reserved_pages);
+                    op(0x20, 1);
+                    body.write_byte(0x6B);
+                    body.write_byte(0x4B);
+                    op(0x04, 0x40);
+                    i32_const(0xFFFFFFFF);
+                    body.write_byte(0x0F);
+                    body.write_byte(0x0B);
+                    // missing = base + old + delta - memory.size
+                    i32_const(static_cast<uint32_t>((layout.base + PAGE_SIZE - 1) / PAGE_SIZE));
+                    op(0x20, 1);
+                    body.write_byte(0x6A);
+                    op(0x20, 0);
+                    body.write_byte(0x6A);
+                    op(0x3F, 0);
+                    body.write_byte(0x6B);
+                    op(0x22, 2);
+                    i32_const(0);
+                    body.write_byte(0x4A);
+                    op(0x04, 0x40); // if (missing > 0 && memory.grow(missing) == -1) return -1
+                    op(0x20, 2);
+                    op(0x40, 0);
+                    i32_const(0xFFFFFFFF);
+                    body.write_byte(0x46);
+                    op(0x04, 0x40);
+                    i32_const(0xFFFFFFFF);
+                    body.write_byte(0x0F);
+                    body.write_byte(0x0B);
+                    body.write_byte(0x0B);
+                    op(0x20, 1); // pages = old + delta; return old
+                    op(0x20, 0);
+                    body.write_byte(0x6A);
+                    op(0x24, segment.pages_global);
+                    op(0x20, 1);
+                    body.write_byte(0x0B);
+                    return wasm::Function(0, {wasm::ValueType::I32, wasm::ValueType::I32}, body.take());
+                }
+
+                bool assemble(FlattenResult &result)
+                {
+                    wasm::Module &merged = result.module;
+
+                    for (const FunctionImport &import : imports_)
+                    {
+                        merged.imports.emplace_back(merged.intern(import.module), merged.intern(import.field),
+                                                    wasm::Import::Kind::Function,
+                                                    wasm::Import::Descriptor(type_index(merged, import.type)));
+                        if (import.module != "flight:adapter")
+                        {
+                            ++result.host_imports;
+                        }
+                    }
+
+                    // Index space layout: imports, unit functions, grow helpers, start
+                    uint32_t functions = static_cast<uint32_t>(imports_.size());
+                    uint32_t tables = 0;
+                    uint32_t globals = 0;
+                    uint32_t data = 0;
+                    uint32_t elements = 0;
+                    for (Unit &unit : units_)
+                    {
+                        unit.function_base = functions;
+                        unit.table_base = tables;
+                        unit.global_base = globals;
+                        unit.data_base = data;
+                        unit.element_base = elements;
+                        functions += static_cast<uint32_t>(unit.module.functions.size());
+                        tables += static_cast<uint32_t>(unit.module.tables.size());
+                        globals += static_cast<uint32_t>(unit.module.globals.size());
+                        data += static_cast<uint32_t>(unit.module.data.size());
+                        elements += static_cast<uint32_t>(unit.module.elements.size());
+                    }
+                    for (Segment &segment : segments_)
+                    {
+                        segment.grow_function = functions++;
+                        segment.pages_global = globals++;
+                        segment.base_global = globals++;
+                    }
+
+                    std::vector<uint32_t> starts;
+                    for (Unit &unit : units_)
+                    {
+                        Remap map = remap(merged, unit);
+                        const wasm::Module &module = unit.module;
+
+                        for (const wasm::Function &function : module.functions)
+                        {
+                            map.scratch = static_cast<uint32_t>(module.types[function.type_index].params.size() +
+                                                                function.locals.size());
+                            wasm::Function rewritten(map.types[function.type_index], function.locals, {});
+                            bool scratch = false;
+                            if (!rewrite(map, function.body(), rewritten.body_bytes, &scratch))
+                            {
+                                return false;
+                            }
+                            if (scratch)
+                            {
+                                rewritten.locals.insert(rewritten.locals.end(), std::begin(SCRATCH_LOCALS),
+                                                        std::end(SCRATCH_LOCALS));
+                            }
+                            merged.function_type_indices.push_back(rewritten.type_index);
+                            merged.functions.push_back(std::move(rewritten));
+                        }
+                        for (const wasm::TableType &table : module.tables)
+                        {
+                            merged.tables.push_back(table);
+                        }
+                        for (const wasm::Global &global : module.globals)
+                        {
+                            wasm::Global rewritten(global.type, {});
+                            if (!rewrite(map, global.initializer_bytes, rewritten.initializer_bytes))
+                            {
+                                return false;
+                            }
+                            merged.globals.push_back(std::move(rewritten));
+                        }
+                        for (const wasm::Element &element : module.elements)
+                        {
+                            wasm::Element rewritten = element;
+                            if (element.mode == wasm::Element::Mode::Active)
+                            {
+                                rewritten.table_index = map.tables[element.table_index];
+                                if (!rewrite(map, element.offset_bytes, rewritten.offset_bytes))
+                                {
+                                    return false;
+                                }
+                            }
+                            for (uint32_t &function : rewritten.function_indices)
+                            {
+                                if (function >= map.functions.size())
+                                {
+                                    return fail(wasm::ErrorCode::InvalidFunctionIndex,
+                                                "Element segment function out of range");
+                                }
+                                function = map.functions[function];
+                            }
+                            merged.elements.push_back(std::move(rewritten));
+                        }
+                        for (const wasm::Data &segment : module.data)
+                        {
+                            wasm::Data rewritten;
+                            rewritten.mode = segment.mode;
+                            rewritten.memory_index = 0;
+                            const wasm::span<const uint8_t> bytes = segment.bytes();
+                            rewritten.data.assign(bytes.begin(), bytes.end());
+                            if (segment.mode == wasm::Data::Mode::Active)
+                            {
+                                if (!map.segment)
+                                {
+                                    return fail(wasm::ErrorCode::InvalidMemoryIndex, "Data segment without a memory");
+                                }
+                                if (!data_offset(map, segment.offset_bytes, bytes.size(), rewritten.offset_bytes))
+                                {
+                                    return false;
+                                }
+                            }
+                            merged.data.push_back(std::move(rewritten));
+                        }
+                        if (module.has_data_count)
+                        {
+                            merged.has_data_count = true;
+                        }
+                        if (module.has_start_function)
+                        {
+                            starts.push_back(map.functions[module.start_function_index]);
+                        }
+                    }
+                    merged.data_count = static_cast<uint32_t>(merged.data.size());
+
+                    // Segments: one memory, size and grow per segment
+                    if (!segments_.empty())
+                    {
+                        const uint32_t grow = type_index(merged, wasm::FunctionType({wasm::ValueType::I32},
+                                                                                    {wasm::ValueType::I32}));
+                        std::vector<wasm::Global> segment_globals;
+                        std::map<std::string, uint32_t> numbers;
+                        for (const Segment &segment : segments_)
+                        {
+                            wasm::Function function = grow_function(segment);
+                            function.type_index = grow;
+                            merged.function_type_indices.push_back(grow);
+                            merged.functions.push_back(std::move(function));
+
+                            auto constant = [](uint32_t value) {
+                                wasm::BinaryWriter expression;
+                                expression.write_byte(0x41);
+                                expression.write_leb128_i32(static_cast<int32_t>(value));
+                                expression.write_byte(0x0B);
+                                return expression.take();
+                            };
+                            const MemorySegment &layout = segment.layout;
+                            merged.globals.emplace_back(wasm::GlobalType(wasm::ValueType::I32, true),
+                                                        constant(layout.initial_pages));
+                            merged.globals.emplace_back(
+                                wasm::GlobalType(wasm::ValueType::I32, false),
+                                constant(layout.base));
+                            const std::string name =
+                                "flight:segment/" + layout.component + "/" + std::to_string(numbers[layout.component]++);
+                            merged.exports.emplace_back(merged.intern(name), wasm::Export::Kind::Global,
+                                                        segment.base_global);
+                        }
+                        merged.memories.emplace_back(
+                            wasm::Limits(result.layout.initial_pages(), result.layout.maximum_pages()));
+                        merged.exports.emplace_back("memory", wasm::Export::Kind::Memory, 0);
+                    }
+
+                    if (starts.size() == 1)
+                    {
+                        merged.start_function_index = starts[0];
+                        merged.has_start_function = true;
+                    }
+                    else if (starts.size() > 1)
+                    {
+                        wasm::BinaryWriter body;
+                        for (uint32_t start : starts)
+                        {
+                            body.write_byte(0x10);
+                            body.write_leb128_u32(start);
+                        }
+                        body.write_byte(0x0B);
+                        const uint32_t type = type_index(merged, wasm::FunctionType());
+                        merged.function_type_indices.push_back(type);
+                        merged.functions.emplace_back(type, std::vector<wasm::ValueType>(), body.take());
+                        merged.start_function_index = functions;
+                        merged.has_start_function = true;
+                    }
+
+                    for (const auto &exported : exports_)
+                    {
+                        merged.exports.emplace_back(merged.intern(exported.first), wasm::Export::Kind::Function,
+                                                    function_index(exported.second));
+                    }
+                    merged.index_exports();
+
+                    result.direct_imports = direct_imports_;
+                    result.adapted_imports = adapted_imports_;
+                    return true;
+                }
+
+                std::vector<std::string> names_;
+                std::vector<const ComponentBinary *> binaries_;
+
+                std::map<std::string, std::pair<uint32_t, uint32_t>> provider_; // Path -> component, function
+                TypeInterner signatures_;
+                std::vector<uint32_t> order_;
+                std::vector<Unit> units_;
+                std::vector<std::vector<uint32_t>> unit_of_; // Component, core instance -> unit
+                std::vector<Segment> segments_;
+                LayoutPlanner planner_;
+                bool bounds_checks_;
+
+                std::vector<FunctionImport> imports_;
+                std::map<std::pair<std::string, std::string>, uint32_t> import_index_;
+                std::vector<std::pair<std::string, Ref>> exports_;
+                std::set<std::string> exported_;
+                std::map<std::pair<std::vector<wasm::ValueType>, std::vector<wasm::ValueType>>, uint32_t> types_;
+
+                uint32_t direct_imports_ = 0;
+                uint32_t adapted_imports_ = 0;
+                wasm::Error error_;
+            };
+        } // namespace
+
+        // =====================================================================
+        // Flattener
+        // =====================================================================
+
+        void Flattener::add(std::string name, ComponentBinary component)
+        {
+            components_.push_back(Input{std::move(name), std::move(component)});
+        }
+
+        wasm::Result<FlattenResult> Flattener::flatten() const
+        {
+            std::vector<std::string> names;
+            std::vector<const ComponentBinary *> binaries;
+            for (const Input &input : components_)
+            {
+                names.push_back(input.name);
+                binaries.push_back(&input.binary);
+            }
+            Flattening flattening(options_, std::move(names), std::move(binaries));
+            return flattening.run();
+        }
+
+    } // namespace component
+} // namespace flight
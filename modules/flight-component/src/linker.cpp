@@ -0,0 +1,343 @@
+#include <flight/component/linker.hpp>
+
+#include <algorithm>
+
+namespace flight
+{
+    namespace component
+    {
+
+        namespace
+        {
+            InterfaceType tuple_of(const std::vector<InterfaceType> &types)
+            {
+                return {TypeKind::Tuple, "", types};
+            }
+
+            // -----------------------------------------------------------------
+            // Thunks
+            // -----------------------------------------------------------------
+
+            wasm::Result<void> call_core(const ResolvedImport &import, const InstanceBinding *instances,
+                                         uint32_t, uint64_t *slots)
+            {
+                return import.function(instances[import.callee].instance, slots);
+            }
+
+            wasm::Result<void> call_host(const ResolvedImport &import, const InstanceBinding *instances,
+                                         uint32_t caller, uint64_t *slots)
+            {
+                return import.host(import.host_context, *instances[caller].memory, slots);
+            }
+
+            wasm::Result<void> call_adapted(const ResolvedImport &import, const InstanceBinding *instances,
+                                            uint32_t caller, uint64_t *slots)
+            {
+                const Adapter &adapter = *import.adapter;
+                const InstanceBinding &from = instances[caller];
+                const InstanceBinding &to = instances[import.callee];
+
+                CallScope scope;
+                HandleTransfer handles{from.resources, to.resources, &scope, from.async, to.async};
+                TransferOptions options;
+                if ((from.resources && to.resources) || (from.async && to.async))
+                {
+                    options.translate_handle = &resource_translator;
+                    options.handle_context = &handles;
+                }
+
+                // Within one memory the callee works on the caller's buffers
+                BorrowScope borrows;
+                if (from.memory->base == to.memory->base)
+                {
+                    options.borrows = &borrows;
+                }
+
+                if (adapter.indirect_params)
+                {
+                    auto params = CanonicalABI::transfer_new(*adapter.params, *from.memory,
+                                                             static_cast<uint32_t>(slots[0]), *to.memory, options);
+                    if (!params)
+                    {
+                        return wasm::Result<void>(params.error());
+                    }
+                    slots[0] = params.value();
+                }
+
+                auto called = import.function(to.instance, slots);
+                if (!called)
+                {
+                    return called;
+                }
+                auto released = borrows.release(*from.memory);
+                if (!released)
+                {
+                    return released;
+                }
+
+                if (adapter.indirect_results)
+                {
+                    // Results are always copied: the callee may reuse its buffers
+                    HandleTransfer back{to.resources, from.resources, &scope, to.async, from.async};
+                    options.handle_context = &back;
+                    options.borrows = nullptr;
+                    auto results = CanonicalABI::transfer_new(*adapter.results, *to.memory,
+                                                              static_cast<uint32_t>(slots[0]), *from.memory, options);
+                    if (!results)
+                    {
+                        return wasm::Result<void>(results.error());
+                    }
+                    slots[0] = results.value();
+                }
+                return scope.finish();
+            }
+        } // namespace
+
+        bool same_type(const InterfaceType &a, const InterfaceType &b)
+        {
+            if (a.kind != b.kind || a.params.size() != b.params.size())
+            {
+                return false;
+            }
+            const bool named = a.kind == TypeKind::Record || a.kind == TypeKind::Variant ||
+                               a.kind == TypeKind::Enum || a.kind == TypeKind::Flags;
+            for (size_t i = 0; i < a.params.size(); ++i)
+            {
+                if (named && a.params[i].name != b.params[i].name)
+                {
+                    return false;
+                }
+                if (!same_type(a.params[i], b.params[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool same_signature(const FunctionType &a, const FunctionType &b)
+        {
+            auto same_types = [](const std::vector<InterfaceType> &x, const std::vector<InterfaceType> &y) {
+                if (x.size() != y.size())
+                {
+                    return false;
+                }
+                for (size_t i = 0; i < x.size(); ++i)
+                {
+                    if (!same_type(x[i], y[i]))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            return same_types(a.params, b.params) && same_types(a.results, b.results);
+        }
+
+        // =====================================================================
+        // AdapterCache
+        // =====================================================================
+
+        std::shared_ptr<const Adapter> AdapterCache::adapter(const FunctionType &type)
+        {
+            auto params = abi_.plan(tuple_of(type.params));
+            auto results = abi_.plan(tuple_of(type.results));
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto key = std::make_pair(params.get(), results.get());
+            auto it = adapters_.find(key);
+            if (it != adapters_.end())
+            {
+                return it->second;
+            }
+            auto adapter = std::make_shared<Adapter>();
+            adapter->indirect_params = !params->trivially_copyable();
+            adapter->indirect_results = !results->trivially_copyable();
+            adapter->params = std::move(params);
+            adapter->results = std::move(results);
+            adapters_.emplace(key, adapter);
+            return adapter;
+        }
+
+        size_t AdapterCache::size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return adapters_.size();
+        }
+
+        // =====================================================================
+        // LinkedGraph
+        // =====================================================================
+
+        wasm::Result<uint32_t> LinkedGraph::component_index(const std::string &name) const
+        {
+            for (size_t i = 0; i < components_.size(); ++i)
+            {
+                if (components_[i]->name == name)
+                {
+                    return static_cast<uint32_t>(i);
+                }
+            }
+            return wasm::make_error<uint32_t>(wasm::ErrorCode::ExportNotFound, "No component with this name");
+        }
+
+        wasm::Result<uint32_t> LinkedGraph::import_index(uint32_t component, const std::string &name) const
+        {
+            const std::vector<ComponentImport> &imports = components_[component]->imports;
+            for (size_t i = 0; i < imports.size(); ++i)
+            {
+                if (imports[i].name == name)
+                {
+                    return static_cast<uint32_t>(i);
+                }
+            }
+            return wasm::make_error<uint32_t>(wasm::ErrorCode::ImportResolutionFailed, "No import with this name");
+        }
+
+        wasm::Result<uint32_t> LinkedGraph::export_index(uint32_t component, const std::string &name) const
+        {
+            const std::vector<ComponentExport> &exports = components_[component]->exports;
+            for (size_t i = 0; i < exports.size(); ++i)
+            {
+                if (exports[i].name == name)
+                {
+                    return static_cast<uint32_t>(i);
+                }
+            }
+            return wasm::make_error<uint32_t>(wasm::ErrorCode::ExportNotFound, "No export with this name");
+        }
+
+        wasm::Result<LinkedInstance> LinkedGraph::instantiate(const std::vector<InstanceBinding> &bindings) const
+        {
+            if (bindings.size() != components_.size())
+            {
+                return wasm::make_error<LinkedInstance>(wasm::ErrorCode::ModuleInstantiationFailed,
+                                                        "One binding per component is required");
+            }
+            for (const InstanceBinding &binding : bindings)
+            {
+                if (!binding.memory)
+                {
+                    return wasm::make_error<LinkedInstance>(wasm::ErrorCode::ModuleInstantiationFailed,
+                                                            "Instance binding without a memory");
+                }
+            }
+            return LinkedInstance(shared_from_this(), bindings);
+        }
+
+        // =====================================================================
+        // Linker
+        // =====================================================================
+
+        wasm::Result<void> Linker::define_host(const std::string &name, const FunctionType &type,
+                                               HostFunction function, void *context)
+        {
+            if (!function)
+            {
+                return wasm::Result<void>(wasm::ErrorCode::ImportResolutionFailed, "Host function is null");
+            }
+            hosts_[name] = HostDefinition{type, types_.intern(type), function, context};
+            return wasm::Result<void>();
+        }
+
+        uint32_t Linker::add(std::shared_ptr<const ComponentDefinition> component)
+        {
+            signature_offsets_.push_back(static_cast<uint32_t>(signatures_.size()));
+            for (const ComponentImport &import : component->imports)
+            {
+                signatures_.push_back(types_.intern(import.type));
+            }
+            for (const ComponentExport &definition : component->exports)
+            {
+                signatures_.push_back(types_.intern(definition.type));
+            }
+            components_.push_back(std::move(component));
+            return static_cast<uint32_t>(components_.size() - 1);
+        }
+
+        wasm::Result<std::shared_ptr<const LinkedGraph>> Linker::link() const
+        {
+            using LinkResult = std::shared_ptr<const LinkedGraph>;
+
+            auto graph = std::make_shared<LinkedGraph>();
+            graph->components_ = components_;
+            graph->import_offsets_.reserve(components_.size());
+
+            // Most recent exporter of each name among the components so far,
+            // as component and export index
+            std::map<std::string, std::pair<uint32_t, uint32_t>> exported;
+
+            for (uint32_t index = 0; index < components_.size(); ++index)
+            {
+                const ComponentDefinition &component = *components_[index];
+                graph->import_offsets_.push_back(static_cast<uint32_t>(graph->imports_.size()));
+
+                const Signature *imports = &signatures_[signature_offsets_[index]];
+
+                for (size_t i = 0; i < component.imports.size(); ++i)
+                {
+                    const ComponentImport &import = component.imports[i];
+                    ResolvedImport resolved{};
+                    auto provider = exported.find(import.name);
+                    if (provider != exported.end())
+                    {
+                        const uint32_t callee = provider->second.first;
+                        const uint32_t function = provider->second.second;
+                        const Signature &target = signatures_[signature_offsets_[callee] +
+                                                              components_[callee]->imports.size() + function];
+                        if (!types_.satisfies(imports[i], target))
+                        {
+                            return wasm::make_error<LinkResult>(wasm::ErrorCode::TypeMismatch,
+                                                                "Import and export signatures differ");
+                        }
+                        auto adapter = adapters_.adapter(import.type);
+                        resolved.callee = callee;
+                        resolved.function = components_[callee]->exports[function].function;
+                        if (adapter->direct())
+                        {
+                            resolved.thunk = &call_core;
+                            resolved.target = ImportTarget::Core;
+                        }
+                        else
+                        {
+                            resolved.thunk = &call_adapted;
+                            resolved.target = ImportTarget::Adapter;
+                            resolved.adapter = adapter.get();
+                            if (std::find(graph->adapters_.begin(), graph->adapters_.end(), adapter) ==
+                                graph->adapters_.end())
+                            {
+                                graph->adapters_.push_back(std::move(adapter));
+                            }
+                        }
+                    }
+                    else
+                    {
+                        auto host = hosts_.find(import.name);
+                        if (host == hosts_.end())
+                        {
+                            return wasm::make_error<LinkResult>(wasm::ErrorCode::ImportResolutionFailed,
+                                                                "Import has no provider");
+                        }
+                        if (!types_.satisfies(imports[i], host->second.signature))
+                        {
+                            return wasm::make_error<LinkResult>(wasm::ErrorCode::TypeMismatch,
+                                                                "Import and host function signatures differ");
+                        }
+                        resolved.thunk = &call_host;
+                        resolved.target = ImportTarget::Host;
+                        resolved.host = host->second.function;
+                        resolved.host_context = host->second.context;
+                    }
+                    graph->imports_.push_back(resolved);
+                }
+
+                for (uint32_t i = 0; i < component.exports.size(); ++i)
+                {
+                    exported[component.exports[i].name] = std::make_pair(index, i);
+                }
+            }
+            return LinkResult(std::move(graph));
+        }
+
+    } // namespace component
+} // namespace flight
@@ -0,0 +1,199 @@
+#include <flight/component/memory_layout.hpp>
+
+#include <algorithm>
+
+namespace flight
+{
+    namespace component
+    {
+
+        namespace
+        {
+            constexpr uint64_t PAGE_SIZE = MemoryLayout::PAGE_SIZE;
+            constexpr uint64_t MAX_PAGES = 65536;
+
+            uint64_t align_up(uint64_t value, uint64_t alignment)
+            {
+                return (value + alignment - 1) & ~(alignment - 1);
+            }
+
+            uint32_t pages_spanning(uint64_t bytes)
+            {
+                return static_cast<uint32_t>((bytes + PAGE_SIZE - 1) / PAGE_SIZE);
+            }
+        } // namespace
+
+        // =====================================================================
+        // PlatformProfile
+        // =====================================================================
+
+        // 16 MiB of main RAM; SH-4 cache lines are 32 bytes
+        PlatformProfile PlatformProfile::dreamcast()
+        {
+            return PlatformProfile{"dreamcast", 16ull << 20, 32, 4096, 4};
+        }
+
+        // 32 MiB of main RAM (PSP-2000 and later); 64-byte cache lines
+        PlatformProfile PlatformProfile::psp()
+        {
+            return PlatformProfile{"psp", 32ull << 20, 64, 4096, 8};
+        }
+
+        PlatformProfile PlatformProfile::vita()
+        {
+            return PlatformProfile{"vita", 512ull << 20, 4096, 16384, 16};
+        }
+
+        // Page-aligned segments with a guard page, as on wasm engines that
+        // map the whole 4 GiB address space
+        PlatformProfile PlatformProfile::desktop()
+        {
+            return PlatformProfile();
+        }
+
+        PlatformProfile PlatformProfile::of(wasm::platform::Platform platform)
+        {
+            switch (platform)
+            {
+            case wasm::platform::Platform::Dreamcast:
+                return dreamcast();
+            case wasm::platform::Platform::PSP:
+                return psp();
+            case wasm::platform::Platform::PSVita:
+                return vita();
+            default:
+                return desktop();
+            }
+        }
+
+        bool PlatformProfile::named(const std::string &name, PlatformProfile &profile)
+        {
+            for (const PlatformProfile &candidate : {dreamcast(), psp(), vita(), desktop()})
+            {
+                if (name == candidate.name)
+                {
+                    profile = candidate;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // =====================================================================
+        // MemoryLayout
+        // =====================================================================
+
+        // Branchless binary search for the last base at or below address:
+        // host addresses are effectively random, so a branching search
+        // mispredicts about every other step
+        uint32_t MemoryLayout::segment_of(uint64_t address) const noexcept
+        {
+            size_t count = bases_.size();
+            if (count == 0 || address < bases_[0])
+            {
+                return NONE;
+            }
+            const uint32_t *first = bases_.data();
+            while (count > 1)
+            {
+                const size_t half = count / 2;
+                first = first[half] <= address ? first + half : first;
+                count -= half;
+            }
+            const size_t segment = static_cast<size_t>(first - bases_.data());
+            return address < ends_[segment] ? static_cast<uint32_t>(segment) : NONE;
+        }
+
+        bool MemoryLayout::set_pages(uint32_t segment, uint32_t pages) noexcept
+        {
+            const uint64_t size = pages * PAGE_SIZE;
+            if (size > ends_[segment] - bases_[segment])
+            {
+                return false;
+            }
+            sizes_[segment] = size;
+            return true;
+        }
+
+        uint64_t MemoryLayout::overhead_bytes() const
+        {
+            uint64_t reserved = 0;
+            for (const MemorySegment &segment : segments_)
+            {
+                reserved += segment.reserved_pages * PAGE_SIZE;
+            }
+            return maximum_pages_ * PAGE_SIZE - reserved;
+        }
+
+        // =====================================================================
+        // LayoutPlanner
+        // =====================================================================
+
+        uint32_t LayoutPlanner::add(std::string component, const wasm::Limits &limits)
+        {
+            requests_.push_back(Request{std::move(component), limits});
+            return static_cast<uint32_t>(requests_.size() - 1);
+        }
+
+        wasm::Result<MemoryLayout> LayoutPlanner::plan() const
+        {
+            const uint64_t alignment = profile_.alignment;
+            if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+            {
+                return wasm::make_error<MemoryLayout>(wasm::ErrorCode::InvalidAlignment,
+                                                      "Segment alignment must be a power of two");
+            }
+            if (profile_.capacity > MAX_PAGES * PAGE_SIZE)
+            {
+                return wasm::make_error<MemoryLayout>(wasm::ErrorCode::MemoryLimitExceeded,
+                                                      "Platform capacity exceeds 4 GiB");
+            }
+
+            MemoryLayout layout;
+            layout.profile_ = profile_;
+            layout.segments_.reserve(requests_.size());
+            layout.bases_.reserve(requests_.size());
+            layout.sizes_.reserve(requests_.size());
+            layout.ends_.reserve(requests_.size());
+
+            uint64_t initial_end = 0;
+            uint64_t end = 0;
+            for (const Request &request : requests_)
+            {
+                const wasm::Limits &limits = request.limits;
+                if (limits.has_max && limits.min > limits.max)
+                {
+                    return wasm::make_error<MemoryLayout>(wasm::ErrorCode::InvalidMemorySize,
+                                                          "Memory minimum exceeds its maximum");
+                }
+                const uint32_t reserved =
+                    limits.has_max ? limits.max : std::max(profile_.default_reserve_pages, limits.min);
+                if (reserved > MAX_PAGES)
+                {
+                    return wasm::make_error<MemoryLayout>(wasm::ErrorCode::InvalidMemorySize,
+                                                          "Memory exceeds 65536 pages");
+                }
+
+                const uint64_t base = layout.ends_.empty() ? 0 : align_up(end + profile_.guard_bytes, alignment);
+                const uint64_t reserve_end = base + reserved * PAGE_SIZE;
+                if (reserve_end > profile_.capacity || base > 0xFFFFFFFFull)
+                {
+                    return wasm::make_error<MemoryLayout>(wasm::ErrorCode::MemoryLimitExceeded,
+                                                          "Memory segments exceed the platform capacity");
+                }
+
+                layout.segments_.push_back(
+                    MemorySegment{request.component, static_cast<uint32_t>(base), limits.min, reserved});
+                layout.bases_.push_back(static_cast<uint32_t>(base));
+                layout.sizes_.push_back(limits.min * PAGE_SIZE);
+                layout.ends_.push_back(reserve_end);
+                initial_end = std::max(initial_end, base + limits.min * PAGE_SIZE);
+                end = reserve_end;
+            }
+            layout.initial_pages_ = pages_spanning(initial_end);
+            layout.maximum_pages_ = pages_spanning(end);
+            return layout;
+        }
+
+    } // namespace component
+} // namespace flight
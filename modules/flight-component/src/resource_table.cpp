@@ -0,0 +1,353 @@
+#include <flight/component/resource_table.hpp>
+#include <flight/component/async.hpp>
+
+namespace flight
+{
+    namespace component
+    {
+
+        namespace
+        {
+            constexpr uint16_t GENERATION_MASK = (1u << ResourceTable::GENERATION_BITS) - 1;
+
+            template <typename T>
+            wasm::Result<T> invalid_handle()
+            {
+                return wasm::make_error<T>(wasm::ErrorCode::InvalidTableIndex, "Invalid or stale resource handle");
+            }
+
+            template <typename T>
+            wasm::Result<T> wrong_type()
+            {
+                return wasm::make_error<T>(wasm::ErrorCode::TypeMismatch, "Resource handle has a different type");
+            }
+        } // namespace
+
+        // =====================================================================
+        // CallScope
+        // =====================================================================
+
+        wasm::Result<void> CallScope::finish()
+        {
+            for (uint32_t i = 0; i < lender_count_; ++i)
+            {
+                unpin(lenders_[i]);
+            }
+            for (const Lender &lender : more_lenders_)
+            {
+                unpin(lender);
+            }
+            lender_count_ = 0;
+            more_lenders_.clear();
+
+            if (borrows_ != 0)
+            {
+                return wasm::Result<void>(wasm::ErrorCode::MemoryAccessViolation,
+                                          "Call returned without dropping its borrow handles");
+            }
+            return wasm::Result<void>();
+        }
+
+        void CallScope::add_lender(ResourceTable *table, uint32_t slot, uint16_t generation)
+        {
+            if (lender_count_ < lenders_.size())
+            {
+                lenders_[lender_count_++] = Lender{table, slot, generation};
+            }
+            else
+            {
+                more_lenders_.push_back(Lender{table, slot, generation});
+            }
+        }
+
+        void CallScope::unpin(const Lender &lender)
+        {
+            // A lent handle can only go away through destroy_all(), which
+            // moves the slot to a new generation
+            ResourceTable::Slot &slot = lender.table->slots_[lender.slot];
+            if (slot.type && slot.generation == lender.generation)
+            {
+                --slot.lends;
+            }
+        }
+
+        // =====================================================================
+        // ResourceTable
+        // =====================================================================
+
+        ResourceTable::ResourceTable(size_t reserve)
+        {
+            slots_.reserve(reserve + 1);
+            slots_.push_back(Slot{});
+        }
+
+        ResourceTable::~ResourceTable()
+        {
+            destroy_all();
+        }
+
+        const ResourceTable::Slot *ResourceTable::find(uint32_t handle) const
+        {
+            const uint32_t index = slot_of(handle);
+            if (index == NO_SLOT || index >= slots_.size())
+            {
+                return nullptr;
+            }
+            const Slot &slot = slots_[index];
+            if (slot.type == nullptr || slot.generation != generation_of(handle))
+            {
+                return nullptr;
+            }
+            return &slot;
+        }
+
+        ResourceTable::Slot *ResourceTable::find(uint32_t handle)
+        {
+            return const_cast<Slot *>(static_cast<const ResourceTable *>(this)->find(handle));
+        }
+
+        wasm::Result<uint32_t> ResourceTable::insert(const ResourceType &type, uint32_t rep, TypeKind kind,
+                                                     CallScope *scope)
+        {
+            uint32_t index = free_head_;
+            if (index != NO_SLOT)
+            {
+                free_head_ = slots_[index].rep;
+            }
+            else
+            {
+                if (slots_.size() >= MAX_SLOTS)
+                {
+                    return wasm::make_error<uint32_t>(wasm::ErrorCode::OutOfMemory, "Resource table is full");
+                }
+                index = static_cast<uint32_t>(slots_.size());
+                slots_.push_back(Slot{});
+            }
+
+            Slot &slot = slots_[index];
+            slot.type = &type;
+            slot.scope = scope;
+            slot.rep = rep;
+            slot.lends = 0;
+            slot.kind = kind;
+            ++live_;
+            return index | (static_cast<uint32_t>(slot.generation) << INDEX_BITS);
+        }
+
+        void ResourceTable::release(uint32_t index)
+        {
+            Slot &slot = slots_[index];
+            slot.type = nullptr;
+            slot.scope = nullptr;
+            slot.lends = 0;
+            --live_;
+            if (slot.generation == GENERATION_MASK)
+            {
+                return; // Retired: a new generation would repeat old handles
+            }
+            ++slot.generation;
+            slot.rep = free_head_;
+            free_head_ = index;
+        }
+
+        wasm::Result<uint32_t> ResourceTable::create(const ResourceType &type, uint32_t rep)
+        {
+            return insert(type, rep, TypeKind::Own, nullptr);
+        }
+
+        wasm::Result<uint32_t> ResourceTable::rep(uint32_t handle, const ResourceType &type) const
+        {
+            const Slot *slot = find(handle);
+            if (!slot)
+            {
+                return invalid_handle<uint32_t>();
+            }
+            if (slot->type != &type)
+            {
+                return wrong_type<uint32_t>();
+            }
+            return slot->rep;
+        }
+
+        wasm::Result<void> ResourceTable::drop(uint32_t handle, const ResourceType &type)
+        {
+            Slot *slot = find(handle);
+            if (!slot)
+            {
+                return invalid_handle<void>();
+            }
+            if (slot->type != &type)
+            {
+                return wrong_type<void>();
+            }
+            if (slot->lends != 0)
+            {
+                return wasm::Result<void>(wasm::ErrorCode::MemoryAccessViolation,
+                                          "Resource handle is lent to an active call");
+            }
+
+            if (slot->kind == TypeKind::Borrow)
+            {
+                --slot->scope->borrows_;
+                release(slot_of(handle));
+                return wasm::Result<void>();
+            }
+
+            // Release first: the destructor may re-enter the table
+            const uint32_t rep = slot->rep;
+            release(slot_of(handle));
+            if (type.destroy)
+            {
+                type.destroy(type.context, &rep, 1);
+            }
+            return wasm::Result<void>();
+        }
+
+        wasm::Result<uint32_t> ResourceTable::take(uint32_t handle, const ResourceType &type)
+        {
+            Slot *slot = find(handle);
+            if (!slot)
+            {
+                return invalid_handle<uint32_t>();
+            }
+            if (slot->type != &type || slot->kind != TypeKind::Own)
+            {
+                return wrong_type<uint32_t>();
+            }
+            if (slot->lends != 0)
+            {
+                return wasm::make_error<uint32_t>(wasm::ErrorCode::MemoryAccessViolation,
+                                                  "Resource handle is lent to an active call");
+            }
+            const uint32_t rep = slot->rep;
+            release(slot_of(handle));
+            return rep;
+        }
+
+        wasm::Result<uint32_t> ResourceTable::lend(uint32_t handle, const ResourceType &type, CallScope &scope)
+        {
+            Slot *slot = find(handle);
+            if (!slot)
+            {
+                return invalid_handle<uint32_t>();
+            }
+            if (slot->type != &type)
+            {
+                return wrong_type<uint32_t>();
+            }
+            ++slot->lends;
+            scope.add_lender(this, slot_of(handle), slot->generation);
+            return slot->rep;
+        }
+
+        wasm::Result<uint32_t> ResourceTable::borrow(const ResourceType &type, uint32_t rep, CallScope &scope)
+        {
+            auto handle = insert(type, rep, TypeKind::Borrow, &scope);
+            if (handle)
+            {
+                ++scope.borrows_;
+            }
+            return handle;
+        }
+
+        const ResourceType *ResourceTable::type_of(uint32_t handle) const
+        {
+            const Slot *slot = find(handle);
+            return slot ? slot->type : nullptr;
+        }
+
+        void ResourceTable::destroy_all()
+        {
+            // Group representations by type; instances define few resource
+            // types, so a linear search from the last hit is enough
+            struct Batch
+            {
+                const ResourceType *type;
+                std::vector<uint32_t> reps;
+            };
+            std::vector<Batch> batches;
+            size_t last = 0;
+            for (const Slot &slot : slots_)
+            {
+                if (!slot.type || slot.kind != TypeKind::Own || !slot.type->destroy)
+                {
+                    continue;
+                }
+                if (batches.empty() || batches[last].type != slot.type)
+                {
+                    last = 0;
+                    while (last < batches.size() && batches[last].type != slot.type)
+                    {
+                        ++last;
+                    }
+                    if (last == batches.size())
+                    {
+                        batches.push_back(Batch{slot.type, {}});
+                        batches.back().reps.reserve(live_);
+                    }
+                }
+                batches[last].reps.push_back(slot.rep);
+            }
+
+            // Free every slot before running destructors, which may re-enter
+            // the table; lowest slots end up first on the free list
+            for (uint32_t index = static_cast<uint32_t>(slots_.size()); index-- > 1;)
+            {
+                if (slots_[index].type)
+                {
+                    release(index);
+                }
+            }
+
+            for (const Batch &batch : batches)
+            {
+                batch.type->destroy(batch.type->context, batch.reps.data(), batch.reps.size());
+            }
+        }
+
+        // =====================================================================
+        // Transfers between instances
+        // =====================================================================
+
+        wasm::Result<uint32_t> resource_translator(void *context, TypeKind kind, uint32_t handle)
+        {
+            const HandleTransfer &transfer = *static_cast<const HandleTransfer *>(context);
+            if (kind == TypeKind::Stream || kind == TypeKind::Future)
+            {
+                if (!transfer.async_source || !transfer.async_destination)
+                {
+                    return handle;
+                }
+                return transfer.async_source->transfer(handle, *transfer.async_destination);
+            }
+            if (!transfer.source || !transfer.destination)
+            {
+                return handle;
+            }
+
+            const ResourceType *type = transfer.source->type_of(handle);
+            if (!type)
+            {
+                return invalid_handle<uint32_t>();
+            }
+
+            if (kind == TypeKind::Own)
+            {
+                auto rep = transfer.source->take(handle, *type);
+                if (!rep)
+                {
+                    return rep;
+                }
+                return transfer.destination->create(*type, rep.value());
+            }
+
+            auto rep = transfer.source->lend(handle, *type, *transfer.scope);
+            if (!rep)
+            {
+                return rep;
+            }
+            return transfer.destination->borrow(*type, rep.value(), *transfer.scope);
+        }
+
+    } // namespace component
+} // namespace flight
@@ -0,0 +1,1127 @@
+#include <flight/component/string_transcoding.hpp>
+#include <flight/wasm/utilities/endian.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FLIGHT_TRANSCODE_AVX2 1
+#define FLIGHT_TRANSCODE_SIMD_VALIDATION 1
+#elif defined(__SSE2__) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#include <emmintrin.h>
+#define FLIGHT_TRANSCODE_SSE 1
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define FLIGHT_TRANSCODE_SIMD_VALIDATION 1
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <arm_neon.h>
+#define FLIGHT_TRANSCODE_NEON 1
+#define FLIGHT_TRANSCODE_SIMD_VALIDATION 1
+#endif
+
+namespace flight
+{
+    namespace component
+    {
+        namespace transcoding
+        {
+
+            namespace
+            {
+                inline uint32_t popcount(uint64_t value)
+                {
+#if defined(__GNUC__) || defined(__clang__)
+                    return static_cast<uint32_t>(__builtin_popcountll(value));
+#else
+                    uint32_t count = 0;
+                    for (; value != 0; value &= value - 1)
+                    {
+                        ++count;
+                    }
+                    return count;
+#endif
+                }
+
+                // Index of the lowest set bit; value must be non-zero
+                inline uint32_t lowest_bit(uint64_t value)
+                {
+#if defined(__GNUC__) || defined(__clang__)
+                    return static_cast<uint32_t>(__builtin_ctzll(value));
+#else
+                    uint32_t index = 0;
+                    for (; (value & 1) == 0; value >>= 1)
+                    {
+                        ++index;
+                    }
+                    return index;
+#endif
+                }
+
+                inline char16_t load_unit(const char16_t *src)
+                {
+                    uint16_t unit;
+                    std::memcpy(&unit, src, sizeof(unit));
+                    return static_cast<char16_t>(wasm::endian::wasm_to_host(unit));
+                }
+
+                inline void store_unit(char16_t *dst, uint32_t unit)
+                {
+                    const uint16_t value = wasm::endian::host_to_wasm(static_cast<uint16_t>(unit));
+                    std::memcpy(dst, &value, sizeof(value));
+                }
+
+                // Decodes one UTF-8 sequence; returns its length, or 0 if the
+                // sequence is truncated, overlong, a surrogate or above U+10FFFF
+                inline size_t decode_utf8(const uint8_t *src, size_t remaining, uint32_t &code_point)
+                {
+                    const uint32_t b0 = src[0];
+                    if (b0 < 0x80)
+                    {
+                        code_point = b0;
+                        return 1;
+                    }
+                    if (b0 < 0xC2)
+                    {
+                        return 0;
+                    }
+                    if (b0 < 0xE0)
+                    {
+                        if (remaining < 2 || (src[1] & 0xC0) != 0x80)
+                        {
+                            return 0;
+                        }
+                        code_point = ((b0 & 0x1F) << 6) | (src[1] & 0x3F);
+                        return 2;
+                    }
+                    if (b0 < 0xF0)
+                    {
+                        if (remaining < 3 || (src[1] & 0xC0) != 0x80 || (src[2] & 0xC0) != 0x80)
+                        {
+                            return 0;
+                        }
+                        code_point = ((b0 & 0x0F) << 12) | ((src[1] & 0x3F) << 6) | (src[2] & 0x3F);
+                        if (code_point < 0x800 || (code_point >= 0xD800 && code_point < 0xE000))
+                        {
+                            return 0;
+                        }
+                        return 3;
+                    }
+                    if (b0 < 0xF5)
+                    {
+                        if (remaining < 4 || (src[1] & 0xC0) != 0x80 || (src[2] & 0xC0) != 0x80 ||
+                            (src[3] & 0xC0) != 0x80)
+                        {
+                            return 0;
+                        }
+                        code_point = ((b0 & 0x07) << 18) | ((src[1] & 0x3F) << 12) | ((src[2] & 0x3F) << 6) |
+                                     (src[3] & 0x3F);
+                        if (code_point < 0x10000 || code_point > 0x10FFFF)
+                        {
+                            return 0;
+                        }
+                        return 4;
+                    }
+                    return 0;
+                }
+
+                // Decodes one code point; returns the units used, or 0 for a lone surrogate
+                inline size_t decode_utf16(const char16_t *src, size_t remaining, uint32_t &code_point)
+                {
+                    const uint32_t unit = load_unit(src);
+                    if (unit < 0xD800 || unit >= 0xE000)
+                    {
+                        code_point = unit;
+                        return 1;
+                    }
+                    if (unit >= 0xDC00 || remaining < 2)
+                    {
+                        return 0;
+                    }
+                    const uint32_t low = load_unit(src + 1);
+                    if (low < 0xDC00 || low >= 0xE000)
+                    {
+                        return 0;
+                    }
+                    code_point = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+                    return 2;
+                }
+
+                // Decoders for input that has already been validated
+                inline size_t decode_valid_utf8(const uint8_t *src, uint32_t &code_point)
+                {
+                    const uint32_t b0 = src[0];
+                    if (b0 < 0x80)
+                    {
+                        code_point = b0;
+                        return 1;
+                    }
+                    if (b0 < 0xE0)
+                    {
+                        code_point = ((b0 & 0x1F) << 6) | (src[1] & 0x3F);
+                        return 2;
+                    }
+                    if (b0 < 0xF0)
+                    {
+                        code_point = ((b0 & 0x0F) << 12) | ((src[1] & 0x3F) << 6) | (src[2] & 0x3F);
+                        return 3;
+                    }
+                    code_point = ((b0 & 0x07) << 18) | ((src[1] & 0x3F) << 12) | ((src[2] & 0x3F) << 6) |
+                                 (src[3] & 0x3F);
+                    return 4;
+                }
+
+                inline size_t decode_valid_utf16(const char16_t *src, uint32_t &code_point)
+                {
+                    const uint32_t unit = load_unit(src);
+                    if ((unit & 0xF800) != 0xD800)
+                    {
+                        code_point = unit;
+                        return 1;
+                    }
+                    code_point = 0x10000 + ((unit - 0xD800) << 10) + (load_unit(src + 1) - 0xDC00);
+                    return 2;
+                }
+
+                inline size_t utf8_size(uint32_t code_point)
+                {
+                    return code_point < 0x80 ? 1 : code_point < 0x800 ? 2 : code_point < 0x10000 ? 3 : 4;
+                }
+
+                inline size_t encode_utf8(uint32_t code_point, uint8_t *dst)
+                {
+                    if (code_point < 0x80)
+                    {
+                        dst[0] = static_cast<uint8_t>(code_point);
+                        return 1;
+                    }
+                    if (code_point < 0x800)
+                    {
+                        dst[0] = static_cast<uint8_t>(0xC0 | (code_point >> 6));
+                        dst[1] = static_cast<uint8_t>(0x80 | (code_point & 0x3F));
+                        return 2;
+                    }
+                    if (code_point < 0x10000)
+                    {
+                        dst[0] = static_cast<uint8_t>(0xE0 | (code_point >> 12));
+                        dst[1] = static_cast<uint8_t>(0x80 | ((code_point >> 6) & 0x3F));
+                        dst[2] = static_cast<uint8_t>(0x80 | (code_point & 0x3F));
+                        return 3;
+                    }
+                    dst[0] = static_cast<uint8_t>(0xF0 | (code_point >> 18));
+                    dst[1] = static_cast<uint8_t>(0x80 | ((code_point >> 12) & 0x3F));
+                    dst[2] = static_cast<uint8_t>(0x80 | ((code_point >> 6) & 0x3F));
+                    dst[3] = static_cast<uint8_t>(0x80 | (code_point & 0x3F));
+                    return 4;
+                }
+
+                inline size_t encode_utf16(uint32_t code_point, char16_t *dst)
+                {
+                    if (code_point < 0x10000)
+                    {
+                        store_unit(dst, code_point);
+                        return 1;
+                    }
+                    code_point -= 0x10000;
+                    store_unit(dst, 0xD800 | (code_point >> 10));
+                    store_unit(dst + 1, 0xDC00 | (code_point & 0x3FF));
+                    return 2;
+                }
+
+                // Block primitives. Each tier processes WIDTH bytes or WIDTH
+                // UTF-16 units at a time:
+                //   ascii_block          no byte >= 0x80
+                //   ascii_prefix         leading bytes below 0x80 (WIDTH if all)
+                //   ascii_prefix16       leading units below 0x80
+                //   high_bit_count       bytes >= 0x80
+                //   widen_block          bytes to units
+                //   narrow_block         units <= 0xFF to bytes
+                //   units_below          all units below limit (a power of two)
+                //   utf8_length_block    UTF-8 size of the units; false if any is a surrogate
+#if defined(FLIGHT_TRANSCODE_AVX2)
+                constexpr const char *IMPLEMENTATION = "avx2";
+                constexpr size_t WIDTH = 32;
+                using Vec = __m256i;
+
+                inline Vec load(const void *src) { return _mm256_loadu_si256(static_cast<const __m256i *>(src)); }
+                inline Vec splat(uint8_t value) { return _mm256_set1_epi8(static_cast<char>(value)); }
+                inline Vec splat16(uint16_t value) { return _mm256_set1_epi16(static_cast<short>(value)); }
+                inline Vec vand(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+                inline Vec vor(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+                inline Vec vxor(Vec a, Vec b) { return _mm256_xor_si256(a, b); }
+                inline Vec subs(Vec a, Vec b) { return _mm256_subs_epu8(a, b); }
+                inline bool is_ascii(Vec v) { return _mm256_movemask_epi8(v) == 0; }
+                inline bool any_set(Vec v) { return !_mm256_testz_si256(v, v); }
+                inline Vec high_nibbles(Vec v) { return vand(_mm256_srli_epi16(v, 4), splat(0x0F)); }
+                inline Vec low_nibbles(Vec v) { return vand(v, splat(0x0F)); }
+
+                inline Vec lookup(Vec index, const uint8_t *table)
+                {
+                    return _mm256_shuffle_epi8(
+                        _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(table))), index);
+                }
+
+                // input shifted right by N bytes, filled from the end of previous
+                template <int N>
+                inline Vec prev(Vec input, Vec previous)
+                {
+                    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+                }
+
+                inline uint32_t count_mask(Vec mask)
+                {
+                    return popcount(static_cast<uint32_t>(_mm256_movemask_epi8(mask)));
+                }
+
+                // Bytes that start a code point: anything but 10xxxxxx
+                inline uint32_t count_leading(Vec v) { return count_mask(_mm256_cmpgt_epi8(v, splat(0xBF))); }
+                inline uint32_t count_at_least(Vec v, uint8_t threshold)
+                {
+                    return count_mask(_mm256_cmpeq_epi8(_mm256_max_epu8(v, splat(threshold)), v));
+                }
+
+                inline bool ascii_block(const uint8_t *src) { return is_ascii(load(src)); }
+                inline uint32_t high_bit_count(const uint8_t *src)
+                {
+                    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(load(src)));
+                    return mask == 0 ? 0 : popcount(mask);
+                }
+
+                inline uint32_t ascii_prefix(const uint8_t *src)
+                {
+                    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(load(src)));
+                    return mask == 0 ? WIDTH : lowest_bit(mask);
+                }
+
+                inline uint32_t ascii_prefix16(const char16_t *src)
+                {
+                    const Vec zero = _mm256_setzero_si256();
+                    const Vec a = _mm256_cmpeq_epi16(vand(load(src), splat16(0xFF80)), zero);
+                    const Vec b = _mm256_cmpeq_epi16(vand(load(src + 16), splat16(0xFF80)), zero);
+                    const Vec ascii = _mm256_permute4x64_epi64(_mm256_packs_epi16(a, b), 0xD8);
+                    const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(ascii));
+                    return mask == 0 ? WIDTH : lowest_bit(mask);
+                }
+
+                inline void widen_block(const uint8_t *src, char16_t *dst)
+                {
+                    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+                    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), _mm256_cvtepu8_epi16(lo));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + 16), _mm256_cvtepu8_epi16(hi));
+                }
+
+                inline void narrow_block(const char16_t *src, uint8_t *dst)
+                {
+                    const Vec packed = _mm256_packus_epi16(load(src), load(src + 16));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), _mm256_permute4x64_epi64(packed, 0xD8));
+                }
+
+                inline bool units_below(const char16_t *src, uint16_t limit)
+                {
+                    const Vec units = vor(load(src), load(src + 16));
+                    return _mm256_testz_si256(units, splat16(static_cast<uint16_t>(~(limit - 1))));
+                }
+
+                inline bool utf8_length_block(const char16_t *src, size_t &bytes)
+                {
+                    const Vec a = load(src);
+                    const Vec b = load(src + 16);
+                    if (_mm256_testz_si256(vor(a, b), splat16(0xFF80)))
+                    {
+                        bytes = WIDTH;
+                        return true;
+                    }
+                    const Vec surrogates = vor(_mm256_cmpeq_epi16(vand(a, splat16(0xF800)), splat16(0xD800)),
+                                               _mm256_cmpeq_epi16(vand(b, splat16(0xF800)), splat16(0xD800)));
+                    if (any_set(surrogates))
+                    {
+                        return false;
+                    }
+                    const Vec zero = _mm256_setzero_si256();
+                    const uint32_t below = count_mask(_mm256_cmpeq_epi16(vand(a, splat16(0xFF80)), zero)) +
+                                           count_mask(_mm256_cmpeq_epi16(vand(b, splat16(0xFF80)), zero)) +
+                                           count_mask(_mm256_cmpeq_epi16(vand(a, splat16(0xF800)), zero)) +
+                                           count_mask(_mm256_cmpeq_epi16(vand(b, splat16(0xF800)), zero));
+                    bytes = 3 * WIDTH - below / 2;
+                    return true;
+                }
+#elif defined(FLIGHT_TRANSCODE_SSE)
+#if defined(FLIGHT_TRANSCODE_SIMD_VALIDATION)
+                constexpr const char *IMPLEMENTATION = "ssse3";
+#else
+                constexpr const char *IMPLEMENTATION = "sse2";
+#endif
+                constexpr size_t WIDTH = 16;
+                using Vec = __m128i;
+
+                inline Vec load(const void *src) { return _mm_loadu_si128(static_cast<const __m128i *>(src)); }
+                inline Vec splat(uint8_t value) { return _mm_set1_epi8(static_cast<char>(value)); }
+                inline Vec splat16(uint16_t value) { return _mm_set1_epi16(static_cast<short>(value)); }
+                inline Vec vand(Vec a, Vec b) { return _mm_and_si128(a, b); }
+                inline Vec vor(Vec a, Vec b) { return _mm_or_si128(a, b); }
+                inline Vec vxor(Vec a, Vec b) { return _mm_xor_si128(a, b); }
+                inline Vec subs(Vec a, Vec b) { return _mm_subs_epu8(a, b); }
+                inline bool is_ascii(Vec v) { return _mm_movemask_epi8(v) == 0; }
+                inline bool any_set(Vec v) { return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) != 0xFFFF; }
+                inline Vec high_nibbles(Vec v) { return vand(_mm_srli_epi16(v, 4), splat(0x0F)); }
+                inline Vec low_nibbles(Vec v) { return vand(v, splat(0x0F)); }
+
+                inline uint32_t count_mask(Vec mask) { return popcount(static_cast<uint32_t>(_mm_movemask_epi8(mask))); }
+                inline uint32_t count_leading(Vec v) { return count_mask(_mm_cmpgt_epi8(v, splat(0xBF))); }
+                inline uint32_t count_at_least(Vec v, uint8_t threshold)
+                {
+                    return count_mask(_mm_cmpeq_epi8(_mm_max_epu8(v, splat(threshold)), v));
+                }
+
+#if defined(FLIGHT_TRANSCODE_SIMD_VALIDATION)
+                inline Vec lookup(Vec index, const uint8_t *table) { return _mm_shuffle_epi8(load(table), index); }
+
+                template <int N>
+                inline Vec prev(Vec input, Vec previous)
+                {
+                    return _mm_alignr_epi8(input, previous, 16 - N);
+                }
+#endif
+
+                inline bool ascii_block(const uint8_t *src) { return is_ascii(load(src)); }
+                inline uint32_t high_bit_count(const uint8_t *src)
+                {
+                    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(load(src)));
+                    return mask == 0 ? 0 : popcount(mask);
+                }
+
+                inline uint32_t ascii_prefix(const uint8_t *src)
+                {
+                    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(load(src)));
+                    return mask == 0 ? WIDTH : lowest_bit(mask);
+                }
+
+                inline uint32_t ascii_prefix16(const char16_t *src)
+                {
+                    const Vec zero = _mm_setzero_si128();
+                    const Vec a = _mm_cmpeq_epi16(vand(load(src), splat16(0xFF80)), zero);
+                    const Vec b = _mm_cmpeq_epi16(vand(load(src + 8), splat16(0xFF80)), zero);
+                    const uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(a, b))) & 0xFFFF;
+                    return mask == 0 ? WIDTH : lowest_bit(mask);
+                }
+
+                inline void widen_block(const uint8_t *src, char16_t *dst)
+                {
+                    const Vec bytes = load(src);
+                    const Vec zero = _mm_setzero_si128();
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_unpacklo_epi8(bytes, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 8), _mm_unpackhi_epi8(bytes, zero));
+                }
+
+                inline void narrow_block(const char16_t *src, uint8_t *dst)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_packus_epi16(load(src), load(src + 8)));
+                }
+
+                inline bool units_below(const char16_t *src, uint16_t limit)
+                {
+                    const Vec high = vand(vor(load(src), load(src + 8)), splat16(static_cast<uint16_t>(~(limit - 1))));
+                    return !any_set(high);
+                }
+
+                inline bool utf8_length_block(const char16_t *src, size_t &bytes)
+                {
+                    const Vec a = load(src);
+                    const Vec b = load(src + 8);
+                    if (!any_set(vand(vor(a, b), splat16(0xFF80))))
+                    {
+                        bytes = WIDTH;
+                        return true;
+                    }
+                    const Vec surrogates = vor(_mm_cmpeq_epi16(vand(a, splat16(0xF800)), splat16(0xD800)),
+                                               _mm_cmpeq_epi16(vand(b, splat16(0xF800)), splat16(0xD800)));
+                    if (_mm_movemask_epi8(surrogates) != 0)
+                    {
+                        return false;
+                    }
+                    const Vec zero = _mm_setzero_si128();
+                    const uint32_t below = count_mask(_mm_cmpeq_epi16(vand(a, splat16(0xFF80)), zero)) +
+                                           count_mask(_mm_cmpeq_epi16(vand(b, splat16(0xFF80)), zero)) +
+                                           count_mask(_mm_cmpeq_epi16(vand(a, splat16(0xF800)), zero)) +
+                                           count_mask(_mm_cmpeq_epi16(vand(b, splat16(0xF800)), zero));
+                    bytes = 3 * WIDTH - below / 2;
+                    return true;
+                }
+#elif defined(FLIGHT_TRANSCODE_NEON)
+                constexpr const char *IMPLEMENTATION = "neon";
+                constexpr size_t WIDTH = 16;
+                using Vec = uint8x16_t;
+
+                inline Vec load(const void *src) { return vld1q_u8(static_cast<const uint8_t *>(src)); }
+                inline Vec splat(uint8_t value) { return vdupq_n_u8(value); }
+                inline Vec vand(Vec a, Vec b) { return vandq_u8(a, b); }
+                inline Vec vor(Vec a, Vec b) { return vorrq_u8(a, b); }
+                inline Vec vxor(Vec a, Vec b) { return veorq_u8(a, b); }
+                inline Vec subs(Vec a, Vec b) { return vqsubq_u8(a, b); }
+                inline bool is_ascii(Vec v) { return vmaxvq_u8(v) < 0x80; }
+                inline bool any_set(Vec v) { return vmaxvq_u8(v) != 0; }
+                inline Vec high_nibbles(Vec v) { return vshrq_n_u8(v, 4); }
+                inline Vec low_nibbles(Vec v) { return vandq_u8(v, splat(0x0F)); }
+                inline Vec lookup(Vec index, const uint8_t *table) { return vqtbl1q_u8(vld1q_u8(table), index); }
+
+                template <int N>
+                inline Vec prev(Vec input, Vec previous)
+                {
+                    return vextq_u8(previous, input, 16 - N);
+                }
+
+                inline uint32_t count_mask(Vec mask) { return vaddvq_u8(vshrq_n_u8(mask, 7)); }
+                inline uint32_t count_leading(Vec v)
+                {
+                    return count_mask(vcgtq_s8(vreinterpretq_s8_u8(v), vdupq_n_s8(-65)));
+                }
+                inline uint32_t count_at_least(Vec v, uint8_t threshold) { return count_mask(vcgeq_u8(v, splat(threshold))); }
+
+                inline bool ascii_block(const uint8_t *src) { return is_ascii(load(src)); }
+                inline uint32_t high_bit_count(const uint8_t *src) { return count_mask(load(src)); }
+
+                inline uint16x8_t load_units(const char16_t *src)
+                {
+                    return vld1q_u16(reinterpret_cast<const uint16_t *>(src));
+                }
+
+                // NEON has no movemask; narrowing by four bits leaves one
+                // nibble per byte of a 0x00/0xFF mask
+                inline uint32_t first_set(Vec mask)
+                {
+                    const uint64_t nibbles =
+                        vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(mask), 4)), 0);
+                    return nibbles == 0 ? WIDTH : lowest_bit(nibbles) / 4;
+                }
+
+                inline uint32_t ascii_prefix(const uint8_t *src) { return first_set(vcgeq_u8(load(src), splat(0x80))); }
+
+                inline uint32_t ascii_prefix16(const char16_t *src)
+                {
+                    const uint16x8_t limit = vdupq_n_u16(0x80);
+                    return first_set(vcombine_u8(vmovn_u16(vcgeq_u16(load_units(src), limit)),
+                                                 vmovn_u16(vcgeq_u16(load_units(src + 8), limit))));
+                }
+
+                inline void widen_block(const uint8_t *src, char16_t *dst)
+                {
+                    const Vec bytes = load(src);
+                    vst1q_u16(reinterpret_cast<uint16_t *>(dst), vmovl_u8(vget_low_u8(bytes)));
+                    vst1q_u16(reinterpret_cast<uint16_t *>(dst + 8), vmovl_high_u8(bytes));
+                }
+
+                inline void narrow_block(const char16_t *src, uint8_t *dst)
+                {
+                    vst1q_u8(dst, vcombine_u8(vmovn_u16(load_units(src)), vmovn_u16(load_units(src + 8))));
+                }
+
+                inline bool units_below(const char16_t *src, uint16_t limit)
+                {
+                    const uint16x8_t units = vorrq_u16(load_units(src), load_units(src + 8));
+                    return vmaxvq_u16(vandq_u16(units, vdupq_n_u16(static_cast<uint16_t>(~(limit - 1))))) == 0;
+                }
+
+                inline uint32_t count_units(uint16x8_t mask) { return vaddvq_u16(vshrq_n_u16(mask, 15)); }
+
+                inline bool utf8_length_block(const char16_t *src, size_t &bytes)
+                {
+                    const uint16x8_t a = load_units(src);
+                    const uint16x8_t b = load_units(src + 8);
+                    const uint16x8_t high5 = vdupq_n_u16(0xF800);
+                    const uint16x8_t surrogate = vdupq_n_u16(0xD800);
+                    if (vmaxvq_u16(vorrq_u16(vceqq_u16(vandq_u16(a, high5), surrogate),
+                                             vceqq_u16(vandq_u16(b, high5), surrogate))) != 0)
+                    {
+                        return false;
+                    }
+                    bytes = WIDTH + count_units(vcgtq_u16(a, vdupq_n_u16(0x7F))) +
+                            count_units(vcgtq_u16(b, vdupq_n_u16(0x7F))) +
+                            count_units(vcgtq_u16(a, vdupq_n_u16(0x7FF))) +
+                            count_units(vcgtq_u16(b, vdupq_n_u16(0x7FF)));
+                    return true;
+                }
+#else
+                // Portable fallback: eight bytes at a time in a 64-bit word
+                constexpr const char *IMPLEMENTATION = "scalar";
+                constexpr size_t WIDTH = 8;
+                constexpr uint64_t HIGH_BITS = 0x8080808080808080ull;
+
+                inline uint64_t load_word(const uint8_t *src)
+                {
+                    uint64_t word;
+                    std::memcpy(&word, src, sizeof(word));
+                    return word;
+                }
+
+                inline bool ascii_block(const uint8_t *src) { return (load_word(src) & HIGH_BITS) == 0; }
+                inline uint32_t high_bit_count(const uint8_t *src) { return popcount(load_word(src) & HIGH_BITS); }
+
+                inline uint32_t ascii_prefix(const uint8_t *src)
+                {
+                    uint32_t i = 0;
+                    while (i < WIDTH && src[i] < 0x80)
+                    {
+                        ++i;
+                    }
+                    return i;
+                }
+
+                inline uint32_t ascii_prefix16(const char16_t *src)
+                {
+                    uint32_t i = 0;
+                    while (i < WIDTH && load_unit(src + i) < 0x80)
+                    {
+                        ++i;
+                    }
+                    return i;
+                }
+
+                inline void widen_block(const uint8_t *src, char16_t *dst)
+                {
+                    for (size_t i = 0; i < WIDTH; ++i)
+                    {
+                        store_unit(dst + i, src[i]);
+                    }
+                }
+
+                inline void narrow_block(const char16_t *src, uint8_t *dst)
+                {
+                    for (size_t i = 0; i < WIDTH; ++i)
+                    {
+                        dst[i] = static_cast<uint8_t>(load_unit(src + i));
+                    }
+                }
+
+                inline bool units_below(const char16_t *src, uint16_t limit)
+                {
+                    uint32_t all = 0;
+                    for (size_t i = 0; i < WIDTH; ++i)
+                    {
+                        all |= load_unit(src + i);
+                    }
+                    return all < limit;
+                }
+
+                inline bool utf8_length_block(const char16_t *src, size_t &bytes)
+                {
+                    size_t total = 0;
+                    for (size_t i = 0; i < WIDTH; ++i)
+                    {
+                        const uint32_t unit = load_unit(src + i);
+                        if ((unit & 0xF800) == 0xD800)
+                        {
+                            return false;
+                        }
+                        total += utf8_size(unit);
+                    }
+                    bytes = total;
+                    return true;
+                }
+#endif
+
+#if defined(FLIGHT_TRANSCODE_SIMD_VALIDATION)
+                // Vectorized UTF-8 validation (Keiser and Lemire, "Validating
+                // UTF-8 In Less Than One Instruction Per Byte"). Three nibble
+                // lookups classify every pair of adjacent bytes; the bits that
+                // survive the AND are errors, except TWO_CONTS, which is only
+                // an error where no three- or four-byte lead expects it.
+                constexpr uint8_t TOO_SHORT = 1 << 0;      // Lead followed by a lead or ASCII
+                constexpr uint8_t TOO_LONG = 1 << 1;       // ASCII followed by a continuation
+                constexpr uint8_t OVERLONG_3 = 1 << 2;     // E0 80..9F
+                constexpr uint8_t TOO_LARGE = 1 << 3;      // F4 90..BF and F5..FF
+                constexpr uint8_t SURROGATE = 1 << 4;      // ED A0..BF
+                constexpr uint8_t OVERLONG_2 = 1 << 5;     // C0, C1
+                constexpr uint8_t TOO_LARGE_1000 = 1 << 6; // F5..FF 80..8F
+                constexpr uint8_t OVERLONG_4 = 1 << 6;     // F0 80..8F
+                constexpr uint8_t TWO_CONTS = 1 << 7;      // Continuation followed by a continuation
+                constexpr uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+                alignas(16) constexpr uint8_t BYTE_1_HIGH[16] = {
+                    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+                    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+                    TOO_SHORT | OVERLONG_2,
+                    TOO_SHORT,
+                    TOO_SHORT | OVERLONG_3 | SURROGATE,
+                    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4};
+
+                alignas(16) constexpr uint8_t BYTE_1_LOW[16] = {
+                    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+                    CARRY | OVERLONG_2,
+                    CARRY,
+                    CARRY,
+                    CARRY | TOO_LARGE,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000,
+                    CARRY | TOO_LARGE | TOO_LARGE_1000};
+
+                alignas(16) constexpr uint8_t BYTE_2_HIGH[16] = {
+                    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+                    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+                    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+                    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+                    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+                    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT};
+
+                // Largest byte allowed in each of the last three positions of
+                // the input: leads there need continuations from beyond it
+                struct IncompleteLimits
+                {
+                    alignas(32) uint8_t bytes[WIDTH];
+
+                    IncompleteLimits()
+                    {
+                        std::memset(bytes, 0xFF, WIDTH);
+                        bytes[WIDTH - 3] = 0xF0 - 1;
+                        bytes[WIDTH - 2] = 0xE0 - 1;
+                        bytes[WIDTH - 1] = 0xC0 - 1;
+                    }
+                };
+                const IncompleteLimits INCOMPLETE_LIMITS;
+
+                class Utf8Checker
+                {
+                public:
+                    void check(Vec input)
+                    {
+                        if (is_ascii(input))
+                        {
+                            // A sequence left open by the previous block cannot finish here
+                            error_ = vor(error_, incomplete_);
+                            incomplete_ = splat(0);
+                        }
+                        else
+                        {
+                            const Vec prev1 = prev<1>(input, previous_);
+                            const Vec special = vand(vand(lookup(high_nibbles(prev1), BYTE_1_HIGH),
+                                                          lookup(low_nibbles(prev1), BYTE_1_LOW)),
+                                                     lookup(high_nibbles(input), BYTE_2_HIGH));
+                            const Vec third = subs(prev<2>(input, previous_), splat(0xE0 - 0x80));
+                            const Vec fourth = subs(prev<3>(input, previous_), splat(0xF0 - 0x80));
+                            const Vec expected = vand(vor(third, fourth), splat(0x80));
+                            error_ = vor(error_, vxor(expected, special));
+                            incomplete_ = subs(input, load(INCOMPLETE_LIMITS.bytes));
+                        }
+                        previous_ = input;
+                    }
+
+                    bool valid()
+                    {
+                        return !any_set(vor(error_, incomplete_));
+                    }
+
+                private:
+                    Vec error_ = splat(0);
+                    Vec previous_ = splat(0);
+                    Vec incomplete_ = splat(0);
+                };
+
+                // The last partial block, padded with NULs (which are ASCII)
+                inline Vec load_tail(const uint8_t *src, size_t length)
+                {
+                    alignas(32) uint8_t block[WIDTH] = {};
+                    std::memcpy(block, src, length);
+                    return load(block);
+                }
+
+                // UTF-16 units encoding the block: one per lead byte, two
+                // for each four-byte lead
+                inline size_t utf16_units(Vec input)
+                {
+                    return is_ascii(input) ? WIDTH : count_leading(input) + count_at_least(input, 0xF0);
+                }
+#endif
+            } // namespace
+
+            const char *implementation()
+            {
+                return IMPLEMENTATION;
+            }
+
+            bool is_ascii(const uint8_t *src, size_t length)
+            {
+                size_t i = 0;
+                for (; i + WIDTH <= length; i += WIDTH)
+                {
+                    if (!ascii_block(src + i))
+                    {
+                        return false;
+                    }
+                }
+                for (; i < length; ++i)
+                {
+                    if (src[i] >= 0x80)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            bool validate_utf8(const uint8_t *src, size_t length)
+            {
+#if defined(FLIGHT_TRANSCODE_SIMD_VALIDATION)
+                Utf8Checker checker;
+                size_t i = 0;
+                for (; i + WIDTH <= length; i += WIDTH)
+                {
+                    checker.check(load(src + i));
+                }
+                if (i < length)
+                {
+                    checker.check(load_tail(src + i, length - i));
+                }
+                return checker.valid();
+#else
+                return utf16_length_from_utf8(src, length) != INVALID_LENGTH;
+#endif
+            }
+
+            bool validate_utf16(const char16_t *src, size_t length)
+            {
+                return utf8_length_from_utf16(src, length) != INVALID_LENGTH;
+            }
+
+            size_t utf16_length_from_utf8(const uint8_t *src, size_t length)
+            {
+                size_t count = 0;
+                size_t i = 0;
+#if defined(FLIGHT_TRANSCODE_SIMD_VALIDATION)
+                Utf8Checker checker;
+                for (; i + WIDTH <= length; i += WIDTH)
+                {
+                    const Vec input = load(src + i);
+                    checker.check(input);
+                    count += utf16_units(input);
+                }
+                if (i < length)
+                {
+                    const Vec input = load_tail(src + i, length - i);
+                    checker.check(input);
+                    count += utf16_units(input) - (WIDTH - (length - i));
+                }
+                return checker.valid() ? count : INVALID_LENGTH;
+#else
+                while (i < length)
+                {
+                    if (i + WIDTH <= length && ascii_block(src + i))
+                    {
+                        count += WIDTH;
+                        i += WIDTH;
+                        continue;
+                    }
+                    const size_t end = std::min(length, i + WIDTH);
+                    while (i < end)
+                    {
+                        uint32_t code_point;
+                        const size_t size = decode_utf8(src + i, length - i, code_point);
+                        if (size == 0)
+                        {
+                            return INVALID_LENGTH;
+                        }
+                        i += size;
+                        count += size == 4 ? 2 : 1;
+                    }
+                }
+                return count;
+#endif
+            }
+
+            size_t latin1_length_from_utf8(const uint8_t *src, size_t length)
+            {
+                size_t count = 0;
+                size_t i = 0;
+#if defined(FLIGHT_TRANSCODE_SIMD_VALIDATION)
+                // Valid UTF-8 is Latin-1 when no lead byte is above C3
+                Utf8Checker checker;
+                for (; i + WIDTH <= length; i += WIDTH)
+                {
+                    const Vec input = load(src + i);
+                    if (is_ascii(input))
+                    {
+                        checker.check(input);
+                        count += WIDTH;
+                        continue;
+                    }
+                    if (count_at_least(input, 0xC4) != 0)
+                    {
+                        return INVALID_LENGTH;
+                    }
+                    checker.check(input);
+                    count += count_leading(input);
+                }
+                if (i < length)
+                {
+                    const Vec input = load_tail(src + i, length - i);
+                    if (count_at_least(input, 0xC4) != 0)
+                    {
+                        return INVALID_LENGTH;
+                    }
+                    checker.check(input);
+                    count += count_leading(input) - (WIDTH - (length - i));
+                }
+                return checker.valid() ? count : INVALID_LENGTH;
+#else
+                while (i < length)
+                {
+                    if (i + WIDTH <= length && ascii_block(src + i))
+                    {
+                        count += WIDTH;
+                        i += WIDTH;
+                        continue;
+                    }
+                    const size_t end = std::min(length, i + WIDTH);
+                    while (i < end)
+                    {
+                        uint32_t code_point;
+                        const size_t size = decode_utf8(src + i, length - i, code_point);
+                        if (size == 0 || code_point > 0xFF)
+                        {
+                            return INVALID_LENGTH;
+                        }
+                        i += size;
+                        ++count;
+                    }
+                }
+                return count;
+#endif
+            }
+
+            size_t convert_utf8_to_utf16(const uint8_t *src, size_t length, char16_t *dst)
+            {
+                size_t i = 0;
+                size_t written = 0;
+                while (i < length)
+                {
+                    if (i + WIDTH <= length)
+                    {
+                        // Output is at least a third of the input, so a whole
+                        // block can be stored when only its ASCII prefix is kept
+                        const uint32_t ascii = ascii_prefix(src + i);
+                        if (ascii == WIDTH || i + 3 * WIDTH <= length)
+                        {
+                            widen_block(src + i, dst + written);
+                            i += ascii;
+                            written += ascii;
+                            if (ascii == WIDTH)
+                            {
+                                continue;
+                            }
+                        }
+                    }
+                    // One code point, then the rest of a run of non-ASCII ones
+                    do
+                    {
+                        uint32_t code_point;
+                        i += decode_valid_utf8(src + i, code_point);
+                        written += encode_utf16(code_point, dst + written);
+                    } while (i < length && src[i] >= 0x80);
+                }
+                return written;
+            }
+
+            size_t convert_utf8_to_latin1(const uint8_t *src, size_t length, uint8_t *dst)
+            {
+                size_t i = 0;
+                size_t written = 0;
+                while (i < length)
+                {
+                    if (i + WIDTH <= length)
+                    {
+                        // Output is at least half the input
+                        const uint32_t ascii = ascii_prefix(src + i);
+                        if (ascii == WIDTH || i + 2 * WIDTH <= length)
+                        {
+                            std::memcpy(dst + written, src + i, WIDTH);
+                            i += ascii;
+                            written += ascii;
+                            if (ascii == WIDTH)
+                            {
+                                continue;
+                            }
+                        }
+                    }
+                    do
+                    {
+                        const uint8_t byte = src[i];
+                        if (byte < 0x80)
+                        {
+                            dst[written++] = byte;
+                            ++i;
+                        }
+                        else
+                        {
+                            dst[written++] = static_cast<uint8_t>(((byte & 0x03) << 6) | (src[i + 1] & 0x3F));
+                            i += 2;
+                        }
+                    } while (i < length && src[i] >= 0x80);
+                }
+                return written;
+            }
+
+            size_t utf8_length_from_utf16(const char16_t *src, size_t length)
+            {
+                size_t count = 0;
+                size_t i = 0;
+                while (i < length)
+                {
+                    size_t bytes;
+                    if (i + WIDTH <= length && utf8_length_block(src + i, bytes))
+                    {
+                        count += bytes;
+                        i += WIDTH;
+                        continue;
+                    }
+                    const size_t end = std::min(length, i + WIDTH);
+                    while (i < end)
+                    {
+                        uint32_t code_point;
+                        const size_t units = decode_utf16(src + i, length - i, code_point);
+                        if (units == 0)
+                        {
+                            return INVALID_LENGTH;
+                        }
+                        i += units;
+                        count += utf8_size(code_point);
+                    }
+                }
+                return count;
+            }
+
+            bool utf16_fits_latin1(const char16_t *src, size_t length)
+            {
+                size_t i = 0;
+                for (; i + WIDTH <= length; i += WIDTH)
+                {
+                    if (!units_below(src + i, 0x100))
+                    {
+                        return false;
+                    }
+                }
+                for (; i < length; ++i)
+                {
+                    if (load_unit(src + i) > 0xFF)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            size_t convert_utf16_to_utf8(const char16_t *src, size_t length, uint8_t *dst)
+            {
+                size_t i = 0;
+                size_t written = 0;
+                while (i < length)
+                {
+                    if (i + WIDTH <= length)
+                    {
+                        // Every unit left produces at least one byte
+                        const uint32_t ascii = ascii_prefix16(src + i);
+                        narrow_block(src + i, dst + written);
+                        i += ascii;
+                        written += ascii;
+                        if (ascii == WIDTH)
+                        {
+                            continue;
+                        }
+                    }
+                    do
+                    {
+                        uint32_t code_point;
+                        i += decode_valid_utf16(src + i, code_point);
+                        written += encode_utf8(code_point, dst + written);
+                    } while (i < length && load_unit(src + i) >= 0x80);
+                }
+                return written;
+            }
+
+            size_t convert_utf16_to_latin1(const char16_t *src, size_t length, uint8_t *dst)
+            {
+                size_t i = 0;
+                for (; i + WIDTH <= length; i += WIDTH)
+                {
+                    narrow_block(src + i, dst + i);
+                }
+                for (; i < length; ++i)
+                {
+                    dst[i] = static_cast<uint8_t>(load_unit(src + i));
+                }
+                return length;
+            }
+
+            size_t utf8_length_from_latin1(const uint8_t *src, size_t length)
+            {
+                size_t count = length;
+                size_t i = 0;
+                for (; i + WIDTH <= length; i += WIDTH)
+                {
+                    count += high_bit_count(src + i);
+                }
+                for (; i < length; ++i)
+                {
+                    count += src[i] >> 7;
+                }
+                return count;
+            }
+
+            size_t convert_latin1_to_utf8(const uint8_t *src, size_t length, uint8_t *dst)
+            {
+                size_t i = 0;
+                size_t written = 0;
+                while (i < length)
+                {
+                    if (i + WIDTH <= length)
+                    {
+                        const uint32_t ascii = ascii_prefix(src + i);
+                        std::memcpy(dst + written, src + i, WIDTH);
+                        i += ascii;
+                        written += ascii;
+                        if (ascii == WIDTH)
+                        {
+                            continue;
+                        }
+                    }
+                    do
+                    {
+                        const uint8_t byte = src[i++];
+                        if (byte < 0x80)
+                        {
+                            dst[written++] = byte;
+                        }
+                        else
+                        {
+                            dst[written++] = static_cast<uint8_t>(0xC0 | (byte >> 6));
+                            dst[written++] = static_cast<uint8_t>(0x80 | (byte & 0x3F));
+                        }
+                    } while (i < length && src[i] >= 0x80);
+                }
+                return written;
+            }
+
+            size_t convert_latin1_to_utf16(const uint8_t *src, size_t length, char16_t *dst)
+            {
+                size_t i = 0;
+                for (; i + WIDTH <= length; i += WIDTH)
+                {
+                    widen_block(src + i, dst + i);
+                }
+                for (; i < length; ++i)
+                {
+                    store_unit(dst + i, src[i]);
+                }
+                return length;
+            }
+
+        } // namespace transcoding
+    } // namespace component
+} // namespace flight
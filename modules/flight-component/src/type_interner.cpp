@@ -0,0 +1,290 @@
+#include <flight/component/type_interner.hpp>
+#include <flight/component/canonical_abi.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace flight
+{
+    namespace component
+    {
+
+        namespace
+        {
+            constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ull;
+            constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+
+            // Spreads every input bit over the low bits used as a slot
+            uint64_t finish(uint64_t hash)
+            {
+                hash ^= hash >> 33;
+                hash *= 0xff51afd7ed558ccdull;
+                return hash ^ (hash >> 33);
+            }
+
+            // Labels are short: hashed eight bytes at a time
+            uint64_t hash_label(const std::string &label)
+            {
+                const char *bytes = label.data();
+                size_t count = label.size();
+                uint64_t hash = FNV_OFFSET ^ count;
+                for (; count >= 8; bytes += 8, count -= 8)
+                {
+                    uint64_t word;
+                    std::memcpy(&word, bytes, sizeof(word));
+                    hash = (hash ^ word) * FNV_PRIME;
+                }
+                uint64_t tail = 0;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    tail |= uint64_t(static_cast<uint8_t>(bytes[i])) << (8 * i);
+                }
+                return finish((hash ^ tail) * FNV_PRIME);
+            }
+
+            uint64_t hash_words(const uint32_t *words, size_t count)
+            {
+                uint64_t hash = FNV_OFFSET;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    hash = (hash ^ words[i]) * FNV_PRIME;
+                }
+                return finish(hash);
+            }
+
+            // Bytes a flags value with count flags occupies in memory
+            uint32_t flags_size(uint32_t count)
+            {
+                return count <= 8 ? 1 : count <= 16 ? 2 : 4 * ((count + 31) / 32);
+            }
+        } // namespace
+
+        // =====================================================================
+        // Interning
+        // =====================================================================
+
+        TypeInterner::TypeInterner(TypeIdentity identity)
+            : identity_(identity), table_(64, 0), label_table_(64, 0)
+        {
+            std::fill(std::begin(leaves_), std::end(leaves_), NONE);
+        }
+
+        bool TypeInterner::labelled(TypeKind kind) const
+        {
+            return identity_ == TypeIdentity::Linking &&
+                   (kind == TypeKind::Record || kind == TypeKind::Variant ||
+                    kind == TypeKind::Enum || kind == TypeKind::Flags);
+        }
+
+        uint32_t TypeInterner::label(const std::string &name)
+        {
+            const uint64_t hash = hash_label(name);
+            const size_t mask = label_table_.size() - 1;
+            size_t slot = static_cast<size_t>(hash) & mask;
+            while (label_table_[slot] != 0)
+            {
+                const uint32_t id = label_table_[slot] - 1;
+                if (label_hashes_[id] == hash && labels_[id] == name)
+                {
+                    return id;
+                }
+                slot = (slot + 1) & mask;
+            }
+
+            const uint32_t id = static_cast<uint32_t>(labels_.size());
+            labels_.push_back(name);
+            label_hashes_.push_back(hash);
+            label_table_[slot] = id + 1;
+            if (labels_.size() * 2 > label_table_.size())
+            {
+                grow_labels();
+            }
+            return id;
+        }
+
+        void TypeInterner::grow_labels()
+        {
+            std::vector<uint32_t> table(label_table_.size() * 2, 0);
+            const size_t mask = table.size() - 1;
+            for (size_t id = 0; id < labels_.size(); ++id)
+            {
+                size_t slot = static_cast<size_t>(label_hashes_[id]) & mask;
+                while (table[slot] != 0)
+                {
+                    slot = (slot + 1) & mask;
+                }
+                table[slot] = static_cast<uint32_t>(id + 1);
+            }
+            label_table_.swap(table);
+        }
+
+        TypeId TypeInterner::intern(const InterfaceType &type)
+        {
+            return intern_children(type.kind, type.params);
+        }
+
+        Signature TypeInterner::intern(const FunctionType &type)
+        {
+            const TypeId params = intern_children(TypeKind::Tuple, type.params);
+            return Signature{params, intern_children(TypeKind::Tuple, type.results)};
+        }
+
+        TypeId TypeInterner::intern_children(TypeKind kind, const std::vector<InterfaceType> &params)
+        {
+            // Scalars and other leaves are most nodes of any type tree
+            if (params.empty())
+            {
+                TypeId &leaf = leaves_[static_cast<size_t>(kind)];
+                if (leaf == NONE)
+                {
+                    scratch_.push_back(static_cast<uint32_t>(kind));
+                    scratch_.push_back(0);
+                    leaf = intern_node(scratch_.size() - 2);
+                }
+                return leaf;
+            }
+
+            // Nested types are interned first, each appending and then
+            // releasing its own words above this node's
+            const size_t start = scratch_.size();
+            scratch_.push_back(static_cast<uint32_t>(kind));
+            scratch_.push_back(static_cast<uint32_t>(params.size()));
+            const bool by_count = identity_ == TypeIdentity::Layout &&
+                                  (kind == TypeKind::Enum || kind == TypeKind::Flags);
+            if (!by_count)
+            {
+                const bool named = labelled(kind);
+                for (const InterfaceType &param : params)
+                {
+                    if (named)
+                    {
+                        scratch_.push_back(label(param.name));
+                    }
+                    const TypeId child = intern(param);
+                    scratch_.push_back(child);
+                }
+            }
+            return intern_node(start);
+        }
+
+        TypeId TypeInterner::intern_node(size_t start)
+        {
+            const uint32_t *words = scratch_.data() + start;
+            const uint32_t length = static_cast<uint32_t>(scratch_.size() - start);
+            const uint64_t hash = hash_words(words, length);
+
+            const size_t mask = table_.size() - 1;
+            size_t slot = static_cast<size_t>(hash) & mask;
+            while (table_[slot] != 0)
+            {
+                const Node &node = nodes_[table_[slot] - 1];
+                if (node.hash == hash && node.length == length &&
+                    std::equal(words, words + length, words_.begin() + node.offset))
+                {
+                    scratch_.resize(start);
+                    return table_[slot] - 1;
+                }
+                slot = (slot + 1) & mask;
+            }
+
+            const TypeId id = static_cast<TypeId>(nodes_.size());
+            nodes_.push_back(Node{static_cast<uint32_t>(words_.size()), length, hash});
+            words_.insert(words_.end(), words, words + length);
+            scratch_.resize(start);
+            table_[slot] = id + 1;
+            if (nodes_.size() * 2 > table_.size())
+            {
+                grow();
+            }
+            return id;
+        }
+
+        void TypeInterner::grow()
+        {
+            std::vector<uint32_t> table(table_.size() * 2, 0);
+            const size_t mask = table.size() - 1;
+            for (size_t id = 0; id < nodes_.size(); ++id)
+            {
+                size_t slot = static_cast<size_t>(nodes_[id].hash) & mask;
+                while (table[slot] != 0)
+                {
+                    slot = (slot + 1) & mask;
+                }
+                table[slot] = static_cast<uint32_t>(id + 1);
+            }
+            table_.swap(table);
+        }
+
+        // =====================================================================
+        // Subtyping
+        // =====================================================================
+
+        bool TypeInterner::subtype(TypeId a, TypeId b)
+        {
+            if (a == b)
+            {
+                return true;
+            }
+            const uint64_t key = uint64_t(a) << 32 | b;
+            auto it = subtypes_.find(key);
+            if (it != subtypes_.end())
+            {
+                return it->second;
+            }
+            const bool result = check_subtype(a, b);
+            subtypes_.emplace(key, result);
+            return result;
+        }
+
+        bool TypeInterner::check_subtype(TypeId a, TypeId b)
+        {
+            const Node &x = nodes_[a];
+            const Node &y = nodes_[b];
+            const uint32_t *p = words_.data() + x.offset;
+            const uint32_t *q = words_.data() + y.offset;
+            if (p[0] != q[0])
+            {
+                return false;
+            }
+            const TypeKind kind = static_cast<TypeKind>(p[0]);
+
+            // Cases appended to an enum or flags keep existing values valid
+            // as long as the stored width does not change
+            if (kind == TypeKind::Enum || kind == TypeKind::Flags)
+            {
+                const bool same_width = kind == TypeKind::Enum
+                                            ? discriminant_size(p[1]) == discriminant_size(q[1])
+                                            : flags_size(p[1]) == flags_size(q[1]);
+                return p[1] <= q[1] && same_width && std::equal(p + 2, p + x.length, q + 2);
+            }
+
+            // Anything else needs the same shape, nested types aside: an
+            // extra variant case can change the payload's flat representation
+            // even when the discriminant width does not
+            if (x.length != y.length || p[1] != q[1])
+            {
+                return false;
+            }
+            const uint32_t stride = labelled(kind) ? 2 : 1;
+            for (uint32_t i = 2; i < x.length; i += stride)
+            {
+                if (stride == 2 && p[i] != q[i])
+                {
+                    return false;
+                }
+                if (!subtype(p[i + stride - 1], q[i + stride - 1]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool TypeInterner::satisfies(const Signature &import, const Signature &target)
+        {
+            return subtype(import.params, target.params) && subtype(target.results, import.results);
+        }
+
+    } // namespace component
+} // namespace flight
@@ -0,0 +1,241 @@
+// Flight Core Component - async stream and future tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/component/async.hpp>
+
+#include <cstring>
+#include <vector>
+
+using namespace flight::component;
+
+namespace
+{
+    constexpr uint32_t INPUT = 0;
+    constexpr uint32_t OUTPUT = 64;
+
+    // One instance over a small memory: bytes to write at INPUT, room to read at OUTPUT
+    struct Fixture
+    {
+        std::vector<uint8_t> bytes = std::vector<uint8_t>(128);
+        GuestMemory memory;
+        const MarshalPlan element{InterfaceType{TypeKind::U8, "", {}}};
+        Executor executor;
+        AsyncInstance instance{executor, memory};
+
+        Fixture()
+        {
+            memory.base = bytes.data();
+            memory.size = bytes.size();
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                bytes[INPUT + i] = static_cast<uint8_t>(i + 1);
+            }
+        }
+    };
+} // namespace
+
+// =============================================================================
+// Streams
+// =============================================================================
+
+TEST_CASE("Writes block on a full stream until it is read", "[component][async]")
+{
+    Fixture f;
+    auto ends = f.instance.stream_new(f.element, 4).value();
+
+    // Four elements fit; the rest of the write waits for the reader
+    REQUIRE(f.instance.write(ends.second, INPUT, 6).value() == BLOCKED);
+    REQUIRE(f.instance.read(ends.first, OUTPUT, 8).value() == copy_result(4, CopyStatus::Completed));
+    REQUIRE(std::memcmp(&f.bytes[OUTPUT], &f.bytes[INPUT], 4) == 0);
+
+    // The read made room: the write completed, its event waits for a set
+    const uint32_t set = f.instance.waitable_set_new().value();
+    REQUIRE(f.instance.join(ends.second, set));
+    Event event;
+    REQUIRE(f.instance.poll(set, event).value());
+    REQUIRE(event.code == EventCode::StreamWrite);
+    REQUIRE(event.handle == ends.second);
+    REQUIRE(event.payload == copy_result(6, CopyStatus::Completed));
+
+    REQUIRE(f.instance.read(ends.first, OUTPUT, 8).value() == copy_result(2, CopyStatus::Completed));
+    REQUIRE(f.bytes[OUTPUT + 1] == 6);
+}
+
+TEST_CASE("Blocked reads complete with the next write", "[component][async]")
+{
+    Fixture f;
+    auto ends = f.instance.stream_new(f.element, 4).value();
+    const uint32_t set = f.instance.waitable_set_new().value();
+    REQUIRE(f.instance.join(ends.first, set));
+
+    REQUIRE(f.instance.read(ends.first, OUTPUT, 4).value() == BLOCKED);
+    REQUIRE(f.instance.write(ends.second, INPUT, 3).value() == copy_result(3, CopyStatus::Completed));
+
+    Event event;
+    REQUIRE(f.instance.poll(set, event).value());
+    REQUIRE(event.code == EventCode::StreamRead);
+    REQUIRE(event.payload == copy_result(3, CopyStatus::Completed));
+}
+
+TEST_CASE("Dropping an end completes the other end's copies", "[component][async]")
+{
+    SECTION("A blocked read ends when the writer is dropped")
+    {
+        Fixture f;
+        auto ends = f.instance.stream_new(f.element, 4).value();
+        const uint32_t set = f.instance.waitable_set_new().value();
+        REQUIRE(f.instance.join(ends.first, set));
+        REQUIRE(f.instance.read(ends.first, OUTPUT, 4).value() == BLOCKED);
+        REQUIRE(f.instance.drop(ends.second));
+
+        Event event;
+        REQUIRE(f.instance.poll(set, event).value());
+        REQUIRE(event.payload == copy_result(0, CopyStatus::Dropped));
+    }
+    SECTION("Buffered elements are still read after the writer is dropped")
+    {
+        Fixture f;
+        auto ends = f.instance.stream_new(f.element, 4).value();
+        REQUIRE(f.instance.write(ends.second, INPUT, 2).value() == copy_result(2, CopyStatus::Completed));
+        REQUIRE(f.instance.drop(ends.second));
+        REQUIRE(f.instance.read(ends.first, OUTPUT, 4).value() == copy_result(2, CopyStatus::Completed));
+        REQUIRE(f.instance.read(ends.first, OUTPUT, 4).value() == copy_result(0, CopyStatus::Dropped));
+    }
+    SECTION("Writes to a dropped reader fail at once")
+    {
+        Fixture f;
+        auto ends = f.instance.stream_new(f.element, 4).value();
+        REQUIRE(f.instance.drop(ends.first));
+        REQUIRE(f.instance.write(ends.second, INPUT, 2).value() == copy_result(0, CopyStatus::Dropped));
+        REQUIRE(f.instance.drop(ends.second));
+        REQUIRE(f.executor.channels() == 0);
+    }
+    SECTION("Ends with a blocked copy cannot be dropped")
+    {
+        Fixture f;
+        auto ends = f.instance.stream_new(f.element, 4).value();
+        REQUIRE(f.instance.read(ends.first, OUTPUT, 4).value() == BLOCKED);
+        REQUIRE_FALSE(f.instance.drop(ends.first));
+    }
+}
+
+TEST_CASE("Stream buffers are checked against the instance memory", "[component][async]")
+{
+    Fixture f;
+    auto ends = f.instance.stream_new(f.element, 4).value();
+    REQUIRE_FALSE(f.instance.write(ends.second, 126, 4));
+    REQUIRE_FALSE(f.instance.read(ends.second, OUTPUT, 1));
+    REQUIRE_FALSE(f.instance.write(ends.first, INPUT, 1));
+}
+
+// =============================================================================
+// Cancellation
+// =============================================================================
+
+TEST_CASE("Cancelling a blocked copy reports what it copied", "[component][async][cancel]")
+{
+    Fixture f;
+    auto ends = f.instance.stream_new(f.element, 4).value();
+    REQUIRE(f.instance.write(ends.second, INPUT, 6).value() == BLOCKED);
+    REQUIRE(f.instance.cancel(ends.second).value() == copy_result(4, CopyStatus::Cancelled));
+    REQUIRE_FALSE(f.instance.cancel(ends.second));
+    REQUIRE(f.instance.drop(ends.second));
+}
+
+TEST_CASE("Cancelling a finished copy returns its result", "[component][async][cancel]")
+{
+    SECTION("Event held by an end outside any set")
+    {
+        Fixture f;
+        auto ends = f.instance.stream_new(f.element, 4).value();
+        REQUIRE(f.instance.read(ends.first, OUTPUT, 4).value() == BLOCKED);
+        REQUIRE(f.instance.write(ends.second, INPUT, 2).value() == copy_result(2, CopyStatus::Completed));
+
+        REQUIRE(f.instance.cancel(ends.first).value() == copy_result(2, CopyStatus::Completed));
+
+        // The event is withdrawn: joining a set later delivers nothing
+        const uint32_t set = f.instance.waitable_set_new().value();
+        REQUIRE(f.instance.join(ends.first, set));
+        Event event;
+        REQUIRE_FALSE(f.instance.poll(set, event).value());
+        REQUIRE_FALSE(f.instance.cancel(ends.first));
+    }
+    SECTION("Event queued on a set")
+    {
+        Fixture f;
+        auto ends = f.instance.stream_new(f.element, 4).value();
+        const uint32_t set = f.instance.waitable_set_new().value();
+        REQUIRE(f.instance.join(ends.first, set));
+        REQUIRE(f.instance.join(ends.second, set));
+        REQUIRE(f.instance.write(ends.second, INPUT, 6).value() == BLOCKED);
+        REQUIRE(f.instance.read(ends.first, OUTPUT, 8).value() == copy_result(4, CopyStatus::Completed));
+
+        REQUIRE(f.instance.cancel(ends.second).value() == copy_result(6, CopyStatus::Completed));
+        Event event;
+        REQUIRE_FALSE(f.instance.poll(set, event).value());
+    }
+}
+
+// =============================================================================
+// Futures and tasks
+// =============================================================================
+
+TEST_CASE("Futures copy one value once", "[component][async]")
+{
+    Fixture f;
+    auto ends = f.instance.future_new(f.element).value();
+    REQUIRE_FALSE(f.instance.write(ends.second, INPUT, 2));
+    REQUIRE(f.instance.write(ends.second, INPUT, 1).value() == copy_result(1, CopyStatus::Completed));
+    REQUIRE_FALSE(f.instance.write(ends.second, INPUT, 1));
+    REQUIRE(f.instance.read(ends.first, OUTPUT, 1).value() == copy_result(1, CopyStatus::Completed));
+    REQUIRE(f.bytes[OUTPUT] == f.bytes[INPUT]);
+    REQUIRE_FALSE(f.instance.read(ends.first, OUTPUT, 1));
+}
+
+namespace
+{
+    struct Waiter
+    {
+        AsyncInstance *instance;
+        uint32_t readable;
+        uint32_t set;
+        std::vector<Event> events;
+    };
+
+    flight::wasm::Result<uint32_t> wait_for_read(void *context, const Event &event)
+    {
+        Waiter &waiter = *static_cast<Waiter *>(context);
+        waiter.events.push_back(event);
+        if (event.code == EventCode::None)
+        {
+            auto read = waiter.instance->read(waiter.readable, OUTPUT, 4);
+            if (!read)
+            {
+                return read;
+            }
+            return wait_on(waiter.set);
+        }
+        return static_cast<uint32_t>(CallbackCode::Exit);
+    }
+} // namespace
+
+TEST_CASE("Tasks wait on a set without blocking the executor", "[component][async]")
+{
+    Fixture f;
+    auto ends = f.instance.stream_new(f.element, 4).value();
+    Waiter waiter{&f.instance, ends.first, f.instance.waitable_set_new().value(), {}};
+    REQUIRE(f.instance.join(ends.first, waiter.set));
+    f.instance.spawn(&wait_for_read, &waiter);
+
+    REQUIRE(f.executor.run().value() == 1);
+    REQUIRE(f.executor.tasks() == 1);
+    REQUIRE(f.executor.ready() == 0);
+
+    REQUIRE(f.instance.write(ends.second, INPUT, 3).value() == copy_result(3, CopyStatus::Completed));
+    REQUIRE(f.executor.ready() == 1);
+    REQUIRE(f.executor.run().value() == 1);
+    REQUIRE(f.executor.tasks() == 0);
+    REQUIRE(waiter.events.size() == 2);
+    REQUIRE(waiter.events[1].code == EventCode::StreamRead);
+    REQUIRE(waiter.events[1].payload == copy_result(3, CopyStatus::Completed));
+}
@@ -0,0 +1,380 @@
+// Flight Core Component - canonical ABI tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/component/canonical_abi.hpp>
+#include <flight/component/canonical_types.hpp>
+
+#include <cstring>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+using namespace flight;
+using namespace flight::component;
+
+namespace
+{
+    // A guest memory whose cabi_realloc bumps through a host buffer
+    struct Memory
+    {
+        std::vector<uint8_t> bytes = std::vector<uint8_t>(64 * 1024);
+        uint32_t top = 16;
+        GuestMemory guest;
+
+        explicit Memory(StringEncoding encoding = StringEncoding::Utf8)
+        {
+            guest.base = bytes.data();
+            guest.size = bytes.size();
+            guest.realloc = &bump;
+            guest.realloc_context = this;
+            guest.string_encoding = encoding;
+        }
+
+        static uint32_t bump(void *context, uint32_t, uint32_t, uint32_t alignment, uint32_t size)
+        {
+            Memory &memory = *static_cast<Memory *>(context);
+            const uint32_t ptr = (memory.top + alignment - 1) & ~(alignment - 1);
+            if (ptr + uint64_t(size) > memory.bytes.size())
+            {
+                return 0;
+            }
+            memory.top = ptr + size;
+            return ptr;
+        }
+    };
+
+    struct Point
+    {
+        int32_t x;
+        int32_t y;
+        static constexpr auto canonical_fields = std::make_tuple(&Point::x, &Point::y);
+    };
+
+    struct File
+    {
+    };
+
+    using Shape = std::variant<std::string, uint32_t, std::vector<std::optional<std::string>>>;
+    using Message = std::tuple<std::vector<Shape>, bool, std::string, char32_t, double>;
+
+    Message sample()
+    {
+        return Message{{Shape{std::string("hi")}, Shape{7u},
+                        Shape{std::vector<std::optional<std::string>>{std::nullopt, std::string("x\xC3\xA9")}}},
+                       true,
+                       "caf\xC3\xA9 \xF0\x9F\x90\xA6",
+                       U'\U0001F426',
+                       -2.5};
+    }
+
+    // Host values are compared with the ABI type of the engine's plans
+    template <typename T>
+    std::shared_ptr<const MarshalPlan> plan_of(CanonicalABI &abi)
+    {
+        return abi.plan(CanonicalType<T>::type());
+    }
+} // namespace
+
+// =============================================================================
+// Lift and lower
+// =============================================================================
+
+TEST_CASE("Values survive lower then lift", "[component][canonical]")
+{
+    Memory memory;
+    const Message value = sample();
+    auto offset = lower_new(memory.guest, value);
+    REQUIRE(offset);
+    auto lifted = lift<Message>(memory.guest, offset.value());
+    REQUIRE(lifted);
+    REQUIRE(lifted.value() == value);
+
+    const Point point{-3, 9};
+    auto stored = lower_new(memory.guest, point);
+    REQUIRE(stored);
+    auto loaded = lift<Point>(memory.guest, stored.value());
+    REQUIRE(loaded);
+    REQUIRE(loaded.value().x == -3);
+    REQUIRE(loaded.value().y == 9);
+}
+
+TEST_CASE("Strings round trip through every encoding", "[component][canonical][strings]")
+{
+    const std::string texts[] = {"", "ascii only", "Latin-1: caf\xC3\xA9", "wide: \xE2\x82\xAC \xF0\x9F\x90\xA6"};
+    for (StringEncoding encoding : {StringEncoding::Utf8, StringEncoding::Utf16, StringEncoding::Latin1Utf16})
+    {
+        Memory memory(encoding);
+        for (const std::string &text : texts)
+        {
+            auto stored = lower_new(memory.guest, text);
+            REQUIRE(stored);
+            auto lifted = lift<std::string>(memory.guest, stored.value());
+            REQUIRE(lifted);
+            REQUIRE(lifted.value() == text);
+        }
+    }
+}
+
+TEST_CASE("Lifting rejects malformed values", "[component][canonical]")
+{
+    Memory memory;
+    uint8_t *base = memory.guest.base;
+
+    // Misaligned and out of bounds
+    REQUIRE_FALSE(lift<uint32_t>(memory.guest, 2));
+    REQUIRE_FALSE(lift<uint64_t>(memory.guest, static_cast<uint32_t>(memory.bytes.size())));
+
+    // A string reaching past the end of memory
+    const uint32_t string[] = {static_cast<uint32_t>(memory.bytes.size() - 2), 4};
+    std::memcpy(base + 64, string, sizeof(string));
+    REQUIRE_FALSE(lift<std::string>(memory.guest, 64));
+
+    // Invalid UTF-8
+    base[128] = 0xC0;
+    base[129] = 0x80;
+    const uint32_t invalid[] = {128, 2};
+    std::memcpy(base + 64, invalid, sizeof(invalid));
+    REQUIRE_FALSE(lift<std::string>(memory.guest, 64));
+
+    // Surrogate code points are not chars
+    const uint32_t surrogate = 0xD800;
+    std::memcpy(base + 64, &surrogate, sizeof(surrogate));
+    REQUIRE_FALSE(lift<char32_t>(memory.guest, 64));
+
+    // Out-of-range variant cases
+    base[64] = 3;
+    REQUIRE_FALSE(lift<Shape>(memory.guest, 64));
+}
+
+// =============================================================================
+// Plans
+// =============================================================================
+
+TEST_CASE("Plain data compiles to a single copy", "[component][canonical][plan]")
+{
+    CanonicalABI abi;
+    auto point = plan_of<Point>(abi);
+    REQUIRE(point->trivially_copyable());
+    REQUIRE(point->layout().size == 8);
+    REQUIRE(point->layout().alignment == 4);
+
+    auto message = plan_of<Message>(abi);
+    REQUIRE_FALSE(message->trivially_copyable());
+    REQUIRE(message->layout().size == CanonicalType<Message>::size);
+    REQUIRE(message->layout().alignment == CanonicalType<Message>::alignment);
+}
+
+TEST_CASE("Plans are cached by layout", "[component][canonical][plan]")
+{
+    CanonicalABI abi;
+    auto first = plan_of<Message>(abi);
+    REQUIRE(plan_of<Message>(abi) == first);
+    REQUIRE(abi.cached_plans() == 1);
+
+    // Names do not change a layout
+    InterfaceType named = CanonicalType<Point>::type();
+    named.name = "point";
+    named.params[0].name = "column";
+    REQUIRE(abi.plan(named) == plan_of<Point>(abi));
+    REQUIRE(abi.cached_plans() == 2);
+}
+
+// =============================================================================
+// Transfer
+// =============================================================================
+
+TEST_CASE("Transfers between memories preserve values", "[component][canonical][transfer]")
+{
+    CanonicalABI abi;
+    auto plan = plan_of<Message>(abi);
+    const Message value = sample();
+    for (StringEncoding from : {StringEncoding::Utf8, StringEncoding::Utf16, StringEncoding::Latin1Utf16})
+    {
+        for (StringEncoding to : {StringEncoding::Utf8, StringEncoding::Utf16, StringEncoding::Latin1Utf16})
+        {
+            Memory source(from);
+            Memory destination(to);
+            auto offset = lower_new(source.guest, value);
+            REQUIRE(offset);
+            auto moved = CanonicalABI::transfer_new(*plan, source.guest, offset.value(), destination.guest);
+            REQUIRE(moved);
+            auto lifted = lift<Message>(destination.guest, moved.value());
+            REQUIRE(lifted);
+            REQUIRE(lifted.value() == value);
+        }
+    }
+}
+
+TEST_CASE("Transfers normalize bools and trap on invalid values", "[component][canonical][transfer]")
+{
+    CanonicalABI abi;
+    Memory source;
+    Memory destination;
+
+    source.guest.base[64] = 0x7F;
+    auto flag = plan_of<bool>(abi);
+    REQUIRE(CanonicalABI::transfer(*flag, source.guest, 64, destination.guest, 64));
+    REQUIRE(destination.guest.base[64] == 1);
+
+    const uint32_t surrogate = 0xDFFF;
+    std::memcpy(source.guest.base + 64, &surrogate, sizeof(surrogate));
+    REQUIRE_FALSE(CanonicalABI::transfer(*plan_of<char32_t>(abi), source.guest, 64, destination.guest, 64));
+
+    InterfaceType status{TypeKind::Enum, "", {}};
+    for (const char *name : {"ok", "busy", "gone"})
+    {
+        status.params.push_back(InterfaceType{TypeKind::Tuple, name, {}});
+    }
+    auto plan = abi.plan(status);
+    source.guest.base[64] = 2;
+    REQUIRE(CanonicalABI::transfer(*plan, source.guest, 64, destination.guest, 64));
+    source.guest.base[64] = 3;
+    REQUIRE_FALSE(CanonicalABI::transfer(*plan, source.guest, 64, destination.guest, 64));
+
+    // The destination must hold the whole value
+    REQUIRE_FALSE(CanonicalABI::transfer(*plan_of<Point>(abi), source.guest, 64, destination.guest,
+                                         static_cast<uint32_t>(destination.bytes.size() - 4)));
+}
+
+TEST_CASE("Transfers pass handles through the translator", "[component][canonical][transfer]")
+{
+    using Owned = std::vector<ResourceHandle<File>>;
+    CanonicalABI abi;
+    Memory source;
+    Memory destination;
+    auto offset = lower_new(source.guest, Owned{ResourceHandle<File>(1), ResourceHandle<File>(2)});
+    REQUIRE(offset);
+
+    TransferOptions options;
+    options.translate_handle = [](void *, TypeKind kind, uint32_t handle) -> wasm::Result<uint32_t> {
+        if (kind != TypeKind::Own || handle == 0)
+        {
+            return wasm::make_error<uint32_t>(wasm::ErrorCode::InvalidTableIndex, "Unknown handle");
+        }
+        return handle + 100;
+    };
+    auto moved = CanonicalABI::transfer_new(*plan_of<Owned>(abi), source.guest, offset.value(), destination.guest,
+                                            options);
+    REQUIRE(moved);
+    auto lifted = lift<Owned>(destination.guest, moved.value());
+    REQUIRE(lifted);
+    REQUIRE(lifted.value().size() == 2);
+    REQUIRE(lifted.value()[0].index() == 101);
+    REQUIRE(lifted.value()[1].index() == 102);
+
+    auto invalid = lower_new(source.guest, Owned{ResourceHandle<File>(0)});
+    REQUIRE_FALSE(CanonicalABI::transfer_new(*plan_of<Owned>(abi), source.guest, invalid.value(),
+                                             destination.guest, options));
+}
+
+// =============================================================================
+// Borrowed buffers
+// =============================================================================
+
+namespace
+{
+    uint32_t pointer_at(const GuestMemory &memory, uint32_t offset)
+    {
+        uint32_t ptr;
+        std::memcpy(&ptr, memory.base + offset, sizeof(ptr));
+        return ptr;
+    }
+} // namespace
+
+TEST_CASE("Shared memories lend strings and plain lists", "[component][canonical][borrow]")
+{
+    using Call = std::tuple<std::string, std::vector<uint32_t>, std::vector<std::string>>;
+    CanonicalABI abi;
+    Memory shared;
+    auto offset = lower_new(shared.guest, Call{"payload", {1, 2, 3}, {"a", "b"}});
+    REQUIRE(offset);
+
+    BorrowScope borrows;
+    TransferOptions options;
+    options.borrows = &borrows;
+    auto moved = CanonicalABI::transfer_new(*plan_of<Call>(abi), shared.guest, offset.value(), shared.guest, options);
+    REQUIRE(moved);
+
+    // The string and the u32 list are views of the caller's buffers; the
+    // list of strings is copied, its strings lent
+    REQUIRE(pointer_at(shared.guest, moved.value()) == pointer_at(shared.guest, offset.value()));
+    REQUIRE(pointer_at(shared.guest, moved.value() + 8) == pointer_at(shared.guest, offset.value() + 8));
+    REQUIRE(pointer_at(shared.guest, moved.value() + 16) != pointer_at(shared.guest, offset.value() + 16));
+    REQUIRE(borrows.size() == 4);
+
+    auto lifted = lift<Call>(shared.guest, moved.value());
+    REQUIRE(lifted);
+    REQUIRE(std::get<0>(lifted.value()) == "payload");
+    REQUIRE(std::get<2>(lifted.value())[1] == "b");
+    REQUIRE(borrows.release(shared.guest));
+    REQUIRE(borrows.size() == 0);
+}
+
+TEST_CASE("Separate memories and encodings still copy", "[component][canonical][borrow]")
+{
+    CanonicalABI abi;
+    BorrowScope borrows;
+    TransferOptions options;
+    options.borrows = &borrows;
+    const std::string text = "copied";
+
+    Memory source;
+    Memory destination;
+    auto offset = lower_new(source.guest, text);
+    auto moved = CanonicalABI::transfer_new(*plan_of<std::string>(abi), source.guest, offset.value(),
+                                            destination.guest, options);
+    REQUIRE(moved);
+    REQUIRE(borrows.size() == 0);
+    REQUIRE(lift<std::string>(destination.guest, moved.value()).value() == text);
+
+    // One memory seen with two encodings, as a UTF-16 callee sees a UTF-8 caller's
+    Memory shared;
+    GuestMemory utf16 = shared.guest;
+    utf16.string_encoding = StringEncoding::Utf16;
+    offset = lower_new(shared.guest, text);
+    moved = CanonicalABI::transfer_new(*plan_of<std::string>(abi), shared.guest, offset.value(), utf16, options);
+    REQUIRE(moved);
+    REQUIRE(borrows.size() == 0);
+    REQUIRE(lift<std::string>(utf16, moved.value()).value() == text);
+}
+
+#if FLIGHT_COMPONENT_BORROW_CHECKS
+TEST_CASE("Writes to a lent buffer are caught on release", "[component][canonical][borrow]")
+{
+    CanonicalABI abi;
+    Memory shared;
+    auto offset = lower_new(shared.guest, std::vector<uint8_t>{1, 2, 3, 4});
+    BorrowScope borrows;
+    TransferOptions options;
+    options.borrows = &borrows;
+    REQUIRE(CanonicalABI::transfer_new(*plan_of<std::vector<uint8_t>>(abi), shared.guest, offset.value(),
+                                       shared.guest, options));
+
+    shared.guest.base[pointer_at(shared.guest, offset.value()) + 2] = 9;
+    REQUIRE_FALSE(borrows.release(shared.guest));
+
+    // Released either way: the next call starts clean
+    REQUIRE(borrows.size() == 0);
+    REQUIRE(borrows.release(shared.guest));
+}
+#endif
+
+TEST_CASE("Views lift without copying", "[component][canonical][borrow]")
+{
+    Memory memory;
+    auto text = lower_new(memory.guest, std::string("view"));
+    auto view = lift<std::string_view>(memory.guest, text.value());
+    REQUIRE(view);
+    REQUIRE(view.value() == "view");
+    REQUIRE(reinterpret_cast<const uint8_t *>(view.value().data()) ==
+            memory.guest.base + pointer_at(memory.guest, text.value()));
+
+    auto blob = lower_new(memory.guest, std::vector<uint8_t>{7, 8, 9});
+    auto bytes = lift<ByteView>(memory.guest, blob.value());
+    REQUIRE(bytes);
+    REQUIRE(bytes.value().size == 3);
+    REQUIRE(bytes.value().data == memory.guest.base + pointer_at(memory.guest, blob.value()));
+    REQUIRE(bytes.value().data[2] == 9);
+}
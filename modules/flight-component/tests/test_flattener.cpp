@@ -0,0 +1,179 @@
+// Flight Core Component - flattener tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/component/flattener.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace flight::component;
+
+namespace
+{
+    using Bytes = std::vector<uint8_t>;
+
+    void append(Bytes &out, const Bytes &bytes)
+    {
+        out.insert(out.end(), bytes.begin(), bytes.end());
+    }
+
+    void section(Bytes &out, uint8_t id, const Bytes &contents)
+    {
+        out.push_back(id);
+        out.push_back(static_cast<uint8_t>(contents.size())); // Sections here stay under 128 bytes
+        append(out, contents);
+    }
+
+    // A core module with one page of memory and three functions:
+    //   load(addr) -> i32.load offset=4
+    //   store(addr, value) -> i32.store
+    //   fill(addr, value, length) -> memory.fill
+    // and, when data_offset is given, an active data segment of four bytes
+    Bytes core_module(int32_t data_offset = -1)
+    {
+        Bytes module = {0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00};
+        section(module, 1, {0x03, 0x60, 0x01, 0x7F, 0x01, 0x7F, 0x60, 0x02, 0x7F, 0x7F, 0x00,
+                            0x60, 0x03, 0x7F, 0x7F, 0x7F, 0x00});
+        section(module, 3, {0x03, 0x00, 0x01, 0x02});
+        section(module, 5, {0x01, 0x01, 0x01, 0x01}); // min 1, max 1
+        section(module, 10, {0x03,
+                             0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x04, 0x0B,
+                             0x09, 0x00, 0x20, 0x00, 0x20, 0x01, 0x36, 0x02, 0x00, 0x0B,
+                             0x0B, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0xFC, 0x0B, 0x00, 0x0B});
+        if (data_offset >= 0)
+        {
+            Bytes data = {0x01, 0x00, 0x41};
+            int32_t value = data_offset;
+            bool more = true;
+            while (more)
+            {
+                uint8_t byte = value & 0x7F;
+                value >>= 7;
+                more = !((value == 0 && !(byte & 0x40)) || (value == -1 && (byte & 0x40)));
+                data.push_back(more ? byte | 0x80 : byte);
+            }
+            append(data, {0x0B, 0x04, 1, 2, 3, 4});
+            section(module, 11, data);
+        }
+        return module;
+    }
+
+    // A component instantiating the core module once
+    ComponentBinary component(const Bytes &module)
+    {
+        Bytes bytes = {0x00, 0x61, 0x73, 0x6D, 0x0D, 0x00, 0x01, 0x00};
+        section(bytes, 1, module);
+        section(bytes, 2, {0x01, 0x00, 0x00, 0x00});
+        auto parsed = ComponentBinary::parse(std::move(bytes));
+        REQUIRE(parsed);
+        return std::move(parsed).value();
+    }
+
+    // The bounds check's trap: i64.gt_u, if, unreachable, end
+    bool traps(const flight::wasm::Function &function)
+    {
+        static const uint8_t TRAP[] = {0x56, 0x04, 0x40, 0x00, 0x0B};
+        const auto body = function.body();
+        return std::search(body.begin(), body.end(), std::begin(TRAP), std::end(TRAP)) != body.end();
+    }
+
+    // Reads the memarg offset of the first i32.load or i32.store
+    uint32_t memarg_offset(const flight::wasm::Function &function, uint8_t opcode)
+    {
+        const auto body = function.body();
+        const auto *at = std::find(body.begin(), body.end(), opcode);
+        REQUIRE(at != body.end());
+        uint32_t offset = 0;
+        uint32_t shift = 0;
+        for (at += 2; *at & 0x80; ++at, shift += 7)
+        {
+            offset |= uint32_t(*at & 0x7F) << shift;
+        }
+        return offset | uint32_t(*at) << shift;
+    }
+} // namespace
+
+// =============================================================================
+// Segments
+// =============================================================================
+
+TEST_CASE("Flattened components get disjoint segments", "[component][flattener]")
+{
+    Flattener flattener;
+    flattener.add("a", component(core_module()));
+    flattener.add("b", component(core_module()));
+    auto result = flattener.flatten();
+    REQUIRE(result);
+
+    const MemoryLayout &layout = result.value().layout;
+    REQUIRE(layout.size() == 2);
+    const MemorySegment &a = layout.segments()[0];
+    const MemorySegment &b = layout.segments()[1];
+    REQUIRE(b.base >= a.base + uint64_t(a.reserved_pages) * MemoryLayout::PAGE_SIZE);
+
+    // Three functions per component, then one memory.grow per segment
+    const flight::wasm::Module &module = result.value().module;
+    REQUIRE(module.functions.size() == 8);
+    REQUIRE(module.memories.size() == 1);
+    REQUIRE(memarg_offset(module.functions[0], 0x28) == a.base + 4);
+    REQUIRE(memarg_offset(module.functions[3], 0x28) == b.base + 4);
+    REQUIRE(memarg_offset(module.functions[4], 0x36) == b.base);
+}
+
+// =============================================================================
+// Isolation
+// =============================================================================
+
+TEST_CASE("Rebased accesses are bounds checked", "[component][flattener]")
+{
+    Flattener flattener;
+    flattener.add("a", component(core_module()));
+    flattener.add("b", component(core_module()));
+    auto result = flattener.flatten();
+    REQUIRE(result);
+
+    // Loads, stores and memory.fill of both segments, base 0 included
+    const flight::wasm::Module &module = result.value().module;
+    for (size_t i = 0; i < 6; ++i)
+    {
+        REQUIRE(traps(module.functions[i]));
+        REQUIRE(module.functions[i].locals.size() == 6);
+    }
+}
+
+TEST_CASE("Bounds checks can be turned off", "[component][flattener]")
+{
+    FlattenOptions options;
+    options.bounds_checks = false;
+    Flattener flattener(options);
+    flattener.add("a", component(core_module()));
+    flattener.add("b", component(core_module()));
+    auto result = flattener.flatten();
+    REQUIRE(result);
+
+    const flight::wasm::Module &module = result.value().module;
+    for (size_t i = 0; i < 6; ++i)
+    {
+        REQUIRE_FALSE(traps(module.functions[i]));
+    }
+    // Only memory.fill of the second segment still needs scratch locals to rebase
+    REQUIRE(module.functions[0].locals.empty());
+    REQUIRE(module.functions[2].locals.empty());
+    REQUIRE(module.functions[5].locals.size() == 6);
+}
+
+TEST_CASE("Data segments must fit their memory", "[component][flattener]")
+{
+    {
+        Flattener flattener;
+        flattener.add("a", component(core_module(65532)));
+        REQUIRE(flattener.flatten());
+    }
+    {
+        Flattener flattener;
+        flattener.add("a", component(core_module(65533)));
+        auto result = flattener.flatten();
+        REQUIRE_FALSE(result);
+        REQUIRE(result.error().code() == flight::wasm::ErrorCode::InvalidModule);
+    }
+}
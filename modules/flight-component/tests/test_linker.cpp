@@ -0,0 +1,350 @@
+// Flight Core Component - linker tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/component/linker.hpp>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace flight;
+using namespace flight::component;
+
+namespace
+{
+    // An instance with its own linear memory and a bump cabi_realloc
+    struct Instance
+    {
+        std::vector<uint8_t> bytes = std::vector<uint8_t>(64 * 1024);
+        uint32_t top = 16;
+        GuestMemory memory;
+        ResourceTable resources;
+
+        Instance()
+        {
+            memory.base = bytes.data();
+            memory.size = bytes.size();
+            memory.realloc = &bump;
+            memory.realloc_context = this;
+        }
+
+        static uint32_t bump(void *context, uint32_t, uint32_t, uint32_t alignment, uint32_t size)
+        {
+            Instance &instance = *static_cast<Instance *>(context);
+            const uint32_t ptr = (instance.top + alignment - 1) & ~(alignment - 1);
+            if (ptr + uint64_t(size) > instance.bytes.size())
+            {
+                return 0;
+            }
+            instance.top = ptr + size;
+            return ptr;
+        }
+
+        InstanceBinding binding() { return {this, &memory, &resources}; }
+    };
+
+    const InterfaceType U32{TypeKind::U32, "", {}};
+    const InterfaceType STRING{TypeKind::String, "", {}};
+    const FunctionType ADD{{U32, U32}, {U32}};
+    const FunctionType LOOKUP{{STRING}, {U32}};
+    const FunctionType LOG{{STRING}, {}};
+
+    InterfaceType level(size_t case_count)
+    {
+        InterfaceType type{TypeKind::Enum, "level", {}};
+        for (size_t i = 0; i < case_count; ++i)
+        {
+            type.params.push_back(InterfaceType{TypeKind::U32, "case-" + std::to_string(i), {}});
+        }
+        return type;
+    }
+
+    wasm::Result<void> add(void *, uint64_t *slots)
+    {
+        slots[0] = static_cast<uint32_t>(slots[0]) + static_cast<uint32_t>(slots[1]);
+        return wasm::Result<void>();
+    }
+
+    // lookup(key: string) -> u32: the key's length, read from the callee's memory
+    wasm::Result<void> lookup(void *instance, uint64_t *slots)
+    {
+        const GuestMemory &memory = static_cast<Instance *>(instance)->memory;
+        uint32_t length;
+        std::memcpy(&length, memory.base + slots[0] + 4, sizeof(length));
+        slots[0] = length;
+        return wasm::Result<void>();
+    }
+
+    wasm::Result<void> set_level(void *, uint64_t *)
+    {
+        return wasm::Result<void>();
+    }
+
+    // Counts calls; the caller's memory is the one passed in
+    struct Log
+    {
+        size_t calls = 0;
+        const GuestMemory *memory = nullptr;
+
+        static wasm::Result<void> call(void *context, GuestMemory &memory, uint64_t *)
+        {
+            Log &log = *static_cast<Log *>(context);
+            ++log.calls;
+            log.memory = &memory;
+            return wasm::Result<void>();
+        }
+    };
+
+    std::shared_ptr<ComponentDefinition> provider()
+    {
+        auto component = std::make_shared<ComponentDefinition>();
+        component->name = "provider";
+        component->exports.push_back({"app:api/math#add", ADD, &add});
+        component->exports.push_back({"app:api/math#lookup", LOOKUP, &lookup});
+        return component;
+    }
+
+    std::shared_ptr<ComponentDefinition> consumer(std::vector<ComponentImport> imports)
+    {
+        auto component = std::make_shared<ComponentDefinition>();
+        component->name = "consumer";
+        component->imports = std::move(imports);
+        return component;
+    }
+} // namespace
+
+// =============================================================================
+// Resolution
+// =============================================================================
+
+TEST_CASE("Imports resolve to direct, adapted or host targets", "[component][linker]")
+{
+    CanonicalABI abi;
+    AdapterCache adapters(abi);
+    Linker linker(adapters);
+    Log log;
+    REQUIRE(linker.define_host("wasi:logging/logging#log", LOG, &Log::call, &log));
+    linker.add(provider());
+    linker.add(consumer({{"app:api/math#add", ADD},
+                         {"app:api/math#lookup", LOOKUP},
+                         {"wasi:logging/logging#log", LOG}}));
+
+    auto graph = linker.link().value();
+    REQUIRE(graph->component_count() == 2);
+    REQUIRE(graph->import(1, 0).target == ImportTarget::Core);
+    REQUIRE(graph->import(1, 0).callee == 0);
+    REQUIRE(graph->import(1, 1).target == ImportTarget::Adapter);
+    REQUIRE(graph->import(1, 1).adapter->indirect_params);
+    REQUIRE_FALSE(graph->import(1, 1).adapter->indirect_results);
+    REQUIRE(graph->import(1, 2).target == ImportTarget::Host);
+
+    Instance callee;
+    Instance caller;
+    auto instance = graph->instantiate({callee.binding(), caller.binding()}).value();
+
+    SECTION("Direct calls pass slots through")
+    {
+        uint64_t slots[2] = {40, 2};
+        REQUIRE(instance.call_import(1, 0, slots));
+        REQUIRE(slots[0] == 42);
+    }
+
+    SECTION("Adapted calls copy parameters into the callee's memory")
+    {
+        const auto key = lower_string(caller.memory, "hello", 5).value();
+        const uint32_t tuple = caller.memory.allocate(8, 4).value();
+        std::memcpy(caller.bytes.data() + tuple, &key.first, 4);
+        std::memcpy(caller.bytes.data() + tuple + 4, &key.second, 4);
+        const uint32_t callee_top = callee.top;
+
+        uint64_t slots[1] = {tuple};
+        REQUIRE(instance.call_import(1, 1, slots));
+        REQUIRE(slots[0] == 5);
+        REQUIRE(callee.top > callee_top);
+    }
+
+    SECTION("Host calls receive the caller's memory")
+    {
+        uint64_t slots[1] = {0};
+        REQUIRE(instance.call_import(1, 2, slots));
+        REQUIRE(log.calls == 1);
+        REQUIRE(log.memory == &caller.memory);
+    }
+}
+
+TEST_CASE("Imports bind to the most recent earlier exporter", "[component][linker]")
+{
+    CanonicalABI abi;
+    AdapterCache adapters(abi);
+    Linker linker(adapters);
+    linker.add(provider());
+    linker.add(provider());
+    linker.add(consumer({{"app:api/math#add", ADD}}));
+
+    auto graph = linker.link().value();
+    REQUIRE(graph->import(2, 0).callee == 1);
+}
+
+TEST_CASE("Names are looked up per component", "[component][linker]")
+{
+    CanonicalABI abi;
+    AdapterCache adapters(abi);
+    Linker linker(adapters);
+    linker.add(provider());
+    linker.add(consumer({{"app:api/math#lookup", LOOKUP}, {"app:api/math#add", ADD}}));
+    auto graph = linker.link().value();
+
+    REQUIRE(graph->component_index("consumer").value() == 1);
+    REQUIRE(graph->import_index(1, "app:api/math#add").value() == 1);
+    REQUIRE(graph->export_index(0, "app:api/math#lookup").value() == 1);
+
+    REQUIRE(graph->component_index("missing").error().code() == wasm::ErrorCode::ExportNotFound);
+    REQUIRE_FALSE(graph->import_index(0, "app:api/math#add"));
+    REQUIRE(graph->export_index(1, "app:api/math#add").error().code() == wasm::ErrorCode::ExportNotFound);
+}
+
+// =============================================================================
+// Link errors
+// =============================================================================
+
+TEST_CASE("Imports without a provider fail to link", "[component][linker]")
+{
+    CanonicalABI abi;
+    AdapterCache adapters(abi);
+    Linker linker(adapters);
+    linker.add(consumer({{"app:api/math#add", ADD}}));
+    linker.add(provider());
+
+    // Exports are only visible to components added after their exporter
+    auto graph = linker.link();
+    REQUIRE_FALSE(graph);
+    REQUIRE(graph.error().code() == wasm::ErrorCode::ImportResolutionFailed);
+}
+
+TEST_CASE("Imports of another type than their export fail to link", "[component][linker]")
+{
+    CanonicalABI abi;
+    AdapterCache adapters(abi);
+    Linker linker(adapters);
+    linker.add(provider());
+
+    SECTION("Different parameters")
+    {
+        linker.add(consumer({{"app:api/math#add", FunctionType{{U32}, {U32}}}}));
+    }
+    SECTION("Different results")
+    {
+        linker.add(consumer({{"app:api/math#lookup", FunctionType{{STRING}, {STRING}}}}));
+    }
+
+    auto graph = linker.link();
+    REQUIRE_FALSE(graph);
+    REQUIRE(graph.error().code() == wasm::ErrorCode::TypeMismatch);
+}
+
+TEST_CASE("Imports of another type than their host function fail to link", "[component][linker]")
+{
+    CanonicalABI abi;
+    AdapterCache adapters(abi);
+    Linker linker(adapters);
+    Log log;
+    REQUIRE(linker.define_host("wasi:logging/logging#log", LOG, &Log::call, &log));
+    linker.add(consumer({{"wasi:logging/logging#log", FunctionType{{U32}, {}}}}));
+
+    auto graph = linker.link();
+    REQUIRE_FALSE(graph);
+    REQUIRE(graph.error().code() == wasm::ErrorCode::TypeMismatch);
+}
+
+TEST_CASE("Enums extended at the end link against older imports", "[component][linker]")
+{
+    CanonicalABI abi;
+    AdapterCache adapters(abi);
+    auto exporter = std::make_shared<ComponentDefinition>();
+    exporter->name = "logger";
+
+    SECTION("A parameter enum may gain cases")
+    {
+        exporter->exports.push_back({"app:api/log#set-level", FunctionType{{level(4)}, {}}, &set_level});
+        Linker linker(adapters);
+        linker.add(exporter);
+        linker.add(consumer({{"app:api/log#set-level", FunctionType{{level(3)}, {}}}}));
+        REQUIRE(linker.link());
+    }
+
+    SECTION("A parameter enum may not lose cases")
+    {
+        exporter->exports.push_back({"app:api/log#set-level", FunctionType{{level(3)}, {}}, &set_level});
+        Linker linker(adapters);
+        linker.add(exporter);
+        linker.add(consumer({{"app:api/log#set-level", FunctionType{{level(4)}, {}}}}));
+        REQUIRE(linker.link().error().code() == wasm::ErrorCode::TypeMismatch);
+    }
+
+    SECTION("A result enum may not gain cases")
+    {
+        exporter->exports.push_back({"app:api/log#get-level", FunctionType{{}, {level(4)}}, &set_level});
+        Linker linker(adapters);
+        linker.add(exporter);
+        linker.add(consumer({{"app:api/log#get-level", FunctionType{{}, {level(3)}}}}));
+        REQUIRE(linker.link().error().code() == wasm::ErrorCode::TypeMismatch);
+    }
+}
+
+TEST_CASE("Case names are part of a type", "[component][linker]")
+{
+    InterfaceType renamed = level(3);
+    renamed.params[2].name = "other";
+    REQUIRE(same_type(level(3), level(3)));
+    REQUIRE_FALSE(same_type(level(3), renamed));
+    REQUIRE_FALSE(same_signature(FunctionType{{level(3)}, {}}, FunctionType{{renamed}, {}}));
+
+    // Type names are not
+    InterfaceType retitled = level(3);
+    retitled.name = "severity";
+    REQUIRE(same_type(level(3), retitled));
+}
+
+// =============================================================================
+// Instantiation
+// =============================================================================
+
+TEST_CASE("Instantiation needs one binding with a memory per component", "[component][linker]")
+{
+    CanonicalABI abi;
+    AdapterCache adapters(abi);
+    Linker linker(adapters);
+    linker.add(provider());
+    linker.add(consumer({{"app:api/math#add", ADD}}));
+    auto graph = linker.link().value();
+
+    Instance a;
+    Instance b;
+    REQUIRE(graph->instantiate({a.binding()}).error().code() == wasm::ErrorCode::ModuleInstantiationFailed);
+    REQUIRE(graph->instantiate({a.binding(), InstanceBinding{&b}}).error().code() ==
+            wasm::ErrorCode::ModuleInstantiationFailed);
+    REQUIRE(graph->instantiate({a.binding(), b.binding()}));
+}
+
+TEST_CASE("Signatures with the same plans share one adapter", "[component][linker]")
+{
+    CanonicalABI abi;
+    AdapterCache adapters(abi);
+
+    const auto first = adapters.adapter(LOOKUP);
+    REQUIRE(adapters.adapter(LOOKUP) == first);
+    // Strings and lists of bytes lower to different plans
+    REQUIRE(adapters.adapter(FunctionType{{InterfaceType{TypeKind::List, "", {U32}}}, {U32}}) != first);
+    REQUIRE(adapters.size() == 2);
+
+    // Graphs linked against one cache reuse its adapters
+    for (int i = 0; i < 2; ++i)
+    {
+        Linker linker(adapters);
+        linker.add(provider());
+        linker.add(consumer({{"app:api/math#lookup", LOOKUP}}));
+        REQUIRE(linker.link().value()->import(1, 0).adapter == first.get());
+    }
+    REQUIRE(adapters.size() == 2);
+}
@@ -0,0 +1,186 @@
+// Flight Core Component - memory layout tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/component/memory_layout.hpp>
+
+#include <string>
+
+using namespace flight;
+using namespace flight::component;
+
+namespace
+{
+    constexpr uint64_t PAGE = MemoryLayout::PAGE_SIZE;
+
+    // Whether no two reserves overlap or come closer than the guard gap
+    bool separated(const MemoryLayout &layout)
+    {
+        const auto &segments = layout.segments();
+        for (size_t i = 1; i < segments.size(); ++i)
+        {
+            const uint64_t previous_end = segments[i - 1].base + segments[i - 1].reserved_pages * PAGE;
+            if (segments[i].base < previous_end + layout.profile().guard_bytes)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+// =============================================================================
+// Planning
+// =============================================================================
+
+TEST_CASE("Segments are aligned and separated by guard gaps", "[component][layout]")
+{
+    for (const char *name : {"dreamcast", "psp", "vita", "desktop"})
+    {
+        PlatformProfile profile;
+        REQUIRE(PlatformProfile::named(name, profile));
+        LayoutPlanner planner(profile);
+        planner.add("a", wasm::Limits(1));
+        planner.add("b", wasm::Limits(1, 2));
+        planner.add("c", wasm::Limits(0, 1));
+
+        const MemoryLayout layout = planner.plan().value();
+        REQUIRE(layout.size() == 3);
+        REQUIRE(separated(layout));
+        for (const MemorySegment &segment : layout.segments())
+        {
+            REQUIRE(segment.base % profile.alignment == 0);
+        }
+    }
+}
+
+TEST_CASE("Reserves come from the maximum or the default reserve", "[component][layout]")
+{
+    LayoutPlanner planner(PlatformProfile::dreamcast());
+    planner.add("bounded", wasm::Limits(1, 2));
+    planner.add("small", wasm::Limits(1));
+    planner.add("large", wasm::Limits(6));
+
+    const MemoryLayout layout = planner.plan().value();
+    const auto &segments = layout.segments();
+    REQUIRE(segments[0].base == 0);
+    REQUIRE(segments[0].reserved_pages == 2);
+    REQUIRE(segments[1].reserved_pages == 4);
+    REQUIRE(segments[2].reserved_pages == 6);
+    REQUIRE(segments[2].initial_pages == 6);
+
+    // Dreamcast bases are only 32-byte aligned: a guard gap, not a whole page
+    REQUIRE(segments[1].base == 2 * PAGE + 4096);
+
+    const uint64_t reserved = (2 + 4 + 6) * PAGE;
+    REQUIRE(layout.maximum_pages() * PAGE >= segments[2].base + 6 * PAGE);
+    REQUIRE(layout.overhead_bytes() == layout.maximum_pages() * PAGE - reserved);
+    REQUIRE(layout.initial_pages() == (segments[2].base + 6 * PAGE + PAGE - 1) / PAGE);
+}
+
+TEST_CASE("Plans exceeding the platform capacity fail", "[component][layout]")
+{
+    // 16 MiB: 256 pages, less the guard gaps
+    LayoutPlanner planner(PlatformProfile::dreamcast());
+    planner.add("a", wasm::Limits(128, 128));
+    planner.add("b", wasm::Limits(128, 128));
+
+    auto layout = planner.plan();
+    REQUIRE_FALSE(layout);
+    REQUIRE(layout.error().code() == wasm::ErrorCode::MemoryLimitExceeded);
+
+    LayoutPlanner fits(PlatformProfile::dreamcast());
+    fits.add("a", wasm::Limits(128, 128));
+    fits.add("b", wasm::Limits(127, 127));
+    REQUIRE(fits.plan());
+}
+
+TEST_CASE("Invalid limits and malformed profiles fail to plan", "[component][layout]")
+{
+    SECTION("Minimum above maximum")
+    {
+        LayoutPlanner planner;
+        planner.add("a", wasm::Limits(2, 1));
+        REQUIRE(planner.plan().error().code() == wasm::ErrorCode::InvalidMemorySize);
+    }
+
+    SECTION("Alignment not a power of two")
+    {
+        PlatformProfile profile;
+        profile.alignment = 48;
+        LayoutPlanner planner(profile);
+        planner.add("a", wasm::Limits(1));
+        REQUIRE(planner.plan().error().code() == wasm::ErrorCode::InvalidAlignment);
+    }
+
+    SECTION("Capacity beyond 4 GiB")
+    {
+        PlatformProfile profile;
+        profile.capacity = 65536ull * 65536 + 1;
+        REQUIRE(LayoutPlanner(profile).plan().error().code() == wasm::ErrorCode::MemoryLimitExceeded);
+    }
+}
+
+TEST_CASE("Unknown profile names are rejected", "[component][layout]")
+{
+    PlatformProfile profile = PlatformProfile::psp();
+    REQUIRE_FALSE(PlatformProfile::named("gamecube", profile));
+    REQUIRE(std::string(profile.name) == "psp");
+}
+
+// =============================================================================
+// Relocation table
+// =============================================================================
+
+TEST_CASE("Addresses map to their segment and gaps to none", "[component][layout]")
+{
+    LayoutPlanner planner(PlatformProfile::psp());
+    planner.add("a", wasm::Limits(1, 1));
+    planner.add("b", wasm::Limits(1, 2));
+    planner.add("c", wasm::Limits(1, 1));
+    const MemoryLayout layout = planner.plan().value();
+    const auto &segments = layout.segments();
+
+    for (uint32_t i = 0; i < segments.size(); ++i)
+    {
+        const uint64_t end = segments[i].base + segments[i].reserved_pages * PAGE;
+        REQUIRE(layout.segment_of(segments[i].base) == i);
+        REQUIRE(layout.segment_of(end - 1) == i);
+        REQUIRE(layout.segment_of(end) == MemoryLayout::NONE);
+    }
+    // Guard gap before b, and past the last reserve
+    REQUIRE(layout.segment_of(segments[1].base - 1) == MemoryLayout::NONE);
+    REQUIRE(layout.segment_of(uint64_t(layout.maximum_pages()) * PAGE) == MemoryLayout::NONE);
+}
+
+TEST_CASE("Translation is checked against the current size", "[component][layout]")
+{
+    LayoutPlanner planner(PlatformProfile::vita());
+    planner.add("a", wasm::Limits(1, 1));
+    planner.add("b", wasm::Limits(1, 3));
+    MemoryLayout layout = planner.plan().value();
+    const uint32_t base = layout.segments()[1].base;
+
+    uint64_t address = 0;
+    REQUIRE(layout.translate(1, 16, 8, address));
+    REQUIRE(address == base + 16);
+    REQUIRE(layout.contains(1, 0, PAGE));
+    REQUIRE_FALSE(layout.contains(1, 1, PAGE));
+    REQUIRE_FALSE(layout.translate(1, PAGE - 4, 8, address));
+    REQUIRE_FALSE(layout.contains(1, 0xFFFFFFFF, 2));
+
+    SECTION("Growing within the reserve widens the checks")
+    {
+        REQUIRE(layout.set_pages(1, 3));
+        REQUIRE(layout.pages(1) == 3);
+        REQUIRE(layout.translate(1, PAGE - 4, 8, address));
+        REQUIRE(address == base + PAGE - 4);
+    }
+
+    SECTION("Growing beyond the reserve fails and keeps the size")
+    {
+        REQUIRE_FALSE(layout.set_pages(1, 4));
+        REQUIRE_FALSE(layout.set_pages(0, 2));
+        REQUIRE(layout.pages(1) == 1);
+        REQUIRE(layout.pages(0) == 1);
+    }
+}
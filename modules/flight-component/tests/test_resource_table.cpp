@@ -0,0 +1,214 @@
+// Flight Core Component - resource table tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/component/resource_table.hpp>
+
+#include <vector>
+
+using namespace flight::component;
+
+namespace
+{
+    // Records every representation its destructor receives
+    struct Destroyed
+    {
+        std::vector<uint32_t> reps;
+        size_t calls = 0;
+
+        static void destroy(void *context, const uint32_t *reps, size_t count)
+        {
+            auto *self = static_cast<Destroyed *>(context);
+            self->reps.insert(self->reps.end(), reps, reps + count);
+            ++self->calls;
+        }
+    };
+} // namespace
+
+// =============================================================================
+// Handles
+// =============================================================================
+
+TEST_CASE("Own handles resolve until dropped", "[component][resources]")
+{
+    Destroyed destroyed;
+    const ResourceType file{&Destroyed::destroy, &destroyed};
+    ResourceTable table;
+
+    const uint32_t handle = table.create(file, 42).value();
+    REQUIRE(handle != 0);
+    REQUIRE(table.rep(handle, file).value() == 42);
+    REQUIRE(table.type_of(handle) == &file);
+
+    REQUIRE(table.drop(handle, file));
+    REQUIRE(destroyed.reps == std::vector<uint32_t>{42});
+    REQUIRE(table.size() == 0);
+}
+
+TEST_CASE("Stale handles never reach a newer resource", "[component][resources]")
+{
+    const ResourceType file{};
+    ResourceTable table;
+
+    const uint32_t stale = table.create(file, 1).value();
+    REQUIRE(table.drop(stale, file));
+    const uint32_t fresh = table.create(file, 2).value();
+
+    // Same slot, new generation
+    REQUIRE(ResourceTable::slot_of(fresh) == ResourceTable::slot_of(stale));
+    REQUIRE(fresh != stale);
+    REQUIRE_FALSE(table.rep(stale, file));
+    REQUIRE_FALSE(table.drop(stale, file));
+    REQUIRE(table.rep(fresh, file).value() == 2);
+}
+
+TEST_CASE("Handles of another type are rejected", "[component][resources]")
+{
+    const ResourceType file{};
+    const ResourceType socket{};
+    ResourceTable table;
+
+    const uint32_t handle = table.create(file, 7).value();
+    REQUIRE_FALSE(table.rep(handle, socket));
+    REQUIRE_FALSE(table.drop(handle, socket));
+    REQUIRE_FALSE(table.take(handle, socket));
+    REQUIRE(table.rep(handle, file).value() == 7);
+}
+
+TEST_CASE("Slots retire when their generation runs out", "[component][resources]")
+{
+    const ResourceType file{};
+    ResourceTable table;
+    constexpr uint32_t LAST_GENERATION = (1u << ResourceTable::GENERATION_BITS) - 1;
+
+    std::vector<uint32_t> handles;
+    uint32_t handle = table.create(file, 0).value();
+    const uint32_t slot = ResourceTable::slot_of(handle);
+    for (uint32_t i = 0; i < LAST_GENERATION; ++i)
+    {
+        handles.push_back(handle);
+        REQUIRE(table.drop(handle, file));
+        handle = table.create(file, 0).value();
+        REQUIRE(ResourceTable::slot_of(handle) == slot);
+    }
+    REQUIRE(ResourceTable::generation_of(handle) == LAST_GENERATION);
+
+    // The saturated slot is not reused, so no earlier handle comes back
+    REQUIRE(table.drop(handle, file));
+    const uint32_t next = table.create(file, 0).value();
+    REQUIRE(ResourceTable::slot_of(next) != slot);
+    for (uint32_t old : handles)
+    {
+        REQUIRE(old != next);
+        REQUIRE_FALSE(table.rep(old, file));
+    }
+}
+
+// =============================================================================
+// Borrows and call scopes
+// =============================================================================
+
+TEST_CASE("Lent handles are pinned for the call", "[component][resources][borrow]")
+{
+    const ResourceType file{};
+    ResourceTable caller;
+    ResourceTable callee;
+
+    const uint32_t own = caller.create(file, 5).value();
+    {
+        CallScope scope;
+        const uint32_t rep = caller.lend(own, file, scope).value();
+        const uint32_t borrowed = callee.borrow(file, rep, scope).value();
+        REQUIRE(scope.live_borrows() == 1);
+
+        REQUIRE_FALSE(caller.drop(own, file));
+        REQUIRE_FALSE(caller.take(own, file));
+
+        REQUIRE(callee.rep(borrowed, file).value() == 5);
+        REQUIRE(callee.drop(borrowed, file));
+        REQUIRE(scope.finish());
+    }
+    REQUIRE(caller.drop(own, file));
+}
+
+TEST_CASE("Leaked borrows trap when the call returns", "[component][resources][borrow]")
+{
+    const ResourceType file{};
+    ResourceTable caller;
+    ResourceTable callee;
+
+    const uint32_t own = caller.create(file, 5).value();
+    CallScope scope;
+    REQUIRE(callee.borrow(file, caller.lend(own, file, scope).value(), scope));
+    REQUIRE_FALSE(scope.finish());
+
+    // The lender is unpinned all the same
+    REQUIRE(caller.drop(own, file));
+}
+
+TEST_CASE("Handles move and borrow through resource_translator", "[component][resources][borrow]")
+{
+    const ResourceType file{};
+    ResourceTable caller;
+    ResourceTable callee;
+    CallScope scope;
+    HandleTransfer transfer{&caller, &callee, &scope};
+
+    const uint32_t own = caller.create(file, 9).value();
+    const uint32_t borrowed = resource_translator(&transfer, TypeKind::Borrow, own).value();
+    REQUIRE(callee.rep(borrowed, file).value() == 9);
+    REQUIRE(caller.rep(own, file).value() == 9);
+
+    const uint32_t moved = resource_translator(&transfer, TypeKind::Own, caller.create(file, 10).value()).value();
+    REQUIRE(callee.rep(moved, file).value() == 10);
+    REQUIRE(caller.size() == 1);
+
+    REQUIRE(callee.drop(borrowed, file));
+    REQUIRE(scope.finish());
+}
+
+// =============================================================================
+// Teardown
+// =============================================================================
+
+TEST_CASE("destroy_all batches destructors per type", "[component][resources]")
+{
+    Destroyed files;
+    Destroyed sockets;
+    const ResourceType file{&Destroyed::destroy, &files};
+    const ResourceType socket{&Destroyed::destroy, &sockets};
+    ResourceTable table;
+
+    REQUIRE(table.create(file, 1));
+    REQUIRE(table.create(socket, 2));
+    REQUIRE(table.create(file, 3));
+    table.destroy_all();
+
+    REQUIRE(files.calls == 1);
+    REQUIRE(files.reps == std::vector<uint32_t>{1, 3});
+    REQUIRE(sockets.reps == std::vector<uint32_t>{2});
+    REQUIRE(table.size() == 0);
+}
+
+TEST_CASE("destroy_all keeps handles stale and live scopes safe", "[component][resources]")
+{
+    const ResourceType file{};
+    ResourceTable caller;
+    ResourceTable callee;
+
+    const uint32_t own = caller.create(file, 1).value();
+    CallScope scope;
+    const uint32_t rep = caller.lend(own, file, scope).value();
+    const uint32_t borrowed = callee.borrow(file, rep, scope).value();
+    REQUIRE(callee.drop(borrowed, file));
+
+    // The caller is torn down mid-call and its slot reused
+    caller.destroy_all();
+    REQUIRE_FALSE(caller.rep(own, file));
+    const uint32_t reused = caller.create(file, 2).value();
+    REQUIRE(ResourceTable::slot_of(reused) == ResourceTable::slot_of(own));
+    REQUIRE(reused != own);
+
+    // Finishing the call must not unpin the new resource
+    REQUIRE(scope.finish());
+    REQUIRE(caller.drop(reused, file));
+}
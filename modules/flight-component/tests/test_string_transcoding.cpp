@@ -0,0 +1,160 @@
+// Flight Core Component - string transcoding tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/component/string_transcoding.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace flight::component;
+using namespace flight::component::transcoding;
+
+namespace
+{
+    const uint8_t *bytes(const std::string &text)
+    {
+        return reinterpret_cast<const uint8_t *>(text.data());
+    }
+
+    std::u16string to_utf16(const std::string &text)
+    {
+        const size_t length = utf16_length_from_utf8(bytes(text), text.size());
+        REQUIRE(length != INVALID_LENGTH);
+        std::u16string out(length, u'\0');
+        REQUIRE(convert_utf8_to_utf16(bytes(text), text.size(), &out[0]) == length);
+        return out;
+    }
+
+    std::string to_utf8(const std::u16string &text)
+    {
+        const size_t length = utf8_length_from_utf16(text.data(), text.size());
+        REQUIRE(length != INVALID_LENGTH);
+        std::string out(length, '\0');
+        REQUIRE(convert_utf16_to_utf8(text.data(), text.size(), reinterpret_cast<uint8_t *>(&out[0])) == length);
+        return out;
+    }
+
+    // Long enough to take every vector path, with the interesting bytes
+    // placed across vector boundaries
+    std::string padded(const std::string &middle, size_t before = 61)
+    {
+        return std::string(before, 'a') + middle + std::string(67, 'z');
+    }
+} // namespace
+
+// =============================================================================
+// Validation
+// =============================================================================
+
+TEST_CASE("UTF-8 validation follows the Unicode definition", "[component][strings]")
+{
+    const std::string valid[] = {"", "plain ascii", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF",
+                                 "\xEE\x80\x80", "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF"};
+    const std::string invalid[] = {
+        "\x80",             // Lone continuation
+        "\xC0\x80",         // Overlong NUL
+        "\xC1\xBF",         // Overlong ASCII
+        "\xE0\x9F\xBF",     // Overlong three-byte
+        "\xED\xA0\x80",     // Surrogate
+        "\xF0\x8F\xBF\xBF", // Overlong four-byte
+        "\xF4\x90\x80\x80", // Above U+10FFFF
+        "\xF5\x80\x80\x80", // Invalid lead byte
+        "\xE2\x82",         // Truncated
+        "\xC3"              // Truncated at the end
+    };
+    for (const std::string &text : valid)
+    {
+        REQUIRE(validate_utf8(bytes(text), text.size()));
+        for (size_t before : {0, 13, 31, 61, 63})
+        {
+            const std::string long_text = padded(text, before);
+            REQUIRE(validate_utf8(bytes(long_text), long_text.size()));
+        }
+    }
+    for (const std::string &text : invalid)
+    {
+        REQUIRE_FALSE(validate_utf8(bytes(text), text.size()));
+        REQUIRE(utf16_length_from_utf8(bytes(text), text.size()) == INVALID_LENGTH);
+        for (size_t before : {0, 13, 31, 61, 63})
+        {
+            const std::string long_text = padded(text, before);
+            REQUIRE_FALSE(validate_utf8(bytes(long_text), long_text.size()));
+            REQUIRE(utf16_length_from_utf8(bytes(long_text), long_text.size()) == INVALID_LENGTH);
+        }
+    }
+}
+
+TEST_CASE("UTF-16 validation rejects unpaired surrogates", "[component][strings]")
+{
+    const std::u16string valid = u"pair \xD83D\xDC26 end";
+    REQUIRE(validate_utf16(valid.data(), valid.size()));
+    for (const std::u16string &text : {std::u16string(u"\xD83D"), std::u16string(u"\xDC26 x"),
+                                       std::u16string(u"x \xD83D y"), std::u16string(u"\xDC26\xD83D")})
+    {
+        REQUIRE_FALSE(validate_utf16(text.data(), text.size()));
+        REQUIRE(utf8_length_from_utf16(text.data(), text.size()) == INVALID_LENGTH);
+    }
+}
+
+TEST_CASE("ASCII detection covers every position", "[component][strings]")
+{
+    std::string text(100, 'x');
+    REQUIRE(is_ascii(bytes(text), text.size()));
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        std::string marked = text;
+        marked[i] = '\x80';
+        REQUIRE_FALSE(is_ascii(bytes(marked), marked.size()));
+    }
+    REQUIRE(is_ascii(nullptr, 0));
+}
+
+// =============================================================================
+// Conversion
+// =============================================================================
+
+TEST_CASE("UTF-8 and UTF-16 convert both ways", "[component][strings]")
+{
+    const std::string texts[] = {"", "hello", "caf\xC3\xA9", "\xE2\x82\xAC", "bird \xF0\x9F\x90\xA6",
+                                 padded("\xF0\x9F\x90\xA6\xC3\xA9\xE2\x82\xAC")};
+    for (const std::string &text : texts)
+    {
+        const std::u16string wide = to_utf16(text);
+        REQUIRE(to_utf8(wide) == text);
+    }
+    REQUIRE(to_utf16("\xF0\x9F\x90\xA6") == u"\xD83D\xDC26");
+}
+
+TEST_CASE("Latin-1 holds code points up to U+00FF only", "[component][strings]")
+{
+    const std::string fits = padded("caf\xC3\xA9 \xC3\xBF");
+    const size_t length = latin1_length_from_utf8(bytes(fits), fits.size());
+    REQUIRE(length == fits.size() - 2);
+    std::vector<uint8_t> latin1(length);
+    REQUIRE(convert_utf8_to_latin1(bytes(fits), fits.size(), latin1.data()) == length);
+    REQUIRE(latin1[61 + 3] == 0xE9);
+
+    // And back
+    std::string utf8(utf8_length_from_latin1(latin1.data(), latin1.size()), '\0');
+    REQUIRE(convert_latin1_to_utf8(latin1.data(), latin1.size(), reinterpret_cast<uint8_t *>(&utf8[0])) ==
+            utf8.size());
+    REQUIRE(utf8 == fits);
+
+    const std::string wide = padded("\xC4\x80"); // U+0100
+    REQUIRE(latin1_length_from_utf8(bytes(wide), wide.size()) == INVALID_LENGTH);
+
+    const std::u16string narrow = u"caf\x00E9";
+    REQUIRE(utf16_fits_latin1(narrow.data(), narrow.size()));
+    REQUIRE_FALSE(utf16_fits_latin1(u"\x0100", 1));
+    std::vector<uint8_t> from_utf16(narrow.size());
+    REQUIRE(convert_utf16_to_latin1(narrow.data(), narrow.size(), from_utf16.data()) == narrow.size());
+    std::u16string to_wide(from_utf16.size(), u'\0');
+    REQUIRE(convert_latin1_to_utf16(from_utf16.data(), from_utf16.size(), &to_wide[0]) == narrow.size());
+    REQUIRE(to_wide == narrow);
+}
+
+TEST_CASE("Transcoders report their instruction set", "[component][strings]")
+{
+    REQUIRE(implementation() != nullptr);
+    REQUIRE(std::string(implementation()).size() > 0);
+}
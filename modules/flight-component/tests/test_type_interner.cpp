@@ -0,0 +1,199 @@
+// Flight Core Component - type interner tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/component/type_interner.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace flight::component;
+
+namespace
+{
+    const InterfaceType U8{TypeKind::U8, "", {}};
+    const InterfaceType U32{TypeKind::U32, "", {}};
+    const InterfaceType STRING{TypeKind::String, "", {}};
+
+    // An enum or flags type with count cases named case-0, case-1, ...
+    InterfaceType cases(TypeKind kind, size_t count)
+    {
+        InterfaceType type{kind, "cases", {}};
+        for (size_t i = 0; i < count; ++i)
+        {
+            type.params.push_back(InterfaceType{TypeKind::U32, "case-" + std::to_string(i), {}});
+        }
+        return type;
+    }
+
+    InterfaceType record(const std::string &first, const std::string &second)
+    {
+        return InterfaceType{TypeKind::Record, "point", {{TypeKind::S32, first, {}}, {TypeKind::S32, second, {}}}};
+    }
+
+    InterfaceType list_of(const InterfaceType &element)
+    {
+        return InterfaceType{TypeKind::List, "", {element}};
+    }
+} // namespace
+
+// =============================================================================
+// Identity
+// =============================================================================
+
+TEST_CASE("Equal types intern to one ID", "[component][interner]")
+{
+    TypeInterner types;
+    const TypeId a = types.intern(list_of(record("x", "y")));
+    const size_t size = types.size();
+
+    // A separately built copy adds no nodes
+    REQUIRE(types.intern(list_of(record("x", "y"))) == a);
+    REQUIRE(types.size() == size);
+    REQUIRE(types.kind(a) == TypeKind::List);
+
+    REQUIRE(types.intern(list_of(U32)) != a);
+    REQUIRE(types.intern(list_of(U8)) != types.intern(list_of(U32)));
+    REQUIRE(types.intern(STRING) != types.intern(list_of(U8)));
+}
+
+TEST_CASE("Function types intern to parameter and result tuples", "[component][interner]")
+{
+    TypeInterner types;
+    const Signature add = types.intern(FunctionType{{U32, U32}, {U32}});
+    REQUIRE(add == types.intern(FunctionType{{U32, U32}, {U32}}));
+    REQUIRE(add != types.intern(FunctionType{{U32}, {U32, U32}}));
+    REQUIRE(types.kind(add.params) == TypeKind::Tuple);
+
+    // A tuple parameter is not the same as two parameters
+    const InterfaceType pair{TypeKind::Tuple, "", {U32, U32}};
+    REQUIRE(types.intern(pair) == add.params);
+    REQUIRE(types.intern(FunctionType{{pair}, {U32}}) != add);
+}
+
+TEST_CASE("Names matter for linking but not for layout", "[component][interner]")
+{
+    SECTION("Linking identity")
+    {
+        TypeInterner types(TypeIdentity::Linking);
+        REQUIRE(types.intern(record("x", "y")) != types.intern(record("x", "z")));
+        InterfaceType renamed = cases(TypeKind::Enum, 3);
+        renamed.params[1].name = "other";
+        REQUIRE(types.intern(cases(TypeKind::Enum, 3)) != types.intern(renamed));
+
+        // Type names never do
+        InterfaceType retitled = record("x", "y");
+        retitled.name = "vector";
+        REQUIRE(types.intern(record("x", "y")) == types.intern(retitled));
+    }
+
+    SECTION("Layout identity")
+    {
+        TypeInterner types(TypeIdentity::Layout);
+        REQUIRE(types.intern(record("x", "y")) == types.intern(record("x", "z")));
+        InterfaceType renamed = cases(TypeKind::Flags, 3);
+        renamed.params[1].name = "other";
+        REQUIRE(types.intern(cases(TypeKind::Flags, 3)) == types.intern(renamed));
+        REQUIRE(types.intern(cases(TypeKind::Flags, 3)) != types.intern(cases(TypeKind::Flags, 4)));
+        REQUIRE(types.intern(cases(TypeKind::Enum, 3)) != types.intern(cases(TypeKind::Flags, 3)));
+    }
+}
+
+TEST_CASE("Interning survives table growth", "[component][interner]")
+{
+    TypeInterner types;
+    std::vector<TypeId> ids;
+    for (size_t i = 1; i <= 200; ++i)
+    {
+        ids.push_back(types.intern(cases(TypeKind::Enum, i)));
+    }
+    for (size_t i = 1; i <= 200; ++i)
+    {
+        REQUIRE(types.intern(cases(TypeKind::Enum, i)) == ids[i - 1]);
+    }
+    // One node per enum, plus the shared u32 leaf
+    REQUIRE(types.size() == 201);
+}
+
+// =============================================================================
+// Subtyping
+// =============================================================================
+
+TEST_CASE("Enums extended at the end are subtypes while their width holds", "[component][interner]")
+{
+    TypeInterner types;
+    const TypeId three = types.intern(cases(TypeKind::Enum, 3));
+    const TypeId four = types.intern(cases(TypeKind::Enum, 4));
+
+    REQUIRE(types.subtype(three, four));
+    REQUIRE_FALSE(types.subtype(four, three));
+
+    // Cases inserted before the end renumber the later ones
+    InterfaceType reordered = cases(TypeKind::Enum, 4);
+    std::swap(reordered.params[2], reordered.params[3]);
+    REQUIRE_FALSE(types.subtype(three, types.intern(reordered)));
+
+    // 256 cases fit one byte, 257 need two
+    const TypeId byte = types.intern(cases(TypeKind::Enum, 256));
+    const TypeId wide = types.intern(cases(TypeKind::Enum, 257));
+    REQUIRE(types.subtype(three, byte));
+    REQUIRE_FALSE(types.subtype(byte, wide));
+    REQUIRE_FALSE(types.subtype(three, wide));
+}
+
+TEST_CASE("Flags extended at the end are subtypes while their width holds", "[component][interner]")
+{
+    TypeInterner types;
+    const TypeId five = types.intern(cases(TypeKind::Flags, 5));
+    REQUIRE(types.subtype(five, types.intern(cases(TypeKind::Flags, 8))));
+    REQUIRE_FALSE(types.subtype(five, types.intern(cases(TypeKind::Flags, 9))));
+    REQUIRE(types.subtype(types.intern(cases(TypeKind::Flags, 33)), types.intern(cases(TypeKind::Flags, 64))));
+    REQUIRE_FALSE(types.subtype(types.intern(cases(TypeKind::Flags, 32)), types.intern(cases(TypeKind::Flags, 33))));
+}
+
+TEST_CASE("Subtyping reaches through nested types", "[component][interner]")
+{
+    TypeInterner types;
+    auto wrap = [](const InterfaceType &status) {
+        return list_of(InterfaceType{TypeKind::Record, "entry", {{TypeKind::U32, "id", {}}, status}});
+    };
+    InterfaceType three = cases(TypeKind::Enum, 3);
+    InterfaceType four = cases(TypeKind::Enum, 4);
+    three.name = four.name = "status";
+    three.params[0].name = four.params[0].name = "ok";
+
+    const TypeId older = types.intern(wrap(three));
+    const TypeId newer = types.intern(wrap(four));
+    REQUIRE(older != newer);
+    REQUIRE(types.subtype(older, newer));
+    REQUIRE_FALSE(types.subtype(newer, older));
+}
+
+TEST_CASE("Variants with an extra case are not subtypes", "[component][interner]")
+{
+    TypeInterner types;
+    const InterfaceType two{TypeKind::Variant, "shape", {{TypeKind::U32, "circle", {}}, {TypeKind::U8, "square", {}}}};
+    InterfaceType three = two;
+    three.params.push_back(InterfaceType{TypeKind::U64, "line", {}});
+
+    REQUIRE_FALSE(types.subtype(types.intern(two), types.intern(three)));
+    REQUIRE_FALSE(types.subtype(types.intern(three), types.intern(two)));
+    REQUIRE_FALSE(types.subtype(types.intern(U8), types.intern(U32)));
+}
+
+TEST_CASE("Imports are satisfied by contravariant parameters and covariant results", "[component][interner]")
+{
+    TypeInterner types;
+    const InterfaceType three = cases(TypeKind::Enum, 3);
+    const InterfaceType four = cases(TypeKind::Enum, 4);
+
+    const Signature takes_three = types.intern(FunctionType{{three}, {}});
+    const Signature takes_four = types.intern(FunctionType{{four}, {}});
+    REQUIRE(types.satisfies(takes_three, takes_four));
+    REQUIRE_FALSE(types.satisfies(takes_four, takes_three));
+
+    const Signature returns_three = types.intern(FunctionType{{}, {three}});
+    const Signature returns_four = types.intern(FunctionType{{}, {four}});
+    REQUIRE(types.satisfies(returns_four, returns_three));
+    REQUIRE_FALSE(types.satisfies(returns_three, returns_four));
+}
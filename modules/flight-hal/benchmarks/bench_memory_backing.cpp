@@ -0,0 +1,90 @@
+// Flight Core HAL - memory backing benchmarks
+//
+// Random block accesses across a large pool-sized mapping with base pages,
+// transparent huge pages and reserved huge pages. The working set is far
+// beyond TLB reach with 4 KiB pages, so the gap is mostly page walks.
+
+#include <benchmark/benchmark.h>
+#include <flight/hal/memory_backing.hpp>
+
+#if defined(FLIGHT_PLATFORM_LINUX)
+
+#include <cstdint>
+
+using namespace flight::hal;
+
+namespace
+{
+    constexpr size_t MAPPING_SIZE = 256 * 1024 * 1024;
+    constexpr size_t BLOCK_SIZE = 4096;
+    constexpr size_t ACCESSES = 4096;
+
+    void run_random_access(benchmark::State &state, HugePageMode mode)
+    {
+        MemoryBacking backing;
+        backing.huge_pages = mode;
+        backing.numa_node = NUMA_NODE_LOCAL;
+        backing.prefault = true;
+        BackedMemory memory = memory_backing::map(MAPPING_SIZE, backing);
+        if (!memory)
+        {
+            state.SkipWithError("mapping failed");
+            return;
+        }
+
+        uint8_t *bytes = static_cast<uint8_t *>(memory.base);
+        const size_t blocks = MAPPING_SIZE / BLOCK_SIZE;
+        uint64_t seed = 0x9E3779B97F4A7C15ull;
+        uint64_t sum = 0;
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < ACCESSES; ++i)
+            {
+                seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+                sum += bytes[(seed >> 33) % blocks * BLOCK_SIZE];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ACCESSES));
+
+        PoolStats stats{};
+        memory_backing::query_stats(memory, stats);
+        state.counters["page_kib"] = static_cast<double>(memory.page_size / 1024);
+        state.counters["huge"] = static_cast<double>(memory.huge_pages != HugePageMode::None);
+        state.counters["node0_mib"] = static_cast<double>(stats.node_resident[0] >> 20);
+        memory_backing::unmap(memory);
+    }
+} // namespace
+
+static void BM_RandomAccess_BasePages(benchmark::State &state)
+{
+    run_random_access(state, HugePageMode::None);
+}
+BENCHMARK(BM_RandomAccess_BasePages);
+
+static void BM_RandomAccess_TransparentHuge(benchmark::State &state)
+{
+    run_random_access(state, HugePageMode::Transparent);
+}
+BENCHMARK(BM_RandomAccess_TransparentHuge);
+
+static void BM_RandomAccess_ExplicitHuge(benchmark::State &state)
+{
+    run_random_access(state, HugePageMode::Explicit);
+}
+BENCHMARK(BM_RandomAccess_ExplicitHuge);
+
+static void BM_MapPrefault(benchmark::State &state)
+{
+    MemoryBacking backing;
+    backing.huge_pages = static_cast<HugePageMode>(state.range(0));
+    backing.prefault = true;
+    for (auto _ : state)
+    {
+        BackedMemory memory = memory_backing::map(64 * 1024 * 1024, backing);
+        memory_backing::unmap(memory);
+    }
+}
+BENCHMARK(BM_MapPrefault)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+#endif // FLIGHT_PLATFORM_LINUX
@@ -0,0 +1,59 @@
+// Flight Core HAL - PoolAllocator benchmarks
+//
+// Block churn on one shared pool through the lock-free free list and
+// through per-thread caches, from 1 to 32 threads.
+
+#include <benchmark/benchmark.h>
+#include <flight/hal/memory_manager.hpp>
+
+#include <vector>
+
+using flight::hal::PoolAllocator;
+
+namespace
+{
+    constexpr size_t BLOCK_SIZE = 64;
+    constexpr size_t BLOCK_COUNT = 16384;
+    constexpr size_t BATCH = 16;
+
+    PoolAllocator &shared_pool()
+    {
+        static std::vector<uint8_t> memory(BLOCK_SIZE * BLOCK_COUNT);
+        static PoolAllocator pool;
+        static bool initialized = pool.initialize(memory.data(), memory.size(), BLOCK_SIZE);
+        (void)initialized;
+        return pool;
+    }
+
+    template <typename Source>
+    void run_churn(benchmark::State &state, Source &source)
+    {
+        void *blocks[BATCH];
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < BATCH; ++i)
+            {
+                blocks[i] = source.allocate();
+            }
+            benchmark::DoNotOptimize(blocks);
+            for (size_t i = 0; i < BATCH; ++i)
+            {
+                source.deallocate(blocks[i]);
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH));
+    }
+} // namespace
+
+static void BM_PoolSharedFreeList(benchmark::State &state)
+{
+    run_churn(state, shared_pool());
+}
+BENCHMARK(BM_PoolSharedFreeList)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_PoolThreadCache(benchmark::State &state)
+{
+    PoolAllocator::Cache cache(shared_pool());
+    run_churn(state, cache);
+}
+BENCHMARK(BM_PoolThreadCache)->ThreadRange(1, 32)->UseRealTime();
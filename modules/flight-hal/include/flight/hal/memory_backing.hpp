@@ -0,0 +1,93 @@
+#ifndef FLIGHT_HAL_MEMORY_BACKING_HPP
+#define FLIGHT_HAL_MEMORY_BACKING_HPP
+
+#include "memory_manager.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace flight
+{
+    namespace hal
+    {
+
+        // Virtual memory mapped according to a MemoryBacking
+        //
+        // Platform memory managers use this to reserve pool storage and
+        // component regions. Large pools backed by huge pages need far fewer
+        // TLB entries, and binding them to the node of the threads that use
+        // them keeps accesses off the inter-socket link. Every request
+        // degrades gracefully: huge pages fall back to base pages, NUMA
+        // binding is skipped on single-node machines, and unless
+        // MemoryBacking::numa_strict is set the node is only preferred, so
+        // pages spill to other nodes instead of failing when it is full.
+        struct BackedMemory
+        {
+            void *base = nullptr;
+            size_t size = 0;            // Mapped size, rounded up to page_size
+            size_t page_size = 0;       // Huge page size, or the base page size
+            HugePageMode huge_pages = HugePageMode::None; // What was actually obtained
+            int32_t numa_node = NUMA_NODE_ANY;            // Node the memory is bound to
+
+            explicit operator bool() const { return base != nullptr; }
+        };
+
+        namespace memory_backing
+        {
+            // Maps at least size bytes; returns an empty BackedMemory on failure
+            BackedMemory map(size_t size, const MemoryBacking &backing);
+
+            void unmap(BackedMemory &memory);
+
+            // Node of the calling thread, or 0 when it cannot be determined
+            int32_t current_node();
+
+            // Number of NUMA nodes with memory (1 without NUMA support)
+            uint32_t node_count();
+
+            // Fills the backing fields of stats: page size, bound node and
+            // resident bytes per node, estimated from a sample of at most
+            // max_samples pages
+            void query_stats(const BackedMemory &memory, PoolStats &stats, size_t max_samples = 4096);
+        } // namespace memory_backing
+
+        // The pools of a MemoryConfig, each over its own mapping
+        //
+        // Memory managers on platforms with virtual memory build their pools
+        // here: initialize() maps every configured pool with the config's
+        // backing, and get_pool_stats() adds the backing page size, node and
+        // per-node residency to the allocator's statistics.
+        class BackedPools
+        {
+        public:
+            BackedPools() = default;
+            ~BackedPools() { release(); }
+
+            BackedPools(const BackedPools &) = delete;
+            BackedPools &operator=(const BackedPools &) = delete;
+
+            // Maps the small, medium, large and canonical pools; on failure
+            // nothing stays mapped
+            bool initialize(const MemoryConfig &config);
+            void release();
+
+            // Pool serving a PoolType, or nullptr for types without a pool
+            PoolAllocator *pool(PoolType type);
+            const BackedMemory *memory(PoolType type) const;
+
+            // Zeroed stats for types without a pool
+            PoolStats get_pool_stats(PoolType type) const;
+
+        private:
+            static constexpr size_t POOL_COUNT = 4;
+
+            // Slot of a PoolType, or POOL_COUNT
+            static size_t slot_of(PoolType type);
+
+            PoolAllocator pools_[POOL_COUNT];
+            BackedMemory memory_[POOL_COUNT];
+        };
+
+    } // namespace hal
+} // namespace flight
+
+#endif // FLIGHT_HAL_MEMORY_BACKING_HPP
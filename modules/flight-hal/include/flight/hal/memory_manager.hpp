@@ -7,6 +7,15 @@
 #include <cstring>
 #include <atomic>
 
+// BLOCK_MAGIC corruption and double-free checks in PoolAllocator
+#ifndef FLIGHT_HAL_POOL_CHECKS
+#ifdef NDEBUG
+#define FLIGHT_HAL_POOL_CHECKS 0
+#else
+#define FLIGHT_HAL_POOL_CHECKS 1
+#endif
+#endif
+
 namespace flight
 {
     namespace hal
@@ -35,6 +44,32 @@ namespace flight
             const char *name;
         };
 
+        // NUMA node selectors for MemoryBacking::numa_node
+        constexpr int32_t NUMA_NODE_ANY = -1;   // Leave placement to the OS
+        constexpr int32_t NUMA_NODE_LOCAL = -2; // Node of the thread that maps the memory
+
+        // Largest node index reported in PoolStats::node_resident
+        constexpr uint32_t MAX_NUMA_NODES = 8;
+
+        // Page size used to back pools and component regions
+        enum class HugePageMode : uint8_t
+        {
+            None,        // Base pages
+            Transparent, // Ask the kernel to promote to huge pages when it can
+            Explicit     // Reserved huge pages, falling back to Transparent
+        };
+
+        // Physical placement of pools and component regions on platforms
+        // with virtual memory. Ignored where FLIGHT_HAS_MMAP is 0.
+        struct MemoryBacking
+        {
+            HugePageMode huge_pages = HugePageMode::None;
+            size_t huge_page_threshold = 0; // Smaller mappings use base pages
+            int32_t numa_node = NUMA_NODE_ANY;
+            bool prefault = false;    // Touch every page at map time, after binding
+            bool numa_strict = false; // Never spill to other nodes; by default the node is only preferred
+        };
+
         // Pool statistics
         struct PoolStats
         {
@@ -48,6 +83,11 @@ namespace flight
             uint32_t peak_used_blocks;
             uint64_t allocation_count;
             uint64_t deallocation_count;
+
+            // Backing placement; zero/NUMA_NODE_ANY for pools over plain memory
+            size_t page_size;                     // Page size backing the pool
+            int32_t numa_node;                    // Node the pool is bound to
+            size_t node_resident[MAX_NUMA_NODES]; // Resident bytes per node (sampled)
         };
 
         // Platform memory configuration
@@ -71,6 +111,9 @@ namespace flight
             PoolConfig medium_pool;
             PoolConfig large_pool;
             PoolConfig canonical_pool;
+
+            // Page size and NUMA placement of pools and component regions
+            MemoryBacking backing;
         };
 
         // Platform-specific memory configurations
@@ -78,63 +121,68 @@ namespace flight
         {
             // Desktop configuration (plenty of memory)
             constexpr MemoryConfig DESKTOP_CONFIG = {
-                .total_memory = 1024 * 1024 * 1024, // 1GB
-                .component_budget = 512 * 1024 * 1024,
-                .runtime_budget = 256 * 1024 * 1024,
-                .asset_budget = 256 * 1024 * 1024,
-                .system_reserved = 0,
-                .small_pool = {4 * 1024 * 1024, 64, 65536},
-                .medium_pool = {16 * 1024 * 1024, 512, 32768},
-                .large_pool = {64 * 1024 * 1024, 4096, 16384},
-                .canonical_pool = {8 * 1024 * 1024, 256, 32768}};
+                1024 * 1024 * 1024, // total_memory (1GB)
+                512 * 1024 * 1024, // component_budget
+                256 * 1024 * 1024, // runtime_budget
+                256 * 1024 * 1024, // asset_budget
+                0, // system_reserved
+                {4 * 1024 * 1024, 64, 65536}, // small_pool
+                {16 * 1024 * 1024, 512, 32768}, // medium_pool
+                {64 * 1024 * 1024, 4096, 16384}, // large_pool
+                {8 * 1024 * 1024, 256, 32768}, // canonical_pool
+                {HugePageMode::Transparent, 4 * 1024 * 1024, NUMA_NODE_LOCAL, true}}; // backing
 
             // PS Vita configuration (512MB)
             constexpr MemoryConfig VITA_CONFIG = {
-                .total_memory = 512 * 1024 * 1024,
-                .component_budget = 256 * 1024 * 1024,
-                .runtime_budget = 128 * 1024 * 1024,
-                .asset_budget = 96 * 1024 * 1024,
-                .system_reserved = 32 * 1024 * 1024,
-                .small_pool = {2 * 1024 * 1024, 64, 32768},
-                .medium_pool = {8 * 1024 * 1024, 512, 16384},
-                .large_pool = {32 * 1024 * 1024, 4096, 8192},
-                .canonical_pool = {4 * 1024 * 1024, 256, 16384}};
+                512 * 1024 * 1024, // total_memory
+                256 * 1024 * 1024, // component_budget
+                128 * 1024 * 1024, // runtime_budget
+                96 * 1024 * 1024, // asset_budget
+                32 * 1024 * 1024, // system_reserved
+                {2 * 1024 * 1024, 64, 32768}, // small_pool
+                {8 * 1024 * 1024, 512, 16384}, // medium_pool
+                {32 * 1024 * 1024, 4096, 8192}, // large_pool
+                {4 * 1024 * 1024, 256, 16384}, // canonical_pool
+                {}}; // backing
 
             // PSP configuration (32-64MB)
             constexpr MemoryConfig PSP_CONFIG = {
-                .total_memory = 32 * 1024 * 1024,
-                .component_budget = 12 * 1024 * 1024,
-                .runtime_budget = 10 * 1024 * 1024,
-                .asset_budget = 8 * 1024 * 1024,
-                .system_reserved = 2 * 1024 * 1024,
-                .small_pool = {512 * 1024, 64, 8192},
-                .medium_pool = {2 * 1024 * 1024, 512, 4096},
-                .large_pool = {4 * 1024 * 1024, 4096, 1024},
-                .canonical_pool = {1 * 1024 * 1024, 256, 4096}};
+                32 * 1024 * 1024, // total_memory
+                12 * 1024 * 1024, // component_budget
+                10 * 1024 * 1024, // runtime_budget
+                8 * 1024 * 1024, // asset_budget
+                2 * 1024 * 1024, // system_reserved
+                {512 * 1024, 64, 8192}, // small_pool
+                {2 * 1024 * 1024, 512, 4096}, // medium_pool
+                {4 * 1024 * 1024, 4096, 1024}, // large_pool
+                {1 * 1024 * 1024, 256, 4096}, // canonical_pool
+                {}}; // backing
 
             // Dreamcast configuration (16MB)
             constexpr MemoryConfig DREAMCAST_CONFIG = {
-                .total_memory = 16 * 1024 * 1024,
-                .component_budget = 4 * 1024 * 1024,
-                .runtime_budget = 6 * 1024 * 1024,
-                .asset_budget = 4 * 1024 * 1024,
-                .system_reserved = 2 * 1024 * 1024,
-                .small_pool = {256 * 1024, 64, 4096},
-                .medium_pool = {1 * 1024 * 1024, 512, 2048},
-                .large_pool = {2 * 1024 * 1024, 4096, 512},
-                .canonical_pool = {512 * 1024, 256, 2048}};
+                16 * 1024 * 1024, // total_memory
+                4 * 1024 * 1024, // component_budget
+                6 * 1024 * 1024, // runtime_budget
+                4 * 1024 * 1024, // asset_budget
+                2 * 1024 * 1024, // system_reserved
+                {256 * 1024, 64, 4096}, // small_pool
+                {1 * 1024 * 1024, 512, 2048}, // medium_pool
+                {2 * 1024 * 1024, 4096, 512}, // large_pool
+                {512 * 1024, 256, 2048}, // canonical_pool
+                {}}; // backing
 
             // Web/Emscripten configuration (browser dependent)
             constexpr MemoryConfig WEB_CONFIG = {
-                .total_memory = 256 * 1024 * 1024, // 256MB default
-                .component_budget = 128 * 1024 * 1024,
-                .runtime_budget = 64 * 1024 * 1024,
-                .asset_budget = 48 * 1024 * 1024,
-                .system_reserved = 16 * 1024 * 1024,
-                .small_pool = {1 * 1024 * 1024, 64, 16384},
-                .medium_pool = {4 * 1024 * 1024, 512, 8192},
-                .large_pool = {16 * 1024 * 1024, 4096, 4096},
-                .canonical_pool = {2 * 1024 * 1024, 256, 8192}};
+                256 * 1024 * 1024, // total_memory (256MB default)
+                128 * 1024 * 1024, // component_budget
+                64 * 1024 * 1024, // runtime_budget
+                48 * 1024 * 1024, // asset_budget
+                16 * 1024 * 1024, // system_reserved
+                {1 * 1024 * 1024, 64, 16384}, // small_pool
+                {4 * 1024 * 1024, 512, 8192}, // medium_pool
+                {16 * 1024 * 1024, 4096, 4096}, // large_pool
+                {2 * 1024 * 1024, 256, 8192}, // canonical_pool
+                {}}; // backing
         }
 
         // Memory manager driver interface
@@ -154,7 +202,8 @@ namespace flight
             // Aligned allocation from pools
             virtual void *pool_alloc_aligned(PoolType pool, size_t size, size_t alignment) = 0;
 
-            // Get pool statistics
+            // Get pool statistics, including backing page size and per-node
+            // residency where the platform has NUMA
             virtual PoolStats get_pool_stats(PoolType pool) const = 0;
 
             // Memory regions for components
@@ -179,23 +228,31 @@ namespace flight
             virtual void set_oom_handler(std::function<void()> handler) = 0;
         };
 
-        // Simple pool allocator implementation
+        // Fixed-block pool allocator, safe for concurrent use
+        //
+        // The free list is a lock-free stack of block indices. Its head packs
+        // the top index (low 32 bits) with a version tag (high 32 bits) that
+        // changes on every update, so a stale compare-exchange cannot succeed
+        // after a block was popped and pushed back (ABA). Threads that churn
+        // a pool heavily can put a Cache in front of it to move blocks in
+        // batches. BLOCK_MAGIC checks run when FLIGHT_HAL_POOL_CHECKS is set
+        // (the default in debug builds).
         class PoolAllocator
         {
         private:
             struct BlockHeader
             {
-                uint32_t next_free; // Index of next free block
-                uint32_t magic;     // Magic number for corruption detection
+                std::atomic<uint32_t> next_free; // Index of next free block
+                std::atomic<uint32_t> magic;     // Magic number for corruption detection
             };
 
             uint8_t *memory_base_;
             size_t pool_size_;
             size_t block_size_;
             uint32_t block_count_;
-            uint32_t free_list_;
-            std::atomic<uint32_t> used_blocks_;
-            uint32_t peak_blocks_;
+            alignas(64) std::atomic<uint64_t> free_list_; // Tag << 32 | head index
+            alignas(64) std::atomic<uint32_t> used_blocks_;
+            std::atomic<uint32_t> peak_blocks_;
             std::atomic<uint64_t> alloc_count_;
             std::atomic<uint64_t> free_count_;
 
@@ -203,12 +260,17 @@ namespace flight
             static constexpr uint32_t FREE_BLOCK_MAGIC = 0xFEEDFACE;
 
         public:
+            class Cache;
+
             PoolAllocator()
                 : memory_base_(nullptr), pool_size_(0), block_size_(0),
                   block_count_(0), free_list_(0), used_blocks_(0),
                   peak_blocks_(0), alloc_count_(0), free_count_(0) {}
 
-            // Initialize pool with pre-allocated memory
+            PoolAllocator(const PoolAllocator &) = delete;
+            PoolAllocator &operator=(const PoolAllocator &) = delete;
+
+            // Initialize pool with pre-allocated memory (not thread-safe)
             bool initialize(void *memory, size_t pool_size, size_t block_size)
             {
                 if (!memory || pool_size == 0 || block_size < sizeof(BlockHeader))
@@ -218,12 +280,15 @@ namespace flight
 
                 // Align block size to 8 bytes
                 block_size = (block_size + 7) & ~7;
+                if (pool_size / block_size == 0 || pool_size / block_size >= UINT32_MAX)
+                {
+                    return false;
+                }
 
                 memory_base_ = static_cast<uint8_t *>(memory);
                 pool_size_ = pool_size;
                 block_size_ = block_size;
-                block_count_ = pool_size / block_size;
-                free_list_ = 0;
+                block_count_ = static_cast<uint32_t>(pool_size / block_size);
                 used_blocks_ = 0;
                 peak_blocks_ = 0;
                 alloc_count_ = 0;
@@ -233,12 +298,13 @@ namespace flight
                 for (uint32_t i = 0; i < block_count_; ++i)
                 {
                     BlockHeader *header = get_block_header(i);
-                    header->next_free = i + 1;
-                    header->magic = FREE_BLOCK_MAGIC;
+                    header->next_free.store(i + 1, std::memory_order_relaxed);
+                    header->magic.store(FREE_BLOCK_MAGIC, std::memory_order_relaxed);
                 }
 
                 // Last block points to invalid index
-                get_block_header(block_count_ - 1)->next_free = block_count_;
+                get_block_header(block_count_ - 1)->next_free.store(block_count_, std::memory_order_relaxed);
+                free_list_.store(0, std::memory_order_release);
 
                 return true;
             }
@@ -246,107 +312,81 @@ namespace flight
             // Allocate a block
             void *allocate()
             {
-                if (free_list_ >= block_count_)
+                const uint32_t block_index = pop_block();
+                if (block_index >= block_count_)
                 {
                     return nullptr; // Out of memory
                 }
-
-                uint32_t block_index = free_list_;
-                BlockHeader *header = get_block_header(block_index);
-
-                // Validate magic
-                if (header->magic != FREE_BLOCK_MAGIC)
+                if (!mark_allocated(block_index))
                 {
                     return nullptr; // Corruption detected
                 }
 
-                // Update free list
-                free_list_ = header->next_free;
-
-                // Mark as allocated
-                header->magic = BLOCK_MAGIC;
-
                 // Update statistics
-                uint32_t used = ++used_blocks_;
-                if (used > peak_blocks_)
-                {
-                    peak_blocks_ = used;
-                }
-                ++alloc_count_;
+                note_used(used_blocks_.fetch_add(1, std::memory_order_relaxed) + 1);
+                alloc_count_.fetch_add(1, std::memory_order_relaxed);
 
                 // Return user pointer (after header)
-                return memory_base_ + (block_index * block_size_) + sizeof(BlockHeader);
+                return block_pointer(block_index);
             }
 
             // Free a block
             void deallocate(void *ptr)
             {
-                if (!ptr)
+                const uint32_t block_index = block_index_of(ptr);
+                if (block_index >= block_count_ || !mark_free(block_index))
                 {
-                    return;
+                    return; // Invalid pointer, double free or corruption
                 }
 
-                // Calculate block index
-                uintptr_t offset = static_cast<uint8_t *>(ptr) - memory_base_ - sizeof(BlockHeader);
-                if (offset % block_size_ != 0 || offset >= pool_size_)
-                {
-                    return; // Invalid pointer
-                }
-
-                uint32_t block_index = offset / block_size_;
-                BlockHeader *header = get_block_header(block_index);
-
-                // Validate magic
-                if (header->magic != BLOCK_MAGIC)
-                {
-                    return; // Double free or corruption
-                }
+                // Uncount the block before it can be reallocated, so the
+                // used count and peak never exceed block_count_
+                used_blocks_.fetch_sub(1, std::memory_order_relaxed);
+                free_count_.fetch_add(1, std::memory_order_relaxed);
 
-                // Mark as free
-                header->magic = FREE_BLOCK_MAGIC;
-                header->next_free = free_list_;
-                free_list_ = block_index;
-
-                // Update statistics
-                --used_blocks_;
-                ++free_count_;
+                push_chain(block_index, block_index);
             }
 
-            // Get pool statistics
+            // Get pool statistics; blocks parked in a Cache count as used
             PoolStats get_stats() const
             {
+                const uint32_t used = used_blocks_.load(std::memory_order_relaxed);
                 return PoolStats{
-                    .total_size = pool_size_,
-                    .used_size = used_blocks_ * block_size_,
-                    .free_size = (block_count_ - used_blocks_) * block_size_,
-                    .block_size = block_size_,
-                    .total_blocks = block_count_,
-                    .used_blocks = used_blocks_.load(),
-                    .free_blocks = block_count_ - used_blocks_,
-                    .peak_used_blocks = peak_blocks_,
-                    .allocation_count = alloc_count_.load(),
-                    .deallocation_count = free_count_.load()};
+                    pool_size_,
+                    used * block_size_,
+                    (block_count_ - used) * block_size_,
+                    block_size_,
+                    block_count_,
+                    used,
+                    block_count_ - used,
+                    peak_blocks_.load(std::memory_order_relaxed),
+                    alloc_count_.load(std::memory_order_relaxed),
+                    free_count_.load(std::memory_order_relaxed),
+                    0,
+                    NUMA_NODE_ANY,
+                    {}};
             }
 
-            // Validate pool integrity
+            // Validate pool integrity (only meaningful while no thread is
+            // allocating or freeing)
             bool validate() const
             {
                 uint32_t free_count = 0;
-                uint32_t current = free_list_;
+                uint32_t current = static_cast<uint32_t>(free_list_.load(std::memory_order_acquire));
 
                 // Walk free list
                 while (current < block_count_ && free_count < block_count_)
                 {
                     BlockHeader *header = get_block_header(current);
-                    if (header->magic != FREE_BLOCK_MAGIC)
+                    if (header->magic.load(std::memory_order_relaxed) != FREE_BLOCK_MAGIC)
                     {
                         return false;
                     }
-                    current = header->next_free;
+                    current = header->next_free.load(std::memory_order_relaxed);
                     ++free_count;
                 }
 
-                return free_count + used_blocks_ == block_count_;
+                return free_count + used_blocks_.load(std::memory_order_relaxed) == block_count_;
             }
 
         private:
@@ -354,6 +394,216 @@ namespace flight
             {
                 return reinterpret_cast<BlockHeader *>(memory_base_ + (index * block_size_));
             }
+
+            void *block_pointer(uint32_t index) const
+            {
+                return memory_base_ + (index * block_size_) + sizeof(BlockHeader);
+            }
+
+            // block_count_ for pointers outside the pool or off a block start
+            uint32_t block_index_of(void *ptr) const
+            {
+                if (!ptr)
+                {
+                    return block_count_;
+                }
+                uintptr_t offset = static_cast<uint8_t *>(ptr) - memory_base_ - sizeof(BlockHeader);
+                if (offset % block_size_ != 0 || offset >= pool_size_)
+                {
+                    return block_count_;
+                }
+                return static_cast<uint32_t>(offset / block_size_);
+            }
+
+            static uint64_t pack_head(uint32_t index, uint64_t previous)
+            {
+                return (((previous >> 32) + 1) << 32) | index;
+            }
+
+            uint32_t pop_block()
+            {
+                uint64_t head = free_list_.load(std::memory_order_acquire);
+                for (;;)
+                {
+                    const uint32_t index = static_cast<uint32_t>(head);
+                    if (index >= block_count_)
+                    {
+                        return block_count_;
+                    }
+                    // May read a block that was just handed out; the tag
+                    // makes the exchange below fail in that case
+                    const uint32_t next = get_block_header(index)->next_free.load(std::memory_order_relaxed);
+                    if (free_list_.compare_exchange_weak(head, pack_head(next, head),
+                                                         std::memory_order_acquire, std::memory_order_acquire))
+                    {
+                        return index;
+                    }
+                }
+            }
+
+            // Pushes blocks first..last, already linked through next_free
+            void push_chain(uint32_t first, uint32_t last)
+            {
+                BlockHeader *tail = get_block_header(last);
+                uint64_t head = free_list_.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    tail->next_free.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+                    if (free_list_.compare_exchange_weak(head, pack_head(first, head),
+                                                         std::memory_order_release, std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+                }
+            }
+
+            bool mark_allocated(uint32_t index)
+            {
+#if FLIGHT_HAL_POOL_CHECKS
+                return get_block_header(index)->magic.exchange(BLOCK_MAGIC, std::memory_order_relaxed) ==
+                       FREE_BLOCK_MAGIC;
+#else
+                (void)index;
+                return true;
+#endif
+            }
+
+            bool mark_free(uint32_t index)
+            {
+#if FLIGHT_HAL_POOL_CHECKS
+                // Exchange so two racing frees of one block cannot both pass
+                return get_block_header(index)->magic.exchange(FREE_BLOCK_MAGIC, std::memory_order_relaxed) ==
+                       BLOCK_MAGIC;
+#else
+                (void)index;
+                return true;
+#endif
+            }
+
+            void note_used(uint32_t used)
+            {
+                uint32_t peak = peak_blocks_.load(std::memory_order_relaxed);
+                while (used > peak &&
+                       !peak_blocks_.compare_exchange_weak(peak, used, std::memory_order_relaxed))
+                {
+                }
+            }
+        };
+
+        // Per-thread block cache in front of a PoolAllocator
+        //
+        // Owned by one thread. Allocation and deallocation hit a local array;
+        // it refills BATCH blocks at a time from the shared free list and
+        // returns BATCH blocks at once with a single compare-exchange when
+        // full. Statistics are published per batch. Cached blocks go back to
+        // the pool when the cache is flushed or destroyed.
+        class PoolAllocator::Cache
+        {
+        public:
+            static constexpr uint32_t CAPACITY = 64;
+            static constexpr uint32_t BATCH = CAPACITY / 2;
+
+            explicit Cache(PoolAllocator &pool) : pool_(pool) {}
+            ~Cache() { flush(); }
+
+            Cache(const Cache &) = delete;
+            Cache &operator=(const Cache &) = delete;
+
+            void *allocate()
+            {
+                if (count_ == 0 && !refill())
+                {
+                    return nullptr; // Out of memory
+                }
+                const uint32_t block_index = blocks_[--count_];
+                if (!pool_.mark_allocated(block_index))
+                {
+                    return nullptr; // Corruption detected
+                }
+                ++allocations_;
+                return pool_.block_pointer(block_index);
+            }
+
+            void deallocate(void *ptr)
+            {
+                const uint32_t block_index = pool_.block_index_of(ptr);
+                if (block_index >= pool_.block_count_ || !pool_.mark_free(block_index))
+                {
+                    return; // Invalid pointer, double free or corruption
+                }
+                if (count_ == CAPACITY)
+                {
+                    release(BATCH);
+                }
+                blocks_[count_++] = block_index;
+                ++deallocations_;
+            }
+
+            // Return every cached block to the pool
+            void flush()
+            {
+                release(count_);
+                publish();
+            }
+
+        private:
+            bool refill()
+            {
+                while (count_ < BATCH)
+                {
+                    const uint32_t block_index = pool_.pop_block();
+                    if (block_index >= pool_.block_count_)
+                    {
+                        break;
+                    }
+                    blocks_[count_++] = block_index;
+                }
+                if (count_ == 0)
+                {
+                    return false;
+                }
+                pool_.note_used(pool_.used_blocks_.fetch_add(count_, std::memory_order_relaxed) + count_);
+                publish();
+                return true;
+            }
+
+            // Hands the oldest `count` cached blocks back as one chain
+            void release(uint32_t count)
+            {
+                if (count == 0)
+                {
+                    return;
+                }
+                for (uint32_t i = 0; i + 1 < count; ++i)
+                {
+                    pool_.get_block_header(blocks_[i])->next_free.store(blocks_[i + 1], std::memory_order_relaxed);
+                }
+                pool_.used_blocks_.fetch_sub(count, std::memory_order_relaxed);
+                pool_.push_chain(blocks_[0], blocks_[count - 1]);
+                std::memmove(blocks_, blocks_ + count, (count_ - count) * sizeof(uint32_t));
+                count_ -= count;
+                publish();
+            }
+
+            void publish()
+            {
+                if (allocations_)
+                {
+                    pool_.alloc_count_.fetch_add(allocations_, std::memory_order_relaxed);
+                    allocations_ = 0;
+                }
+                if (deallocations_)
+                {
+                    pool_.free_count_.fetch_add(deallocations_, std::memory_order_relaxed);
+                    deallocations_ = 0;
+                }
+            }
+
+            PoolAllocator &pool_;
+            uint32_t blocks_[CAPACITY];
+            uint32_t count_ = 0;
+            uint64_t allocations_ = 0;
+            uint64_t deallocations_ = 0;
         };
 
     } // namespace hal
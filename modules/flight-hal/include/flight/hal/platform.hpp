@@ -6,6 +6,10 @@
 #define FLIGHT_PLATFORM_MACOS 1
 #define FLIGHT_PLATFORM_NAME "macOS"
 #define FLIGHT_PLATFORM_POSIX 1
+#elif defined(__linux__) && !defined(__EMSCRIPTEN__)
+#define FLIGHT_PLATFORM_LINUX 1
+#define FLIGHT_PLATFORM_NAME "Linux"
+#define FLIGHT_PLATFORM_POSIX 1
 #elif defined(__EMSCRIPTEN__)
 #define FLIGHT_PLATFORM_EMSCRIPTEN 1
 #define FLIGHT_PLATFORM_NAME "Emscripten"
@@ -30,6 +34,17 @@
 #define FLIGHT_HAS_FILESYSTEM 1
 #define FLIGHT_HAS_DYNAMIC_ALLOC 1
 #define FLIGHT_ARCH "x86_64"
+#elif defined(FLIGHT_PLATFORM_LINUX)
+#define FLIGHT_HAS_THREADS 1
+#define FLIGHT_HAS_MMAP 1
+#define FLIGHT_HAS_SIMD 1
+#define FLIGHT_HAS_FILESYSTEM 1
+#define FLIGHT_HAS_DYNAMIC_ALLOC 1
+#if defined(__aarch64__)
+#define FLIGHT_ARCH "aarch64"
+#else
+#define FLIGHT_ARCH "x86_64"
+#endif
 #elif defined(FLIGHT_PLATFORM_EMSCRIPTEN)
 #define FLIGHT_HAS_THREADS 0 // Web Workers are not real threads
 #define FLIGHT_HAS_MMAP 0
@@ -103,6 +118,7 @@ namespace flight
         enum class PlatformType
         {
             macOS,
+            Linux,
             Emscripten,
             Dreamcast,
             PSP,
@@ -114,6 +130,8 @@ namespace flight
         {
 #if defined(FLIGHT_PLATFORM_MACOS)
             return PlatformType::macOS;
+#elif defined(FLIGHT_PLATFORM_LINUX)
+            return PlatformType::Linux;
 #elif defined(FLIGHT_PLATFORM_EMSCRIPTEN)
             return PlatformType::Emscripten;
 #elif defined(FLIGHT_PLATFORM_DREAMCAST)
@@ -0,0 +1,394 @@
+#include <flight/hal/memory_backing.hpp>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Kernel constants from <linux/mempolicy.h>; libnuma is not required
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
+namespace flight
+{
+    namespace hal
+    {
+        namespace memory_backing
+        {
+            namespace
+            {
+                constexpr size_t FALLBACK_HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+                size_t base_page_size()
+                {
+                    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                    return size;
+                }
+
+                // Page size of transparent huge pages (PMD-mapped)
+                size_t transparent_page_size()
+                {
+                    static const size_t size = []
+                    {
+                        size_t value = 0;
+                        if (FILE *file = std::fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r"))
+                        {
+                            if (std::fscanf(file, "%zu", &value) != 1)
+                            {
+                                value = 0;
+                            }
+                            std::fclose(file);
+                        }
+                        return value ? value : FALLBACK_HUGE_PAGE_SIZE;
+                    }();
+                    return size;
+                }
+
+                // Default hugetlbfs page size, used by MAP_HUGETLB
+                size_t explicit_page_size()
+                {
+                    static const size_t size = []
+                    {
+                        size_t value = 0;
+                        if (FILE *file = std::fopen("/proc/meminfo", "r"))
+                        {
+                            char line[128];
+                            while (std::fgets(line, sizeof(line), file))
+                            {
+                                size_t kib = 0;
+                                if (std::sscanf(line, "Hugepagesize: %zu kB", &kib) == 1)
+                                {
+                                    value = kib * 1024;
+                                    break;
+                                }
+                            }
+                            std::fclose(file);
+                        }
+                        return value ? value : FALLBACK_HUGE_PAGE_SIZE;
+                    }();
+                    return size;
+                }
+
+                size_t round_up(size_t value, size_t alignment)
+                {
+                    return (value + alignment - 1) / alignment * alignment;
+                }
+
+                void *map_anonymous(size_t size, int extra_flags)
+                {
+                    void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                                        MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+                    return memory == MAP_FAILED ? nullptr : memory;
+                }
+
+                bool map_explicit(size_t size, BackedMemory &out)
+                {
+                    const size_t page = explicit_page_size();
+                    const size_t length = round_up(size, page);
+                    void *memory = map_anonymous(length, MAP_HUGETLB);
+                    if (!memory)
+                    {
+                        return false; // No reserved huge pages left
+                    }
+                    out = BackedMemory{memory, length, page, HugePageMode::Explicit, NUMA_NODE_ANY};
+                    return true;
+                }
+
+                // THP only promotes huge-page-aligned ranges, so over-reserve
+                // and trim the mapping down to an aligned window
+                bool map_transparent(size_t size, BackedMemory &out)
+                {
+                    const size_t page = transparent_page_size();
+                    const size_t length = round_up(size, page);
+                    uint8_t *reserved = static_cast<uint8_t *>(map_anonymous(length + page, MAP_NORESERVE));
+                    if (!reserved)
+                    {
+                        return false;
+                    }
+                    uint8_t *aligned = reinterpret_cast<uint8_t *>(round_up(reinterpret_cast<uintptr_t>(reserved), page));
+                    const size_t head = static_cast<size_t>(aligned - reserved);
+                    if (head)
+                    {
+                        munmap(reserved, head);
+                    }
+                    if (page - head)
+                    {
+                        munmap(aligned + length, page - head);
+                    }
+
+                    if (madvise(aligned, length, MADV_HUGEPAGE) != 0)
+                    {
+                        // THP disabled: keep the mapping with base pages
+                        out = BackedMemory{aligned, length, base_page_size(), HugePageMode::None, NUMA_NODE_ANY};
+                        return true;
+                    }
+                    out = BackedMemory{aligned, length, page, HugePageMode::Transparent, NUMA_NODE_ANY};
+                    return true;
+                }
+
+                // MPOL_BIND fails allocations once the node is full, which
+                // for a prefaulted pool means SIGBUS or the OOM killer
+                bool bind_to_node(const BackedMemory &memory, int32_t node, bool strict)
+                {
+                    if (node < 0 || node >= 64)
+                    {
+                        return false;
+                    }
+                    const unsigned long mask = 1UL << node;
+                    return syscall(SYS_mbind, memory.base, memory.size, strict ? MPOL_BIND : MPOL_PREFERRED, &mask,
+                                   sizeof(mask) * 8, 0) == 0;
+                }
+
+                void prefault(const BackedMemory &memory)
+                {
+                    if (madvise(memory.base, memory.size, MADV_POPULATE_WRITE) == 0)
+                    {
+                        return;
+                    }
+                    // Kernels before 5.14: fault each page in by hand
+                    volatile uint8_t *bytes = static_cast<uint8_t *>(memory.base);
+                    const size_t step = memory.huge_pages == HugePageMode::Explicit ? memory.page_size : base_page_size();
+                    for (size_t offset = 0; offset < memory.size; offset += step)
+                    {
+                        bytes[offset] = 0;
+                    }
+                }
+
+                // Fallback for kernels without NUMA: every resident page is on one node
+                void query_resident(const BackedMemory &memory, size_t *node_resident)
+                {
+                    const size_t page = base_page_size();
+                    std::vector<unsigned char> residency(memory.size / page);
+                    if (mincore(memory.base, memory.size, residency.data()) != 0)
+                    {
+                        return;
+                    }
+                    size_t resident = 0;
+                    for (unsigned char flags : residency)
+                    {
+                        resident += (flags & 1) ? page : 0;
+                    }
+                    const int32_t node = memory.numa_node >= 0 ? memory.numa_node : 0;
+                    if (static_cast<uint32_t>(node) < MAX_NUMA_NODES)
+                    {
+                        node_resident[node] = resident;
+                    }
+                }
+            } // namespace
+
+            BackedMemory map(size_t size, const MemoryBacking &backing)
+            {
+                BackedMemory memory;
+                if (size == 0)
+                {
+                    return memory;
+                }
+
+                const bool huge = backing.huge_pages != HugePageMode::None && size >= backing.huge_page_threshold;
+                bool mapped = huge && backing.huge_pages == HugePageMode::Explicit && map_explicit(size, memory);
+                mapped = mapped || (huge && map_transparent(size, memory));
+                if (!mapped)
+                {
+                    const size_t length = round_up(size, base_page_size());
+                    void *base = map_anonymous(length, MAP_NORESERVE);
+                    if (!base)
+                    {
+                        return memory;
+                    }
+                    memory = BackedMemory{base, length, base_page_size(), HugePageMode::None, NUMA_NODE_ANY};
+                }
+
+                // Binding before the first touch decides where every page lands
+                const int32_t node = backing.numa_node == NUMA_NODE_LOCAL ? current_node() : backing.numa_node;
+                if (node >= 0 && node_count() > 1 && bind_to_node(memory, node, backing.numa_strict))
+                {
+                    memory.numa_node = node;
+                }
+                if (backing.prefault)
+                {
+                    prefault(memory);
+                }
+                return memory;
+            }
+
+            void unmap(BackedMemory &memory)
+            {
+                if (memory.base)
+                {
+                    munmap(memory.base, memory.size);
+                }
+                memory = BackedMemory{};
+            }
+
+            int32_t current_node()
+            {
+                unsigned cpu = 0;
+                unsigned node = 0;
+                if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+                {
+                    return 0;
+                }
+                return static_cast<int32_t>(node);
+            }
+
+            uint32_t node_count()
+            {
+                static const uint32_t count = []
+                {
+                    // A list of ranges such as "0-1" or "0,2-3"
+                    uint32_t nodes = 0;
+                    if (FILE *file = std::fopen("/sys/devices/system/node/has_memory", "r"))
+                    {
+                        unsigned first = 0;
+                        unsigned last = 0;
+                        int separator = 0;
+                        while (std::fscanf(file, "%u", &first) == 1)
+                        {
+                            last = first;
+                            separator = std::fgetc(file);
+                            if (separator == '-' && std::fscanf(file, "%u", &last) == 1)
+                            {
+                                separator = std::fgetc(file);
+                            }
+                            nodes += last >= first ? last - first + 1 : 0;
+                            if (separator != ',')
+                            {
+                                break;
+                            }
+                        }
+                        std::fclose(file);
+                    }
+                    return nodes ? nodes : 1u;
+                }();
+                return count;
+            }
+
+            void query_stats(const BackedMemory &memory, PoolStats &stats, size_t max_samples)
+            {
+                stats.page_size = memory.page_size;
+                stats.numa_node = memory.numa_node;
+                std::memset(stats.node_resident, 0, sizeof(stats.node_resident));
+                if (!memory.base || max_samples == 0)
+                {
+                    return;
+                }
+
+                const size_t unit = memory.huge_pages == HugePageMode::Explicit ? memory.page_size : base_page_size();
+                const size_t pages = memory.size / unit;
+                const size_t stride = (pages + max_samples - 1) / max_samples;
+                std::vector<void *> addresses;
+                addresses.reserve(pages / stride + 1);
+                for (size_t page = 0; page < pages; page += stride)
+                {
+                    addresses.push_back(static_cast<uint8_t *>(memory.base) + page * unit);
+                }
+
+                // With a null node list move_pages only reports where each page lives
+                std::vector<int> status(addresses.size());
+                if (syscall(SYS_move_pages, 0, addresses.size(), addresses.data(), nullptr, status.data(), 0) != 0)
+                {
+                    query_resident(memory, stats.node_resident);
+                    return;
+                }
+                for (int node : status)
+                {
+                    // Negative status: not yet faulted in
+                    if (node >= 0 && static_cast<uint32_t>(node) < MAX_NUMA_NODES)
+                    {
+                        stats.node_resident[node] += stride * unit;
+                    }
+                }
+                for (size_t &resident : stats.node_resident)
+                {
+                    resident = std::min(resident, memory.size);
+                }
+            }
+
+        } // namespace memory_backing
+
+        // =====================================================================
+        // BackedPools
+        // =====================================================================
+
+        bool BackedPools::initialize(const MemoryConfig &config)
+        {
+            release();
+            const MemoryConfig::PoolConfig *configs[POOL_COUNT] = {&config.small_pool, &config.medium_pool,
+                                                                  &config.large_pool, &config.canonical_pool};
+            for (size_t i = 0; i < POOL_COUNT; ++i)
+            {
+                memory_[i] = memory_backing::map(configs[i]->size, config.backing);
+                if (!memory_[i] || !pools_[i].initialize(memory_[i].base, configs[i]->size, configs[i]->block_size))
+                {
+                    release();
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void BackedPools::release()
+        {
+            // Pools over unmapped memory are unreachable until initialized again
+            for (BackedMemory &memory : memory_)
+            {
+                memory_backing::unmap(memory);
+            }
+        }
+
+        PoolAllocator *BackedPools::pool(PoolType type)
+        {
+            const size_t slot = slot_of(type);
+            return slot < POOL_COUNT && memory_[slot] ? &pools_[slot] : nullptr;
+        }
+
+        const BackedMemory *BackedPools::memory(PoolType type) const
+        {
+            const size_t slot = slot_of(type);
+            return slot < POOL_COUNT && memory_[slot] ? &memory_[slot] : nullptr;
+        }
+
+        PoolStats BackedPools::get_pool_stats(PoolType type) const
+        {
+            const size_t slot = slot_of(type);
+            if (slot == POOL_COUNT || !memory_[slot])
+            {
+                PoolStats stats{};
+                stats.numa_node = NUMA_NODE_ANY;
+                return stats;
+            }
+            PoolStats stats = pools_[slot].get_stats();
+            memory_backing::query_stats(memory_[slot], stats);
+            return stats;
+        }
+
+        size_t BackedPools::slot_of(PoolType type)
+        {
+            switch (type)
+            {
+            case PoolType::SmallObjects:
+                return 0;
+            case PoolType::MediumObjects:
+                return 1;
+            case PoolType::LargeObjects:
+                return 2;
+            case PoolType::CanonicalMemory:
+                return 3;
+            default:
+                return POOL_COUNT;
+            }
+        }
+
+    } // namespace hal
+} // namespace flight
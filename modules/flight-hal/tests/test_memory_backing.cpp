@@ -0,0 +1,133 @@
+// Flight Core HAL - memory backing tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/hal/memory_backing.hpp>
+
+#if defined(FLIGHT_PLATFORM_LINUX)
+
+#include <cstdint>
+#include <cstring>
+
+using namespace flight::hal;
+
+namespace
+{
+    // Small pools so the tests map a few MiB at most
+    MemoryConfig small_config(const MemoryBacking &backing)
+    {
+        MemoryConfig config{};
+        config.small_pool = {64 * 1024, 64, 1024};
+        config.medium_pool = {256 * 1024, 512, 512};
+        config.large_pool = {1024 * 1024, 4096, 256};
+        config.canonical_pool = {128 * 1024, 256, 512};
+        config.backing = backing;
+        return config;
+    }
+} // namespace
+
+// =============================================================================
+// memory_backing
+// =============================================================================
+
+TEST_CASE("Base page mappings are page aligned and writable", "[hal][backing]")
+{
+    BackedMemory memory = memory_backing::map(10000, MemoryBacking{});
+    REQUIRE(memory);
+    REQUIRE(memory.huge_pages == HugePageMode::None);
+    REQUIRE(memory.size >= 10000);
+    REQUIRE(memory.size % memory.page_size == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(memory.base) % memory.page_size == 0);
+
+    std::memset(memory.base, 0xAB, memory.size);
+    memory_backing::unmap(memory);
+    REQUIRE_FALSE(memory);
+}
+
+TEST_CASE("Huge pages fall back and respect the threshold", "[hal][backing]")
+{
+    MemoryBacking backing;
+    backing.huge_pages = HugePageMode::Explicit;
+    backing.huge_page_threshold = 8 * 1024 * 1024;
+
+    SECTION("Mappings below the threshold use base pages")
+    {
+        BackedMemory memory = memory_backing::map(64 * 1024, backing);
+        REQUIRE(memory);
+        REQUIRE(memory.huge_pages == HugePageMode::None);
+        memory_backing::unmap(memory);
+    }
+
+    SECTION("Mappings above it always succeed, whatever the kernel offers")
+    {
+        BackedMemory memory = memory_backing::map(8 * 1024 * 1024, backing);
+        REQUIRE(memory);
+        REQUIRE(memory.size % memory.page_size == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(memory.base) % memory.page_size == 0);
+        memory_backing::unmap(memory);
+    }
+}
+
+TEST_CASE("query_stats reports prefaulted pages as resident", "[hal][backing]")
+{
+    MemoryBacking backing;
+    backing.numa_node = NUMA_NODE_LOCAL;
+    backing.prefault = true;
+    BackedMemory memory = memory_backing::map(1024 * 1024, backing);
+    REQUIRE(memory);
+
+    PoolStats stats{};
+    memory_backing::query_stats(memory, stats);
+    REQUIRE(stats.page_size == memory.page_size);
+    REQUIRE(stats.numa_node == memory.numa_node);
+    size_t resident = 0;
+    for (size_t bytes : stats.node_resident)
+    {
+        resident += bytes;
+    }
+    REQUIRE(resident == memory.size);
+    memory_backing::unmap(memory);
+}
+
+// =============================================================================
+// BackedPools
+// =============================================================================
+
+TEST_CASE("BackedPools maps each configured pool", "[hal][backing][pool]")
+{
+    BackedPools pools;
+    REQUIRE(pools.initialize(small_config(MemoryBacking{})));
+
+    PoolAllocator *small = pools.pool(PoolType::SmallObjects);
+    REQUIRE(small != nullptr);
+    REQUIRE(pools.pool(PoolType::AssetMemory) == nullptr);
+
+    void *block = small->allocate();
+    REQUIRE(block != nullptr);
+    REQUIRE(pools.memory(PoolType::SmallObjects)->base <= block);
+
+    const PoolStats stats = pools.get_pool_stats(PoolType::SmallObjects);
+    REQUIRE(stats.used_blocks == 1);
+    REQUIRE(stats.total_blocks == 1024);
+    REQUIRE(stats.page_size == pools.memory(PoolType::SmallObjects)->page_size);
+    REQUIRE(stats.node_resident[stats.numa_node >= 0 ? stats.numa_node : 0] > 0);
+    small->deallocate(block);
+
+    const PoolStats none = pools.get_pool_stats(PoolType::AssetMemory);
+    REQUIRE(none.total_size == 0);
+    REQUIRE(none.numa_node == NUMA_NODE_ANY);
+
+    pools.release();
+    REQUIRE(pools.pool(PoolType::SmallObjects) == nullptr);
+}
+
+TEST_CASE("BackedPools rejects pools that cannot hold a block", "[hal][backing][pool]")
+{
+    MemoryConfig config = small_config(MemoryBacking{});
+    config.large_pool = {1024, 4096, 1};
+
+    BackedPools pools;
+    REQUIRE_FALSE(pools.initialize(config));
+    REQUIRE(pools.pool(PoolType::SmallObjects) == nullptr);
+}
+
+#endif // FLIGHT_PLATFORM_LINUX
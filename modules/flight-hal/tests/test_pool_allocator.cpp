@@ -0,0 +1,198 @@
+// Flight Core HAL - pool allocator tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/hal/memory_manager.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace flight::hal;
+
+namespace
+{
+    constexpr size_t BLOCK_SIZE = 64;
+    constexpr uint32_t BLOCK_COUNT = 256;
+
+    struct Pool
+    {
+        alignas(64) uint8_t memory[BLOCK_SIZE * BLOCK_COUNT];
+        PoolAllocator allocator;
+
+        Pool() { REQUIRE(allocator.initialize(memory, sizeof(memory), BLOCK_SIZE)); }
+    };
+} // namespace
+
+// =============================================================================
+// Single thread
+// =============================================================================
+
+TEST_CASE("Pool hands out every block once", "[hal][pool]")
+{
+    Pool pool;
+    std::set<void *> blocks;
+    for (uint32_t i = 0; i < BLOCK_COUNT; ++i)
+    {
+        void *block = pool.allocator.allocate();
+        REQUIRE(block != nullptr);
+        REQUIRE(blocks.insert(block).second);
+    }
+    REQUIRE(pool.allocator.allocate() == nullptr);
+
+    PoolStats stats = pool.allocator.get_stats();
+    REQUIRE(stats.used_blocks == BLOCK_COUNT);
+    REQUIRE(stats.free_blocks == 0);
+    REQUIRE(stats.peak_used_blocks == BLOCK_COUNT);
+
+    for (void *block : blocks)
+    {
+        pool.allocator.deallocate(block);
+    }
+    stats = pool.allocator.get_stats();
+    REQUIRE(stats.used_blocks == 0);
+    REQUIRE(stats.allocation_count == BLOCK_COUNT);
+    REQUIRE(stats.deallocation_count == BLOCK_COUNT);
+    REQUIRE(pool.allocator.validate());
+}
+
+TEST_CASE("Pool rejects invalid configurations and pointers", "[hal][pool]")
+{
+    alignas(64) uint8_t memory[BLOCK_SIZE];
+    PoolAllocator allocator;
+    REQUIRE_FALSE(allocator.initialize(nullptr, sizeof(memory), BLOCK_SIZE));
+    REQUIRE_FALSE(allocator.initialize(memory, sizeof(memory), 2));
+    REQUIRE_FALSE(allocator.initialize(memory, BLOCK_SIZE / 2, BLOCK_SIZE));
+
+    Pool pool;
+    void *block = pool.allocator.allocate();
+    pool.allocator.deallocate(static_cast<uint8_t *>(block) + 1); // Not a block start
+    pool.allocator.deallocate(memory);                           // Outside the pool
+    pool.allocator.deallocate(nullptr);
+    REQUIRE(pool.allocator.get_stats().used_blocks == 1);
+    pool.allocator.deallocate(block);
+    REQUIRE(pool.allocator.validate());
+}
+
+#if FLIGHT_HAL_POOL_CHECKS
+TEST_CASE("Double frees are ignored", "[hal][pool]")
+{
+    Pool pool;
+    void *block = pool.allocator.allocate();
+    pool.allocator.deallocate(block);
+    pool.allocator.deallocate(block);
+    REQUIRE(pool.allocator.get_stats().used_blocks == 0);
+    REQUIRE(pool.allocator.get_stats().deallocation_count == 1);
+    REQUIRE(pool.allocator.validate());
+
+    // The block is on the free list once: two allocations get distinct blocks
+    void *first = pool.allocator.allocate();
+    void *second = pool.allocator.allocate();
+    REQUIRE(first != second);
+}
+
+TEST_CASE("Racing double frees release a block once", "[hal][pool]")
+{
+    Pool pool;
+    for (int round = 0; round < 500; ++round)
+    {
+        void *block = pool.allocator.allocate();
+        REQUIRE(block != nullptr);
+        std::atomic<bool> go{false};
+        auto free_block = [&] {
+            while (!go.load(std::memory_order_acquire))
+            {
+            }
+            pool.allocator.deallocate(block);
+        };
+        std::thread a(free_block);
+        std::thread b(free_block);
+        go.store(true, std::memory_order_release);
+        a.join();
+        b.join();
+        REQUIRE(pool.allocator.get_stats().used_blocks == 0);
+    }
+    REQUIRE(pool.allocator.validate());
+}
+#endif
+
+// =============================================================================
+// Concurrency
+// =============================================================================
+
+TEST_CASE("Concurrent allocation never shares a block", "[hal][pool]")
+{
+    Pool pool;
+    constexpr int THREADS = 4;
+    constexpr int ROUNDS = 2000;
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([&, t] {
+            const bool cached = t % 2 == 1;
+            PoolAllocator::Cache cache(pool.allocator);
+            std::vector<uint8_t *> held;
+            for (int round = 0; round < ROUNDS; ++round)
+            {
+                auto *block = static_cast<uint8_t *>(cached ? cache.allocate() : pool.allocator.allocate());
+                if (block)
+                {
+                    // Stamp the block and check nobody else writes it
+                    std::memset(block, t + 1, BLOCK_SIZE - 8);
+                    held.push_back(block);
+                }
+                if (held.size() > 16 || (!block && !held.empty()))
+                {
+                    uint8_t *victim = held.front();
+                    for (size_t i = 0; i < BLOCK_SIZE - 8; ++i)
+                    {
+                        if (victim[i] != t + 1)
+                        {
+                            failed = true;
+                        }
+                    }
+                    held.erase(held.begin());
+                    cached ? cache.deallocate(victim) : pool.allocator.deallocate(victim);
+                }
+            }
+            for (uint8_t *block : held)
+            {
+                cached ? cache.deallocate(block) : pool.allocator.deallocate(block);
+            }
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE_FALSE(failed);
+    const PoolStats stats = pool.allocator.get_stats();
+    REQUIRE(stats.used_blocks == 0);
+    REQUIRE(stats.peak_used_blocks <= BLOCK_COUNT);
+    REQUIRE(stats.allocation_count == stats.deallocation_count);
+    REQUIRE(pool.allocator.validate());
+}
+
+TEST_CASE("Caches return their blocks when flushed", "[hal][pool]")
+{
+    Pool pool;
+    {
+        PoolAllocator::Cache cache(pool.allocator);
+        void *block = cache.allocate();
+        REQUIRE(block != nullptr);
+        // A refill moves a batch out of the shared list
+        REQUIRE(pool.allocator.get_stats().used_blocks == PoolAllocator::Cache::BATCH);
+        cache.deallocate(block);
+        cache.flush();
+        REQUIRE(pool.allocator.get_stats().used_blocks == 0);
+        REQUIRE(pool.allocator.get_stats().allocation_count == 1);
+        REQUIRE(pool.allocator.get_stats().deallocation_count == 1);
+
+        REQUIRE(cache.allocate() != nullptr);
+    }
+    REQUIRE(pool.allocator.get_stats().used_blocks == 1);
+}
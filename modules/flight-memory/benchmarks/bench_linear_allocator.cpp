@@ -0,0 +1,87 @@
+// Flight Core Memory - Arena / LinearAllocator benchmarks
+//
+// Per-call temporaries (a few vectors and strings built then dropped)
+// served from an arena scope versus the system allocator.
+
+#include <benchmark/benchmark.h>
+#include <flight/memory/stl_allocator.hpp>
+
+#include <string>
+#include <vector>
+
+using flight::memory::Arena;
+using flight::memory::ArenaString;
+using flight::memory::ArenaVector;
+using flight::memory::StlAllocator;
+
+namespace
+{
+    constexpr size_t ELEMENTS = 64;
+    constexpr size_t STRINGS = 8;
+
+    template <typename Vector, typename String, typename MakeVector, typename MakeString>
+    size_t simulate_call(MakeVector make_vector, MakeString make_string)
+    {
+        Vector values = make_vector();
+        for (size_t i = 0; i < ELEMENTS; ++i)
+        {
+            values.push_back(static_cast<uint32_t>(i * 2654435761u));
+        }
+        size_t total = values.size();
+        for (size_t i = 0; i < STRINGS; ++i)
+        {
+            String text = make_string();
+            text.append("component-model-parameter-");
+            text.append(16, static_cast<char>('a' + i));
+            total += text.size();
+        }
+        return total;
+    }
+} // namespace
+
+static void BM_ArenaScopedCall(benchmark::State &state)
+{
+    Arena arena;
+    for (auto _ : state)
+    {
+        Arena::Scope scope(arena);
+        const size_t total = simulate_call<ArenaVector<uint32_t>, ArenaString>(
+            [&]
+            { return ArenaVector<uint32_t>(StlAllocator<uint32_t>(arena)); },
+            [&]
+            { return ArenaString(StlAllocator<char>(arena)); });
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ArenaScopedCall);
+
+static void BM_SystemCall(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        const size_t total = simulate_call<std::vector<uint32_t>, std::string>(
+            []
+            { return std::vector<uint32_t>(); },
+            []
+            { return std::string(); });
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_SystemCall);
+
+static void BM_ArenaBump(benchmark::State &state)
+{
+    Arena arena;
+    for (auto _ : state)
+    {
+        Arena::Scope scope(arena);
+        for (size_t i = 0; i < 256; ++i)
+        {
+            benchmark::DoNotOptimize(arena.allocate(16 + (i & 63), 8));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * 256));
+}
+BENCHMARK(BM_ArenaBump);
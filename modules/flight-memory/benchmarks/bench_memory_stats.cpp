@@ -0,0 +1,92 @@
+// Flight Core Memory - MemoryStats benchmarks
+//
+// Per-allocation accounting cost of the sharded statistics against a single
+// set of shared atomics, from 1 to 32 threads.
+
+#include <benchmark/benchmark.h>
+#include <flight/memory/memory.hpp>
+
+#include <atomic>
+
+using flight::memory::MemoryStats;
+
+namespace
+{
+    // The pre-sharding layout: every thread hits the same cache lines
+    struct SharedAtomicStats
+    {
+        std::atomic<size_t> total_allocated{0};
+        std::atomic<size_t> total_freed{0};
+        std::atomic<size_t> current_usage{0};
+        std::atomic<size_t> peak_usage{0};
+        std::atomic<size_t> allocation_count{0};
+        std::atomic<size_t> deallocation_count{0};
+
+        void record_allocation(size_t size)
+        {
+            total_allocated.fetch_add(size, std::memory_order_relaxed);
+            allocation_count.fetch_add(1, std::memory_order_relaxed);
+            const size_t usage = current_usage.fetch_add(size, std::memory_order_relaxed) + size;
+            size_t peak = peak_usage.load(std::memory_order_relaxed);
+            while (usage > peak && !peak_usage.compare_exchange_weak(peak, usage, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void record_deallocation(size_t size)
+        {
+            total_freed.fetch_add(size, std::memory_order_relaxed);
+            deallocation_count.fetch_add(1, std::memory_order_relaxed);
+            current_usage.fetch_sub(size, std::memory_order_relaxed);
+        }
+    };
+
+    constexpr size_t BATCH = 256;
+
+    template <typename Stats>
+    void run_record(benchmark::State &state, Stats &stats)
+    {
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < BATCH; ++i)
+            {
+                stats.record_allocation(64 + i);
+            }
+            for (size_t i = 0; i < BATCH; ++i)
+            {
+                stats.record_deallocation(64 + i);
+            }
+        }
+        // One item is an allocation and its deallocation
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH));
+    }
+} // namespace
+
+static void BM_ShardedStatsRecord(benchmark::State &state)
+{
+    static MemoryStats stats;
+    run_record(state, stats);
+    if (state.thread_index() == 0)
+    {
+        state.counters["peak"] = static_cast<double>(stats.peak_usage.load());
+    }
+}
+BENCHMARK(BM_ShardedStatsRecord)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_SharedAtomicStatsRecord(benchmark::State &state)
+{
+    static SharedAtomicStats stats;
+    run_record(state, stats);
+}
+BENCHMARK(BM_SharedAtomicStatsRecord)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_ShardedStatsRead(benchmark::State &state)
+{
+    static MemoryStats stats;
+    stats.record_allocation(128);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(stats.current_usage.load());
+    }
+}
+BENCHMARK(BM_ShardedStatsRead);
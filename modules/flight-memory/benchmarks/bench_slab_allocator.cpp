@@ -0,0 +1,118 @@
+// Flight Core Memory - SlabAllocator benchmarks
+//
+// Compares the slab allocator against the system allocator for same-thread
+// churn and for producer/consumer (cross-thread free) patterns.
+
+#include <benchmark/benchmark.h>
+#include <flight/memory/slab_allocator.hpp>
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using flight::memory::SlabAllocator;
+
+namespace
+{
+    SlabAllocator &shared_allocator()
+    {
+        static SlabAllocator allocator;
+        return allocator;
+    }
+
+    constexpr size_t BATCH = 256;
+
+    size_t request_size(size_t i)
+    {
+        // Mix of runtime-typical sizes: frames, metadata, small buffers
+        static constexpr size_t sizes[] = {16, 24, 48, 64, 96, 128, 256, 512};
+        return sizes[i % (sizeof(sizes) / sizeof(sizes[0]))];
+    }
+} // namespace
+
+static void BM_SlabChurn(benchmark::State &state)
+{
+    SlabAllocator &allocator = shared_allocator();
+    void *blocks[BATCH];
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < BATCH; ++i)
+        {
+            blocks[i] = allocator.allocate(request_size(i));
+        }
+        benchmark::DoNotOptimize(blocks);
+        for (size_t i = 0; i < BATCH; ++i)
+        {
+            allocator.deallocate(blocks[i], request_size(i));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH));
+}
+BENCHMARK(BM_SlabChurn)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_SystemChurn(benchmark::State &state)
+{
+    void *blocks[BATCH];
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < BATCH; ++i)
+        {
+            blocks[i] = std::malloc(request_size(i));
+        }
+        benchmark::DoNotOptimize(blocks);
+        for (size_t i = 0; i < BATCH; ++i)
+        {
+            std::free(blocks[i]);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH));
+}
+BENCHMARK(BM_SystemChurn)->ThreadRange(1, 32)->UseRealTime();
+
+// Blocks allocated on another thread and freed here take the lock-free
+// cross-thread return path
+template <typename Allocate, typename Deallocate>
+static void run_remote_free(benchmark::State &state, Allocate allocate, Deallocate deallocate)
+{
+    constexpr size_t COUNT = 4096;
+    std::vector<void *> blocks(COUNT);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::thread producer([&]
+                             {
+                                 for (size_t i = 0; i < COUNT; ++i)
+                                 {
+                                     blocks[i] = allocate(request_size(i));
+                                 } });
+        producer.join();
+        state.ResumeTiming();
+
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+            deallocate(blocks[i], request_size(i));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * COUNT));
+}
+
+static void BM_SlabRemoteFree(benchmark::State &state)
+{
+    SlabAllocator &allocator = shared_allocator();
+    run_remote_free(
+        state, [&](size_t size)
+        { return allocator.allocate(size); },
+        [&](void *ptr, size_t size)
+        { allocator.deallocate(ptr, size); });
+}
+BENCHMARK(BM_SlabRemoteFree);
+
+static void BM_SystemRemoteFree(benchmark::State &state)
+{
+    run_remote_free(
+        state, [](size_t size)
+        { return std::malloc(size); },
+        [](void *ptr, size_t)
+        { std::free(ptr); });
+}
+BENCHMARK(BM_SystemRemoteFree);
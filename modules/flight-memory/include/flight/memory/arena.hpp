@@ -0,0 +1,127 @@
+#ifndef FLIGHT_MEMORY_ARENA_HPP
+#define FLIGHT_MEMORY_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace flight
+{
+    namespace memory
+    {
+
+        // Region allocator over a chain of large blocks
+        //
+        // Allocation bumps a cursor through the current block and moves on to
+        // the next block of the chain when it is exhausted. Nothing is freed
+        // individually: mark() captures the cursor and rewind() restores it in
+        // O(1), keeping the blocks past the marker as spares for reuse. Marks
+        // nest, so a per-request scope can release every temporary it made
+        // without touching the system allocator.
+        //
+        // Requests larger than the block size get a dedicated block. Blocks
+        // are only returned to the system by release() and destruction.
+        class Arena
+        {
+            struct Block;
+
+        public:
+            static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+            // Position in the arena; only valid for the arena that made it and
+            // until the arena is rewound past it or released
+            struct Marker
+            {
+                Block *block = nullptr;
+                uintptr_t cursor = 0;
+                size_t used_before = 0;
+            };
+
+            // Rewinds the arena to its position at construction
+            class Scope
+            {
+            public:
+                explicit Scope(Arena &arena) : arena_(arena), marker_(arena.mark()) {}
+                ~Scope() { arena_.rewind(marker_); }
+
+                Scope(const Scope &) = delete;
+                Scope &operator=(const Scope &) = delete;
+
+            private:
+                Arena &arena_;
+                Marker marker_;
+            };
+
+            explicit Arena(size_t block_size = DEFAULT_BLOCK_SIZE);
+            ~Arena();
+
+            Arena(Arena &&other) noexcept;
+            Arena &operator=(Arena &&other) noexcept;
+            Arena(const Arena &) = delete;
+            Arena &operator=(const Arena &) = delete;
+
+            // Returns nullptr for alignments that are not a power of two and
+            // when the system is out of memory
+            void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+            // Arena memory is reclaimed by rewind()/reset() only
+            void deallocate(void *, size_t) {}
+
+            Marker mark() const { return Marker{current_, cursor_, used_before_}; }
+            void rewind(const Marker &marker);
+            // Rewind to the start, keeping all blocks
+            void reset() { rewind(Marker{}); }
+            // Return all blocks to the system
+            void release();
+
+            // Bytes consumed, including alignment padding and skipped block tails
+            size_t used() const;
+            // Bytes held in blocks
+            size_t capacity() const { return capacity_; }
+            size_t block_size() const { return block_size_; }
+
+        private:
+            struct Block
+            {
+                Block *next;
+                size_t capacity;
+
+                uintptr_t begin() { return reinterpret_cast<uintptr_t>(this + 1); }
+                uintptr_t end() { return begin() + capacity; }
+            };
+
+            void *allocate_slow(size_t size, size_t alignment);
+
+            Block *first_ = nullptr;
+            Block *current_ = nullptr; // nullptr before the first allocation after a reset
+            uintptr_t cursor_ = 0;
+            uintptr_t limit_ = 0;
+            size_t used_before_ = 0; // Bytes consumed in blocks before current_
+            size_t capacity_ = 0;
+            size_t block_size_;
+        };
+
+        inline void *Arena::allocate(size_t size, size_t alignment)
+        {
+            if (size == 0)
+            {
+                size = 1; // Distinct, non-null pointers
+            }
+            // Alignment 0 and overflowing alignments fail the range checks
+            const uintptr_t aligned = (cursor_ + alignment - 1) & ~(uintptr_t(alignment) - 1);
+            if ((alignment & (alignment - 1)) == 0 && aligned >= cursor_ && aligned <= limit_ &&
+                size <= limit_ - aligned)
+            {
+                cursor_ = aligned + size;
+                return reinterpret_cast<void *>(aligned);
+            }
+            return allocate_slow(size, alignment);
+        }
+
+        inline size_t Arena::used() const
+        {
+            return current_ ? used_before_ + (cursor_ - current_->begin()) : 0;
+        }
+
+    } // namespace memory
+} // namespace flight
+
+#endif // FLIGHT_MEMORY_ARENA_HPP
@@ -0,0 +1,45 @@
+#ifndef FLIGHT_MEMORY_LINEAR_ALLOCATOR_HPP
+#define FLIGHT_MEMORY_LINEAR_ALLOCATOR_HPP
+
+#include <flight/memory/arena.hpp>
+#include <flight/memory/memory.hpp>
+
+namespace flight
+{
+    namespace memory
+    {
+
+        // AllocationStrategy::Linear: an Arena behind the Allocator interface
+        //
+        // deallocate() is a no-op; memory comes back through reset() or by
+        // rewinding to a marker.
+        class LinearAllocator : public Allocator
+        {
+        public:
+            using Marker = Arena::Marker;
+
+            explicit LinearAllocator(size_t block_size = Arena::DEFAULT_BLOCK_SIZE) : arena_(block_size) {}
+
+            void *allocate(size_t size, size_t alignment = alignof(std::max_align_t)) override
+            {
+                return arena_.allocate(size, alignment);
+            }
+            void deallocate(void *, size_t) override {}
+            void reset() override { arena_.reset(); }
+
+            size_t get_used_memory() const override { return arena_.used(); }
+            size_t get_total_memory() const override { return arena_.capacity(); }
+
+            Marker mark() const { return arena_.mark(); }
+            void rewind(const Marker &marker) { arena_.rewind(marker); }
+
+            Arena &arena() { return arena_; }
+
+        private:
+            Arena arena_;
+        };
+
+    } // namespace memory
+} // namespace flight
+
+#endif // FLIGHT_MEMORY_LINEAR_ALLOCATOR_HPP
@@ -17,17 +17,149 @@ namespace flight
         class LinearAllocator;
         class StackAllocator;
 
+        namespace detail
+        {
+            // Shard index + 1 of the calling thread, 0 until claimed
+            inline thread_local size_t thread_stats_slot = 0;
+
+            // Claims a free shard index for the calling thread, or returns
+            // the overflow index when all are taken
+            size_t claim_stats_slot();
+
+            inline size_t current_stats_slot()
+            {
+                const size_t slot = thread_stats_slot;
+                return slot != 0 ? slot - 1 : claim_stats_slot();
+            }
+        } // namespace detail
+
         // Memory statistics
-        struct MemoryStats
+        //
+        // Counters are sharded per thread: each thread owns a cache-line-sized
+        // shard it updates with plain stores, and readers aggregate all shards,
+        // so recording an allocation never bounces a shared cache line. Threads
+        // beyond SHARD_COUNT share an overflow shard updated atomically until a
+        // shard is released by an exiting thread.
+        //
+        // peak_usage is a high-water mark: each shard merges its usage change
+        // into a shared total every PEAK_MERGE_BYTES, and every read folds in
+        // the exact current usage. It is within PEAK_MERGE_BYTES per active
+        // thread of the true peak.
+        class MemoryStats
         {
-            std::atomic<size_t> total_allocated{0};
-            std::atomic<size_t> total_freed{0};
-            std::atomic<size_t> current_usage{0};
-            std::atomic<size_t> peak_usage{0};
-            std::atomic<size_t> allocation_count{0};
-            std::atomic<size_t> deallocation_count{0};
+        public:
+            static constexpr size_t SHARD_COUNT = 32;
+            static constexpr size_t PEAK_MERGE_BYTES = 64 * 1024;
+
+            // Read-only view of one aggregated counter
+            class Counter
+            {
+            public:
+                // Shards are always read with acquire ordering
+                size_t load(std::memory_order = std::memory_order_seq_cst) const { return (stats_->*read_)(); }
+                operator size_t() const { return load(); }
+
+            private:
+                friend class MemoryStats;
+                using Reader = size_t (MemoryStats::*)() const;
+
+                Counter(const MemoryStats *stats, Reader read) : stats_(stats), read_(read) {}
+
+                const MemoryStats *stats_;
+                Reader read_;
+            };
+
+            MemoryStats() = default;
+            MemoryStats(const MemoryStats &) = delete;
+            MemoryStats &operator=(const MemoryStats &) = delete;
+
+            const Counter total_allocated{this, &MemoryStats::read_allocated};
+            const Counter total_freed{this, &MemoryStats::read_freed};
+            const Counter current_usage{this, &MemoryStats::read_current};
+            const Counter peak_usage{this, &MemoryStats::read_peak};
+            const Counter allocation_count{this, &MemoryStats::read_allocations};
+            const Counter deallocation_count{this, &MemoryStats::read_deallocations};
+
+            void record_allocation(size_t size);
+            void record_deallocation(size_t size);
+            // Counts size bytes as freed without individual deallocations
+            // (allocator reset)
+            void record_release(size_t size);
+
+        private:
+            struct alignas(64) Shard
+            {
+                std::atomic<size_t> allocated{0};
+                std::atomic<size_t> freed{0};
+                std::atomic<size_t> allocations{0};
+                std::atomic<size_t> deallocations{0};
+                std::ptrdiff_t unmerged_usage = 0; // Owner-only
+            };
+
+            static void bump(std::atomic<size_t> &counter, size_t amount)
+            {
+                // Single writer: no read-modify-write needed
+                counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_release);
+            }
+
+            void merge_usage(std::ptrdiff_t delta);
+            void raise_peak(size_t usage) const;
+
+            size_t read_allocated() const;
+            size_t read_freed() const;
+            size_t read_current() const;
+            size_t read_peak() const;
+            size_t read_allocations() const;
+            size_t read_deallocations() const;
+
+            Shard shards_[SHARD_COUNT];
+            Shard overflow_;
+            alignas(64) std::atomic<std::ptrdiff_t> merged_usage_{0};
+            mutable std::atomic<size_t> peak_{0};
         };
 
+        inline void MemoryStats::record_allocation(size_t size)
+        {
+            const size_t slot = detail::current_stats_slot();
+            if (slot < SHARD_COUNT)
+            {
+                Shard &shard = shards_[slot];
+                bump(shard.allocated, size);
+                bump(shard.allocations, 1);
+                shard.unmerged_usage += static_cast<std::ptrdiff_t>(size);
+                if (shard.unmerged_usage >= static_cast<std::ptrdiff_t>(PEAK_MERGE_BYTES))
+                {
+                    merge_usage(shard.unmerged_usage);
+                    shard.unmerged_usage = 0;
+                }
+                return;
+            }
+            overflow_.allocated.fetch_add(size, std::memory_order_release);
+            overflow_.allocations.fetch_add(1, std::memory_order_release);
+            merge_usage(static_cast<std::ptrdiff_t>(size));
+        }
+
+        inline void MemoryStats::record_deallocation(size_t size)
+        {
+            const size_t slot = detail::current_stats_slot();
+            if (slot < SHARD_COUNT)
+            {
+                Shard &shard = shards_[slot];
+                bump(shard.freed, size);
+                bump(shard.deallocations, 1);
+                shard.unmerged_usage -= static_cast<std::ptrdiff_t>(size);
+                if (shard.unmerged_usage <= -static_cast<std::ptrdiff_t>(PEAK_MERGE_BYTES))
+                {
+                    merge_usage(shard.unmerged_usage);
+                    shard.unmerged_usage = 0;
+                }
+                return;
+            }
+            overflow_.freed.fetch_add(size, std::memory_order_release);
+            overflow_.deallocations.fetch_add(1, std::memory_order_release);
+            merge_usage(-static_cast<std::ptrdiff_t>(size));
+        }
+
         // Base allocator interface
         class Allocator
         {
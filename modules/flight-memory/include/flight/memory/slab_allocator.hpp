@@ -0,0 +1,107 @@
+#ifndef FLIGHT_MEMORY_SLAB_ALLOCATOR_HPP
+#define FLIGHT_MEMORY_SLAB_ALLOCATOR_HPP
+
+#include <flight/memory/memory.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace flight
+{
+    namespace memory
+    {
+
+        class ThreadHeapRegistry;
+
+        // General-purpose size-class allocator
+        //
+        // Requests up to MAX_SMALL_SIZE are rounded to one of SIZE_CLASS_COUNT
+        // classes (16-byte steps up to 128, then four classes per power of two)
+        // and served from SLAB_SIZE slabs that each hold blocks of one class.
+        // Every thread owns a heap with a magazine of free blocks per class, so
+        // the common allocate/deallocate path touches no shared state. A block
+        // freed by a thread other than its slab's owner is pushed onto the
+        // owner heap's lock-free return list and reclaimed on the owner's next
+        // refill. The allocator mutex is only taken per slab (64 KiB), per
+        // thread start/exit and for large requests, which go to the system.
+        //
+        // reset() and destruction must not race with allocation.
+        class SlabAllocator : public Allocator
+        {
+        public:
+            static constexpr size_t SLAB_SIZE = 64 * 1024;
+            static constexpr size_t MAX_SMALL_SIZE = 32 * 1024;
+            static constexpr size_t SIZE_CLASS_COUNT = 40;
+            static constexpr size_t MAGAZINE_CAPACITY = 64;
+            static constexpr size_t MAX_ALIGNMENT = SLAB_SIZE;
+
+            SlabAllocator();
+            ~SlabAllocator() override;
+
+            SlabAllocator(const SlabAllocator &) = delete;
+            SlabAllocator &operator=(const SlabAllocator &) = delete;
+
+            // Returns nullptr for alignments that are not a power of two or
+            // exceed MAX_ALIGNMENT, and when the system is out of memory
+            void *allocate(size_t size, size_t alignment = alignof(std::max_align_t)) override;
+            void deallocate(void *ptr, size_t size) override;
+            void reset() override;
+
+            // Bytes currently handed out (requested sizes)
+            size_t get_used_memory() const override;
+            // Bytes reserved from the system (slabs and large blocks)
+            size_t get_total_memory() const override;
+
+            const MemoryStats &get_stats() const { return stats_; }
+
+            // Return pooled empty slabs to the system
+            void trim();
+
+            // Size class for a request of 1..MAX_SMALL_SIZE bytes
+            static size_t size_class_of(size_t size);
+            // Block size of a size class
+            static size_t class_size(size_t size_class);
+
+        private:
+            struct Slab;
+            struct Heap;
+            friend class ThreadHeapRegistry;
+
+            static Slab *slab_of(void *block);
+
+            Heap *local_heap();
+            Heap *find_local_heap() const;
+            Heap *acquire_heap();
+            void release_heap(Heap *heap);
+
+            void *refill(Heap *heap, size_t size_class);
+            void flush(Heap *heap, size_t size_class);
+            void return_block(Heap *heap, void *block);
+            void drain_remote(Heap *heap);
+
+            Slab *acquire_slab(Heap *heap, size_t size_class);
+            void release_slab(Slab *slab);
+
+            void *allocate_large(size_t size);
+            void deallocate_large(void *ptr, size_t size);
+
+            uint64_t id_;
+            MemoryStats stats_;
+            std::atomic<size_t> reserved_bytes_{0};
+
+            std::mutex mutex_; // Guards everything below
+            std::vector<Heap *> heaps_;
+            std::vector<Heap *> idle_heaps_; // Heaps of exited threads, adopted by new ones
+            std::vector<Slab *> empty_slabs_;
+            std::unordered_set<void *> slabs_;
+            std::unordered_set<void *> large_blocks_;
+        };
+
+    } // namespace memory
+} // namespace flight
+
+#endif // FLIGHT_MEMORY_SLAB_ALLOCATOR_HPP
@@ -0,0 +1,48 @@
+#ifndef FLIGHT_MEMORY_STACK_ALLOCATOR_HPP
+#define FLIGHT_MEMORY_STACK_ALLOCATOR_HPP
+
+#include <flight/memory/arena.hpp>
+#include <flight/memory/memory.hpp>
+
+#include <vector>
+
+namespace flight
+{
+    namespace memory
+    {
+
+        // AllocationStrategy::Stack: LIFO allocation on an Arena
+        //
+        // Freeing the most recent allocation rewinds the arena to where it
+        // was before that allocation. A block freed out of order is held
+        // until everything allocated after it has been freed too.
+        class StackAllocator : public Allocator
+        {
+        public:
+            explicit StackAllocator(size_t block_size = Arena::DEFAULT_BLOCK_SIZE) : arena_(block_size) {}
+
+            void *allocate(size_t size, size_t alignment = alignof(std::max_align_t)) override;
+            void deallocate(void *ptr, size_t size) override;
+            void reset() override;
+
+            size_t get_used_memory() const override { return arena_.used(); }
+            size_t get_total_memory() const override { return arena_.capacity(); }
+
+            // Live (not yet reclaimed) allocations
+            size_t depth() const { return frames_.size(); }
+
+        private:
+            struct Frame
+            {
+                Arena::Marker before;
+                void *ptr; // nullptr once freed out of order
+            };
+
+            Arena arena_;
+            std::vector<Frame> frames_;
+        };
+
+    } // namespace memory
+} // namespace flight
+
+#endif // FLIGHT_MEMORY_STACK_ALLOCATOR_HPP
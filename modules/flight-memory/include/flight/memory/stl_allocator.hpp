@@ -0,0 +1,84 @@
+#ifndef FLIGHT_MEMORY_STL_ALLOCATOR_HPP
+#define FLIGHT_MEMORY_STL_ALLOCATOR_HPP
+
+#include <flight/memory/arena.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace flight
+{
+    namespace memory
+    {
+
+        // Standard allocator adapter over any flight allocator
+        //
+        // Backing is anything with allocate(size, alignment) returning nullptr
+        // on failure and deallocate(ptr, size): an Arena (calls inline) or an
+        // Allocator (calls through the vtable). The adapter only holds a
+        // pointer; the backing allocator must outlive every container using it.
+        template <typename T, typename Backing = Arena>
+        class StlAllocator
+        {
+        public:
+            using value_type = T;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap = std::true_type;
+
+            explicit StlAllocator(Backing &backing) noexcept : backing_(&backing) {}
+
+            template <typename U>
+            StlAllocator(const StlAllocator<U, Backing> &other) noexcept : backing_(other.backing_) {}
+
+            T *allocate(size_t count)
+            {
+                if (count > std::numeric_limits<size_t>::max() / sizeof(T))
+                {
+                    throw std::bad_array_new_length();
+                }
+                void *ptr = backing_->allocate(count * sizeof(T), alignof(T));
+                if (!ptr)
+                {
+                    throw std::bad_alloc();
+                }
+                return static_cast<T *>(ptr);
+            }
+
+            void deallocate(T *ptr, size_t count) noexcept
+            {
+                backing_->deallocate(ptr, count * sizeof(T));
+            }
+
+            Backing *backing() const noexcept { return backing_; }
+
+            template <typename U>
+            bool operator==(const StlAllocator<U, Backing> &other) const noexcept
+            {
+                return backing_ == other.backing_;
+            }
+            template <typename U>
+            bool operator!=(const StlAllocator<U, Backing> &other) const noexcept
+            {
+                return backing_ != other.backing_;
+            }
+
+        private:
+            template <typename U, typename B>
+            friend class StlAllocator;
+
+            Backing *backing_;
+        };
+
+        // Containers for per-call temporaries
+        template <typename T>
+        using ArenaVector = std::vector<T, StlAllocator<T>>;
+        using ArenaString = std::basic_string<char, std::char_traits<char>, StlAllocator<char>>;
+
+    } // namespace memory
+} // namespace flight
+
+#endif // FLIGHT_MEMORY_STL_ALLOCATOR_HPP
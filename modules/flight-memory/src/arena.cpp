@@ -0,0 +1,142 @@
+#include <flight/memory/arena.hpp>
+
+#include <algorithm>
+#include <new>
+
+namespace flight
+{
+    namespace memory
+    {
+
+        Arena::Arena(size_t block_size)
+            : block_size_(std::max(block_size, size_t(1)))
+        {
+        }
+
+        Arena::~Arena()
+        {
+            release();
+        }
+
+        Arena::Arena(Arena &&other) noexcept
+            : first_(other.first_), current_(other.current_), cursor_(other.cursor_), limit_(other.limit_),
+              used_before_(other.used_before_), capacity_(other.capacity_), block_size_(other.block_size_)
+        {
+            other.first_ = nullptr;
+            other.current_ = nullptr;
+            other.cursor_ = 0;
+            other.limit_ = 0;
+            other.used_before_ = 0;
+            other.capacity_ = 0;
+        }
+
+        Arena &Arena::operator=(Arena &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                first_ = other.first_;
+                current_ = other.current_;
+                cursor_ = other.cursor_;
+                limit_ = other.limit_;
+                used_before_ = other.used_before_;
+                capacity_ = other.capacity_;
+                block_size_ = other.block_size_;
+                other.first_ = nullptr;
+                other.current_ = nullptr;
+                other.cursor_ = 0;
+                other.limit_ = 0;
+                other.used_before_ = 0;
+                other.capacity_ = 0;
+            }
+            return *this;
+        }
+
+        void *Arena::allocate_slow(size_t size, size_t alignment)
+        {
+            if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+            {
+                return nullptr;
+            }
+
+            // Block data starts max_align_t-aligned; stricter alignments may
+            // need padding in front of the allocation
+            const size_t padding = alignment > alignof(std::max_align_t) ? alignment - 1 : 0;
+            if (size > SIZE_MAX - sizeof(Block) - padding)
+            {
+                return nullptr;
+            }
+            const size_t needed = size + padding;
+
+            // Reuse the spare block left behind by a rewind when it fits,
+            // otherwise chain a new one in front of it
+            Block *next = current_ ? current_->next : first_;
+            Block *block = next;
+            if (!block || block->capacity < needed)
+            {
+                const size_t capacity = std::max(block_size_, needed);
+                void *memory = ::operator new(sizeof(Block) + capacity, std::nothrow);
+                if (!memory)
+                {
+                    return nullptr;
+                }
+                block = new (memory) Block{next, capacity};
+                if (current_)
+                {
+                    current_->next = block;
+                }
+                else
+                {
+                    first_ = block;
+                }
+                capacity_ += capacity;
+            }
+
+            if (current_)
+            {
+                used_before_ += current_->capacity;
+            }
+            current_ = block;
+            limit_ = block->end();
+
+            const uintptr_t aligned = (block->begin() + alignment - 1) & ~(uintptr_t(alignment) - 1);
+            cursor_ = aligned + size;
+            return reinterpret_cast<void *>(aligned);
+        }
+
+        void Arena::rewind(const Marker &marker)
+        {
+            current_ = marker.block;
+            if (current_)
+            {
+                cursor_ = marker.cursor;
+                limit_ = current_->end();
+                used_before_ = marker.used_before;
+            }
+            else
+            {
+                cursor_ = 0;
+                limit_ = 0;
+                used_before_ = 0;
+            }
+        }
+
+        void Arena::release()
+        {
+            Block *block = first_;
+            while (block)
+            {
+                Block *next = block->next;
+                ::operator delete(block);
+                block = next;
+            }
+            first_ = nullptr;
+            current_ = nullptr;
+            cursor_ = 0;
+            limit_ = 0;
+            used_before_ = 0;
+            capacity_ = 0;
+        }
+
+    } // namespace memory
+} // namespace flight
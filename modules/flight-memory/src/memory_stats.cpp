@@ -0,0 +1,148 @@
+#include <flight/memory/memory.hpp>
+
+#include <cstdint>
+
+namespace flight
+{
+    namespace memory
+    {
+
+        static_assert(MemoryStats::SHARD_COUNT <= 32, "shard ownership is tracked in a 32-bit mask");
+
+        namespace
+        {
+            // Bit i set while a live thread owns shard i of every MemoryStats
+            std::atomic<uint32_t> claimed_slots{0};
+
+            // Hands the calling thread's shard back when the thread exits
+            struct SlotRelease
+            {
+                size_t slot = MemoryStats::SHARD_COUNT;
+
+                ~SlotRelease()
+                {
+                    if (slot < MemoryStats::SHARD_COUNT)
+                    {
+                        // Anything recorded later during thread teardown goes
+                        // to the overflow shard
+                        detail::thread_stats_slot = MemoryStats::SHARD_COUNT + 1;
+                        claimed_slots.fetch_and(~(uint32_t(1) << slot), std::memory_order_release);
+                    }
+                }
+            };
+
+            thread_local SlotRelease slot_release;
+        } // namespace
+
+        namespace detail
+        {
+            size_t claim_stats_slot()
+            {
+                uint32_t claimed = claimed_slots.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    const uint32_t available = ~claimed & static_cast<uint32_t>((uint64_t(1) << MemoryStats::SHARD_COUNT) - 1);
+                    if (available == 0)
+                    {
+                        // Left unclaimed so a later call can pick up a released shard
+                        return MemoryStats::SHARD_COUNT;
+                    }
+                    const uint32_t bit = available & (~available + 1);
+                    // Acquire pairs with the release of the previous owner's
+                    // exit, making its plain shard stores visible to us
+                    if (claimed_slots.compare_exchange_weak(claimed, claimed | bit, std::memory_order_acquire,
+                                                            std::memory_order_relaxed))
+                    {
+                        size_t slot = 0;
+                        while ((uint32_t(1) << slot) != bit)
+                        {
+                            ++slot;
+                        }
+                        slot_release.slot = slot;
+                        thread_stats_slot = slot + 1;
+                        return slot;
+                    }
+                }
+            }
+        } // namespace detail
+
+        void MemoryStats::record_release(size_t size)
+        {
+            overflow_.freed.fetch_add(size, std::memory_order_release);
+            merge_usage(-static_cast<std::ptrdiff_t>(size));
+        }
+
+        void MemoryStats::merge_usage(std::ptrdiff_t delta)
+        {
+            const std::ptrdiff_t usage = merged_usage_.fetch_add(delta, std::memory_order_relaxed) + delta;
+            if (delta > 0 && usage > 0)
+            {
+                raise_peak(static_cast<size_t>(usage));
+            }
+        }
+
+        void MemoryStats::raise_peak(size_t usage) const
+        {
+            size_t peak = peak_.load(std::memory_order_relaxed);
+            while (usage > peak && !peak_.compare_exchange_weak(peak, usage, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        size_t MemoryStats::read_allocated() const
+        {
+            size_t total = overflow_.allocated.load(std::memory_order_acquire);
+            for (const Shard &shard : shards_)
+            {
+                total += shard.allocated.load(std::memory_order_acquire);
+            }
+            return total;
+        }
+
+        size_t MemoryStats::read_freed() const
+        {
+            size_t total = overflow_.freed.load(std::memory_order_acquire);
+            for (const Shard &shard : shards_)
+            {
+                total += shard.freed.load(std::memory_order_acquire);
+            }
+            return total;
+        }
+
+        size_t MemoryStats::read_current() const
+        {
+            // Frees first: every free observed then has its allocation observed
+            // too, so the difference cannot go negative
+            const size_t freed = read_freed();
+            const size_t allocated = read_allocated();
+            return allocated > freed ? allocated - freed : 0;
+        }
+
+        size_t MemoryStats::read_peak() const
+        {
+            raise_peak(read_current());
+            return peak_.load(std::memory_order_relaxed);
+        }
+
+        size_t MemoryStats::read_allocations() const
+        {
+            size_t total = overflow_.allocations.load(std::memory_order_acquire);
+            for (const Shard &shard : shards_)
+            {
+                total += shard.allocations.load(std::memory_order_acquire);
+            }
+            return total;
+        }
+
+        size_t MemoryStats::read_deallocations() const
+        {
+            size_t total = overflow_.deallocations.load(std::memory_order_acquire);
+            for (const Shard &shard : shards_)
+            {
+                total += shard.deallocations.load(std::memory_order_acquire);
+            }
+            return total;
+        }
+
+    } // namespace memory
+} // namespace flight
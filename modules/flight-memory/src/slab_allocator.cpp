@@ -0,0 +1,639 @@
+#include <flight/memory/slab_allocator.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <unordered_map>
+
+namespace flight
+{
+    namespace memory
+    {
+
+        namespace
+        {
+            constexpr size_t CACHE_LINE_SIZE = 64;
+            constexpr size_t SLAB_HEADER_SIZE = 128;
+            constexpr size_t MAGAZINE_BYTES = 64 * 1024; // Upper bound on cached bytes per class
+            constexpr size_t MAX_BLOCK_ALIGNMENT = 4096;
+
+            constexpr size_t compute_class_size(size_t size_class)
+            {
+                if (size_class < 8)
+                {
+                    return (size_class + 1) * 16;
+                }
+                const size_t power = 7 + (size_class - 8) / 4;
+                const size_t step = size_t(1) << (power - 2);
+                return (size_t(1) << power) + ((size_class - 8) % 4 + 1) * step;
+            }
+
+            struct ClassTable
+            {
+                // Class per request size in 16-byte units (all class sizes are multiples of 16)
+                uint8_t by_granule[SlabAllocator::MAX_SMALL_SIZE / 16 + 1] = {};
+                uint32_t block_size[SlabAllocator::SIZE_CLASS_COUNT] = {};
+                uint32_t data_offset[SlabAllocator::SIZE_CLASS_COUNT] = {};
+                uint32_t block_alignment[SlabAllocator::SIZE_CLASS_COUNT] = {};
+                uint32_t magazine_capacity[SlabAllocator::SIZE_CLASS_COUNT] = {};
+
+                constexpr ClassTable()
+                {
+                    size_t size_class = 0;
+                    for (size_t granule = 1; granule <= SlabAllocator::MAX_SMALL_SIZE / 16; ++granule)
+                    {
+                        while (compute_class_size(size_class) < granule * 16)
+                        {
+                            ++size_class;
+                        }
+                        by_granule[granule] = static_cast<uint8_t>(size_class);
+                    }
+                    for (size_t c = 0; c < SlabAllocator::SIZE_CLASS_COUNT; ++c)
+                    {
+                        const size_t size = compute_class_size(c);
+                        size_t alignment = size & (~size + 1);
+                        if (alignment > MAX_BLOCK_ALIGNMENT)
+                        {
+                            alignment = MAX_BLOCK_ALIGNMENT;
+                        }
+                        block_size[c] = static_cast<uint32_t>(size);
+                        block_alignment[c] = static_cast<uint32_t>(alignment);
+                        data_offset[c] = static_cast<uint32_t>((SLAB_HEADER_SIZE + alignment - 1) / alignment * alignment);
+                        size_t capacity = MAGAZINE_BYTES / size;
+                        capacity = capacity < 2 ? 2 : capacity;
+                        capacity = capacity > SlabAllocator::MAGAZINE_CAPACITY ? SlabAllocator::MAGAZINE_CAPACITY : capacity;
+                        magazine_capacity[c] = static_cast<uint32_t>(capacity);
+                    }
+                }
+            };
+
+            constexpr ClassTable class_table{};
+
+            static_assert(compute_class_size(SlabAllocator::SIZE_CLASS_COUNT - 1) == SlabAllocator::MAX_SMALL_SIZE,
+                          "Size classes must end at MAX_SMALL_SIZE");
+
+            // Allocator ids are never reused, so a stale thread-local entry
+            // can never match a newer allocator at the same address
+            std::atomic<uint64_t> next_allocator_id{1};
+
+            // Leaked on purpose: threads may exit after static destruction
+            std::mutex &registry_mutex()
+            {
+                static std::mutex *mutex = new std::mutex();
+                return *mutex;
+            }
+
+            std::unordered_map<uint64_t, SlabAllocator *> &live_allocators()
+            {
+                static auto *allocators = new std::unordered_map<uint64_t, SlabAllocator *>();
+                return *allocators;
+            }
+
+            inline void *&next_of(void *block)
+            {
+                return *static_cast<void **>(block);
+            }
+
+            inline size_t round_up(size_t value, size_t alignment)
+            {
+                return (value + alignment - 1) & ~(alignment - 1);
+            }
+
+        } // namespace
+
+        // Slab header, stored at the start of every SLAB_SIZE-aligned slab.
+        // Only the owning thread touches it while blocks are outstanding.
+        struct SlabAllocator::Slab
+        {
+            Heap *owner = nullptr;
+            Slab *prev = nullptr; // Partial list links
+            Slab *next = nullptr;
+            void *local_free = nullptr;
+            char *bump = nullptr;
+            char *end = nullptr;
+            uint32_t size_class = 0;
+            uint32_t used = 0; // Blocks not on local_free or behind bump
+            bool in_partial = false;
+
+            bool has_free() const { return local_free != nullptr || bump != end; }
+        };
+
+        // Per-thread heap. The remote list sits on its own cache line since
+        // other threads write it.
+        struct SlabAllocator::Heap
+        {
+            struct SizeClass
+            {
+                uint32_t count = 0;
+                uint32_t capacity = 0;
+                Slab *current = nullptr;
+                Slab *partial = nullptr; // Slabs with blocks on their local free list
+                void *slots[MAGAZINE_CAPACITY];
+            };
+
+            alignas(CACHE_LINE_SIZE) std::atomic<void *> remote_free{nullptr};
+            alignas(CACHE_LINE_SIZE) SizeClass classes[SIZE_CLASS_COUNT];
+
+            Heap()
+            {
+                clear();
+            }
+
+            void clear()
+            {
+                remote_free.store(nullptr, std::memory_order_relaxed);
+                for (size_t c = 0; c < SIZE_CLASS_COUNT; ++c)
+                {
+                    classes[c].count = 0;
+                    classes[c].capacity = class_table.magazine_capacity[c];
+                    classes[c].current = nullptr;
+                    classes[c].partial = nullptr;
+                }
+            }
+        };
+
+        // Per-thread list of heaps, one per allocator the thread has used.
+        // Hands each heap back to its allocator when the thread exits.
+        class ThreadHeapRegistry
+        {
+        public:
+            struct Entry
+            {
+                uint64_t allocator_id;
+                SlabAllocator *allocator;
+                SlabAllocator::Heap *heap;
+            };
+
+            ~ThreadHeapRegistry()
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex());
+                for (const Entry &entry : entries_)
+                {
+                    if (live_allocators().count(entry.allocator_id) != 0)
+                    {
+                        entry.allocator->release_heap(entry.heap);
+                    }
+                }
+            }
+
+            SlabAllocator::Heap *find(uint64_t allocator_id) const
+            {
+                for (const Entry &entry : entries_)
+                {
+                    if (entry.allocator_id == allocator_id)
+                    {
+                        return entry.heap;
+                    }
+                }
+                return nullptr;
+            }
+
+            void add(const Entry &entry)
+            {
+                // Drop entries of destroyed allocators
+                std::lock_guard<std::mutex> lock(registry_mutex());
+                entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                              [](const Entry &e)
+                                              { return live_allocators().count(e.allocator_id) == 0; }),
+                               entries_.end());
+                entries_.push_back(entry);
+            }
+
+        private:
+            std::vector<Entry> entries_;
+        };
+
+        namespace
+        {
+            thread_local ThreadHeapRegistry thread_heaps;
+
+            // One-entry cache in front of the registry
+            thread_local uint64_t cached_allocator_id = 0;
+            thread_local void *cached_heap = nullptr;
+
+            inline bool is_large(void *ptr)
+            {
+                // Slab blocks never sit at offset 0, large blocks always do
+                return (reinterpret_cast<uintptr_t>(ptr) & (SlabAllocator::SLAB_SIZE - 1)) == 0;
+            }
+        } // namespace
+
+        SlabAllocator::SlabAllocator()
+            : id_(next_allocator_id.fetch_add(1, std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            live_allocators().emplace(id_, this);
+        }
+
+        SlabAllocator::~SlabAllocator()
+        {
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex());
+                live_allocators().erase(id_);
+            }
+            for (void *slab : slabs_)
+            {
+                ::operator delete(slab, std::align_val_t(SLAB_SIZE));
+            }
+            for (void *block : large_blocks_)
+            {
+                ::operator delete(block, std::align_val_t(SLAB_SIZE));
+            }
+            for (Heap *heap : heaps_)
+            {
+                delete heap;
+            }
+        }
+
+        SlabAllocator::Slab *SlabAllocator::slab_of(void *block)
+        {
+            static_assert(sizeof(Slab) <= SLAB_HEADER_SIZE, "Slab header exceeds reserved space");
+            return reinterpret_cast<Slab *>(reinterpret_cast<uintptr_t>(block) & ~(uintptr_t(SLAB_SIZE) - 1));
+        }
+
+        size_t SlabAllocator::size_class_of(size_t size)
+        {
+            return class_table.by_granule[(size + 15) / 16];
+        }
+
+        size_t SlabAllocator::class_size(size_t size_class)
+        {
+            return class_table.block_size[size_class];
+        }
+
+        void *SlabAllocator::allocate(size_t size, size_t alignment)
+        {
+            if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > MAX_ALIGNMENT)
+            {
+                return nullptr;
+            }
+            if (size == 0)
+            {
+                size = 1;
+            }
+
+            size_t size_class = SIZE_CLASS_COUNT;
+            if (alignment <= 16)
+            {
+                if (size <= MAX_SMALL_SIZE)
+                {
+                    size_class = size_class_of(size);
+                }
+            }
+            else if (round_up(size, alignment) <= MAX_SMALL_SIZE)
+            {
+                // Over-aligned requests use the first class whose blocks are aligned
+                size_class = size_class_of(round_up(size, alignment));
+                while (size_class < SIZE_CLASS_COUNT && class_table.block_alignment[size_class] < alignment)
+                {
+                    ++size_class;
+                }
+            }
+
+            void *block;
+            if (size_class == SIZE_CLASS_COUNT)
+            {
+                block = allocate_large(size);
+            }
+            else
+            {
+                Heap *heap = local_heap();
+                Heap::SizeClass &magazine = heap->classes[size_class];
+                block = magazine.count != 0 ? magazine.slots[--magazine.count] : refill(heap, size_class);
+            }
+            if (block != nullptr)
+            {
+                stats_.record_allocation(size);
+            }
+            return block;
+        }
+
+        void SlabAllocator::deallocate(void *ptr, size_t size)
+        {
+            if (ptr == nullptr)
+            {
+                return;
+            }
+            stats_.record_deallocation(size == 0 ? 1 : size);
+
+            if (is_large(ptr))
+            {
+                deallocate_large(ptr, size);
+                return;
+            }
+
+            Slab *slab = slab_of(ptr);
+            Heap *heap = find_local_heap();
+            if (slab->owner == heap)
+            {
+                Heap::SizeClass &magazine = heap->classes[slab->size_class];
+                if (magazine.count == magazine.capacity)
+                {
+                    flush(heap, slab->size_class);
+                }
+                magazine.slots[magazine.count++] = ptr;
+                return;
+            }
+
+            // Cross-thread free: lock-free push onto the owner's return list.
+            // The slab cannot be released while this block is outstanding, so
+            // its owner is stable; heaps live as long as the allocator.
+            std::atomic<void *> &list = slab->owner->remote_free;
+            void *head = list.load(std::memory_order_relaxed);
+            do
+            {
+                next_of(ptr) = head;
+            } while (!list.compare_exchange_weak(head, ptr, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        void SlabAllocator::reset()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (void *slab : slabs_)
+            {
+                ::operator delete(slab, std::align_val_t(SLAB_SIZE));
+            }
+            for (void *block : large_blocks_)
+            {
+                ::operator delete(block, std::align_val_t(SLAB_SIZE));
+            }
+            slabs_.clear();
+            large_blocks_.clear();
+            empty_slabs_.clear();
+            for (Heap *heap : heaps_)
+            {
+                heap->clear();
+            }
+            reserved_bytes_.store(0, std::memory_order_relaxed);
+
+            stats_.record_release(stats_.current_usage.load());
+        }
+
+        size_t SlabAllocator::get_used_memory() const
+        {
+            return stats_.current_usage.load();
+        }
+
+        size_t SlabAllocator::get_total_memory() const
+        {
+            return reserved_bytes_.load(std::memory_order_relaxed);
+        }
+
+        void SlabAllocator::trim()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (Slab *slab : empty_slabs_)
+            {
+                slabs_.erase(slab);
+                ::operator delete(slab, std::align_val_t(SLAB_SIZE));
+            }
+            reserved_bytes_.fetch_sub(empty_slabs_.size() * SLAB_SIZE, std::memory_order_relaxed);
+            empty_slabs_.clear();
+        }
+
+        SlabAllocator::Heap *SlabAllocator::local_heap()
+        {
+            if (cached_allocator_id == id_)
+            {
+                return static_cast<Heap *>(cached_heap);
+            }
+            Heap *heap = thread_heaps.find(id_);
+            if (heap == nullptr)
+            {
+                heap = acquire_heap();
+                thread_heaps.add({id_, this, heap});
+            }
+            cached_allocator_id = id_;
+            cached_heap = heap;
+            return heap;
+        }
+
+        SlabAllocator::Heap *SlabAllocator::find_local_heap() const
+        {
+            if (cached_allocator_id == id_)
+            {
+                return static_cast<Heap *>(cached_heap);
+            }
+            return thread_heaps.find(id_);
+        }
+
+        SlabAllocator::Heap *SlabAllocator::acquire_heap()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!idle_heaps_.empty())
+            {
+                Heap *heap = idle_heaps_.back();
+                idle_heaps_.pop_back();
+                return heap;
+            }
+            Heap *heap = new Heap();
+            heaps_.push_back(heap);
+            return heap;
+        }
+
+        void SlabAllocator::release_heap(Heap *heap)
+        {
+            // Runs at thread exit: return cached blocks so their slabs can be
+            // recycled, then park the heap (and its slabs) for the next thread
+            for (size_t c = 0; c < SIZE_CLASS_COUNT; ++c)
+            {
+                Heap::SizeClass &magazine = heap->classes[c];
+                while (magazine.count != 0)
+                {
+                    return_block(heap, magazine.slots[--magazine.count]);
+                }
+            }
+            drain_remote(heap);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            idle_heaps_.push_back(heap);
+        }
+
+        void *SlabAllocator::refill(Heap *heap, size_t size_class)
+        {
+            drain_remote(heap);
+
+            Heap::SizeClass &magazine = heap->classes[size_class];
+            const uint32_t target = magazine.capacity / 2 > 0 ? magazine.capacity / 2 : 1;
+            const size_t block_size = class_table.block_size[size_class];
+
+            while (magazine.count < target)
+            {
+                Slab *slab = magazine.current;
+                if (slab == nullptr || !slab->has_free())
+                {
+                    // The exhausted slab stays off every list until a block comes home
+                    slab = magazine.partial;
+                    if (slab != nullptr)
+                    {
+                        magazine.partial = slab->next;
+                        if (magazine.partial != nullptr)
+                        {
+                            magazine.partial->prev = nullptr;
+                        }
+                        slab->in_partial = false;
+                        slab->next = nullptr;
+                    }
+                    else
+                    {
+                        slab = acquire_slab(heap, size_class);
+                        if (slab == nullptr)
+                        {
+                            break;
+                        }
+                    }
+                    magazine.current = slab;
+                }
+
+                while (magazine.count < target && slab->local_free != nullptr)
+                {
+                    void *block = slab->local_free;
+                    slab->local_free = next_of(block);
+                    magazine.slots[magazine.count++] = block;
+                    ++slab->used;
+                }
+                while (magazine.count < target && slab->bump != slab->end)
+                {
+                    magazine.slots[magazine.count++] = slab->bump;
+                    slab->bump += block_size;
+                    ++slab->used;
+                }
+            }
+
+            return magazine.count != 0 ? magazine.slots[--magazine.count] : nullptr;
+        }
+
+        void SlabAllocator::flush(Heap *heap, size_t size_class)
+        {
+            // Return the older half; recently freed blocks stay cached
+            Heap::SizeClass &magazine = heap->classes[size_class];
+            const uint32_t half = magazine.count / 2;
+            for (uint32_t i = 0; i < half; ++i)
+            {
+                return_block(heap, magazine.slots[i]);
+            }
+            std::memmove(magazine.slots, magazine.slots + half, (magazine.count - half) * sizeof(void *));
+            magazine.count -= half;
+        }
+
+        void SlabAllocator::return_block(Heap *heap, void *block)
+        {
+            Slab *slab = slab_of(block);
+            Heap::SizeClass &magazine = heap->classes[slab->size_class];
+            next_of(block) = slab->local_free;
+            slab->local_free = block;
+            --slab->used;
+
+            if (slab == magazine.current)
+            {
+                return;
+            }
+            if (slab->used == 0)
+            {
+                if (slab->in_partial)
+                {
+                    (slab->prev != nullptr ? slab->prev->next : magazine.partial) = slab->next;
+                    if (slab->next != nullptr)
+                    {
+                        slab->next->prev = slab->prev;
+                    }
+                }
+                release_slab(slab);
+            }
+            else if (!slab->in_partial)
+            {
+                slab->prev = nullptr;
+                slab->next = magazine.partial;
+                if (magazine.partial != nullptr)
+                {
+                    magazine.partial->prev = slab;
+                }
+                magazine.partial = slab;
+                slab->in_partial = true;
+            }
+        }
+
+        void SlabAllocator::drain_remote(Heap *heap)
+        {
+            if (heap->remote_free.load(std::memory_order_relaxed) == nullptr)
+            {
+                return;
+            }
+            void *block = heap->remote_free.exchange(nullptr, std::memory_order_acquire);
+            while (block != nullptr)
+            {
+                void *next = next_of(block);
+                return_block(heap, block);
+                block = next;
+            }
+        }
+
+        SlabAllocator::Slab *SlabAllocator::acquire_slab(Heap *heap, size_t size_class)
+        {
+            void *memory = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!empty_slabs_.empty())
+                {
+                    memory = empty_slabs_.back();
+                    empty_slabs_.pop_back();
+                }
+                else
+                {
+                    memory = ::operator new(SLAB_SIZE, std::align_val_t(SLAB_SIZE), std::nothrow);
+                    if (memory == nullptr)
+                    {
+                        return nullptr;
+                    }
+                    slabs_.insert(memory);
+                    reserved_bytes_.fetch_add(SLAB_SIZE, std::memory_order_relaxed);
+                }
+            }
+
+            const size_t block_size = class_table.block_size[size_class];
+            const size_t offset = class_table.data_offset[size_class];
+            const size_t blocks = (SLAB_SIZE - offset) / block_size;
+
+            Slab *slab = new (memory) Slab();
+            slab->owner = heap;
+            slab->size_class = static_cast<uint32_t>(size_class);
+            slab->bump = static_cast<char *>(memory) + offset;
+            slab->end = slab->bump + blocks * block_size;
+            return slab;
+        }
+
+        void SlabAllocator::release_slab(Slab *slab)
+        {
+            slab->owner = nullptr;
+            std::lock_guard<std::mutex> lock(mutex_);
+            empty_slabs_.push_back(slab);
+        }
+
+        void *SlabAllocator::allocate_large(size_t size)
+        {
+            const size_t bytes = round_up(size, SLAB_SIZE);
+            void *block = ::operator new(bytes, std::align_val_t(SLAB_SIZE), std::nothrow);
+            if (block == nullptr)
+            {
+                return nullptr;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                large_blocks_.insert(block);
+            }
+            reserved_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+            return block;
+        }
+
+        void SlabAllocator::deallocate_large(void *ptr, size_t size)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                large_blocks_.erase(ptr);
+            }
+            reserved_bytes_.fetch_sub(round_up(size == 0 ? 1 : size, SLAB_SIZE), std::memory_order_relaxed);
+            ::operator delete(ptr, std::align_val_t(SLAB_SIZE));
+        }
+
+    } // namespace memory
+} // namespace flight
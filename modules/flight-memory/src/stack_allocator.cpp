@@ -0,0 +1,55 @@
+#include <flight/memory/stack_allocator.hpp>
+
+namespace flight
+{
+    namespace memory
+    {
+
+        void *StackAllocator::allocate(size_t size, size_t alignment)
+        {
+            const Arena::Marker before = arena_.mark();
+            void *ptr = arena_.allocate(size, alignment);
+            if (ptr)
+            {
+                frames_.push_back(Frame{before, ptr});
+            }
+            return ptr;
+        }
+
+        void StackAllocator::deallocate(void *ptr, size_t)
+        {
+            if (!ptr)
+            {
+                return;
+            }
+            for (size_t index = frames_.size(); index-- > 0;)
+            {
+                if (frames_[index].ptr != ptr)
+                {
+                    continue;
+                }
+                if (index + 1 != frames_.size())
+                {
+                    frames_[index].ptr = nullptr;
+                    return;
+                }
+                // Top of the stack: also pop anything below it that was
+                // already freed out of order
+                while (index > 0 && frames_[index - 1].ptr == nullptr)
+                {
+                    --index;
+                }
+                arena_.rewind(frames_[index].before);
+                frames_.resize(index);
+                return;
+            }
+        }
+
+        void StackAllocator::reset()
+        {
+            frames_.clear();
+            arena_.reset();
+        }
+
+    } // namespace memory
+} // namespace flight
@@ -0,0 +1,169 @@
+// Flight Core Memory - arena tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/memory/arena.hpp>
+#include <flight/memory/stl_allocator.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+using namespace flight::memory;
+
+namespace
+{
+    bool aligned(const void *ptr, size_t alignment)
+    {
+        return (reinterpret_cast<uintptr_t>(ptr) & (alignment - 1)) == 0;
+    }
+} // namespace
+
+// =============================================================================
+// Allocation
+// =============================================================================
+
+TEST_CASE("Arena allocations are aligned and disjoint", "[memory][arena]")
+{
+    Arena arena(1024);
+    REQUIRE(arena.used() == 0);
+    REQUIRE(arena.capacity() == 0);
+
+    auto *a = static_cast<uint8_t *>(arena.allocate(10, 1));
+    auto *b = static_cast<uint8_t *>(arena.allocate(8, 8));
+    void *c = arena.allocate(0);
+    REQUIRE(a != nullptr);
+    REQUIRE(aligned(b, 8));
+    REQUIRE(b >= a + 10);
+    REQUIRE(c != nullptr);
+    REQUIRE(c != b);
+    REQUIRE(arena.capacity() == 1024);
+    REQUIRE(arena.used() >= 19);
+
+    REQUIRE(aligned(arena.allocate(1, 256), 256));
+    REQUIRE(arena.allocate(8, 3) == nullptr);
+    REQUIRE(arena.allocate(8, 0) == nullptr);
+}
+
+TEST_CASE("Requests beyond the block size get a dedicated block", "[memory][arena]")
+{
+    Arena arena(256);
+    REQUIRE(arena.allocate(16) != nullptr);
+    void *large = arena.allocate(4096, 64);
+    REQUIRE(large != nullptr);
+    REQUIRE(aligned(large, 64));
+    std::memset(large, 0x5A, 4096);
+    REQUIRE(arena.capacity() >= 256 + 4096);
+    REQUIRE(arena.used() >= 16 + 4096);
+}
+
+// =============================================================================
+// Mark and rewind
+// =============================================================================
+
+TEST_CASE("rewind() returns to a marker and reuses its memory", "[memory][arena]")
+{
+    Arena arena(256);
+    REQUIRE(arena.allocate(32) != nullptr);
+    const Arena::Marker marker = arena.mark();
+    const size_t used = arena.used();
+
+    void *first = arena.allocate(64);
+    for (int i = 0; i < 20; ++i)
+    {
+        REQUIRE(arena.allocate(100) != nullptr); // Spills into further blocks
+    }
+    const size_t capacity = arena.capacity();
+    REQUIRE(capacity > 256);
+
+    arena.rewind(marker);
+    REQUIRE(arena.used() == used);
+    REQUIRE(arena.capacity() == capacity);
+    REQUIRE(arena.allocate(64) == first);
+
+    // The spare blocks are reused: no new memory for the same pattern
+    for (int i = 0; i < 20; ++i)
+    {
+        REQUIRE(arena.allocate(100) != nullptr);
+    }
+    REQUIRE(arena.capacity() == capacity);
+}
+
+TEST_CASE("Scopes nest", "[memory][arena]")
+{
+    Arena arena(128);
+    void *outer_first = nullptr;
+    void *inner_first = nullptr;
+    {
+        Arena::Scope outer(arena);
+        outer_first = arena.allocate(48);
+        const size_t used = arena.used();
+        {
+            Arena::Scope inner(arena);
+            inner_first = arena.allocate(48);
+            REQUIRE(arena.allocate(200) != nullptr);
+        }
+        REQUIRE(arena.used() == used);
+        REQUIRE(arena.allocate(48) == inner_first);
+    }
+    REQUIRE(arena.used() == 0);
+    REQUIRE(arena.allocate(48) == outer_first);
+}
+
+TEST_CASE("reset() keeps blocks and release() frees them", "[memory][arena]")
+{
+    Arena arena(128);
+    void *first = arena.allocate(64);
+    REQUIRE(arena.allocate(512) != nullptr);
+    const size_t capacity = arena.capacity();
+
+    arena.reset();
+    REQUIRE(arena.used() == 0);
+    REQUIRE(arena.capacity() == capacity);
+    REQUIRE(arena.allocate(64) == first);
+
+    arena.release();
+    REQUIRE(arena.used() == 0);
+    REQUIRE(arena.capacity() == 0);
+    REQUIRE(arena.allocate(64) != nullptr);
+}
+
+TEST_CASE("Moving an arena moves its blocks", "[memory][arena]")
+{
+    Arena arena(128);
+    REQUIRE(arena.allocate(64) != nullptr);
+    const size_t used = arena.used();
+
+    Arena moved(std::move(arena));
+    REQUIRE(moved.used() == used);
+    REQUIRE(moved.capacity() == 128);
+    REQUIRE(arena.capacity() == 0);
+
+    Arena assigned;
+    assigned = std::move(moved);
+    REQUIRE(assigned.used() == used);
+    REQUIRE(moved.capacity() == 0);
+}
+
+// =============================================================================
+// STL adapter
+// =============================================================================
+
+TEST_CASE("Arena containers allocate from the arena", "[memory][arena]")
+{
+    Arena arena(1024);
+    {
+        Arena::Scope scope(arena);
+        ArenaVector<uint32_t> values{StlAllocator<uint32_t>(arena)};
+        for (uint32_t i = 0; i < 100; ++i)
+        {
+            values.push_back(i);
+        }
+        REQUIRE(values[99] == 99);
+        REQUIRE(arena.used() >= 100 * sizeof(uint32_t));
+
+        ArenaString text{StlAllocator<char>(arena)};
+        text.assign(200, 'x');
+        REQUIRE(text.size() == 200);
+    }
+    REQUIRE(arena.used() == 0);
+}
@@ -0,0 +1,172 @@
+// Flight Core Memory - slab allocator tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/memory/slab_allocator.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace flight::memory;
+
+namespace
+{
+    bool aligned(const void *ptr, size_t alignment)
+    {
+        return (reinterpret_cast<uintptr_t>(ptr) & (alignment - 1)) == 0;
+    }
+} // namespace
+
+// =============================================================================
+// Size classes
+// =============================================================================
+
+TEST_CASE("Size classes cover every small request", "[memory][slab]")
+{
+    size_t previous = 0;
+    for (size_t size = 1; size <= SlabAllocator::MAX_SMALL_SIZE; ++size)
+    {
+        const size_t size_class = SlabAllocator::size_class_of(size);
+        REQUIRE(size_class < SlabAllocator::SIZE_CLASS_COUNT);
+        REQUIRE(size_class >= previous);
+        REQUIRE(SlabAllocator::class_size(size_class) >= size);
+        previous = size_class;
+    }
+    REQUIRE(SlabAllocator::class_size(SlabAllocator::size_class_of(SlabAllocator::MAX_SMALL_SIZE)) ==
+            SlabAllocator::MAX_SMALL_SIZE);
+}
+
+// =============================================================================
+// Small blocks
+// =============================================================================
+
+TEST_CASE("Freed small blocks are reused", "[memory][slab]")
+{
+    SlabAllocator allocator;
+    void *first = allocator.allocate(24);
+    REQUIRE(first != nullptr);
+    REQUIRE(aligned(first, 16));
+    std::memset(first, 0xAB, 24);
+    REQUIRE(allocator.get_used_memory() == 24);
+    REQUIRE(allocator.get_total_memory() == SlabAllocator::SLAB_SIZE);
+
+    allocator.deallocate(first, 24);
+    REQUIRE(allocator.get_used_memory() == 0);
+    REQUIRE(allocator.allocate(20) == first);
+    allocator.deallocate(first, 20);
+
+    REQUIRE(allocator.get_stats().allocation_count == 2);
+    REQUIRE(allocator.get_stats().deallocation_count == 2);
+}
+
+TEST_CASE("Over-aligned requests get aligned blocks", "[memory][slab]")
+{
+    SlabAllocator allocator;
+    for (size_t alignment : {32, 64, 256, 4096})
+    {
+        void *block = allocator.allocate(40, alignment);
+        REQUIRE(block != nullptr);
+        REQUIRE(aligned(block, alignment));
+        allocator.deallocate(block, 40);
+    }
+    REQUIRE(allocator.allocate(16, 3) == nullptr);
+    REQUIRE(allocator.allocate(16, SlabAllocator::MAX_ALIGNMENT * 2) == nullptr);
+    REQUIRE(allocator.get_used_memory() == 0);
+}
+
+TEST_CASE("Blocks freed by another thread return to their slab", "[memory][slab]")
+{
+    SlabAllocator allocator;
+    std::vector<void *> blocks;
+    for (int i = 0; i < 1000; ++i)
+    {
+        blocks.push_back(allocator.allocate(48));
+        REQUIRE(blocks.back() != nullptr);
+    }
+    const size_t reserved = allocator.get_total_memory();
+
+    std::thread([&] {
+        for (void *block : blocks)
+        {
+            allocator.deallocate(block, 48);
+        }
+    }).join();
+    REQUIRE(allocator.get_used_memory() == 0);
+
+    // The owner reclaims the returned blocks instead of carving new slabs
+    for (void *&block : blocks)
+    {
+        block = allocator.allocate(48);
+    }
+    REQUIRE(allocator.get_total_memory() == reserved);
+    for (void *block : blocks)
+    {
+        allocator.deallocate(block, 48);
+    }
+}
+
+// =============================================================================
+// Large blocks and accounting
+// =============================================================================
+
+TEST_CASE("Large frees give back exactly what was reserved", "[memory][slab]")
+{
+    SlabAllocator allocator;
+    const size_t sizes[] = {SlabAllocator::MAX_SMALL_SIZE + 1, SlabAllocator::SLAB_SIZE,
+                            SlabAllocator::SLAB_SIZE + 1, 5 * SlabAllocator::SLAB_SIZE - 7};
+    size_t reserved = 0;
+    std::vector<void *> blocks;
+    for (size_t size : sizes)
+    {
+        void *block = allocator.allocate(size);
+        REQUIRE(block != nullptr);
+        REQUIRE(aligned(block, SlabAllocator::SLAB_SIZE));
+        reserved += (size + SlabAllocator::SLAB_SIZE - 1) / SlabAllocator::SLAB_SIZE * SlabAllocator::SLAB_SIZE;
+        REQUIRE(allocator.get_total_memory() == reserved);
+        blocks.push_back(block);
+    }
+
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        allocator.deallocate(blocks[i], sizes[i]);
+    }
+    REQUIRE(allocator.get_total_memory() == 0);
+    REQUIRE(allocator.get_used_memory() == 0);
+    REQUIRE(allocator.get_stats().total_freed == allocator.get_stats().total_allocated);
+}
+
+TEST_CASE("Over-aligned requests without a fitting class are large", "[memory][slab]")
+{
+    SlabAllocator allocator;
+    void *block = allocator.allocate(100, SlabAllocator::MAX_ALIGNMENT);
+    REQUIRE(block != nullptr);
+    REQUIRE(aligned(block, SlabAllocator::MAX_ALIGNMENT));
+    REQUIRE(allocator.get_total_memory() == SlabAllocator::SLAB_SIZE);
+    allocator.deallocate(block, 100);
+    REQUIRE(allocator.get_total_memory() == 0);
+}
+
+TEST_CASE("trim() and reset() return memory to the system", "[memory][slab]")
+{
+    SlabAllocator allocator;
+    std::vector<void *> blocks;
+    for (int i = 0; i < 4096; ++i)
+    {
+        blocks.push_back(allocator.allocate(64));
+    }
+    void *large = allocator.allocate(SlabAllocator::SLAB_SIZE * 2);
+    REQUIRE(large != nullptr);
+    REQUIRE(allocator.get_total_memory() > SlabAllocator::SLAB_SIZE * 2);
+
+    allocator.reset();
+    REQUIRE(allocator.get_total_memory() == 0);
+    REQUIRE(allocator.get_used_memory() == 0);
+
+    // Still usable after a reset
+    void *block = allocator.allocate(64);
+    REQUIRE(block != nullptr);
+    allocator.deallocate(block, 64);
+    allocator.trim();
+    REQUIRE(allocator.get_used_memory() == 0);
+}
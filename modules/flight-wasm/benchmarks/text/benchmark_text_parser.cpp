@@ -0,0 +1,106 @@
+// =============================================================================
+// Flight WASM Foundation - Text Format Performance Benchmarks
+// WAT parsing and printing throughput (MB/s) on multi-megabyte inputs
+// =============================================================================
+
+#include <benchmark/benchmark.h>
+#include <flight/wasm/text/parser.hpp>
+#include <cstdint>
+#include <string>
+
+using namespace flight::wasm;
+
+namespace {
+
+    // Generates a module of roughly target_bytes with a realistic instruction mix
+    std::string make_wat(size_t target_bytes) {
+        std::string wat = "(module\n"
+                          "  (type $binary (func (param i32 i32) (result i32)))\n"
+                          "  (memory (export \"memory\") 1)\n"
+                          "  (global $sp (mut i32) (i32.const 65536))\n";
+        for (size_t index = 0; wat.size() < target_bytes; ++index) {
+            const std::string id = std::to_string(index);
+            wat += "  (func $f" + id + " (export \"f" + id + "\") (type $binary)"
+                   " (param $a i32) (param $b i32) (result i32)\n"
+                   "    (local $i i32) (local $acc i64)\n"
+                   "    ;; accumulate a checksum\n"
+                   "    (block $done\n"
+                   "      (loop $next\n"
+                   "        (br_if $done (i32.ge_u (local.get $i) (local.get $b)))\n"
+                   "        (local.set $acc (i64.add (local.get $acc)\n"
+                   "          (i64.extend_i32_u (i32.load offset=16 align=4 (local.get $a)))))\n"
+                   "        (local.set $i (i32.add (local.get $i) (i32.const 1)))\n"
+                   "        (br $next)))\n"
+                   "    global.get $sp\n"
+                   "    f64.const 0x1.8p+3\n"
+                   "    drop\n"
+                   "    (i32.wrap_i64 (local.get $acc))\n"
+                   "    i32.xor)\n";
+        }
+        wat += ")\n";
+        return wat;
+    }
+
+} // namespace
+
+// =============================================================================
+// Parsing Throughput
+// =============================================================================
+
+static void BM_TextParse(benchmark::State& state) {
+    const std::string wat = make_wat(static_cast<size_t>(state.range(0)) << 20);
+
+    for (auto _ : state) {
+        auto module = TextParser::parse(wat);
+        if (!module) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+        benchmark::DoNotOptimize(module.value().functions.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * wat.size()));
+    state.SetLabel("wat_to_module");
+}
+BENCHMARK(BM_TextParse)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
+
+static void BM_TextTokenize(benchmark::State& state) {
+    const std::string wat = make_wat(static_cast<size_t>(state.range(0)) << 20);
+
+    for (auto _ : state) {
+        SExprArena arena;
+        auto tree = read_sexprs(wat, arena);
+        benchmark::DoNotOptimize(tree);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * wat.size()));
+    state.SetLabel("lexer_and_tree");
+}
+BENCHMARK(BM_TextTokenize)->Arg(4)->Unit(benchmark::kMillisecond);
+
+// =============================================================================
+// Printing Throughput
+// =============================================================================
+
+static void BM_TextEncodeStream(benchmark::State& state) {
+    const std::string wat = make_wat(static_cast<size_t>(state.range(0)) << 20);
+    auto module = TextParser::parse(wat);
+    if (!module) {
+        state.SkipWithError("parse failed");
+        return;
+    }
+
+    size_t produced = 0;
+    for (auto _ : state) {
+        produced = 0;
+        auto written = TextEncoder::encode_to(module.value(), [&produced](span<const uint8_t> chunk) {
+            produced += chunk.size();
+            return true;
+        });
+        benchmark::DoNotOptimize(written);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * produced));
+    state.SetLabel("streamed_output");
+}
+BENCHMARK(BM_TextEncodeStream)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
@@ -4,36 +4,79 @@
 /**
  * @file encoder.hpp
  * @brief WebAssembly binary format encoding functionality
- * 
- * This header provides forward declarations and basic structure for encoding
- * WebAssembly modules to binary format. Full implementation will be completed
- * in future encoding tasks.
+ *
+ * This header provides the BinaryWriter and the BinaryEncoder that serializes
+ * Module objects to the WebAssembly binary format. Encoding runs a sizing
+ * pass first (every section body is measured by replaying its encoder against
+ * a counting writer), so section length prefixes are written up front with
+ * their exact LEB128 width and the output is produced in a single allocation
+ * or streamed straight to a caller-supplied sink. Section bodies are never
+ * buffered to patch a length prefix afterwards.
+ *
+ * Modules edited after parsing can be spliced back into their original
+ * bytes: unchanged sections are copied verbatim and only the modified ones
+ * are re-encoded.
  */
 
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
 #include <vector>
+#include <flight/wasm/utilities/error.hpp>
+#include <flight/wasm/utilities/endian.hpp>
+#include <flight/wasm/utilities/span.hpp>
+#include <flight/wasm/types/values.hpp>
+#include <flight/wasm/types/modules.hpp>
+#include <flight/wasm/binary/parser.hpp>
 
 namespace flight::wasm {
 
-    // Forward declarations
-    class Module;
-    class Error;
-    template<typename T> class Result;
-    template<typename T> class span;
+    /**
+     * @brief Destination for streamed output
+     *
+     * Receives consecutive chunks of the encoding; returning false aborts
+     * encoding with ErrorCode::FileWriteFailed.
+     */
+    using WriteCallback = std::function<bool(span<const uint8_t> chunk)>;
 
     /**
      * @brief Binary writer for encoding WebAssembly binary format
-     * 
+     *
      * This class provides low-level binary writing functionality with
-     * proper buffer management and endianness handling.
+     * proper buffer management and endianness handling. A writer either
+     * accumulates into its own buffer, streams through a small staging
+     * buffer to a WriteCallback, or only counts bytes (sizing pass).
      */
     class BinaryWriter {
     public:
+        /**
+         * @brief Default staging buffer size for streaming writers
+         */
+        static constexpr size_t DEFAULT_STAGING_SIZE = 64 * 1024;
+
         /**
          * @brief Construct a binary writer
          */
         BinaryWriter() = default;
 
+        /**
+         * @brief Construct a writer that streams to @p sink
+         *
+         * Writes are staged in a buffer of @p staging_size bytes; writes at
+         * least that large bypass the staging buffer and reach the sink
+         * without being copied.
+         */
+        explicit BinaryWriter(WriteCallback sink, size_t staging_size = DEFAULT_STAGING_SIZE);
+
+        /**
+         * @brief Construct a writer that only counts bytes
+         */
+        static BinaryWriter counting() noexcept;
+
         /**
          * @brief Get the current write position
          */
@@ -46,9 +89,17 @@ namespace flight::wasm {
 
         /**
          * @brief Get the written data
+         *
+         * Only meaningful for buffering writers; streaming writers expose
+         * their unflushed staging bytes, counting writers an empty buffer.
          */
         const std::vector<uint8_t>& data() const noexcept;
 
+        /**
+         * @brief Move the written data out of a buffering writer
+         */
+        std::vector<uint8_t> take() noexcept;
+
         /**
          * @brief Clear the buffer
          */
@@ -59,6 +110,17 @@ namespace flight::wasm {
          */
         void reserve(size_t capacity);
 
+        /**
+         * @brief Deliver staged bytes to the sink (streaming writers only)
+         * @return false if the sink rejected a chunk
+         */
+        bool flush();
+
+        /**
+         * @brief Check whether the sink rejected any chunk
+         */
+        bool failed() const noexcept;
+
         /**
          * @brief Write a single byte
          */
@@ -112,24 +174,103 @@ namespace flight::wasm {
         /**
          * @brief Write a UTF-8 string (with length prefix)
          */
-        void write_string(const std::string& str);
+        void write_string(std::string_view str);
+
+        /**
+         * @brief Number of bytes write_leb128_u32 emits for @p value
+         */
+        static constexpr size_t leb128_u32_size(uint32_t value) noexcept {
+            size_t bytes = 1;
+            while (value >= 0x80) {
+                value >>= 7;
+                ++bytes;
+            }
+            return bytes;
+        }
 
     private:
+        enum class Mode : uint8_t {
+            Buffer,  // Accumulate into buffer_
+            Sink,    // Stage in buffer_, deliver to sink_
+            Count    // Advance written_ only
+        };
+
+        void write_raw(const uint8_t* data, size_t size);
+
+        Mode mode_ = Mode::Buffer;
         std::vector<uint8_t> buffer_;
+        WriteCallback sink_;
+        size_t staging_size_ = 0;
+        size_t written_ = 0;
+        bool failed_ = false;
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Standard (non-custom) sections in the order they are encoded
+         */
+        inline constexpr SectionId standard_section_order[] = {
+            SectionId::Type, SectionId::Import, SectionId::Function, SectionId::Table,
+            SectionId::Memory, SectionId::Global, SectionId::Export, SectionId::Start,
+            SectionId::Element, SectionId::DataCount, SectionId::Code, SectionId::Data
+        };
+
+    } // namespace detail
+
+    /**
+     * @brief Set of section ids, used to mark sections modified after parsing
+     */
+    class SectionSet {
+    public:
+        constexpr SectionSet() noexcept = default;
+        constexpr SectionSet(std::initializer_list<SectionId> ids) noexcept {
+            for (SectionId id : ids) {
+                insert(id);
+            }
+        }
+
+        constexpr void insert(SectionId id) noexcept { bits_ |= bit(id); }
+        constexpr bool contains(SectionId id) const noexcept { return (bits_ & bit(id)) != 0; }
+        constexpr bool empty() const noexcept { return bits_ == 0; }
+
+        /**
+         * @brief Set containing every section id
+         */
+        static constexpr SectionSet all() noexcept {
+            SectionSet set;
+            set.bits_ = (1u << 13) - 1;
+            return set;
+        }
+
+    private:
+        static constexpr uint32_t bit(SectionId id) noexcept {
+            return 1u << static_cast<uint8_t>(id);
+        }
+
+        uint32_t bits_ = 0;
     };
 
     /**
      * @brief WebAssembly binary encoder
-     * 
+     *
      * High-level encoder that converts Module objects to binary format.
      */
     class BinaryEncoder {
     public:
         /**
          * @brief Encode a WebAssembly module to binary format
+         *
+         * The result is produced in one exactly-sized allocation.
          */
         static Result<std::vector<uint8_t>> encode(const Module& module) noexcept;
 
+        /**
+         * @brief Stream a WebAssembly module to a caller-supplied sink
+         * @return Total number of bytes delivered
+         */
+        static Result<size_t> encode_to(const Module& module, const WriteCallback& sink) noexcept;
+
         /**
          * @brief Encode a WebAssembly module to a file
          */
@@ -140,13 +281,81 @@ namespace flight::wasm {
          */
         static Result<size_t> calculate_size(const Module& module) noexcept;
 
+        /**
+         * @brief Re-encode a module by splicing it into its original binary
+         *
+         * Sections of @p original that are not in @p modified are copied
+         * byte-for-byte; only the modified sections are re-encoded from
+         * @p module, so the cost is proportional to the edit rather than the
+         * module size. Modified sections missing from @p original are
+         * inserted at their canonical position, and modified sections that
+         * are now empty are dropped. Marking SectionId::Custom re-encodes the
+         * custom sections in place, in Module::custom_sections order, and
+         * appends any extra entries at the end.
+         *
+         * @p module must have been parsed from @p original. The caller is
+         * responsible for marking dependent sections, e.g. Function and Code
+         * together.
+         */
+        static Result<std::vector<uint8_t>> splice(span<const uint8_t> original, const Module& module,
+                                                   SectionSet modified) noexcept;
+
+        /**
+         * @brief Stream a spliced re-encoding to a caller-supplied sink
+         * @return Total number of bytes delivered
+         */
+        static Result<size_t> splice_to(span<const uint8_t> original, const Module& module,
+                                        SectionSet modified, const WriteCallback& sink) noexcept;
+
     private:
+        friend class StreamingBinaryEncoder;
+
+        /**
+         * @brief Result of the sizing pass for one section
+         */
+        struct SectionLayout {
+            uint8_t id;
+            size_t custom_index;  // Index into Module::custom_sections (custom sections only)
+            size_t body_size;     // Exact size of the section body
+
+            size_t encoded_size() const noexcept {
+                return 1 + BinaryWriter::leb128_u32_size(static_cast<uint32_t>(body_size)) + body_size;
+            }
+        };
+
+        /**
+         * @brief One piece of a spliced module: copied input or re-encoded section
+         */
+        struct SplicePiece {
+            bool copy;
+            size_t offset;          // Input offset (copied pieces only)
+            size_t length;          // Input length (copied pieces only)
+            SectionLayout section;  // Re-encoded pieces only
+
+            size_t encoded_size() const noexcept { return copy ? length : section.encoded_size(); }
+        };
+
         BinaryEncoder() = default;
 
-        // Internal encoding methods (to be implemented)
+        // Sizing pass
+        Result<std::vector<SectionLayout>> layout_sections(const Module& module) noexcept;
+        Result<void> measure_section(const Module& module, SectionLayout& section) noexcept;
+        static bool has_section(const Module& module, SectionId id) noexcept;
+        static size_t total_size(const std::vector<SectionLayout>& layout) noexcept;
+        Result<void> encode_section(const Module& module, const SectionLayout& section, BinaryWriter& writer) noexcept;
+        Result<void> encode_section_body(const Module& module, const SectionLayout& section, BinaryWriter& writer) noexcept;
+
+        // Splicing
+        Result<std::vector<SplicePiece>> plan_splice(span<const uint8_t> original, const Module& module,
+                                                     SectionSet modified) noexcept;
+        Result<void> encode_pieces(span<const uint8_t> original, const Module& module,
+                                   const std::vector<SplicePiece>& pieces, BinaryWriter& writer) noexcept;
+
+        // Internal encoding methods
         Result<void> encode_module(const Module& module, BinaryWriter& writer) noexcept;
         Result<void> encode_header(BinaryWriter& writer) noexcept;
-        Result<void> encode_sections(const Module& module, BinaryWriter& writer) noexcept;
+        Result<void> encode_sections(const Module& module, const std::vector<SectionLayout>& layout,
+                                     BinaryWriter& writer) noexcept;
 
         // Section-specific encoders
         Result<void> encode_type_section(const Module& module, BinaryWriter& writer) noexcept;
@@ -158,16 +367,23 @@ namespace flight::wasm {
         Result<void> encode_export_section(const Module& module, BinaryWriter& writer) noexcept;
         Result<void> encode_start_section(const Module& module, BinaryWriter& writer) noexcept;
         Result<void> encode_element_section(const Module& module, BinaryWriter& writer) noexcept;
+        Result<void> encode_data_count_section(const Module& module, BinaryWriter& writer) noexcept;
         Result<void> encode_code_section(const Module& module, BinaryWriter& writer) noexcept;
+        Result<void> encode_code_table(const CodeTable& table, BinaryWriter& writer) noexcept;
         Result<void> encode_data_section(const Module& module, BinaryWriter& writer) noexcept;
-        Result<void> encode_custom_sections(const Module& module, BinaryWriter& writer) noexcept;
+        Result<void> encode_custom_section(const Module& module, size_t index, BinaryWriter& writer) noexcept;
+
+        // Shared encodings
+        static void encode_limits(const Limits& limits, BinaryWriter& writer);
+        static size_t code_entry_size(const Function& function) noexcept;
     };
 
     /**
      * @brief Streaming binary encoder for large modules
-     * 
+     *
      * This encoder can handle very large WebAssembly modules by encoding
-     * sections on-demand to avoid memory usage spikes.
+     * sections on-demand to avoid memory usage spikes: at most one section
+     * is held in memory at a time.
      */
     class StreamingBinaryEncoder {
     public:
@@ -194,12 +410,837 @@ namespace flight::wasm {
 
     private:
         const Module* module_;
-        size_t current_section_ = 0;
-        size_t section_offset_ = 0;
+        size_t current_section_ = 0;   // 0 = header, n = layout_[n - 1]
+        size_t section_offset_ = 0;    // Bytes of pending_ already emitted
         size_t total_encoded_ = 0;
         bool complete_ = false;
+        bool planned_ = false;
+        std::vector<BinaryEncoder::SectionLayout> layout_;
+        std::vector<uint8_t> pending_;
     };
 
+    // =========================================================================
+    // Inline Implementation - BinaryWriter
+    // =========================================================================
+
+    inline BinaryWriter::BinaryWriter(WriteCallback sink, size_t staging_size)
+        : mode_(Mode::Sink), sink_(std::move(sink)), staging_size_(staging_size > 0 ? staging_size : 1) {
+        buffer_.reserve(staging_size_);
+    }
+
+    inline BinaryWriter BinaryWriter::counting() noexcept {
+        BinaryWriter writer;
+        writer.mode_ = Mode::Count;
+        return writer;
+    }
+
+    inline size_t BinaryWriter::position() const noexcept { return written_; }
+
+    inline size_t BinaryWriter::size() const noexcept { return written_; }
+
+    inline const std::vector<uint8_t>& BinaryWriter::data() const noexcept { return buffer_; }
+
+    inline std::vector<uint8_t> BinaryWriter::take() noexcept {
+        written_ = 0;
+        return std::move(buffer_);
+    }
+
+    inline void BinaryWriter::clear() noexcept {
+        buffer_.clear();
+        written_ = 0;
+        failed_ = false;
+    }
+
+    inline void BinaryWriter::reserve(size_t capacity) {
+        if (mode_ == Mode::Buffer) {
+            buffer_.reserve(capacity);
+        }
+    }
+
+    inline bool BinaryWriter::flush() {
+        if (mode_ == Mode::Sink && !buffer_.empty()) {
+            if (!failed_ && !sink_(span<const uint8_t>(buffer_))) {
+                failed_ = true;
+            }
+            buffer_.clear();
+        }
+        return !failed_;
+    }
+
+    inline bool BinaryWriter::failed() const noexcept { return failed_; }
+
+    inline void BinaryWriter::write_raw(const uint8_t* data, size_t size) {
+        written_ += size;
+        switch (mode_) {
+            case Mode::Buffer:
+                buffer_.insert(buffer_.end(), data, data + size);
+                break;
+            case Mode::Sink:
+                if (buffer_.size() + size > staging_size_) {
+                    flush();
+                }
+                if (size >= staging_size_) {
+                    // Large payloads (function bodies, data segments) skip the staging copy
+                    if (!failed_ && !sink_(span<const uint8_t>(data, size))) {
+                        failed_ = true;
+                    }
+                } else {
+                    buffer_.insert(buffer_.end(), data, data + size);
+                }
+                break;
+            case Mode::Count:
+                break;
+        }
+    }
+
+    inline void BinaryWriter::write_byte(uint8_t value) {
+        if (FLIGHT_WASM_LIKELY(mode_ == Mode::Buffer)) {
+            buffer_.push_back(value);
+            ++written_;
+            return;
+        }
+        write_raw(&value, 1);
+    }
+
+    inline void BinaryWriter::write_bytes(span<const uint8_t> data) {
+        write_raw(data.data(), data.size());
+    }
+
+    inline void BinaryWriter::write_u32(uint32_t value) {
+        value = endian::host_to_wasm(value);
+        uint8_t bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        write_raw(bytes, sizeof(bytes));
+    }
+
+    inline void BinaryWriter::write_u64(uint64_t value) {
+        value = endian::host_to_wasm(value);
+        uint8_t bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        write_raw(bytes, sizeof(bytes));
+    }
+
+    inline void BinaryWriter::write_f32(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        write_u32(bits);
+    }
+
+    inline void BinaryWriter::write_f64(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        write_u64(bits);
+    }
+
+    inline void BinaryWriter::write_leb128_u32(uint32_t value) {
+        write_leb128_u64(value);
+    }
+
+    inline void BinaryWriter::write_leb128_i32(int32_t value) {
+        write_leb128_i64(value);
+    }
+
+    inline void BinaryWriter::write_leb128_u64(uint64_t value) {
+        uint8_t bytes[10];
+        size_t length = 0;
+        do {
+            uint8_t byte = value & 0x7F;
+            value >>= 7;
+            if (value != 0) {
+                byte |= 0x80;
+            }
+            bytes[length++] = byte;
+        } while (value != 0);
+        write_raw(bytes, length);
+    }
+
+    inline void BinaryWriter::write_leb128_i64(int64_t value) {
+        uint8_t bytes[10];
+        size_t length = 0;
+        bool more = true;
+        while (more) {
+            uint8_t byte = value & 0x7F;
+            value >>= 7;  // Arithmetic shift on all supported compilers
+            if ((value == 0 && (byte & 0x40) == 0) || (value == -1 && (byte & 0x40) != 0)) {
+                more = false;
+            } else {
+                byte |= 0x80;
+            }
+            bytes[length++] = byte;
+        }
+        write_raw(bytes, length);
+    }
+
+    inline void BinaryWriter::write_string(std::string_view str) {
+        write_leb128_u32(static_cast<uint32_t>(str.size()));
+        write_raw(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+    }
+
+    // =========================================================================
+    // Inline Implementation - BinaryEncoder
+    // =========================================================================
+
+    inline Result<std::vector<uint8_t>> BinaryEncoder::encode(const Module& module) noexcept {
+        BinaryEncoder encoder;
+        auto layout = encoder.layout_sections(module);
+        if (!layout) {
+            return layout.error();
+        }
+
+        const size_t total = total_size(layout.value());
+        BinaryWriter writer;
+        writer.reserve(total);
+
+        auto header = encoder.encode_header(writer);
+        if (!header) {
+            return header.error();
+        }
+        auto sections = encoder.encode_sections(module, layout.value(), writer);
+        if (!sections) {
+            return sections.error();
+        }
+        if (writer.size() != total) {
+            return Result<std::vector<uint8_t>>{ErrorCode::InvalidModule, "Encoded size differs from sizing pass"};
+        }
+        return Result<std::vector<uint8_t>>{writer.take()};
+    }
+
+    inline Result<size_t> BinaryEncoder::encode_to(const Module& module, const WriteCallback& sink) noexcept {
+        BinaryWriter writer(sink);
+        BinaryEncoder encoder;
+        auto encoded = encoder.encode_module(module, writer);
+        if (!encoded) {
+            return encoded.error();
+        }
+        if (!writer.flush()) {
+            return Result<size_t>{ErrorCode::FileWriteFailed, "Output sink rejected data"};
+        }
+        return Result<size_t>{writer.size()};
+    }
+
+    inline Result<void> BinaryEncoder::encode_to_file(const Module& module, const std::string& filename) noexcept {
+        std::FILE* file = std::fopen(filename.c_str(), "wb");
+        if (file == nullptr) {
+            return Result<void>{ErrorCode::FileOpenFailed, "Failed to open output file"};
+        }
+
+        auto written = encode_to(module, [file](span<const uint8_t> chunk) {
+            return std::fwrite(chunk.data(), 1, chunk.size(), file) == chunk.size();
+        });
+        const bool closed = std::fclose(file) == 0;
+        if (!written) {
+            return written.error();
+        }
+        if (!closed) {
+            return Result<void>{ErrorCode::FileWriteFailed, "Failed to close output file"};
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<size_t> BinaryEncoder::calculate_size(const Module& module) noexcept {
+        BinaryEncoder encoder;
+        auto layout = encoder.layout_sections(module);
+        if (!layout) {
+            return layout.error();
+        }
+        return Result<size_t>{total_size(layout.value())};
+    }
+
+    inline Result<std::vector<uint8_t>> BinaryEncoder::splice(span<const uint8_t> original, const Module& module,
+                                                              SectionSet modified) noexcept {
+        BinaryEncoder encoder;
+        auto pieces = encoder.plan_splice(original, module, modified);
+        if (!pieces) {
+            return pieces.error();
+        }
+
+        size_t total = 0;
+        for (const auto& piece : pieces.value()) {
+            total += piece.encoded_size();
+        }
+        BinaryWriter writer;
+        writer.reserve(total);
+
+        auto encoded = encoder.encode_pieces(original, module, pieces.value(), writer);
+        if (!encoded) {
+            return encoded.error();
+        }
+        if (writer.size() != total) {
+            return Result<std::vector<uint8_t>>{ErrorCode::InvalidModule, "Encoded size differs from sizing pass"};
+        }
+        return Result<std::vector<uint8_t>>{writer.take()};
+    }
+
+    inline Result<size_t> BinaryEncoder::splice_to(span<const uint8_t> original, const Module& module,
+                                                   SectionSet modified, const WriteCallback& sink) noexcept {
+        BinaryEncoder encoder;
+        auto pieces = encoder.plan_splice(original, module, modified);
+        if (!pieces) {
+            return pieces.error();
+        }
+
+        BinaryWriter writer(sink);
+        auto encoded = encoder.encode_pieces(original, module, pieces.value(), writer);
+        if (!encoded) {
+            return encoded.error();
+        }
+        if (!writer.flush()) {
+            return Result<size_t>{ErrorCode::FileWriteFailed, "Output sink rejected data"};
+        }
+        return Result<size_t>{writer.size()};
+    }
+
+    inline Result<std::vector<BinaryEncoder::SplicePiece>> BinaryEncoder::plan_splice(
+        span<const uint8_t> original, const Module& module, SectionSet modified) noexcept {
+        auto sections = StreamingBinaryParser::get_section_info(original);
+        if (!sections) {
+            return sections.error();
+        }
+        if ((modified.contains(SectionId::Function) || modified.contains(SectionId::Code)) &&
+            module.defined_function_count() != module.function_type_indices.size()) {
+            return Result<std::vector<SplicePiece>>{ErrorCode::InvalidModule,
+                                                    "Function and code section counts differ"};
+        }
+
+        bool in_original[13] = {};
+        for (const auto& info : sections.value()) {
+            in_original[info.id] = true;
+        }
+
+        std::vector<SplicePiece> pieces;
+        pieces.reserve(sections.value().size() + 13);
+
+        auto copy = [&pieces](size_t offset, size_t length) {
+            // Adjacent unchanged sections collapse into a single memcpy
+            if (!pieces.empty() && pieces.back().copy &&
+                pieces.back().offset + pieces.back().length == offset) {
+                pieces.back().length += length;
+            } else {
+                pieces.push_back(SplicePiece{true, offset, length, SectionLayout{0, 0, 0}});
+            }
+        };
+        auto reencode = [&](SectionId id, size_t custom_index) -> Result<void> {
+            SectionLayout section{static_cast<uint8_t>(id), custom_index, 0};
+            auto sized = measure_section(module, section);
+            if (!sized) {
+                return sized;
+            }
+            pieces.push_back(SplicePiece{false, 0, 0, section});
+            return Result<void>{Error{}};
+        };
+
+        // Modified sections absent from the input are inserted before the
+        // first input section that follows them in binary order
+        size_t next_standard = 0;
+        auto insert_new_before = [&](uint8_t order) -> Result<void> {
+            constexpr size_t standard_count = sizeof(detail::standard_section_order) / sizeof(SectionId);
+            for (; next_standard < standard_count; ++next_standard) {
+                SectionId id = detail::standard_section_order[next_standard];
+                if (detail::section_order(static_cast<uint8_t>(id)) >= order) {
+                    break;
+                }
+                if (modified.contains(id) && !in_original[static_cast<uint8_t>(id)] && has_section(module, id)) {
+                    auto encoded = reencode(id, 0);
+                    if (!encoded) {
+                        return encoded;
+                    }
+                }
+            }
+            return Result<void>{Error{}};
+        };
+
+        copy(0, binary_constants::HEADER_SIZE);
+        size_t custom_index = 0;
+        for (const auto& info : sections.value()) {
+            auto id = static_cast<SectionId>(info.id);
+            if (id == SectionId::Custom) {
+                if (!modified.contains(SectionId::Custom)) {
+                    copy(info.header_offset, info.encoded_size());
+                } else if (custom_index < module.custom_sections.size()) {
+                    auto encoded = reencode(SectionId::Custom, custom_index++);
+                    if (!encoded) {
+                        return encoded.error();
+                    }
+                }
+                continue;
+            }
+
+            auto inserted = insert_new_before(detail::section_order(info.id));
+            if (!inserted) {
+                return inserted.error();
+            }
+            if (!modified.contains(id)) {
+                copy(info.header_offset, info.encoded_size());
+            } else if (has_section(module, id)) {
+                auto encoded = reencode(id, 0);
+                if (!encoded) {
+                    return encoded.error();
+                }
+            }
+        }
+
+        auto inserted = insert_new_before(UINT8_MAX);
+        if (!inserted) {
+            return inserted.error();
+        }
+        if (modified.contains(SectionId::Custom)) {
+            for (; custom_index < module.custom_sections.size(); ++custom_index) {
+                auto encoded = reencode(SectionId::Custom, custom_index);
+                if (!encoded) {
+                    return encoded.error();
+                }
+            }
+        }
+        return Result<std::vector<SplicePiece>>{std::move(pieces)};
+    }
+
+    inline Result<void> BinaryEncoder::encode_pieces(span<const uint8_t> original, const Module& module,
+                                                     const std::vector<SplicePiece>& pieces,
+                                                     BinaryWriter& writer) noexcept {
+        for (const auto& piece : pieces) {
+            if (piece.copy) {
+                writer.write_bytes(original.subspan(piece.offset, piece.length));
+            } else {
+                auto encoded = encode_section(module, piece.section, writer);
+                if (!encoded) {
+                    return encoded;
+                }
+            }
+            if (writer.failed()) {
+                return Result<void>{ErrorCode::FileWriteFailed, "Output sink rejected data"};
+            }
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<std::vector<BinaryEncoder::SectionLayout>> BinaryEncoder::layout_sections(const Module& module) noexcept {
+        if (module.defined_function_count() != module.function_type_indices.size()) {
+            return Result<std::vector<SectionLayout>>{ErrorCode::InvalidModule,
+                                                      "Function and code section counts differ"};
+        }
+
+        // Standard sections in binary order; empty ones are omitted
+        std::vector<SectionLayout> layout;
+        layout.reserve(12 + module.custom_sections.size());
+        for (SectionId id : detail::standard_section_order) {
+            if (has_section(module, id)) {
+                layout.push_back(SectionLayout{static_cast<uint8_t>(id), 0, 0});
+            }
+        }
+        for (size_t i = 0; i < module.custom_sections.size(); ++i) {
+            layout.push_back(SectionLayout{static_cast<uint8_t>(SectionId::Custom), i, 0});
+        }
+
+        for (auto& section : layout) {
+            auto sized = measure_section(module, section);
+            if (!sized) {
+                return sized.error();
+            }
+        }
+        return Result<std::vector<SectionLayout>>{std::move(layout)};
+    }
+
+    inline Result<void> BinaryEncoder::measure_section(const Module& module, SectionLayout& section) noexcept {
+        BinaryWriter counter = BinaryWriter::counting();
+        auto sized = encode_section_body(module, section, counter);
+        if (!sized) {
+            return sized;
+        }
+        if (counter.size() > UINT32_MAX) {
+            return Result<void>{ErrorCode::SectionTooLarge, "Section exceeds 4 GiB"};
+        }
+        section.body_size = counter.size();
+        return Result<void>{Error{}};
+    }
+
+    inline bool BinaryEncoder::has_section(const Module& module, SectionId id) noexcept {
+        switch (id) {
+            case SectionId::Custom:    return !module.custom_sections.empty();
+            case SectionId::Type:      return !module.types.empty();
+            case SectionId::Import:    return !module.imports.empty();
+            case SectionId::Function:  return !module.function_type_indices.empty();
+            case SectionId::Table:     return !module.tables.empty();
+            case SectionId::Memory:    return !module.memories.empty();
+            case SectionId::Global:    return !module.globals.empty();
+            case SectionId::Export:    return !module.exports.empty();
+            case SectionId::Start:     return module.has_start_function;
+            case SectionId::Element:   return !module.elements.empty();
+            case SectionId::Code:      return module.defined_function_count() != 0;
+            case SectionId::Data:      return !module.data.empty();
+            case SectionId::DataCount: return module.has_data_count;
+        }
+        return false;
+    }
+
+    inline size_t BinaryEncoder::total_size(const std::vector<SectionLayout>& layout) noexcept {
+        size_t total = binary_constants::HEADER_SIZE;
+        for (const auto& section : layout) {
+            total += section.encoded_size();
+        }
+        return total;
+    }
+
+    inline Result<void> BinaryEncoder::encode_section(const Module& module, const SectionLayout& section,
+                                                      BinaryWriter& writer) noexcept {
+        writer.write_byte(section.id);
+        writer.write_leb128_u32(static_cast<uint32_t>(section.body_size));
+        return encode_section_body(module, section, writer);
+    }
+
+    inline Result<void> BinaryEncoder::encode_section_body(const Module& module, const SectionLayout& section,
+                                                           BinaryWriter& writer) noexcept {
+        switch (static_cast<SectionId>(section.id)) {
+            case SectionId::Custom:    return encode_custom_section(module, section.custom_index, writer);
+            case SectionId::Type:      return encode_type_section(module, writer);
+            case SectionId::Import:    return encode_import_section(module, writer);
+            case SectionId::Function:  return encode_function_section(module, writer);
+            case SectionId::Table:     return encode_table_section(module, writer);
+            case SectionId::Memory:    return encode_memory_section(module, writer);
+            case SectionId::Global:    return encode_global_section(module, writer);
+            case SectionId::Export:    return encode_export_section(module, writer);
+            case SectionId::Start:     return encode_start_section(module, writer);
+            case SectionId::Element:   return encode_element_section(module, writer);
+            case SectionId::Code:      return encode_code_section(module, writer);
+            case SectionId::Data:      return encode_data_section(module, writer);
+            case SectionId::DataCount: return encode_data_count_section(module, writer);
+        }
+        return Result<void>{ErrorCode::InvalidSectionId, "Unknown section id"};
+    }
+
+    inline Result<void> BinaryEncoder::encode_module(const Module& module, BinaryWriter& writer) noexcept {
+        auto layout = layout_sections(module);
+        if (!layout) {
+            return layout.error();
+        }
+        auto header = encode_header(writer);
+        if (!header) {
+            return header;
+        }
+        return encode_sections(module, layout.value(), writer);
+    }
+
+    inline Result<void> BinaryEncoder::encode_header(BinaryWriter& writer) noexcept {
+        writer.write_u32(binary_constants::WASM_MAGIC);
+        writer.write_u32(binary_constants::WASM_VERSION);
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_sections(const Module& module, const std::vector<SectionLayout>& layout,
+                                                       BinaryWriter& writer) noexcept {
+        for (const auto& section : layout) {
+            auto encoded = encode_section(module, section, writer);
+            if (!encoded) {
+                return encoded;
+            }
+            if (writer.failed()) {
+                return Result<void>{ErrorCode::FileWriteFailed, "Output sink rejected data"};
+            }
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline void BinaryEncoder::encode_limits(const Limits& limits, BinaryWriter& writer) {
+        writer.write_byte(limits.has_max ? 0x01 : 0x00);
+        writer.write_leb128_u32(limits.min);
+        if (limits.has_max) {
+            writer.write_leb128_u32(limits.max);
+        }
+    }
+
+    inline size_t BinaryEncoder::code_entry_size(const Function& function) noexcept {
+        size_t groups = 0;
+        size_t size = 0;
+        for (size_t i = 0; i < function.locals.size();) {
+            size_t run = 1;
+            while (i + run < function.locals.size() && function.locals[i + run] == function.locals[i]) {
+                ++run;
+            }
+            size += BinaryWriter::leb128_u32_size(static_cast<uint32_t>(run)) + 1;
+            ++groups;
+            i += run;
+        }
+        return BinaryWriter::leb128_u32_size(static_cast<uint32_t>(groups)) + size + function.body().size();
+    }
+
+    inline Result<void> BinaryEncoder::encode_type_section(const Module& module, BinaryWriter& writer) noexcept {
+        writer.write_leb128_u32(static_cast<uint32_t>(module.types.size()));
+        for (const auto& type : module.types) {
+            writer.write_byte(0x60);
+            for (const auto* list : {&type.params, &type.results}) {
+                writer.write_leb128_u32(static_cast<uint32_t>(list->size()));
+                for (ValueType value_type : *list) {
+                    writer.write_byte(encode_value_type(value_type));
+                }
+            }
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_import_section(const Module& module, BinaryWriter& writer) noexcept {
+        writer.write_leb128_u32(static_cast<uint32_t>(module.imports.size()));
+        for (const auto& import : module.imports) {
+            writer.write_string(import.module_name);
+            writer.write_string(import.field_name);
+            writer.write_byte(static_cast<uint8_t>(import.kind));
+            switch (import.kind) {
+                case Import::Kind::Function:
+                    writer.write_leb128_u32(import.descriptor.function_type_index);
+                    break;
+                case Import::Kind::Table:
+                    writer.write_byte(encode_value_type(import.descriptor.table_type.element_type));
+                    encode_limits(import.descriptor.table_type.limits, writer);
+                    break;
+                case Import::Kind::Memory:
+                    encode_limits(import.descriptor.memory_type.limits, writer);
+                    break;
+                case Import::Kind::Global:
+                    writer.write_byte(encode_value_type(import.descriptor.global_type.value_type));
+                    writer.write_byte(import.descriptor.global_type.is_mutable ? 0x01 : 0x00);
+                    break;
+                default:
+                    return Result<void>{ErrorCode::InvalidModule, "Invalid import kind"};
+            }
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_function_section(const Module& module, BinaryWriter& writer) noexcept {
+        writer.write_leb128_u32(static_cast<uint32_t>(module.function_type_indices.size()));
+        for (uint32_t type_index : module.function_type_indices) {
+            writer.write_leb128_u32(type_index);
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_table_section(const Module& module, BinaryWriter& writer) noexcept {
+        writer.write_leb128_u32(static_cast<uint32_t>(module.tables.size()));
+        for (const auto& table : module.tables) {
+            writer.write_byte(encode_value_type(table.element_type));
+            encode_limits(table.limits, writer);
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_memory_section(const Module& module, BinaryWriter& writer) noexcept {
+        writer.write_leb128_u32(static_cast<uint32_t>(module.memories.size()));
+        for (const auto& memory : module.memories) {
+            encode_limits(memory.limits, writer);
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_global_section(const Module& module, BinaryWriter& writer) noexcept {
+        writer.write_leb128_u32(static_cast<uint32_t>(module.globals.size()));
+        for (const auto& global : module.globals) {
+            writer.write_byte(encode_value_type(global.type.value_type));
+            writer.write_byte(global.type.is_mutable ? 0x01 : 0x00);
+            writer.write_bytes(global.initializer_bytes);
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_export_section(const Module& module, BinaryWriter& writer) noexcept {
+        writer.write_leb128_u32(static_cast<uint32_t>(module.exports.size()));
+        for (const auto& export_desc : module.exports) {
+            writer.write_string(export_desc.name);
+            writer.write_byte(static_cast<uint8_t>(export_desc.kind));
+            writer.write_leb128_u32(export_desc.index);
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_start_section(const Module& module, BinaryWriter& writer) noexcept {
+        writer.write_leb128_u32(module.start_function_index);
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_element_section(const Module& module, BinaryWriter& writer) noexcept {
+        writer.write_leb128_u32(static_cast<uint32_t>(module.elements.size()));
+        for (const auto& element : module.elements) {
+            // Always use the function-index forms (flags 0-3)
+            switch (element.mode) {
+                case Element::Mode::Active:
+                    if (element.table_index == 0 && element.element_type == ValueType::FuncRef) {
+                        writer.write_leb128_u32(0);
+                        writer.write_bytes(element.offset_bytes);
+                    } else {
+                        writer.write_leb128_u32(2);
+                        writer.write_leb128_u32(element.table_index);
+                        writer.write_bytes(element.offset_bytes);
+                        writer.write_byte(0x00);
+                    }
+                    break;
+                case Element::Mode::Passive:
+                    writer.write_leb128_u32(1);
+                    writer.write_byte(0x00);
+                    break;
+                case Element::Mode::Declarative:
+                    writer.write_leb128_u32(3);
+                    writer.write_byte(0x00);
+                    break;
+                default:
+                    return Result<void>{ErrorCode::InvalidModule, "Invalid element segment mode"};
+            }
+            writer.write_leb128_u32(static_cast<uint32_t>(element.function_indices.size()));
+            for (uint32_t function_index : element.function_indices) {
+                writer.write_leb128_u32(function_index);
+            }
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_data_count_section(const Module& module, BinaryWriter& writer) noexcept {
+        writer.write_leb128_u32(module.data_count);
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_code_section(const Module& module, BinaryWriter& writer) noexcept {
+        if (module.functions.empty()) {
+            return encode_code_table(module.code_table, writer);
+        }
+
+        writer.write_leb128_u32(static_cast<uint32_t>(module.functions.size()));
+        for (const auto& function : module.functions) {
+            writer.write_leb128_u32(static_cast<uint32_t>(code_entry_size(function)));
+
+            // Locals are stored expanded; re-compress consecutive runs
+            size_t groups = 0;
+            for (size_t i = 0; i < function.locals.size(); ++groups) {
+                size_t run = 1;
+                while (i + run < function.locals.size() && function.locals[i + run] == function.locals[i]) {
+                    ++run;
+                }
+                i += run;
+            }
+            writer.write_leb128_u32(static_cast<uint32_t>(groups));
+            for (size_t i = 0; i < function.locals.size();) {
+                size_t run = 1;
+                while (i + run < function.locals.size() && function.locals[i + run] == function.locals[i]) {
+                    ++run;
+                }
+                writer.write_leb128_u32(static_cast<uint32_t>(run));
+                writer.write_byte(encode_value_type(function.locals[i]));
+                i += run;
+            }
+            writer.write_bytes(function.body());
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_code_table(const CodeTable& table, BinaryWriter& writer) noexcept {
+        writer.write_leb128_u32(static_cast<uint32_t>(table.size()));
+        for (size_t i = 0; i < table.size(); ++i) {
+            // Local groups are already run-length encoded; emit them as stored
+            span<const LocalGroup> locals = table.locals(i);
+            span<const uint8_t> body = table.body(i);
+            size_t entry_size = BinaryWriter::leb128_u32_size(static_cast<uint32_t>(locals.size())) + body.size();
+            for (const auto& group : locals) {
+                entry_size += BinaryWriter::leb128_u32_size(group.count) + 1;
+            }
+
+            writer.write_leb128_u32(static_cast<uint32_t>(entry_size));
+            writer.write_leb128_u32(static_cast<uint32_t>(locals.size()));
+            for (const auto& group : locals) {
+                writer.write_leb128_u32(group.count);
+                writer.write_byte(encode_value_type(group.type));
+            }
+            writer.write_bytes(body);
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_data_section(const Module& module, BinaryWriter& writer) noexcept {
+        writer.write_leb128_u32(static_cast<uint32_t>(module.data.size()));
+        for (const auto& segment : module.data) {
+            switch (segment.mode) {
+                case Data::Mode::Active:
+                    if (segment.memory_index == 0) {
+                        writer.write_leb128_u32(0);
+                    } else {
+                        writer.write_leb128_u32(2);
+                        writer.write_leb128_u32(segment.memory_index);
+                    }
+                    writer.write_bytes(segment.offset_bytes);
+                    break;
+                case Data::Mode::Passive:
+                    writer.write_leb128_u32(1);
+                    break;
+                default:
+                    return Result<void>{ErrorCode::InvalidModule, "Invalid data segment mode"};
+            }
+            span<const uint8_t> payload = segment.bytes();
+            writer.write_leb128_u32(static_cast<uint32_t>(payload.size()));
+            writer.write_bytes(payload);
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryEncoder::encode_custom_section(const Module& module, size_t index,
+                                                             BinaryWriter& writer) noexcept {
+        const auto& [name, contents] = module.custom_sections[index];
+        writer.write_string(name);
+        writer.write_bytes(contents);
+        return Result<void>{Error{}};
+    }
+
+    // =========================================================================
+    // Inline Implementation - StreamingBinaryEncoder
+    // =========================================================================
+
+    inline StreamingBinaryEncoder::StreamingBinaryEncoder(const Module& module) : module_(&module) {}
+
+    inline Result<std::vector<uint8_t>> StreamingBinaryEncoder::encode_chunk(size_t max_chunk_size) noexcept {
+        if (complete_) {
+            return Result<std::vector<uint8_t>>{std::vector<uint8_t>()};
+        }
+
+        BinaryEncoder encoder;
+        if (!planned_) {
+            auto layout = encoder.layout_sections(*module_);
+            if (!layout) {
+                return layout.error();
+            }
+            layout_ = std::move(layout).value();
+            planned_ = true;
+        }
+
+        // Materialize the next section once the previous one is fully emitted
+        if (section_offset_ == pending_.size()) {
+            if (current_section_ > layout_.size()) {
+                complete_ = true;
+                pending_ = std::vector<uint8_t>();
+                return Result<std::vector<uint8_t>>{std::vector<uint8_t>()};
+            }
+
+            BinaryWriter writer;
+            if (current_section_ == 0) {
+                writer.reserve(binary_constants::HEADER_SIZE);
+                encoder.encode_header(writer);
+            } else {
+                const auto& section = layout_[current_section_ - 1];
+                writer.reserve(section.encoded_size());
+                auto encoded = encoder.encode_section(*module_, section, writer);
+                if (!encoded) {
+                    return encoded.error();
+                }
+            }
+            pending_ = writer.take();
+            section_offset_ = 0;
+            ++current_section_;
+        }
+
+        const size_t length = std::min(max_chunk_size > 0 ? max_chunk_size : 1, pending_.size() - section_offset_);
+        std::vector<uint8_t> chunk(pending_.begin() + static_cast<std::ptrdiff_t>(section_offset_),
+                                   pending_.begin() + static_cast<std::ptrdiff_t>(section_offset_ + length));
+        section_offset_ += length;
+        total_encoded_ += length;
+        return Result<std::vector<uint8_t>>{std::move(chunk)};
+    }
+
+    inline bool StreamingBinaryEncoder::is_complete() const noexcept { return complete_; }
+
+    inline size_t StreamingBinaryEncoder::encoded_size() const noexcept { return total_encoded_; }
+
 } // namespace flight::wasm
 
 #endif // FLIGHT_WASM_BINARY_ENCODER_HPP
@@ -5,22 +5,31 @@
  * @file parser.hpp
  * @brief WebAssembly binary format parsing functionality
  * 
- * This header provides forward declarations and basic structure for parsing
- * WebAssembly binary format files. Full implementation will be completed in
- * the binary format parsing tasks.
+ * This header provides the low-level BinaryReader and the BinaryParser that
+ * decodes a WebAssembly 1.0 binary (plus bulk-memory element/data segment
+ * forms and the data count section) into a Module. Files are loaded through
+ * a read-only memory mapping and can be parsed zero-copy, in which case
+ * function bodies and data segment payloads borrow from the mapping.
  */
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <flight/wasm/utilities/error.hpp>
+#include <flight/wasm/utilities/endian.hpp>
+#include <flight/wasm/utilities/mapped_file.hpp>
+#include <flight/wasm/utilities/span.hpp>
+#include <flight/wasm/types/values.hpp>
+#include <flight/wasm/types/modules.hpp>
 
 namespace flight::wasm {
 
-    // Forward declarations
-    class Module;
-    class Error;
-    template<typename T> class Result;
-
     /**
      * @brief WebAssembly binary format constants
      */
@@ -30,31 +39,9 @@ namespace flight::wasm {
         constexpr size_t MAGIC_SIZE = 4;
         constexpr size_t VERSION_SIZE = 4;
         constexpr size_t HEADER_SIZE = MAGIC_SIZE + VERSION_SIZE;
+        constexpr size_t MAX_FUNCTION_LOCALS = 50000;  // Implementation limit
     }
 
-    /**
-     * @brief Simple span-like view for C++17 compatibility
-     */
-    template<typename T>
-    class span {
-    public:
-        constexpr span() noexcept : data_(nullptr), size_(0) {}
-        constexpr span(T* data, size_t size) noexcept : data_(data), size_(size) {}
-        constexpr span(const std::vector<T>& vec) noexcept : data_(vec.data()), size_(vec.size()) {}
-        
-        constexpr T* data() const noexcept { return data_; }
-        constexpr size_t size() const noexcept { return size_; }
-        constexpr bool empty() const noexcept { return size_ == 0; }
-        
-        constexpr T& operator[](size_t index) const noexcept { return data_[index]; }
-        constexpr T* begin() const noexcept { return data_; }
-        constexpr T* end() const noexcept { return data_ + size_; }
-        
-    private:
-        T* data_;
-        size_t size_;
-    };
-
     /**
      * @brief Binary reader for parsing WebAssembly binary format
      * 
@@ -88,6 +75,11 @@ namespace flight::wasm {
          */
         size_t remaining() const noexcept;
 
+        /**
+         * @brief Get the underlying data
+         */
+        span<const uint8_t> data() const noexcept { return data_; }
+
         /**
          * @brief Peek at the next byte without consuming it
          */
@@ -103,6 +95,13 @@ namespace flight::wasm {
          */
         Result<std::vector<uint8_t>> read_bytes(size_t count) noexcept;
 
+        /**
+         * @brief Borrow multiple bytes without copying
+         * 
+         * The returned view aliases the reader's underlying data.
+         */
+        Result<span<const uint8_t>> read_view(size_t count) noexcept;
+
         /**
          * @brief Read a 32-bit unsigned integer (little-endian)
          */
@@ -148,6 +147,11 @@ namespace flight::wasm {
          */
         Result<std::string> read_string() noexcept;
 
+        /**
+         * @brief Read a UTF-8 name as a view into the input
+         */
+        Result<std::string_view> read_name() noexcept;
+
         /**
          * @brief Skip bytes
          */
@@ -159,6 +163,9 @@ namespace flight::wasm {
         Result<void> seek(size_t position) noexcept;
 
     private:
+        template<typename T> Result<T> read_unsigned_leb128() noexcept;
+        template<typename T> Result<T> read_signed_leb128() noexcept;
+
         span<const uint8_t> data_;
         size_t position_ = 0;
     };
@@ -170,16 +177,53 @@ namespace flight::wasm {
      */
     class BinaryParser {
     public:
+        /**
+         * @brief Parsing options
+         */
+        struct ParseOptions {
+            /**
+             * @brief Borrow function bodies and data segment payloads
+             * 
+             * When set, Function::body_view and Data::data_view alias the
+             * input instead of being copied; the caller must keep the input
+             * alive for as long as the module (see Module::backing_store).
+             */
+            bool zero_copy = false;
+
+            /**
+             * @brief Decode the code section into Module::code_table
+             * 
+             * Functions are stored flat (one local arena, one code buffer and
+             * offset tables) instead of as one Function object each;
+             * Module::functions is left empty.
+             */
+            bool compact_code = false;
+        };
+
         /**
          * @brief Parse a WebAssembly binary module
          */
         static Result<Module> parse(span<const uint8_t> data) noexcept;
 
+        /**
+         * @brief Parse a WebAssembly binary module with explicit options
+         */
+        static Result<Module> parse(span<const uint8_t> data, const ParseOptions& options) noexcept;
+
         /**
          * @brief Parse a WebAssembly binary module from a file
+         * 
+         * The file is memory-mapped read-only with sequential read-ahead and
+         * parsed zero-copy; the mapping is kept alive by the returned
+         * module's backing_store.
          */
         static Result<Module> parse_file(const std::string& filename) noexcept;
 
+        /**
+         * @brief Parse a module file with explicit paging hints
+         */
+        static Result<Module> parse_file(const std::string& filename, const MappingOptions& mapping) noexcept;
+
         /**
          * @brief Validate WebAssembly binary format without full parsing
          */
@@ -191,6 +235,8 @@ namespace flight::wasm {
         static bool is_wasm_binary(span<const uint8_t> data) noexcept;
 
     private:
+        friend class StreamingBinaryParser;
+
         BinaryParser() = default;
 
         // Internal parsing methods (to be implemented)
@@ -198,6 +244,7 @@ namespace flight::wasm {
         Result<void> parse_header(BinaryReader& reader) noexcept;
         Result<void> parse_sections(BinaryReader& reader, Module& module) noexcept;
         Result<void> parse_section(BinaryReader& reader, Module& module) noexcept;
+        Result<void> parse_section_contents(uint8_t id, span<const uint8_t> contents, Module& module) noexcept;
 
         // Section-specific parsers
         Result<void> parse_type_section(BinaryReader& reader, Module& module) noexcept;
@@ -210,8 +257,23 @@ namespace flight::wasm {
         Result<void> parse_start_section(BinaryReader& reader, Module& module) noexcept;
         Result<void> parse_element_section(BinaryReader& reader, Module& module) noexcept;
         Result<void> parse_code_section(BinaryReader& reader, Module& module) noexcept;
+        Result<void> parse_compact_code_section(BinaryReader& reader, Module& module, uint32_t count) noexcept;
         Result<void> parse_data_section(BinaryReader& reader, Module& module) noexcept;
+        Result<void> parse_data_count_section(BinaryReader& reader, Module& module) noexcept;
         Result<void> parse_custom_section(BinaryReader& reader, Module& module) noexcept;
+
+        // Shared encodings
+        Result<ValueType> parse_value_type(BinaryReader& reader) noexcept;
+        Result<ValueType> parse_reference_type(BinaryReader& reader) noexcept;
+        Result<Limits> parse_limits(BinaryReader& reader) noexcept;
+        Result<GlobalType> parse_global_type(BinaryReader& reader) noexcept;
+        Result<std::vector<uint8_t>> parse_constant_expression(BinaryReader& reader) noexcept;
+        Result<span<const uint8_t>> parse_payload(BinaryReader& reader, size_t size,
+                                                  std::vector<uint8_t>& owned) noexcept;
+        Result<std::string_view> parse_name(BinaryReader& reader, Module& module) noexcept;
+
+        ParseOptions options_;
+        uint8_t last_section_order_ = 0;
     };
 
     /**
@@ -229,12 +291,21 @@ namespace flight::wasm {
 
         /**
          * @brief Get information about sections without parsing content
+         *
+         * The complete encoded section (id byte, size prefix and contents)
+         * spans [header_offset, offset + size) of the input.
          */
         struct SectionInfo {
             uint8_t id;
-            size_t offset;
-            size_t size;
-            std::string name; // For custom sections
+            size_t offset;        // Start of the section contents
+            size_t size;          // Size of the section contents
+            std::string name;     // For custom sections
+            size_t header_offset; // Start of the section id byte
+
+            /**
+             * @brief Size of the complete encoded section
+             */
+            size_t encoded_size() const noexcept { return offset + size - header_offset; }
         };
 
         static Result<std::vector<SectionInfo>> get_section_info(span<const uint8_t> data) noexcept;
@@ -245,6 +316,1185 @@ namespace flight::wasm {
         static Result<void> parse_section_at(span<const uint8_t> data, size_t section_index, Module& module) noexcept;
     };
 
+    // =========================================================================
+    // Inline Implementation - Helpers
+    // =========================================================================
+
+    namespace detail {
+
+        /**
+         * @brief Validate a UTF-8 byte sequence (rejects overlongs and surrogates)
+         */
+        inline bool is_valid_utf8(const uint8_t* data, size_t size) noexcept {
+            size_t i = 0;
+            while (i < size) {
+                uint8_t lead = data[i];
+                if (lead < 0x80) {
+                    ++i;
+                    continue;
+                }
+
+                size_t length;
+                uint32_t min_code_point;
+                uint32_t code_point;
+                if ((lead & 0xE0) == 0xC0) {
+                    length = 2; min_code_point = 0x80; code_point = lead & 0x1F;
+                } else if ((lead & 0xF0) == 0xE0) {
+                    length = 3; min_code_point = 0x800; code_point = lead & 0x0F;
+                } else if ((lead & 0xF8) == 0xF0) {
+                    length = 4; min_code_point = 0x10000; code_point = lead & 0x07;
+                } else {
+                    return false;
+                }
+
+                if (size - i < length) {
+                    return false;
+                }
+                for (size_t k = 1; k < length; ++k) {
+                    uint8_t cont = data[i + k];
+                    if ((cont & 0xC0) != 0x80) {
+                        return false;
+                    }
+                    code_point = (code_point << 6) | (cont & 0x3F);
+                }
+
+                if (code_point < min_code_point || code_point > 0x10FFFF ||
+                    (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+                    return false;
+                }
+                i += length;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Relative order of non-custom sections (DataCount sits between Element and Code)
+         */
+        constexpr uint8_t section_order(uint8_t id) noexcept {
+            switch (static_cast<SectionId>(id)) {
+                case SectionId::Type:      return 1;
+                case SectionId::Import:    return 2;
+                case SectionId::Function:  return 3;
+                case SectionId::Table:     return 4;
+                case SectionId::Memory:    return 5;
+                case SectionId::Global:    return 6;
+                case SectionId::Export:    return 7;
+                case SectionId::Start:     return 8;
+                case SectionId::Element:   return 9;
+                case SectionId::DataCount: return 10;
+                case SectionId::Code:      return 11;
+                case SectionId::Data:      return 12;
+                default:                   return 0;
+            }
+        }
+
+    } // namespace detail
+
+    // =========================================================================
+    // Inline Implementation - BinaryReader
+    // =========================================================================
+
+    inline BinaryReader::BinaryReader(span<const uint8_t> data) noexcept : data_(data) {}
+
+    inline bool BinaryReader::has_data() const noexcept { return position_ < data_.size(); }
+
+    inline size_t BinaryReader::position() const noexcept { return position_; }
+
+    inline size_t BinaryReader::size() const noexcept { return data_.size(); }
+
+    inline size_t BinaryReader::remaining() const noexcept { return data_.size() - position_; }
+
+    inline Result<uint8_t> BinaryReader::peek_byte() const noexcept {
+        if (FLIGHT_WASM_UNLIKELY(position_ >= data_.size())) {
+            return Result<uint8_t>{ErrorCode::UnexpectedEndOfFile, "Unexpected end of data"};
+        }
+        return Result<uint8_t>{data_[position_]};
+    }
+
+    inline Result<uint8_t> BinaryReader::read_byte() noexcept {
+        if (FLIGHT_WASM_UNLIKELY(position_ >= data_.size())) {
+            return Result<uint8_t>{ErrorCode::UnexpectedEndOfFile, "Unexpected end of data"};
+        }
+        return Result<uint8_t>{data_[position_++]};
+    }
+
+    inline Result<std::vector<uint8_t>> BinaryReader::read_bytes(size_t count) noexcept {
+        auto view = read_view(count);
+        if (!view) {
+            return view.error();
+        }
+        return Result<std::vector<uint8_t>>{std::vector<uint8_t>(view->begin(), view->end())};
+    }
+
+    inline Result<span<const uint8_t>> BinaryReader::read_view(size_t count) noexcept {
+        if (FLIGHT_WASM_UNLIKELY(count > remaining())) {
+            return Result<span<const uint8_t>>{ErrorCode::UnexpectedEndOfFile, "Unexpected end of data"};
+        }
+        span<const uint8_t> view = data_.subspan(position_, count);
+        position_ += count;
+        return Result<span<const uint8_t>>{view};
+    }
+
+    inline Result<uint32_t> BinaryReader::read_u32() noexcept {
+        if (FLIGHT_WASM_UNLIKELY(remaining() < sizeof(uint32_t))) {
+            return Result<uint32_t>{ErrorCode::UnexpectedEndOfFile, "Unexpected end of data"};
+        }
+        uint32_t value;
+        std::memcpy(&value, data_.data() + position_, sizeof(value));
+        position_ += sizeof(value);
+        return Result<uint32_t>{endian::wasm_to_host(value)};
+    }
+
+    inline Result<uint64_t> BinaryReader::read_u64() noexcept {
+        if (FLIGHT_WASM_UNLIKELY(remaining() < sizeof(uint64_t))) {
+            return Result<uint64_t>{ErrorCode::UnexpectedEndOfFile, "Unexpected end of data"};
+        }
+        uint64_t value;
+        std::memcpy(&value, data_.data() + position_, sizeof(value));
+        position_ += sizeof(value);
+        return Result<uint64_t>{endian::wasm_to_host(value)};
+    }
+
+    inline Result<float> BinaryReader::read_f32() noexcept {
+        auto bits = read_u32();
+        if (!bits) {
+            return bits.error();
+        }
+        float value;
+        std::memcpy(&value, &bits.value(), sizeof(value));
+        return Result<float>{value};
+    }
+
+    inline Result<double> BinaryReader::read_f64() noexcept {
+        auto bits = read_u64();
+        if (!bits) {
+            return bits.error();
+        }
+        double value;
+        std::memcpy(&value, &bits.value(), sizeof(value));
+        return Result<double>{value};
+    }
+
+    template<typename T>
+    inline Result<T> BinaryReader::read_unsigned_leb128() noexcept {
+        static_assert(std::is_unsigned_v<T>, "Unsigned LEB128 requires an unsigned type");
+        constexpr unsigned bits = sizeof(T) * 8;
+        constexpr unsigned max_bytes = (bits + 6) / 7;
+
+        T result = 0;
+        unsigned shift = 0;
+        for (unsigned i = 0; i < max_bytes; ++i) {
+            if (FLIGHT_WASM_UNLIKELY(position_ >= data_.size())) {
+                return Result<T>{ErrorCode::UnexpectedEndOfFile, "Truncated LEB128"};
+            }
+            uint8_t byte = data_[position_++];
+            if (i == max_bytes - 1) {
+                // Final byte: no continuation and no bits beyond the type width
+                const unsigned used = bits - shift;
+                if ((byte & 0x80) != 0 || (byte >> used) != 0) {
+                    return Result<T>{ErrorCode::InvalidLEB128Encoding, "LEB128 value out of range"};
+                }
+            }
+            result |= static_cast<T>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return Result<T>{result};
+            }
+            shift += 7;
+        }
+        return Result<T>{ErrorCode::InvalidLEB128Encoding, "LEB128 value too long"};
+    }
+
+    template<typename T>
+    inline Result<T> BinaryReader::read_signed_leb128() noexcept {
+        static_assert(std::is_signed_v<T>, "Signed LEB128 requires a signed type");
+        using U = std::make_unsigned_t<T>;
+        constexpr unsigned bits = sizeof(T) * 8;
+        constexpr unsigned max_bytes = (bits + 6) / 7;
+
+        U result = 0;
+        unsigned shift = 0;
+        for (unsigned i = 0; i < max_bytes; ++i) {
+            if (FLIGHT_WASM_UNLIKELY(position_ >= data_.size())) {
+                return Result<T>{ErrorCode::UnexpectedEndOfFile, "Truncated LEB128"};
+            }
+            uint8_t byte = data_[position_++];
+            if (i == max_bytes - 1) {
+                // Final byte: bits beyond the type width must replicate the sign bit
+                const unsigned used = bits - shift;
+                const uint8_t high = static_cast<uint8_t>((byte & 0x7F) >> (used - 1));
+                const uint8_t all_ones = static_cast<uint8_t>(0x7F >> (used - 1));
+                if ((byte & 0x80) != 0 || (high != 0 && high != all_ones)) {
+                    return Result<T>{ErrorCode::InvalidLEB128Encoding, "LEB128 value out of range"};
+                }
+            }
+            result |= static_cast<U>(byte & 0x7F) << shift;
+            shift += 7;
+            if ((byte & 0x80) == 0) {
+                if (shift < bits && (byte & 0x40) != 0) {
+                    result |= ~static_cast<U>(0) << shift;
+                }
+                return Result<T>{static_cast<T>(result)};
+            }
+        }
+        return Result<T>{ErrorCode::InvalidLEB128Encoding, "LEB128 value too long"};
+    }
+
+    inline Result<uint32_t> BinaryReader::read_leb128_u32() noexcept {
+        // Fast path: single-byte values dominate counts and indices
+        if (FLIGHT_WASM_LIKELY(position_ < data_.size() && data_[position_] < 0x80)) {
+            return Result<uint32_t>{data_[position_++]};
+        }
+        return read_unsigned_leb128<uint32_t>();
+    }
+
+    inline Result<int32_t> BinaryReader::read_leb128_i32() noexcept {
+        return read_signed_leb128<int32_t>();
+    }
+
+    inline Result<uint64_t> BinaryReader::read_leb128_u64() noexcept {
+        return read_unsigned_leb128<uint64_t>();
+    }
+
+    inline Result<int64_t> BinaryReader::read_leb128_i64() noexcept {
+        return read_signed_leb128<int64_t>();
+    }
+
+    inline Result<std::string> BinaryReader::read_string() noexcept {
+        auto name = read_name();
+        if (!name) {
+            return name.error();
+        }
+        return Result<std::string>{std::string(name.value())};
+    }
+
+    inline Result<std::string_view> BinaryReader::read_name() noexcept {
+        auto length = read_leb128_u32();
+        if (!length) {
+            return length.error();
+        }
+        auto bytes = read_view(length.value());
+        if (!bytes) {
+            return bytes.error();
+        }
+        if (!detail::is_valid_utf8(bytes->data(), bytes->size())) {
+            return Result<std::string_view>{ErrorCode::InvalidUTF8Sequence, "Name is not valid UTF-8"};
+        }
+        return Result<std::string_view>{
+            std::string_view(reinterpret_cast<const char*>(bytes->data()), bytes->size())};
+    }
+
+    inline Result<void> BinaryReader::skip_bytes(size_t count) noexcept {
+        if (count > remaining()) {
+            return Result<void>{ErrorCode::UnexpectedEndOfFile, "Skip past end of data"};
+        }
+        position_ += count;
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryReader::seek(size_t position) noexcept {
+        if (position > data_.size()) {
+            return Result<void>{ErrorCode::OutOfBounds, "Seek past end of data"};
+        }
+        position_ = position;
+        return Result<void>{Error{}};
+    }
+
+    // =========================================================================
+    // Inline Implementation - BinaryParser
+    // =========================================================================
+
+    inline Result<Module> BinaryParser::parse(span<const uint8_t> data) noexcept {
+        return parse(data, ParseOptions{});
+    }
+
+    inline Result<Module> BinaryParser::parse(span<const uint8_t> data, const ParseOptions& options) noexcept {
+        BinaryParser parser;
+        parser.options_ = options;
+        BinaryReader reader(data);
+        return parser.parse_module(reader);
+    }
+
+    inline Result<Module> BinaryParser::parse_file(const std::string& filename) noexcept {
+        return parse_file(filename, MappingOptions{});
+    }
+
+    inline Result<Module> BinaryParser::parse_file(const std::string& filename,
+                                                   const MappingOptions& mapping) noexcept {
+        auto file = MappedFile::open(filename, mapping);
+        if (!file) {
+            return file.error();
+        }
+        std::shared_ptr<MappedFile> mapped = std::move(file).value();
+
+        ParseOptions options;
+        options.zero_copy = true;
+        auto module = parse(mapped->bytes(), options);
+
+        // Parsing was the only sequential pass; later accesses are random
+        mapped->advise_normal();
+
+        if (module) {
+            module->backing_store = std::move(mapped);
+        }
+        return module;
+    }
+
+    inline Result<void> BinaryParser::validate(span<const uint8_t> data) noexcept {
+        ParseOptions options;
+        options.zero_copy = true;  // Nothing outlives the call, so skip the copies
+        auto module = parse(data, options);
+        if (!module) {
+            return module.error();
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline bool BinaryParser::is_wasm_binary(span<const uint8_t> data) noexcept {
+        if (data.size() < binary_constants::HEADER_SIZE) {
+            return false;
+        }
+        BinaryReader reader(data);
+        return reader.read_u32().value_or(0) == binary_constants::WASM_MAGIC &&
+               reader.read_u32().value_or(0) == binary_constants::WASM_VERSION;
+    }
+
+    inline Result<Module> BinaryParser::parse_module(BinaryReader& reader) noexcept {
+        auto header = parse_header(reader);
+        if (!header) {
+            return header.error();
+        }
+
+        Module module;
+        auto sections = parse_sections(reader, module);
+        if (!sections) {
+            return sections.error();
+        }
+
+        if (module.defined_function_count() != module.function_type_indices.size()) {
+            return Result<Module>{ErrorCode::InvalidModule, "Function and code section counts differ"};
+        }
+        if (module.has_data_count && module.data.size() != module.data_count) {
+            return Result<Module>{ErrorCode::InvalidModule, "Data count does not match data section"};
+        }
+        return Result<Module>{std::move(module)};
+    }
+
+    inline Result<void> BinaryParser::parse_header(BinaryReader& reader) noexcept {
+        auto magic = reader.read_u32();
+        if (!magic) {
+            return magic.error();
+        }
+        if (magic.value() != binary_constants::WASM_MAGIC) {
+            return Result<void>{ErrorCode::InvalidMagicNumber, "Invalid WebAssembly magic number"};
+        }
+
+        auto version = reader.read_u32();
+        if (!version) {
+            return version.error();
+        }
+        if (version.value() != binary_constants::WASM_VERSION) {
+            return Result<void>{ErrorCode::InvalidVersion, "Unsupported WebAssembly version"};
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_sections(BinaryReader& reader, Module& module) noexcept {
+        last_section_order_ = 0;
+        while (reader.has_data()) {
+            auto section = parse_section(reader, module);
+            if (!section) {
+                return section;
+            }
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_section(BinaryReader& reader, Module& module) noexcept {
+        auto id = reader.read_byte();
+        if (!id) {
+            return id.error();
+        }
+        if (!is_valid_section_id(id.value())) {
+            return Result<void>{ErrorCode::InvalidSectionId, "Unknown section id"};
+        }
+
+        auto size = reader.read_leb128_u32();
+        if (!size) {
+            return Result<void>{ErrorCode::MissingSectionSize, "Missing section size"};
+        }
+        auto contents = reader.read_view(size.value());
+        if (!contents) {
+            return Result<void>{ErrorCode::SectionTooLarge, "Section extends past end of module"};
+        }
+
+        if (id.value() != static_cast<uint8_t>(SectionId::Custom)) {
+            uint8_t order = detail::section_order(id.value());
+            if (order == last_section_order_) {
+                return Result<void>{ErrorCode::DuplicateSection, "Duplicate section"};
+            }
+            if (order < last_section_order_) {
+                return Result<void>{ErrorCode::InvalidSectionOrder, "Section out of order"};
+            }
+            last_section_order_ = order;
+        }
+
+        return parse_section_contents(id.value(), contents.value(), module);
+    }
+
+    inline Result<void> BinaryParser::parse_section_contents(uint8_t id, span<const uint8_t> contents,
+                                                             Module& module) noexcept {
+        BinaryReader section(contents);
+        Result<void> parsed{Error{}};
+        switch (static_cast<SectionId>(id)) {
+            case SectionId::Custom:    parsed = parse_custom_section(section, module); break;
+            case SectionId::Type:      parsed = parse_type_section(section, module); break;
+            case SectionId::Import:    parsed = parse_import_section(section, module); break;
+            case SectionId::Function:  parsed = parse_function_section(section, module); break;
+            case SectionId::Table:     parsed = parse_table_section(section, module); break;
+            case SectionId::Memory:    parsed = parse_memory_section(section, module); break;
+            case SectionId::Global:    parsed = parse_global_section(section, module); break;
+            case SectionId::Export:    parsed = parse_export_section(section, module); break;
+            case SectionId::Start:     parsed = parse_start_section(section, module); break;
+            case SectionId::Element:   parsed = parse_element_section(section, module); break;
+            case SectionId::Code:      parsed = parse_code_section(section, module); break;
+            case SectionId::Data:      parsed = parse_data_section(section, module); break;
+            case SectionId::DataCount: parsed = parse_data_count_section(section, module); break;
+        }
+        if (!parsed) {
+            return parsed;
+        }
+        if (section.has_data()) {
+            return Result<void>{ErrorCode::SectionTooLarge, "Section size does not match contents"};
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<ValueType> BinaryParser::parse_value_type(BinaryReader& reader) noexcept {
+        auto byte = reader.read_byte();
+        if (!byte) {
+            return byte.error();
+        }
+        return decode_value_type(byte.value());
+    }
+
+    inline Result<ValueType> BinaryParser::parse_reference_type(BinaryReader& reader) noexcept {
+        auto type = parse_value_type(reader);
+        if (type && !is_reference_type(type.value())) {
+            return Result<ValueType>{ErrorCode::TypeMismatch, "Expected a reference type"};
+        }
+        return type;
+    }
+
+    inline Result<Limits> BinaryParser::parse_limits(BinaryReader& reader) noexcept {
+        auto flag = reader.read_byte();
+        if (!flag) {
+            return flag.error();
+        }
+        if (flag.value() > 0x01) {
+            return Result<Limits>{ErrorCode::InvalidModule, "Invalid limits flag"};
+        }
+
+        auto min = reader.read_leb128_u32();
+        if (!min) {
+            return min.error();
+        }
+        if (flag.value() == 0x00) {
+            return Result<Limits>{Limits(min.value())};
+        }
+
+        auto max = reader.read_leb128_u32();
+        if (!max) {
+            return max.error();
+        }
+        return Result<Limits>{Limits(min.value(), max.value())};
+    }
+
+    inline Result<GlobalType> BinaryParser::parse_global_type(BinaryReader& reader) noexcept {
+        auto type = parse_value_type(reader);
+        if (!type) {
+            return type.error();
+        }
+        auto mutability = reader.read_byte();
+        if (!mutability) {
+            return mutability.error();
+        }
+        if (mutability.value() > 0x01) {
+            return Result<GlobalType>{ErrorCode::InvalidModule, "Invalid global mutability"};
+        }
+        return Result<GlobalType>{GlobalType(type.value(), mutability.value() == 0x01)};
+    }
+
+    inline Result<std::vector<uint8_t>> BinaryParser::parse_constant_expression(BinaryReader& reader) noexcept {
+        const size_t start = reader.position();
+        for (;;) {
+            auto opcode = reader.read_byte();
+            if (!opcode) {
+                return opcode.error();
+            }
+
+            Result<void> immediate{Error{}};
+            switch (opcode.value()) {
+                case 0x0B: {  // end
+                    const size_t length = reader.position() - start;
+                    reader.seek(start);
+                    return reader.read_bytes(length);
+                }
+                case 0x41: {  // i32.const
+                    auto v = reader.read_leb128_i32();
+                    if (!v) immediate = v.error();
+                    break;
+                }
+                case 0x42: {  // i64.const
+                    auto v = reader.read_leb128_i64();
+                    if (!v) immediate = v.error();
+                    break;
+                }
+                case 0x43:    // f32.const
+                    immediate = reader.skip_bytes(4);
+                    break;
+                case 0x44:    // f64.const
+                    immediate = reader.skip_bytes(8);
+                    break;
+                case 0x23:    // global.get
+                case 0xD2: {  // ref.func
+                    auto v = reader.read_leb128_u32();
+                    if (!v) immediate = v.error();
+                    break;
+                }
+                case 0xD0: {  // ref.null
+                    auto v = parse_reference_type(reader);
+                    if (!v) immediate = v.error();
+                    break;
+                }
+                case 0xFD: {  // v128.const
+                    auto sub = reader.read_leb128_u32();
+                    if (!sub) {
+                        immediate = sub.error();
+                    } else if (sub.value() != 0x0C) {
+                        immediate = Result<void>{ErrorCode::InvalidConstantExpression, "Invalid constant expression"};
+                    } else {
+                        immediate = reader.skip_bytes(16);
+                    }
+                    break;
+                }
+                case 0x6A: case 0x6B: case 0x6C:  // i32.add/sub/mul (extended-const)
+                case 0x7C: case 0x7D: case 0x7E:  // i64.add/sub/mul (extended-const)
+                    break;
+                default:
+                    return Result<std::vector<uint8_t>>{ErrorCode::InvalidConstantExpression,
+                                                        "Invalid instruction in constant expression"};
+            }
+            if (!immediate) {
+                return immediate.error();
+            }
+        }
+    }
+
+    inline Result<span<const uint8_t>> BinaryParser::parse_payload(BinaryReader& reader, size_t size,
+                                                                   std::vector<uint8_t>& owned) noexcept {
+        auto view = reader.read_view(size);
+        if (!view) {
+            return view;
+        }
+        if (options_.zero_copy) {
+            return view;
+        }
+        owned.assign(view->begin(), view->end());
+        return Result<span<const uint8_t>>{span<const uint8_t>()};
+    }
+
+    inline Result<std::string_view> BinaryParser::parse_name(BinaryReader& reader, Module& module) noexcept {
+        auto name = reader.read_name();
+        if (!name || options_.zero_copy) {
+            return name;  // Zero-copy names borrow the input like bodies do
+        }
+        return Result<std::string_view>{module.intern(name.value())};
+    }
+
+    inline Result<void> BinaryParser::parse_type_section(BinaryReader& reader, Module& module) noexcept {
+        auto count = reader.read_leb128_u32();
+        if (!count) {
+            return count.error();
+        }
+        module.types.reserve(std::min<size_t>(count.value(), reader.remaining()));
+
+        for (uint32_t i = 0; i < count.value(); ++i) {
+            auto form = reader.read_byte();
+            if (!form) {
+                return form.error();
+            }
+            if (form.value() != 0x60) {
+                return Result<void>{ErrorCode::TypeMismatch, "Expected function type"};
+            }
+
+            FunctionType type;
+            for (auto* list : {&type.params, &type.results}) {
+                auto length = reader.read_leb128_u32();
+                if (!length) {
+                    return length.error();
+                }
+                if (length.value() > reader.remaining()) {
+                    return Result<void>{ErrorCode::UnexpectedEndOfFile, "Type list extends past section"};
+                }
+                list->reserve(length.value());
+                for (uint32_t k = 0; k < length.value(); ++k) {
+                    auto value_type = parse_value_type(reader);
+                    if (!value_type) {
+                        return value_type.error();
+                    }
+                    list->push_back(value_type.value());
+                }
+            }
+            module.types.push_back(std::move(type));
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_import_section(BinaryReader& reader, Module& module) noexcept {
+        auto count = reader.read_leb128_u32();
+        if (!count) {
+            return count.error();
+        }
+        module.imports.reserve(std::min<size_t>(count.value(), reader.remaining()));
+
+        for (uint32_t i = 0; i < count.value(); ++i) {
+            auto module_name = parse_name(reader, module);
+            if (!module_name) {
+                return module_name.error();
+            }
+            auto field_name = parse_name(reader, module);
+            if (!field_name) {
+                return field_name.error();
+            }
+            auto kind = reader.read_byte();
+            if (!kind) {
+                return kind.error();
+            }
+
+            Import::Descriptor descriptor;
+            switch (static_cast<Import::Kind>(kind.value())) {
+                case Import::Kind::Function: {
+                    auto type_index = reader.read_leb128_u32();
+                    if (!type_index) {
+                        return type_index.error();
+                    }
+                    descriptor = Import::Descriptor(type_index.value());
+                    break;
+                }
+                case Import::Kind::Table: {
+                    auto element_type = parse_reference_type(reader);
+                    if (!element_type) {
+                        return element_type.error();
+                    }
+                    auto limits = parse_limits(reader);
+                    if (!limits) {
+                        return limits.error();
+                    }
+                    descriptor = Import::Descriptor(TableType(element_type.value(), limits.value()));
+                    break;
+                }
+                case Import::Kind::Memory: {
+                    auto limits = parse_limits(reader);
+                    if (!limits) {
+                        return limits.error();
+                    }
+                    descriptor = Import::Descriptor(MemoryType(limits.value()));
+                    break;
+                }
+                case Import::Kind::Global: {
+                    auto global_type = parse_global_type(reader);
+                    if (!global_type) {
+                        return global_type.error();
+                    }
+                    descriptor = Import::Descriptor(global_type.value());
+                    break;
+                }
+                default:
+                    return Result<void>{ErrorCode::InvalidModule, "Invalid import kind"};
+            }
+
+            module.imports.emplace_back(std::move(module_name).value(), std::move(field_name).value(),
+                                        static_cast<Import::Kind>(kind.value()), descriptor);
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_function_section(BinaryReader& reader, Module& module) noexcept {
+        auto count = reader.read_leb128_u32();
+        if (!count) {
+            return count.error();
+        }
+        module.function_type_indices.reserve(std::min<size_t>(count.value(), reader.remaining()));
+
+        for (uint32_t i = 0; i < count.value(); ++i) {
+            auto type_index = reader.read_leb128_u32();
+            if (!type_index) {
+                return type_index.error();
+            }
+            module.function_type_indices.push_back(type_index.value());
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_table_section(BinaryReader& reader, Module& module) noexcept {
+        auto count = reader.read_leb128_u32();
+        if (!count) {
+            return count.error();
+        }
+        module.tables.reserve(std::min<size_t>(count.value(), reader.remaining()));
+
+        for (uint32_t i = 0; i < count.value(); ++i) {
+            auto element_type = parse_reference_type(reader);
+            if (!element_type) {
+                return element_type.error();
+            }
+            auto limits = parse_limits(reader);
+            if (!limits) {
+                return limits.error();
+            }
+            module.tables.emplace_back(element_type.value(), limits.value());
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_memory_section(BinaryReader& reader, Module& module) noexcept {
+        auto count = reader.read_leb128_u32();
+        if (!count) {
+            return count.error();
+        }
+        module.memories.reserve(std::min<size_t>(count.value(), reader.remaining()));
+
+        for (uint32_t i = 0; i < count.value(); ++i) {
+            auto limits = parse_limits(reader);
+            if (!limits) {
+                return limits.error();
+            }
+            module.memories.emplace_back(limits.value());
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_global_section(BinaryReader& reader, Module& module) noexcept {
+        auto count = reader.read_leb128_u32();
+        if (!count) {
+            return count.error();
+        }
+        module.globals.reserve(std::min<size_t>(count.value(), reader.remaining()));
+
+        for (uint32_t i = 0; i < count.value(); ++i) {
+            auto type = parse_global_type(reader);
+            if (!type) {
+                return type.error();
+            }
+            auto init = parse_constant_expression(reader);
+            if (!init) {
+                return init.error();
+            }
+            module.globals.emplace_back(type.value(), std::move(init).value());
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_export_section(BinaryReader& reader, Module& module) noexcept {
+        auto count = reader.read_leb128_u32();
+        if (!count) {
+            return count.error();
+        }
+        module.exports.reserve(std::min<size_t>(count.value(), reader.remaining()));
+
+        for (uint32_t i = 0; i < count.value(); ++i) {
+            auto name = parse_name(reader, module);
+            if (!name) {
+                return name.error();
+            }
+            auto kind = reader.read_byte();
+            if (!kind) {
+                return kind.error();
+            }
+            if (kind.value() > static_cast<uint8_t>(Export::Kind::Global)) {
+                return Result<void>{ErrorCode::InvalidModule, "Invalid export kind"};
+            }
+            auto index = reader.read_leb128_u32();
+            if (!index) {
+                return index.error();
+            }
+            module.exports.emplace_back(name.value(), static_cast<Export::Kind>(kind.value()), index.value());
+        }
+        module.index_exports();
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_start_section(BinaryReader& reader, Module& module) noexcept {
+        auto index = reader.read_leb128_u32();
+        if (!index) {
+            return index.error();
+        }
+        module.start_function_index = index.value();
+        module.has_start_function = true;
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_element_section(BinaryReader& reader, Module& module) noexcept {
+        auto count = reader.read_leb128_u32();
+        if (!count) {
+            return count.error();
+        }
+        module.elements.reserve(std::min<size_t>(count.value(), reader.remaining()));
+
+        for (uint32_t i = 0; i < count.value(); ++i) {
+            auto flags = reader.read_leb128_u32();
+            if (!flags) {
+                return flags.error();
+            }
+            if (flags.value() > 7) {
+                return Result<void>{ErrorCode::InvalidModule, "Invalid element segment flags"};
+            }
+
+            // Bit 0: passive/declarative, bit 1: explicit table index or declarative,
+            // bit 2: element expressions instead of function indices
+            const bool not_active = (flags.value() & 0x01) != 0;
+            const bool explicit_kind = (flags.value() & 0x02) != 0;
+            const bool uses_expressions = (flags.value() & 0x04) != 0;
+
+            Element element;
+            element.mode = not_active ? (explicit_kind ? Element::Mode::Declarative : Element::Mode::Passive)
+                                      : Element::Mode::Active;
+            element.table_index = 0;
+            element.element_type = ValueType::FuncRef;
+
+            if (!not_active) {
+                if (explicit_kind) {
+                    auto table_index = reader.read_leb128_u32();
+                    if (!table_index) {
+                        return table_index.error();
+                    }
+                    element.table_index = table_index.value();
+                }
+                auto offset = parse_constant_expression(reader);
+                if (!offset) {
+                    return offset.error();
+                }
+                element.offset_bytes = std::move(offset).value();
+            }
+
+            if (not_active || explicit_kind) {
+                if (uses_expressions) {
+                    auto type = parse_reference_type(reader);
+                    if (!type) {
+                        return type.error();
+                    }
+                    element.element_type = type.value();
+                } else {
+                    auto elem_kind = reader.read_byte();
+                    if (!elem_kind) {
+                        return elem_kind.error();
+                    }
+                    if (elem_kind.value() != 0x00) {
+                        return Result<void>{ErrorCode::InvalidModule, "Invalid element kind"};
+                    }
+                }
+            }
+
+            auto length = reader.read_leb128_u32();
+            if (!length) {
+                return length.error();
+            }
+            element.function_indices.reserve(std::min<size_t>(length.value(), reader.remaining()));
+            for (uint32_t k = 0; k < length.value(); ++k) {
+                if (uses_expressions) {
+                    // Only `ref.func idx end` is representable as a function index
+                    auto opcode = reader.read_byte();
+                    if (!opcode) {
+                        return opcode.error();
+                    }
+                    if (opcode.value() != 0xD2) {
+                        return Result<void>{ErrorCode::UnsupportedInstruction,
+                                            "Only ref.func element expressions are supported"};
+                    }
+                }
+                auto function_index = reader.read_leb128_u32();
+                if (!function_index) {
+                    return function_index.error();
+                }
+                if (uses_expressions) {
+                    auto end = reader.read_byte();
+                    if (!end) {
+                        return end.error();
+                    }
+                    if (end.value() != 0x0B) {
+                        return Result<void>{ErrorCode::InvalidConstantExpression, "Expected end of element expression"};
+                    }
+                }
+                element.function_indices.push_back(function_index.value());
+            }
+            module.elements.push_back(std::move(element));
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_code_section(BinaryReader& reader, Module& module) noexcept {
+        auto count = reader.read_leb128_u32();
+        if (!count) {
+            return count.error();
+        }
+        if (count.value() != module.function_type_indices.size()) {
+            return Result<void>{ErrorCode::InvalidModule, "Function and code section counts differ"};
+        }
+        if (options_.compact_code) {
+            return parse_compact_code_section(reader, module, count.value());
+        }
+        module.functions.reserve(count.value());
+
+        for (uint32_t i = 0; i < count.value(); ++i) {
+            auto size = reader.read_leb128_u32();
+            if (!size) {
+                return size.error();
+            }
+            auto entry = reader.read_view(size.value());
+            if (!entry) {
+                return entry.error();
+            }
+            BinaryReader body(entry.value());
+
+            Function function;
+            function.type_index = module.function_type_indices[i];
+
+            auto groups = body.read_leb128_u32();
+            if (!groups) {
+                return groups.error();
+            }
+            size_t total_locals = 0;
+            for (uint32_t g = 0; g < groups.value(); ++g) {
+                auto n = body.read_leb128_u32();
+                if (!n) {
+                    return n.error();
+                }
+                total_locals += n.value();
+                if (total_locals > binary_constants::MAX_FUNCTION_LOCALS) {
+                    return Result<void>{ErrorCode::InvalidLocalIndex, "Too many locals"};
+                }
+                auto type = parse_value_type(body);
+                if (!type) {
+                    return type.error();
+                }
+                function.locals.insert(function.locals.end(), n.value(), type.value());
+            }
+
+            auto view = parse_payload(body, body.remaining(), function.body_bytes);
+            if (!view) {
+                return view.error();
+            }
+            function.body_view = view.value();
+            module.functions.push_back(std::move(function));
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_compact_code_section(BinaryReader& reader, Module& module,
+                                                                 uint32_t count) noexcept {
+        CodeTable& table = module.code_table;
+        table = CodeTable();
+        if (options_.zero_copy) {
+            table.borrow_code(reader.data());
+        } else {
+            table.copy_code(reader.data());  // One allocation for every body
+        }
+        table.reserve(count, count);
+
+        std::vector<LocalGroup> locals;
+        for (uint32_t i = 0; i < count; ++i) {
+            auto size = reader.read_leb128_u32();
+            if (!size) {
+                return size.error();
+            }
+            auto entry = reader.read_view(size.value());
+            if (!entry) {
+                return entry.error();
+            }
+            BinaryReader body(entry.value());
+
+            auto groups = body.read_leb128_u32();
+            if (!groups) {
+                return groups.error();
+            }
+            locals.clear();
+            size_t total_locals = 0;
+            for (uint32_t g = 0; g < groups.value(); ++g) {
+                auto n = body.read_leb128_u32();
+                if (!n) {
+                    return n.error();
+                }
+                total_locals += n.value();
+                if (total_locals > binary_constants::MAX_FUNCTION_LOCALS) {
+                    return Result<void>{ErrorCode::InvalidLocalIndex, "Too many locals"};
+                }
+                auto type = parse_value_type(body);
+                if (!type) {
+                    return type.error();
+                }
+                locals.push_back(LocalGroup{n.value(), type.value()});
+            }
+
+            const size_t body_offset = reader.position() - body.remaining();
+            table.add(span<const LocalGroup>(locals.data(), locals.size()),
+                      static_cast<uint32_t>(body_offset), static_cast<uint32_t>(body.remaining()));
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_data_section(BinaryReader& reader, Module& module) noexcept {
+        auto count = reader.read_leb128_u32();
+        if (!count) {
+            return count.error();
+        }
+        module.data.reserve(std::min<size_t>(count.value(), reader.remaining()));
+
+        for (uint32_t i = 0; i < count.value(); ++i) {
+            auto flags = reader.read_leb128_u32();
+            if (!flags) {
+                return flags.error();
+            }
+            if (flags.value() > 2) {
+                return Result<void>{ErrorCode::InvalidModule, "Invalid data segment flags"};
+            }
+
+            Data segment;
+            segment.mode = flags.value() == 1 ? Data::Mode::Passive : Data::Mode::Active;
+            segment.memory_index = 0;
+
+            if (flags.value() == 2) {
+                auto memory_index = reader.read_leb128_u32();
+                if (!memory_index) {
+                    return memory_index.error();
+                }
+                segment.memory_index = memory_index.value();
+            }
+            if (segment.mode == Data::Mode::Active) {
+                auto offset = parse_constant_expression(reader);
+                if (!offset) {
+                    return offset.error();
+                }
+                segment.offset_bytes = std::move(offset).value();
+            }
+
+            auto length = reader.read_leb128_u32();
+            if (!length) {
+                return length.error();
+            }
+            auto view = parse_payload(reader, length.value(), segment.data);
+            if (!view) {
+                return view.error();
+            }
+            segment.data_view = view.value();
+            module.data.push_back(std::move(segment));
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_data_count_section(BinaryReader& reader, Module& module) noexcept {
+        auto count = reader.read_leb128_u32();
+        if (!count) {
+            return count.error();
+        }
+        module.data_count = count.value();
+        module.has_data_count = true;
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> BinaryParser::parse_custom_section(BinaryReader& reader, Module& module) noexcept {
+        auto name = parse_name(reader, module);
+        if (!name) {
+            return name.error();
+        }
+        auto contents = reader.read_bytes(reader.remaining());
+        if (!contents) {
+            return contents.error();
+        }
+        module.custom_sections.emplace_back(name.value(), std::move(contents).value());
+        return Result<void>{Error{}};
+    }
+
+    // =========================================================================
+    // Inline Implementation - StreamingBinaryParser
+    // =========================================================================
+
+    inline Result<void> StreamingBinaryParser::parse_headers(span<const uint8_t> data) noexcept {
+        auto sections = get_section_info(data);
+        if (!sections) {
+            return sections.error();
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<std::vector<StreamingBinaryParser::SectionInfo>>
+    StreamingBinaryParser::get_section_info(span<const uint8_t> data) noexcept {
+        BinaryParser parser;
+        BinaryReader reader(data);
+        auto header = parser.parse_header(reader);
+        if (!header) {
+            return header.error();
+        }
+
+        std::vector<SectionInfo> sections;
+        uint8_t last_order = 0;
+        while (reader.has_data()) {
+            const size_t header_offset = reader.position();
+            auto id = reader.read_byte();
+            if (!id) {
+                return id.error();
+            }
+            if (!is_valid_section_id(id.value())) {
+                return Result<std::vector<SectionInfo>>{ErrorCode::InvalidSectionId, "Unknown section id"};
+            }
+            auto size = reader.read_leb128_u32();
+            if (!size) {
+                return Result<std::vector<SectionInfo>>{ErrorCode::MissingSectionSize, "Missing section size"};
+            }
+            const size_t offset = reader.position();
+            auto contents = reader.read_view(size.value());
+            if (!contents) {
+                return Result<std::vector<SectionInfo>>{ErrorCode::SectionTooLarge,
+                                                        "Section extends past end of module"};
+            }
+
+            SectionInfo info{id.value(), offset, size.value(), std::string(), header_offset};
+            if (id.value() == static_cast<uint8_t>(SectionId::Custom)) {
+                BinaryReader custom(contents.value());
+                auto name = custom.read_string();
+                if (!name) {
+                    return name.error();
+                }
+                info.name = std::move(name).value();
+            } else {
+                uint8_t order = detail::section_order(id.value());
+                if (order == last_order) {
+                    return Result<std::vector<SectionInfo>>{ErrorCode::DuplicateSection, "Duplicate section"};
+                }
+                if (order < last_order) {
+                    return Result<std::vector<SectionInfo>>{ErrorCode::InvalidSectionOrder, "Section out of order"};
+                }
+                last_order = order;
+            }
+            sections.push_back(std::move(info));
+        }
+        return Result<std::vector<SectionInfo>>{std::move(sections)};
+    }
+
+    inline Result<void> StreamingBinaryParser::parse_section_at(span<const uint8_t> data, size_t section_index,
+                                                                Module& module) noexcept {
+        auto sections = get_section_info(data);
+        if (!sections) {
+            return sections.error();
+        }
+        if (section_index >= sections.value().size()) {
+            return Result<void>{ErrorCode::OutOfBounds, "Section index out of range"};
+        }
+
+        const SectionInfo& info = sections.value()[section_index];
+        BinaryParser parser;
+        return parser.parse_section_contents(info.id, data.subspan(info.offset, info.size), module);
+    }
+
 } // namespace flight::wasm
 
 #endif // FLIGHT_WASM_BINARY_PARSER_HPP
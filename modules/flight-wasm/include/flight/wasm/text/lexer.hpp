@@ -0,0 +1,514 @@
+#ifndef FLIGHT_WASM_TEXT_LEXER_HPP
+#define FLIGHT_WASM_TEXT_LEXER_HPP
+
+/**
+ * @file lexer.hpp
+ * @brief WebAssembly Text Format (WAT) tokenizer and literal decoding
+ *
+ * The lexer walks a std::string_view and hands out tokens that are views into
+ * the source; it never allocates. Literal decoding (integers, floats and
+ * string escapes) happens only when the parser lowers a token.
+ */
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <flight/wasm/utilities/error.hpp>
+#include <flight/wasm/utilities/platform.hpp>
+
+namespace flight::wasm {
+
+    /**
+     * @brief Lexical token of the text format
+     */
+    struct Token {
+        enum class Kind : uint8_t {
+            LeftParen,
+            RightParen,
+            Keyword,     // Starts with a lowercase letter (also inf/nan)
+            Identifier,  // $name
+            Number,      // Starts with a digit or sign
+            String,      // Quoted, escapes still encoded
+            End
+        };
+
+        Kind kind = Kind::End;
+        std::string_view text;  // View into the source
+        uint32_t offset = 0;    // Byte offset into the source
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Character classes of the text format grammar
+         */
+        enum : uint8_t {
+            WAT_IDCHAR = 1,  // May appear in keywords, identifiers and numbers
+            WAT_SPACE = 2
+        };
+
+        struct WatCharTable {
+            uint8_t classes[256] = {};
+
+            constexpr WatCharTable() {
+                for (int c = '0'; c <= '9'; ++c) classes[c] = WAT_IDCHAR;
+                for (int c = 'A'; c <= 'Z'; ++c) classes[c] = WAT_IDCHAR;
+                for (int c = 'a'; c <= 'z'; ++c) classes[c] = WAT_IDCHAR;
+                for (char c : {'!', '#', '$', '%', '&', '\'', '*', '+', '-', '.', '/', ':', '<',
+                               '=', '>', '?', '@', '\\', '^', '_', '`', '|', '~'}) {
+                    classes[static_cast<uint8_t>(c)] = WAT_IDCHAR;
+                }
+                for (char c : {' ', '\t', '\n', '\r'}) {
+                    classes[static_cast<uint8_t>(c)] = WAT_SPACE;
+                }
+            }
+        };
+
+        inline constexpr WatCharTable wat_chars{};
+
+        inline constexpr bool is_idchar(char c) noexcept {
+            return wat_chars.classes[static_cast<uint8_t>(c)] == WAT_IDCHAR;
+        }
+
+        inline constexpr bool is_space(char c) noexcept {
+            return wat_chars.classes[static_cast<uint8_t>(c)] == WAT_SPACE;
+        }
+
+        inline int hex_digit_value(char c) noexcept {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Tokenizer for the WebAssembly text format
+     */
+    class Lexer {
+    public:
+        explicit Lexer(std::string_view source) noexcept : source_(source) {}
+
+        /**
+         * @brief Produce the next token, skipping whitespace and comments
+         */
+        Result<Token> next() noexcept;
+
+        /**
+         * @brief Current byte offset into the source
+         */
+        size_t offset() const noexcept { return position_; }
+
+    private:
+        Result<void> skip_trivia() noexcept;
+
+        std::string_view source_;
+        size_t position_ = 0;
+    };
+
+    // =========================================================================
+    // Literal decoding
+    // =========================================================================
+
+    namespace text {
+
+        /**
+         * @brief Decode an unsigned integer literal (decimal or 0x hex, with _ separators)
+         */
+        Result<uint64_t> parse_uint(std::string_view text, uint64_t max) noexcept;
+
+        /**
+         * @brief Decode a u32 (indices, alignments, limits)
+         */
+        inline Result<uint32_t> parse_u32(std::string_view text) noexcept {
+            auto value = parse_uint(text, UINT32_MAX);
+            if (!value) {
+                return value.error();
+            }
+            return Result<uint32_t>{static_cast<uint32_t>(value.value())};
+        }
+
+        /**
+         * @brief Decode an i32 literal (signed or unsigned interpretation)
+         */
+        Result<int32_t> parse_i32(std::string_view text) noexcept;
+
+        /**
+         * @brief Decode an i64 literal (signed or unsigned interpretation)
+         */
+        Result<int64_t> parse_i64(std::string_view text) noexcept;
+
+        /**
+         * @brief Decode an f32 literal (decimal, hex, inf, nan, nan:0x...)
+         */
+        Result<float> parse_f32(std::string_view text) noexcept;
+
+        /**
+         * @brief Decode an f64 literal (decimal, hex, inf, nan, nan:0x...)
+         */
+        Result<double> parse_f64(std::string_view text) noexcept;
+
+        /**
+         * @brief Decode a string token (including quotes), appending raw bytes to @p out
+         */
+        template<typename Container>
+        Result<void> decode_string(std::string_view token, Container& out);
+
+    } // namespace text
+
+    // =========================================================================
+    // Inline Implementation - Lexer
+    // =========================================================================
+
+    inline Result<void> Lexer::skip_trivia() noexcept {
+        const size_t size = source_.size();
+        while (position_ < size) {
+            char c = source_[position_];
+            if (detail::is_space(c)) {
+                ++position_;
+            } else if (c == ';' && position_ + 1 < size && source_[position_ + 1] == ';') {
+                const size_t newline = source_.find('\n', position_);
+                position_ = newline == std::string_view::npos ? size : newline + 1;
+            } else if (c == '(' && position_ + 1 < size && source_[position_ + 1] == ';') {
+                // Block comments nest
+                size_t depth = 1;
+                position_ += 2;
+                while (depth > 0) {
+                    if (position_ + 1 >= size) {
+                        return Result<void>{ErrorCode::UnterminatedComment, "Unterminated block comment"};
+                    }
+                    if (source_[position_] == '(' && source_[position_ + 1] == ';') {
+                        ++depth;
+                        position_ += 2;
+                    } else if (source_[position_] == ';' && source_[position_ + 1] == ')') {
+                        --depth;
+                        position_ += 2;
+                    } else {
+                        ++position_;
+                    }
+                }
+            } else {
+                break;
+            }
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<Token> Lexer::next() noexcept {
+        auto trivia = skip_trivia();
+        if (!trivia) {
+            return trivia.error();
+        }
+
+        Token token;
+        token.offset = static_cast<uint32_t>(position_);
+        if (position_ >= source_.size()) {
+            token.kind = Token::Kind::End;
+            return Result<Token>{token};
+        }
+
+        const size_t start = position_;
+        const char c = source_[position_];
+        if (c == '(') {
+            ++position_;
+            token.kind = Token::Kind::LeftParen;
+        } else if (c == ')') {
+            ++position_;
+            token.kind = Token::Kind::RightParen;
+        } else if (c == '"') {
+            ++position_;
+            for (;;) {
+                if (FLIGHT_WASM_UNLIKELY(position_ >= source_.size())) {
+                    return Result<Token>{ErrorCode::UnterminatedString, "Unterminated string literal"};
+                }
+                const char s = source_[position_++];
+                if (s == '"') {
+                    break;
+                }
+                if (s == '\\') {
+                    ++position_;  // Escapes are validated when decoded
+                } else if (FLIGHT_WASM_UNLIKELY(s == '\n')) {
+                    return Result<Token>{ErrorCode::UnterminatedString, "Newline in string literal"};
+                }
+            }
+            token.kind = Token::Kind::String;
+        } else if (detail::is_idchar(c)) {
+            while (position_ < source_.size() && detail::is_idchar(source_[position_])) {
+                ++position_;
+            }
+            if (c == '$') {
+                token.kind = Token::Kind::Identifier;
+                if (position_ - start == 1) {
+                    return Result<Token>{ErrorCode::UnexpectedToken, "Empty identifier"};
+                }
+            } else if ((c >= '0' && c <= '9') || c == '+' || c == '-') {
+                token.kind = Token::Kind::Number;
+            } else if (c >= 'a' && c <= 'z') {
+                token.kind = Token::Kind::Keyword;
+            } else {
+                return Result<Token>{ErrorCode::UnexpectedToken, "Reserved token"};
+            }
+        } else {
+            return Result<Token>{ErrorCode::UnexpectedToken, "Unexpected character"};
+        }
+
+        if (position_ < source_.size() && token.kind != Token::Kind::LeftParen &&
+            token.kind != Token::Kind::RightParen) {
+            // Tokens must be separated by whitespace, comments or parentheses
+            const char follow = source_[position_];
+            if (follow != '(' && follow != ')' && follow != ';' && !detail::is_space(follow)) {
+                return Result<Token>{ErrorCode::UnexpectedToken, "Malformed token"};
+            }
+        }
+        token.text = source_.substr(start, position_ - start);
+        return Result<Token>{token};
+    }
+
+    // =========================================================================
+    // Inline Implementation - Literal decoding
+    // =========================================================================
+
+    namespace text {
+
+        inline Result<uint64_t> parse_uint(std::string_view text, uint64_t max) noexcept {
+            bool hex = text.size() > 2 && text[0] == '0' && text[1] == 'x';
+            size_t i = hex ? 2 : 0;
+            const uint64_t base = hex ? 16 : 10;
+            if (i >= text.size()) {
+                return Result<uint64_t>{ErrorCode::InvalidNumber, "Empty integer literal"};
+            }
+
+            uint64_t value = 0;
+            bool previous_digit = false;
+            for (; i < text.size(); ++i) {
+                const char c = text[i];
+                if (c == '_') {
+                    // Separators must sit between two digits
+                    if (!previous_digit || i + 1 == text.size()) {
+                        return Result<uint64_t>{ErrorCode::InvalidNumber, "Misplaced digit separator"};
+                    }
+                    previous_digit = false;
+                    continue;
+                }
+                const int digit = hex ? detail::hex_digit_value(c) : (c >= '0' && c <= '9' ? c - '0' : -1);
+                if (digit < 0) {
+                    return Result<uint64_t>{ErrorCode::InvalidNumber, "Invalid digit in integer literal"};
+                }
+                if (value > (max - static_cast<uint64_t>(digit)) / base) {
+                    return Result<uint64_t>{ErrorCode::InvalidNumber, "Integer literal out of range"};
+                }
+                value = value * base + static_cast<uint64_t>(digit);
+                previous_digit = true;
+            }
+            return Result<uint64_t>{value};
+        }
+
+        namespace detail {
+
+            template<typename Signed, typename Unsigned>
+            inline Result<Signed> parse_signed(std::string_view text) noexcept {
+                bool negative = false;
+                if (!text.empty() && (text[0] == '+' || text[0] == '-')) {
+                    negative = text[0] == '-';
+                    text.remove_prefix(1);
+                }
+                const uint64_t limit = negative
+                    ? static_cast<uint64_t>(std::numeric_limits<Signed>::max()) + 1
+                    : static_cast<uint64_t>(std::numeric_limits<Unsigned>::max());
+                auto magnitude = parse_uint(text, limit);
+                if (!magnitude) {
+                    return magnitude.error();
+                }
+                Unsigned bits = static_cast<Unsigned>(magnitude.value());
+                if (negative) {
+                    bits = static_cast<Unsigned>(Unsigned(0) - bits);
+                }
+                Signed value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return Result<Signed>{value};
+            }
+
+            template<typename Float, typename Bits>
+            inline Result<Float> parse_float(std::string_view text) noexcept {
+                constexpr int mantissa_bits = std::numeric_limits<Float>::digits - 1;
+                constexpr Bits exponent_mask = static_cast<Bits>(~Bits(0)) >> (mantissa_bits + 1) << mantissa_bits;
+                constexpr Bits sign_bit = Bits(1) << (sizeof(Bits) * 8 - 1);
+                constexpr Bits mantissa_mask = (Bits(1) << mantissa_bits) - 1;
+
+                bool negative = false;
+                std::string_view body = text;
+                if (!body.empty() && (body[0] == '+' || body[0] == '-')) {
+                    negative = body[0] == '-';
+                    body.remove_prefix(1);
+                }
+
+                Bits bits = 0;
+                if (body == "inf") {
+                    bits = exponent_mask;
+                } else if (body == "nan") {
+                    bits = exponent_mask | (Bits(1) << (mantissa_bits - 1));
+                } else if (body.size() > 6 && body.substr(0, 6) == "nan:0x") {
+                    auto payload = parse_uint(body.substr(4), mantissa_mask);
+                    if (!payload || payload.value() == 0) {
+                        return Result<Float>{ErrorCode::InvalidNumber, "Invalid NaN payload"};
+                    }
+                    bits = exponent_mask | static_cast<Bits>(payload.value());
+                } else {
+                    // strtod/strtof handle decimal and hex floats with correct
+                    // rounding; strip separators into a terminated buffer
+                    char buffer[128];
+                    std::string fallback;
+                    char* digits = buffer;
+                    if (text.size() >= sizeof(buffer)) {
+                        fallback.resize(text.size() + 1);
+                        digits = fallback.data();
+                    }
+                    size_t length = 0;
+                    bool previous_digit = false;
+                    for (char c : body) {
+                        if (c == '_') {
+                            if (!previous_digit) {
+                                return Result<Float>{ErrorCode::InvalidNumber, "Misplaced digit separator"};
+                            }
+                            previous_digit = false;
+                            continue;
+                        }
+                        previous_digit = ::flight::wasm::detail::hex_digit_value(c) >= 0;
+                        digits[length++] = c;
+                    }
+                    digits[length] = '\0';
+                    // Reject forms strtod accepts but the grammar does not (".5", "0X1", "infinity")
+                    if (length == 0 || digits[0] < '0' || digits[0] > '9' || (length > 1 && digits[1] == 'X')) {
+                        return Result<Float>{ErrorCode::InvalidNumber, "Invalid float literal"};
+                    }
+
+                    char* end = nullptr;
+                    errno = 0;
+                    Float value;
+                    if constexpr (sizeof(Float) == 4) {
+                        value = std::strtof(digits, &end);
+                    } else {
+                        value = std::strtod(digits, &end);
+                    }
+                    if (end != digits + length) {
+                        return Result<Float>{ErrorCode::InvalidNumber, "Invalid float literal"};
+                    }
+                    if (std::isinf(value)) {
+                        return Result<Float>{ErrorCode::InvalidNumber, "Float literal out of range"};
+                    }
+                    std::memcpy(&bits, &value, sizeof(bits));
+                }
+
+                if (negative) {
+                    bits |= sign_bit;
+                }
+                Float result;
+                std::memcpy(&result, &bits, sizeof(result));
+                return Result<Float>{result};
+            }
+
+        } // namespace detail
+
+        inline Result<int32_t> parse_i32(std::string_view text) noexcept {
+            return detail::parse_signed<int32_t, uint32_t>(text);
+        }
+
+        inline Result<int64_t> parse_i64(std::string_view text) noexcept {
+            return detail::parse_signed<int64_t, uint64_t>(text);
+        }
+
+        inline Result<float> parse_f32(std::string_view text) noexcept {
+            return detail::parse_float<float, uint32_t>(text);
+        }
+
+        inline Result<double> parse_f64(std::string_view text) noexcept {
+            return detail::parse_float<double, uint64_t>(text);
+        }
+
+        template<typename Container>
+        inline Result<void> decode_string(std::string_view token, Container& out) {
+            // token includes the surrounding quotes
+            const size_t end = token.size() - 1;
+            for (size_t i = 1; i < end; ++i) {
+                const char c = token[i];
+                if (c != '\\') {
+                    out.push_back(static_cast<typename Container::value_type>(c));
+                    continue;
+                }
+                if (++i >= end) {
+                    return Result<void>{ErrorCode::UnterminatedString, "Dangling escape"};
+                }
+                const char e = token[i];
+                switch (e) {
+                    case 'n':  out.push_back('\n'); break;
+                    case 't':  out.push_back('\t'); break;
+                    case 'r':  out.push_back('\r'); break;
+                    case '"':  out.push_back('"'); break;
+                    case '\'': out.push_back('\''); break;
+                    case '\\': out.push_back('\\'); break;
+                    case 'u': {
+                        // \u{hex} encodes one Unicode scalar value as UTF-8
+                        if (i + 1 >= end || token[i + 1] != '{') {
+                            return Result<void>{ErrorCode::InvalidNumber, "Malformed unicode escape"};
+                        }
+                        const size_t close = token.find('}', i + 2);
+                        if (close == std::string_view::npos || close >= end) {
+                            return Result<void>{ErrorCode::InvalidNumber, "Malformed unicode escape"};
+                        }
+                        uint64_t cp = 0;
+                        for (size_t k = i + 2; k < close; ++k) {
+                            const int digit = ::flight::wasm::detail::hex_digit_value(token[k]);
+                            if (digit < 0 || cp > 0x10FFFF) {
+                                return Result<void>{ErrorCode::InvalidNumber, "Malformed unicode escape"};
+                            }
+                            cp = cp * 16 + static_cast<uint64_t>(digit);
+                        }
+                        if (close == i + 2 || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+                            return Result<void>{ErrorCode::InvalidNumber, "Invalid unicode scalar value"};
+                        }
+                        using Byte = typename Container::value_type;
+                        if (cp < 0x80) {
+                            out.push_back(static_cast<Byte>(cp));
+                        } else if (cp < 0x800) {
+                            out.push_back(static_cast<Byte>(0xC0 | (cp >> 6)));
+                            out.push_back(static_cast<Byte>(0x80 | (cp & 0x3F)));
+                        } else if (cp < 0x10000) {
+                            out.push_back(static_cast<Byte>(0xE0 | (cp >> 12)));
+                            out.push_back(static_cast<Byte>(0x80 | ((cp >> 6) & 0x3F)));
+                            out.push_back(static_cast<Byte>(0x80 | (cp & 0x3F)));
+                        } else {
+                            out.push_back(static_cast<Byte>(0xF0 | (cp >> 18)));
+                            out.push_back(static_cast<Byte>(0x80 | ((cp >> 12) & 0x3F)));
+                            out.push_back(static_cast<Byte>(0x80 | ((cp >> 6) & 0x3F)));
+                            out.push_back(static_cast<Byte>(0x80 | (cp & 0x3F)));
+                        }
+                        i = close;
+                        break;
+                    }
+                    default: {
+                        const int high = ::flight::wasm::detail::hex_digit_value(e);
+                        const int low = i + 1 < end ? ::flight::wasm::detail::hex_digit_value(token[i + 1]) : -1;
+                        if (high < 0 || low < 0) {
+                            return Result<void>{ErrorCode::InvalidNumber, "Invalid string escape"};
+                        }
+                        out.push_back(static_cast<typename Container::value_type>((high << 4) | low));
+                        ++i;
+                        break;
+                    }
+                }
+            }
+            return Result<void>{Error{}};
+        }
+
+    } // namespace text
+
+} // namespace flight::wasm
+
+#endif // FLIGHT_WASM_TEXT_LEXER_HPP
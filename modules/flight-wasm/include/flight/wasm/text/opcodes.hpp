@@ -0,0 +1,308 @@
+#ifndef FLIGHT_WASM_TEXT_OPCODES_HPP
+#define FLIGHT_WASM_TEXT_OPCODES_HPP
+
+/**
+ * @file opcodes.hpp
+ * @brief Instruction mnemonic table shared by the text parser and encoder
+ *
+ * Covers the MVP instruction set plus sign extension, non-trapping
+ * float-to-int, bulk memory and reference types (0xFC prefix). SIMD is not
+ * included.
+ */
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+namespace flight::wasm::text {
+
+    /**
+     * @brief Immediate operands following an instruction
+     */
+    enum class ImmediateKind : uint8_t {
+        None,
+        BlockType,      // block, loop, if
+        Label,          // br, br_if
+        LabelTable,     // br_table
+        Function,       // call, ref.func
+        CallIndirect,   // typeuse + table
+        Local,
+        Global,
+        Table,          // table.get/set/grow/size/fill
+        MemArg,         // loads and stores
+        Memory,         // memory.size/grow, memory.fill (reserved byte)
+        I32,
+        I64,
+        F32,
+        F64,
+        Select,         // select (result t)*
+        RefNull,        // heap type
+        MemoryInit,     // data index + reserved byte
+        Data,           // data.drop
+        MemoryCopy,     // two reserved bytes
+        TableInit,      // elem index + table index
+        Elem,           // elem.drop
+        TableCopy       // destination + source table
+    };
+
+    /**
+     * @brief Description of one instruction
+     */
+    struct OpcodeInfo {
+        std::string_view name;
+        uint8_t prefix;       // 0 or 0xFC
+        uint8_t code;         // Opcode byte, or LEB128 sub-opcode when prefixed
+        ImmediateKind immediate;
+        uint8_t alignment;    // Natural alignment (log2) for MemArg
+    };
+
+    inline constexpr OpcodeInfo opcode_table[] = {
+        {"unreachable", 0, 0x00, ImmediateKind::None, 0},
+        {"nop", 0, 0x01, ImmediateKind::None, 0},
+        {"block", 0, 0x02, ImmediateKind::BlockType, 0},
+        {"loop", 0, 0x03, ImmediateKind::BlockType, 0},
+        {"if", 0, 0x04, ImmediateKind::BlockType, 0},
+        {"else", 0, 0x05, ImmediateKind::None, 0},
+        {"end", 0, 0x0B, ImmediateKind::None, 0},
+        {"br", 0, 0x0C, ImmediateKind::Label, 0},
+        {"br_if", 0, 0x0D, ImmediateKind::Label, 0},
+        {"br_table", 0, 0x0E, ImmediateKind::LabelTable, 0},
+        {"return", 0, 0x0F, ImmediateKind::None, 0},
+        {"call", 0, 0x10, ImmediateKind::Function, 0},
+        {"call_indirect", 0, 0x11, ImmediateKind::CallIndirect, 0},
+        {"drop", 0, 0x1A, ImmediateKind::None, 0},
+        {"select", 0, 0x1B, ImmediateKind::Select, 0},
+        {"local.get", 0, 0x20, ImmediateKind::Local, 0},
+        {"local.set", 0, 0x21, ImmediateKind::Local, 0},
+        {"local.tee", 0, 0x22, ImmediateKind::Local, 0},
+        {"global.get", 0, 0x23, ImmediateKind::Global, 0},
+        {"global.set", 0, 0x24, ImmediateKind::Global, 0},
+        {"table.get", 0, 0x25, ImmediateKind::Table, 0},
+        {"table.set", 0, 0x26, ImmediateKind::Table, 0},
+        {"i32.load", 0, 0x28, ImmediateKind::MemArg, 2},
+        {"i64.load", 0, 0x29, ImmediateKind::MemArg, 3},
+        {"f32.load", 0, 0x2A, ImmediateKind::MemArg, 2},
+        {"f64.load", 0, 0x2B, ImmediateKind::MemArg, 3},
+        {"i32.load8_s", 0, 0x2C, ImmediateKind::MemArg, 0},
+        {"i32.load8_u", 0, 0x2D, ImmediateKind::MemArg, 0},
+        {"i32.load16_s", 0, 0x2E, ImmediateKind::MemArg, 1},
+        {"i32.load16_u", 0, 0x2F, ImmediateKind::MemArg, 1},
+        {"i64.load8_s", 0, 0x30, ImmediateKind::MemArg, 0},
+        {"i64.load8_u", 0, 0x31, ImmediateKind::MemArg, 0},
+        {"i64.load16_s", 0, 0x32, ImmediateKind::MemArg, 1},
+        {"i64.load16_u", 0, 0x33, ImmediateKind::MemArg, 1},
+        {"i64.load32_s", 0, 0x34, ImmediateKind::MemArg, 2},
+        {"i64.load32_u", 0, 0x35, ImmediateKind::MemArg, 2},
+        {"i32.store", 0, 0x36, ImmediateKind::MemArg, 2},
+        {"i64.store", 0, 0x37, ImmediateKind::MemArg, 3},
+        {"f32.store", 0, 0x38, ImmediateKind::MemArg, 2},
+        {"f64.store", 0, 0x39, ImmediateKind::MemArg, 3},
+        {"i32.store8", 0, 0x3A, ImmediateKind::MemArg, 0},
+        {"i32.store16", 0, 0x3B, ImmediateKind::MemArg, 1},
+        {"i64.store8", 0, 0x3C, ImmediateKind::MemArg, 0},
+        {"i64.store16", 0, 0x3D, ImmediateKind::MemArg, 1},
+        {"i64.store32", 0, 0x3E, ImmediateKind::MemArg, 2},
+        {"memory.size", 0, 0x3F, ImmediateKind::Memory, 0},
+        {"memory.grow", 0, 0x40, ImmediateKind::Memory, 0},
+        {"i32.const", 0, 0x41, ImmediateKind::I32, 0},
+        {"i64.const", 0, 0x42, ImmediateKind::I64, 0},
+        {"f32.const", 0, 0x43, ImmediateKind::F32, 0},
+        {"f64.const", 0, 0x44, ImmediateKind::F64, 0},
+        {"i32.eqz", 0, 0x45, ImmediateKind::None, 0},
+        {"i32.eq", 0, 0x46, ImmediateKind::None, 0},
+        {"i32.ne", 0, 0x47, ImmediateKind::None, 0},
+        {"i32.lt_s", 0, 0x48, ImmediateKind::None, 0},
+        {"i32.lt_u", 0, 0x49, ImmediateKind::None, 0},
+        {"i32.gt_s", 0, 0x4A, ImmediateKind::None, 0},
+        {"i32.gt_u", 0, 0x4B, ImmediateKind::None, 0},
+        {"i32.le_s", 0, 0x4C, ImmediateKind::None, 0},
+        {"i32.le_u", 0, 0x4D, ImmediateKind::None, 0},
+        {"i32.ge_s", 0, 0x4E, ImmediateKind::None, 0},
+        {"i32.ge_u", 0, 0x4F, ImmediateKind::None, 0},
+        {"i64.eqz", 0, 0x50, ImmediateKind::None, 0},
+        {"i64.eq", 0, 0x51, ImmediateKind::None, 0},
+        {"i64.ne", 0, 0x52, ImmediateKind::None, 0},
+        {"i64.lt_s", 0, 0x53, ImmediateKind::None, 0},
+        {"i64.lt_u", 0, 0x54, ImmediateKind::None, 0},
+        {"i64.gt_s", 0, 0x55, ImmediateKind::None, 0},
+        {"i64.gt_u", 0, 0x56, ImmediateKind::None, 0},
+        {"i64.le_s", 0, 0x57, ImmediateKind::None, 0},
+        {"i64.le_u", 0, 0x58, ImmediateKind::None, 0},
+        {"i64.ge_s", 0, 0x59, ImmediateKind::None, 0},
+        {"i64.ge_u", 0, 0x5A, ImmediateKind::None, 0},
+        {"f32.eq", 0, 0x5B, ImmediateKind::None, 0},
+        {"f32.ne", 0, 0x5C, ImmediateKind::None, 0},
+        {"f32.lt", 0, 0x5D, ImmediateKind::None, 0},
+        {"f32.gt", 0, 0x5E, ImmediateKind::None, 0},
+        {"f32.le", 0, 0x5F, ImmediateKind::None, 0},
+        {"f32.ge", 0, 0x60, ImmediateKind::None, 0},
+        {"f64.eq", 0, 0x61, ImmediateKind::None, 0},
+        {"f64.ne", 0, 0x62, ImmediateKind::None, 0},
+        {"f64.lt", 0, 0x63, ImmediateKind::None, 0},
+        {"f64.gt", 0, 0x64, ImmediateKind::None, 0},
+        {"f64.le", 0, 0x65, ImmediateKind::None, 0},
+        {"f64.ge", 0, 0x66, ImmediateKind::None, 0},
+        {"i32.clz", 0, 0x67, ImmediateKind::None, 0},
+        {"i32.ctz", 0, 0x68, ImmediateKind::None, 0},
+        {"i32.popcnt", 0, 0x69, ImmediateKind::None, 0},
+        {"i32.add", 0, 0x6A, ImmediateKind::None, 0},
+        {"i32.sub", 0, 0x6B, ImmediateKind::None, 0},
+        {"i32.mul", 0, 0x6C, ImmediateKind::None, 0},
+        {"i32.div_s", 0, 0x6D, ImmediateKind::None, 0},
+        {"i32.div_u", 0, 0x6E, ImmediateKind::None, 0},
+        {"i32.rem_s", 0, 0x6F, ImmediateKind::None, 0},
+        {"i32.rem_u", 0, 0x70, ImmediateKind::None, 0},
+        {"i32.and", 0, 0x71, ImmediateKind::None, 0},
+        {"i32.or", 0, 0x72, ImmediateKind::None, 0},
+        {"i32.xor", 0, 0x73, ImmediateKind::None, 0},
+        {"i32.shl", 0, 0x74, ImmediateKind::None, 0},
+        {"i32.shr_s", 0, 0x75, ImmediateKind::None, 0},
+        {"i32.shr_u", 0, 0x76, ImmediateKind::None, 0},
+        {"i32.rotl", 0, 0x77, ImmediateKind::None, 0},
+        {"i32.rotr", 0, 0x78, ImmediateKind::None, 0},
+        {"i64.clz", 0, 0x79, ImmediateKind::None, 0},
+        {"i64.ctz", 0, 0x7A, ImmediateKind::None, 0},
+        {"i64.popcnt", 0, 0x7B, ImmediateKind::None, 0},
+        {"i64.add", 0, 0x7C, ImmediateKind::None, 0},
+        {"i64.sub", 0, 0x7D, ImmediateKind::None, 0},
+        {"i64.mul", 0, 0x7E, ImmediateKind::None, 0},
+        {"i64.div_s", 0, 0x7F, ImmediateKind::None, 0},
+        {"i64.div_u", 0, 0x80, ImmediateKind::None, 0},
+        {"i64.rem_s", 0, 0x81, ImmediateKind::None, 0},
+        {"i64.rem_u", 0, 0x82, ImmediateKind::None, 0},
+        {"i64.and", 0, 0x83, ImmediateKind::None, 0},
+        {"i64.or", 0, 0x84, ImmediateKind::None, 0},
+        {"i64.xor", 0, 0x85, ImmediateKind::None, 0},
+        {"i64.shl", 0, 0x86, ImmediateKind::None, 0},
+        {"i64.shr_s", 0, 0x87, ImmediateKind::None, 0},
+        {"i64.shr_u", 0, 0x88, ImmediateKind::None, 0},
+        {"i64.rotl", 0, 0x89, ImmediateKind::None, 0},
+        {"i64.rotr", 0, 0x8A, ImmediateKind::None, 0},
+        {"f32.abs", 0, 0x8B, ImmediateKind::None, 0},
+        {"f32.neg", 0, 0x8C, ImmediateKind::None, 0},
+        {"f32.ceil", 0, 0x8D, ImmediateKind::None, 0},
+        {"f32.floor", 0, 0x8E, ImmediateKind::None, 0},
+        {"f32.trunc", 0, 0x8F, ImmediateKind::None, 0},
+        {"f32.nearest", 0, 0x90, ImmediateKind::None, 0},
+        {"f32.sqrt", 0, 0x91, ImmediateKind::None, 0},
+        {"f32.add", 0, 0x92, ImmediateKind::None, 0},
+        {"f32.sub", 0, 0x93, ImmediateKind::None, 0},
+        {"f32.mul", 0, 0x94, ImmediateKind::None, 0},
+        {"f32.div", 0, 0x95, ImmediateKind::None, 0},
+        {"f32.min", 0, 0x96, ImmediateKind::None, 0},
+        {"f32.max", 0, 0x97, ImmediateKind::None, 0},
+        {"f32.copysign", 0, 0x98, ImmediateKind::None, 0},
+        {"f64.abs", 0, 0x99, ImmediateKind::None, 0},
+        {"f64.neg", 0, 0x9A, ImmediateKind::None, 0},
+        {"f64.ceil", 0, 0x9B, ImmediateKind::None, 0},
+        {"f64.floor", 0, 0x9C, ImmediateKind::None, 0},
+        {"f64.trunc", 0, 0x9D, ImmediateKind::None, 0},
+        {"f64.nearest", 0, 0x9E, ImmediateKind::None, 0},
+        {"f64.sqrt", 0, 0x9F, ImmediateKind::None, 0},
+        {"f64.add", 0, 0xA0, ImmediateKind::None, 0},
+        {"f64.sub", 0, 0xA1, ImmediateKind::None, 0},
+        {"f64.mul", 0, 0xA2, ImmediateKind::None, 0},
+        {"f64.div", 0, 0xA3, ImmediateKind::None, 0},
+        {"f64.min", 0, 0xA4, ImmediateKind::None, 0},
+        {"f64.max", 0, 0xA5, ImmediateKind::None, 0},
+        {"f64.copysign", 0, 0xA6, ImmediateKind::None, 0},
+        {"i32.wrap_i64", 0, 0xA7, ImmediateKind::None, 0},
+        {"i32.trunc_f32_s", 0, 0xA8, ImmediateKind::None, 0},
+        {"i32.trunc_f32_u", 0, 0xA9, ImmediateKind::None, 0},
+        {"i32.trunc_f64_s", 0, 0xAA, ImmediateKind::None, 0},
+        {"i32.trunc_f64_u", 0, 0xAB, ImmediateKind::None, 0},
+        {"i64.extend_i32_s", 0, 0xAC, ImmediateKind::None, 0},
+        {"i64.extend_i32_u", 0, 0xAD, ImmediateKind::None, 0},
+        {"i64.trunc_f32_s", 0, 0xAE, ImmediateKind::None, 0},
+        {"i64.trunc_f32_u", 0, 0xAF, ImmediateKind::None, 0},
+        {"i64.trunc_f64_s", 0, 0xB0, ImmediateKind::None, 0},
+        {"i64.trunc_f64_u", 0, 0xB1, ImmediateKind::None, 0},
+        {"f32.convert_i32_s", 0, 0xB2, ImmediateKind::None, 0},
+        {"f32.convert_i32_u", 0, 0xB3, ImmediateKind::None, 0},
+        {"f32.convert_i64_s", 0, 0xB4, ImmediateKind::None, 0},
+        {"f32.convert_i64_u", 0, 0xB5, ImmediateKind::None, 0},
+        {"f32.demote_f64", 0, 0xB6, ImmediateKind::None, 0},
+        {"f64.convert_i32_s", 0, 0xB7, ImmediateKind::None, 0},
+        {"f64.convert_i32_u", 0, 0xB8, ImmediateKind::None, 0},
+        {"f64.convert_i64_s", 0, 0xB9, ImmediateKind::None, 0},
+        {"f64.convert_i64_u", 0, 0xBA, ImmediateKind::None, 0},
+        {"f64.promote_f32", 0, 0xBB, ImmediateKind::None, 0},
+        {"i32.reinterpret_f32", 0, 0xBC, ImmediateKind::None, 0},
+        {"i64.reinterpret_f64", 0, 0xBD, ImmediateKind::None, 0},
+        {"f32.reinterpret_i32", 0, 0xBE, ImmediateKind::None, 0},
+        {"f64.reinterpret_i64", 0, 0xBF, ImmediateKind::None, 0},
+        {"i32.extend8_s", 0, 0xC0, ImmediateKind::None, 0},
+        {"i32.extend16_s", 0, 0xC1, ImmediateKind::None, 0},
+        {"i64.extend8_s", 0, 0xC2, ImmediateKind::None, 0},
+        {"i64.extend16_s", 0, 0xC3, ImmediateKind::None, 0},
+        {"i64.extend32_s", 0, 0xC4, ImmediateKind::None, 0},
+        {"ref.null", 0, 0xD0, ImmediateKind::RefNull, 0},
+        {"ref.is_null", 0, 0xD1, ImmediateKind::None, 0},
+        {"ref.func", 0, 0xD2, ImmediateKind::Function, 0},
+        {"i32.trunc_sat_f32_s", 0xFC, 0, ImmediateKind::None, 0},
+        {"i32.trunc_sat_f32_u", 0xFC, 1, ImmediateKind::None, 0},
+        {"i32.trunc_sat_f64_s", 0xFC, 2, ImmediateKind::None, 0},
+        {"i32.trunc_sat_f64_u", 0xFC, 3, ImmediateKind::None, 0},
+        {"i64.trunc_sat_f32_s", 0xFC, 4, ImmediateKind::None, 0},
+        {"i64.trunc_sat_f32_u", 0xFC, 5, ImmediateKind::None, 0},
+        {"i64.trunc_sat_f64_s", 0xFC, 6, ImmediateKind::None, 0},
+        {"i64.trunc_sat_f64_u", 0xFC, 7, ImmediateKind::None, 0},
+        {"memory.init", 0xFC, 8, ImmediateKind::MemoryInit, 0},
+        {"data.drop", 0xFC, 9, ImmediateKind::Data, 0},
+        {"memory.copy", 0xFC, 10, ImmediateKind::MemoryCopy, 0},
+        {"memory.fill", 0xFC, 11, ImmediateKind::Memory, 0},
+        {"table.init", 0xFC, 12, ImmediateKind::TableInit, 0},
+        {"elem.drop", 0xFC, 13, ImmediateKind::Elem, 0},
+        {"table.copy", 0xFC, 14, ImmediateKind::TableCopy, 0},
+        {"table.grow", 0xFC, 15, ImmediateKind::Table, 0},
+        {"table.size", 0xFC, 16, ImmediateKind::Table, 0},
+        {"table.fill", 0xFC, 17, ImmediateKind::Table, 0},
+    };
+
+    /**
+     * @brief Look up an instruction by mnemonic
+     * @return nullptr if @p name is not an instruction
+     */
+    inline const OpcodeInfo* find_opcode(std::string_view name) noexcept {
+        static const std::unordered_map<std::string_view, const OpcodeInfo*> by_name = [] {
+            std::unordered_map<std::string_view, const OpcodeInfo*> map;
+            map.reserve(sizeof(opcode_table) / sizeof(opcode_table[0]));
+            for (const auto& info : opcode_table) {
+                map.emplace(info.name, &info);
+            }
+            return map;
+        }();
+        auto entry = by_name.find(name);
+        return entry == by_name.end() ? nullptr : entry->second;
+    }
+
+    /**
+     * @brief Look up an instruction by encoding
+     * @param prefix 0 for single-byte opcodes, 0xFC for prefixed ones
+     * @return nullptr for unknown encodings
+     */
+    inline const OpcodeInfo* find_opcode(uint8_t prefix, uint32_t code) noexcept {
+        struct ByCode {
+            const OpcodeInfo* single[256] = {};
+            const OpcodeInfo* prefixed[18] = {};
+        };
+        static const ByCode by_code = [] {
+            ByCode table;
+            for (const auto& info : opcode_table) {
+                if (info.prefix == 0) {
+                    table.single[info.code] = &info;
+                } else {
+                    table.prefixed[info.code] = &info;
+                }
+            }
+            return table;
+        }();
+        if (prefix == 0) {
+            return code < 256 ? by_code.single[code] : nullptr;
+        }
+        return prefix == 0xFC && code < 18 ? by_code.prefixed[code] : nullptr;
+    }
+
+} // namespace flight::wasm::text
+
+#endif // FLIGHT_WASM_TEXT_OPCODES_HPP
@@ -3,29 +3,113 @@
 
 /**
  * @file parser.hpp
- * @brief WebAssembly Text Format (WAT) parsing functionality
- * 
- * This header provides forward declarations and basic structure for parsing
- * WebAssembly Text Format files. Full implementation is planned for future
- * development phases focused on text format support.
+ * @brief WebAssembly Text Format (WAT) parsing and printing
+ *
+ * Parsing runs in three steps: the Lexer hands out tokens as views into the
+ * source, read_sexprs() links them into an S-expression tree whose nodes come
+ * from a block arena, and TextParser lowers the tree straight into a Module
+ * (instructions are encoded with BinaryWriter as they are visited). No
+ * intermediate AST or per-token string is built.
+ *
+ * Supported: module fields in flat and abbreviated forms (inline imports,
+ * exports, table elements and memory data), named indices, plain and folded
+ * instructions for the set listed in opcodes.hpp. Not supported: SIMD,
+ * `(module binary ...)` / `(module quote ...)` and element expressions other
+ * than ref.func.
  */
 
+#include <charconv>
+#include <cmath>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <flight/wasm/utilities/error.hpp>
+#include <flight/wasm/utilities/mapped_file.hpp>
+#include <flight/wasm/types/values.hpp>
+#include <flight/wasm/types/modules.hpp>
+#include <flight/wasm/binary/encoder.hpp>
+#include <flight/wasm/text/lexer.hpp>
+#include <flight/wasm/text/opcodes.hpp>
 
 namespace flight::wasm {
 
-    // Forward declarations
-    class Module;
-    class Error;
-    template<typename T> class Result;
+    /**
+     * @brief Node of the S-expression tree
+     *
+     * Atoms carry their token; lists carry the opening parenthesis token and
+     * link their children through @c first and @c next.
+     */
+    struct SExpr {
+        Token token;
+        SExpr* first = nullptr;  // First child (lists only)
+        SExpr* next = nullptr;   // Next sibling
+
+        bool is_list() const noexcept { return token.kind == Token::Kind::LeftParen; }
+
+        bool is_atom(Token::Kind kind) const noexcept { return token.kind == kind; }
+
+        bool is_keyword(std::string_view keyword) const noexcept {
+            return token.kind == Token::Kind::Keyword && token.text == keyword;
+        }
+
+        /**
+         * @brief Check for a list headed by @p keyword, e.g. (param ...)
+         */
+        bool is_form(std::string_view keyword) const noexcept {
+            return is_list() && first != nullptr && first->is_keyword(keyword);
+        }
+    };
+
+    /**
+     * @brief Block arena owning the nodes of one S-expression tree
+     *
+     * Nodes are never freed individually; the whole tree goes away with the
+     * arena.
+     */
+    class SExprArena {
+    public:
+        /**
+         * @brief Nodes per allocation block
+         */
+        static constexpr size_t BLOCK_NODES = 4096;
+
+        SExprArena() = default;
+        SExprArena(const SExprArena&) = delete;
+        SExprArena& operator=(const SExprArena&) = delete;
+
+        /**
+         * @brief Allocate a default-initialized node
+         */
+        SExpr* allocate();
+
+        /**
+         * @brief Number of nodes handed out
+         */
+        size_t size() const noexcept { return count_; }
+
+    private:
+        std::vector<std::unique_ptr<SExpr[]>> blocks_;
+        size_t block_used_ = BLOCK_NODES;
+        size_t count_ = 0;
+    };
+
+    /**
+     * @brief Build the S-expression tree for @p source
+     * @return First top-level node (siblings linked through next), or null for empty input
+     */
+    Result<SExpr*> read_sexprs(std::string_view source, SExprArena& arena) noexcept;
 
     /**
      * @brief WebAssembly Text Format parser
-     * 
+     *
      * This parser converts WebAssembly Text Format (WAT) files into Module objects.
-     * Currently this is a placeholder for future text format support.
+     * Names in the resulting module are interned, so it does not reference
+     * the source text.
      */
     class TextParser {
     public:
@@ -52,7 +136,7 @@ namespace flight::wasm {
     private:
         TextParser() = default;
 
-        // Internal parsing methods (to be implemented in future)
+        // Internal parsing methods
         struct ParseContext;
         Result<Module> parse_module(ParseContext& context) noexcept;
         Result<void> parse_declarations(ParseContext& context, Module& module) noexcept;
@@ -60,9 +144,11 @@ namespace flight::wasm {
 
     /**
      * @brief WebAssembly text format encoder (Module to WAT)
-     * 
+     *
      * This encoder converts Module objects back to WebAssembly Text Format.
-     * Currently this is a placeholder for future text format support.
+     * Output is produced in a single pass through a streaming BinaryWriter, so
+     * encode_to() and encode_to_file() never hold the whole text in memory.
+     * Function bodies are printed as flat instruction sequences.
      */
     class TextEncoder {
     public:
@@ -78,10 +164,13 @@ namespace flight::wasm {
 
         /**
          * @brief Encoding options for text format output
+         *
+         * use_folded_expressions and max_line_length are accepted for
+         * compatibility; the printer always emits flat instructions.
          */
         struct EncodingOptions {
             bool pretty_print = true;
-            bool include_comments = false;
+            bool include_comments = false;  // Index comments and custom section notes
             bool use_folded_expressions = true;
             size_t indent_size = 2;
             size_t max_line_length = 80;
@@ -90,11 +179,25 @@ namespace flight::wasm {
         /**
          * @brief Encode with custom formatting options
          */
-        static Result<std::string> encode_with_options(const Module& module, 
+        static Result<std::string> encode_with_options(const Module& module,
                                                      const EncodingOptions& options) noexcept;
 
+        /**
+         * @brief Stream the text format to @p sink in staging-buffer sized chunks
+         * @return Number of bytes written
+         */
+        static Result<size_t> encode_to(const Module& module, const WriteCallback& sink) noexcept;
+
+        /**
+         * @brief Stream the text format to @p sink with custom formatting options
+         */
+        static Result<size_t> encode_to(const Module& module, const WriteCallback& sink,
+                                        const EncodingOptions& options) noexcept;
+
     private:
         TextEncoder() = default;
+
+        class Printer;
     };
 
     /**
@@ -103,12 +206,12 @@ namespace flight::wasm {
     class TextValidator {
     public:
         /**
-         * @brief Validate text format syntax
+         * @brief Validate text format syntax (tokens and parenthesis structure)
          */
         static Result<void> validate_syntax(std::string_view text) noexcept;
 
         /**
-         * @brief Check for common text format errors
+         * @brief Check for common text format errors (names, indices, instructions)
          */
         static Result<void> validate_semantics(std::string_view text) noexcept;
 
@@ -116,6 +219,2337 @@ namespace flight::wasm {
         TextValidator() = default;
     };
 
+    // =========================================================================
+    // Inline Implementation - S-expressions
+    // =========================================================================
+
+    inline SExpr* SExprArena::allocate() {
+        if (block_used_ == BLOCK_NODES) {
+            blocks_.emplace_back(new SExpr[BLOCK_NODES]);
+            block_used_ = 0;
+        }
+        ++count_;
+        return &blocks_.back()[block_used_++];
+    }
+
+    inline Result<SExpr*> read_sexprs(std::string_view source, SExprArena& arena) noexcept {
+        struct OpenList {
+            SExpr* list;
+            SExpr* tail;
+        };
+
+        // Explicit stack: nesting depth is bounded by memory, not the call stack
+        std::vector<OpenList> open;
+        SExpr* root = nullptr;
+        SExpr* root_tail = nullptr;
+        Lexer lexer(source);
+
+        for (;;) {
+            auto token = lexer.next();
+            if (!token) {
+                return token.error();
+            }
+            const Token& current = token.value();
+
+            if (current.kind == Token::Kind::End) {
+                if (!open.empty()) {
+                    return Result<SExpr*>{ErrorCode::UnexpectedToken, "Unclosed parenthesis"};
+                }
+                return Result<SExpr*>{root};
+            }
+            if (current.kind == Token::Kind::RightParen) {
+                if (open.empty()) {
+                    return Result<SExpr*>{ErrorCode::UnexpectedToken, "Unbalanced closing parenthesis"};
+                }
+                open.pop_back();
+                continue;
+            }
+
+            SExpr* node = arena.allocate();
+            node->token = current;
+            if (open.empty()) {
+                (root_tail != nullptr ? root_tail->next : root) = node;
+                root_tail = node;
+            } else {
+                OpenList& parent = open.back();
+                (parent.tail != nullptr ? parent.tail->next : parent.list->first) = node;
+                parent.tail = node;
+            }
+            if (current.kind == Token::Kind::LeftParen) {
+                open.push_back({node, nullptr});
+            }
+        }
+    }
+
+    // =========================================================================
+    // Inline Implementation - TextParser
+    // =========================================================================
+
+    /**
+     * @brief State for lowering one module
+     *
+     * Pass 1 (declare) assigns indices to every named entity and records type
+     * definitions; pass 2 (define) lowers fields in source order, visiting
+     * them in the same order so index counters line up.
+     */
+    struct TextParser::ParseContext {
+        enum Space : uint8_t {
+            TypeSpace,
+            FuncSpace,
+            TableSpace,
+            MemorySpace,
+            GlobalSpace,
+            ElemSpace,
+            DataSpace,
+            SpaceCount
+        };
+
+        using NameMap = std::unordered_map<std::string_view, uint32_t>;
+
+        explicit ParseContext(std::string_view text) noexcept : source(text) {}
+
+        std::string_view source;
+        SExprArena arena;
+        const SExpr* fields = nullptr;
+        Module* module = nullptr;
+
+        NameMap names[SpaceCount];
+        uint32_t counts[SpaceCount] = {};      // Pass 1: indices assigned
+        uint32_t next_index[SpaceCount] = {};  // Pass 2: index of the next field
+        bool defined[SpaceCount] = {};         // Imports must precede definitions
+        bool uses_data_count = false;          // memory.init / data.drop seen
+
+        // Function scope
+        NameMap locals;
+        uint32_t local_total = 0;
+        std::vector<std::string_view> labels;  // Innermost last; empty when unnamed
+        BinaryWriter code;
+        std::string scratch;
+
+        // Pass drivers
+        Result<void> declare(const SExpr* field);
+        Result<void> define(const SExpr* field);
+
+        // Fields
+        Result<void> define_import(const SExpr* node);
+        Result<void> define_func(const SExpr* node);
+        Result<void> define_table(const SExpr* node);
+        Result<void> define_memory(const SExpr* node);
+        Result<void> define_global(const SExpr* node);
+        Result<void> define_export(const SExpr* node);
+        Result<void> define_start(const SExpr* node);
+        Result<void> define_elem(const SExpr* node);
+        Result<void> define_data(const SExpr* node);
+
+        // Shared pieces
+        Result<void> bind(Space space, const SExpr*& node);
+        Result<uint32_t> resolve(Space space, const SExpr* node) const noexcept;
+        Result<std::string_view> name(const SExpr* node);
+        Result<void> inline_exports(const SExpr*& node, Export::Kind kind, uint32_t index);
+        Result<Import::Descriptor> import_descriptor(Import::Kind kind, const SExpr*& node);
+        Result<void> inline_import(Import::Kind kind, const SExpr*& node);
+        Result<void> signature(const SExpr*& node, FunctionType& type, bool bind_locals);
+        Result<uint32_t> type_use(const SExpr*& node, bool bind_locals);
+        Result<Limits> limits(const SExpr*& node) noexcept;
+        Result<GlobalType> global_type(const SExpr*& node) noexcept;
+        Result<std::vector<uint8_t>> constant(const SExpr* node, bool folded_only);
+
+        // Instructions
+        Result<void> instructions(const SExpr* node);
+        Result<void> plain(const SExpr*& node);
+        Result<void> folded(const SExpr* list);
+        Result<void> lower(const SExpr* start, bool sequence);
+        Result<void> immediates(const text::OpcodeInfo& info, const SExpr*& node);
+        Result<void> block_type(const SExpr*& node);
+        Result<uint32_t> label(const SExpr* node) const noexcept;
+        void write_opcode(const text::OpcodeInfo& info);
+        void open_label(const SExpr*& node);
+
+        static bool is_index(const SExpr* node) noexcept {
+            return node != nullptr &&
+                   (node->is_atom(Token::Kind::Number) || node->is_atom(Token::Kind::Identifier));
+        }
+
+        static void skip_id(const SExpr*& node) noexcept {
+            if (node != nullptr && node->is_atom(Token::Kind::Identifier)) {
+                node = node->next;
+            }
+        }
+
+        static bool is_type_form(const SExpr* node) noexcept {
+            return node->is_form("type") || node->is_form("param") || node->is_form("result");
+        }
+
+        static Result<ValueType> value_type(const SExpr* node) noexcept;
+        static Result<ValueType> reference_type(const SExpr* node) noexcept;
+    };
+
+    inline Result<ValueType> TextParser::ParseContext::value_type(const SExpr* node) noexcept {
+        if (node != nullptr && node->is_atom(Token::Kind::Keyword)) {
+            const std::string_view t = node->token.text;
+            if (t == "i32") return Result<ValueType>{ValueType::I32};
+            if (t == "i64") return Result<ValueType>{ValueType::I64};
+            if (t == "f32") return Result<ValueType>{ValueType::F32};
+            if (t == "f64") return Result<ValueType>{ValueType::F64};
+            if (t == "v128") return Result<ValueType>{ValueType::V128};
+            if (t == "funcref") return Result<ValueType>{ValueType::FuncRef};
+            if (t == "externref") return Result<ValueType>{ValueType::ExternRef};
+        }
+        return Result<ValueType>{ErrorCode::UnexpectedToken, "Expected a value type"};
+    }
+
+    inline Result<ValueType> TextParser::ParseContext::reference_type(const SExpr* node) noexcept {
+        if (node != nullptr && node->is_keyword("funcref")) return Result<ValueType>{ValueType::FuncRef};
+        if (node != nullptr && node->is_keyword("externref")) return Result<ValueType>{ValueType::ExternRef};
+        return Result<ValueType>{ErrorCode::UnexpectedToken, "Expected a reference type"};
+    }
+
+    inline Result<void> TextParser::ParseContext::bind(Space space, const SExpr*& node) {
+        const uint32_t index = counts[space]++;
+        if (node != nullptr && node->is_atom(Token::Kind::Identifier)) {
+            if (!names[space].emplace(node->token.text, index).second) {
+                return Result<void>{ErrorCode::DuplicateIdentifier, "Duplicate identifier"};
+            }
+            node = node->next;
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<uint32_t> TextParser::ParseContext::resolve(Space space, const SExpr* node) const noexcept {
+        if (node != nullptr && node->is_atom(Token::Kind::Number)) {
+            return text::parse_u32(node->token.text);
+        }
+        if (node != nullptr && node->is_atom(Token::Kind::Identifier)) {
+            auto found = names[space].find(node->token.text);
+            if (found == names[space].end()) {
+                return Result<uint32_t>{ErrorCode::UnknownIdentifier, "Unknown identifier"};
+            }
+            return Result<uint32_t>{found->second};
+        }
+        return Result<uint32_t>{ErrorCode::UnexpectedToken, "Expected an index"};
+    }
+
+    inline Result<std::string_view> TextParser::ParseContext::name(const SExpr* node) {
+        if (node == nullptr || !node->is_atom(Token::Kind::String)) {
+            return Result<std::string_view>{ErrorCode::UnexpectedToken, "Expected a string"};
+        }
+        std::string_view raw = node->token.text.substr(1, node->token.text.size() - 2);
+        if (raw.find('\\') != std::string_view::npos) {
+            scratch.clear();
+            auto decoded = text::decode_string(node->token.text, scratch);
+            if (!decoded) {
+                return decoded.error();
+            }
+            raw = scratch;
+        }
+        if (!detail::is_valid_utf8(reinterpret_cast<const uint8_t*>(raw.data()), raw.size())) {
+            return Result<std::string_view>{ErrorCode::InvalidUTF8Sequence, "Name is not valid UTF-8"};
+        }
+        return Result<std::string_view>{module->intern(raw)};
+    }
+
+    inline Result<void> TextParser::ParseContext::inline_exports(const SExpr*& node, Export::Kind kind,
+                                                                  uint32_t index) {
+        while (node != nullptr && node->is_form("export")) {
+            auto export_name = name(node->first->next);
+            if (!export_name) {
+                return export_name.error();
+            }
+            module->exports.emplace_back(export_name.value(), kind, index);
+            node = node->next;
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<Import::Descriptor> TextParser::ParseContext::import_descriptor(Import::Kind kind,
+                                                                                   const SExpr*& node) {
+        switch (kind) {
+            case Import::Kind::Function: {
+                auto type = type_use(node, false);
+                if (!type) {
+                    return type.error();
+                }
+                return Result<Import::Descriptor>{Import::Descriptor(type.value())};
+            }
+            case Import::Kind::Table: {
+                auto table_limits = limits(node);
+                if (!table_limits) {
+                    return table_limits.error();
+                }
+                auto element = reference_type(node);
+                if (!element) {
+                    return element.error();
+                }
+                node = node->next;
+                return Result<Import::Descriptor>{Import::Descriptor(TableType(element.value(), table_limits.value()))};
+            }
+            case Import::Kind::Memory: {
+                auto memory_limits = limits(node);
+                if (!memory_limits) {
+                    return memory_limits.error();
+                }
+                return Result<Import::Descriptor>{Import::Descriptor(MemoryType(memory_limits.value()))};
+            }
+            case Import::Kind::Global: {
+                auto type = global_type(node);
+                if (!type) {
+                    return type.error();
+                }
+                return Result<Import::Descriptor>{Import::Descriptor(type.value())};
+            }
+        }
+        return Result<Import::Descriptor>{ErrorCode::UnexpectedToken, "Invalid import kind"};
+    }
+
+    inline Result<void> TextParser::ParseContext::inline_import(Import::Kind kind, const SExpr*& node) {
+        // node is (import "module" "field"); the descriptor follows it
+        auto module_name = name(node->first->next);
+        if (!module_name) {
+            return module_name.error();
+        }
+        auto field_name = name(node->first->next->next);
+        if (!field_name) {
+            return field_name.error();
+        }
+        if (node->first->next->next->next != nullptr) {
+            return Result<void>{ErrorCode::UnexpectedToken, "Unexpected token in import"};
+        }
+        node = node->next;
+        auto descriptor = import_descriptor(kind, node);
+        if (!descriptor) {
+            return descriptor.error();
+        }
+        if (node != nullptr) {
+            return Result<void>{ErrorCode::UnexpectedToken, "Unexpected token after import"};
+        }
+        module->imports.emplace_back(module_name.value(), field_name.value(), kind, descriptor.value());
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextParser::ParseContext::signature(const SExpr*& node, FunctionType& type,
+                                                            bool bind_locals) {
+        for (; node != nullptr && node->is_form("param"); node = node->next) {
+            const SExpr* item = node->first->next;
+            if (item != nullptr && item->is_atom(Token::Kind::Identifier)) {
+                // (param $name type) names exactly one parameter
+                const auto index = static_cast<uint32_t>(type.params.size());
+                if (bind_locals && !locals.emplace(item->token.text, index).second) {
+                    return Result<void>{ErrorCode::DuplicateIdentifier, "Duplicate local name"};
+                }
+                auto param = value_type(item->next);
+                if (!param) {
+                    return param.error();
+                }
+                if (item->next->next != nullptr) {
+                    return Result<void>{ErrorCode::UnexpectedToken, "Named parameter takes one type"};
+                }
+                type.params.push_back(param.value());
+                continue;
+            }
+            for (; item != nullptr; item = item->next) {
+                auto param = value_type(item);
+                if (!param) {
+                    return param.error();
+                }
+                type.params.push_back(param.value());
+            }
+        }
+        for (; node != nullptr && node->is_form("result"); node = node->next) {
+            for (const SExpr* item = node->first->next; item != nullptr; item = item->next) {
+                auto result = value_type(item);
+                if (!result) {
+                    return result.error();
+                }
+                type.results.push_back(result.value());
+            }
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<uint32_t> TextParser::ParseContext::type_use(const SExpr*& node, bool bind_locals) {
+        bool explicit_index = false;
+        uint32_t index = 0;
+        if (node != nullptr && node->is_form("type")) {
+            auto resolved = resolve(TypeSpace, node->first->next);
+            if (!resolved) {
+                return resolved.error();
+            }
+            if (resolved.value() >= module->types.size()) {
+                return Result<uint32_t>{ErrorCode::InvalidTypeIndex, "Type index out of range"};
+            }
+            index = resolved.value();
+            explicit_index = true;
+            node = node->next;
+        }
+
+        FunctionType inline_type;
+        auto parsed = signature(node, inline_type, bind_locals);
+        if (!parsed) {
+            return parsed.error();
+        }
+
+        if (explicit_index) {
+            const FunctionType& declared = module->types[index];
+            const bool has_inline = !inline_type.params.empty() || !inline_type.results.empty();
+            if (has_inline && (declared.params != inline_type.params || declared.results != inline_type.results)) {
+                return Result<uint32_t>{ErrorCode::TypeMismatch, "Inline signature does not match type"};
+            }
+            return Result<uint32_t>{index};
+        }
+
+        // Implicit type use: reuse an identical signature or append one
+        for (uint32_t i = 0; i < module->types.size(); ++i) {
+            if (module->types[i].params == inline_type.params && module->types[i].results == inline_type.results) {
+                return Result<uint32_t>{i};
+            }
+        }
+        module->types.push_back(std::move(inline_type));
+        return Result<uint32_t>{static_cast<uint32_t>(module->types.size() - 1)};
+    }
+
+    inline Result<Limits> TextParser::ParseContext::limits(const SExpr*& node) noexcept {
+        if (node == nullptr || !node->is_atom(Token::Kind::Number)) {
+            return Result<Limits>{ErrorCode::UnexpectedToken, "Expected limits"};
+        }
+        auto minimum = text::parse_u32(node->token.text);
+        if (!minimum) {
+            return minimum.error();
+        }
+        node = node->next;
+        if (node != nullptr && node->is_atom(Token::Kind::Number)) {
+            auto maximum = text::parse_u32(node->token.text);
+            if (!maximum) {
+                return maximum.error();
+            }
+            node = node->next;
+            return Result<Limits>{Limits(minimum.value(), maximum.value())};
+        }
+        return Result<Limits>{Limits(minimum.value())};
+    }
+
+    inline Result<GlobalType> TextParser::ParseContext::global_type(const SExpr*& node) noexcept {
+        if (node != nullptr && node->is_form("mut")) {
+            auto type = value_type(node->first->next);
+            if (!type) {
+                return type.error();
+            }
+            if (node->first->next->next != nullptr) {
+                return Result<GlobalType>{ErrorCode::UnexpectedToken, "Unexpected token in global type"};
+            }
+            node = node->next;
+            return Result<GlobalType>{GlobalType(type.value(), true)};
+        }
+        auto type = value_type(node);
+        if (!type) {
+            return type.error();
+        }
+        node = node->next;
+        return Result<GlobalType>{GlobalType(type.value(), false)};
+    }
+
+    inline Result<std::vector<uint8_t>> TextParser::ParseContext::constant(const SExpr* node, bool folded_only) {
+        code.clear();
+        labels.clear();
+        locals.clear();
+        local_total = 0;
+        auto lowered = folded_only ? folded(node) : instructions(node);
+        if (!lowered) {
+            return lowered.error();
+        }
+        if (!labels.empty()) {
+            return Result<std::vector<uint8_t>>{ErrorCode::UnexpectedToken, "Unclosed block"};
+        }
+        code.write_byte(0x0B);
+        return Result<std::vector<uint8_t>>{code.take()};
+    }
+
+    inline Result<void> TextParser::ParseContext::declare(const SExpr* field) {
+        if (!field->is_list() || field->first == nullptr || !field->first->is_atom(Token::Kind::Keyword)) {
+            return Result<void>{ErrorCode::UnexpectedToken, "Expected a module field"};
+        }
+        const std::string_view kind = field->first->token.text;
+        const SExpr* node = field->first->next;
+
+        if (kind == "type") {
+            auto bound = bind(TypeSpace, node);
+            if (!bound) {
+                return bound;
+            }
+            if (node == nullptr || !node->is_form("func") || node->next != nullptr) {
+                return Result<void>{ErrorCode::UnexpectedToken, "Expected a function type"};
+            }
+            const SExpr* item = node->first->next;
+            FunctionType type;
+            auto parsed = signature(item, type, false);
+            if (!parsed) {
+                return parsed;
+            }
+            if (item != nullptr) {
+                return Result<void>{ErrorCode::UnexpectedToken, "Unexpected token in function type"};
+            }
+            module->types.push_back(std::move(type));
+            return Result<void>{Error{}};
+        }
+
+        if (kind == "import") {
+            const SExpr* descriptor = node != nullptr && node->next != nullptr ? node->next->next : nullptr;
+            if (descriptor == nullptr || !descriptor->is_list() || descriptor->first == nullptr) {
+                return Result<void>{ErrorCode::UnexpectedToken, "Expected an import descriptor"};
+            }
+            const std::string_view what = descriptor->first->token.text;
+            Space space;
+            if (what == "func") space = FuncSpace;
+            else if (what == "table") space = TableSpace;
+            else if (what == "memory") space = MemorySpace;
+            else if (what == "global") space = GlobalSpace;
+            else return Result<void>{ErrorCode::UnexpectedToken, "Invalid import kind"};
+            if (defined[space]) {
+                return Result<void>{ErrorCode::UnexpectedToken, "Import after definition"};
+            }
+            const SExpr* id = descriptor->first->next;
+            return bind(space, id);
+        }
+
+        Space space;
+        if (kind == "func") space = FuncSpace;
+        else if (kind == "table") space = TableSpace;
+        else if (kind == "memory") space = MemorySpace;
+        else if (kind == "global") space = GlobalSpace;
+        else if (kind == "elem") return bind(ElemSpace, node);
+        else if (kind == "data") return bind(DataSpace, node);
+        else if (kind == "export" || kind == "start") return Result<void>{Error{}};
+        else return Result<void>{ErrorCode::UnexpectedToken, "Unknown module field"};
+
+        auto bound = bind(space, node);
+        if (!bound) {
+            return bound;
+        }
+        while (node != nullptr && node->is_form("export")) {
+            node = node->next;
+        }
+        if (node != nullptr && node->is_form("import")) {
+            if (defined[space]) {
+                return Result<void>{ErrorCode::UnexpectedToken, "Import after definition"};
+            }
+            return Result<void>{Error{}};
+        }
+        defined[space] = true;
+
+        // Inline table elements and memory data declare an unnamed segment
+        for (; node != nullptr; node = node->next) {
+            if (space == TableSpace && node->is_form("elem")) ++counts[ElemSpace];
+            if (space == MemorySpace && node->is_form("data")) ++counts[DataSpace];
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextParser::ParseContext::define(const SExpr* field) {
+        const std::string_view kind = field->first->token.text;
+        const SExpr* node = field->first->next;
+        if (kind == "type") return Result<void>{Error{}};  // Recorded in pass 1
+        if (kind == "import") return define_import(node);
+        if (kind == "func") return define_func(node);
+        if (kind == "table") return define_table(node);
+        if (kind == "memory") return define_memory(node);
+        if (kind == "global") return define_global(node);
+        if (kind == "export") return define_export(node);
+        if (kind == "start") return define_start(node);
+        if (kind == "elem") return define_elem(node);
+        return define_data(node);
+    }
+
+    inline Result<void> TextParser::ParseContext::define_import(const SExpr* node) {
+        auto module_name = name(node);
+        if (!module_name) {
+            return module_name.error();
+        }
+        auto field_name = name(node->next);
+        if (!field_name) {
+            return field_name.error();
+        }
+        const SExpr* descriptor = node->next->next;
+        if (descriptor->next != nullptr) {
+            return Result<void>{ErrorCode::UnexpectedToken, "Unexpected token after import"};
+        }
+
+        const std::string_view what = descriptor->first->token.text;
+        Import::Kind kind;
+        Space space;
+        if (what == "func") { kind = Import::Kind::Function; space = FuncSpace; }
+        else if (what == "table") { kind = Import::Kind::Table; space = TableSpace; }
+        else if (what == "memory") { kind = Import::Kind::Memory; space = MemorySpace; }
+        else { kind = Import::Kind::Global; space = GlobalSpace; }
+        ++next_index[space];
+
+        const SExpr* item = descriptor->first->next;
+        skip_id(item);
+        auto desc = import_descriptor(kind, item);
+        if (!desc) {
+            return desc.error();
+        }
+        if (item != nullptr) {
+            return Result<void>{ErrorCode::UnexpectedToken, "Unexpected token in import descriptor"};
+        }
+        module->imports.emplace_back(module_name.value(), field_name.value(), kind, desc.value());
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextParser::ParseContext::define_func(const SExpr* node) {
+        const uint32_t index = next_index[FuncSpace]++;
+        skip_id(node);
+        auto exported = inline_exports(node, Export::Kind::Function, index);
+        if (!exported) {
+            return exported;
+        }
+        if (node != nullptr && node->is_form("import")) {
+            return inline_import(Import::Kind::Function, node);
+        }
+
+        locals.clear();
+        labels.clear();
+        auto type = type_use(node, true);
+        if (!type) {
+            return type.error();
+        }
+        local_total = static_cast<uint32_t>(module->types[type.value()].params.size());
+
+        std::vector<ValueType> declared;
+        for (; node != nullptr && node->is_form("local"); node = node->next) {
+            const SExpr* item = node->first->next;
+            if (item != nullptr && item->is_atom(Token::Kind::Identifier)) {
+                if (!locals.emplace(item->token.text, local_total).second) {
+                    return Result<void>{ErrorCode::DuplicateIdentifier, "Duplicate local name"};
+                }
+                auto local = value_type(item->next);
+                if (!local) {
+                    return local.error();
+                }
+                if (item->next->next != nullptr) {
+                    return Result<void>{ErrorCode::UnexpectedToken, "Named local takes one type"};
+                }
+                declared.push_back(local.value());
+                ++local_total;
+                continue;
+            }
+            for (; item != nullptr; item = item->next) {
+                auto local = value_type(item);
+                if (!local) {
+                    return local.error();
+                }
+                declared.push_back(local.value());
+                ++local_total;
+            }
+        }
+
+        code.clear();
+        auto body = instructions(node);
+        if (!body) {
+            return body;
+        }
+        if (!labels.empty()) {
+            return Result<void>{ErrorCode::UnexpectedToken, "Unclosed block"};
+        }
+        code.write_byte(0x0B);
+        module->function_type_indices.push_back(type.value());
+        module->functions.emplace_back(type.value(), std::move(declared), code.take());
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextParser::ParseContext::define_table(const SExpr* node) {
+        const uint32_t index = next_index[TableSpace]++;
+        skip_id(node);
+        auto exported = inline_exports(node, Export::Kind::Table, index);
+        if (!exported) {
+            return exported;
+        }
+        if (node != nullptr && node->is_form("import")) {
+            return inline_import(Import::Kind::Table, node);
+        }
+
+        if (node != nullptr && node->is_atom(Token::Kind::Keyword) && node->next != nullptr &&
+            node->next->is_form("elem")) {
+            // (table reftype (elem x*)) sizes the table to fit an active segment at 0
+            auto element_type = reference_type(node);
+            if (!element_type) {
+                return element_type.error();
+            }
+            Element segment;
+            segment.mode = Element::Mode::Active;
+            segment.table_index = index;
+            segment.offset_bytes = {0x41, 0x00, 0x0B};  // i32.const 0
+            segment.element_type = element_type.value();
+            for (const SExpr* item = node->next->first->next; item != nullptr; item = item->next) {
+                auto function = resolve(FuncSpace, item);
+                if (!function) {
+                    return function.error();
+                }
+                segment.function_indices.push_back(function.value());
+            }
+            if (node->next->next != nullptr) {
+                return Result<void>{ErrorCode::UnexpectedToken, "Unexpected token after table elements"};
+            }
+            const auto size = static_cast<uint32_t>(segment.function_indices.size());
+            module->tables.emplace_back(element_type.value(), Limits(size, size));
+            module->elements.push_back(std::move(segment));
+            ++next_index[ElemSpace];
+            return Result<void>{Error{}};
+        }
+
+        auto table_limits = limits(node);
+        if (!table_limits) {
+            return table_limits.error();
+        }
+        auto element_type = reference_type(node);
+        if (!element_type) {
+            return element_type.error();
+        }
+        if (node->next != nullptr) {
+            return Result<void>{ErrorCode::UnexpectedToken, "Unexpected token in table"};
+        }
+        module->tables.emplace_back(element_type.value(), table_limits.value());
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextParser::ParseContext::define_memory(const SExpr* node) {
+        const uint32_t index = next_index[MemorySpace]++;
+        skip_id(node);
+        auto exported = inline_exports(node, Export::Kind::Memory, index);
+        if (!exported) {
+            return exported;
+        }
+        if (node != nullptr && node->is_form("import")) {
+            return inline_import(Import::Kind::Memory, node);
+        }
+
+        if (node != nullptr && node->is_form("data")) {
+            // (memory (data "...")) sizes the memory to fit an active segment at 0
+            Data segment;
+            segment.mode = Data::Mode::Active;
+            segment.memory_index = index;
+            segment.offset_bytes = {0x41, 0x00, 0x0B};  // i32.const 0
+            for (const SExpr* item = node->first->next; item != nullptr; item = item->next) {
+                if (!item->is_atom(Token::Kind::String)) {
+                    return Result<void>{ErrorCode::UnexpectedToken, "Expected a data string"};
+                }
+                auto decoded = text::decode_string(item->token.text, segment.data);
+                if (!decoded) {
+                    return decoded;
+                }
+            }
+            if (node->next != nullptr) {
+                return Result<void>{ErrorCode::UnexpectedToken, "Unexpected token after memory data"};
+            }
+            const auto pages = static_cast<uint32_t>((segment.data.size() + 65535) / 65536);
+            module->memories.emplace_back(Limits(pages, pages));
+            module->data.push_back(std::move(segment));
+            ++next_index[DataSpace];
+            return Result<void>{Error{}};
+        }
+
+        auto memory_limits = limits(node);
+        if (!memory_limits) {
+            return memory_limits.error();
+        }
+        if (node != nullptr) {
+            return Result<void>{ErrorCode::UnexpectedToken, "Unexpected token in memory"};
+        }
+        module->memories.emplace_back(memory_limits.value());
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextParser::ParseContext::define_global(const SExpr* node) {
+        const uint32_t index = next_index[GlobalSpace]++;
+        skip_id(node);
+        auto exported = inline_exports(node, Export::Kind::Global, index);
+        if (!exported) {
+            return exported;
+        }
+        if (node != nullptr && node->is_form("import")) {
+            return inline_import(Import::Kind::Global, node);
+        }
+
+        auto type = global_type(node);
+        if (!type) {
+            return type.error();
+        }
+        auto initializer = constant(node, false);
+        if (!initializer) {
+            return initializer.error();
+        }
+        module->globals.emplace_back(type.value(), std::move(initializer.value()));
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextParser::ParseContext::define_export(const SExpr* node) {
+        auto export_name = name(node);
+        if (!export_name) {
+            return export_name.error();
+        }
+        const SExpr* descriptor = node->next;
+        if (descriptor == nullptr || !descriptor->is_list() || descriptor->first == nullptr ||
+            descriptor->next != nullptr) {
+            return Result<void>{ErrorCode::UnexpectedToken, "Expected an export descriptor"};
+        }
+
+        const std::string_view what = descriptor->first->token.text;
+        Export::Kind kind;
+        Space space;
+        if (what == "func") { kind = Export::Kind::Function; space = FuncSpace; }
+        else if (what == "table") { kind = Export::Kind::Table; space = TableSpace; }
+        else if (what == "memory") { kind = Export::Kind::Memory; space = MemorySpace; }
+        else if (what == "global") { kind = Export::Kind::Global; space = GlobalSpace; }
+        else return Result<void>{ErrorCode::UnexpectedToken, "Invalid export kind"};
+
+        auto index = resolve(space, descriptor->first->next);
+        if (!index) {
+            return index.error();
+        }
+        module->exports.emplace_back(export_name.value(), kind, index.value());
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextParser::ParseContext::define_start(const SExpr* node) {
+        auto index = resolve(FuncSpace, node);
+        if (!index) {
+            return index.error();
+        }
+        if (module->has_start_function) {
+            return Result<void>{ErrorCode::UnexpectedToken, "Multiple start functions"};
+        }
+        module->start_function_index = index.value();
+        module->has_start_function = true;
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextParser::ParseContext::define_elem(const SExpr* node) {
+        ++next_index[ElemSpace];
+        skip_id(node);
+
+        Element segment;
+        segment.mode = Element::Mode::Passive;
+        segment.table_index = 0;
+        segment.element_type = ValueType::FuncRef;
+
+        if (node != nullptr && node->is_keyword("declare")) {
+            segment.mode = Element::Mode::Declarative;
+            node = node->next;
+        } else {
+            if (node != nullptr && node->is_form("table")) {
+                auto table = resolve(TableSpace, node->first->next);
+                if (!table) {
+                    return table.error();
+                }
+                segment.table_index = table.value();
+                segment.mode = Element::Mode::Active;
+                node = node->next;
+            }
+            if (node != nullptr && node->is_list() && !node->is_form("item") && !node->is_form("ref.func")) {
+                // (offset instr*) or the single folded instruction abbreviation
+                const bool explicit_offset = node->is_form("offset");
+                auto offset = explicit_offset ? constant(node->first->next, false) : constant(node, true);
+                if (!offset) {
+                    return offset.error();
+                }
+                segment.offset_bytes = std::move(offset.value());
+                segment.mode = Element::Mode::Active;
+                node = node->next;
+            } else if (segment.mode == Element::Mode::Active) {
+                return Result<void>{ErrorCode::UnexpectedToken, "Active element segment needs an offset"};
+            }
+        }
+
+        if (node != nullptr && node->is_keyword("func")) {
+            node = node->next;
+        } else if (node != nullptr && node->is_atom(Token::Kind::Keyword)) {
+            auto element_type = reference_type(node);
+            if (!element_type) {
+                return element_type.error();
+            }
+            segment.element_type = element_type.value();
+            node = node->next;
+        } else if (segment.mode != Element::Mode::Active) {
+            return Result<void>{ErrorCode::UnexpectedToken, "Expected an element type"};
+        }
+
+        for (; node != nullptr; node = node->next) {
+            const SExpr* item = node;
+            if (item->is_form("item")) {
+                item = item->first->next;
+                if (item == nullptr || item->next != nullptr) {
+                    return Result<void>{ErrorCode::UnsupportedInstruction, "Element item must be one ref.func"};
+                }
+            }
+            if (item->is_form("ref.func")) {
+                item = item->first->next;
+            } else if (item->is_list()) {
+                return Result<void>{ErrorCode::UnsupportedInstruction, "Only ref.func element expressions are supported"};
+            }
+            auto function = resolve(FuncSpace, item);
+            if (!function) {
+                return function.error();
+            }
+            segment.function_indices.push_back(function.value());
+        }
+        module->elements.push_back(std::move(segment));
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextParser::ParseContext::define_data(const SExpr* node) {
+        ++next_index[DataSpace];
+        skip_id(node);
+
+        Data segment;
+        segment.mode = Data::Mode::Passive;
+        segment.memory_index = 0;
+
+        if (node != nullptr && node->is_form("memory")) {
+            auto memory = resolve(MemorySpace, node->first->next);
+            if (!memory) {
+                return memory.error();
+            }
+            segment.memory_index = memory.value();
+            segment.mode = Data::Mode::Active;
+            node = node->next;
+        }
+        if (node != nullptr && node->is_list()) {
+            const bool explicit_offset = node->is_form("offset");
+            auto offset = explicit_offset ? constant(node->first->next, false) : constant(node, true);
+            if (!offset) {
+                return offset.error();
+            }
+            segment.offset_bytes = std::move(offset.value());
+            segment.mode = Data::Mode::Active;
+            node = node->next;
+        } else if (segment.mode == Data::Mode::Active) {
+            return Result<void>{ErrorCode::UnexpectedToken, "Active data segment needs an offset"};
+        }
+
+        for (; node != nullptr; node = node->next) {
+            if (!node->is_atom(Token::Kind::String)) {
+                return Result<void>{ErrorCode::UnexpectedToken, "Expected a data string"};
+            }
+            auto decoded = text::decode_string(node->token.text, segment.data);
+            if (!decoded) {
+                return decoded;
+            }
+        }
+        module->data.push_back(std::move(segment));
+        return Result<void>{Error{}};
+    }
+
+    inline void TextParser::ParseContext::write_opcode(const text::OpcodeInfo& info) {
+        if (info.prefix != 0) {
+            code.write_byte(info.prefix);
+            code.write_leb128_u32(info.code);
+        } else {
+            code.write_byte(info.code);
+        }
+    }
+
+    inline void TextParser::ParseContext::open_label(const SExpr*& node) {
+        if (node != nullptr && node->is_atom(Token::Kind::Identifier)) {
+            labels.push_back(node->token.text);
+            node = node->next;
+        } else {
+            labels.emplace_back();
+        }
+    }
+
+    inline Result<uint32_t> TextParser::ParseContext::label(const SExpr* node) const noexcept {
+        if (node != nullptr && node->is_atom(Token::Kind::Identifier)) {
+            for (size_t i = labels.size(); i-- > 0;) {
+                if (labels[i] == node->token.text) {
+                    return Result<uint32_t>{static_cast<uint32_t>(labels.size() - 1 - i)};
+                }
+            }
+            return Result<uint32_t>{ErrorCode::UnknownIdentifier, "Unknown label"};
+        }
+        if (node != nullptr && node->is_atom(Token::Kind::Number)) {
+            return text::parse_u32(node->token.text);
+        }
+        return Result<uint32_t>{ErrorCode::UnexpectedToken, "Expected a label"};
+    }
+
+    inline Result<void> TextParser::ParseContext::block_type(const SExpr*& node) {
+        // Zero or one result and no parameters encode inline; anything else is a type index
+        const SExpr* probe = node;
+        const SExpr* result = nullptr;
+        size_t result_count = 0;
+        const bool inline_form = probe == nullptr || !(probe->is_form("type") || probe->is_form("param"));
+        if (inline_form) {
+            for (; probe != nullptr && probe->is_form("result"); probe = probe->next) {
+                for (const SExpr* item = probe->first->next; item != nullptr; item = item->next) {
+                    result = item;
+                    ++result_count;
+                }
+            }
+        }
+        if (inline_form && result_count <= 1) {
+            if (result == nullptr) {
+                code.write_byte(static_cast<uint8_t>(ValueType::EmptyBlockType));
+            } else {
+                auto type = value_type(result);
+                if (!type) {
+                    return type.error();
+                }
+                code.write_byte(static_cast<uint8_t>(type.value()));
+            }
+            node = probe;
+            return Result<void>{Error{}};
+        }
+        auto index = type_use(node, false);
+        if (!index) {
+            return index.error();
+        }
+        code.write_leb128_i64(index.value());  // s33
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextParser::ParseContext::instructions(const SExpr* node) {
+        return lower(node, true);
+    }
+
+    inline Result<void> TextParser::ParseContext::plain(const SExpr*& node) {
+        if (!node->is_atom(Token::Kind::Keyword)) {
+            return Result<void>{ErrorCode::UnexpectedToken, "Expected an instruction"};
+        }
+        const text::OpcodeInfo* info = text::find_opcode(node->token.text);
+        if (info == nullptr) {
+            return Result<void>{ErrorCode::UnknownOpcode, "Unknown instruction"};
+        }
+        node = node->next;
+
+        if (info->prefix == 0 && (info->code == 0x05 || info->code == 0x0B)) {
+            // else / end close (and for else, reopen) the innermost block
+            if (labels.empty()) {
+                return Result<void>{ErrorCode::UnexpectedToken, "Unmatched else or end"};
+            }
+            if (node != nullptr && node->is_atom(Token::Kind::Identifier)) {
+                if (node->token.text != labels.back()) {
+                    return Result<void>{ErrorCode::UnexpectedToken, "Mismatched block label"};
+                }
+                node = node->next;
+            }
+            if (info->code == 0x0B) {
+                labels.pop_back();
+            }
+            code.write_byte(info->code);
+            return Result<void>{Error{}};
+        }
+        return immediates(*info, node);
+    }
+
+    inline Result<void> TextParser::ParseContext::folded(const SExpr* list) {
+        return lower(list, false);
+    }
+
+    inline Result<void> TextParser::ParseContext::lower(const SExpr* start, bool sequence) {
+        enum class Step : uint8_t {
+            Sequence,     // node: next instruction of an instr* run
+            Folded,       // node: a folded instruction, not yet started
+            Operands,     // node: next operand; immediates: first token after the opcode
+            BlockEnd,     // The body of a block or loop has been lowered
+            IfCondition,  // node: next condition or the then clause
+            IfElse,       // node: what follows the then clause
+            IfEnd         // node: what follows the else clause
+        };
+        struct Work {
+            Step step;
+            const SExpr* node;
+            const SExpr* immediates;
+            const SExpr* label;
+            const SExpr* type;
+            const text::OpcodeInfo* info;
+        };
+
+        // Explicit stack, as in read_sexprs(): folded instructions and block
+        // bodies nest as deep as the source does
+        std::vector<Work> work;
+        work.push_back(Work{sequence ? Step::Sequence : Step::Folded, start, nullptr, nullptr, nullptr, nullptr});
+
+        while (!work.empty()) {
+            Work& top = work.back();
+            const SExpr* node = top.node;
+
+            switch (top.step) {
+            case Step::Sequence:
+                if (node == nullptr) {
+                    work.pop_back();
+                } else if (node->is_list()) {
+                    top.node = node->next;
+                    work.push_back(Work{Step::Folded, node, nullptr, nullptr, nullptr, nullptr});
+                } else {
+                    auto lowered = plain(node);
+                    if (!lowered) {
+                        return lowered;
+                    }
+                    top.node = node;
+                }
+                break;
+
+            case Step::Folded: {
+                const SExpr* head = node->first;
+                if (head == nullptr || !head->is_atom(Token::Kind::Keyword)) {
+                    return Result<void>{ErrorCode::UnexpectedToken, "Expected an instruction"};
+                }
+                const text::OpcodeInfo* info = text::find_opcode(head->token.text);
+                if (info == nullptr) {
+                    return Result<void>{ErrorCode::UnknownOpcode, "Unknown instruction"};
+                }
+                node = head->next;
+
+                if (info->immediate == text::ImmediateKind::BlockType && info->code != 0x04) {
+                    // (block label? blocktype instr*)
+                    write_opcode(*info);
+                    open_label(node);
+                    auto type = block_type(node);
+                    if (!type) {
+                        return type;
+                    }
+                    top.step = Step::BlockEnd;
+                    work.push_back(Work{Step::Sequence, node, nullptr, nullptr, nullptr, nullptr});
+                } else if (info->immediate == text::ImmediateKind::BlockType) {
+                    // (if label? blocktype condition* (then instr*) (else instr*)?)
+                    top.label = node;
+                    skip_id(node);
+                    top.type = node;
+                    while (node != nullptr && is_type_form(node)) {
+                        node = node->next;
+                    }
+                    top.step = Step::IfCondition;
+                    top.node = node;
+                    top.info = info;
+                } else if (info->prefix == 0 && (info->code == 0x05 || info->code == 0x0B)) {
+                    return Result<void>{ErrorCode::UnexpectedToken, "else/end cannot be folded"};
+                } else {
+                    // (op immediates* operand*): operands are evaluated first
+                    top.step = Step::Operands;
+                    top.node = node;
+                    top.immediates = node;
+                    top.info = info;
+                }
+                break;
+            }
+
+            case Step::Operands:
+                while (node != nullptr && (!node->is_list() || is_type_form(node))) {
+                    node = node->next;
+                }
+                if (node != nullptr) {
+                    top.node = node->next;
+                    work.push_back(Work{Step::Folded, node, nullptr, nullptr, nullptr, nullptr});
+                    break;
+                }
+                node = top.immediates;
+                {
+                    auto encoded = immediates(*top.info, node);
+                    if (!encoded) {
+                        return encoded;
+                    }
+                }
+                for (; node != nullptr; node = node->next) {
+                    if (!node->is_list() || is_type_form(node)) {
+                        return Result<void>{ErrorCode::UnexpectedToken, "Unexpected token in folded instruction"};
+                    }
+                }
+                work.pop_back();
+                break;
+
+            case Step::BlockEnd:
+                labels.pop_back();
+                code.write_byte(0x0B);
+                work.pop_back();
+                break;
+
+            case Step::IfCondition:
+                if (node != nullptr && !node->is_form("then")) {
+                    if (!node->is_list()) {
+                        return Result<void>{ErrorCode::UnexpectedToken, "Expected a folded condition"};
+                    }
+                    top.node = node->next;
+                    work.push_back(Work{Step::Folded, node, nullptr, nullptr, nullptr, nullptr});
+                    break;
+                }
+                if (node == nullptr) {
+                    return Result<void>{ErrorCode::UnexpectedToken, "Missing then clause"};
+                }
+                {
+                    write_opcode(*top.info);
+                    const SExpr* label_node = top.label;
+                    open_label(label_node);
+                    const SExpr* type_node = top.type;
+                    auto type = block_type(type_node);
+                    if (!type) {
+                        return type;
+                    }
+                }
+                top.step = Step::IfElse;
+                top.node = node->next;
+                work.push_back(Work{Step::Sequence, node->first->next, nullptr, nullptr, nullptr, nullptr});
+                break;
+
+            case Step::IfElse:
+                top.step = Step::IfEnd;
+                if (node != nullptr && node->is_form("else")) {
+                    code.write_byte(0x05);
+                    top.node = node->next;
+                    work.push_back(Work{Step::Sequence, node->first->next, nullptr, nullptr, nullptr, nullptr});
+                }
+                break;
+
+            case Step::IfEnd:
+                if (node != nullptr) {
+                    return Result<void>{ErrorCode::UnexpectedToken, "Unexpected token after if"};
+                }
+                labels.pop_back();
+                code.write_byte(0x0B);
+                work.pop_back();
+                break;
+            }
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextParser::ParseContext::immediates(const text::OpcodeInfo& info, const SExpr*& node) {
+        using text::ImmediateKind;
+
+        if (info.immediate == ImmediateKind::Select) {
+            // select with (result t*) is the typed form, 0x1C
+            std::vector<ValueType> types;
+            for (; node != nullptr && node->is_form("result"); node = node->next) {
+                for (const SExpr* item = node->first->next; item != nullptr; item = item->next) {
+                    auto type = value_type(item);
+                    if (!type) {
+                        return type.error();
+                    }
+                    types.push_back(type.value());
+                }
+            }
+            if (types.empty()) {
+                code.write_byte(0x1B);
+            } else {
+                code.write_byte(0x1C);
+                code.write_leb128_u32(static_cast<uint32_t>(types.size()));
+                for (ValueType type : types) {
+                    code.write_byte(static_cast<uint8_t>(type));
+                }
+            }
+            return Result<void>{Error{}};
+        }
+
+        write_opcode(info);
+
+        // Reads one index in @p space and advances; optional ones default to 0
+        auto index = [this, &node](Space space, bool optional) -> Result<uint32_t> {
+            if (optional && !is_index(node)) {
+                return Result<uint32_t>{0u};
+            }
+            auto resolved = resolve(space, node);
+            if (resolved) {
+                node = node->next;
+            }
+            return resolved;
+        };
+
+        switch (info.immediate) {
+            case ImmediateKind::None:
+            case ImmediateKind::Select:
+                break;
+
+            case ImmediateKind::BlockType: {
+                open_label(node);
+                return block_type(node);
+            }
+
+            case ImmediateKind::Label: {
+                auto depth = label(node);
+                if (!depth) {
+                    return depth.error();
+                }
+                code.write_leb128_u32(depth.value());
+                node = node->next;
+                break;
+            }
+
+            case ImmediateKind::LabelTable: {
+                std::vector<uint32_t> depths;
+                for (; is_index(node); node = node->next) {
+                    auto depth = label(node);
+                    if (!depth) {
+                        return depth.error();
+                    }
+                    depths.push_back(depth.value());
+                }
+                if (depths.empty()) {
+                    return Result<void>{ErrorCode::UnexpectedToken, "br_table needs a default label"};
+                }
+                code.write_leb128_u32(static_cast<uint32_t>(depths.size() - 1));
+                for (uint32_t depth : depths) {
+                    code.write_leb128_u32(depth);
+                }
+                break;
+            }
+
+            case ImmediateKind::Function: {
+                auto function = index(FuncSpace, false);
+                if (!function) {
+                    return function.error();
+                }
+                code.write_leb128_u32(function.value());
+                break;
+            }
+
+            case ImmediateKind::CallIndirect: {
+                auto table = index(TableSpace, true);
+                if (!table) {
+                    return table.error();
+                }
+                auto type = type_use(node, false);
+                if (!type) {
+                    return type.error();
+                }
+                code.write_leb128_u32(type.value());
+                code.write_leb128_u32(table.value());
+                break;
+            }
+
+            case ImmediateKind::Local: {
+                Result<uint32_t> local{0u};
+                if (node != nullptr && node->is_atom(Token::Kind::Identifier)) {
+                    auto found = locals.find(node->token.text);
+                    if (found == locals.end()) {
+                        return Result<void>{ErrorCode::UnknownIdentifier, "Unknown local"};
+                    }
+                    local = Result<uint32_t>{found->second};
+                } else if (node != nullptr && node->is_atom(Token::Kind::Number)) {
+                    local = text::parse_u32(node->token.text);
+                } else {
+                    return Result<void>{ErrorCode::UnexpectedToken, "Expected a local index"};
+                }
+                if (!local) {
+                    return local.error();
+                }
+                if (local.value() >= local_total) {
+                    return Result<void>{ErrorCode::InvalidLocalIndex, "Local index out of range"};
+                }
+                code.write_leb128_u32(local.value());
+                node = node->next;
+                break;
+            }
+
+            case ImmediateKind::Global:
+            case ImmediateKind::Table:
+            case ImmediateKind::Memory:
+            case ImmediateKind::Data:
+            case ImmediateKind::Elem: {
+                Space space = GlobalSpace;
+                if (info.immediate == ImmediateKind::Table) space = TableSpace;
+                if (info.immediate == ImmediateKind::Memory) space = MemorySpace;
+                if (info.immediate == ImmediateKind::Data) space = DataSpace;
+                if (info.immediate == ImmediateKind::Elem) space = ElemSpace;
+                const bool optional = space == TableSpace || space == MemorySpace;
+                auto resolved = index(space, optional);
+                if (!resolved) {
+                    return resolved.error();
+                }
+                code.write_leb128_u32(resolved.value());
+                uses_data_count = uses_data_count || space == DataSpace;
+                break;
+            }
+
+            case ImmediateKind::MemArg: {
+                uint32_t offset = 0;
+                uint32_t alignment = info.alignment;
+                if (node != nullptr && node->is_atom(Token::Kind::Keyword) &&
+                    node->token.text.substr(0, 7) == "offset=") {
+                    auto value = text::parse_u32(node->token.text.substr(7));
+                    if (!value) {
+                        return value.error();
+                    }
+                    offset = value.value();
+                    node = node->next;
+                }
+                if (node != nullptr && node->is_atom(Token::Kind::Keyword) &&
+                    node->token.text.substr(0, 6) == "align=") {
+                    auto value = text::parse_u32(node->token.text.substr(6));
+                    if (!value) {
+                        return value.error();
+                    }
+                    const uint32_t bytes = value.value();
+                    if (bytes == 0 || (bytes & (bytes - 1)) != 0) {
+                        return Result<void>{ErrorCode::InvalidNumber, "Alignment must be a power of two"};
+                    }
+                    alignment = 0;
+                    while ((1u << alignment) != bytes) {
+                        ++alignment;
+                    }
+                    node = node->next;
+                }
+                code.write_leb128_u32(alignment);
+                code.write_leb128_u32(offset);
+                break;
+            }
+
+            case ImmediateKind::I32:
+            case ImmediateKind::I64:
+            case ImmediateKind::F32:
+            case ImmediateKind::F64: {
+                // Float keywords (inf, nan, nan:0x...) lex as keywords
+                if (node == nullptr || (!node->is_atom(Token::Kind::Number) && !node->is_atom(Token::Kind::Keyword))) {
+                    return Result<void>{ErrorCode::UnexpectedToken, "Expected a numeric literal"};
+                }
+                const std::string_view literal = node->token.text;
+                if (info.immediate == ImmediateKind::I32) {
+                    auto value = text::parse_i32(literal);
+                    if (!value) {
+                        return value.error();
+                    }
+                    code.write_leb128_i32(value.value());
+                } else if (info.immediate == ImmediateKind::I64) {
+                    auto value = text::parse_i64(literal);
+                    if (!value) {
+                        return value.error();
+                    }
+                    code.write_leb128_i64(value.value());
+                } else if (info.immediate == ImmediateKind::F32) {
+                    auto value = text::parse_f32(literal);
+                    if (!value) {
+                        return value.error();
+                    }
+                    code.write_f32(value.value());
+                } else {
+                    auto value = text::parse_f64(literal);
+                    if (!value) {
+                        return value.error();
+                    }
+                    code.write_f64(value.value());
+                }
+                node = node->next;
+                break;
+            }
+
+            case ImmediateKind::RefNull: {
+                if (node != nullptr && node->is_keyword("func")) {
+                    code.write_byte(static_cast<uint8_t>(ValueType::FuncRef));
+                } else if (node != nullptr && node->is_keyword("extern")) {
+                    code.write_byte(static_cast<uint8_t>(ValueType::ExternRef));
+                } else {
+                    return Result<void>{ErrorCode::UnexpectedToken, "Expected a heap type"};
+                }
+                node = node->next;
+                break;
+            }
+
+            case ImmediateKind::MemoryInit:
+            case ImmediateKind::TableInit: {
+                // memory.init mem? data / table.init table? elem
+                const bool memory = info.immediate == ImmediateKind::MemoryInit;
+                const Space target = memory ? MemorySpace : TableSpace;
+                const Space segment_space = memory ? DataSpace : ElemSpace;
+                uint32_t target_index = 0;
+                if (is_index(node) && is_index(node->next)) {
+                    auto resolved = index(target, false);
+                    if (!resolved) {
+                        return resolved.error();
+                    }
+                    target_index = resolved.value();
+                }
+                auto segment = index(segment_space, false);
+                if (!segment) {
+                    return segment.error();
+                }
+                code.write_leb128_u32(segment.value());
+                code.write_leb128_u32(target_index);
+                uses_data_count = uses_data_count || memory;
+                break;
+            }
+
+            case ImmediateKind::MemoryCopy:
+            case ImmediateKind::TableCopy: {
+                const Space space = info.immediate == ImmediateKind::MemoryCopy ? MemorySpace : TableSpace;
+                auto destination = index(space, true);
+                if (!destination) {
+                    return destination.error();
+                }
+                auto source_index = index(space, true);
+                if (!source_index) {
+                    return source_index.error();
+                }
+                code.write_leb128_u32(destination.value());
+                code.write_leb128_u32(source_index.value());
+                break;
+            }
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<Module> TextParser::parse_module(ParseContext& context) noexcept {
+        auto root = read_sexprs(context.source, context.arena);
+        if (!root) {
+            return root.error();
+        }
+
+        const SExpr* fields = root.value();
+        if (fields != nullptr && fields->is_form("module")) {
+            if (fields->next != nullptr) {
+                return Result<Module>{ErrorCode::UnexpectedToken, "Unexpected content after module"};
+            }
+            fields = fields->first->next;
+            ParseContext::skip_id(fields);
+            if (fields != nullptr && (fields->is_keyword("binary") || fields->is_keyword("quote"))) {
+                return Result<Module>{ErrorCode::UnexpectedToken, "Binary and quoted modules are not supported"};
+            }
+        }
+        context.fields = fields;
+
+        Module module;
+        auto declared = parse_declarations(context, module);
+        if (!declared) {
+            return declared.error();
+        }
+        return Result<Module>{std::move(module)};
+    }
+
+    inline Result<void> TextParser::parse_declarations(ParseContext& context, Module& module) noexcept {
+        context.module = &module;
+        for (const SExpr* field = context.fields; field != nullptr; field = field->next) {
+            auto declared = context.declare(field);
+            if (!declared) {
+                return declared;
+            }
+        }
+        for (const SExpr* field = context.fields; field != nullptr; field = field->next) {
+            auto defined = context.define(field);
+            if (!defined) {
+                return defined;
+            }
+        }
+        if (context.uses_data_count) {
+            module.has_data_count = true;
+            module.data_count = static_cast<uint32_t>(module.data.size());
+        }
+        module.index_exports();
+        return Result<void>{Error{}};
+    }
+
+    inline Result<Module> TextParser::parse(std::string_view text) noexcept {
+        TextParser parser;
+        ParseContext context(text);
+        return parser.parse_module(context);
+    }
+
+    inline Result<Module> TextParser::parse_file(const std::string& filename) noexcept {
+        auto file = MappedFile::open(filename);
+        if (!file) {
+            return file.error();
+        }
+        const span<const uint8_t> bytes = file.value()->bytes();
+        // Names are interned, so the module does not keep the mapping alive
+        return parse(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+    }
+
+    inline Result<void> TextParser::validate(std::string_view text) noexcept {
+        auto module = parse(text);
+        if (!module) {
+            return module.error();
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline bool TextParser::is_wat_text(std::string_view text) noexcept {
+        Lexer lexer(text);
+        auto open = lexer.next();
+        if (!open || open.value().kind != Token::Kind::LeftParen) {
+            return false;
+        }
+        auto head = lexer.next();
+        if (!head || head.value().kind != Token::Kind::Keyword) {
+            return false;
+        }
+        const std::string_view keyword = head.value().text;
+        for (std::string_view field : {"module", "type", "import", "func", "table", "memory",
+                                       "global", "export", "start", "elem", "data"}) {
+            if (keyword == field) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // =========================================================================
+    // Inline Implementation - TextEncoder
+    // =========================================================================
+
+    /**
+     * @brief Writes the text of one module through a BinaryWriter
+     */
+    class TextEncoder::Printer {
+    public:
+        Printer(BinaryWriter& writer, const EncodingOptions& options) noexcept
+            : writer_(writer), options_(options) {}
+
+        Result<void> print(const Module& module);
+
+    private:
+        void put(std::string_view text) {
+            writer_.write_bytes(span<const uint8_t>(reinterpret_cast<const uint8_t*>(text.data()), text.size()));
+        }
+
+        void put(char c) { writer_.write_byte(static_cast<uint8_t>(c)); }
+
+        void put_number(uint64_t value);
+        void put_signed(int64_t value);
+        template<typename Float, typename Bits> void put_float(Float value);
+        void put_string(span<const uint8_t> bytes);
+        void put_type(ValueType type);
+        void put_limits(const Limits& limits);
+        void put_global_type(const GlobalType& type);
+        void put_signature(const FunctionType& type);
+        void index_comment(uint32_t index);
+        void line(size_t depth);
+
+        Result<void> expression(span<const uint8_t> code, size_t depth, bool one_line);
+        Result<void> immediates(const text::OpcodeInfo& info, BinaryReader& reader);
+
+        BinaryWriter& writer_;
+        const EncodingOptions& options_;
+    };
+
+    namespace detail {
+
+        inline const char* text_type_name(ValueType type) noexcept {
+            switch (type) {
+                case ValueType::I32: return "i32";
+                case ValueType::I64: return "i64";
+                case ValueType::F32: return "f32";
+                case ValueType::F64: return "f64";
+                case ValueType::V128: return "v128";
+                case ValueType::FuncRef: return "funcref";
+                case ValueType::ExternRef: return "externref";
+                default: return nullptr;
+            }
+        }
+
+    } // namespace detail
+
+    inline void TextEncoder::Printer::put_number(uint64_t value) {
+        char buffer[24];
+        auto converted = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        put(std::string_view(buffer, static_cast<size_t>(converted.ptr - buffer)));
+    }
+
+    inline void TextEncoder::Printer::put_signed(int64_t value) {
+        char buffer[24];
+        auto converted = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        put(std::string_view(buffer, static_cast<size_t>(converted.ptr - buffer)));
+    }
+
+    template<typename Float, typename Bits>
+    inline void TextEncoder::Printer::put_float(Float value) {
+        constexpr int mantissa_bits = std::numeric_limits<Float>::digits - 1;
+        constexpr Bits mantissa_mask = (Bits(1) << mantissa_bits) - 1;
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        if (std::signbit(value)) {
+            put('-');
+        }
+        if (std::isnan(value)) {
+            const Bits payload = bits & mantissa_mask;
+            put("nan");
+            if (payload != (Bits(1) << (mantissa_bits - 1))) {
+                char buffer[24];
+                auto converted = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<uint64_t>(payload), 16);
+                put(":0x");
+                put(std::string_view(buffer, static_cast<size_t>(converted.ptr - buffer)));
+            }
+            return;
+        }
+        if (std::isinf(value)) {
+            put("inf");
+            return;
+        }
+        // Shortest-safe precision for an exact round trip
+        char buffer[48];
+        const int length = std::snprintf(buffer, sizeof(buffer), sizeof(Float) == 4 ? "%.9g" : "%.17g",
+                                         static_cast<double>(std::fabs(value)));
+        put(std::string_view(buffer, static_cast<size_t>(length)));
+    }
+
+    inline void TextEncoder::Printer::put_string(span<const uint8_t> bytes) {
+        static constexpr char hex[] = "0123456789abcdef";
+        put('"');
+        for (uint8_t byte : bytes) {
+            // ';' is escaped too so strings inside block comments cannot close them
+            if (byte >= 0x20 && byte < 0x7F && byte != '"' && byte != '\\' && byte != ';') {
+                put(static_cast<char>(byte));
+            } else {
+                put('\\');
+                put(hex[byte >> 4]);
+                put(hex[byte & 0x0F]);
+            }
+        }
+        put('"');
+    }
+
+    inline void TextEncoder::Printer::put_type(ValueType type) {
+        const char* type_name = detail::text_type_name(type);
+        put(type_name != nullptr ? std::string_view(type_name) : std::string_view("<invalid>"));
+    }
+
+    inline void TextEncoder::Printer::put_limits(const Limits& limits) {
+        put_number(limits.min);
+        if (limits.has_max) {
+            put(' ');
+            put_number(limits.max);
+        }
+    }
+
+    inline void TextEncoder::Printer::put_global_type(const GlobalType& type) {
+        if (type.is_mutable) {
+            put("(mut ");
+            put_type(type.value_type);
+            put(')');
+        } else {
+            put_type(type.value_type);
+        }
+    }
+
+    inline void TextEncoder::Printer::put_signature(const FunctionType& type) {
+        if (!type.params.empty()) {
+            put(" (param");
+            for (ValueType param : type.params) {
+                put(' ');
+                put_type(param);
+            }
+            put(')');
+        }
+        if (!type.results.empty()) {
+            put(" (result");
+            for (ValueType result : type.results) {
+                put(' ');
+                put_type(result);
+            }
+            put(')');
+        }
+    }
+
+    inline void TextEncoder::Printer::index_comment(uint32_t index) {
+        if (options_.include_comments) {
+            put(" (;");
+            put_number(index);
+            put(";)");
+        }
+    }
+
+    inline void TextEncoder::Printer::line(size_t depth) {
+        if (!options_.pretty_print) {
+            put(' ');
+            return;
+        }
+        put('\n');
+        for (size_t i = 0; i < depth * options_.indent_size; ++i) {
+            put(' ');
+        }
+    }
+
+    inline Result<void> TextEncoder::Printer::immediates(const text::OpcodeInfo& info, BinaryReader& reader) {
+        using text::ImmediateKind;
+
+        auto u32 = [&reader, this]() -> Result<uint32_t> {
+            auto value = reader.read_leb128_u32();
+            if (value) {
+                put(' ');
+                put_number(value.value());
+            }
+            return value;
+        };
+
+        switch (info.immediate) {
+            case ImmediateKind::None:
+                break;
+
+            case ImmediateKind::BlockType: {
+                auto type = reader.read_leb128_i64();
+                if (!type) {
+                    return type.error();
+                }
+                if (type.value() >= 0) {
+                    put(" (type ");
+                    put_number(static_cast<uint64_t>(type.value()));
+                    put(')');
+                } else if (type.value() != -64) {
+                    put(" (result ");
+                    put_type(static_cast<ValueType>(type.value() & 0x7F));
+                    put(')');
+                }
+                break;
+            }
+
+            case ImmediateKind::LabelTable: {
+                auto count = reader.read_leb128_u32();
+                if (!count) {
+                    return count.error();
+                }
+                for (uint32_t i = 0; i <= count.value(); ++i) {
+                    auto depth = u32();
+                    if (!depth) {
+                        return depth.error();
+                    }
+                }
+                break;
+            }
+
+            case ImmediateKind::CallIndirect: {
+                auto type = reader.read_leb128_u32();
+                if (!type) {
+                    return type.error();
+                }
+                auto table = reader.read_leb128_u32();
+                if (!table) {
+                    return table.error();
+                }
+                if (table.value() != 0) {
+                    put(' ');
+                    put_number(table.value());
+                }
+                put(" (type ");
+                put_number(type.value());
+                put(')');
+                break;
+            }
+
+            case ImmediateKind::Label:
+            case ImmediateKind::Function:
+            case ImmediateKind::Local:
+            case ImmediateKind::Global:
+            case ImmediateKind::Table:
+            case ImmediateKind::Data:
+            case ImmediateKind::Elem: {
+                auto index = u32();
+                if (!index) {
+                    return index.error();
+                }
+                break;
+            }
+
+            case ImmediateKind::Memory: {
+                auto memory = reader.read_leb128_u32();
+                if (!memory) {
+                    return memory.error();
+                }
+                if (memory.value() != 0) {
+                    put(' ');
+                    put_number(memory.value());
+                }
+                break;
+            }
+
+            case ImmediateKind::MemArg: {
+                auto alignment = reader.read_leb128_u32();
+                if (!alignment) {
+                    return alignment.error();
+                }
+                auto offset = reader.read_leb128_u32();
+                if (!offset) {
+                    return offset.error();
+                }
+                if (alignment.value() >= 32) {
+                    return Result<void>{ErrorCode::InvalidAlignment, "Alignment exponent out of range"};
+                }
+                if (offset.value() != 0) {
+                    put(" offset=");
+                    put_number(offset.value());
+                }
+                if (alignment.value() != info.alignment) {
+                    put(" align=");
+                    put_number(uint64_t(1) << alignment.value());
+                }
+                break;
+            }
+
+            case ImmediateKind::I32: {
+                auto value = reader.read_leb128_i32();
+                if (!value) {
+                    return value.error();
+                }
+                put(' ');
+                put_signed(value.value());
+                break;
+            }
+
+            case ImmediateKind::I64: {
+                auto value = reader.read_leb128_i64();
+                if (!value) {
+                    return value.error();
+                }
+                put(' ');
+                put_signed(value.value());
+                break;
+            }
+
+            case ImmediateKind::F32: {
+                auto value = reader.read_f32();
+                if (!value) {
+                    return value.error();
+                }
+                put(' ');
+                put_float<float, uint32_t>(value.value());
+                break;
+            }
+
+            case ImmediateKind::F64: {
+                auto value = reader.read_f64();
+                if (!value) {
+                    return value.error();
+                }
+                put(' ');
+                put_float<double, uint64_t>(value.value());
+                break;
+            }
+
+            case ImmediateKind::Select:
+                break;  // Typed select is decoded by the caller
+
+            case ImmediateKind::RefNull: {
+                auto heap = reader.read_byte();
+                if (!heap) {
+                    return heap.error();
+                }
+                put(heap.value() == static_cast<uint8_t>(ValueType::ExternRef) ? " extern" : " func");
+                break;
+            }
+
+            case ImmediateKind::MemoryInit: {
+                auto segment = reader.read_leb128_u32();
+                if (!segment) {
+                    return segment.error();
+                }
+                auto memory = reader.read_leb128_u32();
+                if (!memory) {
+                    return memory.error();
+                }
+                if (memory.value() != 0) {
+                    put(' ');
+                    put_number(memory.value());
+                }
+                put(' ');
+                put_number(segment.value());
+                break;
+            }
+
+            case ImmediateKind::TableInit: {
+                auto segment = reader.read_leb128_u32();
+                if (!segment) {
+                    return segment.error();
+                }
+                auto table = reader.read_leb128_u32();
+                if (!table) {
+                    return table.error();
+                }
+                put(' ');
+                put_number(table.value());
+                put(' ');
+                put_number(segment.value());
+                break;
+            }
+
+            case ImmediateKind::MemoryCopy:
+            case ImmediateKind::TableCopy: {
+                auto destination = reader.read_leb128_u32();
+                if (!destination) {
+                    return destination.error();
+                }
+                auto source = reader.read_leb128_u32();
+                if (!source) {
+                    return source.error();
+                }
+                if (info.immediate == ImmediateKind::TableCopy || destination.value() != 0 || source.value() != 0) {
+                    put(' ');
+                    put_number(destination.value());
+                    put(' ');
+                    put_number(source.value());
+                }
+                break;
+            }
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextEncoder::Printer::expression(span<const uint8_t> code, size_t depth, bool one_line) {
+        BinaryReader reader(code);
+        size_t nesting = 0;
+        while (reader.has_data()) {
+            auto opcode = reader.read_byte();
+            if (!opcode) {
+                return opcode.error();
+            }
+            uint8_t prefix = 0;
+            uint32_t value = opcode.value();
+            if (value == 0xFC) {
+                auto sub = reader.read_leb128_u32();
+                if (!sub) {
+                    return sub.error();
+                }
+                prefix = 0xFC;
+                value = sub.value();
+            }
+
+            if (prefix == 0 && value == 0x0B && nesting == 0) {
+                // The final end is implicit in the text format
+                if (reader.has_data()) {
+                    return Result<void>{ErrorCode::InvalidModule, "Bytes after end of expression"};
+                }
+                return Result<void>{Error{}};
+            }
+
+            if (prefix == 0 && value == 0x0B) {
+                --nesting;
+            }
+            if (one_line) {
+                put(' ');
+            } else {
+                line(depth + nesting - (prefix == 0 && value == 0x05 ? 1 : 0));
+            }
+
+            if (prefix == 0 && value == 0x1C) {
+                auto count = reader.read_leb128_u32();
+                if (!count) {
+                    return count.error();
+                }
+                put("select (result");
+                for (uint32_t i = 0; i < count.value(); ++i) {
+                    auto type = reader.read_byte();
+                    if (!type) {
+                        return type.error();
+                    }
+                    put(' ');
+                    put_type(static_cast<ValueType>(type.value()));
+                }
+                put(')');
+                continue;
+            }
+
+            const text::OpcodeInfo* info = text::find_opcode(prefix, value);
+            if (info == nullptr) {
+                return Result<void>{ErrorCode::UnknownOpcode, "Instruction has no text mnemonic"};
+            }
+            put(info->name);
+            auto decoded = immediates(*info, reader);
+            if (!decoded) {
+                return decoded;
+            }
+            if (info->immediate == text::ImmediateKind::BlockType) {
+                ++nesting;
+            }
+        }
+        return Result<void>{ErrorCode::InvalidModule, "Expression is missing end"};
+    }
+
+    inline Result<void> TextEncoder::Printer::print(const Module& module) {
+        if (module.defined_function_count() != module.function_type_indices.size()) {
+            return Result<void>{ErrorCode::InvalidModule, "Function and code counts differ"};
+        }
+
+        put("(module");
+        uint32_t counts[4] = {};  // Imported functions, tables, memories, globals
+
+        for (uint32_t i = 0; i < module.types.size(); ++i) {
+            line(1);
+            put("(type");
+            index_comment(i);
+            put(" (func");
+            put_signature(module.types[i]);
+            put("))");
+        }
+
+        for (const Import& import : module.imports) {
+            line(1);
+            put("(import ");
+            put_string(span<const uint8_t>(reinterpret_cast<const uint8_t*>(import.module_name.data()),
+                                           import.module_name.size()));
+            put(' ');
+            put_string(span<const uint8_t>(reinterpret_cast<const uint8_t*>(import.field_name.data()),
+                                           import.field_name.size()));
+            const uint32_t index = counts[static_cast<uint8_t>(import.kind)]++;
+            switch (import.kind) {
+                case Import::Kind::Function:
+                    put(" (func");
+                    index_comment(index);
+                    put(" (type ");
+                    put_number(import.descriptor.function_type_index);
+                    put(')');
+                    break;
+                case Import::Kind::Table:
+                    put(" (table");
+                    index_comment(index);
+                    put(' ');
+                    put_limits(import.descriptor.table_type.limits);
+                    put(' ');
+                    put_type(import.descriptor.table_type.element_type);
+                    break;
+                case Import::Kind::Memory:
+                    put(" (memory");
+                    index_comment(index);
+                    put(' ');
+                    put_limits(import.descriptor.memory_type.limits);
+                    break;
+                case Import::Kind::Global:
+                    put(" (global");
+                    index_comment(index);
+                    put(' ');
+                    put_global_type(import.descriptor.global_type);
+                    break;
+            }
+            put("))");
+        }
+
+        for (uint32_t i = 0; i < module.function_type_indices.size(); ++i) {
+            const uint32_t type_index = module.function_type_indices[i];
+            line(1);
+            put("(func");
+            index_comment(counts[0] + i);
+            put(" (type ");
+            put_number(type_index);
+            put(')');
+            if (type_index < module.types.size()) {
+                put_signature(module.types[type_index]);
+            }
+
+            span<const uint8_t> body;
+            if (!module.functions.empty()) {
+                const Function& function = module.functions[i];
+                if (!function.locals.empty()) {
+                    line(2);
+                    put("(local");
+                    for (ValueType local : function.locals) {
+                        put(' ');
+                        put_type(local);
+                    }
+                    put(')');
+                }
+                body = function.body();
+            } else {
+                const span<const LocalGroup> groups = module.code_table.locals(i);
+                if (!groups.empty()) {
+                    line(2);
+                    put("(local");
+                    for (const LocalGroup& group : groups) {
+                        for (uint32_t k = 0; k < group.count; ++k) {
+                            put(' ');
+                            put_type(group.type);
+                        }
+                    }
+                    put(')');
+                }
+                body = module.code_table.body(i);
+            }
+            auto printed = expression(body, 2, false);
+            if (!printed) {
+                return printed;
+            }
+            put(')');
+        }
+
+        for (uint32_t i = 0; i < module.tables.size(); ++i) {
+            line(1);
+            put("(table");
+            index_comment(counts[1] + i);
+            put(' ');
+            put_limits(module.tables[i].limits);
+            put(' ');
+            put_type(module.tables[i].element_type);
+            put(')');
+        }
+
+        for (uint32_t i = 0; i < module.memories.size(); ++i) {
+            line(1);
+            put("(memory");
+            index_comment(counts[2] + i);
+            put(' ');
+            put_limits(module.memories[i].limits);
+            put(')');
+        }
+
+        for (uint32_t i = 0; i < module.globals.size(); ++i) {
+            line(1);
+            put("(global");
+            index_comment(counts[3] + i);
+            put(' ');
+            put_global_type(module.globals[i].type);
+            auto printed = expression(module.globals[i].initializer_bytes, 0, true);
+            if (!printed) {
+                return printed;
+            }
+            put(')');
+        }
+
+        static constexpr std::string_view export_kinds[] = {"func", "table", "memory", "global"};
+        for (const Export& exported : module.exports) {
+            line(1);
+            put("(export ");
+            put_string(span<const uint8_t>(reinterpret_cast<const uint8_t*>(exported.name.data()),
+                                           exported.name.size()));
+            put(" (");
+            put(export_kinds[static_cast<uint8_t>(exported.kind) & 3]);
+            put(' ');
+            put_number(exported.index);
+            put("))");
+        }
+
+        if (module.has_start_function) {
+            line(1);
+            put("(start ");
+            put_number(module.start_function_index);
+            put(')');
+        }
+
+        for (uint32_t i = 0; i < module.elements.size(); ++i) {
+            const Element& segment = module.elements[i];
+            line(1);
+            put("(elem");
+            index_comment(i);
+            if (segment.mode == Element::Mode::Declarative) {
+                put(" declare");
+            } else if (segment.mode == Element::Mode::Active) {
+                if (segment.table_index != 0) {
+                    put(" (table ");
+                    put_number(segment.table_index);
+                    put(')');
+                }
+                put(" (offset");
+                auto printed = expression(segment.offset_bytes, 0, true);
+                if (!printed) {
+                    return printed;
+                }
+                put(')');
+            }
+            if (segment.element_type == ValueType::FuncRef) {
+                put(" func");
+            } else {
+                put(' ');
+                put_type(segment.element_type);
+            }
+            for (uint32_t function : segment.function_indices) {
+                put(' ');
+                put_number(function);
+            }
+            put(')');
+        }
+
+        for (uint32_t i = 0; i < module.data.size(); ++i) {
+            const Data& segment = module.data[i];
+            line(1);
+            put("(data");
+            index_comment(i);
+            if (segment.mode == Data::Mode::Active) {
+                if (segment.memory_index != 0) {
+                    put(" (memory ");
+                    put_number(segment.memory_index);
+                    put(')');
+                }
+                put(" (offset");
+                auto printed = expression(segment.offset_bytes, 0, true);
+                if (!printed) {
+                    return printed;
+                }
+                put(')');
+            }
+            put(' ');
+            put_string(segment.bytes());
+            put(')');
+        }
+
+        if (options_.include_comments) {
+            // Custom sections have no text form; note them so they are not silently lost
+            for (const auto& custom : module.custom_sections) {
+                line(1);
+                put("(; custom section ");
+                put_string(span<const uint8_t>(reinterpret_cast<const uint8_t*>(custom.first.data()),
+                                               custom.first.size()));
+                put(", ");
+                put_number(custom.second.size());
+                put(" bytes ;)");
+            }
+        }
+
+        put(')');
+        if (options_.pretty_print) {
+            put('\n');
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<size_t> TextEncoder::encode_to(const Module& module, const WriteCallback& sink,
+                                                 const EncodingOptions& options) noexcept {
+        BinaryWriter writer(sink);
+        Printer printer(writer, options);
+        auto printed = printer.print(module);
+        if (!printed) {
+            return printed.error();
+        }
+        if (!writer.flush()) {
+            return Result<size_t>{ErrorCode::FileWriteFailed, "Output sink rejected data"};
+        }
+        return Result<size_t>{writer.size()};
+    }
+
+    inline Result<size_t> TextEncoder::encode_to(const Module& module, const WriteCallback& sink) noexcept {
+        return encode_to(module, sink, EncodingOptions{});
+    }
+
+    inline Result<std::string> TextEncoder::encode_with_options(const Module& module,
+                                                                const EncodingOptions& options) noexcept {
+        std::string text;
+        auto written = encode_to(module, [&text](span<const uint8_t> chunk) {
+            text.append(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+            return true;
+        }, options);
+        if (!written) {
+            return written.error();
+        }
+        return Result<std::string>{std::move(text)};
+    }
+
+    inline Result<std::string> TextEncoder::encode(const Module& module) noexcept {
+        return encode_with_options(module, EncodingOptions{});
+    }
+
+    inline Result<void> TextEncoder::encode_to_file(const Module& module, const std::string& filename) noexcept {
+        std::FILE* file = std::fopen(filename.c_str(), "wb");
+        if (file == nullptr) {
+            return Result<void>{ErrorCode::FileOpenFailed, "Failed to open output file"};
+        }
+
+        auto written = encode_to(module, [file](span<const uint8_t> chunk) {
+            return std::fwrite(chunk.data(), 1, chunk.size(), file) == chunk.size();
+        });
+        const bool closed = std::fclose(file) == 0;
+        if (!written) {
+            return written.error();
+        }
+        if (!closed) {
+            return Result<void>{ErrorCode::FileWriteFailed, "Failed to close output file"};
+        }
+        return Result<void>{Error{}};
+    }
+
+    // =========================================================================
+    // Inline Implementation - TextValidator
+    // =========================================================================
+
+    inline Result<void> TextValidator::validate_syntax(std::string_view text) noexcept {
+        SExprArena arena;
+        auto tree = read_sexprs(text, arena);
+        if (!tree) {
+            return tree.error();
+        }
+        return Result<void>{Error{}};
+    }
+
+    inline Result<void> TextValidator::validate_semantics(std::string_view text) noexcept {
+        return TextParser::validate(text);
+    }
+
 } // namespace flight::wasm
 
 #endif // FLIGHT_WASM_TEXT_PARSER_HPP
@@ -11,8 +11,13 @@
  */
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <flight/wasm/utilities/name_pool.hpp>
+#include <flight/wasm/utilities/span.hpp>
 
 namespace flight::wasm {
 
@@ -124,8 +129,8 @@ namespace flight::wasm {
             Global = 3
         };
 
-        std::string module_name;
-        std::string field_name;
+        std::string_view module_name;  // Interned (see Module::intern) or borrowed
+        std::string_view field_name;
         Kind kind;
         
         union Descriptor {
@@ -142,9 +147,8 @@ namespace flight::wasm {
         } descriptor;
 
         Import() = default;
-        Import(std::string mod, std::string field, Kind k, Descriptor desc)
-            : module_name(std::move(mod)), field_name(std::move(field))
-            , kind(k), descriptor(desc) {}
+        Import(std::string_view mod, std::string_view field, Kind k, Descriptor desc)
+            : module_name(mod), field_name(field), kind(k), descriptor(desc) {}
     };
 
     /**
@@ -158,13 +162,13 @@ namespace flight::wasm {
             Global = 3
         };
 
-        std::string name;
+        std::string_view name;  // Interned (see Module::intern) or borrowed
         Kind kind;
         uint32_t index;
 
         Export() = default;
-        Export(std::string n, Kind k, uint32_t idx)
-            : name(std::move(n)), kind(k), index(idx) {}
+        Export(std::string_view n, Kind k, uint32_t idx)
+            : name(n), kind(k), index(idx) {}
     };
 
     /**
@@ -186,10 +190,124 @@ namespace flight::wasm {
         uint32_t type_index;
         std::vector<ValueType> locals;
         std::vector<uint8_t> body_bytes;  // Function body as raw bytes
+        span<const uint8_t> body_view;    // Borrowed body (zero-copy parsing)
 
         Function() = default;
         Function(uint32_t type_idx, std::vector<ValueType> loc, std::vector<uint8_t> b)
             : type_index(type_idx), locals(std::move(loc)), body_bytes(std::move(b)) {}
+
+        /**
+         * @brief Function body bytes, whether owned or borrowed
+         */
+        span<const uint8_t> body() const noexcept {
+            return body_view.data() != nullptr ? body_view : span<const uint8_t>(body_bytes);
+        }
+    };
+
+    /**
+     * @brief Run-length local declaration, as encoded in the code section
+     */
+    struct LocalGroup {
+        uint32_t count;
+        ValueType type;
+    };
+
+    /**
+     * @brief Flat (structure-of-arrays) storage for defined function code
+     * 
+     * Alternative to Module::functions for large modules. Instead of three
+     * heap blocks per function, all local declarations share one run-length
+     * arena and all bodies live in one code buffer (or a borrowed view of the
+     * code section), addressed through per-function offset tables. Type
+     * indices stay in Module::function_type_indices.
+     */
+    class CodeTable {
+    public:
+        CodeTable() = default;
+
+        /**
+         * @brief Number of functions
+         */
+        size_t size() const noexcept { return body_offsets_.size(); }
+
+        /**
+         * @brief Check if the table holds no functions
+         */
+        bool empty() const noexcept { return body_offsets_.empty(); }
+
+        /**
+         * @brief Pre-size the offset tables and local arena
+         */
+        void reserve(size_t functions, size_t local_groups);
+
+        /**
+         * @brief Address bodies relative to a borrowed code buffer
+         * 
+         * Used for zero-copy parsing; @p code must outlive the table (see
+         * Module::backing_store).
+         */
+        void borrow_code(span<const uint8_t> code) noexcept;
+
+        /**
+         * @brief Address bodies relative to an owned copy of @p code
+         */
+        void copy_code(span<const uint8_t> code);
+
+        /**
+         * @brief Append a function whose body is already in the code buffer
+         * @pre body_offset + body_size lies within the code buffer
+         */
+        void add(span<const LocalGroup> locals, uint32_t body_offset, uint32_t body_size);
+
+        /**
+         * @brief Append a function, copying @p body into the owned code buffer
+         * 
+         * A borrowed code buffer is copied into owned storage first.
+         */
+        void append(span<const LocalGroup> locals, span<const uint8_t> body);
+
+        /**
+         * @brief Run-length local declarations of function @p index
+         */
+        span<const LocalGroup> locals(size_t index) const noexcept {
+            const uint32_t begin = local_begin_[index];
+            const uint32_t end = index + 1 < local_begin_.size()
+                ? local_begin_[index + 1] : static_cast<uint32_t>(local_groups_.size());
+            return span<const LocalGroup>(local_groups_.data() + begin, end - begin);
+        }
+
+        /**
+         * @brief Number of locals (expanded) of function @p index
+         */
+        uint32_t local_count(size_t index) const noexcept { return local_counts_[index]; }
+
+        /**
+         * @brief Body bytes of function @p index (instructions through end)
+         */
+        span<const uint8_t> body(size_t index) const noexcept {
+            return code().subspan(body_offsets_[index], body_sizes_[index]);
+        }
+
+        /**
+         * @brief Locals of function @p index, one entry per local
+         */
+        std::vector<ValueType> expand_locals(size_t index) const;
+
+        /**
+         * @brief The code buffer bodies are addressed in
+         */
+        span<const uint8_t> code() const noexcept {
+            return code_view_.data() != nullptr ? code_view_ : span<const uint8_t>(code_);
+        }
+
+    private:
+        std::vector<uint32_t> local_begin_;     // Index of first group, per function
+        std::vector<uint32_t> local_counts_;    // Expanded local count, per function
+        std::vector<uint32_t> body_offsets_;    // Body offset into code(), per function
+        std::vector<uint32_t> body_sizes_;      // Body size, per function
+        std::vector<LocalGroup> local_groups_;  // Shared run-length arena
+        std::vector<uint8_t> code_;
+        span<const uint8_t> code_view_;
     };
 
     /**
@@ -224,8 +342,16 @@ namespace flight::wasm {
         uint32_t memory_index;  // For active mode
         std::vector<uint8_t> offset_bytes;  // Constant expression as raw bytes
         std::vector<uint8_t> data;
+        span<const uint8_t> data_view;      // Borrowed payload (zero-copy parsing)
 
         Data() = default;
+
+        /**
+         * @brief Segment payload, whether owned or borrowed
+         */
+        span<const uint8_t> bytes() const noexcept {
+            return data_view.data() != nullptr ? data_view : span<const uint8_t>(data);
+        }
     };
 
     /**
@@ -245,6 +371,7 @@ namespace flight::wasm {
         std::vector<Global> globals;
         std::vector<Export> exports;
         std::vector<Function> functions;
+        CodeTable code_table;  // Flat alternative to functions (compact parsing)
         std::vector<Element> elements;
         std::vector<Data> data;
 
@@ -252,11 +379,53 @@ namespace flight::wasm {
         uint32_t start_function_index = UINT32_MAX;
         bool has_start_function = false;
 
+        // Optional data count section (bulk memory)
+        uint32_t data_count = 0;
+        bool has_data_count = false;
+
         // Custom sections (name, data pairs)
-        std::vector<std::pair<std::string, std::vector<uint8_t>>> custom_sections;
+        std::vector<std::pair<std::string_view, std::vector<uint8_t>>> custom_sections;
+
+        // Storage for interned names; shared (append-only) between copies
+        std::shared_ptr<NamePool> names;
+
+        // Owner of the bytes borrowed by Function::body_view and Data::data_view
+        // (e.g. the MappedFile a module was parsed from). Null for owning modules.
+        std::shared_ptr<const void> backing_store;
 
         Module() = default;
 
+        /**
+         * @brief Copy @p name into the module's name pool
+         * 
+         * Import, export and custom section names are views; names that do
+         * not outlive the module (i.e. anything but literals and bytes kept
+         * alive by backing_store) must be interned first.
+         */
+        std::string_view intern(std::string_view name);
+
+        /**
+         * @brief Number of defined functions, in either code representation
+         */
+        uint32_t defined_function_count() const noexcept {
+            return static_cast<uint32_t>(functions.empty() ? code_table.size() : functions.size());
+        }
+
+        /**
+         * @brief Look up an export by name
+         * 
+         * O(1) through the hashed index built by index_exports(), which the
+         * binary parser calls. Without an index (or after exports were added)
+         * this falls back to a linear scan; after renaming exports in place,
+         * call index_exports() again.
+         */
+        const Export* find_export(std::string_view name) const noexcept;
+
+        /**
+         * @brief Rebuild the export name index after modifying exports
+         */
+        void index_exports();
+
         /**
          * @brief Check if the module is valid
          * 
@@ -304,6 +473,9 @@ namespace flight::wasm {
          * @brief Get the total number of globals (imported + defined)
          */
         uint32_t total_global_count() const noexcept;
+
+    private:
+        std::unordered_map<std::string_view, uint32_t> export_index_;
     };
 
     /**
@@ -334,6 +506,97 @@ namespace flight::wasm {
         Module module_;
     };
 
+    // =========================================================================
+    // Inline Implementation - CodeTable
+    // =========================================================================
+
+    inline void CodeTable::reserve(size_t functions, size_t local_groups) {
+        local_begin_.reserve(functions);
+        local_counts_.reserve(functions);
+        body_offsets_.reserve(functions);
+        body_sizes_.reserve(functions);
+        local_groups_.reserve(local_groups);
+    }
+
+    inline void CodeTable::borrow_code(span<const uint8_t> code) noexcept {
+        code_.clear();
+        code_view_ = code;
+    }
+
+    inline void CodeTable::copy_code(span<const uint8_t> code) {
+        code_.assign(code.begin(), code.end());
+        code_view_ = span<const uint8_t>();
+    }
+
+    inline void CodeTable::add(span<const LocalGroup> locals, uint32_t body_offset, uint32_t body_size) {
+        uint32_t count = 0;
+        for (const auto& group : locals) {
+            count += group.count;
+        }
+        local_begin_.push_back(static_cast<uint32_t>(local_groups_.size()));
+        local_counts_.push_back(count);
+        body_offsets_.push_back(body_offset);
+        body_sizes_.push_back(body_size);
+        local_groups_.insert(local_groups_.end(), locals.begin(), locals.end());
+    }
+
+    inline void CodeTable::append(span<const LocalGroup> locals, span<const uint8_t> body) {
+        if (code_view_.data() != nullptr) {
+            copy_code(code_view_);
+        }
+        const auto offset = static_cast<uint32_t>(code_.size());
+        code_.insert(code_.end(), body.begin(), body.end());
+        add(locals, offset, static_cast<uint32_t>(body.size()));
+    }
+
+    inline std::vector<ValueType> CodeTable::expand_locals(size_t index) const {
+        std::vector<ValueType> expanded;
+        expanded.reserve(local_counts_[index]);
+        for (const auto& group : locals(index)) {
+            expanded.insert(expanded.end(), group.count, group.type);
+        }
+        return expanded;
+    }
+
+    // =========================================================================
+    // Inline Implementation - Module
+    // =========================================================================
+
+    inline std::string_view Module::intern(std::string_view name) {
+        if (!names) {
+            names = std::make_shared<NamePool>();
+        }
+        return names->intern(name);
+    }
+
+    inline const Export* Module::find_export(std::string_view name) const noexcept {
+        // Duplicate names or later additions leave the index smaller than the
+        // export list; a renamed entry fails the hit check below
+        if (!export_index_.empty() && export_index_.size() == exports.size()) {
+            auto entry = export_index_.find(name);
+            if (entry == export_index_.end()) {
+                return nullptr;
+            }
+            if (entry->second < exports.size() && exports[entry->second].name == name) {
+                return &exports[entry->second];
+            }
+        }
+        for (const auto& export_desc : exports) {
+            if (export_desc.name == name) {
+                return &export_desc;
+            }
+        }
+        return nullptr;
+    }
+
+    inline void Module::index_exports() {
+        export_index_.clear();
+        export_index_.reserve(exports.size());
+        for (uint32_t i = 0; i < exports.size(); ++i) {
+            export_index_.emplace(exports[i].name, i);
+        }
+    }
+
 } // namespace flight::wasm
 
 #endif // FLIGHT_WASM_TYPES_MODULES_HPP
@@ -13,6 +13,7 @@
 #include <flight/wasm/utilities/platform.hpp>
 #include <cstring>
 #include <array>
+#include <limits>
 
 namespace flight::wasm::endian {
 
@@ -27,6 +27,8 @@ namespace flight::wasm {
      * - Memory: 0x3000-0x3FFF
      * - Instruction: 0x4000-0x4FFF
      * - Module: 0x5000-0x5FFF
+     * - I/O: 0x6000-0x6FFF
+     * - Text format: 0x7000-0x7FFF
      */
     enum class ErrorCode : uint32_t {
         // Success
@@ -79,7 +81,21 @@ namespace flight::wasm {
         CircularDependency = 0x5002,
         ExportNotFound = 0x5003,
         ImportResolutionFailed = 0x5004,
-        ModuleInstantiationFailed = 0x5005
+        ModuleInstantiationFailed = 0x5005,
+        
+        // I/O errors (0x6000-0x6FFF)
+        FileOpenFailed = 0x6000,
+        FileReadFailed = 0x6001,
+        FileMapFailed = 0x6002,
+        FileWriteFailed = 0x6003,
+
+        // Text format errors (0x7000-0x7FFF)
+        UnexpectedToken = 0x7000,
+        UnterminatedString = 0x7001,
+        UnterminatedComment = 0x7002,
+        InvalidNumber = 0x7003,
+        UnknownIdentifier = 0x7004,
+        DuplicateIdentifier = 0x7005
     };
 
     /**
@@ -117,6 +133,20 @@ namespace flight::wasm {
         return error_category(code) == 0x3000;
     }
 
+    /**
+     * @brief Check if an error code represents an I/O error
+     */
+    constexpr bool is_io_error(ErrorCode code) noexcept {
+        return error_category(code) == 0x6000;
+    }
+
+    /**
+     * @brief Check if an error code represents a text format error
+     */
+    constexpr bool is_text_error(ErrorCode code) noexcept {
+        return error_category(code) == 0x7000;
+    }
+
     /**
      * @brief Lightweight error representation
      * 
@@ -387,6 +417,55 @@ namespace flight::wasm {
         } storage_;
     };
 
+    /**
+     * @brief Result specialization for operations without a value
+     * 
+     * A default-constructed Error (ErrorCode::Success) denotes success, so
+     * `Result<void>{Error{}}` is the idiomatic successful return.
+     */
+    template<>
+    class Result<void> {
+    public:
+        /**
+         * @brief Construct a successful result
+         */
+        constexpr Result() noexcept : error_() {}
+
+        /**
+         * @brief Construct a result from an error (success if error.success())
+         */
+        constexpr Result(Error error) noexcept : error_(error) {}
+
+        /**
+         * @brief Construct a failed result with an error code
+         */
+        constexpr Result(ErrorCode code, std::string_view message = "") noexcept
+            : error_(code, message) {}
+
+        /**
+         * @brief Check if the operation succeeded
+         */
+        constexpr bool success() const noexcept { return error_.success(); }
+
+        /**
+         * @brief Check if the operation failed
+         */
+        constexpr bool failed() const noexcept { return error_.failed(); }
+
+        /**
+         * @brief Implicit conversion to bool (true = success, false = error)
+         */
+        constexpr explicit operator bool() const noexcept { return success(); }
+
+        /**
+         * @brief Get the error
+         */
+        constexpr const Error& error() const noexcept { return error_; }
+
+    private:
+        Error error_;
+    };
+
     /**
      * @brief Convenience function to create a successful Result
      */
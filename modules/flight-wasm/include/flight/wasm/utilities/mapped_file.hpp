@@ -0,0 +1,206 @@
+#ifndef FLIGHT_WASM_UTILITIES_MAPPED_FILE_HPP
+#define FLIGHT_WASM_UTILITIES_MAPPED_FILE_HPP
+
+/**
+ * @file mapped_file.hpp
+ * @brief Read-only file mapping used as a zero-copy module backing store
+ *
+ * On POSIX hosts the file is mapped with mmap(PROT_READ, MAP_PRIVATE) so that
+ * large modules are paged in on demand and the page cache is shared between
+ * every process loading the same file. Embedded targets without virtual
+ * memory fall back to a single heap read with the same interface.
+ */
+
+#include <flight/wasm/utilities/error.hpp>
+#include <flight/wasm/utilities/span.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__DREAMCAST__) && \
+    !defined(__PSP__) && !defined(__vita__) && !defined(__EMSCRIPTEN__)
+    #define FLIGHT_WASM_HAS_MMAP 1
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#else
+    #define FLIGHT_WASM_HAS_MMAP 0
+#endif
+
+namespace flight::wasm {
+
+    /**
+     * @brief Paging hints applied when mapping a file
+     */
+    struct MappingOptions {
+        /// Advise sequential access (MADV_SEQUENTIAL) for aggressive read-ahead
+        bool sequential = true;
+
+        /// Pre-fault every page at map time (MAP_POPULATE, Linux only)
+        bool populate = false;
+
+        /// Start asynchronous read-ahead of the whole file (MADV_WILLNEED)
+        bool will_need = false;
+    };
+
+    /**
+     * @brief Read-only view of a whole file
+     *
+     * Always held through std::shared_ptr so that modules parsed zero-copy can
+     * share ownership of the bytes they borrow.
+     */
+    class MappedFile {
+    public:
+        /**
+         * @brief Map (or, without mmap support, read) a file
+         */
+        static Result<std::shared_ptr<MappedFile>> open(const std::string& filename,
+                                                        const MappingOptions& options = {}) noexcept;
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile() {
+#if FLIGHT_WASM_HAS_MMAP
+            if (mapping_ != nullptr) {
+                ::munmap(mapping_, size_);
+            }
+#endif
+        }
+
+        /**
+         * @brief File contents
+         */
+        span<const uint8_t> bytes() const noexcept {
+            return span<const uint8_t>(data_, size_);
+        }
+
+        /**
+         * @brief File size in bytes
+         */
+        size_t size() const noexcept { return size_; }
+
+        /**
+         * @brief True if the bytes live in a file mapping rather than the heap
+         */
+        bool is_mapped() const noexcept { return mapping_ != nullptr; }
+
+        /**
+         * @brief Switch paging advice to sequential (single forward pass)
+         */
+        void advise_sequential() const noexcept {
+#if FLIGHT_WASM_HAS_MMAP && defined(POSIX_MADV_SEQUENTIAL)
+            if (mapping_ != nullptr) {
+                ::posix_madvise(mapping_, size_, POSIX_MADV_SEQUENTIAL);
+            }
+#endif
+        }
+
+        /**
+         * @brief Switch paging advice back to the default (random access)
+         *
+         * Called once parsing is done: later accesses to function bodies and
+         * data segments are no longer in file order.
+         */
+        void advise_normal() const noexcept {
+#if FLIGHT_WASM_HAS_MMAP && defined(POSIX_MADV_NORMAL)
+            if (mapping_ != nullptr) {
+                ::posix_madvise(mapping_, size_, POSIX_MADV_NORMAL);
+            }
+#endif
+        }
+
+    private:
+        MappedFile() = default;
+
+        void* mapping_ = nullptr;          // mmap base, null when heap-backed or empty
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+        std::vector<uint8_t> fallback_;    // Heap copy on targets without mmap
+    };
+
+    // =========================================================================
+    // Inline Implementation
+    // =========================================================================
+
+    inline Result<std::shared_ptr<MappedFile>> MappedFile::open(const std::string& filename,
+                                                                const MappingOptions& options) noexcept {
+        std::shared_ptr<MappedFile> file(new (std::nothrow) MappedFile());
+        if (!file) {
+            return Result<std::shared_ptr<MappedFile>>{ErrorCode::OutOfMemory, "Failed to allocate file mapping"};
+        }
+
+#if FLIGHT_WASM_HAS_MMAP
+        int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return Result<std::shared_ptr<MappedFile>>{ErrorCode::FileOpenFailed, "Failed to open file"};
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return Result<std::shared_ptr<MappedFile>>{ErrorCode::FileReadFailed, "Failed to stat file"};
+        }
+
+        file->size_ = static_cast<size_t>(st.st_size);
+        if (file->size_ == 0) {
+            // mmap rejects zero-length mappings; an empty view is still valid
+            ::close(fd);
+            return Result<std::shared_ptr<MappedFile>>{std::move(file)};
+        }
+
+        int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+        if (options.populate) {
+            flags |= MAP_POPULATE;
+        }
+#endif
+        void* mapping = ::mmap(nullptr, file->size_, PROT_READ, flags, fd, 0);
+        ::close(fd);  // The mapping keeps its own reference to the file
+        if (mapping == MAP_FAILED) {
+            return Result<std::shared_ptr<MappedFile>>{ErrorCode::FileMapFailed, "Failed to map file"};
+        }
+
+        file->mapping_ = mapping;
+        file->data_ = static_cast<const uint8_t*>(mapping);
+
+        if (options.sequential) {
+            file->advise_sequential();
+        }
+#ifdef POSIX_MADV_WILLNEED
+        if (options.will_need) {
+            ::posix_madvise(mapping, file->size_, POSIX_MADV_WILLNEED);
+        }
+#endif
+#else
+        (void)options;
+        std::FILE* handle = std::fopen(filename.c_str(), "rb");
+        if (handle == nullptr) {
+            return Result<std::shared_ptr<MappedFile>>{ErrorCode::FileOpenFailed, "Failed to open file"};
+        }
+
+        bool ok = std::fseek(handle, 0, SEEK_END) == 0;
+        long length = ok ? std::ftell(handle) : -1;
+        ok = ok && length >= 0 && std::fseek(handle, 0, SEEK_SET) == 0;
+        if (ok) {
+            file->fallback_.resize(static_cast<size_t>(length));
+            ok = std::fread(file->fallback_.data(), 1, file->fallback_.size(), handle) == file->fallback_.size();
+        }
+        std::fclose(handle);
+        if (!ok) {
+            return Result<std::shared_ptr<MappedFile>>{ErrorCode::FileReadFailed, "Failed to read file"};
+        }
+
+        file->data_ = file->fallback_.data();
+        file->size_ = file->fallback_.size();
+#endif
+
+        return Result<std::shared_ptr<MappedFile>>{std::move(file)};
+    }
+
+} // namespace flight::wasm
+
+#endif // FLIGHT_WASM_UTILITIES_MAPPED_FILE_HPP
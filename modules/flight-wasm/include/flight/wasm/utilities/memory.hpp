@@ -13,7 +13,11 @@
 #include <memory>
 #include <new>
 #include <cstdlib>
-#include <stack>
+#include <atomic>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <utility>
 #include <cstring>
 
 namespace flight::wasm::memory {
@@ -269,6 +273,14 @@ namespace flight::wasm::memory {
     };
 
     // Memory pool for frequent allocations (reduces fragmentation)
+    //
+    // Lock-free: free slots form a stack threaded through a per-slot link
+    // array and a head word packing the top slot index with a version tag
+    // bumped on every pop and push, so a stale compare-exchange can never
+    // succeed after the slot was recycled (ABA). The links live beside the
+    // slots rather than inside them so a racing pop never reads the bytes of
+    // a live object. Objects are constructed in place by acquire() and
+    // destroyed by release().
     template<typename T, size_t PoolSize = 64>
     class ObjectPool {
     public:
@@ -276,25 +288,42 @@ namespace flight::wasm::memory {
             platform::CurrentPlatform::is_embedded ?
             std::min(PoolSize, platform::CurrentPlatform::max_memory / (sizeof(T) * 16)) : PoolSize;
         
-        ObjectPool() {
-            // Initialize free list
+        ObjectPool() noexcept {
+            // Initialize free list: slot i links to slot i + 1
             for (size_t i = 0; i < pool_size; ++i) {
-                free_objects_.push(reinterpret_cast<T*>(&objects_[i]));
+                links_[i].store(static_cast<Index>(i + 1), std::memory_order_relaxed);
             }
+            head_.store(pack(0, 0), std::memory_order_release);
         }
         
         ~ObjectPool() {
-            // Objects are automatically destroyed with the pool
+            // Objects still acquired are not destroyed
         }
         
-        T* acquire() noexcept {
-            if (free_objects_.empty()) {
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+        
+        // Constructs a T from args in a free slot; nullptr when exhausted
+        template<typename... Args>
+        T* acquire(Args&&... args) noexcept(std::is_nothrow_constructible<T, Args...>::value) {
+            const Index index = pop();
+            if (index == EMPTY) {
                 return nullptr; // Pool exhausted
             }
             
-            T* obj = free_objects_.top();
-            free_objects_.pop();
-            return obj;
+            void* slot = &objects_[index];
+            if constexpr (std::is_nothrow_constructible<T, Args...>::value) {
+                return ::new (slot) T(std::forward<Args>(args)...);
+            } else {
+                struct ReturnSlot {
+                    ObjectPool* pool;
+                    Index index;
+                    ~ReturnSlot() { if (pool) pool->push(index); }
+                } guard{this, index};
+                T* obj = ::new (slot) T(std::forward<Args>(args)...);
+                guard.pool = nullptr;
+                return obj;
+            }
         }
         
         void release(T* obj) noexcept {
@@ -305,16 +334,24 @@ namespace flight::wasm::memory {
             const uintptr_t pool_start = reinterpret_cast<uintptr_t>(objects_);
             const uintptr_t pool_end = pool_start + sizeof(objects_);
             
-            if (obj_addr >= pool_start && obj_addr < pool_end) {
-                // Call destructor but don't deallocate memory
+            if (obj_addr >= pool_start && obj_addr < pool_end &&
+                (obj_addr - pool_start) % sizeof(ObjectStorage) == 0) {
                 obj->~T();
-                free_objects_.push(obj);
+                push(static_cast<Index>((obj_addr - pool_start) / sizeof(ObjectStorage)));
             }
             // Ignore objects not from this pool
         }
         
+        // Walks the free list: exact when quiescent, approximate under
+        // concurrent use (kept off the acquire/release path)
         size_t available() const noexcept {
-            return free_objects_.size();
+            size_t count = 0;
+            Index index = unpack_index(head_.load(std::memory_order_acquire));
+            while (index != EMPTY && count < pool_size) {
+                ++count;
+                index = links_[index].load(std::memory_order_relaxed);
+            }
+            return count;
         }
         
         size_t capacity() const noexcept {
@@ -322,10 +359,57 @@ namespace flight::wasm::memory {
         }
         
         bool empty() const noexcept {
-            return free_objects_.empty();
+            return unpack_index(head_.load(std::memory_order_acquire)) == EMPTY;
         }
         
     private:
+        // 32-bit index and tag when 64-bit atomics are native, 16-bit halves
+        // otherwise (pools of up to 65534 objects)
+        static constexpr bool wide_head = std::atomic<uint64_t>::is_always_lock_free;
+        using Head = std::conditional_t<wide_head, uint64_t, uint32_t>;
+        using Index = std::conditional_t<wide_head, uint32_t, uint16_t>;
+        static constexpr unsigned index_bits = sizeof(Index) * 8;
+        static constexpr Index EMPTY = static_cast<Index>(pool_size);
+        
+        static_assert(pool_size < static_cast<size_t>(std::numeric_limits<Index>::max()),
+                      "ObjectPool size exceeds the free-list index range");
+        
+        static constexpr Head pack(Index index, Head tag) noexcept {
+            return static_cast<Head>((tag << index_bits) | index);
+        }
+        static constexpr Index unpack_index(Head head) noexcept {
+            return static_cast<Index>(head);
+        }
+        static constexpr Head unpack_tag(Head head) noexcept {
+            return head >> index_bits;
+        }
+        
+        Index pop() noexcept {
+            Head head = head_.load(std::memory_order_acquire);
+            for (;;) {
+                const Index index = unpack_index(head);
+                if (index == EMPTY) {
+                    return EMPTY;
+                }
+                const Index next = links_[index].load(std::memory_order_relaxed);
+                if (head_.compare_exchange_weak(head, pack(next, unpack_tag(head) + 1),
+                                                std::memory_order_acquire, std::memory_order_acquire)) {
+                    return index;
+                }
+            }
+        }
+        
+        void push(Index index) noexcept {
+            Head head = head_.load(std::memory_order_relaxed);
+            for (;;) {
+                links_[index].store(unpack_index(head), std::memory_order_relaxed);
+                if (head_.compare_exchange_weak(head, pack(index, unpack_tag(head) + 1),
+                                                std::memory_order_release, std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+        }
+        
         // Use union to avoid default construction
         union ObjectStorage {
             T object;
@@ -333,8 +417,9 @@ namespace flight::wasm::memory {
             ~ObjectStorage() {} // No-op destructor
         };
         
+        alignas(platform::CurrentPlatform::cache_line_size) std::atomic<Head> head_;
+        alignas(platform::CurrentPlatform::cache_line_size) std::atomic<Index> links_[pool_size];
         ObjectStorage objects_[pool_size];
-        std::stack<T*> free_objects_;
     };
 
     // Memory-mapped region for large allocations (platform-specific)
@@ -0,0 +1,117 @@
+#ifndef FLIGHT_WASM_UTILITIES_NAME_POOL_HPP
+#define FLIGHT_WASM_UTILITIES_NAME_POOL_HPP
+
+/**
+ * @file name_pool.hpp
+ * @brief Interned storage for import, export and custom section names
+ *
+ * Names are copied once into large append-only blocks and handed out as
+ * std::string_view; equal names share one copy. Views stay valid for the
+ * lifetime of the pool because blocks are never reallocated.
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace flight::wasm {
+
+    /**
+     * @brief Append-only pool of deduplicated names
+     *
+     * Not thread-safe; a pool belongs to the module that owns it.
+     */
+    class NamePool {
+    public:
+        /**
+         * @brief Default size of each storage block
+         */
+        static constexpr size_t DEFAULT_BLOCK_SIZE = 16 * 1024;
+
+        explicit NamePool(size_t block_size = DEFAULT_BLOCK_SIZE) noexcept
+            : block_size_(block_size > 0 ? block_size : DEFAULT_BLOCK_SIZE) {}
+
+        NamePool(const NamePool&) = delete;
+        NamePool& operator=(const NamePool&) = delete;
+
+        /**
+         * @brief Return the pooled copy of @p name, adding it if necessary
+         */
+        std::string_view intern(std::string_view name);
+
+        /**
+         * @brief Check whether @p name has been interned
+         */
+        bool contains(std::string_view name) const noexcept {
+            return names_.find(name) != names_.end();
+        }
+
+        /**
+         * @brief Number of distinct names
+         */
+        size_t size() const noexcept { return names_.size(); }
+
+        /**
+         * @brief Total bytes of name storage in use
+         */
+        size_t bytes_used() const noexcept { return bytes_used_; }
+
+        /**
+         * @brief Pre-size the lookup table for @p count names
+         */
+        void reserve(size_t count) { names_.reserve(count); }
+
+    private:
+        const char* store(std::string_view name);
+
+        std::vector<std::unique_ptr<char[]>> blocks_;
+        char* cursor_ = nullptr;
+        size_t available_ = 0;
+        size_t block_size_;
+        size_t bytes_used_ = 0;
+        std::unordered_set<std::string_view> names_;
+    };
+
+    // =========================================================================
+    // Inline Implementation
+    // =========================================================================
+
+    inline std::string_view NamePool::intern(std::string_view name) {
+        auto existing = names_.find(name);
+        if (existing != names_.end()) {
+            return *existing;
+        }
+        if (name.empty()) {
+            return *names_.insert(std::string_view()).first;
+        }
+        std::string_view pooled(store(name), name.size());
+        names_.insert(pooled);
+        return pooled;
+    }
+
+    inline const char* NamePool::store(std::string_view name) {
+        bytes_used_ += name.size();
+        if (name.size() > block_size_ / 4) {
+            // Oversized names get a dedicated block so the current one is not wasted
+            blocks_.emplace_back(new char[name.size()]);
+            std::memcpy(blocks_.back().get(), name.data(), name.size());
+            return blocks_.back().get();
+        }
+        if (name.size() > available_) {
+            blocks_.emplace_back(new char[block_size_]);
+            cursor_ = blocks_.back().get();
+            available_ = block_size_;
+        }
+        char* destination = cursor_;
+        std::memcpy(destination, name.data(), name.size());
+        cursor_ += name.size();
+        available_ -= name.size();
+        return destination;
+    }
+
+} // namespace flight::wasm
+
+#endif // FLIGHT_WASM_UTILITIES_NAME_POOL_HPP
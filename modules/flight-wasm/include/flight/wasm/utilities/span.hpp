@@ -0,0 +1,53 @@
+#ifndef FLIGHT_WASM_UTILITIES_SPAN_HPP
+#define FLIGHT_WASM_UTILITIES_SPAN_HPP
+
+/**
+ * @file span.hpp
+ * @brief Non-owning contiguous view for C++17 compatibility
+ *
+ * Shared by the binary parser, encoder and module representation so that
+ * borrowed byte ranges (e.g. a memory-mapped module file) can be passed
+ * around without copying.
+ */
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace flight::wasm {
+
+    /**
+     * @brief Simple span-like view for C++17 compatibility
+     */
+    template<typename T>
+    class span {
+    public:
+        constexpr span() noexcept : data_(nullptr), size_(0) {}
+        constexpr span(T* data, size_t size) noexcept : data_(data), size_(size) {}
+        constexpr span(const std::vector<std::remove_const_t<T>>& vec) noexcept
+            : data_(vec.data()), size_(vec.size()) {}
+
+        constexpr T* data() const noexcept { return data_; }
+        constexpr size_t size() const noexcept { return size_; }
+        constexpr bool empty() const noexcept { return size_ == 0; }
+
+        constexpr T& operator[](size_t index) const noexcept { return data_[index]; }
+        constexpr T* begin() const noexcept { return data_; }
+        constexpr T* end() const noexcept { return data_ + size_; }
+
+        /**
+         * @brief View of @p count elements starting at @p offset
+         * @pre offset + count <= size()
+         */
+        constexpr span subspan(size_t offset, size_t count) const noexcept {
+            return span(data_ + offset, count);
+        }
+
+    private:
+        T* data_;
+        size_t size_;
+    };
+
+} // namespace flight::wasm
+
+#endif // FLIGHT_WASM_UTILITIES_SPAN_HPP
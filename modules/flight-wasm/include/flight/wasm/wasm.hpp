@@ -10,7 +10,7 @@
  * - Binary format parsing and encoding
  * - Validation and error handling
  * - Platform-specific optimizations
- * - Text format support (future)
+ * - Text format support
  * 
  * Simply include this header to access the complete Flight WASM toolkit.
  */
@@ -29,7 +29,7 @@
 #include <flight/wasm/binary/encoder.hpp>
 #include <flight/wasm/binary/validation.hpp>
 
-// Text format support (placeholder for future development)
+// Text format support
 #include <flight/wasm/text/parser.hpp>
 
 namespace flight::wasm {
@@ -111,14 +111,14 @@ namespace flight::wasm {
         }
 
         /**
-         * @brief Parse a WebAssembly text format module (future)
+         * @brief Parse a WebAssembly text format module
          */
         inline Result<Module> parse_text(std::string_view text) {
             return TextParser::parse(text);
         }
 
         /**
-         * @brief Encode a module to WebAssembly text format (future)
+         * @brief Encode a module to WebAssembly text format
          */
         inline Result<std::string> encode_text(const Module& module) {
             return TextEncoder::encode(module);
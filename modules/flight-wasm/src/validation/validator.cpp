@@ -4,6 +4,9 @@
  */
 
 #include <flight/wasm/validation/validator.hpp>
+#include <string>
+#include <string_view>
+#include <unordered_set>
 
 namespace flight::wasm::validation {
 
@@ -120,12 +123,12 @@ namespace flight::wasm::validation {
         const std::vector<Export>& exports,
         const Module& module) noexcept {
         // Check for duplicate export names
-        for (size_t i = 0; i < exports.size(); ++i) {
-            for (size_t j = i + 1; j < exports.size(); ++j) {
-                if (exports[i].name == exports[j].name) {
-                    return Result<void>{ErrorCode::InvalidModule, 
-                        "Duplicate export name: " + exports[i].name};
-                }
+        std::unordered_set<std::string_view> seen_names;
+        seen_names.reserve(exports.size());
+        for (const auto& export_desc : exports) {
+            if (!seen_names.insert(export_desc.name).second) {
+                return Result<void>{ErrorCode::InvalidModule, 
+                    "Duplicate export name: " + std::string(export_desc.name)};
             }
         }
         
@@ -134,7 +137,7 @@ namespace flight::wasm::validation {
             switch (export_desc.kind) {
                 case Export::Kind::Function: {
                     uint32_t total_functions = module.imported_function_count() + 
-                                             static_cast<uint32_t>(module.functions.size());
+                                             module.defined_function_count();
                     if (export_desc.index >= total_functions) {
                         return Result<void>{ErrorCode::InvalidFunctionIndex, 
                             "Export references invalid function index"};
@@ -0,0 +1,330 @@
+// =============================================================================
+// Flight WASM Tests - Binary Encoder
+// WebAssembly Binary Format Encoding Tests
+// =============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/wasm/binary/encoder.hpp>
+#include <flight/wasm/binary/parser.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace flight::wasm;
+
+namespace {
+
+    // Canonically encoded module touching every standard section
+    std::vector<uint8_t> make_full_module() {
+        return {
+            0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00,                // header
+            0x01, 0x08, 0x02, 0x60, 0x00, 0x00, 0x60, 0x01, 0x7F, 0x00,    // type
+            0x02, 0x0D, 0x01, 0x03, 'e', 'n', 'v', 0x05, 'p', 'r', 'i', 'n', 't',
+                  0x00, 0x01,                                              // import
+            0x03, 0x03, 0x02, 0x00, 0x00,                                  // function
+            0x04, 0x04, 0x01, 0x70, 0x00, 0x02,                            // table
+            0x05, 0x04, 0x01, 0x01, 0x01, 0x02,                            // memory
+            0x06, 0x06, 0x01, 0x7F, 0x01, 0x41, 0x2A, 0x0B,                // global
+            0x07, 0x08, 0x01, 0x04, 'm', 'a', 'i', 'n', 0x00, 0x01,        // export
+            0x08, 0x01, 0x01,                                              // start
+            0x09, 0x0B, 0x02, 0x00, 0x41, 0x00, 0x0B, 0x01, 0x01,
+                  0x01, 0x00, 0x01, 0x02,                                  // element
+            0x0C, 0x01, 0x02,                                              // data count
+            0x0A, 0x0B, 0x02, 0x02, 0x00, 0x0B, 0x06, 0x01, 0x03, 0x7F,
+                  0x10, 0x02, 0x0B,                                        // code
+            0x0B, 0x0D, 0x02, 0x00, 0x41, 0x08, 0x0B, 0x03, 'a', 'b', 'c',
+                  0x01, 0x02, 'x', 'y',                                    // data
+            0x00, 0x05, 0x04, 'n', 'o', 't', 'e'                           // custom
+        };
+    }
+
+    Module parse_module(const std::vector<uint8_t>& bytes) {
+        auto parsed = BinaryParser::parse(bytes);
+        REQUIRE(parsed.success());
+        return std::move(parsed).value();
+    }
+
+} // namespace
+
+// =============================================================================
+// BinaryWriter Tests
+// =============================================================================
+
+TEST_CASE("BinaryWriter LEB128 encoding", "[binary][writer][leb128]") {
+    SECTION("Unsigned values use the minimal width") {
+        BinaryWriter writer;
+        writer.write_leb128_u32(0);
+        writer.write_leb128_u32(127);
+        writer.write_leb128_u32(128);
+        writer.write_leb128_u32(UINT32_MAX);
+        REQUIRE(writer.data() == std::vector<uint8_t>{0x00, 0x7F, 0x80, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F});
+    }
+
+    SECTION("Signed values round-trip through BinaryReader") {
+        BinaryWriter writer;
+        writer.write_leb128_i32(-1);
+        writer.write_leb128_i32(INT32_MIN);
+        writer.write_leb128_i64(INT64_MIN);
+        writer.write_leb128_i64(63);
+        writer.write_leb128_i64(64);
+
+        BinaryReader reader(writer.data());
+        REQUIRE(reader.read_leb128_i32().value() == -1);
+        REQUIRE(reader.read_leb128_i32().value() == INT32_MIN);
+        REQUIRE(reader.read_leb128_i64().value() == INT64_MIN);
+        REQUIRE(reader.read_leb128_i64().value() == 63);
+        REQUIRE(reader.read_leb128_i64().value() == 64);
+        REQUIRE_FALSE(reader.has_data());
+    }
+
+    SECTION("Size helper matches emitted width") {
+        for (uint32_t value : {0u, 127u, 128u, 16383u, 16384u, 0x0FFFFFFFu, UINT32_MAX}) {
+            BinaryWriter writer;
+            writer.write_leb128_u32(value);
+            REQUIRE(writer.size() == BinaryWriter::leb128_u32_size(value));
+        }
+    }
+}
+
+TEST_CASE("BinaryWriter output modes", "[binary][writer]") {
+    SECTION("Counting writer tracks size without storing bytes") {
+        BinaryWriter counter = BinaryWriter::counting();
+        std::vector<uint8_t> payload(1000, 0xAB);
+        counter.write_string("name");
+        counter.write_bytes(payload);
+        REQUIRE(counter.size() == 1005);
+        REQUIRE(counter.data().empty());
+    }
+
+    SECTION("Streaming writer delivers staged and large writes in order") {
+        std::vector<uint8_t> received;
+        size_t chunks = 0;
+        BinaryWriter writer([&](span<const uint8_t> chunk) {
+            received.insert(received.end(), chunk.begin(), chunk.end());
+            ++chunks;
+            return true;
+        }, 16);
+
+        std::vector<uint8_t> large(64);
+        for (size_t i = 0; i < large.size(); ++i) {
+            large[i] = static_cast<uint8_t>(i);
+        }
+        writer.write_byte(0xEE);
+        writer.write_bytes(large);
+        writer.write_u32(0x04030201);
+        REQUIRE(writer.flush());
+
+        REQUIRE(received.size() == 69);
+        REQUIRE(received[0] == 0xEE);
+        REQUIRE(received[1] == 0x00);
+        REQUIRE(received[64] == 0x3F);
+        REQUIRE(received[65] == 0x01);
+        REQUIRE(chunks == 3);
+    }
+
+    SECTION("Sink failure is sticky") {
+        BinaryWriter writer([](span<const uint8_t>) { return false; }, 4);
+        writer.write_u64(1);
+        REQUIRE(writer.failed());
+        REQUIRE_FALSE(writer.flush());
+    }
+}
+
+// =============================================================================
+// BinaryEncoder Tests
+// =============================================================================
+
+TEST_CASE("BinaryEncoder round-trips canonical modules", "[binary][encoder]") {
+    auto original = make_full_module();
+    Module module = parse_module(original);
+
+    auto encoded = BinaryEncoder::encode(module);
+    REQUIRE(encoded.success());
+    REQUIRE(encoded.value() == original);
+    REQUIRE(encoded.value().capacity() == original.size());
+
+    auto size = BinaryEncoder::calculate_size(module);
+    REQUIRE(size.success());
+    REQUIRE(size.value() == original.size());
+}
+
+TEST_CASE("BinaryEncoder re-encodes zero-copy modules", "[binary][encoder]") {
+    auto original = make_full_module();
+    BinaryParser::ParseOptions options;
+    options.zero_copy = true;
+    auto parsed = BinaryParser::parse(original, options);
+    REQUIRE(parsed.success());
+
+    auto encoded = BinaryEncoder::encode(parsed.value());
+    REQUIRE(encoded.success());
+    REQUIRE(encoded.value() == original);
+}
+
+TEST_CASE("BinaryEncoder compresses expanded locals", "[binary][encoder]") {
+    Module module;
+    module.types.push_back(FunctionType{});
+    module.function_type_indices.push_back(0);
+    std::vector<ValueType> locals(200, ValueType::I32);
+    locals.push_back(ValueType::F64);
+    module.functions.push_back(Function(0, locals, {0x0B}));
+
+    auto encoded = BinaryEncoder::encode(module);
+    REQUIRE(encoded.success());
+
+    Module decoded = parse_module(encoded.value());
+    REQUIRE(decoded.functions.size() == 1);
+    REQUIRE(decoded.functions[0].locals == locals);
+
+    auto size = BinaryEncoder::calculate_size(module);
+    REQUIRE(size.value() == encoded.value().size());
+}
+
+TEST_CASE("BinaryEncoder rejects inconsistent modules", "[binary][encoder]") {
+    Module module;
+    module.types.push_back(FunctionType{});
+    module.function_type_indices.push_back(0);
+
+    auto encoded = BinaryEncoder::encode(module);
+    REQUIRE(encoded.failed());
+    REQUIRE(encoded.error().code() == ErrorCode::InvalidModule);
+    REQUIRE(BinaryEncoder::calculate_size(module).failed());
+}
+
+TEST_CASE("BinaryEncoder streams to sinks and files", "[binary][encoder][streaming]") {
+    auto original = make_full_module();
+    Module module = parse_module(original);
+
+    SECTION("Sink receives the exact encoding") {
+        std::vector<uint8_t> received;
+        auto written = BinaryEncoder::encode_to(module, [&](span<const uint8_t> chunk) {
+            received.insert(received.end(), chunk.begin(), chunk.end());
+            return true;
+        });
+        REQUIRE(written.success());
+        REQUIRE(written.value() == original.size());
+        REQUIRE(received == original);
+    }
+
+    SECTION("Failing sink reports a write error") {
+        auto written = BinaryEncoder::encode_to(module, [](span<const uint8_t>) { return false; });
+        REQUIRE(written.failed());
+        REQUIRE(written.error().code() == ErrorCode::FileWriteFailed);
+    }
+
+    SECTION("File output parses back") {
+        std::string path = "flight_wasm_test_encoder.wasm";
+        REQUIRE(BinaryEncoder::encode_to_file(module, path).success());
+
+        auto reparsed = BinaryParser::parse_file(path);
+        REQUIRE(reparsed.success());
+        REQUIRE(BinaryEncoder::encode(reparsed.value()).value() == original);
+        std::remove(path.c_str());
+    }
+
+    SECTION("Chunked streaming encoder concatenates to the same bytes") {
+        for (size_t chunk_size : {size_t(1), size_t(7), size_t(65536)}) {
+            StreamingBinaryEncoder encoder(module);
+            std::vector<uint8_t> assembled;
+            while (!encoder.is_complete()) {
+                auto chunk = encoder.encode_chunk(chunk_size);
+                REQUIRE(chunk.success());
+                REQUIRE(chunk.value().size() <= chunk_size);
+                assembled.insert(assembled.end(), chunk.value().begin(), chunk.value().end());
+            }
+            REQUIRE(assembled == original);
+            REQUIRE(encoder.encoded_size() == original.size());
+        }
+    }
+}
+
+TEST_CASE("BinaryEncoder splices modified sections into the original", "[binary][encoder][splice]") {
+    auto original = make_full_module();
+    Module module = parse_module(original);
+
+    SECTION("No modifications reproduce the input") {
+        auto spliced = BinaryEncoder::splice(original, module, SectionSet{});
+        REQUIRE(spliced.success());
+        REQUIRE(spliced.value() == original);
+    }
+
+    SECTION("Rewritten export section matches a full re-encode") {
+        module.exports[0].name = "entry_point";
+        module.exports.push_back(Export("memory", Export::Kind::Memory, 0));
+
+        auto spliced = BinaryEncoder::splice(original, module, SectionSet{SectionId::Export});
+        REQUIRE(spliced.success());
+        REQUIRE(spliced.value() == BinaryEncoder::encode(module).value());
+        REQUIRE(parse_module(spliced.value()).exports[1].name == "memory");
+    }
+
+    SECTION("Added custom section is appended") {
+        module.custom_sections.emplace_back("producers", std::vector<uint8_t>{0x00});
+
+        auto spliced = BinaryEncoder::splice(original, module, SectionSet{SectionId::Custom});
+        REQUIRE(spliced.success());
+        std::vector<uint8_t> prefix(spliced.value().begin(),
+                                    spliced.value().begin() + static_cast<std::ptrdiff_t>(original.size()));
+        REQUIRE(prefix == original);
+        REQUIRE(parse_module(spliced.value()).custom_sections.size() == 2);
+    }
+
+    SECTION("Emptied sections are dropped") {
+        module.custom_sections.clear();
+        module.has_start_function = false;
+
+        auto spliced = BinaryEncoder::splice(original, module, SectionSet{SectionId::Custom, SectionId::Start});
+        REQUIRE(spliced.success());
+        REQUIRE(spliced.value() == BinaryEncoder::encode(module).value());
+        REQUIRE(spliced.value().size() == original.size() - 7 - 3);
+    }
+
+    SECTION("Sections missing from the input are inserted in order") {
+        Module stripped = module;
+        stripped.exports.clear();
+        stripped.globals.clear();
+        auto base = BinaryEncoder::encode(stripped).value();
+
+        Module edited = parse_module(base);
+        edited.exports = module.exports;
+        edited.globals = module.globals;
+        auto spliced = BinaryEncoder::splice(base, edited, SectionSet{SectionId::Export, SectionId::Global});
+        REQUIRE(spliced.success());
+        REQUIRE(spliced.value() == original);
+    }
+
+    SECTION("Sink output matches buffered output") {
+        module.exports[0].name = "run";
+        std::vector<uint8_t> received;
+        auto written = BinaryEncoder::splice_to(original, module, SectionSet{SectionId::Export},
+                                                [&](span<const uint8_t> chunk) {
+            received.insert(received.end(), chunk.begin(), chunk.end());
+            return true;
+        });
+        REQUIRE(written.success());
+        REQUIRE(received == BinaryEncoder::splice(original, module, SectionSet{SectionId::Export}).value());
+    }
+
+    SECTION("Inconsistent function edits are rejected") {
+        module.function_type_indices.push_back(0);
+        auto spliced = BinaryEncoder::splice(original, module, SectionSet{SectionId::Function});
+        REQUIRE(spliced.error().code() == ErrorCode::InvalidModule);
+    }
+}
+
+TEST_CASE("BinaryEncoder encodes compact code tables", "[binary][encoder][compact]") {
+    auto original = make_full_module();
+    BinaryParser::ParseOptions options;
+    options.compact_code = true;
+
+    for (bool zero_copy : {false, true}) {
+        options.zero_copy = zero_copy;
+        auto parsed = BinaryParser::parse(original, options);
+        REQUIRE(parsed.success());
+        REQUIRE(parsed->functions.empty());
+
+        auto encoded = BinaryEncoder::encode(parsed.value());
+        REQUIRE(encoded.success());
+        REQUIRE(encoded.value() == original);
+        REQUIRE(BinaryEncoder::calculate_size(parsed.value()).value() == original.size());
+    }
+}
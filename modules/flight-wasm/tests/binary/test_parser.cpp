@@ -5,6 +5,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <flight/wasm/binary/parser.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
 
 using namespace flight::wasm;
 
@@ -37,3 +40,343 @@ TEST_CASE("WebAssembly Binary Format Constants", "[binary][format][spec]") {
         REQUIRE(true); // Placeholder test
     }
 }
+
+// =============================================================================
+// Test Module Fixture
+// =============================================================================
+
+namespace {
+
+    // (module
+    //   (type (func (param i32) (result i32)))
+    //   (import "env" "log" (func (type 0)))
+    //   (memory 1)
+    //   (func (type 0) (local i64 i64) local.get 0)
+    //   (export "id" (func 1))
+    //   (data (i32.const 16) "hi")
+    //   (@custom "meta" "\01\02"))
+    std::vector<uint8_t> make_test_module() {
+        return {
+            0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00,                // header
+            0x01, 0x06, 0x01, 0x60, 0x01, 0x7F, 0x01, 0x7F,                // type
+            0x02, 0x0B, 0x01, 0x03, 'e', 'n', 'v', 0x03, 'l', 'o', 'g',
+                  0x00, 0x00,                                              // import
+            0x03, 0x02, 0x01, 0x00,                                        // function
+            0x05, 0x03, 0x01, 0x00, 0x01,                                  // memory
+            0x07, 0x06, 0x01, 0x02, 'i', 'd', 0x00, 0x01,                  // export
+            0x0A, 0x08, 0x01, 0x06, 0x01, 0x02, 0x7E, 0x20, 0x00, 0x0B,    // code
+            0x0B, 0x08, 0x01, 0x00, 0x41, 0x10, 0x0B, 0x02, 'h', 'i',      // data
+            0x00, 0x07, 0x04, 'm', 'e', 't', 'a', 0x01, 0x02               // custom
+        };
+    }
+
+} // namespace
+
+// =============================================================================
+// BinaryReader Tests
+// =============================================================================
+
+TEST_CASE("BinaryReader LEB128 decoding", "[binary][reader][leb128]") {
+    SECTION("Unsigned 32-bit values") {
+        std::vector<uint8_t> data = {0x00, 0x7F, 0x80, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F};
+        BinaryReader reader(data);
+        REQUIRE(reader.read_leb128_u32().value() == 0u);
+        REQUIRE(reader.read_leb128_u32().value() == 127u);
+        REQUIRE(reader.read_leb128_u32().value() == 128u);
+        REQUIRE(reader.read_leb128_u32().value() == UINT32_MAX);
+        REQUIRE_FALSE(reader.has_data());
+    }
+
+    SECTION("Signed values sign-extend") {
+        std::vector<uint8_t> data = {0x7F, 0x80, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x78};
+        BinaryReader reader(data);
+        REQUIRE(reader.read_leb128_i32().value() == -1);
+        REQUIRE(reader.read_leb128_i32().value() == -128);
+        REQUIRE(reader.read_leb128_i32().value() == INT32_MIN);
+    }
+
+    SECTION("Out-of-range and truncated encodings are rejected") {
+        std::vector<uint8_t> too_big = {0xFF, 0xFF, 0xFF, 0xFF, 0x1F};
+        BinaryReader big_reader(too_big);
+        REQUIRE(big_reader.read_leb128_u32().error().code() == ErrorCode::InvalidLEB128Encoding);
+
+        std::vector<uint8_t> truncated = {0x80, 0x80};
+        BinaryReader truncated_reader(truncated);
+        REQUIRE(truncated_reader.read_leb128_u32().error().code() == ErrorCode::UnexpectedEndOfFile);
+    }
+
+    SECTION("64-bit values") {
+        std::vector<uint8_t> data = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01,
+                                     0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F};
+        BinaryReader reader(data);
+        REQUIRE(reader.read_leb128_u64().value() == UINT64_MAX);
+        REQUIRE(reader.read_leb128_i64().value() == INT64_MIN);
+    }
+}
+
+TEST_CASE("BinaryReader strings", "[binary][reader]") {
+    std::vector<uint8_t> valid = {0x03, 'a', 'b', 'c'};
+    BinaryReader reader(valid);
+    REQUIRE(reader.read_string().value() == "abc");
+
+    std::vector<uint8_t> invalid = {0x02, 0xC0, 0x80};  // Overlong encoding of NUL
+    BinaryReader invalid_reader(invalid);
+    REQUIRE(invalid_reader.read_string().error().code() == ErrorCode::InvalidUTF8Sequence);
+}
+
+// =============================================================================
+// BinaryParser Tests
+// =============================================================================
+
+TEST_CASE("BinaryParser decodes module sections", "[binary][parser]") {
+    auto bytes = make_test_module();
+    REQUIRE(BinaryParser::is_wasm_binary(bytes));
+
+    auto result = BinaryParser::parse(bytes);
+    REQUIRE(result.success());
+    const Module& module = result.value();
+
+    REQUIRE(module.types.size() == 1);
+    REQUIRE(module.types[0].params.size() == 1);
+    REQUIRE(module.types[0].results[0] == ValueType::I32);
+
+    REQUIRE(module.imports.size() == 1);
+    REQUIRE(module.imports[0].module_name == "env");
+    REQUIRE(module.imports[0].field_name == "log");
+    REQUIRE(module.imports[0].kind == Import::Kind::Function);
+
+    REQUIRE(module.memories.size() == 1);
+    REQUIRE(module.memories[0].limits.min == 1);
+    REQUIRE_FALSE(module.memories[0].limits.has_max);
+
+    REQUIRE(module.exports.size() == 1);
+    REQUIRE(module.exports[0].name == "id");
+    REQUIRE(module.exports[0].index == 1);
+
+    REQUIRE(module.functions.size() == 1);
+    REQUIRE(module.functions[0].locals.size() == 2);
+    REQUIRE(module.functions[0].locals[1] == ValueType::I64);
+    REQUIRE(module.functions[0].body().size() == 3);  // local.get 0; end
+
+    REQUIRE(module.data.size() == 1);
+    REQUIRE(module.data[0].offset_bytes == std::vector<uint8_t>{0x41, 0x10, 0x0B});
+    REQUIRE(module.data[0].bytes().size() == 2);
+
+    REQUIRE(module.custom_sections.size() == 1);
+    REQUIRE(module.custom_sections[0].first == "meta");
+
+    // Owning parse must not alias the input
+    REQUIRE(module.functions[0].body_view.data() == nullptr);
+    REQUIRE(module.backing_store == nullptr);
+}
+
+TEST_CASE("BinaryParser zero-copy mode borrows payloads", "[binary][parser]") {
+    auto bytes = make_test_module();
+    BinaryParser::ParseOptions options;
+    options.zero_copy = true;
+
+    auto result = BinaryParser::parse(bytes, options);
+    REQUIRE(result.success());
+    const Module& module = result.value();
+
+    const uint8_t* begin = bytes.data();
+    const uint8_t* end = bytes.data() + bytes.size();
+    REQUIRE(module.functions[0].body_bytes.empty());
+    REQUIRE(module.functions[0].body().data() >= begin);
+    REQUIRE(module.functions[0].body().data() < end);
+    REQUIRE(module.data[0].data.empty());
+    REQUIRE(module.data[0].bytes()[0] == 'h');
+}
+
+TEST_CASE("BinaryParser rejects malformed modules", "[binary][parser]") {
+    SECTION("Bad magic") {
+        auto bytes = make_test_module();
+        bytes[0] = 0x01;
+        REQUIRE(BinaryParser::parse(bytes).error().code() == ErrorCode::InvalidMagicNumber);
+    }
+
+    SECTION("Truncated section") {
+        auto bytes = make_test_module();
+        bytes.resize(bytes.size() - 1);
+        REQUIRE(BinaryParser::validate(bytes).failed());
+    }
+
+    SECTION("Section out of order") {
+        std::vector<uint8_t> bytes = {0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00,
+                                      0x05, 0x03, 0x01, 0x00, 0x01,
+                                      0x01, 0x01, 0x00};
+        REQUIRE(BinaryParser::parse(bytes).error().code() == ErrorCode::InvalidSectionOrder);
+    }
+
+    SECTION("Function without body") {
+        std::vector<uint8_t> bytes = {0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00,
+                                      0x01, 0x04, 0x01, 0x60, 0x00, 0x00,
+                                      0x03, 0x02, 0x01, 0x00};
+        REQUIRE(BinaryParser::parse(bytes).error().code() == ErrorCode::InvalidModule);
+    }
+}
+
+TEST_CASE("BinaryParser parse_file maps the module", "[binary][parser][file]") {
+    auto bytes = make_test_module();
+    std::string path = "flight_wasm_parse_file_test.wasm";
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        REQUIRE(file != nullptr);
+        REQUIRE(std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size());
+        std::fclose(file);
+    }
+
+    SECTION("Module keeps the mapping alive") {
+        Module copy;
+        {
+            auto result = BinaryParser::parse_file(path);
+            REQUIRE(result.success());
+            REQUIRE(result->backing_store != nullptr);
+            REQUIRE(result->functions[0].body_bytes.empty());
+            copy = result.value();
+        }
+        // The original result is gone; the copy shares the backing store
+        REQUIRE(copy.functions[0].body()[0] == 0x20);
+        REQUIRE(copy.data[0].bytes()[1] == 'i');
+    }
+
+    SECTION("Populate and read-ahead hints") {
+        MappingOptions mapping;
+        mapping.populate = true;
+        mapping.will_need = true;
+        auto result = BinaryParser::parse_file(path, mapping);
+        REQUIRE(result.success());
+        REQUIRE(result->exports[0].name == "id");
+    }
+
+    SECTION("Missing file") {
+        auto result = BinaryParser::parse_file(path + ".missing");
+        REQUIRE(result.error().code() == ErrorCode::FileOpenFailed);
+    }
+
+    std::remove(path.c_str());
+}
+
+// =============================================================================
+// StreamingBinaryParser Tests
+// =============================================================================
+
+TEST_CASE("StreamingBinaryParser section info", "[binary][parser][streaming]") {
+    auto bytes = make_test_module();
+
+    auto sections = StreamingBinaryParser::get_section_info(bytes);
+    REQUIRE(sections.success());
+    REQUIRE(sections.value().size() == 8);
+
+    SECTION("Encoded sections tile the module after the header") {
+        size_t expected_offset = binary_constants::HEADER_SIZE;
+        for (const auto& info : sections.value()) {
+            REQUIRE(info.header_offset == expected_offset);
+            REQUIRE(bytes[info.header_offset] == info.id);
+            expected_offset += info.encoded_size();
+        }
+        REQUIRE(expected_offset == bytes.size());
+    }
+
+    SECTION("Custom sections report their name") {
+        const auto& custom = sections.value().back();
+        REQUIRE(custom.id == static_cast<uint8_t>(SectionId::Custom));
+        REQUIRE(custom.name == "meta");
+        REQUIRE(custom.size == 7);
+    }
+
+    SECTION("Individual sections parse on demand") {
+        Module module;
+        REQUIRE(StreamingBinaryParser::parse_section_at(bytes, 4, module).success());
+        REQUIRE(module.exports.size() == 1);
+        REQUIRE(module.exports[0].name == "id");
+        REQUIRE(module.types.empty());
+
+        auto out_of_range = StreamingBinaryParser::parse_section_at(bytes, 8, module);
+        REQUIRE(out_of_range.error().code() == ErrorCode::OutOfBounds);
+    }
+
+    SECTION("Framing errors are detected without parsing contents") {
+        REQUIRE(StreamingBinaryParser::parse_headers(bytes).success());
+
+        auto truncated = bytes;
+        truncated.pop_back();
+        REQUIRE(StreamingBinaryParser::parse_headers(truncated).error().code() == ErrorCode::SectionTooLarge);
+    }
+}
+
+TEST_CASE("BinaryParser interns names", "[binary][parser][names]") {
+    auto bytes = make_test_module();
+
+    SECTION("Owning parse copies names into the module pool") {
+        auto result = BinaryParser::parse(bytes);
+        REQUIRE(result.success());
+        Module module = std::move(result).value();
+        bytes.assign(bytes.size(), 0);  // Names must not alias the input
+
+        REQUIRE(module.names != nullptr);
+        REQUIRE(module.imports[0].module_name == "env");
+        REQUIRE(module.custom_sections[0].first == "meta");
+        const Export* exported = module.find_export("id");
+        REQUIRE(exported != nullptr);
+        REQUIRE(exported->index == 1);
+        REQUIRE(module.find_export("missing") == nullptr);
+    }
+
+    SECTION("Zero-copy parse borrows names from the input") {
+        BinaryParser::ParseOptions options;
+        options.zero_copy = true;
+        auto result = BinaryParser::parse(bytes, options);
+        REQUIRE(result.success());
+        const auto* base = reinterpret_cast<const char*>(bytes.data());
+        REQUIRE(result->exports[0].name.data() >= base);
+        REQUIRE(result->exports[0].name.data() < base + bytes.size());
+        REQUIRE(result->names == nullptr);
+    }
+}
+
+TEST_CASE("BinaryParser compact code table", "[binary][parser][compact]") {
+    auto bytes = make_test_module();
+    Module reference = BinaryParser::parse(bytes).value();
+
+    for (bool zero_copy : {false, true}) {
+        BinaryParser::ParseOptions options;
+        options.compact_code = true;
+        options.zero_copy = zero_copy;
+        auto result = BinaryParser::parse(bytes, options);
+        REQUIRE(result.success());
+        const Module& module = result.value();
+
+        REQUIRE(module.functions.empty());
+        REQUIRE(module.code_table.size() == 1);
+        REQUIRE(module.defined_function_count() == 1);
+
+        const CodeTable& table = module.code_table;
+        REQUIRE(table.locals(0).size() == 1);
+        REQUIRE(table.locals(0)[0].count == 2);
+        REQUIRE(table.locals(0)[0].type == ValueType::I64);
+        REQUIRE(table.local_count(0) == 2);
+        REQUIRE(table.expand_locals(0) == reference.functions[0].locals);
+
+        auto body = table.body(0);
+        REQUIRE(std::vector<uint8_t>(body.begin(), body.end()) == reference.functions[0].body_bytes);
+        const bool aliases_input = body.data() >= bytes.data() && body.data() < bytes.data() + bytes.size();
+        REQUIRE(aliases_input == zero_copy);
+    }
+}
+
+TEST_CASE("CodeTable programmatic construction", "[binary][parser][compact]") {
+    CodeTable table;
+    const LocalGroup locals[] = {{3, ValueType::I32}, {1, ValueType::F32}};
+    const uint8_t first[] = {0x20, 0x00, 0x0B};
+    const uint8_t second[] = {0x0B};
+    table.append(span<const LocalGroup>(locals, 2), span<const uint8_t>(first, 3));
+    table.append(span<const LocalGroup>(), span<const uint8_t>(second, 1));
+
+    REQUIRE(table.size() == 2);
+    REQUIRE(table.local_count(0) == 4);
+    REQUIRE(table.locals(1).empty());
+    REQUIRE(table.body(0).size() == 3);
+    REQUIRE(table.body(1)[0] == 0x0B);
+    REQUIRE(table.expand_locals(0).back() == ValueType::F32);
+}
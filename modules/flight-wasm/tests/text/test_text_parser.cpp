@@ -0,0 +1,478 @@
+// =============================================================================
+// Flight WASM Tests - Text Format
+// WebAssembly Text Format (WAT) Parsing and Printing Tests
+// =============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/wasm/text/parser.hpp>
+#include <flight/wasm/binary/encoder.hpp>
+#include <flight/wasm/binary/parser.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace flight::wasm;
+
+namespace {
+
+    Module parse_text(std::string_view text) {
+        auto parsed = TextParser::parse(text);
+        INFO(parsed.error().message());
+        REQUIRE(parsed.success());
+        return std::move(parsed).value();
+    }
+
+    std::vector<uint8_t> function_body(std::string_view text) {
+        Module module = parse_text(text);
+        REQUIRE(module.functions.size() == 1);
+        auto body = module.functions[0].body();
+        return std::vector<uint8_t>(body.begin(), body.end());
+    }
+
+    // Canonical module covering every standard section (see test_encoder.cpp)
+    std::vector<uint8_t> make_full_module() {
+        return {
+            0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00,                // header
+            0x01, 0x08, 0x02, 0x60, 0x00, 0x00, 0x60, 0x01, 0x7F, 0x00,    // type
+            0x02, 0x0D, 0x01, 0x03, 'e', 'n', 'v', 0x05, 'p', 'r', 'i', 'n', 't',
+                  0x00, 0x01,                                              // import
+            0x03, 0x03, 0x02, 0x00, 0x00,                                  // function
+            0x04, 0x04, 0x01, 0x70, 0x00, 0x02,                            // table
+            0x05, 0x04, 0x01, 0x01, 0x01, 0x02,                            // memory
+            0x06, 0x06, 0x01, 0x7F, 0x01, 0x41, 0x2A, 0x0B,                // global
+            0x07, 0x08, 0x01, 0x04, 'm', 'a', 'i', 'n', 0x00, 0x01,        // export
+            0x08, 0x01, 0x01,                                              // start
+            0x09, 0x0B, 0x02, 0x00, 0x41, 0x00, 0x0B, 0x01, 0x01,
+                  0x01, 0x00, 0x01, 0x02,                                  // element
+            0x0A, 0x0B, 0x02, 0x02, 0x00, 0x0B, 0x06, 0x01, 0x03, 0x7F,
+                  0x10, 0x02, 0x0B,                                        // code
+            0x0B, 0x0D, 0x02, 0x00, 0x41, 0x08, 0x0B, 0x03, 'a', 'b', 'c',
+                  0x01, 0x02, 'x', 'y'                                     // data
+        };
+    }
+
+} // namespace
+
+// =============================================================================
+// Lexer and Literal Tests
+// =============================================================================
+
+TEST_CASE("Lexer produces views into the source", "[text][lexer]") {
+    const std::string_view source = "(module ;; line comment\n (; nested (; block ;) ;) $id \"str\\\"\" -42 f32)";
+    Lexer lexer(source);
+
+    std::vector<Token::Kind> kinds;
+    std::vector<std::string_view> texts;
+    for (;;) {
+        auto token = lexer.next();
+        REQUIRE(token.success());
+        if (token.value().kind == Token::Kind::End) {
+            break;
+        }
+        kinds.push_back(token.value().kind);
+        texts.push_back(token.value().text);
+        REQUIRE(token.value().text.data() >= source.data());
+        REQUIRE(token.value().text.data() < source.data() + source.size());
+    }
+
+    REQUIRE(kinds == std::vector<Token::Kind>{
+        Token::Kind::LeftParen, Token::Kind::Keyword, Token::Kind::Identifier, Token::Kind::String,
+        Token::Kind::Number, Token::Kind::Keyword, Token::Kind::RightParen});
+    REQUIRE(texts[2] == "$id");
+    REQUIRE(texts[3] == "\"str\\\"\"");
+    REQUIRE(texts[4] == "-42");
+}
+
+TEST_CASE("Lexer rejects malformed input", "[text][lexer]") {
+    auto first_error = [](std::string_view source) {
+        Lexer lexer(source);
+        for (;;) {
+            auto token = lexer.next();
+            if (!token) {
+                return token.error().code();
+            }
+            if (token.value().kind == Token::Kind::End) {
+                return ErrorCode::Success;
+            }
+        }
+    };
+
+    REQUIRE(first_error("\"open") == ErrorCode::UnterminatedString);
+    REQUIRE(first_error("(; never closed") == ErrorCode::UnterminatedComment);
+    REQUIRE(first_error("i32\"x\"") == ErrorCode::UnexpectedToken);
+    REQUIRE(first_error("$") == ErrorCode::UnexpectedToken);
+    REQUIRE(first_error("(func)") == ErrorCode::Success);
+}
+
+TEST_CASE("Numeric literals decode per the text grammar", "[text][lexer][literals]") {
+    SECTION("Integers") {
+        REQUIRE(text::parse_i32("0xFFFF_FFFF").value() == -1);
+        REQUIRE(text::parse_i32("-2147483648").value() == INT32_MIN);
+        REQUIRE(text::parse_i32("+1_000").value() == 1000);
+        REQUIRE(text::parse_i64("-0x8000000000000000").value() == INT64_MIN);
+        REQUIRE(text::parse_i32("4294967296").error().code() == ErrorCode::InvalidNumber);
+        REQUIRE(text::parse_i32("-2147483649").error().code() == ErrorCode::InvalidNumber);
+        REQUIRE(text::parse_i32("1__0").error().code() == ErrorCode::InvalidNumber);
+        REQUIRE(text::parse_u32("12a").error().code() == ErrorCode::InvalidNumber);
+    }
+
+    SECTION("Floats") {
+        REQUIRE(text::parse_f64("0x1p-2").value() == 0.25);
+        REQUIRE(text::parse_f64("1_000.5e1").value() == 10005.0);
+        REQUIRE(text::parse_f32("-0").value() == 0.0f);
+        REQUIRE(std::signbit(text::parse_f32("-0").value()));
+        REQUIRE(std::isinf(text::parse_f64("-inf").value()));
+
+        uint32_t bits;
+        float nan = text::parse_f32("nan:0x200000").value();
+        std::memcpy(&bits, &nan, sizeof(bits));
+        REQUIRE(bits == 0x7FA00000u);
+
+        REQUIRE(text::parse_f32("1e39").error().code() == ErrorCode::InvalidNumber);
+        REQUIRE(text::parse_f64(".5").error().code() == ErrorCode::InvalidNumber);
+        REQUIRE(text::parse_f64("nan:0x0").error().code() == ErrorCode::InvalidNumber);
+    }
+
+    SECTION("Strings") {
+        std::string decoded;
+        REQUIRE(text::decode_string("\"a\\n\\t\\\\\\41\\u{1F600}\"", decoded).success());
+        REQUIRE(decoded == "a\n\t\\A\xF0\x9F\x98\x80");
+
+        std::string invalid;
+        REQUIRE_FALSE(text::decode_string("\"\\u{D800}\"", invalid).success());
+        REQUIRE_FALSE(text::decode_string("\"\\x\"", invalid).success());
+    }
+}
+
+// =============================================================================
+// S-expression Tests
+// =============================================================================
+
+TEST_CASE("S-expression tree is built in an arena", "[text][sexpr]") {
+    SExprArena arena;
+    auto root = read_sexprs("(a (b c) d) (e)", arena);
+    REQUIRE(root.success());
+    REQUIRE(arena.size() == 8);
+
+    const SExpr* first = root.value();
+    REQUIRE(first->is_form("a"));
+    REQUIRE(first->next->is_form("e"));
+    REQUIRE(first->next->next == nullptr);
+    REQUIRE(first->first->next->is_form("b"));
+    REQUIRE(first->first->next->next->is_keyword("d"));
+
+    SExprArena unbalanced;
+    REQUIRE(read_sexprs("(a (b)", unbalanced).error().code() == ErrorCode::UnexpectedToken);
+    REQUIRE(read_sexprs("(a))", unbalanced).error().code() == ErrorCode::UnexpectedToken);
+
+    SExprArena empty;
+    auto nothing = read_sexprs("  ;; only a comment\n", empty);
+    REQUIRE(nothing.success());
+    REQUIRE(nothing.value() == nullptr);
+}
+
+TEST_CASE("S-expression nesting does not use the call stack", "[text][sexpr]") {
+    const size_t depth = 100000;
+    std::string source(depth, '(');
+    source.append(depth, ')');
+    REQUIRE(TextValidator::validate_syntax(source).success());
+}
+
+// =============================================================================
+// TextParser Tests
+// =============================================================================
+
+TEST_CASE("TextParser lowers functions with named indices", "[text][parser]") {
+    Module module = parse_text(R"(
+        (module
+          (type $binary (func (param i32 i32) (result i32)))
+          (func $add (export "add") (type $binary) (param $a i32) (param $b i32) (result i32)
+            (local $tmp i32)
+            local.get $a
+            local.get $b
+            i32.add
+            local.tee $tmp)
+          (func $twice (param i32) (result i32)
+            (call $add (local.get 0) (local.get 0))))
+    )");
+
+    REQUIRE(module.types.size() == 2);
+    REQUIRE(module.function_type_indices == std::vector<uint32_t>{0, 1});
+    REQUIRE(module.functions.size() == 2);
+    REQUIRE(module.functions[0].locals == std::vector<ValueType>{ValueType::I32});
+
+    auto body = module.functions[0].body();
+    REQUIRE(std::vector<uint8_t>(body.begin(), body.end()) ==
+            std::vector<uint8_t>{0x20, 0x00, 0x20, 0x01, 0x6A, 0x22, 0x02, 0x0B});
+    auto twice = module.functions[1].body();
+    REQUIRE(std::vector<uint8_t>(twice.begin(), twice.end()) ==
+            std::vector<uint8_t>{0x20, 0x00, 0x20, 0x00, 0x10, 0x00, 0x0B});
+
+    const Export* add = module.find_export("add");
+    REQUIRE(add != nullptr);
+    REQUIRE(add->kind == Export::Kind::Function);
+    REQUIRE(add->index == 0);
+}
+
+TEST_CASE("Folded and flat instructions lower identically", "[text][parser]") {
+    const auto flat = function_body(R"(
+        (func (param i32) (result i32)
+          block $outer (result i32)
+            local.get 0
+            if (result i32)
+              i32.const 1
+              br $outer
+            else
+              i32.const 2
+            end
+          end))");
+    const auto folded = function_body(R"(
+        (func (param i32) (result i32)
+          (block $outer (result i32)
+            (if (result i32) (local.get 0)
+              (then (br $outer (i32.const 1)))
+              (else (i32.const 2))))))");
+
+    REQUIRE(flat == folded);
+    REQUIRE(flat == std::vector<uint8_t>{
+        0x02, 0x7F, 0x20, 0x00, 0x04, 0x7F, 0x41, 0x01, 0x0C, 0x01, 0x05, 0x41, 0x02, 0x0B, 0x0B, 0x0B});
+}
+
+TEST_CASE("Folded instruction nesting does not use the call stack", "[text][parser]") {
+    const size_t depth = 100000;
+
+    SECTION("Operands") {
+        std::string source = "(func (result i32) ";
+        for (size_t i = 0; i < depth; ++i) {
+            source += "(i32.eqz ";
+        }
+        source += "(i32.const 0)";
+        source.append(depth, ')');
+        source += ")";
+
+        const auto body = function_body(source);
+        REQUIRE(body.size() == depth + 3);
+        REQUIRE(body[0] == 0x41);
+        REQUIRE(body[1] == 0x00);
+        REQUIRE(body[depth + 1] == 0x45);
+        REQUIRE(body.back() == 0x0B);
+    }
+
+    SECTION("Blocks and if clauses") {
+        std::string source = "(func ";
+        for (size_t i = 0; i < depth; ++i) {
+            source += i % 2 == 0 ? "(block " : "(if (i32.const 1) (then ";
+        }
+        source += "nop";
+        for (size_t i = depth; i-- > 0;) {
+            source += i % 2 == 0 ? ")" : "))";
+        }
+        source += ")";
+
+        const auto body = function_body(source);
+        REQUIRE(body.size() == 2 * (depth / 2) + 4 * (depth / 2) + depth + 2);
+        REQUIRE(body[depth / 2 * 6] == 0x01);  // nop
+    }
+}
+
+TEST_CASE("TextParser encodes instruction immediates", "[text][parser]") {
+    SECTION("Memory arguments") {
+        auto body = function_body(R"(
+            (memory 1)
+            (func (param i32)
+              (i64.store offset=8 align=4 (local.get 0) (i64.const -1))
+              (drop (i32.load8_u (local.get 0)))))");
+        REQUIRE(body == std::vector<uint8_t>{
+            0x20, 0x00, 0x42, 0x7F, 0x37, 0x02, 0x08, 0x20, 0x00, 0x2D, 0x00, 0x00, 0x1A, 0x0B});
+    }
+
+    SECTION("Floats, br_table and typed select") {
+        auto body = function_body(R"(
+            (func (param i32)
+              f32.const 1.5
+              drop
+              f64.const -inf
+              drop
+              block
+                local.get 0
+                br_table 0 0 1
+              end
+              (drop (select (result i32) (i32.const 1) (i32.const 2) (local.get 0)))))");
+        REQUIRE(body == std::vector<uint8_t>{
+            0x43, 0x00, 0x00, 0xC0, 0x3F, 0x1A,
+            0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xFF, 0x1A,
+            0x02, 0x40, 0x20, 0x00, 0x0E, 0x02, 0x00, 0x00, 0x01, 0x0B,
+            0x41, 0x01, 0x41, 0x02, 0x20, 0x00, 0x1C, 0x01, 0x7F, 0x1A, 0x0B});
+    }
+
+    SECTION("Bulk memory records the data count") {
+        Module module = parse_text(R"(
+            (memory 1)
+            (data $d "hi")
+            (func
+              (memory.init $d (i32.const 0) (i32.const 0) (i32.const 2))
+              data.drop $d))");
+        REQUIRE(module.has_data_count);
+        REQUIRE(module.data_count == 1);
+        auto body = module.functions[0].body();
+        REQUIRE(std::vector<uint8_t>(body.begin(), body.end()) == std::vector<uint8_t>{
+            0x41, 0x00, 0x41, 0x00, 0x41, 0x02, 0xFC, 0x08, 0x00, 0x00, 0xFC, 0x09, 0x00, 0x0B});
+    }
+}
+
+TEST_CASE("TextParser expands module field abbreviations", "[text][parser]") {
+    Module module = parse_text(R"(
+        (module
+          (func $log (import "env" "log") (param i32))
+          (global $g (import "env" "g") i32)
+          (memory (export "mem") (data "hello" "!"))
+          (table $t funcref (elem $main))
+          (global $counter (mut i32) (i32.const 0))
+          (func $main (export "main") (export "_start")
+            (call $log (global.get $g))
+            (global.set $counter (i32.const 1)))
+          (start $main))
+    )");
+
+    REQUIRE(module.imports.size() == 2);
+    REQUIRE(module.imports[0].module_name == "env");
+    REQUIRE(module.imports[0].kind == Import::Kind::Function);
+    REQUIRE(module.imports[1].kind == Import::Kind::Global);
+
+    REQUIRE(module.memories.size() == 1);
+    REQUIRE(module.memories[0].limits.min == 1);
+    REQUIRE(module.data.size() == 1);
+    REQUIRE(std::string(module.data[0].data.begin(), module.data[0].data.end()) == "hello!");
+
+    REQUIRE(module.tables.size() == 1);
+    REQUIRE(module.tables[0].limits.min == 1);
+    REQUIRE(module.elements.size() == 1);
+    REQUIRE(module.elements[0].function_indices == std::vector<uint32_t>{1});
+
+    REQUIRE(module.globals.size() == 1);
+    REQUIRE(module.globals[0].initializer_bytes == std::vector<uint8_t>{0x41, 0x00, 0x0B});
+    REQUIRE(module.has_start_function);
+    REQUIRE(module.start_function_index == 1);
+    REQUIRE(module.find_export("_start")->index == 1);
+    REQUIRE(module.find_export("mem")->kind == Export::Kind::Memory);
+
+    auto encoded = BinaryEncoder::encode(module);
+    REQUIRE(encoded.success());
+    REQUIRE(BinaryParser::parse(encoded.value()).success());
+}
+
+TEST_CASE("TextParser reports errors", "[text][parser][error]") {
+    auto code_of = [](std::string_view text) { return TextParser::parse(text).error().code(); };
+
+    REQUIRE(code_of("(module (func i32.frobnicate))") == ErrorCode::UnknownOpcode);
+    REQUIRE(code_of("(module (func call $missing))") == ErrorCode::UnknownIdentifier);
+    REQUIRE(code_of("(module (func $f) (func $f))") == ErrorCode::DuplicateIdentifier);
+    REQUIRE(code_of("(module (func (param $x i32) (local $x i32)))") == ErrorCode::DuplicateIdentifier);
+    REQUIRE(code_of("(module (func local.get 0))") == ErrorCode::InvalidLocalIndex);
+    REQUIRE(code_of("(module (func (i32.const 99999999999)))") == ErrorCode::InvalidNumber);
+    REQUIRE(code_of("(module (func block))") == ErrorCode::UnexpectedToken);
+    REQUIRE(code_of("(module (func end))") == ErrorCode::UnexpectedToken);
+    REQUIRE(code_of("(module (func) (import \"a\" \"b\" (func)))") == ErrorCode::UnexpectedToken);
+    REQUIRE(code_of("(module (type (func)) (func (type 0) (param i32)))") == ErrorCode::TypeMismatch);
+    REQUIRE(code_of("(module (export \"\\ff\" (func 0)) (func))") == ErrorCode::InvalidUTF8Sequence);
+    REQUIRE(code_of("(module (bogus))") == ErrorCode::UnexpectedToken);
+    REQUIRE(code_of("(module \"unterminated)") == ErrorCode::UnterminatedString);
+}
+
+TEST_CASE("TextParser detection and validation helpers", "[text][parser]") {
+    REQUIRE(TextParser::is_wat_text("  ;; comment\n(module)"));
+    REQUIRE(TextParser::is_wat_text("(func)"));
+    REQUIRE_FALSE(TextParser::is_wat_text("\0asm"));
+    REQUIRE_FALSE(TextParser::is_wat_text("(hello)"));
+
+    REQUIRE(TextParser::validate("(module (func nop))").success());
+    REQUIRE_FALSE(TextParser::validate("(module (func nope))").success());
+    REQUIRE(TextValidator::validate_syntax("(module (func nope))").success());
+    REQUIRE_FALSE(TextValidator::validate_semantics("(module (func nope))").success());
+}
+
+// =============================================================================
+// TextEncoder Tests
+// =============================================================================
+
+TEST_CASE("Binary to text to binary round trip", "[text][encoder]") {
+    const auto original = make_full_module();
+    auto binary = BinaryParser::parse(original);
+    REQUIRE(binary.success());
+
+    auto text = TextEncoder::encode(binary.value());
+    REQUIRE(text.success());
+    REQUIRE(TextParser::is_wat_text(text.value()));
+
+    Module reparsed = parse_text(text.value());
+    auto encoded = BinaryEncoder::encode(reparsed);
+    REQUIRE(encoded.success());
+    REQUIRE(encoded.value() == original);
+
+    SECTION("Compact output with comments parses identically") {
+        TextEncoder::EncodingOptions options;
+        options.pretty_print = false;
+        options.include_comments = true;
+        auto compact = TextEncoder::encode_with_options(binary.value(), options);
+        REQUIRE(compact.success());
+        REQUIRE(compact.value().find('\n') == std::string::npos);
+        REQUIRE(compact.value().find("(;0;)") != std::string::npos);
+        REQUIRE(BinaryEncoder::encode(parse_text(compact.value())).value() == original);
+    }
+}
+
+TEST_CASE("TextEncoder preserves float bit patterns", "[text][encoder]") {
+    Module module = parse_text(R"(
+        (func
+          (drop (f32.const nan:0x1))
+          (drop (f32.const -nan))
+          (drop (f64.const 0x1.fffffffffffffp+1023))
+          (drop (f64.const 5e-324))
+          (drop (f32.const 0.1))))");
+    auto text = TextEncoder::encode(module);
+    REQUIRE(text.success());
+    Module reparsed = parse_text(text.value());
+
+    auto before = module.functions[0].body();
+    auto after = reparsed.functions[0].body();
+    REQUIRE(std::vector<uint8_t>(before.begin(), before.end()) == std::vector<uint8_t>(after.begin(), after.end()));
+}
+
+TEST_CASE("TextEncoder streams to a sink", "[text][encoder]") {
+    Module module;
+    module.types.push_back(FunctionType{});
+    for (int i = 0; i < 2000; ++i) {
+        module.function_type_indices.push_back(0);
+        module.functions.push_back(Function(0, {}, {0x01, 0x01, 0x01, 0x0B}));
+    }
+    auto whole = TextEncoder::encode(module);
+    REQUIRE(whole.success());
+    REQUIRE(whole.value().size() > BinaryWriter::DEFAULT_STAGING_SIZE);
+
+    std::string streamed;
+    size_t chunks = 0;
+    auto written = TextEncoder::encode_to(module, [&](span<const uint8_t> chunk) {
+        REQUIRE(chunk.size() <= BinaryWriter::DEFAULT_STAGING_SIZE);
+        streamed.append(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+        ++chunks;
+        return true;
+    });
+    REQUIRE(written.success());
+    REQUIRE(written.value() == whole.value().size());
+    REQUIRE(streamed == whole.value());
+    REQUIRE(chunks > 1);
+
+    auto rejected = TextEncoder::encode_to(module, [](span<const uint8_t>) { return false; });
+    REQUIRE(rejected.error().code() == ErrorCode::FileWriteFailed);
+
+    SECTION("File output parses back") {
+        const std::string path = "flight_wasm_text_encoder_test.wat";
+        REQUIRE(TextEncoder::encode_to_file(module, path).success());
+        auto reparsed = TextParser::parse_file(path);
+        std::remove(path.c_str());
+        REQUIRE(reparsed.success());
+        REQUIRE(reparsed.value().functions.size() == 2000);
+    }
+}
@@ -0,0 +1,83 @@
+// =============================================================================
+// Flight WASM Tests - Name Pool
+// Interned Import/Export Name Storage Testing
+// =============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <flight/wasm/utilities/name_pool.hpp>
+#include <flight/wasm/types/modules.hpp>
+#include <string>
+#include <vector>
+
+using namespace flight::wasm;
+
+// =============================================================================
+// NamePool Tests
+// =============================================================================
+
+TEST_CASE("NamePool interning", "[utilities][name_pool]") {
+    NamePool pool(64);
+
+    SECTION("Equal names share storage") {
+        std::string first = "memory";
+        std::string second = "memory";
+        auto a = pool.intern(first);
+        auto b = pool.intern(second);
+        REQUIRE(a == "memory");
+        REQUIRE(a.data() == b.data());
+        REQUIRE(a.data() != first.data());
+        REQUIRE(pool.size() == 1);
+        REQUIRE(pool.bytes_used() == 6);
+    }
+
+    SECTION("Views survive block growth") {
+        std::vector<std::string_view> views;
+        for (int i = 0; i < 200; ++i) {
+            views.push_back(pool.intern("export_" + std::to_string(i)));
+        }
+        views.push_back(pool.intern(std::string(500, 'x')));
+        for (int i = 0; i < 200; ++i) {
+            REQUIRE(views[i] == "export_" + std::to_string(i));
+        }
+        REQUIRE(views.back().size() == 500);
+        REQUIRE(pool.size() == 201);
+        REQUIRE(pool.contains("export_199"));
+        REQUIRE_FALSE(pool.contains("export_200"));
+    }
+
+    SECTION("Empty names are valid") {
+        REQUIRE(pool.intern("").empty());
+        REQUIRE(pool.contains(""));
+        REQUIRE(pool.bytes_used() == 0);
+    }
+}
+
+TEST_CASE("Module export lookup", "[utilities][name_pool][module]") {
+    Module module;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        module.exports.emplace_back(module.intern("fn_" + std::to_string(i)), Export::Kind::Function, i);
+    }
+
+    SECTION("Indexed lookup") {
+        module.index_exports();
+        const Export* found = module.find_export("fn_731");
+        REQUIRE(found != nullptr);
+        REQUIRE(found->index == 731);
+        REQUIRE(module.find_export("fn_1000") == nullptr);
+    }
+
+    SECTION("Unindexed and stale lookups fall back to a scan") {
+        REQUIRE(module.find_export("fn_5")->index == 5);
+
+        module.index_exports();
+        module.exports.emplace_back("late", Export::Kind::Memory, 0);
+        REQUIRE(module.find_export("late") != nullptr);
+    }
+
+    SECTION("Copies share the name pool") {
+        Module copy = module;
+        copy.index_exports();
+        REQUIRE(copy.names == module.names);
+        REQUIRE(copy.find_export("fn_0")->name.data() == module.exports[0].name.data());
+    }
+}
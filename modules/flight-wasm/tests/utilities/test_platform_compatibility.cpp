@@ -9,6 +9,8 @@
 #include <flight/wasm/utilities/memory.hpp>
 #include <flight/wasm/utilities/simd.hpp>
 #include <array>
+#include <atomic>
+#include <thread>
 #include <vector>
 #include <limits>
 
@@ -197,6 +199,66 @@ TEST_CASE("Memory Management", "[platform][memory][compatibility]") {
         REQUIRE(pool.available() == 8);
     }
     
+    SECTION("Object pool constructs in place and rejects foreign pointers") {
+        struct Tracked {
+            int value;
+            int* destroyed;
+            Tracked(int v, int* d) : value(v), destroyed(d) {}
+            ~Tracked() { ++*destroyed; }
+        };
+        memory::ObjectPool<Tracked, 4> pool;
+        int destroyed = 0;
+        
+        std::vector<Tracked*> acquired;
+        for (int i = 0; i < 4; ++i) {
+            Tracked* obj = pool.acquire(i, &destroyed);
+            REQUIRE(obj != nullptr);
+            REQUIRE(obj->value == i);
+            acquired.push_back(obj);
+        }
+        REQUIRE(pool.empty());
+        REQUIRE(pool.acquire(99, &destroyed) == nullptr);
+        
+        Tracked outside(7, &destroyed);
+        pool.release(&outside);
+        REQUIRE(destroyed == 0);
+        REQUIRE(pool.available() == 0);
+        
+        // LIFO reuse: the last released slot is handed out next
+        pool.release(acquired[2]);
+        REQUIRE(destroyed == 1);
+        REQUIRE(pool.acquire(5, &destroyed) == acquired[2]);
+        REQUIRE(acquired[2]->value == 5);
+        
+        for (Tracked* obj : acquired) {
+            pool.release(obj);
+        }
+        REQUIRE(destroyed == 5);
+        REQUIRE(pool.available() == 4);
+    }
+    
+    SECTION("Object pool is safe under concurrent acquire and release") {
+        memory::ObjectPool<size_t, 16> pool;
+        std::atomic<size_t> corrupted{0};
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < 4; ++t) {
+            threads.emplace_back([&pool, &corrupted, t] {
+                for (size_t i = 0; i < 20000; ++i) {
+                    const size_t stamp = t * 1000000 + i;
+                    size_t* obj = pool.acquire(stamp);
+                    if (!obj) continue;
+                    if (*obj != stamp) corrupted.fetch_add(1);
+                    pool.release(obj);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        REQUIRE(corrupted.load() == 0);
+        REQUIRE(pool.available() == 16);
+    }
+    
     SECTION("Memory region RAII works correctly") {
         {
             memory::MemoryRegion region(4096);
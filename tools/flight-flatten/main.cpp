@@ -0,0 +1,179 @@
+// flight-flatten - fuses a graph of components into one core module
+//
+//   flight-flatten [--platform dreamcast|psp|vita|desktop] [--guard-bytes N]
+//                  [--align N] [--reserve-pages N] -o out.wasm
+//                  [name=]component.wasm...
+//
+// Components are named after their file unless a name is given; names
+// appear in adapter imports and segment exports of the output. The
+// platform profile sets the capacity and default segment layout; the
+// other options override it.
+
+#include <flight/component/flattener.hpp>
+#include <flight/wasm/binary/encoder.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace flight;
+using namespace flight::component;
+
+namespace
+{
+    void usage()
+    {
+        std::fprintf(stderr, "usage: flight-flatten [--platform dreamcast|psp|vita|desktop] [--guard-bytes N] "
+                             "[--align N] [--reserve-pages N] -o out.wasm [name=]component.wasm...\n");
+    }
+
+    bool read_file(const std::string &path, std::vector<uint8_t> &bytes)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    std::string stem(const std::string &path)
+    {
+        const size_t slash = path.find_last_of("/\\");
+        std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+        const size_t dot = name.find('.');
+        return dot == std::string::npos ? name : name.substr(0, dot);
+    }
+
+    bool number(const char *text, uint32_t limit, uint32_t &value)
+    {
+        char *end = nullptr;
+        const unsigned long long parsed = std::strtoull(text, &end, 10);
+        if (end == text || *end != '\0' || parsed > limit)
+        {
+            return false;
+        }
+        value = static_cast<uint32_t>(parsed);
+        return true;
+    }
+
+    int error(const char *what, const wasm::Error &error)
+    {
+        std::fprintf(stderr, "flight-flatten: %s: %.*s\n", what, static_cast<int>(error.message().size()),
+                     error.message().data());
+        return 1;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    FlattenOptions options;
+    PlatformProfile overrides;
+    bool guard = false, align = false, reserve = false;
+    std::string output;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "-o" && has_value)
+        {
+            output = argv[++i];
+        }
+        else if (arg == "--platform" && has_value && PlatformProfile::named(argv[i + 1], options.platform))
+        {
+            ++i;
+        }
+        else if (arg == "--guard-bytes" && has_value && number(argv[i + 1], 0xFFFFFFFF, overrides.guard_bytes))
+        {
+            guard = true;
+            ++i;
+        }
+        else if (arg == "--align" && has_value && number(argv[i + 1], 65536, overrides.alignment))
+        {
+            align = true;
+            ++i;
+        }
+        else if (arg == "--reserve-pages" && has_value && number(argv[i + 1], 65536, overrides.default_reserve_pages))
+        {
+            reserve = true;
+            ++i;
+        }
+        else if (!arg.empty() && arg[0] != '-')
+        {
+            inputs.push_back(arg);
+        }
+        else
+        {
+            usage();
+            return 2;
+        }
+    }
+    if (output.empty() || inputs.empty())
+    {
+        usage();
+        return 2;
+    }
+    if (guard)
+    {
+        options.platform.guard_bytes = overrides.guard_bytes;
+    }
+    if (align)
+    {
+        options.platform.alignment = overrides.alignment;
+    }
+    if (reserve)
+    {
+        options.platform.default_reserve_pages = overrides.default_reserve_pages;
+    }
+
+    Flattener flattener(options);
+    for (const std::string &input : inputs)
+    {
+        const size_t equals = input.find('=');
+        const std::string path = equals == std::string::npos ? input : input.substr(equals + 1);
+        const std::string name = equals == std::string::npos ? stem(path) : input.substr(0, equals);
+
+        std::vector<uint8_t> bytes;
+        if (!read_file(path, bytes))
+        {
+            std::fprintf(stderr, "flight-flatten: cannot read %s\n", path.c_str());
+            return 1;
+        }
+        auto component = ComponentBinary::parse(std::move(bytes));
+        if (!component)
+        {
+            return error(path.c_str(), component.error());
+        }
+        flattener.add(name, std::move(component).value());
+    }
+
+    auto flattened = flattener.flatten();
+    if (!flattened)
+    {
+        return error("flatten", flattened.error());
+    }
+    const FlattenResult &result = flattened.value();
+    auto written = wasm::BinaryEncoder::encode_to_file(result.module, output);
+    if (!written)
+    {
+        return error(output.c_str(), written.error());
+    }
+
+    const MemoryLayout &layout = result.layout;
+    for (const MemorySegment &segment : layout.segments())
+    {
+        std::printf("segment %-24s base 0x%08x, %u pages initial, %u reserved\n", segment.component.c_str(),
+                    segment.base, segment.initial_pages, segment.reserved_pages);
+    }
+    std::printf("memory: %u pages initial, %u maximum, %llu bytes overhead (%s)\n", layout.initial_pages(),
+                layout.maximum_pages(), static_cast<unsigned long long>(layout.overhead_bytes()),
+                layout.profile().name);
+    std::printf("imports: %u direct, %u adapted, %u host\n", result.direct_imports, result.adapted_imports,
+                result.host_imports);
+    return 0;
+}